@@ -0,0 +1,158 @@
+// Animation track compression microbenchmark: authoring curves vs. the cooked
+// CompressedClip that AnimationAssetCache builds for runtime copies.
+//
+//   bench_animation_compression [seconds] [iterations]
+//
+// The clip is shaped like a mocap take: 64 bones keyed at 30 fps for 'seconds'
+// (default 20), every bone rotating on smooth multi-frequency noise, translation
+// keys on every bone but animated on the hips and a few props only, scale keys
+// constant. Reported:
+//   size       curve key bytes vs. cooked bytes, and the ratio
+//   error      worst rotation (degrees) and translation (mm) difference between
+//              the two paths over 2000 random times
+//   ns/bone    SampleAsset into a 64-bone PoseBuffer, curves (with a per-instance
+//              cursor, as AnimationSystem samples them) vs. cooked; "decode" is
+//              SampleCompressed alone, without composing bone matrices
+#include "animation/AnimationEvaluator.h"
+#include "animation/CompressedClip.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace cm::animation;
+using Clock = std::chrono::steady_clock;
+
+constexpr int kBones = 64;
+constexpr float kFps = 30.0f;
+constexpr float kFrameDt = 1.0f / 60.0f;
+
+float Noise(float t, float seed) {
+   return std::sin(t * 1.7f + seed) * 0.6f + std::sin(t * 4.3f + seed * 2.1f) * 0.25f + std::sin(t * 11.0f + seed * 0.7f) * 0.05f;
+   }
+
+std::unique_ptr<AnimationAsset> MakeMocapClip(float seconds) {
+   auto asset = std::make_unique<AnimationAsset>();
+   asset->meta.length = seconds;
+   asset->meta.fps = kFps;
+   const int keys = int(seconds * kFps) + 1;
+   for (int b = 0; b < kBones; ++b) {
+      auto track = std::make_unique<AssetBoneTrack>();
+      track->boneId = b;
+      track->name = "Bone" + std::to_string(b);
+      const bool movesT = b == 0 || b % 21 == 0;
+      const glm::vec3 axis = glm::normalize(glm::vec3(std::sin(float(b)), 1.0f, std::cos(float(b) * 0.5f)));
+      for (int k = 0; k < keys; ++k) {
+         const float t = float(k) / kFps;
+         const glm::vec3 bind(0.0f, 0.1f, 0.02f * float(b % 3));
+         const glm::vec3 pos = movesT ? glm::vec3(Noise(t, float(b)) * 2.0f, 0.9f + Noise(t, float(b) + 5.0f) * 0.05f, t * 1.4f) : bind;
+         const glm::quat rot = glm::angleAxis(Noise(t, float(b) * 0.37f) * 1.2f, axis) * glm::angleAxis(Noise(t, float(b) + 9.0f) * 0.4f, glm::vec3(1.0f, 0.0f, 0.0f));
+         track->t.keys.push_back({ KeyID(k), t, pos });
+         track->r.keys.push_back({ KeyID(k), t, rot });
+         track->s.keys.push_back({ KeyID(k), t, glm::vec3(1.0f) });
+         }
+      asset->tracks.push_back(std::move(track));
+      }
+   return asset;
+   }
+
+// Same tracks with the curves dropped, as the asset cache keeps a cooked copy
+std::unique_ptr<AnimationAsset> MakeCookedCopy(const AnimationAsset& src, size_t& cookedBytes) {
+   auto asset = std::make_unique<AnimationAsset>();
+   asset->meta = src.meta;
+   std::unique_ptr<CompressedClip> clip = CookCompressedClip(src);
+   cookedBytes = clip->ByteSize();
+   asset->compressed = std::move(clip);
+   for (const auto& t : src.tracks) {
+      auto track = std::make_unique<AssetBoneTrack>();
+      track->boneId = static_cast<const AssetBoneTrack*>(t.get())->boneId;
+      track->name = t->name;
+      asset->tracks.push_back(std::move(track));
+      }
+   return asset;
+   }
+
+template<class F>
+double NsPerBone(F&& sample, int iterations) {
+   sample(0.0f);
+   const auto t0 = Clock::now();
+   float t = 0.0f;
+   for (int i = 0; i < iterations; ++i) { t += kFrameDt; sample(t); }
+   return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / double(iterations) / double(kBones);
+   }
+
+void DecomposeRT(const glm::mat4& m, glm::quat& r, glm::vec3& t) {
+   t = glm::vec3(m[3]);
+   r = glm::quat_cast(glm::mat3(m));
+   }
+
+} // namespace
+
+int main(int argc, char** argv) {
+   const float seconds = argc > 1 ? float(std::atof(argv[1])) : 20.0f;
+   const int iterations = argc > 2 ? std::atoi(argv[2]) : 20000;
+
+   const std::unique_ptr<AnimationAsset> curves = MakeMocapClip(seconds);
+   size_t cookedBytes = 0;
+   const std::unique_ptr<AnimationAsset> cooked = MakeCookedCopy(*curves, cookedBytes);
+   const size_t curveBytes = BoneCurveBytes(*curves);
+
+   PoseBuffer a, b;
+   a.local.assign(kBones, glm::mat4(1.0f));
+   b.local.assign(kBones, glm::mat4(1.0f));
+   AnimationCursor cursor;
+   EvalContext ctx;
+   auto sampleCurves = [&](float t) {
+      EvalInputs in{ curves.get(), t, true, &cursor };
+      EvalTargets out{ &a };
+      SampleAsset(in, ctx, out);
+      };
+   auto sampleCooked = [&](float t) {
+      EvalInputs in{ cooked.get(), t, true, nullptr };
+      EvalTargets out{ &b };
+      SampleAsset(in, ctx, out);
+      };
+
+   // Accuracy over random times
+   std::mt19937 rng(7);
+   std::uniform_real_distribution<float> time(0.0f, seconds);
+   double maxDeg = 0.0, maxMm = 0.0;
+   for (int i = 0; i < 2000; ++i) {
+      const float t = time(rng);
+      sampleCurves(t);
+      sampleCooked(t);
+      for (int bone = 0; bone < kBones; ++bone) {
+         glm::quat ra, rb; glm::vec3 ta, tb;
+         DecomposeRT(a.local[bone], ra, ta);
+         DecomposeRT(b.local[bone], rb, tb);
+         const float dot = std::min(1.0f, std::abs(glm::dot(glm::normalize(ra), glm::normalize(rb))));
+         maxDeg = std::max(maxDeg, double(glm::degrees(2.0f * std::acos(dot))));
+         maxMm = std::max(maxMm, double(glm::length(ta - tb)) * 1000.0);
+         }
+      }
+
+   CompressedSample decoded;
+   const double curveNs = NsPerBone(sampleCurves, iterations);
+   const double cookedNs = NsPerBone(sampleCooked, iterations);
+   const double decodeNs = NsPerBone([&](float t) { SampleCompressed(*cooked->compressed, std::fmod(t, seconds), decoded); }, iterations);
+
+   const double kib = 1024.0;
+   std::printf("bones: %d, length: %.1f s @ %.0f fps, kernel: %s\n", kBones, seconds, kFps, CompressedKernelName());
+   std::printf("%-10s %12s %12s %8s\n", "", "curves", "cooked", "ratio");
+   std::printf("%-10s %10.1f K %10.1f K %7.2fx\n", "size", double(curveBytes) / kib, double(cookedBytes) / kib, double(curveBytes) / double(cookedBytes));
+   std::printf("%-10s %12.2f %12.2f %7.2fx\n", "ns/bone", curveNs, cookedNs, curveNs / cookedNs);
+   std::printf("%-10s %12s %12.2f\n", "decode", "", decodeNs);
+   std::printf("max error: %.4f deg rotation, %.4f mm translation\n", maxDeg, maxMm);
+   return 0;
+}
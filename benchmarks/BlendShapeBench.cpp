@@ -0,0 +1,199 @@
+// Blend shape microbenchmark: SkinningSystem's previous dense blend (every vertex of
+// every weighted shape, fresh vertex array, whole buffer uploaded) vs. the sparse,
+// range-uploading blend of BlendShapeBlender.h.
+//
+//   bench_blendshapes [workers] [frames]
+//
+// The mesh is a 12k-vertex face with 52 ARKit-style shapes, each moving one region
+// (300 to 1500 vertices inside a window of the index range, as exporters keep
+// regions roughly contiguous). Two animations are played:
+//   speech   ~12 mouth/jaw shapes weighted, 6 of them changing every frame
+//   blink    one eyelid shape changing, everything else still
+// Reported per frame: blend time and bytes handed to the upload (bgfx::copy), and
+// the largest position difference between the two paths.
+#include "ecs/AnimationComponents.h"
+#include "ecs/BlendShapeBlender.h"
+#include "jobs/JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kVertices = 12000;
+constexpr int kShapes = 52;
+constexpr int kSpeechShapes = 12;          // shapes 0..11 animate the mouth
+constexpr int kBlinkShape = 40;
+
+// Same layout as PBRVertex (rendering/VertexTypes.h) without the bgfx dependency
+struct Vertex {
+   float x, y, z;
+   float nx, ny, nz;
+   float u, v;
+   };
+
+struct Face {
+   std::vector<glm::vec3> positions, normals;
+   std::vector<glm::vec2> uvs;
+   BlendShapeComponent shapes;
+   };
+
+Face MakeFace() {
+   Face f;
+   std::mt19937 rng(7);
+   std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+   f.positions.resize(kVertices);
+   f.normals.resize(kVertices);
+   f.uvs.resize(kVertices);
+   for (size_t i = 0; i < kVertices; ++i) {
+      f.positions[i] = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.1f;
+      f.normals[i] = glm::normalize(f.positions[i] + glm::vec3(0.0f, 0.0f, 0.05f));
+      f.uvs[i] = glm::vec2(float(i % 128) / 128.0f, float(i / 128) / 128.0f);
+      }
+   f.shapes.Shapes.resize(kShapes);
+   for (int s = 0; s < kShapes; ++s) {
+      BlendShape& shape = f.shapes.Shapes[s];
+      shape.Name = "shape" + std::to_string(s);
+      shape.DeltaPos.assign(kVertices, glm::vec3(0.0f));
+      shape.DeltaNormal.assign(kVertices, glm::vec3(0.0f));
+      const size_t moved = 300 + size_t(rng() % 1200);
+      const size_t window = std::min(kVertices, moved + moved / 2);
+      const size_t first = size_t(rng() % (kVertices - window + 1));
+      for (size_t i = first; i < first + window; ++i) {
+         if (rng() % 3 == 0) continue;
+         shape.DeltaPos[i] = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.004f;
+         shape.DeltaNormal[i] = glm::vec3(unit(rng), unit(rng), unit(rng)) * 0.05f;
+         }
+      }
+   return f;
+   }
+
+void SetWeights(BlendShapeComponent& bs, int frame, bool speech) {
+   const float t = float(frame) / 60.0f;
+   if (speech) {
+      // half of the mouth shapes move every frame, the other half every 4th
+      for (int s = 0; s < kSpeechShapes; ++s) {
+         if (s % 2 == 1 && frame % 4 != 0) continue;
+         bs.Shapes[s].Weight = 0.5f + 0.5f * std::sin(t * (3.0f + float(s)) + float(s));
+         }
+      }
+   else {
+      bs.Shapes[kBlinkShape].Weight = std::max(0.0f, std::sin(t * 6.0f));
+      }
+   }
+
+// SkinningSystem before: rebuild every vertex, accumulate every weighted shape over
+// the whole mesh, upload the whole buffer
+size_t DenseBlend(const Face& f, const BlendShapeComponent& bs, std::vector<uint8_t>& upload) {
+   std::vector<Vertex> blended(kVertices);
+   for (size_t i = 0; i < kVertices; ++i) {
+      blended[i] = { f.positions[i].x, f.positions[i].y, f.positions[i].z,
+                     f.normals[i].x, f.normals[i].y, f.normals[i].z, f.uvs[i].x, f.uvs[i].y };
+      }
+   std::vector<glm::vec3> accDP(kVertices, glm::vec3(0)), accDN(kVertices, glm::vec3(0));
+   for (const BlendShape& shape : bs.Shapes) {
+      if (shape.Weight == 0.0f) continue;
+      for (size_t i = 0; i < kVertices; ++i) {
+         accDP[i] += shape.DeltaPos[i] * shape.Weight;
+         accDN[i] += shape.DeltaNormal[i] * shape.Weight;
+         }
+      }
+   for (size_t i = 0; i < kVertices; ++i) {
+      const glm::vec3 p = f.positions[i] + accDP[i], n = f.normals[i] + accDN[i];
+      blended[i].x = p.x; blended[i].y = p.y; blended[i].z = p.z;
+      blended[i].nx = n.x; blended[i].ny = n.y; blended[i].nz = n.z;
+      }
+   const size_t bytes = blended.size() * sizeof(Vertex);
+   upload.resize(bytes);
+   std::memcpy(upload.data(), blended.data(), bytes);
+   return bytes;
+   }
+
+// SkinningSystem now: persistent vertex copy, sparse active shapes, dirty span uploaded
+size_t SparseBlend(const Face& f, BlendShapeComponent& bs, JobSystem& js, std::vector<uint8_t>& upload) {
+   bool all = false;
+   if (bs.SparseVertexCount != kVertices) BuildSparseBlendShapes(bs, kVertices);
+   if (bs.Vertices.size() != kVertices * sizeof(Vertex)) {
+      bs.VertexStride = sizeof(Vertex);
+      bs.Vertices.resize(kVertices * sizeof(Vertex));
+      Vertex* v = reinterpret_cast<Vertex*>(bs.Vertices.data());
+      for (size_t i = 0; i < kVertices; ++i) {
+         v[i] = { f.positions[i].x, f.positions[i].y, f.positions[i].z,
+                  f.normals[i].x, f.normals[i].y, f.normals[i].z, f.uvs[i].x, f.uvs[i].y };
+         }
+      all = true;
+      }
+   const BlendShapeSpan span = BlendShapesInto(bs, f.positions.data(), f.normals.data(), kVertices, all, js);
+   const size_t bytes = size_t(span.count) * sizeof(Vertex);
+   upload.resize(bytes);
+   if (bytes) std::memcpy(upload.data(), bs.Vertices.data() + size_t(span.first) * sizeof(Vertex), bytes);
+   return bytes;
+   }
+
+float MaxDifference(const BlendShapeComponent& dense, const BlendShapeComponent& sparse, const Face& f) {
+   const Vertex* v = reinterpret_cast<const Vertex*>(sparse.Vertices.data());
+   float worst = 0.0f;
+   for (size_t i = 0; i < kVertices; ++i) {
+      glm::vec3 p = f.positions[i];
+      for (const BlendShape& shape : dense.Shapes) p += shape.DeltaPos[i] * shape.Weight;
+      worst = std::max(worst, glm::length(p - glm::vec3(v[i].x, v[i].y, v[i].z)));
+      }
+   return worst;
+   }
+
+} // namespace
+
+int main(int argc, char** argv) {
+   unsigned hw = std::thread::hardware_concurrency();
+   size_t workers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : ((hw > 2) ? (hw - 1) : 1);
+   if (workers == 0) workers = 1;
+   const int frames = (argc > 2) ? std::atoi(argv[2]) : 600;
+
+   JobSystem js(workers);
+   const Face face = MakeFace();
+   size_t moved = 0;
+   {
+      BlendShapeComponent probe = face.shapes;
+      BuildSparseBlendShapes(probe, kVertices);
+      for (const BlendShape& s : probe.Shapes) moved += s.Indices.size();
+      }
+   std::printf("face: %zu vertices, %d shapes, %.0f moved vertices per shape on average; %zu workers, %d frames\n\n",
+      kVertices, kShapes, double(moved) / kShapes, workers, frames);
+   std::printf("%-8s %12s %12s %14s %14s %8s %12s\n", "anim", "dense ms", "sparse ms", "dense KB/frm", "sparse KB/frm", "speedup", "max diff");
+
+   for (int pass = 0; pass < 2; ++pass) {
+      const bool speech = pass == 0;
+      BlendShapeComponent dense = face.shapes, sparse = face.shapes;
+      std::vector<uint8_t> upload;
+      double denseMs = 0.0, sparseMs = 0.0, denseBytes = 0.0, sparseBytes = 0.0;
+      SparseBlend(face, sparse, js, upload);                 // first upload builds the copy; not timed
+      for (int frame = 0; frame < frames; ++frame) {
+         SetWeights(dense, frame, speech);
+         SetWeights(sparse, frame, speech);
+
+         auto t0 = Clock::now();
+         denseBytes += double(DenseBlend(face, dense, upload));
+         auto t1 = Clock::now();
+         sparseBytes += double(SparseBlend(face, sparse, js, upload));
+         auto t2 = Clock::now();
+         denseMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+         sparseMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+         }
+      std::printf("%-8s %12.3f %12.3f %14.1f %14.1f %7.1fx %12.2e\n", speech ? "speech" : "blink",
+         denseMs / frames, sparseMs / frames, denseBytes / frames / 1024.0, sparseBytes / frames / 1024.0,
+         denseMs / std::max(sparseMs, 1e-9), double(MaxDifference(dense, sparse, face)));
+      }
+   return 0;
+}
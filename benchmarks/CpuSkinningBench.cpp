@@ -0,0 +1,159 @@
+// CPU skinning microbenchmark: the SkinVertices kernel (CpuSkinning.h) against a
+// plain glm loop, serial and one character per task on the JobSystem.
+//
+//   bench_cpu_skinning [workers] [characters] [frames]
+//
+// Every character is an 8k-vertex mesh on a 64-bone palette, four influences per
+// vertex (weights 0.55/0.25/0.15/0.05), positions and normals interleaved the way
+// BlendShapeComponent::Vertices holds them. Each frame the palette changes and every
+// character is skinned into its own position/normal buffer plus bounds, as
+// SkinningSystem does for CPU-skinned meshes. Reported: ms per frame, Mverts/s and
+// the largest position difference between the kernel and the glm loop.
+#include "ecs/CpuSkinning.h"
+#include "jobs/JobSystem.h"
+#include "jobs/ParallelFor.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kVertices = 8192;
+constexpr size_t kBones = 64;
+
+struct Character {
+   std::vector<float> vertices;            // x y z nx ny nz u v, as PBRVertex
+   std::vector<glm::ivec4> boneIndices;
+   std::vector<glm::vec4> boneWeights;
+   std::vector<glm::mat4> palette;
+   std::vector<glm::vec3> positions, normals;
+   glm::vec3 boundsMin{ 0.0f }, boundsMax{ 0.0f };
+   };
+
+Character MakeCharacter(std::mt19937& rng) {
+   std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+   Character c;
+   c.vertices.resize(kVertices * 8);
+   c.boneIndices.resize(kVertices);
+   c.boneWeights.resize(kVertices);
+   for (size_t v = 0; v < kVertices; ++v) {
+      float* f = &c.vertices[v * 8];
+      const glm::vec3 p(unit(rng) * 0.4f, (unit(rng) + 1.0f) * 0.9f, unit(rng) * 0.2f);
+      const glm::vec3 n = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 0.0f, 1e-3f));
+      f[0] = p.x; f[1] = p.y; f[2] = p.z; f[3] = n.x; f[4] = n.y; f[5] = n.z; f[6] = 0.0f; f[7] = 0.0f;
+      const int b = int(rng() % kBones);
+      c.boneIndices[v] = glm::ivec4(b, (b + 1) % kBones, (b + 7) % kBones, (b + 13) % kBones);
+      c.boneWeights[v] = glm::vec4(0.55f, 0.25f, 0.15f, 0.05f);
+      }
+   c.palette.resize(kBones);
+   c.positions.resize(kVertices);
+   c.normals.resize(kVertices);
+   return c;
+   }
+
+void Animate(Character& c, int frame, size_t index) {
+   const float t = float(frame) / 60.0f + float(index) * 0.37f;
+   for (size_t b = 0; b < kBones; ++b) {
+      const float a = std::sin(t * 2.0f + float(b)) * 0.5f;
+      c.palette[b] = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.01f * float(b % 8), std::sin(t) * 0.1f))
+                   * glm::rotate(glm::mat4(1.0f), a, glm::normalize(glm::vec3(1.0f, float(b % 3), 0.5f)));
+      }
+   }
+
+void SkinKernel(Character& c) {
+   SkinSource src;
+   src.positions = c.vertices.data();
+   src.normals = c.vertices.data() + 3;
+   src.stride = sizeof(float) * 8;
+   src.boneIndices = c.boneIndices.data();
+   src.boneWeights = c.boneWeights.data();
+   c.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+   c.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+   SkinVertices(src, c.palette.data(), c.palette.size(), 0, kVertices, c.positions.data(), c.normals.data(), c.boundsMin, c.boundsMax);
+   }
+
+// Reference: blend four glm matrices per vertex, transform, normalise
+void SkinGlm(Character& c) {
+   c.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+   c.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+   for (size_t v = 0; v < kVertices; ++v) {
+      const float* f = &c.vertices[v * 8];
+      const glm::ivec4 bi = c.boneIndices[v];
+      const glm::vec4 bw = c.boneWeights[v];
+      const glm::mat4 m = c.palette[bi.x] * bw.x + c.palette[bi.y] * bw.y + c.palette[bi.z] * bw.z + c.palette[bi.w] * bw.w;
+      c.positions[v] = glm::vec3(m * glm::vec4(f[0], f[1], f[2], 1.0f));
+      c.normals[v] = glm::normalize(glm::vec3(m * glm::vec4(f[3], f[4], f[5], 0.0f)));
+      c.boundsMin = glm::min(c.boundsMin, c.positions[v]);
+      c.boundsMax = glm::max(c.boundsMax, c.positions[v]);
+      }
+   }
+
+template <typename Fn>
+double RunFrames(std::vector<Character>& crowd, int frames, JobSystem* js, Fn&& skin) {
+   double ms = 0.0;
+   for (int frame = 0; frame < frames; ++frame) {
+      for (size_t i = 0; i < crowd.size(); ++i) Animate(crowd[i], frame, i);
+      const auto t0 = Clock::now();
+      if (js) {
+         parallel_for(*js, size_t{ 0 }, crowd.size(), size_t{ 1 }, [&](size_t start, size_t count) {
+            for (size_t i = start; i < start + count; ++i) skin(crowd[i]);
+            });
+         }
+      else {
+         for (Character& c : crowd) skin(c);
+         }
+      ms += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+      }
+   return ms / frames;
+   }
+
+} // namespace
+
+int main(int argc, char** argv) {
+   unsigned hw = std::thread::hardware_concurrency();
+   size_t workers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : ((hw > 2) ? (hw - 1) : 1);
+   if (workers == 0) workers = 1;
+   const size_t characters = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 32;
+   const int frames = (argc > 3) ? std::atoi(argv[3]) : 60;
+
+   JobSystem js(workers);
+   std::mt19937 rng(11);
+   std::vector<Character> crowd;
+   for (size_t i = 0; i < characters; ++i) crowd.push_back(MakeCharacter(rng));
+
+   // Accuracy: kernel vs. glm on one posed character
+   Character check = crowd[0];
+   Animate(check, 17, 0);
+   SkinGlm(check);
+   const std::vector<glm::vec3> reference = check.positions;
+   const glm::vec3 refMin = check.boundsMin, refMax = check.boundsMax;
+   SkinKernel(check);
+   float maxDiff = std::max(glm::length(check.boundsMin - refMin), glm::length(check.boundsMax - refMax));
+   for (size_t v = 0; v < kVertices; ++v) maxDiff = std::max(maxDiff, glm::length(check.positions[v] - reference[v]));
+
+   const double verts = double(characters * kVertices);
+   std::printf("%zu characters x %zu vertices, %zu bones; %zu workers, %d frames; max diff %.2e\n\n",
+      characters, kVertices, kBones, workers, frames, double(maxDiff));
+   std::printf("%-18s %10s %10s\n", "path", "ms/frame", "Mverts/s");
+   struct Row { const char* name; double ms; };
+   const Row rows[] = {
+      { "glm, serial",    RunFrames(crowd, frames, nullptr, SkinGlm) },
+      { "kernel, serial", RunFrames(crowd, frames, nullptr, SkinKernel) },
+      { "glm, jobs",      RunFrames(crowd, frames, &js, SkinGlm) },
+      { "kernel, jobs",   RunFrames(crowd, frames, &js, SkinKernel) },
+      };
+   for (const Row& r : rows) std::printf("%-18s %10.3f %10.1f\n", r.name, r.ms, verts / (r.ms * 1e3));
+   return 0;
+}
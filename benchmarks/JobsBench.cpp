@@ -0,0 +1,90 @@
+// Scheduler microbenchmark: work-stealing JobSystem vs. the legacy mutex queue.
+//
+//   bench_jobs [workers]
+//
+// Reports empty-job throughput (jobs/s) and the latency of a parallel_for over
+// 1000 chunks with trivial bodies (the shape of Scene::UpdateTransforms on a
+// wide hierarchy level).
+#include "jobs/JobSystem.h"
+#include "jobs/ParallelFor.h"
+#include "LegacyJobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point t0) {
+   return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// The waiting thread helps in the new scheduler; the legacy one can only yield.
+void HelpOrYield(legacy::JobSystem&) { std::this_thread::yield(); }
+void HelpOrYield(JobSystem& js) { if (!js.TryRunOne()) std::this_thread::yield(); }
+
+template<class JS>
+double EmptyJobThroughput(JS& js, size_t jobs) {
+   std::atomic<size_t> done{ 0 };
+   const auto t0 = Clock::now();
+   for (size_t i = 0; i < jobs; ++i)
+      js.Enqueue([&done] { done.fetch_add(1, std::memory_order_release); });
+   while (done.load(std::memory_order_acquire) != jobs) HelpOrYield(js);
+   return double(jobs) / SecondsSince(t0);
+}
+
+template<class PF>
+double ParallelForLatencyUs(PF&& pfor, size_t iterations) {
+   constexpr size_t kChunks = 1000;
+   std::vector<uint32_t> data(kChunks * 64, 1u);
+   // Warm-up so thread wake-up from cold sleep is not part of the measurement.
+   for (int i = 0; i < 16; ++i) pfor(data);
+   const auto t0 = Clock::now();
+   for (size_t i = 0; i < iterations; ++i) pfor(data);
+   return SecondsSince(t0) * 1e6 / double(iterations);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   unsigned hw = std::thread::hardware_concurrency();
+   size_t workers = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : ((hw > 2) ? (hw - 1) : 1);
+   if (workers == 0) workers = 1;
+
+   constexpr size_t kEmptyJobs = 500000;
+   constexpr size_t kPforIters = 2000;
+
+   auto body = [](std::vector<uint32_t>& v) {
+      return [&v](size_t s, size_t c) {
+         for (size_t i = s * 64; i < (s + c) * 64; ++i) v[i] += 1u;
+         };
+      };
+
+   double legacyJobs = 0.0, legacyPfor = 0.0;
+      {
+      legacy::JobSystem js(workers);
+      legacyJobs = EmptyJobThroughput(js, kEmptyJobs);
+      legacyPfor = ParallelForLatencyUs([&](std::vector<uint32_t>& v) {
+         legacy::parallel_for(js, size_t{ 0 }, size_t{ 1000 }, size_t{ 1 }, body(v));
+         }, kPforIters);
+      }
+
+   double wsJobs = 0.0, wsPfor = 0.0;
+      {
+      JobSystem js(workers);
+      wsJobs = EmptyJobThroughput(js, kEmptyJobs);
+      wsPfor = ParallelForLatencyUs([&](std::vector<uint32_t>& v) {
+         parallel_for(js, size_t{ 0 }, size_t{ 1000 }, size_t{ 1 }, body(v));
+         }, kPforIters);
+      }
+
+   std::printf("workers: %zu\n", workers);
+   std::printf("%-28s %14s %14s %8s\n", "", "legacy", "work-stealing", "speedup");
+   std::printf("%-28s %14.0f %14.0f %7.2fx\n", "empty jobs/s", legacyJobs, wsJobs, wsJobs / legacyJobs);
+   std::printf("%-28s %14.2f %14.2f %7.2fx\n", "parallel_for 1k chunks (us)", legacyPfor, wsPfor, legacyPfor / wsPfor);
+   return 0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+// Snapshot of the original mutex + std::deque<std::function> job system and its
+// parallel_for, kept only as a baseline for the scheduler benchmarks.
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+namespace legacy {
+
+class JobSystem {
+public:
+   explicit JobSystem(size_t threads =
+      std::max(1u, std::thread::hardware_concurrency()))
+      {
+      start(threads ? threads : 1);
+      }
+
+   ~JobSystem() { stop(); }
+
+   bool Enqueue(std::function<void()> job) {
+         {
+         std::lock_guard<std::mutex> lk(m_);
+         if (stopping_) return false;
+         q_.push_back(std::move(job));
+         }
+         cv_.notify_one();
+         return true;
+      }
+
+private:
+   void start(size_t n) {
+      stopping_ = false;
+      workers_.reserve(n);
+      for (size_t i = 0; i < n; ++i) {
+         workers_.emplace_back([this] {
+            for (;;) {
+               std::function<void()> job;
+               {
+               std::unique_lock<std::mutex> lk(m_);
+               cv_.wait(lk, [this] { return stopping_ || !q_.empty(); });
+               if (stopping_ && q_.empty()) return;
+               job = std::move(q_.front());
+               q_.pop_front();
+               }
+               try { job(); }
+               catch (...) {}
+               }
+            });
+         }
+      }
+
+   void stop() {
+         {
+         std::lock_guard<std::mutex> lk(m_);
+         stopping_ = true;
+         }
+         cv_.notify_all();
+         for (auto& t : workers_) if (t.joinable()) t.join();
+         workers_.clear();
+      }
+
+   std::vector<std::thread> workers_;
+   std::deque<std::function<void()>> q_;
+   std::mutex m_;
+   std::condition_variable cv_;
+   bool stopping_{ false };
+   };
+
+template<class Fn>
+inline void parallel_for(JobSystem& js,
+   size_t begin, size_t end, size_t chunk,
+   Fn&& fn)
+   {
+   if (end <= begin) return;
+
+   const size_t groups = (end - begin + chunk - 1) / chunk;
+   auto first_error = std::make_shared<std::exception_ptr>();
+   std::mutex err_m;
+
+   using FnT = std::decay_t<Fn>;
+   auto fn_holder = std::make_shared<FnT>(std::forward<Fn>(fn));
+
+   struct Sync {
+      std::mutex m;
+      std::condition_variable cv;
+      std::atomic<size_t> remaining{ 0 };
+      };
+   auto sync = std::make_shared<Sync>();
+   sync->remaining.store(groups, std::memory_order_relaxed);
+
+   auto signal = [](Sync& s) {
+      if (s.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         std::lock_guard<std::mutex> lk(s.m);
+         s.cv.notify_one();
+         }
+      };
+
+   for (size_t s = begin; s < end; s += chunk) {
+      const size_t c = std::min(chunk, end - s);
+      bool ok = js.Enqueue([s, c, fn_holder, first_error, &err_m, sync, signal] {
+         try { (*fn_holder)(s, c); }
+         catch (...) {
+            std::lock_guard<std::mutex> lk(err_m);
+            if (!*first_error) *first_error = std::current_exception();
+            }
+         signal(*sync);
+         });
+      if (!ok) {
+         try { (*fn_holder)(s, c); }
+         catch (...) {
+            std::lock_guard<std::mutex> lk(err_m);
+            if (!*first_error) *first_error = std::current_exception();
+            }
+         signal(*sync);
+         }
+      }
+
+   std::unique_lock<std::mutex> lk(sync->m);
+   sync->cv.wait(lk, [&] { return sync->remaining.load(std::memory_order_acquire) == 0; });
+
+   if (*first_error) std::rethrow_exception(*first_error);
+   }
+
+} // namespace legacy
@@ -0,0 +1,229 @@
+// Pak load microbenchmark: v1 archive (ifstream per read, string-keyed table
+// parsed at mount) vs. the v2 memory-mapped archive with a hashed table.
+//
+//   bench_pak_load [files] [workers] [dir]
+//
+// Builds a synthetic project of 'files' small assets (1-64 KiB, mixed text-like
+// and noise content) plus a handful of 8 MiB blobs, writes it as both a v1 and a
+// v2 pak in 'dir' (default: the temp directory) and reports:
+//   mount      time to open the archive and build/attach its table
+//   read all   FileSystem-style read of every small asset by path
+//   view all   v2 only: zero-copy view of every stored entry
+//   big blobs  decode of the large entries, serial vs. spread over the workers
+// Compression is only exercised when the build found LZ4 or zstd.
+// The archives are read back from a warm page cache, so compressed entries show
+// their decode cost but not the disk bytes they save; compare the archive sizes
+// for the cold-start side of the trade.
+#include "pipeline/PakArchive.h"
+#include "pipeline/PakWriter.h"
+#include "jobs/JobSystem.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MsSince(Clock::time_point t0) {
+   return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// The pre-v2 archive, kept verbatim as the baseline.
+namespace legacy {
+   struct Entry { uint64_t offset = 0; uint64_t size = 0; };
+
+   bool Save(const std::string& path, const std::vector<std::pair<std::string, std::vector<uint8_t>>>& files) {
+      std::ofstream out(path, std::ios::binary | std::ios::trunc);
+      if (!out.is_open()) return false;
+      const uint32_t version = 1, count = uint32_t(files.size());
+      out.write("CLYP", 4);
+      out.write(reinterpret_cast<const char*>(&version), 4);
+      out.write(reinterpret_cast<const char*>(&count), 4);
+      uint64_t offset = 12;
+      for (const auto& f : files) offset += 4 + f.first.size() + 16;
+      for (const auto& f : files) {
+         const uint32_t len = uint32_t(f.first.size());
+         const uint64_t size = f.second.size();
+         out.write(reinterpret_cast<const char*>(&len), 4);
+         out.write(f.first.data(), len);
+         out.write(reinterpret_cast<const char*>(&offset), 8);
+         out.write(reinterpret_cast<const char*>(&size), 8);
+         offset += size;
+      }
+      for (const auto& f : files) out.write(reinterpret_cast<const char*>(f.second.data()), std::streamsize(f.second.size()));
+      return bool(out);
+   }
+
+   struct Reader {
+      std::string pakPath;
+      std::unordered_map<std::string, Entry> index;
+
+      bool Open(const std::string& path) {
+         index.clear();
+         pakPath = path;
+         std::ifstream in(path, std::ios::binary);
+         if (!in.is_open()) return false;
+         char magic[4]; uint32_t version = 0, count = 0;
+         in.read(magic, 4);
+         in.read(reinterpret_cast<char*>(&version), 4);
+         in.read(reinterpret_cast<char*>(&count), 4);
+         for (uint32_t i = 0; i < count; ++i) {
+            uint32_t len = 0;
+            in.read(reinterpret_cast<char*>(&len), 4);
+            std::string p(len, '\0');
+            in.read(p.data(), len);
+            Entry e;
+            in.read(reinterpret_cast<char*>(&e.offset), 8);
+            in.read(reinterpret_cast<char*>(&e.size), 8);
+            index.emplace(std::move(p), e);
+         }
+         return true;
+      }
+
+      bool ReadFile(const std::string& path, std::vector<uint8_t>& out) const {
+         auto it = index.find(path);
+         if (it == index.end()) return false;
+         std::ifstream in(pakPath, std::ios::binary);
+         if (!in.is_open()) return false;
+         in.seekg(std::streamoff(it->second.offset));
+         out.resize(size_t(it->second.size));
+         if (!out.empty()) in.read(reinterpret_cast<char*>(out.data()), std::streamsize(out.size()));
+         return true;
+      }
+
+      // The old FileSystem::ReadFile probing order for a project-relative asset path
+      bool ReadLikeFileSystem(const std::string& path, std::vector<uint8_t>& out) const {
+         if (ReadFile(path, out)) return true;
+         auto pos = path.find("assets/");
+         if (pos != std::string::npos && ReadFile(path.substr(pos), out)) return true;
+         return false;
+      }
+   };
+} // namespace legacy
+
+std::vector<uint8_t> MakeContent(std::mt19937& rng, size_t size, bool textLike) {
+   std::vector<uint8_t> v(size);
+   if (textLike) {
+      static const char kWords[][8] = { "vertex", "normal", "\"uv\":", "0.000", "1.0f,", "mesh", "{ }", "bone" };
+      for (size_t i = 0; i < size;) {
+         const char* w = kWords[rng() % 8];
+         for (size_t k = 0; w[k] && i < size; ++k) v[i++] = uint8_t(w[k]);
+         if (i < size) v[i++] = ' ';
+      }
+   } else {
+      for (auto& b : v) b = uint8_t(rng());
+   }
+   return v;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   const size_t fileCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+   unsigned hw = std::thread::hardware_concurrency();
+   size_t workers = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : ((hw > 2) ? (hw - 1) : 1);
+   if (workers == 0) workers = 1;
+   const std::filesystem::path dir = (argc > 3) ? std::filesystem::path(argv[3]) : std::filesystem::temp_directory_path();
+
+   std::mt19937 rng(1234);
+   std::vector<std::pair<std::string, std::vector<uint8_t>>> files;
+   size_t totalBytes = 0;
+   for (size_t i = 0; i < fileCount; ++i) {
+      const size_t size = 1024 + rng() % (63 * 1024);
+      char name[96];
+      std::snprintf(name, sizeof(name), "assets/level%02zu/props/prop_%06zu.%s", i % 37, i, (i % 3) ? "json" : "png");
+      files.emplace_back(name, MakeContent(rng, size, (i % 3) != 0));
+      totalBytes += size;
+   }
+   constexpr size_t kBigBlobs = 8;
+   std::vector<std::string> bigNames;
+   for (size_t i = 0; i < kBigBlobs; ++i) {
+      bigNames.push_back("assets/streaming/blob_" + std::to_string(i) + ".bin");
+      files.emplace_back(bigNames.back(), MakeContent(rng, 8u << 20, true));
+      totalBytes += 8u << 20;
+   }
+
+   const std::string v1Path = (dir / "bench_pak_v1.pak").string();
+   const std::string v2Path = (dir / "bench_pak_v2.pak").string();
+   if (!legacy::Save(v1Path, files)) { std::fprintf(stderr, "failed to write %s\n", v1Path.c_str()); return 1; }
+   {
+      PakWriter writer;
+      for (const auto& f : files) writer.AddBytes(f.first, f.second);
+      if (!writer.Write(v2Path, nullptr)) { std::fprintf(stderr, "failed to write %s\n", v2Path.c_str()); return 1; }
+   }
+
+   // Paths as the engine asks for them: absolute-looking, so the v1 probe misses once
+   std::vector<std::string> requests;
+   for (size_t i = 0; i < fileCount; ++i) requests.push_back("C:/Games/Demo/" + files[i].first);
+
+   std::vector<uint8_t> buf;
+   size_t checksum = 0;
+
+   auto t0 = Clock::now();
+   legacy::Reader v1;
+   v1.Open(v1Path);
+   const double v1Mount = MsSince(t0);
+   t0 = Clock::now();
+   for (const auto& r : requests) if (v1.ReadLikeFileSystem(r, buf)) checksum += buf.size();
+   const double v1Read = MsSince(t0);
+   t0 = Clock::now();
+   for (const auto& name : bigNames) if (v1.ReadFile(name, buf)) checksum += buf.size();
+   const double v1Big = MsSince(t0);
+
+   t0 = Clock::now();
+   PakArchive v2;
+   v2.Open(v2Path);
+   const double v2Mount = MsSince(t0);
+   t0 = Clock::now();
+   for (const auto& r : requests) {
+      // FileSystem::PakKey: cut to the assets/ segment, then one hashed lookup
+      const std::string key = r.substr(r.find("assets/"));
+      if (v2.ReadFile(key, buf)) checksum += buf.size();
+   }
+   const double v2Read = MsSince(t0);
+   t0 = Clock::now();
+   size_t viewed = 0;
+   for (size_t i = 0; i < fileCount; ++i) {
+      PakArchive::View view;
+      if (v2.ReadFileView(files[i].first, view)) { checksum += view.size; ++viewed; }
+   }
+   const double v2View = MsSince(t0);
+   t0 = Clock::now();
+   for (const auto& name : bigNames) if (v2.ReadFile(name, buf)) checksum += buf.size();
+   const double v2BigSerial = MsSince(t0);
+   double v2BigParallel = 0.0;
+      {
+      JobSystem js(workers);
+      t0 = Clock::now();
+      for (const auto& name : bigNames) if (v2.ReadFile(name, buf, &js)) checksum += buf.size();
+      v2BigParallel = MsSince(t0);
+      }
+
+   const bool compressed = PakArchive::IsCodecAvailable(PakArchive::Codec::LZ4) || PakArchive::IsCodecAvailable(PakArchive::Codec::Zstd);
+   std::printf("files: %zu (+%zu x 8 MiB), payload: %.1f MiB, workers: %zu\n", fileCount, kBigBlobs, double(totalBytes) / (1 << 20), workers);
+   std::printf("archive size: v1 %.1f MiB, v2 %.1f MiB (%s)\n",
+      double(std::filesystem::file_size(v1Path)) / (1 << 20), double(std::filesystem::file_size(v2Path)) / (1 << 20),
+      compressed ? "compressed" : "no codec in this build, stored raw");
+   std::printf("%-24s %12s %12s %8s\n", "", "v1 (ms)", "v2 (ms)", "speedup");
+   std::printf("%-24s %12.2f %12.2f %7.2fx\n", "mount", v1Mount, v2Mount, v1Mount / v2Mount);
+   std::printf("%-24s %12.2f %12.2f %7.2fx\n", "read all small", v1Read, v2Read, v1Read / v2Read);
+   std::printf("%-24s %12s %12.2f %8s   (%zu stored entries)\n", "view all small", "-", v2View, "", viewed);
+   std::printf("%-24s %12.2f %12.2f %7.2fx\n", "big blobs, serial", v1Big, v2BigSerial, v1Big / v2BigSerial);
+   std::printf("%-24s %12.2f %12.2f %7.2fx\n", "big blobs, job system", v1Big, v2BigParallel, v1Big / v2BigParallel);
+   std::printf("checksum: %zu\n", checksum);
+
+   std::error_code ec;
+   std::filesystem::remove(v1Path, ec);
+   std::filesystem::remove(v2Path, ec);
+   return 0;
+}
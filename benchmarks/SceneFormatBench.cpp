@@ -0,0 +1,230 @@
+// Scene format microbenchmark: JSON text vs. the binary scene encoding.
+//
+//   bench_scene_format [entities] [dir]
+//
+// Builds a synthetic scene of 'entities' records shaped like Serializer::SerializeEntity
+// output (transform with matrices, GUIDs, children, and a mix of mesh, light, collider
+// and script components), writes it as pretty-printed JSON (what SaveSceneToFile
+// produces) and as binary in 'dir' (default: the temp directory), then loads each back
+// into a document:
+//   load       read the file + parse/decode, best of several runs
+//   peak       highest heap growth during one load, the document included
+//   allocs     heap allocations during one load
+// Both paths end in the same nlohmann document that Serializer::DeserializeScene
+// consumes, and the benchmark checks they are equal; entity creation after that is
+// the same for either format and is not measured.
+#include "serialization/SceneBinary.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Heap accounting: every allocation carries its size in front so deletes can be counted
+namespace {
+   std::atomic<size_t> g_Live{ 0 };
+   std::atomic<size_t> g_Peak{ 0 };
+   std::atomic<size_t> g_Allocs{ 0 };
+   constexpr size_t kHeader = alignof(std::max_align_t);
+}
+
+void* operator new(size_t size) {
+   void* p = std::malloc(size + kHeader);
+   if (!p) throw std::bad_alloc();
+   *static_cast<size_t*>(p) = size;
+   const size_t live = g_Live.fetch_add(size) + size;
+   size_t peak = g_Peak.load();
+   while (live > peak && !g_Peak.compare_exchange_weak(peak, live)) {}
+   g_Allocs.fetch_add(1);
+   return static_cast<char*>(p) + kHeader;
+}
+void operator delete(void* p) noexcept {
+   if (!p) return;
+   char* base = static_cast<char*>(p) - kHeader;
+   g_Live.fetch_sub(*reinterpret_cast<size_t*>(base));
+   std::free(base);
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+double MsSince(Clock::time_point t0) {
+   return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+std::string MakeGuid(std::mt19937_64& rng) {
+   char buf[33];
+   std::snprintf(buf, sizeof(buf), "%016llx%016llx", (unsigned long long)rng(), (unsigned long long)rng());
+   return buf;
+}
+
+// Values go through float first, as the serializer writes them from glm
+json Floats(std::mt19937_64& rng, size_t n, float lo, float hi) {
+   std::uniform_real_distribution<float> d(lo, hi);
+   json a = json::array();
+   for (size_t i = 0; i < n; ++i) a.push_back(d(rng));
+   return a;
+}
+
+json MakeScene(size_t count) {
+   std::mt19937_64 rng(42);
+   std::vector<std::string> meshGuids, materials;
+   for (int i = 0; i < 64; ++i) meshGuids.push_back(MakeGuid(rng));
+   for (int i = 0; i < 16; ++i) materials.push_back("assets/materials/mat_" + std::to_string(i) + ".mat");
+
+   json scene;
+   scene["version"] = "1.0";
+   scene["shaderPreset"] = "pbr";
+   json& entities = scene["entities"] = json::array();
+   std::vector<std::vector<uint32_t>> children(count + 1);
+   std::vector<uint32_t> parents(count + 1, 0);
+   for (uint32_t id = 2; id <= count; ++id) {
+      // Shallow forest: a tenth of the entities are roots
+      if (rng() % 10 == 0) continue;
+      const uint32_t parent = 1 + uint32_t(rng() % (id - 1));
+      parents[id] = parent;
+      children[parent].push_back(id);
+   }
+   for (uint32_t id = 1; id <= count; ++id) {
+      json e;
+      e["id"] = id;
+      e["name"] = "Entity_" + std::to_string(id);
+      e["layer"] = int(rng() % 4);
+      e["tag"] = (rng() % 8 == 0) ? "Enemy" : "Untagged";
+      e["parent"] = parents[id] ? json(parents[id]) : json(-1);
+      e["children"] = children[id];
+      e["guid"] = MakeGuid(rng);
+      json t;
+      t["position"] = Floats(rng, 3, -500.0f, 500.0f);
+      t["rotation"] = Floats(rng, 3, -180.0f, 180.0f);
+      t["scale"] = json::array({ 1.0f, 1.0f, 1.0f });
+      t["useQuatRotation"] = false;
+      t["rotationQ"] = Floats(rng, 4, -1.0f, 1.0f);
+      t["localMatrix"] = Floats(rng, 16, -10.0f, 10.0f);
+      t["worldMatrix"] = Floats(rng, 16, -10.0f, 10.0f);
+      t["transformDirty"] = true;
+      e["transform"] = std::move(t);
+      const uint64_t kind = rng() % 100;
+      if (kind < 70) {
+         json m;
+         m["meshReference"] = { { "guid", meshGuids[rng() % meshGuids.size()] }, { "fileID", int(rng() % 8) } };
+         m["meshName"] = "Mesh_" + std::to_string(rng() % 64);
+         m["material"] = materials[rng() % materials.size()];
+         m["uniqueMaterial"] = false;
+         m["blendShapeWeights"] = Floats(rng, rng() % 3 == 0 ? 12 : 0, 0.0f, 1.0f);
+         e["mesh"] = std::move(m);
+      }
+      if (kind >= 70 && kind < 75) {
+         e["light"] = { { "type", int(rng() % 3) }, { "color", Floats(rng, 3, 0.0f, 1.0f) }, { "intensity", 2.5f } };
+      }
+      if (kind % 5 == 0) {
+         e["collider"] = { { "shapeType", int(rng() % 3) }, { "size", Floats(rng, 3, 0.1f, 4.0f) },
+                           { "offset", Floats(rng, 3, -1.0f, 1.0f) }, { "isTrigger", false } };
+      }
+      if (kind % 9 == 0) {
+         e["scripts"] = json::array({ { { "class", "EnemyController" },
+                                        { "properties", { { "speed", 3.5f }, { "target", MakeGuid(rng) } } } } });
+      }
+      entities.push_back(std::move(e));
+   }
+   return scene;
+}
+
+bool ReadAll(const std::string& path, std::vector<uint8_t>& out) {
+   std::ifstream in(path, std::ios::binary | std::ios::ate);
+   if (!in.is_open()) return false;
+   out.resize(size_t(in.tellg()));
+   in.seekg(0);
+   in.read(reinterpret_cast<char*>(out.data()), std::streamsize(out.size()));
+   return bool(in);
+}
+
+struct Result {
+   double bestMs = 1e30;
+   size_t peakBytes = 0;
+   size_t allocs = 0;
+};
+
+// Reads and decodes 'path' 'runs' times; peak and allocs come from the first run
+template<class Load>
+Result Measure(const std::string& path, int runs, Load&& load, json& keep) {
+   Result r;
+   for (int i = 0; i < runs; ++i) {
+      const size_t base = g_Live.load();
+      g_Peak.store(base);
+      const size_t allocs0 = g_Allocs.load();
+      const auto t0 = Clock::now();
+      json doc;
+      {
+         std::vector<uint8_t> bytes;
+         if (!ReadAll(path, bytes) || !load(bytes, doc)) { std::fprintf(stderr, "failed to load %s\n", path.c_str()); std::exit(1); }
+      }
+      const double ms = MsSince(t0);
+      if (i == 0) {
+         r.peakBytes = g_Peak.load() - base;
+         r.allocs = g_Allocs.load() - allocs0;
+      }
+      if (ms < r.bestMs) r.bestMs = ms;
+      if (i == runs - 1) keep = std::move(doc);
+   }
+   return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   const size_t entityCount = argc > 1 ? size_t(std::strtoull(argv[1], nullptr, 10)) : 50000;
+   const std::filesystem::path dir = argc > 2 ? std::filesystem::path(argv[2]) : std::filesystem::temp_directory_path();
+   constexpr int kRuns = 5;
+
+   const std::string jsonPath = (dir / "bench_scene.scene").string();
+   const std::string binPath = (dir / "bench_scene_bin.scene").string();
+   double encodeMs = 0.0;
+   {
+      const json scene = MakeScene(entityCount);
+      std::ofstream(jsonPath, std::ios::binary | std::ios::trunc) << scene.dump(4);
+      std::vector<uint8_t> bytes;
+      std::string error;
+      const auto t0 = Clock::now();
+      if (!scenebin::Encode(scene, bytes, &error)) { std::fprintf(stderr, "encode failed: %s\n", error.c_str()); return 1; }
+      encodeMs = MsSince(t0);
+      std::ofstream(binPath, std::ios::binary | std::ios::trunc).write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+   }
+
+   json fromJson, fromBinary;
+   const Result j = Measure(jsonPath, kRuns, [](const std::vector<uint8_t>& bytes, json& doc) {
+      doc = json::parse(bytes.begin(), bytes.end(), nullptr, false);
+      return !doc.is_discarded();
+   }, fromJson);
+   const Result b = Measure(binPath, kRuns, [](const std::vector<uint8_t>& bytes, json& doc) {
+      return scenebin::Decode(bytes.data(), bytes.size(), doc);
+   }, fromBinary);
+   const bool same = fromJson == fromBinary;
+
+   const double mib = 1 << 20;
+   std::printf("entities: %zu, encode: %.2f ms, documents %s\n", entityCount, encodeMs, same ? "equal" : "DIFFER");
+   std::printf("%-10s %12s %12s %8s\n", "", "json", "binary", "ratio");
+   std::printf("%-10s %10.1f M %10.1f M %7.2fx\n", "file",
+      double(std::filesystem::file_size(jsonPath)) / mib, double(std::filesystem::file_size(binPath)) / mib,
+      double(std::filesystem::file_size(jsonPath)) / double(std::filesystem::file_size(binPath)));
+   std::printf("%-10s %9.2f ms %9.2f ms %7.2fx\n", "load", j.bestMs, b.bestMs, j.bestMs / b.bestMs);
+   std::printf("%-10s %10.1f M %10.1f M %7.2fx\n", "peak", double(j.peakBytes) / mib, double(b.peakBytes) / mib, double(j.peakBytes) / double(b.peakBytes));
+   std::printf("%-10s %12zu %12zu %7.2fx\n", "allocs", j.allocs, b.allocs, double(j.allocs) / double(b.allocs));
+
+   std::error_code ec;
+   std::filesystem::remove(jsonPath, ec);
+   std::filesystem::remove(binPath, ec);
+   return same ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+// Transform propagation microbenchmark: packed TransformStore kernels vs. the
+// per-entity hash-map path Scene::UpdateTransforms used before.
+//
+//   bench_transforms [frames]
+//
+// Every entity is edited every frame (the animated-crowd worst case). Both paths
+// run level by level on one thread so the numbers are per-core kernel cost;
+// Scene spreads each level over the job system on top of this. Reports ns/entity
+// for a flat scene and for 10-level-deep skeleton hierarchies.
+#include "ecs/TransformStore.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/euler_angles.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Same fields and CalculateLocalMatrix as ecs/Components.h (which drags in the renderer).
+struct TransformComponent {
+   glm::vec3 Position = glm::vec3(0.0f);
+   glm::vec3 Rotation = glm::vec3(0.0f);
+   glm::quat RotationQ = glm::quat(1, 0, 0, 0);
+   glm::vec3 Scale = glm::vec3(1.0f);
+   bool UseQuatRotation = false;
+   glm::mat4 LocalMatrix = glm::mat4(1.0f);
+   glm::mat4 WorldMatrix = glm::mat4(1.0f);
+   bool TransformDirty = true;
+
+   glm::mat4 CalculateLocalMatrix() {
+      const glm::mat4 translation = glm::translate(glm::mat4(1.0f), Position);
+      const glm::mat4 rotation = UseQuatRotation
+         ? glm::toMat4(glm::normalize(RotationQ))
+         : glm::yawPitchRoll(glm::radians(Rotation.y), glm::radians(Rotation.x), glm::radians(Rotation.z));
+      const glm::mat4 scale = glm::scale(glm::mat4(1.0f), Scale);
+      LocalMatrix = translation * rotation * scale;
+      return LocalMatrix;
+      }
+   };
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using EntityId = uint32_t;
+constexpr EntityId kNone = static_cast<EntityId>(-1);
+
+// Roughly the footprint of EntityData: the transform plus a name, hierarchy links and
+// a couple dozen component pointers, so hash-map nodes are as sparse as in the engine.
+struct EntityRecord {
+   std::string Name;
+   TransformComponent Transform;
+   EntityId Parent = kNone;
+   std::vector<EntityId> Children;
+   std::array<std::unique_ptr<int>, 20> Components;
+   };
+
+struct World {
+   std::unordered_map<EntityId, EntityRecord> Entities;
+   std::vector<std::vector<EntityId>> Levels;
+   TransformStore Store;
+
+   EntityId Add(EntityId parent, size_t depth, uint32_t seed) {
+      const EntityId id = (EntityId)Entities.size() + 1;
+      EntityRecord& r = Entities[id];
+      r.Name = "Bone";
+      r.Parent = parent;
+      r.Transform.Position = glm::vec3(0.1f * (seed % 7), 0.2f, 0.05f * (seed % 3));
+      r.Transform.Rotation = glm::vec3(float(seed % 90), float(seed % 45), 5.0f);
+      r.Transform.UseQuatRotation = (seed & 1) != 0;
+      r.Transform.RotationQ = glm::quat(glm::radians(r.Transform.Rotation));
+      if (parent != kNone) Entities[parent].Children.push_back(id);
+      if (Levels.size() <= depth) Levels.resize(depth + 1);
+      Levels[depth].push_back(id);
+      return id;
+      }
+
+   // Same packing as Scene::RebuildHierarchy.
+   void Pack() {
+      Store.Clear();
+      for (const auto& level : Levels) {
+         Store.BeginLevel();
+         for (EntityId id : level) {
+            EntityRecord& r = Entities.at(id);
+            Store.Add(id, &r.Transform, r.Parent != kNone ? Store.SlotOf(r.Parent) : TransformStore::kNoParent);
+            }
+         }
+      Store.EndRebuild();
+      }
+
+   void MarkAllDirty() { for (auto& kv : Entities) kv.second.Transform.TransformDirty = true; }
+   };
+
+// Pre-store kernel: two hash lookups and a glm TRS build per entity.
+void LegacyUpdate(World& w) {
+   for (const auto& level : w.Levels) {
+      for (EntityId id : level) {
+         auto it = w.Entities.find(id);
+         if (it == w.Entities.end()) continue;
+         TransformComponent& t = it->second.Transform;
+         if (t.TransformDirty) t.CalculateLocalMatrix();
+         if (it->second.Parent != kNone) {
+            auto p = w.Entities.find(it->second.Parent);
+            t.WorldMatrix = p != w.Entities.end() ? p->second.Transform.WorldMatrix * t.LocalMatrix : t.LocalMatrix;
+            }
+         else {
+            t.WorldMatrix = t.LocalMatrix;
+            }
+         t.TransformDirty = false;
+         }
+      }
+   }
+
+// Store kernel, staged and written back exactly like ComposeKernel in Scene.cpp.
+void StoreUpdate(World& w) {
+   TransformStore& store = w.Store;
+   std::vector<uint32_t> edited;
+   for (size_t L = 0; L < store.LevelCount(); ++L) {
+      const uint32_t begin = store.LevelBegin(L), end = store.LevelEnd(L);
+      edited.clear();
+      for (uint32_t s = begin; s < end; ++s) {
+         const TransformComponent& t = *store.Source(s);
+         if (!t.TransformDirty) {
+            std::memcpy(store.Local(s).m, &t.LocalMatrix, sizeof(glm::mat4));
+            continue;
+            }
+         glm::quat q = t.UseQuatRotation ? t.RotationQ
+            : glm::angleAxis(glm::radians(t.Rotation.y), glm::vec3(0, 1, 0))
+            * glm::angleAxis(glm::radians(t.Rotation.x), glm::vec3(1, 0, 0))
+            * glm::angleAxis(glm::radians(t.Rotation.z), glm::vec3(0, 0, 1));
+         const float quat[4] = { q.x, q.y, q.z, q.w };
+         store.SetLocalTRS(s, &t.Position.x, quat, &t.Scale.x);
+         edited.push_back(s);
+         }
+      store.ComposeLocal(edited.data(), edited.size());
+      store.ComposeWorldRange(begin, end);
+      for (uint32_t s = begin; s < end; ++s) {
+         TransformComponent& t = *store.Source(s);
+         std::memcpy(&t.LocalMatrix, store.Local(s).m, sizeof(glm::mat4));
+         std::memcpy(&t.WorldMatrix, store.World(s).m, sizeof(glm::mat4));
+         t.TransformDirty = false;
+         }
+      }
+   }
+
+template<class F>
+double NsPerEntity(World& w, F&& update, size_t frames) {
+   w.MarkAllDirty();
+   update(w); // warm-up
+   double total = 0.0;
+   for (size_t f = 0; f < frames; ++f) {
+      w.MarkAllDirty();
+      const auto t0 = Clock::now();
+      update(w);
+      total += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+      }
+   return total / double(frames) / double(w.Entities.size());
+   }
+
+double MaxWorldError(World& w) {
+   // Run the legacy path into a copy of every world matrix, then the store path, and compare.
+   w.MarkAllDirty();
+   LegacyUpdate(w);
+   std::unordered_map<EntityId, glm::mat4> expected;
+   for (auto& kv : w.Entities) expected[kv.first] = kv.second.Transform.WorldMatrix;
+   w.MarkAllDirty();
+   StoreUpdate(w);
+   double err = 0.0;
+   for (auto& kv : w.Entities)
+      for (int c = 0; c < 4; ++c)
+         for (int r = 0; r < 4; ++r)
+            err = std::max(err, (double)std::abs(kv.second.Transform.WorldMatrix[c][r] - expected[kv.first][c][r]));
+   return err;
+   }
+
+void Report(const char* name, World& w, size_t frames) {
+   w.Pack();
+   const double err = MaxWorldError(w);
+   const double legacy = NsPerEntity(w, LegacyUpdate, frames);
+   const double packed = NsPerEntity(w, StoreUpdate, frames);
+   std::printf("%-34s %8zu %12.2f %12.2f %7.2fx   (max |dW| %.2g)\n",
+      name, w.Entities.size(), legacy, packed, legacy / packed, err);
+   }
+
+} // namespace
+
+int main(int argc, char** argv) {
+   const size_t frames = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 50;
+
+   std::printf("kernel: %s, frames: %zu\n", TransformStore::KernelName(), frames);
+   std::printf("%-34s %8s %12s %12s %8s\n", "", "entities", "legacy ns/e", "store ns/e", "speedup");
+
+      {
+      World flat;
+      for (uint32_t i = 0; i < 50000; ++i) flat.Add(kNone, 0, i);
+      Report("flat (50k roots)", flat, frames);
+      }
+
+      {
+      // 1000 skeletons: a root with five 10-bone chains (spine, limbs, head).
+      World deep;
+      uint32_t seed = 0;
+      for (int s = 0; s < 1000; ++s) {
+         const EntityId root = deep.Add(kNone, 0, seed++);
+         for (int chain = 0; chain < 5; ++chain) {
+            EntityId parent = root;
+            for (size_t d = 1; d <= 10; ++d) parent = deep.Add(parent, d, seed++);
+            }
+         }
+      Report("skeletons (1000 x 51 bones, 10 deep)", deep, frames);
+      }
+   return 0;
+}
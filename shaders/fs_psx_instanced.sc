@@ -0,0 +1,21 @@
+$input v_texcoord0, v_color0
+$output
+
+#include <bgfx_shader.sh>
+
+SAMPLER2D(s_albedo, 0);
+uniform vec4 u_psxParams; // x=jitter_amp_px, y=affine_factor
+
+// fs_psx with the tint coming from the instance (v_color0) instead of u_ColorTint
+void main()
+{
+    float aff = clamp(u_psxParams.y, 0.0, 1.0);
+    vec2 uv = v_texcoord0;
+    float stepUV = mix(0.0, 1.0/64.0, aff);
+    if (stepUV > 0.0) {
+        uv = floor(uv / stepUV + 0.5) * stepUV;
+    }
+
+    vec4 c = texture2D(s_albedo, uv) * v_color0;
+    gl_FragColor = c;
+}
@@ -0,0 +1,21 @@
+// Normal map sampling shared by every shader.
+//
+// Normal maps are cooked to BC5 (see TextureCooker), which stores only X and Y; the
+// blue channel samples as 0. Any shader that reads a normal map, hand-written ones
+// included, must decode it with clayUnpackNormal() rather than texel.xyz * 2 - 1:
+//
+//   #include "normal_map.sh"
+//   vec3 n = clayUnpackNormal(texture2D(s_normalMap, v_texcoord0.xy));
+//
+// Z is rebuilt from the unit length, so the result is the same for BC5, ASTC and RGBA8.
+// Unified shaders (ShaderImporter) get this include in their fragment stage automatically.
+
+#ifndef CLAY_NORMAL_MAP_SH
+#define CLAY_NORMAL_MAP_SH
+
+vec3 clayUnpackNormal(vec4 texel) {
+    vec2 xy = texel.xy * 2.0 - 1.0;
+    return vec3(xy, sqrt(clamp(1.0 - dot(xy, xy), 0.0, 1.0)));
+}
+
+#endif // CLAY_NORMAL_MAP_SH
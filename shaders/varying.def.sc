@@ -6,6 +6,13 @@ ivec4 a_indices      : BLENDINDICES0;
 vec4 a_weight        : BLENDWEIGHT0;
 vec4 a_color0			: COLOR0;   
 
+// Per-instance data for the *_instanced programs: model matrix columns, then tint
+vec4 i_data0      : TEXCOORD7;
+vec4 i_data1      : TEXCOORD6;
+vec4 i_data2      : TEXCOORD5;
+vec4 i_data3      : TEXCOORD4;
+vec4 i_data4      : TEXCOORD3;
+
 vec4 v_color0     : COLOR0;    // For debug colored meshes
 vec3 v_worldPos   : TEXCOORD1; // World-space position for lighting
 vec3 v_normal     : TEXCOORD2; // Normal vector
@@ -0,0 +1,21 @@
+$input a_position, a_normal, a_texcoord0, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_worldPos, v_normal, v_texcoord0, v_viewDir, v_color0
+
+#include <bgfx_shader.sh>
+
+uniform vec4 u_cameraPos;
+
+// Same as vs_pbr, with the model matrix and tint taken from the instance data buffer
+void main()
+{
+    mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+    vec4 worldPos = mul(model, vec4(a_position, 1.0));
+
+    v_worldPos = worldPos.xyz;
+    v_normal = normalize(mul((mat3)model, a_normal));
+
+    v_texcoord0.xy = a_texcoord0.xy;
+    v_viewDir  = normalize(u_cameraPos.xyz - worldPos.xyz);
+    v_color0 = i_data4;
+    gl_Position = mul(u_viewProj, worldPos);
+}
@@ -0,0 +1,24 @@
+$input a_position, a_normal, a_texcoord0, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_texcoord0, v_color0
+
+#include <bgfx_shader.sh>
+
+uniform vec4 u_psxParams; // x=jitter_amp_px, y=affine_factor [0..1], z=unused, w=unused
+
+void main()
+{
+    mat4 model = mtxFromCols(i_data0, i_data1, i_data2, i_data3);
+    vec4 wp = mul(model, vec4(a_position, 1.0));
+    vec4 clip = mul(u_viewProj, wp);
+    float px = max(u_psxParams.x, 0.0);
+    if (px > 0.0) {
+        vec2 ndc = clip.xy / max(clip.w, 1e-6);
+        float step = max(px / 540.0, 1e-6);
+        ndc = floor(ndc / step + 0.5) * step;
+        clip.xy = ndc * clip.w;
+    }
+
+    v_texcoord0.xy = a_texcoord0.xy;
+    v_color0 = i_data4;
+    gl_Position = clip;
+}
@@ -58,6 +58,12 @@ float AnimationAsset::Duration() const {
     return maxT;
 }
 
+void AnimationCursor::Bind(const AnimationAsset* a) {
+    if (asset == a && segments.size() == (a ? a->tracks.size() * 3 : 0)) return;
+    asset = a;
+    segments.assign(a ? a->tracks.size() * 3 : 0, 0);
+}
+
 } // namespace animation
 } // namespace cm
 
@@ -59,16 +59,33 @@ struct AssetScriptEventTrack : ITrack { std::vector<AssetScriptEvent> events; As
 // Backward-compatible alias used by some parts of the codebase
 using ScriptEvent = AssetScriptEvent;
 
+struct CompressedClip;
+
 struct AnimationAsset {
     std::string name;
     AnimationAssetMeta meta;
     std::vector<std::unique_ptr<ITrack>> tracks;
+    // Cooked bone tracks (runtime copies from AnimationAssetCache). When set, SampleAsset
+    // reads bones from it and the bone tracks' curves may be empty.
+    std::shared_ptr<const CompressedClip> compressed;
 
     const ITrack* FindTrack(TrackID id) const;
     ITrack* FindTrack(TrackID id);
     float Duration() const; // derived from max key time across all tracks if meta.length == 0
 };
 
+// Per-instance sampling state for one asset: the key segment each curve was last
+// sampled in. Assets are shared between players (AnimationAssetCache) and never
+// written while sampled; each player keeps its own cursor.
+struct AnimationCursor {
+    const AnimationAsset* asset = nullptr;
+    std::vector<int> segments; // 3 per track (t, r, s); property tracks use the first
+
+    // Resets the cursor if it was last used with another asset
+    void Bind(const AnimationAsset* a);
+    int* Track(size_t index) { return segments.data() + index * 3; }
+};
+
 } // namespace animation
 } // namespace cm
 
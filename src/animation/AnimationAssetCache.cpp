@@ -0,0 +1,189 @@
+#include "animation/AnimationAssetCache.h"
+#include "animation/AnimationSerializer.h"
+#include "animation/CompressedClip.h"
+#include "pipeline/AssetLibrary.h"
+#include "jobs/Jobs.h"
+#include <editor/Project.h>
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace cm {
+namespace animation {
+
+namespace {
+
+// Frames an unreferenced entry survives, so a clip that is swapped out and back in
+// (state machines, scene reloads) is not parsed again
+constexpr uint64_t kGraceFrames = 600;
+constexpr uint64_t kPurgeInterval = 120;
+// Update()s between checks of a loaded entry's file for changes
+constexpr uint64_t kRecheckFrames = 60;
+
+std::string CacheKey(const std::string& path) {
+    std::string norm = path;
+    std::replace(norm.begin(), norm.end(), '\\', '/');
+    const ClaymoreGUID guid = AssetLibrary::Instance().GetGUIDForPath(norm);
+    if (guid.high != 0 || guid.low != 0) return guid.ToString();
+    return "path:" + norm;
+}
+
+// Same lookup as the loaders: as given, then relative to the project
+std::filesystem::path ResolveOnDisk(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path p(path);
+    if (std::filesystem::exists(p, ec)) return p;
+    try {
+        const std::filesystem::path base = Project::GetProjectDirectory();
+        if (!base.empty() && std::filesystem::exists(base / p, ec)) return base / p;
+    } catch (...) {}
+    return p;
+}
+
+std::shared_ptr<const AnimationAsset> LoadAsset(const std::string& path) {
+    auto asset = std::make_shared<AnimationAsset>();
+    try {
+        *asset = LoadAnimationAsset(path);
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (asset->tracks.empty() && ext != ".animbin") {
+            AnimationClip legacy = LoadAnimationClip(path);
+            if (!legacy.BoneTracks.empty() || !legacy.HumanoidTracks.empty()) *asset = WrapLegacyClipAsAsset(legacy);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[AnimationAssetCache] Failed to load '" << path << "': " << e.what() << std::endl;
+        *asset = AnimationAsset{};
+    }
+    // Duration() scans every key when no length is authored; settle it while the asset is still private
+    if (asset->meta.length <= 0.0f) asset->meta.length = asset->Duration();
+    // Bones are sampled from the cooked form; keep it, and drop the curves it replaces, when it is smaller
+    if (std::unique_ptr<CompressedClip> cooked = CookCompressedClip(*asset)) {
+        if (cooked->ByteSize() < BoneCurveBytes(*asset)) {
+            for (auto& t : asset->tracks) {
+                if (!t || t->muted || t->type != TrackType::Bone) continue;
+                auto* bt = static_cast<AssetBoneTrack*>(t.get());
+                std::vector<KeyVec3>().swap(bt->t.keys);
+                std::vector<KeyQuat>().swap(bt->r.keys);
+                std::vector<KeyVec3>().swap(bt->s.keys);
+            }
+            asset->compressed = std::move(cooked);
+        }
+    }
+    return asset;
+}
+
+std::shared_ptr<const AnimationClip> LoadClip(const std::string& path) {
+    try {
+        return std::make_shared<AnimationClip>(LoadAnimationClip(path));
+    } catch (const std::exception& e) {
+        std::cerr << "[AnimationAssetCache] Failed to load clip '" << path << "': " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+} // namespace
+
+AnimationAssetCache& AnimationAssetCache::Instance() {
+    static AnimationAssetCache instance;
+    return instance;
+}
+
+template <typename T, typename LoadFn>
+std::shared_ptr<const T> AnimationAssetCache::AcquireEntry(std::unordered_map<std::string, Entry<T>>& entries,
+                                                           const std::string& path, LoadFn loadFn, bool wait)
+{
+    if (path.empty()) return nullptr;
+    const std::string key = CacheKey(path);
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    bool load = false;
+    {
+        Entry<T>& entry = entries[key];
+        entry.LastUsed = m_Frame;
+        const bool settled = !entry.Loading && (entry.Data || entry.Failed);
+        if (!settled) {
+            load = !entry.Loading;
+        } else if (m_Frame - entry.Checked >= kRecheckFrames) {
+            // The stat runs unlocked; the entry is looked up again afterwards
+            entry.Checked = m_Frame;
+            const auto known = entry.Stamp;
+            lock.unlock();
+            std::error_code ec;
+            const auto stamp = std::filesystem::last_write_time(ResolveOnDisk(path), ec);
+            lock.lock();
+            load = !ec && stamp != known;
+        }
+    }
+
+    Entry<T>& entry = entries[key]; // nodes are stable; Purge skips entries being loaded
+    if (load && !entry.Loading) {
+        entry.Loading = true;
+        lock.unlock();
+        auto job = [this, &entry, path, loadFn] {
+            const std::filesystem::path file = ResolveOnDisk(path);
+            std::error_code ec;
+            const auto stamp = std::filesystem::last_write_time(file, ec);
+            std::shared_ptr<const T> data;
+            try {
+                data = loadFn(file.string());
+            } catch (...) {
+                std::cerr << "[AnimationAssetCache] Failed to load '" << path << "'" << std::endl;
+            }
+            std::lock_guard<std::mutex> done(m_Mutex);
+            // A failed reload keeps serving the previous copy; either way it waits for the file to change
+            entry.Failed = !data;
+            if (data) entry.Data = std::move(data);
+            entry.Stamp = stamp;
+            entry.Checked = m_Frame;
+            entry.Loading = false;
+            m_Loaded.notify_all();
+        };
+        if (wait || !Jobs().EnqueueBackground(job)) job();
+        lock.lock();
+    }
+    if (wait) m_Loaded.wait(lock, [&] { return !entry.Loading; });
+    return entry.Data;
+}
+
+std::shared_ptr<const AnimationAsset> AnimationAssetCache::Acquire(const std::string& path) {
+    return AcquireEntry(m_Assets, path, LoadAsset, false);
+}
+
+std::shared_ptr<const AnimationClip> AnimationAssetCache::AcquireClip(const std::string& path) {
+    return AcquireEntry(m_Clips, path, LoadClip, false);
+}
+
+std::shared_ptr<const AnimationAsset> AnimationAssetCache::LoadBlocking(const std::string& path) {
+    return AcquireEntry(m_Assets, path, LoadAsset, true);
+}
+
+template <typename T>
+void AnimationAssetCache::Purge(std::unordered_map<std::string, Entry<T>>& entries, bool all) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        const Entry<T>& e = it->second;
+        const bool unused = !e.Data || e.Data.use_count() == 1;
+        if (!e.Loading && (all || (unused && m_Frame - e.LastUsed > kGraceFrames))) it = entries.erase(it);
+        else ++it;
+    }
+}
+
+void AnimationAssetCache::Update() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (++m_Frame % kPurgeInterval != 0) return;
+    Purge(m_Assets, false);
+    Purge(m_Clips, false);
+}
+
+void AnimationAssetCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Purge(m_Assets, true);
+    Purge(m_Clips, true);
+}
+
+size_t AnimationAssetCache::Size() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Assets.size() + m_Clips.size();
+}
+
+} // namespace animation
+} // namespace cm
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "animation/AnimationAsset.h"
+#include "animation/AnimationTypes.h"
+
+namespace cm {
+namespace animation {
+
+// -----------------------------------------------------------------------------
+// Process-wide store of loaded animation data: one immutable copy per source
+// asset, shared by every player of the clip. Entries are keyed by the asset's GUID
+// (AssetLibrary), or by the normalized path for files the library does not know,
+// so different spellings of a path still share. Files are parsed on a job;
+// Acquire() returns null until the load has finished, so the first frames of a
+// new clip are skipped rather than stalled.
+//
+// Callers keep the returned shared_ptr for as long as they sample the data. Entries
+// nobody holds are dropped by Update() after a grace period. Once an entry has
+// loaded (or failed to), Acquire serves it without touching the disk and re-reads
+// the file's write time only every so many Update()s; a changed file is reloaded
+// then, and holders of the old copy keep it. A load that fails is not retried until
+// the file changes.
+// Sampling state lives with the sampler (AnimationCursor), never in the asset.
+// Bone tracks are cooked to a CompressedClip on load when that is smaller than
+// their curves, which are then dropped from the shared copy.
+// -----------------------------------------------------------------------------
+class AnimationAssetCache {
+public:
+    static AnimationAssetCache& Instance();
+
+    // Unified asset (.anim, .animbin); a legacy skeletal clip at the path is wrapped
+    // (WrapLegacyClipAsAsset). Null while loading; a missing file yields an empty asset.
+    std::shared_ptr<const AnimationAsset> Acquire(const std::string& path);
+    // Legacy AnimationClip, for controller states that only name a ClipPath
+    std::shared_ptr<const AnimationClip> AcquireClip(const std::string& path);
+    // As Acquire, but loads on the calling thread or waits for the running load
+    std::shared_ptr<const AnimationAsset> LoadBlocking(const std::string& path);
+
+    // Main thread, once per frame: ages entries and drops those nobody holds
+    void Update();
+    // Drops every entry not being loaded; holders keep their copies
+    void Clear();
+    size_t Size() const;
+
+private:
+    AnimationAssetCache() = default;
+
+    template <typename T>
+    struct Entry {
+        std::shared_ptr<const T> Data;
+        std::filesystem::file_time_type Stamp{};
+        uint64_t LastUsed = 0;          // Update() count at the last Acquire
+        uint64_t Checked = 0;           // Update() count when Stamp was last compared with the file
+        bool Loading = false;
+        bool Failed = false;            // last load threw or produced nothing
+    };
+
+    template <typename T, typename LoadFn>
+    std::shared_ptr<const T> AcquireEntry(std::unordered_map<std::string, Entry<T>>& entries,
+                                          const std::string& path, LoadFn loadFn, bool wait);
+    template <typename T>
+    void Purge(std::unordered_map<std::string, Entry<T>>& entries, bool all);
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Loaded;
+    std::unordered_map<std::string, Entry<AnimationAsset>> m_Assets;
+    std::unordered_map<std::string, Entry<AnimationClip>> m_Clips;
+    uint64_t m_Frame = 0;
+};
+
+} // namespace animation
+} // namespace cm
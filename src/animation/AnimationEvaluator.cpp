@@ -7,6 +7,7 @@
 #include "animation/AvatarDefinition.h"
 #include "animation/AnimationAsset.h"
 #include "animation/BindingCache.h"
+#include "animation/CompressedClip.h"
 #include "animation/Retargeting.h"
 #include "ecs/AnimationComponents.h" // for SkeletonComponent::BoneNameToIndex
 #include <nlohmann/json.hpp>
@@ -95,6 +96,59 @@ void EvaluateAnimation(const AnimationClip& clip,
 namespace cm {
 namespace animation {
 
+namespace {
+
+// Skeleton bone for a track name, tolerating namespace prefixes ("mixamorig:", "Armature|")
+int ResolveBoneIndex(const ::SkeletonComponent& skeleton, const std::string& name)
+{
+    int idx = skeleton.GetBoneIndex(name);
+    if (idx >= 0) return idx;
+    // Try suffix after common namespace separators
+    size_t pos = name.find_last_of(':');
+    if (pos != std::string::npos && pos + 1 < name.size()) {
+        idx = skeleton.GetBoneIndex(name.substr(pos + 1));
+        if (idx >= 0) return idx;
+    }
+    pos = name.find_last_of('|');
+    if (pos != std::string::npos && pos + 1 < name.size()) {
+        idx = skeleton.GetBoneIndex(name.substr(pos + 1));
+        if (idx >= 0) return idx;
+    }
+    pos = name.find_last_of('.');
+    if (pos != std::string::npos && pos + 1 < name.size()) {
+        idx = skeleton.GetBoneIndex(name.substr(pos + 1));
+        if (idx >= 0) return idx;
+    }
+    // Final fallback: suffix match against known bone names
+    for (const auto& kv : skeleton.BoneNameToIndex) {
+        const std::string& skName = kv.first;
+        if (skName.size() >= name.size()) {
+            if (skName.compare(skName.size() - name.size(), name.size(), name) == 0) return kv.second;
+        } else {
+            if (name.compare(name.size() - skName.size(), skName.size(), skName) == 0) return kv.second;
+        }
+    }
+    return -1;
+}
+
+// False for bones the context's LOD mask leaves at their bind local
+bool BoneSampled(const EvalContext& ctx, int boneIndex)
+{
+    return !ctx.boneMask || boneIndex < 0 || boneIndex >= (int)ctx.boneMask->size() || (*ctx.boneMask)[boneIndex];
+}
+
+void WriteBone(PoseBuffer& pose, int boneIndex, const glm::vec3& pos, const glm::quat& rot, const glm::vec3& scl)
+{
+    if (boneIndex < 0) return;
+    const size_t bi = static_cast<size_t>(boneIndex);
+    if (bi >= pose.local.size()) pose.local.resize(bi + 1, glm::mat4(1.0f));
+    if (bi >= pose.touched.size()) pose.touched.resize(bi + 1, false);
+    pose.local[bi] = glm::translate(pos) * glm::mat4_cast(rot) * glm::scale(scl);
+    pose.touched[bi] = true;
+}
+
+} // namespace
+
 void SampleAsset(const EvalInputs& in, const EvalContext& ctx, EvalTargets& out,
                  std::vector<ScriptEvent>* firedEvents, nlohmann::json* propertyWrites)
 {
@@ -108,9 +162,28 @@ void SampleAsset(const EvalInputs& in, const EvalContext& ctx, EvalTargets& out,
         std::fill(out.pose->touched.begin(), out.pose->touched.end(), false);
     }
 
-    for (const auto& uptr : in.asset->tracks) {
+    // Cooked bone tracks: every bone from one batched decode at t
+    const CompressedClip* cooked = in.asset->compressed.get();
+    if (cooked && out.pose) {
+        thread_local CompressedSample s_sample;
+        SampleCompressed(*cooked, t, s_sample);
+        for (const CompressedClip::Track& track : cooked->tracks) {
+            const ITrack* base = in.asset->tracks[track.assetTrack].get();
+            int boneIndex = static_cast<const AssetBoneTrack*>(base)->boneId;
+            if (boneIndex < 0 && ctx.skeleton && !base->name.empty()) boneIndex = ResolveBoneIndex(*ctx.skeleton, base->name);
+            if (boneIndex < 0 || !BoneSampled(ctx, boneIndex)) continue;
+            glm::vec3 pos, scl; glm::quat rot;
+            CompressedTrackTRS(*cooked, s_sample, track, pos, rot, scl);
+            WriteBone(*out.pose, boneIndex, pos, rot, scl);
+        }
+    }
+
+    if (in.cursor) in.cursor->Bind(in.asset);
+    for (size_t ti = 0; ti < in.asset->tracks.size(); ++ti) {
+        const auto& uptr = in.asset->tracks[ti];
         if (!uptr || uptr->muted) continue;
         const ITrack* base = uptr.get();
+        int* seg = in.cursor ? in.cursor->Track(ti) : nullptr;
         switch (base->type) {
             case TrackType::Avatar: {
                 if (!out.pose || !ctx.avatar || !ctx.skeleton) break;
@@ -130,53 +203,17 @@ void SampleAsset(const EvalInputs& in, const EvalContext& ctx, EvalTargets& out,
                 }
             } break;
             case TrackType::Bone: {
-                if (!out.pose) break;
+                if (!out.pose || cooked) break;
                 const auto* bt = static_cast<const AssetBoneTrack*>(base);
-                glm::vec3 pos = bt->t.keys.empty() ? glm::vec3(0.0f) : bt->t.Sample(t, in.loop, clipLen);
-                glm::quat rot = bt->r.keys.empty() ? glm::quat(1,0,0,0) : bt->r.Sample(t, in.loop, clipLen);
-                glm::vec3 scl = bt->s.keys.empty() ? glm::vec3(1.0f) : bt->s.Sample(t, in.loop, clipLen);
                 int boneIndex = bt->boneId;
-                auto tryResolveBone = [&](const std::string& name) -> int {
-                    if (!ctx.skeleton) return -1;
-                    int idx = ctx.skeleton->GetBoneIndex(name);
-                    if (idx >= 0) return idx;
-                    // Try suffix after common namespace separators
-                    size_t pos = name.find_last_of(':');
-                    if (pos != std::string::npos && pos + 1 < name.size()) {
-                        idx = ctx.skeleton->GetBoneIndex(name.substr(pos + 1));
-                        if (idx >= 0) return idx;
-                    }
-                    pos = name.find_last_of('|');
-                    if (pos != std::string::npos && pos + 1 < name.size()) {
-                        idx = ctx.skeleton->GetBoneIndex(name.substr(pos + 1));
-                        if (idx >= 0) return idx;
-                    }
-                    pos = name.find_last_of('.');
-                    if (pos != std::string::npos && pos + 1 < name.size()) {
-                        idx = ctx.skeleton->GetBoneIndex(name.substr(pos + 1));
-                        if (idx >= 0) return idx;
-                    }
-                    // Final fallback: suffix match against known bone names
-                    for (const auto& kv : ctx.skeleton->BoneNameToIndex) {
-                        const std::string& skName = kv.first;
-                        if (skName.size() >= name.size()) {
-                            if (skName.compare(skName.size() - name.size(), name.size(), name) == 0) return kv.second;
-                        } else {
-                            if (name.compare(name.size() - skName.size(), skName.size(), skName) == 0) return kv.second;
-                        }
-                    }
-                    return -1;
-                };
                 if (boneIndex < 0 && ctx.skeleton && !base->name.empty()) {
-                    boneIndex = tryResolveBone(base->name);
-                }
-                if (boneIndex >= 0) {
-                    const size_t bi = static_cast<size_t>(boneIndex);
-                    if (bi >= out.pose->local.size()) out.pose->local.resize(bi + 1, glm::mat4(1.0f));
-                    if (bi >= out.pose->touched.size()) out.pose->touched.resize(bi + 1, false);
-                    out.pose->local[bi] = glm::translate(pos) * glm::mat4_cast(rot) * glm::scale(scl);
-                    out.pose->touched[bi] = true;
+                    boneIndex = ResolveBoneIndex(*ctx.skeleton, base->name);
                 }
+                if (!BoneSampled(ctx, boneIndex)) break;
+                glm::vec3 pos = bt->t.keys.empty() ? glm::vec3(0.0f) : bt->t.Sample(t, in.loop, clipLen, seg);
+                glm::quat rot = bt->r.keys.empty() ? glm::quat(1,0,0,0) : bt->r.Sample(t, in.loop, clipLen, seg ? seg + 1 : nullptr);
+                glm::vec3 scl = bt->s.keys.empty() ? glm::vec3(1.0f) : bt->s.Sample(t, in.loop, clipLen, seg ? seg + 2 : nullptr);
+                WriteBone(*out.pose, boneIndex, pos, rot, scl);
             } break;
             case TrackType::Property: {
                 if (!propertyWrites || !ctx.bindings) break;
@@ -185,23 +222,23 @@ void SampleAsset(const EvalInputs& in, const EvalContext& ctx, EvalTargets& out,
                 const std::string key = std::to_string(id);
                 switch (pt->binding.type) {
                     case PropertyType::Float: {
-                        float v = std::get<CurveFloat>(pt->curve).Sample(t, in.loop, clipLen);
+                        float v = std::get<CurveFloat>(pt->curve).Sample(t, in.loop, clipLen, seg);
                         (*propertyWrites)[key] = v;
                     } break;
                     case PropertyType::Vec2:  {
-                        glm::vec2 v = std::get<CurveVec2>(pt->curve).Sample(t, in.loop, clipLen);
+                        glm::vec2 v = std::get<CurveVec2>(pt->curve).Sample(t, in.loop, clipLen, seg);
                         (*propertyWrites)[key] = { v.x, v.y };
                     } break;
                     case PropertyType::Vec3:  {
-                        glm::vec3 v = std::get<CurveVec3>(pt->curve).Sample(t, in.loop, clipLen);
+                        glm::vec3 v = std::get<CurveVec3>(pt->curve).Sample(t, in.loop, clipLen, seg);
                         (*propertyWrites)[key] = { v.x, v.y, v.z };
                     } break;
                     case PropertyType::Quat:  {
-                        glm::quat v = std::get<CurveQuat>(pt->curve).Sample(t, in.loop, clipLen);
+                        glm::quat v = std::get<CurveQuat>(pt->curve).Sample(t, in.loop, clipLen, seg);
                         (*propertyWrites)[key] = { v.x, v.y, v.z, v.w };
                     } break;
                     case PropertyType::Color: {
-                        glm::vec4 v = std::get<CurveColor>(pt->curve).Sample(t, in.loop, clipLen);
+                        glm::vec4 v = std::get<CurveColor>(pt->curve).Sample(t, in.loop, clipLen, seg);
                         (*propertyWrites)[key] = { v.x, v.y, v.z, v.w };
                     } break;
                 }
@@ -240,3 +277,264 @@ void SampleAsset(const EvalInputs& in,
 }
 } }
 
+
+// ================= Per-skeleton pose evaluation =================
+namespace cm { namespace animation {
+
+void decomposeTRS(const glm::mat4& m, glm::vec3& T, glm::quat& R, glm::vec3& S) {
+    T = glm::vec3(m[3]);
+    glm::vec3 X = glm::vec3(m[0]);
+    glm::vec3 Y = glm::vec3(m[1]);
+    glm::vec3 Z = glm::vec3(m[2]);
+    S = glm::vec3(glm::length(X), glm::length(Y), glm::length(Z));
+    if (S.x > 1e-6f) X /= S.x;
+    if (S.y > 1e-6f) Y /= S.y;
+    if (S.z > 1e-6f) Z /= S.z;
+    glm::mat3 rotMat(X, Y, Z);
+    R = glm::quat_cast(rotMat);
+}
+
+void ComputeBindLocals(const ::SkeletonComponent& skeleton, std::vector<glm::mat4>& outBindLocals)
+{
+    const size_t n = skeleton.BoneEntities.size();
+    outBindLocals.assign(n, glm::mat4(1.0f));
+    for (size_t i = 0; i < n && i < skeleton.InverseBindPoses.size(); ++i) {
+        const glm::mat4 globalBind = glm::inverse(skeleton.InverseBindPoses[i]);
+        const int parent = (i < skeleton.BoneParents.size()) ? skeleton.BoneParents[i] : -1;
+        const glm::mat4 parentGlobal = (parent >= 0 && parent < (int)skeleton.InverseBindPoses.size()) ? glm::inverse(skeleton.InverseBindPoses[parent]) : glm::mat4(1.0f);
+        outBindLocals[i] = glm::inverse(parentGlobal) * globalBind;
+    }
+}
+
+namespace {
+
+// Samples one asset/clip into 'out' (identity where nothing is animated), then replaces
+// bones left at identity / untouched with their bind local.
+void SampleInto(const PoseSample& s, const ::SkeletonComponent& skeleton, const std::vector<glm::mat4>& bindLocals,
+                const std::vector<uint8_t>* boneMask, PoseBuffer& out, std::vector<ScriptEvent>* firedEvents)
+{
+    const size_t n = skeleton.BoneEntities.size();
+    out.local.assign(n, glm::mat4(1.0f));
+    out.touched.assign(n, false);
+    bool useTouched = false;
+    if (s.asset) {
+        EvalInputs in{ s.asset, s.time, s.loop, s.cursor };
+        EvalTargets tgt{ &out };
+        EvalContext ctx{ nullptr, skeleton.Avatar.get(), &skeleton, boneMask };
+        SampleAsset(in, ctx, tgt, firedEvents, nullptr);
+        useTouched = true;
+    } else if (s.clip) {
+        EvaluateAnimation(*s.clip, s.time, skeleton, out.local);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const bool animated = useTouched ? (i < out.touched.size() && out.touched[i]) : out.local[i] != glm::mat4(1.0f);
+        if (!animated) out.local[i] = (i < bindLocals.size()) ? bindLocals[i] : glm::mat4(1.0f);
+    }
+}
+
+glm::mat4 BlendLocal(const glm::mat4& a, const glm::mat4& b, float t)
+{
+    glm::vec3 T0, S0, T1, S1; glm::quat R0, R1;
+    decomposeTRS(a, T0, R0, S0);
+    decomposeTRS(b, T1, R1, S1);
+    glm::vec3 T = glm::mix(T0, T1, t);
+    glm::quat R = glm::slerp(R0, R1, t);
+    glm::vec3 S = glm::mix(S0, S1, t);
+    return glm::translate(T) * glm::mat4_cast(glm::normalize(R)) * glm::scale(S);
+}
+
+void BlendLocals(std::vector<glm::mat4>& a, const std::vector<glm::mat4>& b, float t, const std::vector<uint8_t>* boneMask)
+{
+    const size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (boneMask && i < boneMask->size() && !(*boneMask)[i]) continue; // bind local on both sides
+        a[i] = BlendLocal(a[i], b[i], t);
+    }
+}
+
+// Humanoid constraint for a bone other than root/hips: bind T/S, animated rotation
+glm::mat4 HumanoidLocal(const glm::mat4& animated, const glm::mat4& bindLocal)
+{
+    glm::vec3 Ta, Sa; glm::quat Ra;
+    decomposeTRS(animated, Ta, Ra, Sa);
+    glm::vec3 Tb, Sb; glm::quat Rb; // Rb unused
+    decomposeTRS(bindLocal, Tb, Rb, Sb);
+    return glm::translate(Tb) * glm::mat4_cast(glm::normalize(Ra)) * glm::scale(Sb);
+}
+
+// SampleInto for the bones in 'bones' alone: out[j] is the local of bones[j], its bind
+// local where the sample does not drive it. Bone tracks are read one at a time (cooked
+// ones without the whole-skeleton decode, stopping once every bone is found);
+// retargeted assets and legacy clips take the full SampleInto.
+void SampleBones(const PoseSample& s, const ::SkeletonComponent& skeleton, const std::vector<glm::mat4>& bindLocals,
+                 const std::vector<int>& bones, std::vector<glm::mat4>& out)
+{
+    out.resize(bones.size());
+    for (size_t j = 0; j < bones.size(); ++j)
+        out[j] = (bones[j] < (int)bindLocals.size()) ? bindLocals[bones[j]] : glm::mat4(1.0f);
+    auto slotOf = [&](int bone) -> int {
+        for (size_t j = 0; bone >= 0 && j < bones.size(); ++j) if (bones[j] == bone) return (int)j;
+        return -1;
+    };
+
+    auto boneOf = [&](const ITrack* base, int boneId) {
+        return (boneId < 0 && !base->name.empty()) ? ResolveBoneIndex(skeleton, base->name) : boneId;
+    };
+
+    bool whole = s.clip != nullptr;
+    if (s.asset) {
+        const AnimationAsset& asset = *s.asset;
+        const CompressedClip* cooked = asset.compressed.get();
+        const float clipLen = asset.Duration();
+        float t = s.time;
+        if (s.loop && clipLen > 0.0f) t = std::fmod(std::fmod(t, clipLen) + clipLen, clipLen);
+        if (cooked && !(cooked->retargeted && skeleton.Avatar)) {
+            size_t found = 0;
+            for (const CompressedClip::Track& track : cooked->tracks) {
+                const int j = slotOf(boneOf(asset.tracks[track.assetTrack].get(), track.boneId));
+                if (j < 0) continue;
+                glm::vec3 pos, scl; glm::quat rot;
+                SampleCompressedTrack(*cooked, track, t, pos, rot, scl);
+                out[j] = glm::translate(pos) * glm::mat4_cast(rot) * glm::scale(scl);
+                if (++found == bones.size()) break;
+            }
+        } else if (!cooked) {
+            if (s.cursor) s.cursor->Bind(s.asset);
+            for (size_t ti = 0; ti < asset.tracks.size() && !whole; ++ti) {
+                const ITrack* base = asset.tracks[ti].get();
+                if (!base || base->muted) continue;
+                if (base->type == TrackType::Avatar) { whole = skeleton.Avatar != nullptr; continue; }
+                if (base->type != TrackType::Bone) continue;
+                const auto* bt = static_cast<const AssetBoneTrack*>(base);
+                const int j = slotOf(boneOf(base, bt->boneId));
+                if (j < 0) continue;
+                int* seg = s.cursor ? s.cursor->Track(ti) : nullptr;
+                const glm::vec3 pos = bt->t.keys.empty() ? glm::vec3(0.0f) : bt->t.Sample(t, s.loop, clipLen, seg);
+                const glm::quat rot = bt->r.keys.empty() ? glm::quat(1,0,0,0) : bt->r.Sample(t, s.loop, clipLen, seg ? seg + 1 : nullptr);
+                const glm::vec3 scl = bt->s.keys.empty() ? glm::vec3(1.0f) : bt->s.Sample(t, s.loop, clipLen, seg ? seg + 2 : nullptr);
+                out[j] = glm::translate(pos) * glm::mat4_cast(rot) * glm::scale(scl);
+            }
+        } else {
+            whole = true;
+        }
+    }
+    if (whole) {
+        thread_local PoseBuffer s_whole;
+        SampleInto(s, skeleton, bindLocals, nullptr, s_whole, nullptr);
+        for (size_t j = 0; j < bones.size(); ++j)
+            if (bones[j] < (int)s_whole.local.size()) out[j] = s_whole.local[bones[j]];
+    }
+}
+
+} // namespace
+
+void EvaluatePose(const PoseEvalDesc& desc, const ::SkeletonComponent& skeleton,
+                  const std::vector<glm::mat4>& bindLocals, PoseBuffer& pose,
+                  std::vector<ScriptEvent>* firedEvents)
+{
+    // Per-worker scratch for the second sample of a blend/crossfade
+    thread_local PoseBuffer s_scratch;
+
+    const std::vector<uint8_t>* mask = desc.boneMask;
+    if (desc.blendWeight >= 0.0f) {
+        SampleInto(desc.primary, skeleton, bindLocals, mask, pose, nullptr);
+        SampleInto(desc.blend, skeleton, bindLocals, mask, s_scratch, nullptr);
+        BlendLocals(pose.local, s_scratch.local, desc.blendWeight, mask);
+    } else {
+        SampleInto(desc.primary, skeleton, bindLocals, mask, pose, firedEvents);
+    }
+
+    if (desc.crossfadeAlpha >= 0.0f) {
+        SampleInto(desc.crossfade, skeleton, bindLocals, mask, s_scratch, nullptr);
+        BlendLocals(pose.local, s_scratch.local, desc.crossfadeAlpha, mask);
+    }
+
+    // Humanoid constraint: keep translation/scale only on root/hips; others use bind T/S, animated rotation
+    if (skeleton.Avatar) {
+        const int hipsIdx = skeleton.Avatar->GetMappedBoneIndex(HumanoidBone::Hips);
+        const int rootIdx = skeleton.Avatar->GetMappedBoneIndex(HumanoidBone::Root);
+        for (int i = 0; i < (int)pose.local.size(); ++i) {
+            if (i == hipsIdx || i == rootIdx) continue;
+            if (mask && i < (int)mask->size() && !(*mask)[i]) continue;
+            pose.local[i] = HumanoidLocal(pose.local[i], (i < (int)bindLocals.size()) ? bindLocals[i] : glm::mat4(1.0f));
+        }
+    }
+}
+
+glm::vec3 EvaluateBoneModelPosition(const PoseEvalDesc& desc, const ::SkeletonComponent& skeleton,
+                                    const std::vector<glm::mat4>& bindLocals, int bone)
+{
+    thread_local std::vector<int> s_chain, s_sampled;
+    thread_local std::vector<glm::mat4> s_locals, s_other;
+
+    const int n = (int)skeleton.BoneEntities.size();
+    if (bone < 0 || bone >= n) return glm::vec3(0.0f);
+
+    // The bone and its ancestors; those desc.boneMask leaves at bind are not sampled,
+    // so the result matches EvaluatePose
+    s_chain.clear();
+    s_sampled.clear();
+    for (int b = bone, guard = 0; b >= 0 && b < n && guard < n; ++guard) {
+        s_chain.push_back(b);
+        if (!desc.boneMask || b >= (int)desc.boneMask->size() || (*desc.boneMask)[b]) s_sampled.push_back(b);
+        b = (b < (int)skeleton.BoneParents.size()) ? skeleton.BoneParents[b] : -1;
+    }
+
+    SampleBones(desc.primary, skeleton, bindLocals, s_sampled, s_locals);
+    if (desc.blendWeight >= 0.0f) {
+        SampleBones(desc.blend, skeleton, bindLocals, s_sampled, s_other);
+        for (size_t j = 0; j < s_sampled.size(); ++j) s_locals[j] = BlendLocal(s_locals[j], s_other[j], desc.blendWeight);
+    }
+    if (desc.crossfadeAlpha >= 0.0f) {
+        SampleBones(desc.crossfade, skeleton, bindLocals, s_sampled, s_other);
+        for (size_t j = 0; j < s_sampled.size(); ++j) s_locals[j] = BlendLocal(s_locals[j], s_other[j], desc.crossfadeAlpha);
+    }
+    if (skeleton.Avatar) {
+        const int hipsIdx = skeleton.Avatar->GetMappedBoneIndex(HumanoidBone::Hips);
+        const int rootIdx = skeleton.Avatar->GetMappedBoneIndex(HumanoidBone::Root);
+        for (size_t j = 0; j < s_sampled.size(); ++j) {
+            const int b = s_sampled[j];
+            if (b == hipsIdx || b == rootIdx) continue;
+            s_locals[j] = HumanoidLocal(s_locals[j], (b < (int)bindLocals.size()) ? bindLocals[b] : glm::mat4(1.0f));
+        }
+    }
+
+    // Compose from the bone up; s_sampled is s_chain in the same order minus masked bones
+    glm::mat4 model(1.0f);
+    for (size_t i = 0, j = 0; i < s_chain.size(); ++i) {
+        const int b = s_chain[i];
+        if (j < s_sampled.size() && s_sampled[j] == b) model = s_locals[j++] * model;
+        else model = ((b < (int)bindLocals.size()) ? bindLocals[b] : glm::mat4(1.0f)) * model;
+    }
+    return glm::vec3(model[3]);
+}
+
+void CollectScriptEvents(const AnimationAsset& asset, float from, float to, std::vector<ScriptEvent>& out)
+{
+    const bool wrapped = to < from;
+    for (const auto& uptr : asset.tracks) {
+        if (!uptr || uptr->muted || uptr->type != TrackType::ScriptEvent) continue;
+        for (const auto& e : static_cast<const AssetScriptEventTrack*>(uptr.get())->events) {
+            const bool crossed = wrapped ? (e.time > from || e.time <= to) : (e.time > from && e.time <= to);
+            if (crossed) out.push_back(e);
+        }
+    }
+}
+
+void ComputeModelPose(PoseBuffer& pose, const std::vector<int>& parents)
+{
+    const int n = (int)pose.local.size();
+    pose.model.resize(pose.local.size());
+    for (int i = 0; i < n; ++i) {
+        const int p = (i < (int)parents.size()) ? parents[i] : -1;
+        if (p < 0 || p >= n) { pose.model[i] = pose.local[i]; continue; }
+        if (p < i) { pose.model[i] = pose.model[p] * pose.local[i]; continue; }
+        // Parent stored after the child (not produced by the importer): walk the chain
+        glm::mat4 m = pose.local[i];
+        for (int q = p, guard = 0; q >= 0 && q < n && guard < n; q = (q < (int)parents.size()) ? parents[q] : -1, ++guard)
+            m = pose.local[q] * m;
+        pose.model[i] = m;
+    }
+}
+
+} }
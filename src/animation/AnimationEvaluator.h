@@ -11,6 +11,7 @@
 // New unified interfaces
 #include "animation/AnimationAsset.h"
 #include "animation/BindingCache.h"
+#include "animation/PoseBuffer.h"
 
 struct SkeletonComponent; // forward
 
@@ -28,11 +29,13 @@ void EvaluateAnimation(const AnimationClip& clip,
                        const AvatarDefinition* avatar = nullptr);
 
 // Unified evaluator API
-struct PoseBuffer { std::vector<glm::mat4> local; std::vector<bool> touched; };
-struct EvalInputs { const AnimationAsset* asset = nullptr; float time = 0.0f; bool loop = true; };
+// 'cursor' (optional) is the caller's segment state for 'asset'; without one every curve is searched
+struct EvalInputs { const AnimationAsset* asset = nullptr; float time = 0.0f; bool loop = true; AnimationCursor* cursor = nullptr; };
 struct EvalTargets { PoseBuffer* pose = nullptr; };
 struct AvatarDefinition; // forward
-struct EvalContext { const BindingCache* bindings = nullptr; const AvatarDefinition* avatar = nullptr; const ::SkeletonComponent* skeleton = nullptr; };
+// 'boneMask' (optional, per skeleton bone): bones at 0 are not sampled (animation LOD)
+struct EvalContext { const BindingCache* bindings = nullptr; const AvatarDefinition* avatar = nullptr; const ::SkeletonComponent* skeleton = nullptr;
+                     const std::vector<uint8_t>* boneMask = nullptr; };
 
 void SampleAsset(const EvalInputs&, const EvalContext&, EvalTargets& out,
                  std::vector<ScriptEvent>* firedEvents = nullptr, nlohmann::json* propertyWrites = nullptr);
@@ -43,5 +46,46 @@ void SampleAsset(const EvalInputs&, const EvalContext&, PoseBuffer& outPose,
                  std::vector<ScriptEvent>* outEvents = nullptr,
                  std::vector<PropertyWrite>* outProps = nullptr);
 
+// ---------------- Per-skeleton pose evaluation ----------------
+// Everything one skeleton needs for a frame, resolved on the main thread (controller,
+// state, time). EvaluatePose() touches nothing but the pose it is given, so
+// skeletons can be evaluated on different workers.
+struct PoseSample { const AnimationAsset* asset = nullptr; const AnimationClip* clip = nullptr; float time = 0.0f; bool loop = true; AnimationCursor* cursor = nullptr; };
+struct PoseEvalDesc {
+    PoseSample primary;
+    PoseSample blend;            // Blend1D: second sample, mixed in by blendWeight
+    float blendWeight = -1.0f;   // < 0: no Blend1D
+    PoseSample crossfade;        // next state of an active crossfade
+    float crossfadeAlpha = -1.0f; // < 0: no crossfade
+    const std::vector<uint8_t>* boneMask = nullptr; // per bone, 0: keep the bind local; null: every bone
+};
+
+// Splits an affine matrix into translation, rotation and (positive) scale.
+void decomposeTRS(const glm::mat4& m, glm::vec3& T, glm::quat& R, glm::vec3& S);
+
+// Parent-relative bind pose of every bone, derived from InverseBindPoses.
+void ComputeBindLocals(const ::SkeletonComponent& skeleton, std::vector<glm::mat4>& outBindLocals);
+
+// Samples 'desc' into pose.local (size = bone count), filling bones no track drives
+// or desc.boneMask excludes with 'bindLocals' and applying the humanoid constraint
+// (bind T/S except root/hips).
+// Script events of the primary asset are appended to 'firedEvents'.
+void EvaluatePose(const PoseEvalDesc& desc, const ::SkeletonComponent& skeleton,
+                  const std::vector<glm::mat4>& bindLocals, PoseBuffer& pose,
+                  std::vector<ScriptEvent>* firedEvents = nullptr);
+
+// Model-space position of 'bone' under 'desc', as EvaluatePose + ComputeModelPose
+// would place it, sampling only the bone and its ancestors. Root motion for frames
+// on which animation LOD skips the full pose.
+glm::vec3 EvaluateBoneModelPosition(const PoseEvalDesc& desc, const ::SkeletonComponent& skeleton,
+                                    const std::vector<glm::mat4>& bindLocals, int bone);
+
+// Appends the script events of 'asset' with a time in (from, to]. to < from means
+// the clip looped in between: (from, end] and [start, to] are reported.
+void CollectScriptEvents(const AnimationAsset& asset, float from, float to, std::vector<ScriptEvent>& out);
+
+// pose.model[i] = pose.model[parent] * pose.local[i]
+void ComputeModelPose(PoseBuffer& pose, const std::vector<int>& parents);
+
 } // namespace animation
 } // namespace cm
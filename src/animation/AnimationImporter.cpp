@@ -95,7 +95,7 @@ std::vector<AnimationClip> AnimationImporter::ImportFromModel(const std::string&
 }
 
 // New unified output: produce an .anim (unified) with BoneTracks from raw node channels
-static AnimationAsset BuildUnifiedFromAssimp(const aiScene* scene, unsigned int animIndex)
+AnimationAsset AnimationImporter::BuildAsset(const aiScene* scene, unsigned int animIndex)
 {
     AnimationAsset asset; asset.meta.version = 1; asset.meta.fps = 30.0f; asset.meta.length = 0.0f;
     const aiAnimation* aiAnim = scene->mAnimations[animIndex];
@@ -140,7 +140,7 @@ bool AnimationImporter::ImportUnifiedAnimationFromFBX(const std::string& filepat
         aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_LimitBoneWeights | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_FlipUVs | aiProcess_GlobalScale);
     if (!scene || !scene->mRootNode || scene->mNumAnimations == 0) return false;
 
-    cm::animation::AnimationAsset asset = BuildUnifiedFromAssimp(scene, 0);
+    cm::animation::AnimationAsset asset = BuildAsset(scene, 0);
     return cm::animation::SaveAnimationAsset(asset, outAnimPath);
 }
 
@@ -5,6 +5,8 @@
 #include "animation/AnimationTypes.h"
 #include "animation/AnimationAsset.h"
 
+struct aiScene;
+
 namespace cm {
 namespace animation {
 
@@ -14,6 +16,8 @@ public:
     static std::vector<AnimationClip> ImportFromModel(const std::string& filepath);
     // New unified import convenience: build a single unified AnimationAsset and save it
     static bool ImportUnifiedAnimationFromFBX(const std::string& filepath, const std::string& outAnimPath);
+    // Unified asset (bone tracks keyed by node name) for one animation of an already imported scene
+    static AnimationAsset BuildAsset(const aiScene* scene, unsigned int animIndex);
 };
 
 } // namespace animation
@@ -0,0 +1,169 @@
+#include "animation/AnimationLOD.h"
+#include "ecs/AnimationComponents.h"
+#include <algorithm>
+#include <cmath>
+
+namespace cm {
+namespace animation {
+
+namespace {
+
+// Skinned vertices sit outside the joints (top of the head, finger pads)
+constexpr float kSkinPadding = 1.1f;
+
+AnimationLOD LevelFor(float size, const AnimationLODSettings& s, float scale)
+{
+    if (size >= s.HalfRateBelow * scale) return AnimationLOD::Full;
+    if (size >= s.QuarterRateBelow * scale) return AnimationLOD::Half;
+    if (size >= s.FreezeBelow * scale) return AnimationLOD::Quarter;
+    return AnimationLOD::Frozen;
+}
+
+} // namespace
+
+void ComputeLODBounds(const ::SkeletonComponent& skeleton, AnimationLODState& state)
+{
+    const size_t n = skeleton.BoneEntities.size();
+    std::vector<glm::vec3> joints(n, glm::vec3(0.0f));
+    for (size_t i = 0; i < n && i < skeleton.InverseBindPoses.size(); ++i)
+        joints[i] = glm::vec3(glm::inverse(skeleton.InverseBindPoses[i])[3]);
+    auto parentOf = [&](size_t i) { return (i < skeleton.BoneParents.size()) ? skeleton.BoneParents[i] : -1; };
+
+    glm::vec3 lo(0.0f), hi(0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        lo = i ? glm::min(lo, joints[i]) : joints[i];
+        hi = i ? glm::max(hi, joints[i]) : joints[i];
+    }
+    state.Center = (lo + hi) * 0.5f;
+    state.Radius = 0.0f;
+    for (size_t i = 0; i < n; ++i) state.Radius = std::max(state.Radius, glm::length(joints[i] - state.Center));
+    state.Radius *= kSkinPadding;
+
+    // Reach of a bone: its own length, or the farthest joint of its subtree from it
+    std::vector<float>& extents = state.BoneExtents;
+    extents.assign(n, 0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        const int p = parentOf(i);
+        if (p >= 0 && p < (int)n) extents[i] = glm::length(joints[i] - joints[p]);
+    }
+    for (size_t j = 0; j < n; ++j) {
+        int a = parentOf(j);
+        for (size_t guard = 0; a >= 0 && a < (int)n && guard < n; a = parentOf((size_t)a), ++guard)
+            extents[a] = std::max(extents[a], glm::length(joints[j] - joints[a]));
+    }
+    // Never more than an ancestor, so a culled bone's subtree is culled with it
+    std::vector<float> capped(extents);
+    for (size_t i = 0; i < n; ++i) {
+        int a = parentOf(i);
+        for (size_t guard = 0; a >= 0 && a < (int)n && guard < n; a = parentOf((size_t)a), ++guard)
+            capped[i] = std::min(capped[i], extents[a]);
+    }
+    extents.swap(capped);
+}
+
+float ProjectedScreenSize(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& rootWorld,
+                          const AnimationLODState& state)
+{
+    if (state.Radius <= 0.0f) return 1.0f;
+    const glm::vec3 center = glm::vec3(view * rootWorld * glm::vec4(state.Center, 1.0f));
+    const float scale = std::max({ glm::length(glm::vec3(rootWorld[0])), glm::length(glm::vec3(rootWorld[1])),
+                                   glm::length(glm::vec3(rootWorld[2])) });
+    const float radius = state.Radius * scale;
+    // Distance rather than view depth, so turning the camera does not change levels
+    const bool perspective = projection[2][3] != 0.0f;
+    const float distance = perspective ? glm::length(center) : 1.0f;
+    if (distance <= radius) return 1.0f;
+    return std::min(1.0f, radius * std::abs(projection[1][1]) / distance);
+}
+
+AnimationLOD SelectLOD(float screenSize, AnimationLOD previous, const AnimationLODSettings& settings)
+{
+    const AnimationLOD level = LevelFor(screenSize, settings, 1.0f);
+    if (previous >= level) return level;
+    return std::max(previous, LevelFor(screenSize, settings, 1.0f - settings.Hysteresis));
+}
+
+void BuildLODBoneMask(const ::SkeletonComponent& skeleton, const AnimationLODSettings& settings, AnimationLODState& state)
+{
+    const size_t n = state.BoneExtents.size();
+    if (settings.MinBoneScreenSize <= 0.0f || state.Radius <= 0.0f || state.ScreenSize <= 0.0f || n == 0) {
+        state.BoneMask.clear();
+        return;
+    }
+    // Bind-pose length that projects to MinBoneScreenSize at this distance
+    const float minExtent = settings.MinBoneScreenSize * state.Radius / state.ScreenSize;
+    state.BoneMask.resize(n);
+    bool all = true;
+    for (size_t i = 0; i < n; ++i) {
+        const bool observed = i < skeleton.ObservedBones.size() && skeleton.ObservedBones[i];
+        state.BoneMask[i] = (observed || state.BoneExtents[i] >= minExtent) ? 1 : 0;
+        all = all && state.BoneMask[i];
+    }
+    if (all) state.BoneMask.clear();
+}
+
+LODFrame ScheduleLOD(AnimationLODState& state, uint32_t stagger, bool hasPose)
+{
+    LODFrame frame;
+    frame.Interval = LODUpdateInterval(state.Level);
+    if (frame.Interval <= 1) {
+        // Full rate, or frozen on the pose already on screen (evaluated once if there is none)
+        frame.Evaluate = frame.Interval == 1 || !hasPose;
+        state.Phase = UINT32_MAX;
+        return frame;
+    }
+    if (state.Phase == UINT32_MAX || !hasPose) {
+        // Entering a throttled level: evaluate now and show it as is, then join the
+        // skeleton's slot in the rotation
+        frame.Evaluate = true;
+        frame.Alpha = 1.0f;
+        state.Phase = stagger % frame.Interval;
+    } else {
+        state.Phase %= frame.Interval;
+        frame.Evaluate = state.Phase == 0;
+        frame.Alpha = float(state.Phase + 1) / float(frame.Interval);
+    }
+    state.Phase = (state.Phase + 1) % frame.Interval;
+    return frame;
+}
+
+PoseBuffer& BeginLODEvaluation(::SkeletonComponent& skeleton, const LODFrame& frame)
+{
+    if (frame.Alpha < 0.0f) return skeleton.Pose;
+    AnimationLODState& state = skeleton.LOD;
+    if (frame.Alpha < 1.0f) {
+        // Blend from what is on screen, not from the previous evaluation, so a level change never pops
+        state.From.local = skeleton.Pose.local;
+        state.From.model = skeleton.Pose.model;
+    }
+    return state.To;
+}
+
+void FinishLODFrame(::SkeletonComponent& skeleton, const LODFrame& frame)
+{
+    if (frame.Alpha < 0.0f) return;
+    AnimationLODState& state = skeleton.LOD;
+    PoseBuffer& pose = skeleton.Pose;
+    const size_t n = state.To.model.size();
+    if (frame.Alpha >= 1.0f || state.From.model.size() != n || state.From.local.size() != state.To.local.size()) {
+        state.From.local = state.To.local;
+        state.From.model = state.To.model;
+        pose.local = state.To.local;
+        pose.model = state.To.model;
+        return;
+    }
+    // Component-wise: over at most four frames the shortening of a turning bone is
+    // far below what a character at this size shows. Skinning reads the model pose;
+    // locals only matter for bones written back to their entities (IK is off here).
+    const float a = frame.Alpha, b = 1.0f - frame.Alpha;
+    pose.model.resize(n);
+    for (size_t i = 0; i < n; ++i) pose.model[i] = state.From.model[i] * b + state.To.model[i] * a;
+    pose.local.resize(state.To.local.size());
+    for (size_t i = 0; i < state.To.local.size(); ++i) {
+        if (!skeleton.WriteBackAllBones && (i >= skeleton.ObservedBones.size() || !skeleton.ObservedBones[i])) continue;
+        pose.local[i] = state.From.local[i] * b + state.To.local[i] * a;
+    }
+}
+
+} // namespace animation
+} // namespace cm
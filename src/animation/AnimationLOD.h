@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "animation/PoseBuffer.h"
+
+struct SkeletonComponent;
+
+namespace cm {
+namespace animation {
+
+// -----------------------------------------------------------------------------
+// Animation LOD. Each frame AnimationSystem measures every animated skeleton's
+// projected height in the active camera (bind-pose bounding sphere, as a fraction
+// of the viewport height) and picks a level:
+//
+//   Full      sampled, blended, IK-solved and blend-shaped every frame
+//   Half      sampled every 2nd frame, model pose interpolated in between
+//   Quarter   sampled every 4th frame, interpolated; no blend shape updates
+//   Frozen    last pose held
+//
+// Throttled skeletons are staggered across frames and shown one update behind,
+// blending from the pose on screen towards the newest evaluation, so motion stays
+// continuous. IK runs at Full only. Independently of the level, bones whose
+// subtree projects below MinBoneScreenSize (fingers, face, props on a distant
+// character) are not sampled and keep their bind local.
+//
+// Only the full pose is throttled: script events and root motion are taken every
+// frame at every level, Frozen included (the root motion bone is sampled alone).
+// -----------------------------------------------------------------------------
+enum class AnimationLOD : uint8_t { Full, Half, Quarter, Frozen };
+
+struct AnimationLODSettings {
+    bool Enabled = true;
+    // Projected height (fraction of the viewport) below which a level is used
+    float HalfRateBelow = 0.20f;
+    float QuarterRateBelow = 0.08f;
+    float FreezeBelow = 0.01f;
+    // A skeleton only drops to a coarser level once it is this much (relative)
+    // below the threshold, so one at a boundary does not flicker between levels
+    float Hysteresis = 0.15f;
+    // Bones whose subtree projects smaller than this are not sampled; 0 samples all
+    float MinBoneScreenSize = 0.003f;
+};
+
+// Per-skeleton LOD state, kept on SkeletonComponent
+struct AnimationLODState {
+    AnimationLOD Level = AnimationLOD::Full;
+    float ScreenSize = 1.0f;               // last measured projected height
+    uint32_t Phase = UINT32_MAX;           // frames since the last evaluation; UINT32_MAX: not scheduled yet
+    std::vector<uint8_t> BoneMask;         // per bone, 0: keep bind local; empty: every bone
+    PoseBuffer From, To;                   // interpolation endpoints while throttled
+
+    // Bind-pose bounds relative to the skeleton root, from ComputeLODBounds()
+    glm::vec3 Center{0.0f};
+    float Radius = 0.0f;
+    std::vector<float> BoneExtents;        // per bone: reach of the bone and its subtree
+};
+
+// This frame's work for one skeleton, from ScheduleLOD()
+struct LODFrame {
+    bool Evaluate = true;                  // sample the animation this frame
+    float Alpha = -1.0f;                   // >= 0: show From..To at Alpha; < 0: show the evaluation as is
+    uint32_t Interval = 1;                 // frames between evaluations; 0 when frozen
+};
+
+inline uint32_t LODUpdateInterval(AnimationLOD level)
+{
+    switch (level) {
+        case AnimationLOD::Full:    return 1;
+        case AnimationLOD::Half:    return 2;
+        case AnimationLOD::Quarter: return 4;
+        default:                    return 0;
+    }
+}
+inline bool IKAtLOD(AnimationLOD level) { return level == AnimationLOD::Full; }
+inline bool BlendShapesAtLOD(AnimationLOD level) { return level <= AnimationLOD::Half; }
+
+// Bounds and per-bone extents from the bind pose; call when the bone count changes
+void ComputeLODBounds(const ::SkeletonComponent& skeleton, AnimationLODState& state);
+
+// Projected height of the skeleton's bounds as a fraction of the viewport height
+float ProjectedScreenSize(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& rootWorld,
+                          const AnimationLODState& state);
+
+// Level for 'screenSize', with hysteresis against the previous level
+AnimationLOD SelectLOD(float screenSize, AnimationLOD previous, const AnimationLODSettings& settings);
+
+// Rebuilds state.BoneMask for the measured screen size. Observed bones are always sampled.
+void BuildLODBoneMask(const ::SkeletonComponent& skeleton, const AnimationLODSettings& settings, AnimationLODState& state);
+
+// Advances the skeleton's schedule by one frame. 'stagger' spreads throttled
+// skeletons across frames (e.g. the entity id); 'hasPose' forces an evaluation
+// for skeletons that were never evaluated.
+LODFrame ScheduleLOD(AnimationLODState& state, uint32_t stagger, bool hasPose);
+
+// Worker side, around EvaluatePose + ComputeModelPose of an evaluating frame:
+// the buffer to evaluate into (the skeleton's Pose, or state.To while throttled)
+PoseBuffer& BeginLODEvaluation(::SkeletonComponent& skeleton, const LODFrame& frame);
+// Interpolates the skeleton's Pose for a throttled frame; no-op otherwise
+void FinishLODFrame(::SkeletonComponent& skeleton, const LODFrame& frame);
+
+} // namespace animation
+} // namespace cm
@@ -30,22 +30,27 @@ struct AnimationPlayerComponent {
     std::shared_ptr<AnimatorController> Controller;
     Animator AnimatorInstance;
     int CurrentStateId = -1;
-    // Cache of loaded assets per state id
-    std::unordered_map<int, std::shared_ptr<AnimationClip>> CachedClips; // legacy clips
-    std::unordered_map<int, std::shared_ptr<AnimationAsset>> CachedAssets; // unified assets
+    // Assets this player uses, by source path; shared through AnimationAssetCache
+    std::unordered_map<std::string, std::shared_ptr<const AnimationClip>> CachedClips; // legacy clips
+    std::unordered_map<std::string, std::shared_ptr<const AnimationAsset>> CachedAssets; // unified assets
+    // Segment cursors of the primary, Blend1D and crossfade samples
+    AnimationCursor Cursors[3];
 
     // Root motion handling
     enum class RootMotionMode { None, FromHipsToEntity, FromRootToEntity };
     RootMotionMode RootMotion = RootMotionMode::None;
     glm::vec3 _PrevRootModelPos{0.0f};
     bool _PrevRootValid = false;
+    // Script events: asset and time of the last frame scanned
+    const AnimationAsset* _EventAsset = nullptr;
+    float _EventTime = 0.0f;
 
     // Bimodal animator behavior
     enum class Mode { ControllerAnimated, AnimationPlayerAnimated };
     Mode AnimatorMode = Mode::AnimationPlayerAnimated;
 
     // Single-clip (Animation Player) mode configuration
-    std::string SingleClipPath;      // Path to a unified .anim (preferred) or legacy clip; resolved to CachedAssets[0]
+    std::string SingleClipPath;      // Path to a unified .anim (preferred) or legacy clip; resolved through CachedAssets
     bool PlayOnStart = true;         // If true, auto-begin playback on start
     bool IsPlaying = false;          // Runtime playing flag for single-clip mode
     bool _InitApplied = false;       // Internal guard to apply PlayOnStart once
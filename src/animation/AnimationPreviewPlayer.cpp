@@ -45,7 +45,7 @@ void AnimationPreviewPlayer::Update(float dt)
             if (boneId == (EntityID)-1) continue;
             if (auto* data = m_Scene->GetEntityData(boneId)) {
                 data->Transform.LocalMatrix = localPose[i];
-                data->Transform.TransformDirty = true;
+                m_Scene->MarkTransformDirty(boneId);
             }
         }
         return;
@@ -74,7 +74,7 @@ void AnimationPreviewPlayer::Update(float dt)
             if (boneId == (EntityID)-1) continue;
             if (auto* data = m_Scene->GetEntityData(boneId)) {
                 data->Transform.LocalMatrix = pose.local[i];
-                data->Transform.TransformDirty = true;
+                m_Scene->MarkTransformDirty(boneId);
             }
         }
     }
@@ -1,4 +1,5 @@
 #include "animation/AnimationSerializer.h"
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
 #include <editor/Project.h>
@@ -6,6 +7,9 @@
 #include "animation/AnimationAsset.h"
 #include "animation/HumanoidAvatar.h"
 #include <iostream>
+#include <cstring>
+#include "io/MappedFile.h"
+#include "pipeline/ModelCacheFormat.h"
 namespace cm {
 namespace animation {
 
@@ -377,6 +381,10 @@ bool SaveAnimationAsset(const AnimationAsset& asset, const std::string& path)
 
 AnimationAsset LoadAnimationAsset(const std::string& path)
 {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".animbin") return LoadAnimationBin(path);
+
     std::ifstream f(path);
     if (!f.is_open()) {
         // Fallback: treat as project-relative
@@ -392,6 +400,100 @@ AnimationAsset LoadAnimationAsset(const std::string& path)
     json j; f >> j; return DeserializeAnimationAsset(j);
 }
 
+bool SaveAnimationBin(const AnimationAsset& asset, const std::string& path)
+{
+    using namespace modelcache;
+    std::vector<const AssetBoneTrack*> bones;
+    for (const auto& t : asset.tracks)
+        if (t && t->type == TrackType::Bone) bones.push_back(static_cast<const AssetBoneTrack*>(t.get()));
+
+    BinWriter w(sizeof(AnimBinHeader));
+    AnimBinHeader h;
+    h.trackCount = (uint32_t)bones.size();
+    h.name = w.String(asset.name);
+    h.length = asset.meta.length;
+    h.fps = asset.meta.fps;
+    h.tracks = w.Reserve(sizeof(AnimBinTrack) * bones.size());
+
+    std::vector<AnimBinTrack> records(bones.size());
+    std::vector<AnimBinKeyVec3> vkeys;
+    std::vector<AnimBinKeyQuat> qkeys;
+    auto appendVec3 = [&](const CurveVec3& c) {
+        vkeys.clear();
+        for (const auto& k : c.keys) vkeys.push_back({ k.t, { k.v.x, k.v.y, k.v.z } });
+        return w.Append(vkeys);
+    };
+    for (size_t i = 0; i < bones.size(); ++i) {
+        const AssetBoneTrack& bt = *bones[i];
+        AnimBinTrack& r = records[i];
+        r.name = w.String(bt.name);
+        r.translation = appendVec3(bt.t);
+        qkeys.clear();
+        for (const auto& k : bt.r.keys) qkeys.push_back({ k.t, { k.v.x, k.v.y, k.v.z, k.v.w } });
+        r.rotation = w.Append(qkeys);
+        r.scale = appendVec3(bt.s);
+    }
+    if (!records.empty()) std::memcpy(w.At(h.tracks.offset), records.data(), sizeof(AnimBinTrack) * records.size());
+    h.strings = w.FinishStrings();
+    w.SetHeader(h);
+
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f.is_open()) return false;
+    f.write(reinterpret_cast<const char*>(w.Bytes().data()), (std::streamsize)w.Bytes().size());
+    return (bool)f;
+}
+
+AnimationAsset LoadAnimationBin(const std::string& path)
+{
+    using namespace modelcache;
+    MappedFile file;
+    if (!file.Open(path)) {
+        // Fallback: treat as project-relative
+        try {
+            std::filesystem::path base = Project::GetProjectDirectory();
+            if (!base.empty()) file.Open((base / path).string());
+        } catch (...) {}
+    }
+    AnimationAsset a;
+    if (!file.IsOpen() || file.Size() < sizeof(AnimBinHeader)) return a;
+
+    const uint8_t* base = file.Data();
+    const size_t size = file.Size();
+    AnimBinHeader h;
+    std::memcpy(&h, base, sizeof(h));
+    const AnimBinTrack* tracks = ArrayAt<AnimBinTrack>(base, size, h.tracks, h.trackCount);
+    if (h.magic != kAnimBinMagic || h.version != kVersion || !tracks || !RangeValid(h.strings, size)) {
+        std::cerr << "[AnimationSerializer] Invalid or stale animbin: " << path << std::endl;
+        return a;
+    }
+
+    a.name = StringAt(base, h.strings, h.name);
+    a.meta.length = h.length;
+    a.meta.fps = h.fps;
+    a.tracks.reserve(h.trackCount);
+    for (uint32_t i = 0; i < h.trackCount; ++i) {
+        const AnimBinTrack& r = tracks[i];
+        auto t = std::make_unique<AssetBoneTrack>();
+        t->name = StringAt(base, h.strings, r.name);
+        auto readVec3 = [&](const BinRange& range, CurveVec3& c) {
+            const size_t n = range.size / sizeof(AnimBinKeyVec3);
+            const AnimBinKeyVec3* k = ArrayAt<AnimBinKeyVec3>(base, size, range, n);
+            if (!k) return;
+            c.keys.resize(n);
+            for (size_t j = 0; j < n; ++j) c.keys[j] = { 0ull, k[j].t, glm::vec3(k[j].v[0], k[j].v[1], k[j].v[2]) };
+        };
+        readVec3(r.translation, t->t);
+        readVec3(r.scale, t->s);
+        const size_t nq = r.rotation.size / sizeof(AnimBinKeyQuat);
+        if (const AnimBinKeyQuat* k = ArrayAt<AnimBinKeyQuat>(base, size, r.rotation, nq)) {
+            t->r.keys.resize(nq);
+            for (size_t j = 0; j < nq; ++j) t->r.keys[j] = { 0ull, k[j].t, glm::quat(k[j].v[3], k[j].v[0], k[j].v[1], k[j].v[2]) };
+        }
+        a.tracks.push_back(std::move(t));
+    }
+    return a;
+}
+
 AnimationAsset WrapLegacyClipAsAsset(const AnimationClip& clip)
 {
     AnimationAsset a; a.name = clip.Name; a.meta.version = 1; a.meta.fps = (clip.TicksPerSecond > 0.0f) ? clip.TicksPerSecond : 30.0f; a.meta.length = clip.Duration;
@@ -35,7 +35,12 @@ TimelineClip LoadTimelineClip(const std::string& path);
 json SerializeAnimationAsset(const AnimationAsset& asset);
 AnimationAsset DeserializeAnimationAsset(const json& j);
 bool SaveAnimationAsset(const AnimationAsset& asset, const std::string& path);
-AnimationAsset LoadAnimationAsset(const std::string& path);
+AnimationAsset LoadAnimationAsset(const std::string& path); // also reads .animbin
+
+// Binary clip written by the model import cache (.animbin, see pipeline/ModelCacheFormat.h).
+// Holds bone tracks only; the file is memory-mapped while reading.
+bool SaveAnimationBin(const AnimationAsset& asset, const std::string& path);
+AnimationAsset LoadAnimationBin(const std::string& path);
 
 // Migration: wrap a legacy skeletal AnimationClip as a unified AnimationAsset with BoneTracks
 AnimationAsset WrapLegacyClipAsAsset(const AnimationClip& clip);
@@ -1,6 +1,7 @@
 #include "animation/AnimationSystem.h"
 #include "ecs/Scene.h"
 #include "ecs/Entity.h"
+#include <algorithm>
 #include <cmath>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/transform.hpp>
@@ -8,10 +9,15 @@
 #include "animation/AnimationSerializer.h"
 #include "animation/AnimatorController.h"
 #include "animation/AnimationAsset.h"
+#include "animation/AnimationAssetCache.h"
 #include "animation/AnimationEvaluator.h"
+#include "animation/AnimationLOD.h"
 #include "animation/BindingCache.h"
 #include "animation/HumanoidRetargeter.h"
 #include "animation/AvatarSerializer.h"
+#include "jobs/Jobs.h"
+#include "jobs/ParallelFor.h"
+#include "rendering/Camera.h"
 // Script event dispatch to managed C# scripts
 #include "scripting/ManagedScriptComponent.h"
 #include "scripting/DotNetHost.h"
@@ -21,26 +27,268 @@
 namespace cm {
 namespace animation {
 
-    void decomposeTRS(const glm::mat4& m, glm::vec3& T, glm::quat& R, glm::vec3& S) {
-        T = glm::vec3(m[3]);
-        glm::vec3 X = glm::vec3(m[0]);
-        glm::vec3 Y = glm::vec3(m[1]);
-        glm::vec3 Z = glm::vec3(m[2]);
-        S = glm::vec3(glm::length(X), glm::length(Y), glm::length(Z));
-        if (S.x > 1e-6f) X /= S.x;
-        if (S.y > 1e-6f) Y /= S.y;
-        if (S.z > 1e-6f) Z /= S.z;
-        glm::mat3 rotMat(X, Y, Z);
-        R = glm::quat_cast(rotMat);
+namespace {
+
+// One skeleton's share of the parallel phase. Prepared on the main thread; the
+// worker only touches the skeleton's Pose and the player's root motion state.
+struct SkeletonJob {
+    EntityID Entity = INVALID_ENTITY_ID;
+    AnimationPlayerComponent* Player = nullptr;
+    ::SkeletonComponent* Skeleton = nullptr;
+    PoseEvalDesc Desc;
+    LODFrame Frame;
+
+    // Outputs applied on the main thread
+    std::vector<ScriptEvent> Events;            // crossed this frame, collected in phase 1
+    glm::vec3 RootDelta{0.0f};
+    bool HasRootDelta = false;
+};
+
+std::vector<SkeletonJob> s_Jobs;              // reused across frames
+std::vector<EntityID> s_IKReferences;         // IK target/pole entities, sorted
+std::vector<EntityID> s_SortedBones;
+
+// Entities named as IK target or pole by any skeleton's IK components or authored IK blocks
+void CollectIKReferences(::Scene& scene) {
+    s_IKReferences.clear();
+    for (auto [id, data, skeleton] : scene.View<::EntityData, ::SkeletonComponent>()) {
+        for (const auto& ik : data.IKs) {
+            if (ik.TargetEntity != 0) s_IKReferences.push_back(ik.TargetEntity);
+            if (ik.PoleEntity != 0) s_IKReferences.push_back(ik.PoleEntity);
+        }
+        if (!data.Extra.is_object()) continue;
+        auto it = data.Extra.find("ik");
+        if (it == data.Extra.end() || !it->is_array()) continue;
+        for (const auto& j : *it) {
+            const EntityID target = j.value("target", (EntityID)0);
+            const EntityID pole = j.value("pole", (EntityID)0);
+            if (target != 0) s_IKReferences.push_back(target);
+            if (pole != 0) s_IKReferences.push_back(pole);
+        }
+    }
+    std::sort(s_IKReferences.begin(), s_IKReferences.end());
+}
+
+// A bone entity is observed when something other than skinning reads its transform:
+// non-bone children (attachments), components or scripts on the bone, or an IK
+// target/pole pointing at it. Ancestors of observed bones are observed as well so
+// the transform system can compose their world matrices.
+void RefreshObservedBones(::Scene& scene, ::SkeletonComponent& skeleton, uint32_t componentVersion) {
+    const size_t n = skeleton.BoneEntities.size();
+    skeleton.ObservedBones.assign(n, 0);
+    skeleton.ObservedVersion = scene.GetHierarchyVersion();
+    skeleton.ObservedComponentVersion = componentVersion;
+
+    s_SortedBones = skeleton.BoneEntities;
+    std::sort(s_SortedBones.begin(), s_SortedBones.end());
+    auto isBone = [](EntityID id) { return std::binary_search(s_SortedBones.begin(), s_SortedBones.end(), id); };
+
+    for (size_t i = 0; i < n; ++i) {
+        const EntityID be = skeleton.BoneEntities[i];
+        const ::EntityData* bd = (be != (EntityID)-1) ? scene.GetEntityData(be) : nullptr;
+        if (!bd) continue;
+        bool observed = !bd->Scripts.empty() || bd->Mesh || bd->Light || bd->Collider || bd->RigidBody
+            || bd->StaticBody || bd->Camera || bd->Emitter
+            || std::binary_search(s_IKReferences.begin(), s_IKReferences.end(), be);
+        for (size_t c = 0; c < bd->Children.size() && !observed; ++c)
+            observed = !isBone(bd->Children[c]);
+        skeleton.ObservedBones[i] = observed ? 1 : 0;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!skeleton.ObservedBones[i]) continue;
+        int q = (i < skeleton.BoneParents.size()) ? skeleton.BoneParents[i] : -1;
+        for (size_t guard = 0; q >= 0 && q < (int)n && !skeleton.ObservedBones[q] && guard < n; ++guard) {
+            skeleton.ObservedBones[q] = 1;
+            q = (q < (int)skeleton.BoneParents.size()) ? skeleton.BoneParents[q] : -1;
+        }
+    }
+}
+
+// Bone whose model-space motion moves the entity; -1 without root motion
+int RootMotionBone(const ::SkeletonComponent& skeleton, const AnimationPlayerComponent& player) {
+    if (!skeleton.Avatar) return -1;
+    switch (player.RootMotion) {
+        case AnimationPlayerComponent::RootMotionMode::FromHipsToEntity: return skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Hips);
+        case AnimationPlayerComponent::RootMotionMode::FromRootToEntity: return skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Root);
+        default: return -1;
+    }
+}
+
+// Entity delta from the root motion bone's model position this frame (worker side)
+void TakeRootDelta(SkeletonJob& job, const glm::vec3& curPos) {
+    AnimationPlayerComponent& player = *job.Player;
+    if (player._PrevRootValid) {
+        job.RootDelta = curPos - player._PrevRootModelPos;
+        job.HasRootDelta = true;
+    }
+    player._PrevRootModelPos = curPos;
+    player._PrevRootValid = true;
+}
+
+// Root motion on the evaluated locals (worker side). The entity delta is applied later
+// on the main thread.
+void ApplyRootMotion(SkeletonJob& job, std::vector<glm::mat4>& localTransforms) {
+    const ::SkeletonComponent& skeleton = *job.Skeleton;
+    AnimationPlayerComponent& player = *job.Player;
+    if (!skeleton.Avatar) return;
+
+    // Compose model matrix from locals up the parent chain
+    auto composeModel = [&](int boneIndex) -> glm::mat4 {
+        glm::mat4 model(1.0f);
+        int bi = boneIndex;
+        while (bi >= 0) {
+            model = localTransforms[bi] * model;
+            bi = (bi < (int)skeleton.BoneParents.size()) ? skeleton.BoneParents[bi] : -1;
+        }
+        return model;
+    };
+
+    // Replace a bone's local translation with its bind local translation, preserve animated R/S
+    auto zeroLocalTranslationToBind = [&](int boneIndex) {
+        if (boneIndex < 0 || boneIndex >= (int)localTransforms.size()) return;
+        glm::vec3 Ta, Sa; glm::quat Ra;
+        decomposeTRS(localTransforms[boneIndex], Ta, Ra, Sa);
+        glm::vec3 Tb, Sb; glm::quat Rb;
+        decomposeTRS(boneIndex < (int)skeleton.BindLocals.size() ? skeleton.BindLocals[boneIndex] : glm::mat4(1.0f), Tb, Rb, Sb);
+        localTransforms[boneIndex] = glm::translate(Tb) * glm::mat4_cast(glm::normalize(Ra)) * glm::scale(Sb);
+    };
+
+    int hipsIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Hips);
+    int rootIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Root);
+
+    switch (player.RootMotion) {
+        case AnimationPlayerComponent::RootMotionMode::None: {
+            // Keep rig in-place: zero translation on hips and root back to bind
+            zeroLocalTranslationToBind(hipsIdx);
+            zeroLocalTranslationToBind(rootIdx);
+            player._PrevRootValid = false;
+        } break;
+
+        case AnimationPlayerComponent::RootMotionMode::FromHipsToEntity:
+        case AnimationPlayerComponent::RootMotionMode::FromRootToEntity: {
+            const int src = (player.RootMotion == AnimationPlayerComponent::RootMotionMode::FromHipsToEntity) ? hipsIdx : rootIdx;
+            if (src >= 0) {
+                TakeRootDelta(job, glm::vec3(composeModel(src)[3]));
+
+                // After extracting root motion, keep the animated bone in-place
+                zeroLocalTranslationToBind(src);
+            } else {
+                player._PrevRootValid = false;
+            }
+        } break;
+    }
+}
+
+// Resolves a path through the player's references, acquiring it from the shared cache
+// on first use. Null while the cache is still loading the file.
+const AnimationAsset* ResolveAsset(AnimationPlayerComponent& player, const std::string& path) {
+    if (path.empty()) return nullptr;
+    auto it = player.CachedAssets.find(path);
+    if (it != player.CachedAssets.end()) return it->second.get();
+    std::shared_ptr<const AnimationAsset> asset = AnimationAssetCache::Instance().Acquire(path);
+    if (!asset) return nullptr;
+    return player.CachedAssets.emplace(path, std::move(asset)).first->second.get();
+}
+
+const AnimationClip* ResolveClip(AnimationPlayerComponent& player, const std::string& path) {
+    if (path.empty()) return nullptr;
+    auto it = player.CachedClips.find(path);
+    if (it != player.CachedClips.end()) return it->second.get();
+    std::shared_ptr<const AnimationClip> clip = AnimationAssetCache::Instance().AcquireClip(path);
+    if (!clip) return nullptr;
+    return player.CachedClips.emplace(path, std::move(clip)).first->second.get();
+}
+
+// Unified asset if the state names one, else its legacy clip
+struct ResolvedMotion {
+    const AnimationAsset* asset = nullptr;
+    const AnimationClip* clip = nullptr;
+    float Duration() const { return asset ? asset->Duration() : (clip ? clip->Duration : 0.0f); }
+};
+
+ResolvedMotion ResolveMotion(AnimationPlayerComponent& player, const std::string& assetPath, const std::string& clipPath) {
+    ResolvedMotion m;
+    if (!assetPath.empty()) m.asset = ResolveAsset(player, assetPath);
+    else m.clip = ResolveClip(player, clipPath);
+    return m;
+}
+
+void DispatchScriptEvents(::Scene& scene, EntityID entityId, const std::vector<ScriptEvent>& firedEvents) {
+    // Dispatch script events to managed scripts attached to the skeleton root entity
+    auto* rootData = scene.GetEntityData(entityId);
+    if (!rootData) return;
+    for (const auto& ev : firedEvents) {
+        const std::string& targetClass  = ev.className;
+        const std::string& targetMethod = ev.method;
+        for (auto& script : rootData->Scripts) {
+            if (!script.Instance) continue;
+            if (script.ClassName != targetClass) continue;
+            if (script.Instance->GetBackend() == ScriptBackend::Managed) {
+                auto managed = std::dynamic_pointer_cast<ManagedScriptComponent>(script.Instance);
+                if (managed && g_Script_Invoke) {
+                    g_Script_Invoke(managed->GetHandle(), targetMethod.c_str());
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void AnimationSystem::WriteBoneEntities(::Scene& scene, ::SkeletonComponent& skeleton) {
+    const std::vector<glm::mat4>& localTransforms = skeleton.Pose.local;
+    for (size_t i = 0; i < localTransforms.size() && i < skeleton.BoneEntities.size(); ++i) {
+        if (!skeleton.WriteBackAllBones && (i >= skeleton.ObservedBones.size() || !skeleton.ObservedBones[i])) continue;
+        EntityID boneId = skeleton.BoneEntities[i];
+        if (boneId == (EntityID)-1) continue;
+        if (auto* bd = scene.GetEntityData(boneId)) {
+            glm::vec3 T, S; glm::quat R;
+            decomposeTRS(localTransforms[i], T, R, S);
+            bd->Transform.Position = T;
+            bd->Transform.Scale    = S;
+            bd->Transform.RotationQ = glm::normalize(R);
+            bd->Transform.UseQuatRotation = true;
+            // Keep Euler for inspector display
+            bd->Transform.Rotation = glm::degrees(glm::eulerAngles(bd->Transform.RotationQ));
+            scene.MarkTransformDirty(boneId);
+        }
     }
+}
+
+AnimationLODSettings& AnimationSystem::LODSettings() {
+    static AnimationLODSettings settings;
+    return settings;
+}
 
 void AnimationSystem::Update(::Scene& scene, float deltaTime) {
-    for (const auto& ent : scene.GetEntities()) {
-        auto* data = scene.GetEntityData(ent.GetID());
-        // Drive animation from entities that own an AnimationPlayer and a Skeleton (skeleton root)
-        if (!data || !data->AnimationPlayer || !data->Skeleton) continue;
-        auto& player   = *data->AnimationPlayer;
-        auto& skeleton = *data->Skeleton;
+    AnimationAssetCache::Instance().Update();
+
+    // LOD is measured against the camera the scene renders with; none: everything at full rate
+    const AnimationLODSettings& lodSettings = LODSettings();
+    const Camera* camera = lodSettings.Enabled ? scene.GetActiveCamera() : nullptr;
+    const glm::mat4 view = camera ? camera->GetViewMatrix() : glm::mat4(1.0f);
+    const glm::mat4 projection = camera ? camera->GetProjectionMatrix() : glm::mat4(1.0f);
+
+    // Poses are valid only for skeletons evaluated below; others fall back to bone entities.
+    // Observed bones depend on parent links, components/scripts on bones and IK targets.
+    const uint32_t componentVersion = scene.GetComponentVersion();
+    auto observedCurrent = [&](const ::SkeletonComponent& skeleton) {
+        return skeleton.ObservedVersion == scene.GetHierarchyVersion() && skeleton.ObservedComponentVersion == componentVersion;
+    };
+    bool observedStale = false;
+    for (auto [id, data, skeleton] : scene.View<::EntityData, ::SkeletonComponent>()) {
+        skeleton.PoseValid = false;
+        if (data.AnimationPlayer) observedStale |= !observedCurrent(skeleton);
+    }
+    if (observedStale) CollectIKReferences(scene);
+
+    // Phase 1 (main thread): controller, state and time for every player, plus asset loading
+    s_Jobs.clear();
+    for (auto row : scene.View<::EntityData, AnimationPlayerComponent, ::SkeletonComponent>()) {
+        const EntityID entityId = std::get<0>(row);
+        auto* data = &std::get<1>(row);
+        auto& player   = std::get<2>(row);
+        auto& skeleton = std::get<3>(row);
 
         // Auto-load controller if path is set but runtime controller not yet created
         if (player.AnimatorMode == AnimationPlayerComponent::Mode::ControllerAnimated && !player.Controller && !player.ControllerPath.empty()) {
@@ -64,20 +312,9 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
                     player.AnimatorInstance.SetController(ctrl);
                     player.AnimatorInstance.ResetToDefaults();
                     player.CurrentStateId = ctrl->DefaultState;
-                    // Bind default state's asset/clip immediately so evaluation has something to drive
+                    // Start loading the default state's asset/clip so evaluation has something to drive
                     const auto* st = player.Controller->FindState(player.CurrentStateId);
-                    if (st) {
-                        if (!st->AnimationAssetPath.empty()) {
-                            auto ita = player.CachedAssets.find(st->Id);
-                            if (ita == player.CachedAssets.end())
-                                player.CachedAssets[st->Id] = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(st->AnimationAssetPath));
-                        }
-                        if (st->AnimationAssetPath.empty() && !st->ClipPath.empty()) {
-                            auto itc = player.CachedClips.find(st->Id);
-                            if (itc == player.CachedClips.end())
-                                player.CachedClips[st->Id] = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(st->ClipPath));
-                        }
-                    }
+                    if (st) ResolveMotion(player, st->AnimationAssetPath, st->ClipPath);
                     // Respect PlayOnStart for controller mode as well (advance will still be driven by controller)
                     if (!player._InitApplied) {
                         player._InitApplied = true;
@@ -102,10 +339,7 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
 
         // Predeclare evaluation context shared across phases (needed for Blend1D sampling later)
         const cm::animation::AnimatorState* stNowForEval = nullptr;
-        std::shared_ptr<cm::animation::AnimationAsset> assetNow;
-        std::shared_ptr<cm::animation::AnimationClip> clipNow;
-        std::shared_ptr<cm::animation::AnimationAsset> assetB0, assetB1;
-        std::shared_ptr<cm::animation::AnimationClip> clipB0, clipB1;
+        ResolvedMotion now, b0, b1;
         float durationNow = 0.0f;
         float blendT = 0.0f;
         bool useBlend1D = false;
@@ -121,23 +355,8 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
 
             const auto* st = player.Controller->FindState(player.CurrentStateId);
             if (!st) continue;
-            // Load or get cached unified asset (prefer) or legacy clip (fallback)
-            std::shared_ptr<cm::animation::AnimationAsset> asset;
-            if (!st->AnimationAssetPath.empty()) {
-                auto ita = player.CachedAssets.find(st->Id);
-                if (ita != player.CachedAssets.end()) asset = ita->second; else {
-                    asset = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(st->AnimationAssetPath));
-                    player.CachedAssets[st->Id] = asset;
-                }
-            }
-            std::shared_ptr<cm::animation::AnimationClip> clip;
-            if (!asset && !st->ClipPath.empty()) {
-                auto itc = player.CachedClips.find(st->Id);
-                if (itc != player.CachedClips.end()) clip = itc->second; else {
-                    clip = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(st->ClipPath));
-                    player.CachedClips[st->Id] = clip;
-                }
-            }
+            // Unified asset (preferred) or legacy clip (fallback), shared through the asset cache
+            const ResolvedMotion current = ResolveMotion(player, st->AnimationAssetPath, st->ClipPath);
             // Advance animator time; if Blend1D, use blended duration so normalized time progresses
             float currentDuration = 0.0f;
             if (st->Kind == cm::animation::AnimatorStateKind::Blend1D && !st->Blend1DEntries.empty()) {
@@ -151,17 +370,12 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
                 const auto& a = e[i1]; const auto& b = e[i2];
                 float denom = std::max(1e-6f, (b.Key - a.Key));
                 float t = glm::clamp((x - a.Key) / denom, 0.0f, 1.0f);
-                // Resolve durations for a/b (load or get cached)
-                std::shared_ptr<cm::animation::AnimationAsset> aAsset, bAsset; std::shared_ptr<cm::animation::AnimationClip> aClip, bClip;
-                if (!a.AssetPath.empty()) { auto ita = player.CachedAssets.find(st->Id * 1000 + i1); if (ita != player.CachedAssets.end()) aAsset = ita->second; else { aAsset = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(a.AssetPath)); player.CachedAssets[st->Id * 1000 + i1] = aAsset; } }
-                if (!aAsset && !a.ClipPath.empty()) { auto itc = player.CachedClips.find(st->Id * 1000 + i1); if (itc != player.CachedClips.end()) aClip = itc->second; else { aClip = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(a.ClipPath)); player.CachedClips[st->Id * 1000 + i1] = aClip; } }
-                if (!b.AssetPath.empty()) { auto ita = player.CachedAssets.find(st->Id * 1000 + i2); if (ita != player.CachedAssets.end()) bAsset = ita->second; else { bAsset = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(b.AssetPath)); player.CachedAssets[st->Id * 1000 + i2] = bAsset; } }
-                if (!bAsset && !b.ClipPath.empty()) { auto itc = player.CachedClips.find(st->Id * 1000 + i2); if (itc != player.CachedClips.end()) bClip = itc->second; else { bClip = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(b.ClipPath)); player.CachedClips[st->Id * 1000 + i2] = bClip; } }
-                float d0 = aAsset ? aAsset->Duration() : (aClip ? aClip->Duration : 0.0f);
-                float d1 = bAsset ? bAsset->Duration() : (bClip ? bClip->Duration : 0.0f);
+                // Resolve durations for a/b
+                const float d0 = ResolveMotion(player, a.AssetPath, a.ClipPath).Duration();
+                const float d1 = ResolveMotion(player, b.AssetPath, b.ClipPath).Duration();
                 currentDuration = glm::mix(d0, d1, t);
             } else {
-                currentDuration = asset ? asset->Duration() : (clip ? clip->Duration : 0.0f);
+                currentDuration = current.Duration();
             }
             player.AnimatorInstance.Update(deltaTime * st->Speed * player.PlaybackSpeed, currentDuration);
             // Check transitions
@@ -201,38 +415,21 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
                     float denom = std::max(1e-6f, (b.Key - a.Key));
                     blendT = glm::clamp((x - a.Key) / denom, 0.0f, 1.0f);
                     // Resolve assets/clips for a and b
-                    if (!a.AssetPath.empty()) { auto ita = player.CachedAssets.find(stNowForEval->Id * 1000 + i1); if (ita != player.CachedAssets.end()) assetB0 = ita->second; else { assetB0 = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(a.AssetPath)); player.CachedAssets[stNowForEval->Id * 1000 + i1] = assetB0; } }
-                    if (!assetB0 && !a.ClipPath.empty()) { auto itc = player.CachedClips.find(stNowForEval->Id * 1000 + i1); if (itc != player.CachedClips.end()) clipB0 = itc->second; else { clipB0 = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(a.ClipPath)); player.CachedClips[stNowForEval->Id * 1000 + i1] = clipB0; } }
-                    if (!b.AssetPath.empty()) { auto ita = player.CachedAssets.find(stNowForEval->Id * 1000 + i2); if (ita != player.CachedAssets.end()) assetB1 = ita->second; else { assetB1 = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(b.AssetPath)); player.CachedAssets[stNowForEval->Id * 1000 + i2] = assetB1; } }
-                    if (!assetB1 && !b.ClipPath.empty()) { auto itc = player.CachedClips.find(stNowForEval->Id * 1000 + i2); if (itc != player.CachedClips.end()) clipB1 = itc->second; else { clipB1 = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(b.ClipPath)); player.CachedClips[stNowForEval->Id * 1000 + i2] = clipB1; } }
+                    b0 = ResolveMotion(player, a.AssetPath, a.ClipPath);
+                    b1 = ResolveMotion(player, b.AssetPath, b.ClipPath);
                     useBlend1D = true;
                     // duration as blend of two durations
-                    float d0 = assetB0 ? assetB0->Duration() : (clipB0 ? clipB0->Duration : 0.0f);
-                    float d1 = assetB1 ? assetB1->Duration() : (clipB1 ? clipB1->Duration : 0.0f);
-                    durationNow = glm::mix(d0, d1, blendT);
+                    durationNow = glm::mix(b0.Duration(), b1.Duration(), blendT);
                 } else {
-                    if (!stNowForEval->AnimationAssetPath.empty()) {
-                        auto ita = player.CachedAssets.find(stNowForEval->Id);
-                        if (ita != player.CachedAssets.end()) assetNow = ita->second; else {
-                            assetNow = std::make_shared<cm::animation::AnimationAsset>(cm::animation::LoadAnimationAsset(stNowForEval->AnimationAssetPath));
-                            player.CachedAssets[stNowForEval->Id] = assetNow;
-                        }
-                    }
-                    if (!assetNow && !stNowForEval->ClipPath.empty()) {
-                        auto itc = player.CachedClips.find(stNowForEval->Id);
-                        if (itc != player.CachedClips.end()) clipNow = itc->second; else {
-                            clipNow = std::make_shared<cm::animation::AnimationClip>(cm::animation::LoadAnimationClip(stNowForEval->ClipPath));
-                            player.CachedClips[stNowForEval->Id] = clipNow;
-                        }
-                    }
-                    durationNow = assetNow ? assetNow->Duration() : (clipNow ? clipNow->Duration : 0.0f);
+                    now = ResolveMotion(player, stNowForEval->AnimationAssetPath, stNowForEval->ClipPath);
+                    durationNow = now.Duration();
                 }
             }
 
             if (player.ActiveStates.empty()) player.ActiveStates.push_back({});
             AnimationState& s0 = player.ActiveStates.front();
-            s0.Asset = assetNow.get();
-            s0.LegacyClip = clipNow.get();
+            s0.Asset = now.asset;
+            s0.LegacyClip = now.clip;
             s0.Loop = stNowForEval ? stNowForEval->Loop : true;
             // Derive time from absolute state time so parameter changes (which alter duration) don't cause jumps
             float baseT = player.AnimatorInstance.Playback().StateTime;
@@ -242,25 +439,15 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
 
             // Debug info
             if (stNowForEval) player.Debug_CurrentControllerStateName = stNowForEval->Name;
-            player.Debug_CurrentAnimationName = assetNow ? assetNow->name : (clipNow ? clipNow->Name : std::string());
+            player.Debug_CurrentAnimationName = now.asset ? now.asset->name : (now.clip ? now.clip->Name : std::string());
         }
 
         // Animation Player mode (single clip, no controller)
         if (player.AnimatorMode == AnimationPlayerComponent::Mode::AnimationPlayerAnimated) {
             // Ensure ActiveStates[0] is bound to the selected SingleClipPath if provided
             if (!player.SingleClipPath.empty()) {
-                // Resolve cached asset at key 0
-                std::shared_ptr<cm::animation::AnimationAsset> asset;
-                auto it = player.CachedAssets.find(0);
-                if (it == player.CachedAssets.end()) {
-                    cm::animation::AnimationAsset a = cm::animation::LoadAnimationAsset(player.SingleClipPath);
-                    asset = std::make_shared<cm::animation::AnimationAsset>(std::move(a));
-                    player.CachedAssets[0] = asset;
-                } else {
-                    asset = it->second;
-                }
                 if (player.ActiveStates.empty()) player.ActiveStates.push_back({});
-                player.ActiveStates.front().Asset = player.CachedAssets[0].get();
+                player.ActiveStates.front().Asset = ResolveAsset(player, player.SingleClipPath);
                 player.ActiveStates.front().LegacyClip = nullptr;
                 player.Debug_CurrentAnimationName = player.ActiveStates.front().Asset ? player.ActiveStates.front().Asset->name : std::string();
             }
@@ -303,175 +490,44 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
             player.AnimatorInstance.AdvanceCrossfade(deltaTime * player.PlaybackSpeed);
         }
 
-        std::vector<glm::mat4> localTransforms;
-        // Helper to compute local bind transform for a bone index
-        auto computeLocalBind = [&](int boneIndex) -> glm::mat4 {
-            if (boneIndex < 0 || boneIndex >= (int)skeleton.InverseBindPoses.size()) return glm::mat4(1.0f);
-            glm::mat4 invBind = skeleton.InverseBindPoses[boneIndex];
-            glm::mat4 globalBind = glm::inverse(invBind);
-            int parent = (boneIndex < (int)skeleton.BoneParents.size()) ? skeleton.BoneParents[boneIndex] : -1;
-            glm::mat4 parentGlobal = (parent >= 0 && parent < (int)skeleton.InverseBindPoses.size()) ? glm::inverse(skeleton.InverseBindPoses[parent]) : glm::mat4(1.0f);
-            glm::mat4 localBind = glm::inverse(parentGlobal) * globalBind;
-            return localBind;
-        };
-
+        SkeletonJob job;
+        job.Entity = entityId;
+        job.Player = &player;
+        job.Skeleton = &skeleton;
         if (stNowForEval && stNowForEval->Kind == cm::animation::AnimatorStateKind::Blend1D && useBlend1D) {
-            // Evaluate two samples then blend; drive time from Animator's normalized state
-            std::vector<glm::mat4> A(skeleton.BoneEntities.size(), glm::mat4(1.0f));
-            std::vector<glm::mat4> B(skeleton.BoneEntities.size(), glm::mat4(1.0f));
-            float d0 = assetB0 ? assetB0->Duration() : (clipB0 ? clipB0->Duration : 0.0f);
-            float d1 = assetB1 ? assetB1->Duration() : (clipB1 ? clipB1->Duration : 0.0f);
+            // Two samples blended by the parameter; time driven from Animator's state time
+            const float d0 = b0.Duration();
+            const float d1 = b1.Duration();
             float baseT = player.AnimatorInstance.Playback().StateTime;
             float tA = (d0 > 0.0f) ? fmod(baseT, d0) : 0.0f;
             float tB = (d1 > 0.0f) ? fmod(baseT, d1) : 0.0f;
-            // Sample A
-            if (assetB0) {
-                PoseBuffer pose; pose.local.resize(skeleton.BoneEntities.size(), glm::mat4(1.0f)); pose.touched.resize(skeleton.BoneEntities.size(), false);
-                static BindingCache s_bindings; s_bindings.SetScene(&scene); s_bindings.SetSkeleton(&skeleton);
-                EvalInputs in{ assetB0.get(), tA, stNowForEval->Loop };
-                EvalTargets tgt{ &pose };
-                EvalContext ctx{ &s_bindings, skeleton.Avatar.get(), &skeleton };
-                SampleAsset(in, ctx, tgt, nullptr, nullptr);
-                A = std::move(pose.local);
-            } else if (clipB0) {
-                EvaluateAnimation(*clipB0, tA, skeleton, A);
-            }
-            // Sample B
-            if (assetB1) {
-                PoseBuffer pose; pose.local.resize(skeleton.BoneEntities.size(), glm::mat4(1.0f)); pose.touched.resize(skeleton.BoneEntities.size(), false);
-                static BindingCache s_bindings; s_bindings.SetScene(&scene); s_bindings.SetSkeleton(&skeleton);
-                EvalInputs in{ assetB1.get(), tB, stNowForEval->Loop };
-                EvalTargets tgt{ &pose };
-                EvalContext ctx{ &s_bindings, skeleton.Avatar.get(), &skeleton };
-                SampleAsset(in, ctx, tgt, nullptr, nullptr);
-                B = std::move(pose.local);
-            } else if (clipB1) {
-                EvaluateAnimation(*clipB1, tB, skeleton, B);
-            }
-            // Fill untouched like elsewhere
-            auto ensureBind = [&](std::vector<glm::mat4>& buf){ for (int i=0;i<(int)buf.size();++i) { if (buf[i] == glm::mat4(1.0f)) buf[i] = computeLocalBind(i); } };
-            ensureBind(A); ensureBind(B);
-            // Lerp pose A->B by blendT
-            localTransforms.resize(skeleton.BoneEntities.size(), glm::mat4(1.0f));
-            for (size_t i=0;i<localTransforms.size();++i) {
-                glm::vec3 T0, S0, T1, S1; glm::quat R0, R1;
-                decomposeTRS(A[i], T0, R0, S0);
-                decomposeTRS(B[i], T1, R1, S1);
-                glm::vec3 T = glm::mix(T0, T1, blendT);
-                glm::quat R = glm::slerp(R0, R1, blendT);
-                glm::vec3 S = glm::mix(S0, S1, blendT);
-                localTransforms[i] = glm::translate(T) * glm::mat4_cast(glm::normalize(R)) * glm::scale(S);
-            }
+            job.Desc.primary = { b0.asset, b0.clip, tA, stNowForEval->Loop, &player.Cursors[0] };
+            job.Desc.blend = { b1.asset, b1.clip, tB, stNowForEval->Loop, &player.Cursors[1] };
+            job.Desc.blendWeight = blendT;
         } else if (state.Asset) {
-            // Unified evaluation into a temporary pose buffer sized to skeleton
-            PoseBuffer pose; pose.local.resize(skeleton.BoneEntities.size(), glm::mat4(1.0f)); pose.touched.resize(skeleton.BoneEntities.size(), false);
-            static BindingCache s_bindings; s_bindings.SetScene(&scene); s_bindings.SetSkeleton(&skeleton);
-            EvalInputs in{ state.Asset, mutableState.Time, mutableState.Loop };
-            EvalTargets tgt{ &pose };
-            EvalContext ctx{ &s_bindings, skeleton.Avatar.get(), &skeleton };
-            // Collect script events and property writes (if any)
-            std::vector<cm::animation::ScriptEvent> firedEvents;
-            nlohmann::json propWrites;
-            SampleAsset(in, ctx, tgt, &firedEvents, &propWrites);
-            localTransforms = std::move(pose.local);
-            // Fill untouched bones with bind pose locals
-            for (int i = 0; i < (int)localTransforms.size(); ++i) {
-                if (i < (int)pose.touched.size() && !pose.touched[i]) {
-                    localTransforms[i] = computeLocalBind(i);
-                }
-            }
-
-            // Dispatch script events to managed scripts attached to the skeleton root entity
-            if (!firedEvents.empty()) {
-                auto* rootData = scene.GetEntityData(ent.GetID());
-                if (rootData) {
-                    for (const auto& ev : firedEvents) {
-                        const std::string& targetClass  = ev.className;
-                        const std::string& targetMethod = ev.method;
-                        for (auto& script : rootData->Scripts) {
-                            if (!script.Instance) continue;
-                            if (script.ClassName != targetClass) continue;
-                            if (script.Instance->GetBackend() == ScriptBackend::Managed) {
-                                auto managed = std::dynamic_pointer_cast<ManagedScriptComponent>(script.Instance);
-                                if (managed && g_Script_Invoke) {
-                                    g_Script_Invoke(managed->GetHandle(), targetMethod.c_str());
-                                }
-                            }
-                        }
-                    }
-                }
+            job.Desc.primary = { state.Asset, nullptr, mutableState.Time, mutableState.Loop, &player.Cursors[0] };
+            // Script events crossed since the last frame, at any LOD level
+            if (shouldAdvance && deltaTime * player.PlaybackSpeed > 0.0f) {
+                // A new asset, or a clip that ran out and started over: everything up to now
+                const bool restarted = player._EventAsset != state.Asset || (!mutableState.Loop && mutableState.Time < player._EventTime);
+                CollectScriptEvents(*state.Asset, restarted ? -1.0f : player._EventTime, mutableState.Time, job.Events);
             }
-        } else if (state.LegacyClip) {
-            EvaluateAnimation(*state.LegacyClip, mutableState.Time, skeleton, localTransforms);
-            // EvaluateAnimation leaves non-animated bones as identity; replace with bind locals
-            for (int i = 0; i < (int)localTransforms.size(); ++i) {
-                // Identity check: compare to mat4 identity exactly (inputs are exact identity)
-                if (localTransforms[i] == glm::mat4(1.0f)) {
-                    localTransforms[i] = computeLocalBind(i);
-                } 
-            } 
+            player._EventAsset = state.Asset;
+            player._EventTime = mutableState.Time;
+        } else {
+            job.Desc.primary = { nullptr, state.LegacyClip, mutableState.Time, mutableState.Loop };
         }
-         
-        // Crossfade blend if active: sample next state and blend matrices linearly (local-space)
+
+        // Crossfade: sample the next state as well and blend in local space
         if (player.AnimatorInstance.IsCrossfading() && player.Controller && player.AnimatorMode == AnimationPlayerComponent::Mode::ControllerAnimated) {
             int nextId = player.AnimatorInstance.Playback().NextStateId;
             const auto* nextSt = player.Controller->FindState(nextId);
             if (nextSt) {
-                const AnimationAsset* nextAsset = nullptr;
-                std::shared_ptr<AnimationAsset> nextAssetPtr;
-                if (!nextSt->AnimationAssetPath.empty()) { 
-                    auto it = player.CachedAssets.find(nextSt->Id);
-                    if (it != player.CachedAssets.end()) nextAssetPtr = it->second; else {
-                        nextAssetPtr = std::make_shared<AnimationAsset>(LoadAnimationAsset(nextSt->AnimationAssetPath));
-                        player.CachedAssets[nextSt->Id] = nextAssetPtr;
-                    }
-                    nextAsset = nextAssetPtr.get();
-                }
-                std::shared_ptr<AnimationClip> nextClip;
-                if (!nextAsset && !nextSt->ClipPath.empty()) {
-                    auto itc = player.CachedClips.find(nextSt->Id);
-                    if (itc != player.CachedClips.end()) nextClip = itc->second; else {
-                        nextClip = std::make_shared<AnimationClip>(LoadAnimationClip(nextSt->ClipPath));
-                        player.CachedClips[nextSt->Id] = nextClip;
-                    }
-                }
-
-                std::vector<glm::mat4> nextLocal(localTransforms.size(), glm::mat4(1.0f));
-                float nextTime = player.AnimatorInstance.Playback().NextStateTime;
-                if (nextAsset) {
-                    PoseBuffer pose; pose.local.resize(skeleton.BoneEntities.size(), glm::mat4(1.0f)); pose.touched.resize(skeleton.BoneEntities.size(), false);
-                    static BindingCache s_bindings; s_bindings.SetScene(&scene); s_bindings.SetSkeleton(&skeleton);
-                    EvalInputs in{ nextAsset, nextTime, nextSt->Loop };
-                    EvalTargets tgt{ &pose };
-                    EvalContext ctx{ &s_bindings, skeleton.Avatar.get(), &skeleton };
-                    SampleAsset(in, ctx, tgt, nullptr, nullptr);
-                    nextLocal = std::move(pose.local);
-                } else if (nextClip) {
-                    EvaluateAnimation(*nextClip, nextTime, skeleton, nextLocal);
-                }
+                const ResolvedMotion next = ResolveMotion(player, nextSt->AnimationAssetPath, nextSt->ClipPath);
 
                 float a = player.AnimatorInstance.CrossfadeAlpha();
-                if (!nextLocal.empty() && nextLocal.size() == localTransforms.size()) {
-                    for (size_t i = 0; i < localTransforms.size(); ++i) {
-                        glm::vec3 T0, S0, T1, S1; glm::quat R0, R1;
-                        auto decompose = [](const glm::mat4& m, glm::vec3& T, glm::quat& R, glm::vec3& S){
-                            T = glm::vec3(m[3]);
-                            glm::vec3 X = glm::vec3(m[0]);
-                            glm::vec3 Y = glm::vec3(m[1]);
-                            glm::vec3 Z = glm::vec3(m[2]);
-                            S = glm::vec3(glm::length(X), glm::length(Y), glm::length(Z));
-                            if (S.x > 1e-6f) X /= S.x; if (S.y > 1e-6f) Y /= S.y; if (S.z > 1e-6f) Z /= S.z;
-                            glm::mat3 rotMat(X, Y, Z);
-                            R = glm::quat_cast(rotMat);
-                        };
-                        decompose(localTransforms[i], T0, R0, S0);
-                        decompose(nextLocal[i], T1, R1, S1);
-                        glm::vec3 T = glm::mix(T0, T1, a);
-                        glm::quat R = glm::slerp(R0, R1, a);
-                        glm::vec3 S = glm::mix(S0, S1, a);
-                        localTransforms[i] = glm::translate(T) * glm::mat4_cast(glm::normalize(R)) * glm::scale(S);
-                    }
-                }
+                job.Desc.crossfade = { next.asset, next.clip, player.AnimatorInstance.Playback().NextStateTime, nextSt->Loop, &player.Cursors[2] };
+                job.Desc.crossfadeAlpha = a;
                 if (a >= 1.0f) {
                     // Crossfade complete: ensure Animator's current state is updated as well
                     player.AnimatorInstance.SetCurrentState(nextId, /*resetTime*/true);
@@ -480,105 +536,59 @@ void AnimationSystem::Update(::Scene& scene, float deltaTime) {
             }
         }
 
-        // Humanoid constraint: keep translation/scale only on root/hips; others use bind T/S, animated rotation
-        if (skeleton.Avatar) {
-            int hipsIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Hips);
-            int rootIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Root);
-            for (int i = 0; i < (int)localTransforms.size(); ++i) {
-                if (i == hipsIdx || i == rootIdx) continue;
-                glm::vec3 Ta, Sa; glm::quat Ra;
-                decomposeTRS(localTransforms[i], Ta, Ra, Sa);
-                glm::mat4 bindLocal = computeLocalBind(i);
-                glm::vec3 Tb, Sb; glm::quat Rb; // Rb unused
-                decomposeTRS(bindLocal, Tb, Rb, Sb);
-                localTransforms[i] = glm::translate(Tb) * glm::mat4_cast(glm::normalize(Ra)) * glm::scale(Sb);
-            }
-        }
+        if (skeleton.BindLocals.size() != skeleton.BoneEntities.size()) ComputeBindLocals(skeleton, skeleton.BindLocals);
+        if (!observedCurrent(skeleton)) RefreshObservedBones(scene, skeleton, componentVersion);
 
-        // Root motion handling and in-place playback
-        if (skeleton.Avatar) {
-            // Compose model matrix from locals up the parent chain
-            auto composeModel = [&](int boneIndex) -> glm::mat4 {
-                glm::mat4 model(1.0f);
-                int bi = boneIndex;
-                while (bi >= 0) {
-                    model = localTransforms[bi] * model;
-                    bi = (bi < (int)skeleton.BoneParents.size()) ? skeleton.BoneParents[bi] : -1;
-                }
-                return model;
-            };
-
-            // Replace a bone's local translation with its bind local translation, preserve animated R/S
-            auto zeroLocalTranslationToBind = [&](int boneIndex) {
-                if (boneIndex < 0 || boneIndex >= (int)localTransforms.size()) return;
-                glm::vec3 Ta, Sa; glm::quat Ra;
-                decomposeTRS(localTransforms[boneIndex], Ta, Ra, Sa);
-                glm::vec3 Tb, Sb; glm::quat Rb;
-                decomposeTRS(computeLocalBind(boneIndex), Tb, Rb, Sb);
-                localTransforms[boneIndex] = glm::translate(Tb) * glm::mat4_cast(glm::normalize(Ra)) * glm::scale(Sb);
-            };
-
-            int hipsIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Hips);
-            int rootIdx = skeleton.Avatar->GetMappedBoneIndex(cm::animation::HumanoidBone::Root);
-
-            switch (player.RootMotion) {
-                case AnimationPlayerComponent::RootMotionMode::None: {
-                    // Keep rig in-place: zero translation on hips and root back to bind
-                    zeroLocalTranslationToBind(hipsIdx);
-                    zeroLocalTranslationToBind(rootIdx);
-                    player._PrevRootValid = false;
-                } break;
-
-                case AnimationPlayerComponent::RootMotionMode::FromHipsToEntity:
-                case AnimationPlayerComponent::RootMotionMode::FromRootToEntity: {
-                    const int src = (player.RootMotion == AnimationPlayerComponent::RootMotionMode::FromHipsToEntity) ? hipsIdx : rootIdx;
-                    if (src >= 0) {
-                        glm::vec3 curPos = glm::vec3(composeModel(src)[3]);
-                        if (player._PrevRootValid) {
-                            glm::vec3 delta = curPos - player._PrevRootModelPos;
-                            if (auto* rootData = scene.GetEntityData(ent.GetID())) {
-                                rootData->Transform.Position += delta;
-                                rootData->Transform.TransformDirty = true;
-                            }
-                        }
-                        player._PrevRootModelPos = curPos;
-                        player._PrevRootValid = true;
+        // LOD: update rate and sampled bones from the skeleton's projected size
+        AnimationLODState& lod = skeleton.LOD;
+        if (camera) {
+            if (lod.BoneExtents.size() != skeleton.BoneEntities.size()) ComputeLODBounds(skeleton, lod);
+            lod.ScreenSize = ProjectedScreenSize(view, projection, data->Transform.WorldMatrix, lod);
+            lod.Level = SelectLOD(lod.ScreenSize, lod.Level, lodSettings);
+            BuildLODBoneMask(skeleton, lodSettings, lod);
+        } else {
+            lod.Level = AnimationLOD::Full;
+            lod.BoneMask.clear();
+        }
+        job.Desc.boneMask = lod.BoneMask.empty() ? nullptr : &lod.BoneMask;
+        job.Frame = ScheduleLOD(lod, (uint32_t)entityId, skeleton.Pose.model.size() == skeleton.BoneEntities.size());
+        s_Jobs.push_back(std::move(job));
+    }
 
-                        // After extracting root motion, keep the animated bone in-place
-                        zeroLocalTranslationToBind(src);
-                    } else {
-                        player._PrevRootValid = false;
-                    }
-                } break;
+    // Phase 2 (workers): sample, blend and compose each skeleton's pose in its own task;
+    // throttled skeletons between evaluations interpolate, frozen ones keep their pose,
+    // and both sample only the root motion bone
+    parallel_for(Jobs(), size_t{ 0 }, s_Jobs.size(), size_t{ 1 },
+        [](size_t start, size_t count) {
+        for (size_t i = start; i < start + count; ++i) {
+            SkeletonJob& job = s_Jobs[i];
+            ::SkeletonComponent& skeleton = *job.Skeleton;
+            if (job.Frame.Evaluate) {
+                PoseBuffer& pose = BeginLODEvaluation(skeleton, job.Frame);
+                EvaluatePose(job.Desc, skeleton, skeleton.BindLocals, pose);
+                ApplyRootMotion(job, pose.local);
+                ComputeModelPose(pose, skeleton.BoneParents);
+            } else {
+                const int src = RootMotionBone(skeleton, *job.Player);
+                if (src >= 0) TakeRootDelta(job, EvaluateBoneModelPosition(job.Desc, skeleton, skeleton.BindLocals, src));
+                else job.Player->_PrevRootValid = false;
             }
+            FinishLODFrame(skeleton, job.Frame);
+            skeleton.PoseValid = true;
         }
+        });
 
-        // Write evaluated local pose into bone entities as TRS so transform system recomputes matrices
-        auto decomposeTRS = [](const glm::mat4& m, glm::vec3& T, glm::quat& R, glm::vec3& S){
-            T = glm::vec3(m[3]);
-            glm::vec3 X = glm::vec3(m[0]);
-            glm::vec3 Y = glm::vec3(m[1]);
-            glm::vec3 Z = glm::vec3(m[2]);
-            S = glm::vec3(glm::length(X), glm::length(Y), glm::length(Z));
-            if (S.x > 1e-6f) X /= S.x; if (S.y > 1e-6f) Y /= S.y; if (S.z > 1e-6f) Z /= S.z;
-            glm::mat3 rotMat(X, Y, Z);
-            R = glm::quat_cast(rotMat);
-        };
-        for (size_t i = 0; i < localTransforms.size() && i < skeleton.BoneEntities.size(); ++i) {
-            EntityID boneId = skeleton.BoneEntities[i];
-            if (boneId == (EntityID)-1) continue;
-            if (auto* bd = scene.GetEntityData(boneId)) {
-                glm::vec3 T, S; glm::quat R;
-                decomposeTRS(localTransforms[i], T, R, S);
-                bd->Transform.Position = T;
-                bd->Transform.Scale    = S;
-                bd->Transform.RotationQ = glm::normalize(R);
-                bd->Transform.UseQuatRotation = true;
-                // Keep Euler for inspector display
-                bd->Transform.Rotation = glm::degrees(glm::eulerAngles(bd->Transform.RotationQ));
-                bd->Transform.TransformDirty = true;
+    // Phase 3 (main thread): script events, root motion and bone entity write-back
+    for (SkeletonJob& job : s_Jobs) {
+        if (!job.Events.empty()) DispatchScriptEvents(scene, job.Entity, job.Events);
+        if (job.HasRootDelta) {
+            if (auto* rootData = scene.GetEntityData(job.Entity)) {
+                rootData->Transform.Position += job.RootDelta;
+                scene.MarkTransformDirty(job.Entity);
             }
         }
+        // Frozen: the bones already hold this pose
+        if (job.Frame.Evaluate || job.Frame.Alpha >= 0.0f) WriteBoneEntities(scene, *job.Skeleton);
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include "ecs/Scene.h"
 #include "animation/AnimationEvaluator.h"
+#include "animation/AnimationLOD.h"
 #include "animation/AnimationPlayerComponent.h"
 #include "ecs/AnimationComponents.h"
 
@@ -10,8 +11,17 @@ namespace animation {
 
 class AnimationSystem {
 public:
-    // Call each frame.
+    // Call each frame. Controller/state updates run on the calling thread; each
+    // skeleton's pose is then sampled into SkeletonComponent::Pose on the job system.
     static void Update(::Scene& scene, float deltaTime);
+
+    // Screen-size thresholds of the animation LOD (AnimationLOD.h), measured against
+    // the scene's active camera. Enabled = false evaluates every skeleton every frame.
+    static AnimationLODSettings& LODSettings();
+
+    // Writes skeleton.Pose.local into the TRS of observed bone entities (every bone
+    // with WriteBackAllBones) and marks them dirty.
+    static void WriteBoneEntities(::Scene& scene, ::SkeletonComponent& skeleton);
 };
 
 } // namespace animation
@@ -1,6 +1,5 @@
 #include "animation/BindingCache.h"
 #include "ecs/AnimationComponents.h"
-#include "ecs/Scene.h"
 
 #include <functional>
 
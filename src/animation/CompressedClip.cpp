@@ -0,0 +1,398 @@
+#include "animation/CompressedClip.h"
+#include "animation/AnimationAsset.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLAYMORE_ANIM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace cm {
+namespace animation {
+
+namespace {
+
+constexpr uint32_t kLanes = 4;
+constexpr float kQuatRange = 0.70710678f;                    // smallest-three components lie in [-k, k]
+constexpr float kQuatStep = 2.0f * kQuatRange / 32767.0f;
+constexpr uint16_t kQuatMask = 0x7FFF;
+
+uint32_t PadToLanes(uint32_t n) { return (n + kLanes - 1) / kLanes * kLanes; }
+
+// --- Encoding -------------------------------------------------------------------
+
+void EncodeQuat(glm::quat q, uint16_t& a, uint16_t& b, uint16_t& c) {
+    const float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (len > 1e-12f) { q.x /= len; q.y /= len; q.z /= len; q.w /= len; }
+    else q = glm::quat(1, 0, 0, 0);
+    float comp[4] = { q.x, q.y, q.z, q.w };
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) if (std::abs(comp[i]) > std::abs(comp[largest])) largest = i;
+    const float sign = comp[largest] < 0.0f ? -1.0f : 1.0f;
+    uint16_t stored[3];
+    for (int i = 0, o = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float v = std::clamp(comp[i] * sign, -kQuatRange, kQuatRange);
+        stored[o++] = (uint16_t)std::lround((v + kQuatRange) / kQuatStep);
+    }
+    a = uint16_t(stored[0] | ((largest & 1) << 15));
+    b = uint16_t(stored[1] | ((largest >> 1) << 15));
+    c = stored[2];
+}
+
+bool IsConstant(const std::vector<glm::vec3>& v, float tol) {
+    for (const glm::vec3& x : v)
+        if (std::abs(x.x - v[0].x) > tol || std::abs(x.y - v[0].y) > tol || std::abs(x.z - v[0].z) > tol) return false;
+    return true;
+}
+
+bool IsConstant(const std::vector<glm::quat>& q, float tol) {
+    for (const glm::quat& x : q) {
+        // q and -q are the same rotation
+        const float s = (x.x * q[0].x + x.y * q[0].y + x.z * q[0].z + x.w * q[0].w) < 0.0f ? -1.0f : 1.0f;
+        if (std::abs(x.x * s - q[0].x) > tol || std::abs(x.y * s - q[0].y) > tol
+            || std::abs(x.z * s - q[0].z) > tol || std::abs(x.w * s - q[0].w) > tol) return false;
+    }
+    return true;
+}
+
+// --- Sampling kernels ---------------------------------------------------------------
+
+// The two frames around t and the blend between them
+void FramesAt(const CompressedClip& clip, float t, uint32_t& f0, uint32_t& f1, float& alpha) {
+    f0 = f1 = 0;
+    alpha = 0.0f;
+    if (clip.frameCount > 1 && clip.frameStep > 0.0f) {
+        const float u = std::clamp(t / clip.frameStep, 0.0f, float(clip.frameCount - 1));
+        f0 = std::min((uint32_t)u, clip.frameCount - 2);
+        f1 = f0 + 1;
+        alpha = u - float(f0);
+    }
+}
+
+// Scalar decode; DecodeQuat4 is the same per lane
+glm::quat DecodeQuat(uint16_t a, uint16_t b, uint16_t c) {
+    const int largest = (a >> 15) | ((b >> 15) << 1);
+    const float va = float(a & kQuatMask) * kQuatStep - kQuatRange;
+    const float vb = float(b & kQuatMask) * kQuatStep - kQuatRange;
+    const float vc = float(c & kQuatMask) * kQuatStep - kQuatRange;
+    const float d = std::sqrt(std::max(0.0f, 1.0f - va * va - vb * vb - vc * vc));
+    switch (largest) {
+        case 0:  return glm::quat(vc, d, va, vb);
+        case 1:  return glm::quat(vc, va, d, vb);
+        case 2:  return glm::quat(vc, va, vb, d);
+        default: return glm::quat(d, va, vb, vc);
+    }
+}
+
+#if !defined(CLAYMORE_ANIM_SSE)
+void SampleRotationsScalar(const CompressedClip& clip, const uint16_t* f0, const uint16_t* f1, float alpha,
+                           CompressedSample& out)
+{
+    const uint32_t stride = clip.rotationStride;
+    for (uint32_t i = 0; i < clip.rotationCount; ++i) {
+        const glm::quat q0 = DecodeQuat(f0[i], f0[stride + i], f0[2 * stride + i]);
+        glm::quat q1 = DecodeQuat(f1[i], f1[stride + i], f1[2 * stride + i]);
+        const float dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+        const float s = dot < 0.0f ? -1.0f : 1.0f;
+        float x = q0.x + (q1.x * s - q0.x) * alpha;
+        float y = q0.y + (q1.y * s - q0.y) * alpha;
+        float z = q0.z + (q1.z * s - q0.z) * alpha;
+        float w = q0.w + (q1.w * s - q0.w) * alpha;
+        const float inv = 1.0f / std::sqrt(std::max(1e-12f, x * x + y * y + z * z + w * w));
+        out.rx[i] = x * inv; out.ry[i] = y * inv; out.rz[i] = z * inv; out.rw[i] = w * inv;
+    }
+}
+
+void SampleVectorsScalar(const CompressedClip& clip, const uint16_t* f0, const uint16_t* f1, float alpha,
+                         CompressedSample& out)
+{
+    const uint32_t stride = clip.vectorStride;
+    float* dst[3] = { out.vx.data(), out.vy.data(), out.vz.data() };
+    for (uint32_t c = 0; c < 3; ++c) {
+        const float* mn = clip.vectorMin.data() + c * stride;
+        const float* sc = clip.vectorScale.data() + c * stride;
+        for (uint32_t i = 0; i < clip.vectorCount; ++i) {
+            const float a = float(f0[c * stride + i]);
+            const float b = float(f1[c * stride + i]);
+            dst[c][i] = mn[i] + sc[i] * (a + (b - a) * alpha);
+        }
+    }
+}
+#else
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+inline __m128i Load4(const uint16_t* p) {
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+}
+
+// Smallest-three decode of 4 channels into x, y, z, w lanes
+inline void DecodeQuat4(const uint16_t* pa, const uint16_t* pb, const uint16_t* pc,
+                        __m128& x, __m128& y, __m128& z, __m128& w)
+{
+    const __m128i a = Load4(pa), b = Load4(pb), c = Load4(pc);
+    const __m128i mask = _mm_set1_epi32(kQuatMask);
+    const __m128i largest = _mm_or_si128(_mm_srli_epi32(a, 15), _mm_slli_epi32(_mm_srli_epi32(b, 15), 1));
+    const __m128 step = _mm_set1_ps(kQuatStep), range = _mm_set1_ps(kQuatRange);
+    const __m128 va = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(a, mask)), step), range);
+    const __m128 vb = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(b, mask)), step), range);
+    const __m128 vc = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(c, mask)), step), range);
+    const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(va, va), _mm_mul_ps(vb, vb)), _mm_mul_ps(vc, vc));
+    const __m128 d = _mm_sqrt_ps(_mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_set1_ps(1.0f), sum)));
+    const __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_setzero_si128()));
+    const __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(1)));
+    const __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(2)));
+    const __m128 is3 = _mm_castsi128_ps(_mm_cmpeq_epi32(largest, _mm_set1_epi32(3)));
+    x = Select(is0, d, va);
+    y = Select(is0, va, Select(is1, d, vb));
+    z = Select(is2, d, Select(is3, vc, vb));
+    w = Select(is3, d, vc);
+}
+
+void SampleRotationsSSE(const CompressedClip& clip, const uint16_t* f0, const uint16_t* f1, float alpha, CompressedSample& out) {
+    const uint32_t stride = clip.rotationStride;
+    const __m128 t = _mm_set1_ps(alpha);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    for (uint32_t i = 0; i < clip.rotationCount; i += kLanes) {
+        __m128 x0, y0, z0, w0, x1, y1, z1, w1;
+        DecodeQuat4(f0 + i, f0 + stride + i, f0 + 2 * stride + i, x0, y0, z0, w0);
+        DecodeQuat4(f1 + i, f1 + stride + i, f1 + 2 * stride + i, x1, y1, z1, w1);
+        // Shortest arc: flip the second key where the dot product is negative
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x0, x1), _mm_mul_ps(y0, y1)),
+                                      _mm_add_ps(_mm_mul_ps(z0, z1), _mm_mul_ps(w0, w1)));
+        const __m128 flip = _mm_and_ps(dot, signBit);
+        x1 = _mm_xor_ps(x1, flip); y1 = _mm_xor_ps(y1, flip); z1 = _mm_xor_ps(z1, flip); w1 = _mm_xor_ps(w1, flip);
+        const __m128 x = _mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), t));
+        const __m128 y = _mm_add_ps(y0, _mm_mul_ps(_mm_sub_ps(y1, y0), t));
+        const __m128 z = _mm_add_ps(z0, _mm_mul_ps(_mm_sub_ps(z1, z0), t));
+        const __m128 w = _mm_add_ps(w0, _mm_mul_ps(_mm_sub_ps(w1, w0), t));
+        const __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(len2, _mm_set1_ps(1e-12f))));
+        _mm_storeu_ps(&out.rx[i], _mm_mul_ps(x, inv));
+        _mm_storeu_ps(&out.ry[i], _mm_mul_ps(y, inv));
+        _mm_storeu_ps(&out.rz[i], _mm_mul_ps(z, inv));
+        _mm_storeu_ps(&out.rw[i], _mm_mul_ps(w, inv));
+    }
+}
+
+void SampleVectorsSSE(const CompressedClip& clip, const uint16_t* f0, const uint16_t* f1, float alpha, CompressedSample& out) {
+    const uint32_t stride = clip.vectorStride;
+    const __m128 t = _mm_set1_ps(alpha);
+    float* dst[3] = { out.vx.data(), out.vy.data(), out.vz.data() };
+    for (uint32_t c = 0; c < 3; ++c) {
+        const float* mn = clip.vectorMin.data() + c * stride;
+        const float* sc = clip.vectorScale.data() + c * stride;
+        for (uint32_t i = 0; i < clip.vectorCount; i += kLanes) {
+            const __m128 a = _mm_cvtepi32_ps(Load4(f0 + c * stride + i));
+            const __m128 b = _mm_cvtepi32_ps(Load4(f1 + c * stride + i));
+            const __m128 q = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+            _mm_storeu_ps(dst[c] + i, _mm_add_ps(_mm_loadu_ps(mn + i), _mm_mul_ps(_mm_loadu_ps(sc + i), q)));
+        }
+    }
+}
+#endif
+
+} // namespace
+
+size_t CompressedClip::ByteSize() const {
+    return tracks.size() * sizeof(Track)
+        + constRotations.size() * sizeof(glm::quat) + constVectors.size() * sizeof(glm::vec3)
+        + rotations.size() * sizeof(uint16_t) + vectors.size() * sizeof(uint16_t)
+        + (vectorMin.size() + vectorScale.size()) * sizeof(float);
+}
+
+size_t BoneCurveBytes(const AnimationAsset& asset) {
+    size_t bytes = 0;
+    for (const auto& t : asset.tracks) {
+        if (!t || t->type != TrackType::Bone) continue;
+        const auto* bt = static_cast<const AssetBoneTrack*>(t.get());
+        bytes += bt->t.keys.size() * sizeof(KeyVec3) + bt->r.keys.size() * sizeof(KeyQuat) + bt->s.keys.size() * sizeof(KeyVec3);
+    }
+    return bytes;
+}
+
+std::unique_ptr<CompressedClip> CookCompressedClip(const AnimationAsset& asset, const CompressedCookOptions& options) {
+    std::vector<uint32_t> bones;
+    bool retargeted = false;
+    for (size_t i = 0; i < asset.tracks.size(); ++i) {
+        const auto& t = asset.tracks[i];
+        if (t && !t->muted && t->type == TrackType::Bone) bones.push_back((uint32_t)i);
+        retargeted = retargeted || (t && !t->muted && t->type == TrackType::Avatar);
+    }
+    if (bones.empty()) return nullptr;
+
+    auto clip = std::make_unique<CompressedClip>();
+    clip->retargeted = retargeted;
+    clip->duration = std::max(0.0f, asset.Duration());
+    const float rate = options.sampleRate > 0.0f ? options.sampleRate : (asset.meta.fps > 0.0f ? asset.meta.fps : 30.0f);
+    clip->frameCount = clip->duration > 0.0f ? std::max(2u, (uint32_t)std::ceil(clip->duration * rate) + 1) : 1u;
+    clip->frameStep = clip->frameCount > 1 ? clip->duration / float(clip->frameCount - 1) : 0.0f;
+    const uint32_t frames = clip->frameCount;
+
+    // Resample every channel at the frame times, then sort channels into constants and animated
+    std::vector<std::vector<glm::quat>> animatedRot;
+    std::vector<std::vector<glm::vec3>> animatedVec;
+    std::vector<glm::quat> rot(frames);
+    std::vector<glm::vec3> vec(frames);
+    auto vectorChannel = [&](const CurveVec3& curve) {
+        CompressedClip::Channel ch;
+        if (curve.keys.empty()) return ch;
+        int cursor = 0;
+        for (uint32_t f = 0; f < frames; ++f) vec[f] = curve.Sample(float(f) * clip->frameStep, false, 0.0f, &cursor);
+        if (IsConstant(vec, options.constantTolerance)) {
+            ch.kind = CompressedClip::ChannelKind::Constant;
+            ch.index = (uint32_t)clip->constVectors.size();
+            clip->constVectors.push_back(vec[0]);
+        } else {
+            ch.kind = CompressedClip::ChannelKind::Animated;
+            ch.index = (uint32_t)animatedVec.size();
+            animatedVec.push_back(vec);
+        }
+        return ch;
+    };
+    for (uint32_t ti : bones) {
+        const auto* bt = static_cast<const AssetBoneTrack*>(asset.tracks[ti].get());
+        CompressedClip::Track track;
+        track.assetTrack = ti;
+        track.boneId = bt->boneId;
+        track.translation = vectorChannel(bt->t);
+        track.scale = vectorChannel(bt->s);
+        if (!bt->r.keys.empty()) {
+            int cursor = 0;
+            for (uint32_t f = 0; f < frames; ++f) rot[f] = bt->r.Sample(float(f) * clip->frameStep, false, 0.0f, &cursor);
+            if (IsConstant(rot, options.constantTolerance)) {
+                track.rotation = { CompressedClip::ChannelKind::Constant, (uint32_t)clip->constRotations.size() };
+                clip->constRotations.push_back(glm::normalize(rot[0]));
+            } else {
+                track.rotation = { CompressedClip::ChannelKind::Animated, (uint32_t)animatedRot.size() };
+                animatedRot.push_back(rot);
+            }
+        }
+        clip->tracks.push_back(track);
+    }
+
+    // Rotations: smallest-three; padding lanes decode to identity
+    clip->rotationCount = (uint32_t)animatedRot.size();
+    clip->rotationStride = PadToLanes(clip->rotationCount);
+    const uint32_t rs = clip->rotationStride;
+    clip->rotations.assign(size_t(frames) * 3 * rs, 0);
+    for (uint32_t f = 0; f < frames; ++f) {
+        uint16_t* block = clip->rotations.data() + size_t(f) * 3 * rs;
+        for (uint32_t i = 0; i < rs; ++i) {
+            const glm::quat q = i < clip->rotationCount ? animatedRot[i][f] : glm::quat(1, 0, 0, 0);
+            EncodeQuat(q, block[i], block[rs + i], block[2 * rs + i]);
+        }
+    }
+
+    // Translations and scales: 16 bits over each channel's range
+    clip->vectorCount = (uint32_t)animatedVec.size();
+    clip->vectorStride = PadToLanes(clip->vectorCount);
+    const uint32_t vs = clip->vectorStride;
+    clip->vectorMin.assign(size_t(3) * vs, 0.0f);
+    clip->vectorScale.assign(size_t(3) * vs, 0.0f);
+    clip->vectors.assign(size_t(frames) * 3 * vs, 0);
+    for (uint32_t i = 0; i < clip->vectorCount; ++i) {
+        for (uint32_t c = 0; c < 3; ++c) {
+            float lo = animatedVec[i][0][c], hi = lo;
+            for (const glm::vec3& v : animatedVec[i]) { lo = std::min(lo, v[c]); hi = std::max(hi, v[c]); }
+            const float scale = (hi - lo) / 65535.0f;
+            clip->vectorMin[c * vs + i] = lo;
+            clip->vectorScale[c * vs + i] = scale;
+            for (uint32_t f = 0; f < frames; ++f) {
+                const float q = scale > 0.0f ? (animatedVec[i][f][c] - lo) / scale : 0.0f;
+                clip->vectors[size_t(f) * 3 * vs + c * vs + i] = (uint16_t)std::clamp(std::lround(q), 0L, 65535L);
+            }
+        }
+    }
+    return clip;
+}
+
+void SampleCompressed(const CompressedClip& clip, float t, CompressedSample& out) {
+    out.rx.resize(clip.rotationStride); out.ry.resize(clip.rotationStride);
+    out.rz.resize(clip.rotationStride); out.rw.resize(clip.rotationStride);
+    out.vx.resize(clip.vectorStride); out.vy.resize(clip.vectorStride); out.vz.resize(clip.vectorStride);
+    if (clip.frameCount == 0) return;
+
+    uint32_t f0, f1;
+    float alpha;
+    FramesAt(clip, t, f0, f1, alpha);
+    const uint16_t* r0 = clip.rotations.data() + size_t(f0) * 3 * clip.rotationStride;
+    const uint16_t* r1 = clip.rotations.data() + size_t(f1) * 3 * clip.rotationStride;
+    const uint16_t* v0 = clip.vectors.data() + size_t(f0) * 3 * clip.vectorStride;
+    const uint16_t* v1 = clip.vectors.data() + size_t(f1) * 3 * clip.vectorStride;
+#if defined(CLAYMORE_ANIM_SSE)
+    SampleRotationsSSE(clip, r0, r1, alpha, out);
+    SampleVectorsSSE(clip, v0, v1, alpha, out);
+#else
+    SampleRotationsScalar(clip, r0, r1, alpha, out);
+    SampleVectorsScalar(clip, v0, v1, alpha, out);
+#endif
+}
+
+void CompressedTrackTRS(const CompressedClip& clip, const CompressedSample& sample, const CompressedClip::Track& track,
+                        glm::vec3& T, glm::quat& R, glm::vec3& S)
+{
+    using Kind = CompressedClip::ChannelKind;
+    auto vector = [&](const CompressedClip::Channel& ch, const glm::vec3& fallback) {
+        if (ch.kind == Kind::Constant) return clip.constVectors[ch.index];
+        if (ch.kind == Kind::Animated) return glm::vec3(sample.vx[ch.index], sample.vy[ch.index], sample.vz[ch.index]);
+        return fallback;
+    };
+    T = vector(track.translation, glm::vec3(0.0f));
+    S = vector(track.scale, glm::vec3(1.0f));
+    if (track.rotation.kind == Kind::Constant) R = clip.constRotations[track.rotation.index];
+    else if (track.rotation.kind == Kind::Animated) {
+        const uint32_t i = track.rotation.index;
+        R = glm::quat(sample.rw[i], sample.rx[i], sample.ry[i], sample.rz[i]);
+    }
+    else R = glm::quat(1, 0, 0, 0);
+}
+
+void SampleCompressedTrack(const CompressedClip& clip, const CompressedClip::Track& track, float t,
+                           glm::vec3& T, glm::quat& R, glm::vec3& S)
+{
+    using Kind = CompressedClip::ChannelKind;
+    uint32_t f0 = 0, f1 = 0;
+    float alpha = 0.0f;
+    if (clip.frameCount > 0) FramesAt(clip, t, f0, f1, alpha);
+    auto vector = [&](const CompressedClip::Channel& ch, const glm::vec3& fallback) {
+        if (ch.kind == Kind::Constant) return clip.constVectors[ch.index];
+        if (ch.kind != Kind::Animated || clip.frameCount == 0) return fallback;
+        const uint32_t stride = clip.vectorStride;
+        const uint16_t* v0 = clip.vectors.data() + size_t(f0) * 3 * stride + ch.index;
+        const uint16_t* v1 = clip.vectors.data() + size_t(f1) * 3 * stride + ch.index;
+        glm::vec3 out;
+        for (uint32_t c = 0; c < 3; ++c) {
+            const float a = float(v0[c * stride]), b = float(v1[c * stride]);
+            out[c] = clip.vectorMin[c * stride + ch.index] + clip.vectorScale[c * stride + ch.index] * (a + (b - a) * alpha);
+        }
+        return out;
+    };
+    T = vector(track.translation, glm::vec3(0.0f));
+    S = vector(track.scale, glm::vec3(1.0f));
+    if (track.rotation.kind == Kind::Constant) R = clip.constRotations[track.rotation.index];
+    else if (track.rotation.kind == Kind::Animated && clip.frameCount > 0) {
+        const uint32_t stride = clip.rotationStride;
+        const uint16_t* r0 = clip.rotations.data() + size_t(f0) * 3 * stride + track.rotation.index;
+        const uint16_t* r1 = clip.rotations.data() + size_t(f1) * 3 * stride + track.rotation.index;
+        const glm::quat q0 = DecodeQuat(r0[0], r0[stride], r0[2 * stride]);
+        const glm::quat q1 = DecodeQuat(r1[0], r1[stride], r1[2 * stride]);
+        const float s = (q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w) < 0.0f ? -1.0f : 1.0f;
+        R = glm::normalize(glm::quat(q0.w + (q1.w * s - q0.w) * alpha, q0.x + (q1.x * s - q0.x) * alpha,
+                                     q0.y + (q1.y * s - q0.y) * alpha, q0.z + (q1.z * s - q0.z) * alpha));
+    }
+    else R = glm::quat(1, 0, 0, 0);
+}
+
+const char* CompressedKernelName() {
+#if defined(CLAYMORE_ANIM_SSE)
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace animation
+} // namespace cm
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace cm {
+namespace animation {
+
+struct AnimationAsset;
+
+// -----------------------------------------------------------------------------
+// Runtime ("cooked") form of an asset's bone tracks. The authoring curves keep
+// 32-byte keys (id, time, value) and are searched and slerped one channel at a
+// time; a cooked clip resamples every channel at a uniform rate so one time value
+// addresses the same two frames for all bones, and decodes a whole skeleton with
+// 4-wide SIMD.
+//
+//   rotations     smallest-three: the largest component is dropped (and made
+//                 positive), the other three are stored as 15 bits each in
+//                 [-1/sqrt(2), 1/sqrt(2)]; its index goes in the spare top bits.
+//                 6 bytes per key.
+//   translations  range-quantized: 16 bits per component over the channel's
+//   and scales    [min, max] box. 6 bytes per key.
+//   constants     channels that never change are stored once at full precision
+//                 and cost nothing per frame.
+//
+// Frame data is frame-major and SoA within a frame (all first components, then
+// all second, ...), padded to the SIMD width, so the kernel reads two contiguous
+// blocks per sample. Sampling is lerp/nlerp between adjacent frames.
+//
+// Built by AnimationAssetCache for the shared runtime copy of an asset; the
+// editor keeps sampling the curves of its own copies.
+// -----------------------------------------------------------------------------
+struct CompressedClip {
+    enum class ChannelKind : uint8_t { Default, Constant, Animated };
+    struct Channel {
+        ChannelKind kind = ChannelKind::Default; // Default: the track has no keys (0 / identity / 1)
+        uint32_t index = 0;                      // into the constants or the animated channels
+    };
+    struct Track {
+        uint32_t assetTrack = 0;                 // index into AnimationAsset::tracks
+        int boneId = -1;                         // the track's boneId; -1: resolved by name
+        Channel translation, rotation, scale;
+    };
+
+    float duration = 0.0f;
+    float frameStep = 0.0f;                      // seconds between frames; 0 with a single frame
+    uint32_t frameCount = 0;
+    std::vector<Track> tracks;                   // unmuted bone tracks, in asset order
+    bool retargeted = false;                     // the asset also has avatar tracks
+
+    std::vector<glm::quat> constRotations;
+    std::vector<glm::vec3> constVectors;
+
+    uint32_t rotationCount = 0;                  // animated rotation channels
+    uint32_t rotationStride = 0;                 // rotationCount rounded up to the SIMD width
+    std::vector<uint16_t> rotations;             // frameCount * 3 * rotationStride
+
+    uint32_t vectorCount = 0;                    // animated translation and scale channels
+    uint32_t vectorStride = 0;
+    std::vector<float> vectorMin;                // 3 * vectorStride: x mins, y mins, z mins
+    std::vector<float> vectorScale;              // (max - min) / 65535, same layout
+    std::vector<uint16_t> vectors;               // frameCount * 3 * vectorStride
+
+    // Heap bytes of the cooked data
+    size_t ByteSize() const;
+};
+
+struct CompressedCookOptions {
+    float sampleRate = 0.0f;                     // frames per second; 0: the asset's fps (30 if unset)
+    float constantTolerance = 1e-5f;             // max deviation for a channel to be stored once
+};
+
+// SoA result of one sample of every animated channel
+struct CompressedSample {
+    std::vector<float> rx, ry, rz, rw;           // rotationStride each
+    std::vector<float> vx, vy, vz;               // vectorStride each
+};
+
+// Cooks the unmuted bone tracks of 'asset'. Null if it has none.
+std::unique_ptr<CompressedClip> CookCompressedClip(const AnimationAsset& asset, const CompressedCookOptions& options = {});
+
+// Bytes of key data the cooked form replaces (the bone tracks' curves)
+size_t BoneCurveBytes(const AnimationAsset& asset);
+
+// Decodes every animated channel at time t (clamped to the clip)
+void SampleCompressed(const CompressedClip& clip, float t, CompressedSample& out);
+
+// TRS of one track from the last SampleCompressed into 'sample'
+void CompressedTrackTRS(const CompressedClip& clip, const CompressedSample& sample, const CompressedClip::Track& track,
+                        glm::vec3& T, glm::quat& R, glm::vec3& S);
+
+// TRS of one track at time t, decoding only that track's channels (a few bones,
+// e.g. the root motion chain, without the whole-skeleton decode)
+void SampleCompressedTrack(const CompressedClip& clip, const CompressedClip::Track& track, float t,
+                           glm::vec3& T, glm::quat& R, glm::vec3& S);
+
+// "sse" or "scalar": the kernel SampleCompressed was built with
+const char* CompressedKernelName();
+
+} // namespace animation
+} // namespace cm
@@ -36,12 +36,12 @@ template <typename T>
 static T lerp(const T& a, const T& b, float t) { return a * (1.0f - t) + b * t; }
 }
 
-float CurveFloat::Sample(float t, bool loop, float length) const
+float CurveFloat::Sample(float t, bool loop, float length, int* cursor) const
 {
     if (keys.empty()) return 0.0f;
     if (keys.size() == 1) return keys[0].v;
-    int seg = findSegment(keys, t, cache.last, loop, length);
-    cache.last = seg;
+    const int seg = findSegment(keys, t, cursor ? *cursor : 0, loop, length);
+    if (cursor) *cursor = seg;
     const auto& k0 = keys[seg];
     const auto& k1 = keys[seg + 1];
     const float dt = (k1.t - k0.t);
@@ -50,12 +50,12 @@ float CurveFloat::Sample(float t, bool loop, float length) const
     return k0.v * (1.0f - a) + k1.v * a;
 }
 
-glm::vec2 CurveVec2::Sample(float t, bool loop, float length) const
+glm::vec2 CurveVec2::Sample(float t, bool loop, float length, int* cursor) const
 {
     if (keys.empty()) return glm::vec2(0.0f);
     if (keys.size() == 1) return keys[0].v;
-    int seg = findSegment(keys, t, cache.last, loop, length);
-    cache.last = seg;
+    const int seg = findSegment(keys, t, cursor ? *cursor : 0, loop, length);
+    if (cursor) *cursor = seg;
     const auto& k0 = keys[seg];
     const auto& k1 = keys[seg + 1];
     const float dt = (k1.t - k0.t);
@@ -64,12 +64,12 @@ glm::vec2 CurveVec2::Sample(float t, bool loop, float length) const
     return lerp(k0.v, k1.v, a);
 }
 
-glm::vec3 CurveVec3::Sample(float t, bool loop, float length) const
+glm::vec3 CurveVec3::Sample(float t, bool loop, float length, int* cursor) const
 {
     if (keys.empty()) return glm::vec3(0.0f);
     if (keys.size() == 1) return keys[0].v;
-    int seg = findSegment(keys, t, cache.last, loop, length);
-    cache.last = seg;
+    const int seg = findSegment(keys, t, cursor ? *cursor : 0, loop, length);
+    if (cursor) *cursor = seg;
     const auto& k0 = keys[seg];
     const auto& k1 = keys[seg + 1];
     const float dt = (k1.t - k0.t);
@@ -78,12 +78,12 @@ glm::vec3 CurveVec3::Sample(float t, bool loop, float length) const
     return lerp(k0.v, k1.v, a);
 }
 
-glm::quat CurveQuat::Sample(float t, bool loop, float length) const
+glm::quat CurveQuat::Sample(float t, bool loop, float length, int* cursor) const
 {
     if (keys.empty()) return glm::quat(1,0,0,0);
     if (keys.size() == 1) return keys[0].v;
-    int seg = findSegment(keys, t, cache.last, loop, length);
-    cache.last = seg;
+    const int seg = findSegment(keys, t, cursor ? *cursor : 0, loop, length);
+    if (cursor) *cursor = seg;
     const auto& k0 = keys[seg];
     const auto& k1 = keys[seg + 1];
     const float dt = (k1.t - k0.t);
@@ -92,12 +92,12 @@ glm::quat CurveQuat::Sample(float t, bool loop, float length) const
     return glm::slerp(k0.v, k1.v, a);
 }
 
-glm::vec4 CurveColor::Sample(float t, bool loop, float length) const
+glm::vec4 CurveColor::Sample(float t, bool loop, float length, int* cursor) const
 {
     if (keys.empty()) return glm::vec4(1.0f);
     if (keys.size() == 1) return keys[0].v;
-    int seg = findSegment(keys, t, cache.last, loop, length);
-    cache.last = seg;
+    const int seg = findSegment(keys, t, cursor ? *cursor : 0, loop, length);
+    if (cursor) *cursor = seg;
     const auto& k0 = keys[seg];
     const auto& k1 = keys[seg + 1];
     const float dt = (k1.t - k0.t);
@@ -7,6 +7,11 @@
 
 // Minimal curve utilities for animation sampling. Linear by default; can be
 // extended with Hermite in future.
+//
+// Curves hold no sampling state: loaded assets are shared between players and
+// sampled from several workers at once. A caller that samples the same curve
+// frame after frame passes its own segment cursor so the search starts where the
+// previous sample ended; without one it is a binary search.
 
 namespace cm {
 namespace animation {
@@ -19,33 +24,29 @@ struct KeyVec3  { KeyID id = 0; float t = 0.0f; glm::vec3 v{0.0f}; };
 struct KeyQuat  { KeyID id = 0; float t = 0.0f; glm::quat v{1,0,0,0}; };
 struct KeyColor { KeyID id = 0; float t = 0.0f; glm::vec4 v{1.0f}; };
 
-// Simple segment cache for monotonic key times
-struct SegmentCache { mutable int last = 0; };
-
 struct CurveFloat {
     std::vector<KeyFloat> keys;
-    mutable SegmentCache cache;
-    float Sample(float t, bool loop = false, float length = 0.0f) const;
+    float Sample(float t, bool loop = false, float length = 0.0f, int* cursor = nullptr) const;
 };
 
 struct CurveVec2 {
-    std::vector<KeyVec2> keys; mutable SegmentCache cache;
-    glm::vec2 Sample(float t, bool loop = false, float length = 0.0f) const;
+    std::vector<KeyVec2> keys;
+    glm::vec2 Sample(float t, bool loop = false, float length = 0.0f, int* cursor = nullptr) const;
 };
 
 struct CurveVec3 {
-    std::vector<KeyVec3> keys; mutable SegmentCache cache;
-    glm::vec3 Sample(float t, bool loop = false, float length = 0.0f) const;
+    std::vector<KeyVec3> keys;
+    glm::vec3 Sample(float t, bool loop = false, float length = 0.0f, int* cursor = nullptr) const;
 };
 
 struct CurveQuat {
-    std::vector<KeyQuat> keys; mutable SegmentCache cache;
-    glm::quat Sample(float t, bool loop = false, float length = 0.0f) const; // slerp
+    std::vector<KeyQuat> keys;
+    glm::quat Sample(float t, bool loop = false, float length = 0.0f, int* cursor = nullptr) const; // slerp
 };
 
 struct CurveColor {
-    std::vector<KeyColor> keys; mutable SegmentCache cache;
-    glm::vec4 Sample(float t, bool loop = false, float length = 0.0f) const;
+    std::vector<KeyColor> keys;
+    glm::vec4 Sample(float t, bool loop = false, float length = 0.0f, int* cursor = nullptr) const;
 };
 
 } // namespace animation
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace cm {
+namespace animation {
+
+// Pose of one skeleton, indexed like SkeletonComponent::BoneEntities.
+//   local:   parent-relative bone transforms (what the sampler writes)
+//   touched: bones written by the last SampleAsset call
+//   model:   bone transforms relative to the skeleton root entity, filled by ComputeModelPose()
+struct PoseBuffer {
+    std::vector<glm::mat4> local;
+    std::vector<bool> touched;
+    std::vector<glm::mat4> model;
+};
+
+} // namespace animation
+} // namespace cm
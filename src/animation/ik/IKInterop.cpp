@@ -24,14 +24,21 @@ static void IK_SetWeight_Native(EntityID entity, float w)
     if (auto* ik = GetFirstIK(entity)) ik->SetWeight(w);
 }
 
+// Target/pole bones are kept written back by the animation system; tell it when they move
 static void IK_SetTarget_Native(EntityID entity, EntityID target)
 {
-    if (auto* ik = GetFirstIK(entity)) ik->SetTarget(target);
+    auto* ik = GetFirstIK(entity);
+    if (!ik || ik->TargetEntity == target) return;
+    ik->SetTarget(target);
+    Scene::Get().MarkComponentsChanged();
 }
 
 static void IK_SetPole_Native(EntityID entity, EntityID pole)
 {
-    if (auto* ik = GetFirstIK(entity)) ik->SetPole(pole);
+    auto* ik = GetFirstIK(entity);
+    if (!ik || ik->PoleEntity == pole) return;
+    ik->SetPole(pole);
+    Scene::Get().MarkComponentsChanged();
 }
 
 static void IK_SetChain_Native(EntityID entity, const BoneId* ids, int count)
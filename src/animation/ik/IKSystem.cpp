@@ -5,6 +5,8 @@
 #include "ecs/AnimationComponents.h"
 #include "animation/ik/IKSolvers.h"
 #include "animation/ik/IKDebugDraw.h"
+#include "animation/AnimationEvaluator.h"
+#include "animation/AnimationSystem.h"
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtx/quaternion.hpp>
 
@@ -23,6 +25,8 @@ void IKSystem::SolveAndBlend(Scene& scene, float /*deltaTime*/) {
     for (const auto& ent : scene.GetEntities()) {
         auto* data = scene.GetEntityData(ent.GetID());
         if (!data || !data->Skeleton) continue;
+        // Small on screen (animation LOD): the pose is throttled or held, chains are not solved
+        if (data->Skeleton->PoseValid && !IKAtLOD(data->Skeleton->LOD.Level)) continue;
 
         // Discover IK components stored in Extra under "ik" array; also support future native storage
         std::vector<IKComponent>* ikListPtr = nullptr;
@@ -66,9 +70,12 @@ void IKSystem::SolveAndBlend(Scene& scene, float /*deltaTime*/) {
         auto& skeleton = *data->Skeleton;
         const size_t boneCount = skeleton.BoneEntities.size();
 
-        // Build current local transforms buffer from bone entity TRS
+        // Build current local transforms buffer: the animation pose when one was evaluated
+        // this frame, else bone entity TRS
+        const bool fromPose = skeleton.PoseValid && skeleton.Pose.local.size() == boneCount;
         std::vector<glm::mat4> local(boneCount, glm::mat4(1.0f));
-        for (size_t i=0;i<boneCount;++i) {
+        if (fromPose) local = skeleton.Pose.local;
+        else for (size_t i=0;i<boneCount;++i) {
             EntityID be = skeleton.BoneEntities[i];
             if (auto* bd = scene.GetEntityData(be)) {
                 glm::mat4 T = glm::translate(glm::mat4(1.0f), bd->Transform.Position);
@@ -155,6 +162,14 @@ void IKSystem::SolveAndBlend(Scene& scene, float /*deltaTime*/) {
             }
         }
 
+        if (fromPose) {
+            // Skinning reads the pose; bone entities only need the observed bones
+            skeleton.Pose.local = std::move(local);
+            ComputeModelPose(skeleton.Pose, skeleton.BoneParents);
+            AnimationSystem::WriteBoneEntities(scene, skeleton);
+            continue;
+        }
+
         // Write back locals to bone entities
         for (size_t i=0;i<boneCount;++i) {
             EntityID be = skeleton.BoneEntities[i]; if (be == (EntityID)-1) continue;
@@ -165,7 +180,7 @@ void IKSystem::SolveAndBlend(Scene& scene, float /*deltaTime*/) {
                 bd->Transform.RotationQ = glm::normalize(R);
                 bd->Transform.UseQuatRotation = true;
                 bd->Transform.Rotation = glm::degrees(glm::eulerAngles(bd->Transform.RotationQ));
-                bd->Transform.TransformDirty = true;
+                scene.MarkTransformDirty(be);
             }
         }
     }
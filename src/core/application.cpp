@@ -14,6 +14,7 @@
 #include "Application.h"
 #include "rendering/Renderer.h"
 #include "rendering/ShaderManager.h"
+#include "rendering/TextureStreamer.h"
 #include "ui/imgui_backend/imgui_impl_bgfx_docking.h"
 #include "backends/imgui_impl_win32.h"
 #include <imgui.h>
@@ -28,6 +29,7 @@
 #include "platform/win32/Win32Window.h"
 #include "io/FileSystem.h"
 #include "serialization/Serializer.h"
+#include "serialization/SceneLoader.h"
 #include "pipeline/AssetPipeline.h"
 #include "pipeline/AssetLibrary.h"
 #include "utils/Profiler.h"
@@ -161,6 +163,7 @@ Application::Application(int width, int height, const std::string& title)
     unsigned hw = std::thread::hardware_concurrency();
     size_t workers = (hw > 2) ? (hw - 1) : 1;
     m_Jobs = std::make_unique<JobSystem>(workers);
+    FileSystem::Instance().SetJobSystem(m_Jobs.get());
 
     // Init Dotnet
     std::filesystem::path fullPath = std::filesystem::current_path() / "ClaymoreEngine.dll";
@@ -201,6 +204,9 @@ Application::Application(int width, int height, const std::string& title)
                         }
                     }
                 }
+                if (j.contains("physics") && j["physics"].is_object()) {
+                    Physics::SetFixedTimestep(j["physics"].value("fixedHz", 60.0f), j["physics"].value("maxSubsteps", 4));
+                }
                 std::string entry = j.value("entryScene", "");
                 if (!entry.empty()) {
                     Serializer::LoadSceneFromFile(entry, *Scene::CurrentScene);
@@ -218,6 +224,7 @@ Application::Application(int width, int height, const std::string& title)
             m_RuntimeScene = m_GameScene->RuntimeClone();
             if (m_RuntimeScene) {
                 m_RuntimeScene->m_IsPlaying = true;
+                Physics::ResetFixedStep();
                 Scene::CurrentScene = m_RuntimeScene.get();
                 // Debug: report entering play mode and script counts
                 size_t scriptCount = 0;
@@ -394,6 +401,10 @@ void Application::Run() {
         // 2. CPU pre-processing (decoding textures/models)
         // 3. GPU uploads (executed on main thread for safety)
         m_AssetPipeline->ProcessMainThreadTasks();
+        // Commits staged scene loads within their per-frame budget
+        SceneLoader::Instance().Update();
+        // Uploads finished texture loads and schedules mip upgrades/evictions
+        TextureStreamer::Instance().Update();
 
         // --------------------------------------
         // START NEW IMGUI FRAME (editor mode only)
@@ -583,6 +594,7 @@ void Application::Shutdown() {
         m_AssetWatcher->Stop();
     }
 
+    FileSystem::Instance().SetJobSystem(nullptr);
     m_Jobs.reset();
 
     if (m_RunEditorUI) {
@@ -615,6 +627,7 @@ void Application::StartPlayMode() {
     editorScene.m_RuntimeScene = editorScene.RuntimeClone();
     if (editorScene.m_RuntimeScene) {
         editorScene.m_RuntimeScene->m_IsPlaying = true;
+        Physics::ResetFixedStep();
         Scene::CurrentScene = editorScene.m_RuntimeScene.get();
         m_IsPlaying = true;
     }
@@ -1,24 +1,51 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <glm/glm.hpp>
 #include <unordered_map>
 #include <memory>
+#include "animation/AnimationLOD.h"
 #include "animation/AvatarDefinition.h"
+#include "animation/PoseBuffer.h"
 #include "ecs/Entity.h" // assumes EntityID typedef lives there; adjust path if different
 #include "pipeline/AssetReference.h" // for ClaymoreGUID
 
 // ------------ Blend Shapes ------------
 struct BlendShape {
     std::string Name;
-    std::vector<glm::vec3> DeltaPos;
+    std::vector<glm::vec3> DeltaPos;      // one per mesh vertex as imported; released once sparse
+                                          // (kept when the count does not match the mesh)
     std::vector<glm::vec3> DeltaNormal;
     float Weight = 0.0f;
+
+    // Sparse form used at runtime (BuildSparseBlendShapes): the vertices the shape moves, ascending
+    std::vector<uint32_t> Indices;
+    std::vector<glm::vec3> SparsePos;
+    std::vector<glm::vec3> SparseNormal;
 };
 
 struct BlendShapeComponent {
     std::vector<BlendShape> Shapes;
     bool Dirty = false;
+
+    // SkinningSystem runtime state (see ecs/BlendShapeBlender.h)
+    uint32_t SparseVertexCount = 0;       // mesh vertex count the sparse deltas were built for; 0: not yet
+    std::vector<float> AppliedWeights;    // weights the uploaded vertices were blended with
+    std::vector<uint8_t> Vertices;        // CPU copy of the dynamic vertex buffer, GPU layout
+    uint32_t VertexStride = 0;
+
+    // Identifies these vertices in Mesh::BlendShapeSerial. Never reused, and a copy
+    // (e.g. the play-mode clone of the entity) draws a new one.
+    struct Serial {
+        uint64_t Value = Next();
+        Serial() = default;
+        Serial(const Serial&) : Value(Next()) {}
+        Serial& operator=(const Serial&) { Value = Next(); return *this; }
+        static uint64_t Next() { static std::atomic<uint64_t> s_Next{ 1 }; return s_Next++; }
+    };
+    Serial VertexSerial;
 };
 
 // ------------ Unified Morphs (per-model grouped blendshapes) ------------
@@ -61,9 +88,35 @@ struct SkeletonComponent {
     // Optional humanoid avatar built for this skeleton
     std::unique_ptr<cm::animation::AvatarDefinition> Avatar;
 
+    // Runtime pose from AnimationSystem (local, then model space relative to the
+    // skeleton root entity). PoseValid is true only for skeletons AnimationSystem
+    // updated this frame (evaluated, interpolated or held by LOD); SkinningSystem and
+    // IK then use the pose instead of the bone entities.
+    cm::animation::PoseBuffer Pose;
+    bool PoseValid = false;
+    std::vector<glm::mat4> BindLocals; // parent-relative bind pose, derived on first evaluation
+
+    // Bone entity write-back. Only bones something reads (attachments, components or
+    // scripts on the bone, IK targets) and their ancestors get their TRS written each
+    // frame, unless WriteBackAllBones is set (e.g. to inspect bones in play mode).
+    bool WriteBackAllBones = false;
+    std::vector<uint8_t> ObservedBones;    // per bone, rebuilt when the hierarchy or components change
+    uint32_t ObservedVersion = UINT32_MAX; // hierarchy version ObservedBones was built for
+    uint32_t ObservedComponentVersion = UINT32_MAX; // Scene::GetComponentVersion at that time
+
+    // Animation LOD: update rate and sampled bones from the projected size (AnimationSystem)
+    cm::animation::AnimationLODState LOD;
 };
 
 struct SkinningComponent {
     EntityID SkeletonRoot = -1;
     std::vector<glm::mat4> Palette;           // current frame palette
+
+    // CPU skinning (ecs/CpuSkinning.h) for animated bounds, picking and hitbox queries
+    bool CpuSkinning = false;                 // also on for every mesh with SkinningSystem::CpuSkinningForAll()
+    bool SkinnedValid = false;                // the buffers below hold the mesh skinned with Palette
+    std::vector<glm::vec3> SkinnedPositions;  // mesh-local, one per mesh vertex
+    std::vector<glm::vec3> SkinnedNormals;
+    glm::vec3 SkinnedBoundsMin{0.0f};
+    glm::vec3 SkinnedBoundsMax{0.0f};
 };
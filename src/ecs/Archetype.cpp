@@ -0,0 +1,102 @@
+#include "Archetype.h"
+
+ComponentMask ComputeComponentMask(const EntityData& d) {
+   ComponentMask m = 0;
+   if (d.Mesh)            m |= ComponentTraits<MeshComponent>::Mask;
+   if (d.Light)           m |= ComponentTraits<LightComponent>::Mask;
+   if (d.BlendShapes)     m |= ComponentTraits<BlendShapeComponent>::Mask;
+   if (d.UnifiedMorph)    m |= ComponentTraits<UnifiedMorphComponent>::Mask;
+   if (d.Skeleton)        m |= ComponentTraits<SkeletonComponent>::Mask;
+   if (d.Skinning)        m |= ComponentTraits<SkinningComponent>::Mask;
+   if (d.Collider)        m |= ComponentTraits<ColliderComponent>::Mask;
+   if (d.Camera)          m |= ComponentTraits<CameraComponent>::Mask;
+   if (d.RigidBody)       m |= ComponentTraits<RigidBodyComponent>::Mask;
+   if (d.StaticBody)      m |= ComponentTraits<StaticBodyComponent>::Mask;
+   if (d.Terrain)         m |= ComponentTraits<TerrainComponent>::Mask;
+   if (d.Emitter)         m |= ComponentTraits<ParticleEmitterComponent>::Mask;
+   if (d.Navigation)      m |= ComponentTraits<nav::NavMeshComponent>::Mask;
+   if (d.NavAgent)        m |= ComponentTraits<nav::NavAgentComponent>::Mask;
+   if (d.Text)            m |= ComponentTraits<TextRendererComponent>::Mask;
+   if (d.Canvas)          m |= ComponentTraits<CanvasComponent>::Mask;
+   if (d.Panel)           m |= ComponentTraits<PanelComponent>::Mask;
+   if (d.Button)          m |= ComponentTraits<ButtonComponent>::Mask;
+   if (d.AnimationPlayer) m |= ComponentTraits<cm::animation::AnimationPlayerComponent>::Mask;
+   return m;
+   }
+
+void ArchetypeStorage::Insert(EntityID id, EntityData* data) {
+   Remove(id);
+   Append(0, id, data);
+   ++m_Version;
+   m_Stale = true;
+   }
+
+void ArchetypeStorage::Remove(EntityID id) {
+   if (id >= m_Location.size()) return;
+   Location& loc = m_Location[id];
+   if (loc.Archetype == UINT32_MAX) return;
+   m_Archetypes[loc.Archetype].Rows[loc.Row] = nullptr;
+   loc.Archetype = UINT32_MAX;
+   ++m_Version;
+   m_Stale = true;
+   }
+
+void ArchetypeStorage::Clear() {
+   m_Archetypes.clear();
+   m_Lookup.clear();
+   m_Location.clear();
+   m_Archetypes.push_back(Archetype{});
+   m_Lookup.emplace(0u, 0u);
+   ++m_Version;
+   m_Stale = true;
+   }
+
+uint32_t ArchetypeStorage::FindOrCreate(ComponentMask mask) {
+   auto it = m_Lookup.find(mask);
+   if (it != m_Lookup.end()) return it->second;
+   const uint32_t index = (uint32_t)m_Archetypes.size();
+   Archetype a;
+   a.Mask = mask;
+   m_Archetypes.push_back(std::move(a));
+   m_Lookup.emplace(mask, index);
+   return index;
+   }
+
+void ArchetypeStorage::Append(uint32_t archetype, EntityID id, EntityData* data) {
+   Archetype& a = m_Archetypes[archetype];
+   if (id >= m_Location.size()) m_Location.resize((size_t)id + 1);
+   m_Location[id] = { archetype, (uint32_t)a.Rows.size() };
+   a.Ids.push_back(id);
+   a.Rows.push_back(data);
+   }
+
+void ArchetypeStorage::SwapRemove(uint32_t archetype, uint32_t row) {
+   Archetype& a = m_Archetypes[archetype];
+   const uint32_t last = (uint32_t)a.Rows.size() - 1;
+   if (row != last) {
+      a.Ids[row] = a.Ids[last];
+      a.Rows[row] = a.Rows[last];
+      if (a.Rows[row]) m_Location[a.Ids[row]].Row = row;
+      }
+   a.Ids.pop_back();
+   a.Rows.pop_back();
+   }
+
+void ArchetypeStorage::Refresh() {
+   m_Stale = false;
+   // Moves only append to other archetypes, so a row index stays valid until it is processed;
+   // a row filled by SwapRemove is looked at again before advancing.
+   for (uint32_t a = 0; a < (uint32_t)m_Archetypes.size(); ++a) {
+      uint32_t row = 0;
+      while (row < (uint32_t)m_Archetypes[a].Rows.size()) {
+         EntityData* d = m_Archetypes[a].Rows[row];
+         if (!d) { SwapRemove(a, row); continue; }
+         const ComponentMask mask = ComputeComponentMask(*d);
+         if (mask == m_Archetypes[a].Mask) { ++row; continue; }
+         const EntityID id = m_Archetypes[a].Ids[row];
+         SwapRemove(a, row);
+         Append(FindOrCreate(mask), id, d);
+         ++m_Version;
+         }
+      }
+   }
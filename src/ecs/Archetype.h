@@ -0,0 +1,228 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <tuple>
+#include "Entity.h"
+#include "EntityData.h"
+#include "jobs/JobSystem.h"
+#include "jobs/ParallelFor.h"
+
+// -----------------------------------------------------------------------------
+// Archetype index over EntityData.
+//
+// Entities that carry the same set of optional components share an archetype.
+// Each archetype is a pair of dense arrays (ids, EntityData*). A query visits
+// only the archetypes whose component set covers it and walks their rows in
+// order; nothing goes through the entity hash map and no row is tested for a
+// component it cannot have.
+//
+// Components are still owned by EntityData (std::unique_ptr members), which
+// stays the facade the editor, serializer and scripts use. Because those write
+// the members directly, the index cannot see an add/remove when it happens.
+// Scene marks it stale at the start of every Update and on CreateEntity; the
+// next query re-buckets the entities whose component set changed. Queries
+// re-read the component pointers per row, so a component removed in between is
+// skipped rather than dereferenced. Call Scene::InvalidateArchetypes() after
+// adding a component if a query later in the same frame must see it, and after
+// every structural edit of a scene that is not updated (the prefab editor's);
+// the inspector does so whenever it changes an entity's component set.
+// Version() lets systems cache results derived from component sets; changes
+// the mask does not cover (scripts, IK targets) go through MarkChanged().
+// -----------------------------------------------------------------------------
+
+using ComponentMask = uint32_t;
+
+// Type -> bit and accessor. Mask 0 means "always present" (Transform, the EntityData itself).
+template<class T> struct ComponentTraits;
+
+#define CLAYMORE_COMPONENT_TRAITS(Type, Member, Bit)                                  \
+   template<> struct ComponentTraits<Type> {                                         \
+      static constexpr ComponentMask Mask = 1u << (Bit);                              \
+      static Type* Get(EntityData& d) { return d.Member.get(); }                      \
+      };
+
+CLAYMORE_COMPONENT_TRAITS(MeshComponent, Mesh, 0)
+CLAYMORE_COMPONENT_TRAITS(LightComponent, Light, 1)
+CLAYMORE_COMPONENT_TRAITS(BlendShapeComponent, BlendShapes, 2)
+CLAYMORE_COMPONENT_TRAITS(UnifiedMorphComponent, UnifiedMorph, 3)
+CLAYMORE_COMPONENT_TRAITS(SkeletonComponent, Skeleton, 4)
+CLAYMORE_COMPONENT_TRAITS(SkinningComponent, Skinning, 5)
+CLAYMORE_COMPONENT_TRAITS(ColliderComponent, Collider, 6)
+CLAYMORE_COMPONENT_TRAITS(CameraComponent, Camera, 7)
+CLAYMORE_COMPONENT_TRAITS(RigidBodyComponent, RigidBody, 8)
+CLAYMORE_COMPONENT_TRAITS(StaticBodyComponent, StaticBody, 9)
+CLAYMORE_COMPONENT_TRAITS(TerrainComponent, Terrain, 10)
+CLAYMORE_COMPONENT_TRAITS(ParticleEmitterComponent, Emitter, 11)
+CLAYMORE_COMPONENT_TRAITS(nav::NavMeshComponent, Navigation, 12)
+CLAYMORE_COMPONENT_TRAITS(nav::NavAgentComponent, NavAgent, 13)
+CLAYMORE_COMPONENT_TRAITS(TextRendererComponent, Text, 14)
+CLAYMORE_COMPONENT_TRAITS(CanvasComponent, Canvas, 15)
+CLAYMORE_COMPONENT_TRAITS(PanelComponent, Panel, 16)
+CLAYMORE_COMPONENT_TRAITS(ButtonComponent, Button, 17)
+CLAYMORE_COMPONENT_TRAITS(cm::animation::AnimationPlayerComponent, AnimationPlayer, 18)
+
+#undef CLAYMORE_COMPONENT_TRAITS
+
+template<> struct ComponentTraits<TransformComponent> {
+   static constexpr ComponentMask Mask = 0;
+   static TransformComponent* Get(EntityData& d) { return &d.Transform; }
+   };
+
+template<> struct ComponentTraits<EntityData> {
+   static constexpr ComponentMask Mask = 0;
+   static EntityData* Get(EntityData& d) { return &d; }
+   };
+
+// Component set of 'd' as currently stored in its unique_ptr members.
+ComponentMask ComputeComponentMask(const EntityData& d);
+
+struct Archetype {
+   ComponentMask Mask = 0;
+   std::vector<EntityID> Ids;
+   std::vector<EntityData*> Rows; // nullptr = removed since the last refresh
+   };
+
+class ArchetypeStorage {
+public:
+   ArchetypeStorage() { m_Archetypes.push_back(Archetype{}); m_Lookup.emplace(0u, 0u); }
+
+   // New entities start in the empty archetype until the next refresh.
+   void Insert(EntityID id, EntityData* data);
+   // O(1); leaves a hole so a query in progress is not disturbed.
+   void Remove(EntityID id);
+   void Clear();
+
+   void MarkStale() { m_Stale = true; }
+   // For changes the mask cannot see (scripts, IK targets): bumps Version() and marks stale.
+   void MarkChanged() { ++m_Version; m_Stale = true; }
+   // Bumped on insert/remove, when a refresh re-buckets an entity, and by MarkChanged.
+   uint32_t Version() const { return m_Version; }
+   // True when a refresh is due and no view is iterating.
+   bool NeedsRefresh() const { return m_Stale && m_ActiveQueries == 0; }
+   // Re-bucket every entity whose component set changed and drop holes.
+   void Refresh();
+
+   // Live SceneViews; re-bucketing is deferred while any exist.
+   void BeginQuery() const { ++m_ActiveQueries; }
+   void EndQuery() const { --m_ActiveQueries; }
+
+   const std::vector<Archetype>& Archetypes() const { return m_Archetypes; }
+
+private:
+   struct Location { uint32_t Archetype = UINT32_MAX; uint32_t Row = 0; };
+
+   uint32_t FindOrCreate(ComponentMask mask);
+   void Append(uint32_t archetype, EntityID id, EntityData* data);
+   void SwapRemove(uint32_t archetype, uint32_t row);
+
+   std::vector<Archetype> m_Archetypes;          // [0] = no optional components
+   std::unordered_map<ComponentMask, uint32_t> m_Lookup;
+   std::vector<Location> m_Location;             // per EntityID
+   bool m_Stale = true;
+   uint32_t m_Version = 0;
+   mutable int m_ActiveQueries = 0;              // main thread only
+   };
+
+// Typed query over every entity that has all of Ts. Obtain through Scene::View<Ts...>().
+//
+//   for (auto [id, xf, mesh] : scene.View<TransformComponent, MeshComponent>()) { ... }
+//
+// While a view is alive the index is not re-bucketed, so rows never move under the walk.
+// Entities created during it may or may not be visited; removed ones are skipped.
+template<class... Ts>
+class SceneView {
+public:
+   static constexpr ComponentMask kMask = (ComponentMask{ 0 } | ... | ComponentTraits<Ts>::Mask);
+   using Row = std::tuple<EntityID, Ts&...>;
+
+   explicit SceneView(const ArchetypeStorage& storage) : m_Storage(&storage) {
+      m_Storage->BeginQuery();
+      const auto& archetypes = storage.Archetypes();
+      for (uint32_t a = 0; a < archetypes.size(); ++a)
+         if ((archetypes[a].Mask & kMask) == kMask) m_Matches.push_back(a);
+      }
+   ~SceneView() { m_Storage->EndQuery(); }
+
+   SceneView(const SceneView&) = delete;
+   SceneView& operator=(const SceneView&) = delete;
+
+   class Iterator {
+   public:
+      Iterator(const SceneView* view, size_t match) : m_View(view), m_Match(match) { Settle(); }
+
+      Row operator*() const {
+         const Archetype& a = m_View->Matched(m_Match);
+         return Row(a.Ids[m_Row], *ComponentTraits<Ts>::Get(*a.Rows[m_Row])...);
+         }
+      Iterator& operator++() { ++m_Row; Settle(); return *this; }
+      bool operator!=(const Iterator& o) const { return m_Match != o.m_Match || m_Row != o.m_Row; }
+
+   private:
+      // Advance to the next row that is live and still has every component.
+      void Settle() {
+         while (m_Match < m_View->m_Matches.size()) {
+            const Archetype& a = m_View->Matched(m_Match);
+            if (m_Row >= a.Rows.size()) { ++m_Match; m_Row = 0; continue; }
+            if (Accepts(a.Rows[m_Row])) return;
+            ++m_Row;
+            }
+         }
+
+      const SceneView* m_View;
+      size_t m_Match;
+      size_t m_Row = 0;
+      };
+
+   Iterator begin() const { return Iterator(this, 0); }
+   Iterator end() const { return Iterator(this, m_Matches.size()); }
+
+   // fn(EntityID, Ts&...)
+   template<class Fn>
+   void ForEach(Fn&& fn) const {
+      for (Row row : *this) std::apply(fn, row);
+      }
+
+   // Splits the matching rows into chunks of 'chunk' entities across the job system. The
+   // scene's structure (entities and components) must not change until this returns.
+   template<class Fn>
+   void ParallelForEach(JobSystem& js, Fn&& fn, size_t chunk = 256) const {
+      if (chunk == 0) chunk = 1;
+      struct Range { size_t Match, Begin, End; };
+      std::vector<Range> ranges;
+      for (size_t m = 0; m < m_Matches.size(); ++m) {
+         const size_t rows = Matched(m).Rows.size();
+         for (size_t b = 0; b < rows; b += chunk) ranges.push_back({ m, b, std::min(b + chunk, rows) });
+         }
+      parallel_for(js, size_t{ 0 }, ranges.size(), size_t{ 1 }, [&](size_t s, size_t c) {
+         for (size_t r = s; r < s + c; ++r) {
+            const Archetype& a = Matched(ranges[r].Match);
+            for (size_t i = ranges[r].Begin; i < ranges[r].End; ++i) {
+               EntityData* d = a.Rows[i];
+               if (!Accepts(d)) continue;
+               fn(a.Ids[i], *ComponentTraits<Ts>::Get(*d)...);
+               }
+            }
+         });
+      }
+
+   bool Any() const { return begin() != end(); }
+
+   // Upper bound: rows removed since the last refresh are still counted.
+   size_t SizeHint() const {
+      size_t n = 0;
+      for (size_t m = 0; m < m_Matches.size(); ++m) n += Matched(m).Rows.size();
+      return n;
+      }
+
+private:
+   const Archetype& Matched(size_t m) const { return m_Storage->Archetypes()[m_Matches[m]]; }
+
+   static bool Accepts(EntityData* d) {
+      return d && ((ComponentTraits<Ts>::Get(*d) != nullptr) && ...);
+      }
+
+   const ArchetypeStorage* m_Storage;
+   std::vector<uint32_t> m_Matches;
+   };
@@ -0,0 +1,107 @@
+#include "BlendShapeBlender.h"
+#include "ecs/AnimationComponents.h"
+#include "jobs/JobSystem.h"
+#include "jobs/ParallelFor.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Vertices per task; a face mesh of ~10k vertices spreads over a handful of workers
+constexpr size_t kVertexChunk = 1024;
+// Deltas at or below this (squared length) do not move the vertex
+constexpr float kMinDelta2 = 1e-14f;
+
+struct ActiveShape {
+   const BlendShape* shape;
+   float weight;
+   };
+
+std::vector<ActiveShape> s_Active;       // main thread only, reused across calls
+
+} // namespace
+
+void BuildSparseBlendShapes(BlendShapeComponent& bs, size_t vertexCount) {
+   for (BlendShape& shape : bs.Shapes) {
+      // Converted for another vertex count: back to dense first, so the deltas survive
+      if (shape.DeltaPos.empty() && !shape.Indices.empty() && shape.Indices.back() < bs.SparseVertexCount) {
+         shape.DeltaPos.assign(bs.SparseVertexCount, glm::vec3(0.0f));
+         shape.DeltaNormal.assign(bs.SparseVertexCount, glm::vec3(0.0f));
+         for (size_t k = 0; k < shape.Indices.size(); ++k) {
+            shape.DeltaPos[shape.Indices[k]] = shape.SparsePos[k];
+            shape.DeltaNormal[shape.Indices[k]] = shape.SparseNormal[k];
+            }
+         }
+      shape.Indices.clear();
+      shape.SparsePos.clear();
+      shape.SparseNormal.clear();
+      // Deltas for another mesh stay dense and unused; the data is not thrown away
+      if (shape.DeltaPos.size() != vertexCount) continue;
+
+      const bool normals = shape.DeltaNormal.size() == vertexCount;
+      for (size_t i = 0; i < vertexCount; ++i) {
+         const glm::vec3 dp = shape.DeltaPos[i];
+         const glm::vec3 dn = normals ? shape.DeltaNormal[i] : glm::vec3(0.0f);
+         if (glm::dot(dp, dp) <= kMinDelta2 && glm::dot(dn, dn) <= kMinDelta2) continue;
+         shape.Indices.push_back((uint32_t)i);
+         shape.SparsePos.push_back(dp);
+         shape.SparseNormal.push_back(dn);
+         }
+      shape.Indices.shrink_to_fit();
+      shape.SparsePos.shrink_to_fit();
+      shape.SparseNormal.shrink_to_fit();
+      std::vector<glm::vec3>().swap(shape.DeltaPos);
+      std::vector<glm::vec3>().swap(shape.DeltaNormal);
+      }
+   bs.SparseVertexCount = (uint32_t)vertexCount;
+   bs.AppliedWeights.clear();
+   }
+
+BlendShapeSpan BlendShapesInto(BlendShapeComponent& bs, const glm::vec3* basePositions, const glm::vec3* baseNormals,
+   size_t vertexCount, bool all, JobSystem& js) {
+   const size_t stride = bs.VertexStride;
+   if (vertexCount == 0 || stride < 6 * sizeof(float) || bs.Vertices.size() < vertexCount * stride) return {};
+
+   // Span covered by shapes whose weight changed; shapes at zero add nothing
+   if (bs.AppliedWeights.size() != bs.Shapes.size()) {
+      bs.AppliedWeights.assign(bs.Shapes.size(), 0.0f);
+      all = true;
+      }
+   size_t lo = all ? 0 : vertexCount, hi = all ? vertexCount : 0;
+   s_Active.clear();
+   for (size_t s = 0; s < bs.Shapes.size(); ++s) {
+      const BlendShape& shape = bs.Shapes[s];
+      if (shape.Indices.empty()) continue;
+      if (shape.Weight != bs.AppliedWeights[s]) {
+         lo = std::min(lo, (size_t)shape.Indices.front());
+         hi = std::max(hi, (size_t)shape.Indices.back() + 1);
+         bs.AppliedWeights[s] = shape.Weight;
+         }
+      if (shape.Weight != 0.0f) s_Active.push_back({ &shape, shape.Weight });
+      }
+   hi = std::min(hi, vertexCount);
+   if (lo >= hi) return {};
+
+   uint8_t* vertices = bs.Vertices.data();
+   parallel_for(js, lo, hi, kVertexChunk, [&](size_t start, size_t count) {
+      const size_t end = start + count;
+      for (size_t v = start; v < end; ++v) {
+         float* out = reinterpret_cast<float*>(vertices + v * stride);
+         out[0] = basePositions[v].x; out[1] = basePositions[v].y; out[2] = basePositions[v].z;
+         out[3] = baseNormals[v].x;   out[4] = baseNormals[v].y;   out[5] = baseNormals[v].z;
+         }
+      for (const ActiveShape& a : s_Active) {
+         const std::vector<uint32_t>& idx = a.shape->Indices;
+         const size_t k0 = size_t(std::lower_bound(idx.begin(), idx.end(), (uint32_t)start) - idx.begin());
+         const glm::vec3* dp = a.shape->SparsePos.data();
+         const glm::vec3* dn = a.shape->SparseNormal.data();
+         const float w = a.weight;
+         for (size_t k = k0; k < idx.size() && idx[k] < end; ++k) {
+            float* out = reinterpret_cast<float*>(vertices + size_t(idx[k]) * stride);
+            out[0] += dp[k].x * w; out[1] += dp[k].y * w; out[2] += dp[k].z * w;
+            out[3] += dn[k].x * w; out[4] += dn[k].y * w; out[5] += dn[k].z * w;
+            }
+         }
+      });
+   return { (uint32_t)lo, (uint32_t)(hi - lo) };
+   }
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct BlendShapeComponent;
+class JobSystem;
+
+// -----------------------------------------------------------------------------
+// Blend shape evaluation for SkinningSystem.
+//
+// Shapes are imported as one delta per mesh vertex; most of them (an ARKit
+// "jawOpen", "eyeBlinkLeft", ...) move a small region of the face. The first
+// evaluation converts every shape to a sparse list of the vertices it moves
+// (ascending indices + deltas) and releases the dense arrays. Shapes whose
+// delta count does not match the mesh keep their dense arrays and are skipped.
+//
+// BlendShapeComponent::Vertices keeps a CPU copy of the mesh's dynamic vertex
+// buffer in its GPU layout. A weight change re-blends only the vertex span the
+// changed shapes cover: every vertex of the span is reset to its base and the
+// shapes at non-zero weight are added in, split into vertex ranges across the
+// job system. The caller uploads that span alone.
+//
+// Vertex layouts must start with float3 position and float3 normal
+// (PBRVertex, SkinnedPBRVertex).
+// -----------------------------------------------------------------------------
+
+struct BlendShapeSpan {
+   uint32_t first = 0;
+   uint32_t count = 0;                     // 0: nothing changed
+   };
+
+// Converts the component's dense deltas for a mesh of 'vertexCount' vertices to the
+// sparse form. Shapes whose delta count does not match the mesh keep their dense
+// deltas (no sparse ones); shapes converted for another count are restored first.
+void BuildSparseBlendShapes(BlendShapeComponent& bs, size_t vertexCount);
+
+// Re-blends bs.Vertices (bs.VertexStride bytes per vertex) where the weights changed
+// since the last call, or everywhere with 'all' (after the copy was rebuilt from the
+// base mesh). Returns the vertex span to upload.
+BlendShapeSpan BlendShapesInto(BlendShapeComponent& bs, const glm::vec3* basePositions, const glm::vec3* baseNormals,
+   size_t vertexCount, bool all, JobSystem& js);
@@ -42,8 +42,19 @@ struct TransformComponent {
 
     glm::mat4 LocalMatrix = glm::mat4(1.0f);  // Local transform
     glm::mat4 WorldMatrix = glm::mat4(1.0f);  // Computed
+    glm::mat4 NormalMatrix = glm::mat4(1.0f); // Cached, see GetNormalMatrix
 
     bool TransformDirty = true;
+    bool NormalMatrixDirty = true;            // Set whenever WorldMatrix is recomputed
+
+    // transpose(inverse(mat3(WorldMatrix))) as a mat4, recomputed once per world matrix change
+    inline const glm::mat4& GetNormalMatrix() {
+        if (NormalMatrixDirty) {
+            NormalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(WorldMatrix))));
+            NormalMatrixDirty = false;
+        }
+        return NormalMatrix;
+    }
 
     inline glm::mat4 CalculateLocalMatrix() {
         const glm::mat4 translation = glm::translate(glm::mat4(1.0f), Position);
@@ -0,0 +1,165 @@
+#include "CpuSkinning.h"
+#include "ecs/AnimationComponents.h"
+#include "rendering/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLAYMORE_SKINNING_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+inline const float* At(const float* base, size_t stride, size_t i) {
+   return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(base) + i * stride);
+   }
+
+#if defined(CLAYMORE_SKINNING_SSE)
+// Columns of one palette matrix (glm::mat4 is column-major, not necessarily 16-byte aligned)
+struct Columns {
+   __m128 c0, c1, c2, c3;
+   };
+
+inline void AddWeighted(Columns& m, const glm::mat4& bone, __m128 w) {
+   const float* p = &bone[0][0];
+   m.c0 = _mm_add_ps(m.c0, _mm_mul_ps(_mm_loadu_ps(p + 0), w));
+   m.c1 = _mm_add_ps(m.c1, _mm_mul_ps(_mm_loadu_ps(p + 4), w));
+   m.c2 = _mm_add_ps(m.c2, _mm_mul_ps(_mm_loadu_ps(p + 8), w));
+   m.c3 = _mm_add_ps(m.c3, _mm_mul_ps(_mm_loadu_ps(p + 12), w));
+   }
+
+inline void Store3(glm::vec3& out, __m128 v) {
+   alignas(16) float f[4];
+   _mm_store_ps(f, v);
+   out = glm::vec3(f[0], f[1], f[2]);
+   }
+
+void SkinRangeSSE(const SkinSource& src, const glm::mat4* palette, size_t boneCount, size_t start, size_t end,
+   glm::vec3* outPos, glm::vec3* outNrm, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+   __m128 lo = _mm_set1_ps(std::numeric_limits<float>::max());
+   __m128 hi = _mm_set1_ps(std::numeric_limits<float>::lowest());
+   for (size_t v = start; v < end; ++v) {
+      const float* p = At(src.positions, src.stride, v);
+      const float* n = At(src.normals, src.stride, v);
+      const glm::ivec4 bi = src.boneIndices[v];
+      const glm::vec4 bw = src.boneWeights[v];
+
+      Columns m{ _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+      float total = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+         if (bw[k] == 0.0f || bi[k] < 0 || (size_t)bi[k] >= boneCount) continue;
+         AddWeighted(m, palette[bi[k]], _mm_set1_ps(bw[k]));
+         total += bw[k];
+         }
+
+      __m128 pos, nrm;
+      if (total == 0.0f) {
+         pos = _mm_setr_ps(p[0], p[1], p[2], 1.0f);
+         nrm = _mm_setr_ps(n[0], n[1], n[2], 0.0f);
+         }
+      else {
+         pos = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m.c0, _mm_set1_ps(p[0])), _mm_mul_ps(m.c1, _mm_set1_ps(p[1]))),
+                          _mm_add_ps(_mm_mul_ps(m.c2, _mm_set1_ps(p[2])), m.c3));
+         nrm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m.c0, _mm_set1_ps(n[0])), _mm_mul_ps(m.c1, _mm_set1_ps(n[1]))),
+                          _mm_mul_ps(m.c2, _mm_set1_ps(n[2])));
+         // Renormalise (palettes may scale); w of nrm is 0, so the 4-lane dot is the 3D one
+         __m128 d = _mm_mul_ps(nrm, nrm);
+         d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+         d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+         const __m128 len = _mm_sqrt_ps(d);
+         nrm = _mm_and_ps(_mm_div_ps(nrm, len), _mm_cmpgt_ps(len, _mm_set1_ps(1e-20f)));
+         }
+      lo = _mm_min_ps(lo, pos);
+      hi = _mm_max_ps(hi, pos);
+      Store3(outPos[v], pos);
+      Store3(outNrm[v], nrm);
+      }
+   glm::vec3 l, h;
+   Store3(l, lo);
+   Store3(h, hi);
+   boundsMin = glm::min(boundsMin, l);
+   boundsMax = glm::max(boundsMax, h);
+   }
+#endif
+
+#if !defined(CLAYMORE_SKINNING_SSE)
+void SkinRangeScalar(const SkinSource& src, const glm::mat4* palette, size_t boneCount, size_t start, size_t end,
+   glm::vec3* outPos, glm::vec3* outNrm, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+   for (size_t v = start; v < end; ++v) {
+      const float* p = At(src.positions, src.stride, v);
+      const float* n = At(src.normals, src.stride, v);
+      const glm::ivec4 bi = src.boneIndices[v];
+      const glm::vec4 bw = src.boneWeights[v];
+
+      glm::mat4 m(0.0f);
+      float total = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+         if (bw[k] == 0.0f || bi[k] < 0 || (size_t)bi[k] >= boneCount) continue;
+         m += palette[bi[k]] * bw[k];
+         total += bw[k];
+         }
+      glm::vec3 pos(p[0], p[1], p[2]), nrm(n[0], n[1], n[2]);
+      if (total != 0.0f) {
+         pos = glm::vec3(m * glm::vec4(pos, 1.0f));
+         nrm = glm::vec3(m * glm::vec4(nrm, 0.0f));
+         const float len = glm::length(nrm);
+         nrm = len > 1e-20f ? nrm / len : glm::vec3(0.0f);
+         }
+      outPos[v] = pos;
+      outNrm[v] = nrm;
+      boundsMin = glm::min(boundsMin, pos);
+      boundsMax = glm::max(boundsMax, pos);
+      }
+   }
+#endif
+
+} // namespace
+
+void SkinVertices(const SkinSource& src, const glm::mat4* palette, size_t boneCount, size_t start, size_t count,
+   glm::vec3* outPositions, glm::vec3* outNormals, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+#if defined(CLAYMORE_SKINNING_SSE)
+   SkinRangeSSE(src, palette, boneCount, start, start + count, outPositions, outNormals, boundsMin, boundsMax);
+#else
+   SkinRangeScalar(src, palette, boneCount, start, start + count, outPositions, outNormals, boundsMin, boundsMax);
+#endif
+   }
+
+void CpuSkinMesh(const Mesh& mesh, const BlendShapeComponent* blendShapes, SkinningComponent& skin) {
+   const size_t vCount = mesh.Vertices.size();
+   if (vCount == 0 || mesh.Normals.size() < vCount || mesh.BoneIndices.size() < vCount
+      || mesh.BoneWeights.size() < vCount || skin.Palette.empty()) {
+      skin.SkinnedValid = false;
+      return;
+      }
+
+   // Blend-shaped vertices when SkinningSystem keeps a CPU copy for this mesh, else the base mesh
+   SkinSource src;
+   if (blendShapes && blendShapes->VertexStride >= 6 * sizeof(float)
+      && blendShapes->Vertices.size() == vCount * blendShapes->VertexStride) {
+      src.positions = reinterpret_cast<const float*>(blendShapes->Vertices.data());
+      src.normals = src.positions + 3;
+      src.stride = blendShapes->VertexStride;
+      }
+   else {
+      src.positions = &mesh.Vertices[0].x;
+      src.normals = &mesh.Normals[0].x;
+      src.stride = sizeof(glm::vec3);
+      }
+   src.boneIndices = mesh.BoneIndices.data();
+   src.boneWeights = mesh.BoneWeights.data();
+
+   skin.SkinnedPositions.resize(vCount);
+   skin.SkinnedNormals.resize(vCount);
+   glm::vec3 lo(std::numeric_limits<float>::max()), hi(std::numeric_limits<float>::lowest());
+   SkinVertices(src, skin.Palette.data(), skin.Palette.size(), 0, vCount,
+      skin.SkinnedPositions.data(), skin.SkinnedNormals.data(), lo, hi);
+   skin.SkinnedBoundsMin = lo;
+   skin.SkinnedBoundsMax = hi;
+   skin.SkinnedValid = true;
+   }
+
+bool HasCpuSkinnedPose(const SkinningComponent* skin, const Mesh& mesh) {
+   return skin && skin->SkinnedValid && skin->SkinnedPositions.size() == mesh.Vertices.size();
+   }
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct SkinningComponent;
+struct BlendShapeComponent;
+struct Mesh;
+
+// -----------------------------------------------------------------------------
+// Linear blend skinning on the CPU, for consumers that need the animated mesh
+// rather than the bind pose: animated bounds (Scene::SyncBounds), picking, and
+// hitbox queries on a server without a GPU.
+//
+// SkinningSystem skins meshes whose SkinningComponent::CpuSkinning is set, or
+// every skinned mesh with SkinningSystem::CpuSkinningForAll(), one mesh per task,
+// with the same mesh-local palette it uploads for the GPU. Results land in the
+// component (SkinnedPositions/Normals/Bounds, mesh-local). Blend shapes are
+// included when the mesh has them: the source is BlendShapeComponent::Vertices.
+//
+// Those results only exist where SkinningSystem runs: every frame in play mode
+// and in the editor, not in a paused headless scene. One-off consumers call
+// CpuSkinMesh themselves when HasCpuSkinnedPose is false (navmesh baking does).
+// -----------------------------------------------------------------------------
+
+// Vertex input of SkinVertices: positions and normals may be interleaved
+struct SkinSource {
+   const float* positions = nullptr;       // x, y, z at every 'stride' bytes
+   const float* normals = nullptr;
+   size_t stride = sizeof(float) * 3;
+   const glm::ivec4* boneIndices = nullptr;
+   const glm::vec4* boneWeights = nullptr;
+   };
+
+// Skins vertices [start, start + count) into outPositions/outNormals (indexed like the
+// source) and grows boundsMin/boundsMax by the skinned positions. Bone indices outside
+// the palette are ignored; vertices without weights keep their input position.
+void SkinVertices(const SkinSource& src, const glm::mat4* palette, size_t boneCount, size_t start, size_t count,
+   glm::vec3* outPositions, glm::vec3* outNormals, glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+// Skins the whole mesh with skin.Palette into the component's CPU buffers.
+void CpuSkinMesh(const Mesh& mesh, const BlendShapeComponent* blendShapes, SkinningComponent& skin);
+
+// True when 'skin' holds this mesh's skinned vertices (null skin: false)
+bool HasCpuSkinnedPose(const SkinningComponent* skin, const Mesh& mesh);
@@ -73,6 +73,7 @@ EntityData EntityData::DeepCopy(EntityID ID, Scene* newScene) const {
       copy.Skeleton->BoneEntities     = Skeleton->BoneEntities;
       copy.Skeleton->BoneNameToIndex  = Skeleton->BoneNameToIndex;
       copy.Skeleton->BoneParents      = Skeleton->BoneParents;
+      copy.Skeleton->WriteBackAllBones = Skeleton->WriteBackAllBones;
       if (Skeleton->Avatar) {
          copy.Skeleton->Avatar = std::make_unique<cm::animation::AvatarDefinition>(*Skeleton->Avatar);
       }
@@ -2,6 +2,7 @@
 #include "scripting/DotNetHost.h"
 #include "EntityData.h"
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -10,6 +11,7 @@ namespace fs = std::filesystem;
 #include "ecs/AnimationComponents.h"
 #include "ecs/ParticleEmitterSystem.h"
 #include "ecs/SkinningSystem.h"
+#include "ecs/CpuSkinning.h"
 #include <rendering/TextureLoader.h>
 #include <rendering/MaterialManager.h>
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
@@ -19,6 +21,7 @@ namespace fs = std::filesystem;
 #include "animation/AvatarDefinition.h"
 #include "animation/AnimationSystem.h"
 #include "animation/AnimationAsset.h"
+#include "animation/AnimationAssetCache.h"
 #include "animation/SkeletonBinding.h"
 #include "animation/AnimationSerializer.h"
 #include "animation/AnimationPlayerComponent.h"
@@ -27,8 +30,6 @@ namespace fs = std::filesystem;
 
 
 #include <sstream> // Include for std::ostringstream
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
 #include <glm/gtc/quaternion.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/matrix_decompose.hpp>
@@ -48,83 +49,104 @@ namespace fs = std::filesystem;
 #include "animation/ik/IKSystem.h"
 // --- Kernels --------------------------------------------------------------------------------
 
+static constexpr size_t kComposeChunk = 1024;
 
-struct RootArgs {
-   Scene* scene;
-   const std::vector<EntityID>* level;   // level 0 (roots)
-   std::vector<uint8_t>* recomputed;     // size >= scene->m_NextID
+struct ComposeArgs {
+   TransformStore* store;
+   const uint32_t* slots;   // one depth; parents are final before this runs
+   uint32_t first;          // when slots == nullptr: the depth is the contiguous range from 'first'
    };
 
-static inline void RootsKernel(const RootArgs& a, size_t start, size_t count) {
-   for (size_t i = start; i < start + count; ++i) {
-      EntityID id = (*a.level)[i];
-      auto* d = a.scene->GetEntityData(id);
-      if (!d) continue;
-      const bool wasDirty = d->Transform.TransformDirty;
-      if (wasDirty) d->Transform.CalculateLocalMatrix();
-      d->Transform.WorldMatrix = d->Transform.LocalMatrix; // root: parent = I
-      d->Transform.TransformDirty = false;
-      (*a.recomputed)[id] = wasDirty ? 1u : 0u;
+// Stages an edited component's TRS in the store. Euler angles follow yawPitchRoll (Y * X * Z).
+static inline void StageLocalTRS(TransformStore& store, uint32_t slot, const TransformComponent& t) {
+   glm::quat q;
+   if (t.UseQuatRotation) {
+      q = t.RotationQ;
       }
+   else {
+      const glm::vec3 r = glm::radians(t.Rotation);
+      q = glm::angleAxis(r.y, glm::vec3(0, 1, 0))
+        * glm::angleAxis(r.x, glm::vec3(1, 0, 0))
+        * glm::angleAxis(r.z, glm::vec3(0, 0, 1));
+      }
+   const float quat[4] = { q.x, q.y, q.z, q.w };
+   store.SetLocalTRS(slot, &t.Position.x, quat, &t.Scale.x);
    }
 
-struct PropArgs {
-   Scene* scene;
-   const std::vector<EntityID>* level;       // current level
-   std::vector<uint8_t>* recomputed;         // per-entity "updated this frame" flag
-   };
-
-static inline void PropagateKernel(const PropArgs& a, size_t start, size_t count) {
-   for (size_t i = start; i < start + count; ++i) {
-      EntityID id = (*a.level)[i];
-      auto* d = a.scene->GetEntityData(id);
-      if (!d) continue;
-
-      // parent info (guaranteed processed on a previous level)
-      glm::mat4 parentWorld = glm::mat4(1.0f);
-      bool parentUpdated = false;
-      if (d->Parent != -1) {
-         auto* p = a.scene->GetEntityData(d->Parent);
-         parentWorld = p ? p->Transform.WorldMatrix : glm::mat4(1.0f);
-         parentUpdated = p ? ((*a.recomputed)[d->Parent] != 0) : false;
+// Local is only rebuilt for entities that were edited; everything else keeps its LocalMatrix.
+// world = parentWorld * local, then both are written back to the components.
+static inline void ComposeKernel(const ComposeArgs& a, size_t start, size_t count) {
+   TransformStore& store = *a.store;
+   auto slotAt = [&](size_t k) { return a.slots ? a.slots[start + k] : a.first + (uint32_t)(start + k); };
+
+   uint32_t edited[kComposeChunk];
+   size_t numEdited = 0;
+   for (size_t k = 0; k < count; ++k) {
+      const uint32_t slot = slotAt(k);
+      const TransformComponent* src = store.Source(slot);
+      if (!src) continue;
+      if (src->TransformDirty) {
+         StageLocalTRS(store, slot, *src);
+         edited[numEdited++] = slot;
          }
-
-      const bool wasDirty = d->Transform.TransformDirty;
-      const bool needs = wasDirty || parentUpdated;
-      if (needs) {
-         if (wasDirty) d->Transform.CalculateLocalMatrix(); // local changed
-         d->Transform.WorldMatrix = parentWorld * d->Transform.LocalMatrix;
-         d->Transform.TransformDirty = false;
+      else {
+         std::memcpy(store.Local(slot).m, &src->LocalMatrix, sizeof(glm::mat4));
          }
-      (*a.recomputed)[id] = needs ? 1u : 0u;
+      }
+   store.ComposeLocal(edited, numEdited);
+
+   if (a.slots) store.ComposeWorld(a.slots + start, count);
+   else         store.ComposeWorldRange(a.first + (uint32_t)start, a.first + (uint32_t)(start + count));
+
+   for (size_t k = 0; k < count; ++k) {
+      const uint32_t slot = slotAt(k);
+      TransformComponent* src = store.Source(slot);
+      if (!src) continue;
+      std::memcpy(&src->LocalMatrix, store.Local(slot).m, sizeof(glm::mat4));
+      std::memcpy(&src->WorldMatrix, store.World(slot).m, sizeof(glm::mat4));
+      src->TransformDirty = false;
+      src->NormalMatrixDirty = true;
       }
    }
 
-// --- Build breadth levels from your existing parent/children lists
-static inline void BuildHierarchyLevels(Scene& scene,
-   std::vector<std::vector<EntityID>>& levels)
-   {
-   levels.clear();
-   std::vector<EntityID> roots;
-   for (const auto& e : scene.GetEntities()) {
-      auto* d = scene.GetEntityData(e.GetID());
-      if (d && d->Parent == -1) roots.push_back(e.GetID());
+static inline void ComposeLevels(TransformStore& store, const std::vector<std::vector<uint32_t>>& levels) {
+   for (const auto& level : levels) {
+      if (level.empty()) continue;
+      ComposeArgs args{ &store, level.data(), 0 };
+      parallel_for(Jobs(), size_t{0}, level.size(), kComposeChunk,
+         [&](size_t s, size_t c) { ComposeKernel(args, s, c); });
       }
-   if (roots.empty()) return;
-   levels.push_back(std::move(roots));
+   }
 
-   // BFS: each level is the concatenation of all children from the previous level
-   for (;;) {
-      std::vector<EntityID> next;
-      for (EntityID id : levels.back()) {
-         auto* d = scene.GetEntityData(id);
-         if (!d) continue;
-         next.insert(next.end(), d->Children.begin(), d->Children.end());
-         }
-      if (next.empty()) break;
-      levels.push_back(std::move(next));
+// Right after a rebuild every level is a contiguous slot range.
+static inline void ComposeAll(TransformStore& store) {
+   for (size_t L = 0; L < store.LevelCount(); ++L) {
+      const uint32_t begin = store.LevelBegin(L), end = store.LevelEnd(L);
+      if (begin == end) continue;
+      ComposeArgs args{ &store, nullptr, begin };
+      parallel_for(Jobs(), size_t{0}, size_t(end - begin), kComposeChunk,
+         [&](size_t s, size_t c) { ComposeKernel(args, s, c); });
       }
    }
+
+// Stand-in box for meshes without usable bounds (no CPU vertices): large enough that it is
+// never culled, finite so tree costs stay well-defined.
+static constexpr float kUnboundedExtent = 1e18f;
+
+// World AABB of a local box under 'world' (centre/extent form, exact for the box's OBB).
+static DynamicBVH::AABB MeshWorldBounds(const glm::vec3& lmin, const glm::vec3& lmax, bool skinned, const glm::mat4& world) {
+   if (!(lmax.x >= lmin.x && lmax.y >= lmin.y && lmax.z >= lmin.z) || lmin == lmax)
+      return { glm::vec3(-kUnboundedExtent), glm::vec3(kUnboundedExtent) };
+   const glm::vec3 c = (lmin + lmax) * 0.5f;
+   glm::vec3 e = (lmax - lmin) * 0.5f;
+   // Bounds are the bind pose; give skinned meshes room for the animated pose.
+   if (skinned) e *= 2.0f;
+   const glm::vec3 wc = glm::vec3(world * glm::vec4(c, 1.0f));
+   const glm::vec3 we = glm::abs(glm::vec3(world[0])) * e.x
+                      + glm::abs(glm::vec3(world[1])) * e.y
+                      + glm::abs(glm::vec3(world[2])) * e.z;
+   return { wc - we, wc + we };
+   }
 // -----------------------------------------------------------------------------------------
 
 Scene* Scene::CurrentScene = nullptr;
@@ -145,7 +167,14 @@ Entity Scene::CreateEntity(const std::string& name) {
        data.Name = name;
    }
 
-   m_Entities.emplace(id, std::move(data));
+   auto& stored = m_Entities.emplace(id, std::move(data)).first->second;
+   m_Archetypes.Insert(id, &stored);
+   if (m_Hierarchy.Valid) {
+      HierarchyTrack(id, 0);
+      m_TransformStore.Add(id, &stored.Transform);
+      }
+   QueueTransformUpdate(id);
+   m_BoundsStale = true;
 
    Entity entity(id, this);
    m_EntityList.push_back(entity);
@@ -161,7 +190,14 @@ Entity Scene::CreateEntityExact(const std::string& name) {
    EntityData data;
    data.Name = name;
 
-   m_Entities.emplace(id, std::move(data));
+   auto& stored = m_Entities.emplace(id, std::move(data)).first->second;
+   m_Archetypes.Insert(id, &stored);
+   if (m_Hierarchy.Valid) {
+      HierarchyTrack(id, 0);
+      m_TransformStore.Add(id, &stored.Transform);
+      }
+   QueueTransformUpdate(id);
+   m_BoundsStale = true;
 
    Entity entity(id, this);
    m_EntityList.push_back(entity);
@@ -171,6 +207,28 @@ Entity Scene::CreateEntityExact(const std::string& name) {
    return entity;
 }
 
+Entity Scene::AdoptEntity(EntityData&& data) {
+   EntityID id = m_NextID++;
+   data.Parent = INVALID_ENTITY_ID;
+   data.Children.clear();
+   data.Transform.TransformDirty = true;
+
+   auto& stored = m_Entities.emplace(id, std::move(data)).first->second;
+   m_Archetypes.Insert(id, &stored);
+   if (m_Hierarchy.Valid) {
+      HierarchyTrack(id, 0);
+      m_TransformStore.Add(id, &stored.Transform);
+      }
+   QueueTransformUpdate(id);
+   m_BoundsStale = true;
+
+   Entity entity(id, this);
+   m_EntityList.push_back(entity);
+   MarkDirty();
+
+   return entity;
+}
+
 void Scene::RemoveEntity(EntityID id) {
     auto* data = GetEntityData(id);
     if (!data) return;
@@ -253,7 +311,14 @@ void Scene::RemoveEntity(EntityID id) {
         std::remove_if(m_EntityList.begin(), m_EntityList.end(),
             [&](const Entity& e) { return e.GetID() == id; }),
         m_EntityList.end());
+    DestroyBoundsProxy(id);
     m_Entities.erase(id);
+    m_Archetypes.Remove(id);
+    HierarchyUntrack(id);
+    ++m_HierarchyVersion;
+    m_TransformStore.Remove(id);
+    // Compact the transform store once it is mostly holes
+    if (m_TransformStore.DeadCount() * 2 > m_TransformStore.Size()) InvalidateHierarchy();
 
     // Editor: mark scene dirty on structural change
     MarkDirty();
@@ -365,26 +430,28 @@ EntityID Scene::InstantiateAsset(const std::string& path, const glm::vec3& posit
    }
 
 EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootPosition) {
-    Assimp::Importer importer;
-    importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
-    const aiScene* aScene = importer.ReadFile(path,
-        aiProcess_Triangulate |
-        aiProcess_GenNormals |
-        aiProcess_CalcTangentSpace |
-        aiProcess_FlipUVs |
-        aiProcess_JoinIdenticalVertices |
-        aiProcess_ImproveCacheLocality |
-        aiProcess_LimitBoneWeights |
-        aiProcess_GlobalScale);
-
-    if (!aScene || !aScene->mRootNode) {
+    // One Assimp pass: meshes, placeholder materials, node transforms and bone parents
+    Model model = ModelLoader::LoadModel(path);
+    if (model.Meshes.empty() && model.BoneNames.empty()) {
         std::cerr << "[Scene] Failed to load model: " << path << std::endl;
         return -1;
     }
+    return InstantiateLoadedModel(model, path, rootPosition, {});
+}
 
-    // Load meshes and placeholder materials once
-    Model model = ModelLoader::LoadModel(path);
+EntityID Scene::InstantiateImportedModel(const ImportedModel& imported, const std::string& path, const glm::vec3& rootPosition) {
+    Model model = ModelLoader::CreateModel(imported, path);
+    if (model.Meshes.empty() && model.BoneNames.empty()) {
+        std::cerr << "[Scene] Failed to load model: " << path << std::endl;
+        return -1;
+    }
+    return InstantiateLoadedModel(model, path, rootPosition, {});
+}
 
+// Entity tree for a loaded model (from the source file or the binary model cache).
+// 'path' is the source model; 'animPaths' are cached clips used when no .anim sits next to it.
+EntityID Scene::InstantiateLoadedModel(const Model& model, const std::string& path, const glm::vec3& rootPosition,
+                                       const std::vector<std::string>& animPaths) {
     // Root entity that encapsulates the whole model
     Entity rootEntity = CreateEntity("ImportedModel");
     EntityID rootID = rootEntity.GetID();
@@ -394,27 +461,14 @@ EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootP
     glm::vec3 rootT, rootS, rootSkew; glm::vec4 rootPersp; glm::quat rootR;
     glm::mat4 rootLocal   = glm::mat4(1.0f); // will be set below prior to traversal
     glm::mat4 invRoot     = glm::mat4(1.0f);
-    {
-        // Helper: Assimp (row-major) -> GLM (column-major) exists below. We'll use it here after it's defined.
-    }
 
     //--------------------------------------------------------------------
-    // Build map of meshIndex -> transform relative to the FBX root
+    // meshIndex -> transform relative to the FBX root, and its node name
     //--------------------------------------------------------------------
-    std::vector<glm::mat4> meshTransforms(aScene->mNumMeshes, glm::mat4(1.0f));
-    std::vector<std::string> meshEntityNames(aScene->mNumMeshes, std::string());
-
-    // Helper: Assimp (row-major) -> GLM (column-major)
-    auto AiToGlm = [](const aiMatrix4x4& m) {
-        // Keep consistent with ModelLoader's AiToGlm: construct directly (no transpose)
-        return glm::mat4(
-            m.a1, m.b1, m.c1, m.d1,
-            m.a2, m.b2, m.c2, m.d2,
-            m.a3, m.b3, m.c3, m.d3,
-            m.a4, m.b4, m.c4, m.d4);
-    };
-
-    rootLocal   = AiToGlm(aScene->mRootNode->mTransformation);
+    const std::vector<glm::mat4>& meshTransforms = model.MeshTransforms;
+    const std::vector<std::string>& meshEntityNames = model.MeshNodeNames;
+
+    rootLocal   = model.RootTransform;
     // Orient skinned, bind-pose-only imports to +Y-up based on FBX metadata up-axis
     
     // Preserve authoring unit scaling; do not normalize away UnitScaleFactor so imported size matches DCC
@@ -430,30 +484,6 @@ EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootP
     rootData->Transform.Scale    = rootS;
     rootData->Transform.TransformDirty = true;
 
-    // Recursive lambda to accumulate transforms
-    std::function<void(aiNode*, const glm::mat4&)> traverse;
-    traverse = [&](aiNode* node, const glm::mat4& parentTransform) {
-        glm::mat4 local  = AiToGlm(node->mTransformation);
-        glm::mat4 global = parentTransform * local;
-        // Keep meshes in the model's local space; entity root carries the FBX root transform.
-        glm::mat4 relative = invRoot * global;
-
-        // Store relative transform and remember a name for entities from this node
-        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-            unsigned int meshIndex = node->mMeshes[i];
-            if (meshIndex < meshTransforms.size())
-                meshTransforms[meshIndex] = relative;
-            if (meshIndex < meshEntityNames.size()) {
-                // Prefer node name for hierarchy clarity; fallback applied later
-                meshEntityNames[meshIndex] = node->mName.C_Str();
-            }
-        }
-        // Recurse into children
-        for (unsigned int c = 0; c < node->mNumChildren; ++c) {
-            traverse(node->mChildren[c], global);
-        }
-    };
-    traverse(aScene->mRootNode, glm::mat4(1.0f));
 
     //--------------------------------------------------------------------
     // ---------------- Skeleton creation ----------------
@@ -465,28 +495,9 @@ EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootP
         for (int i = 0; i < (int)model.BoneNames.size(); ++i)
             boneNameToIndex[model.BoneNames[i]] = i;
 
-        // Build name->aiNode* map for the whole scene to query parents
-        std::unordered_map<std::string, aiNode*> nodeByName;
-        std::function<void(aiNode*)> gatherNodes = [&](aiNode* n){
-            nodeByName[n->mName.C_Str()] = n;
-            for (unsigned int c = 0; c < n->mNumChildren; ++c)
-                gatherNodes(n->mChildren[c]);
-        };
-        gatherNodes(aScene->mRootNode);
-
-        // Compute parent indices from the Assimp node hierarchy
-        std::vector<int> parentIndex(model.BoneNames.size(), -1);
-        for (size_t i = 0; i < model.BoneNames.size(); ++i) {
-            auto itNode = nodeByName.find(model.BoneNames[i]);
-            if (itNode != nodeByName.end()) {
-                aiNode* p = itNode->second->mParent;
-                while (p) {
-                    auto itBI = boneNameToIndex.find(p->mName.C_Str());
-                    if (itBI != boneNameToIndex.end()) { parentIndex[i] = itBI->second; break; }
-                    p = p->mParent;
-                }
-            }
-        }
+        // Parent indices come from the source node hierarchy
+        std::vector<int> parentIndex = model.BoneParents;
+        parentIndex.resize(model.BoneNames.size(), -1);
 
         // No runtime toggle: default to inverse-bind initialization
 
@@ -565,10 +576,7 @@ EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootP
 
         // Auto-add an AnimationPlayerComponent at the skeleton root if the source FBX has animations
         // Load the first unified .anim next to the FBX into the player's first state so it can play without a controller
-        Assimp::Importer animImporter;
-        const aiScene* fbxForAnims = animImporter.ReadFile(path,
-            aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_LimitBoneWeights | aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality | aiProcess_FlipUVs);
-        if (fbxForAnims && fbxForAnims->mNumAnimations > 0) {
+        if (model.AnimationCount > 0) {
             if (!skelData->AnimationPlayer) skelData->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>();
             // Look for a unified .anim next to the FBX using the pattern <fbxname>_*.anim; fallback to first .anim
             std::filesystem::path p(path);
@@ -587,23 +595,17 @@ EntityID Scene::InstantiateModel(const std::string& path, const glm::vec3& rootP
                     if (chosenAnim.empty()) chosenAnim = entry.path().string();
                 }
             }
+            // No authored .anim: first clip from the model cache
+            if (chosenAnim.empty() && !animPaths.empty()) chosenAnim = animPaths.front();
             // Initialize the first active state with loop on by default
             if (skelData->AnimationPlayer->ActiveStates.empty()) skelData->AnimationPlayer->ActiveStates.push_back({});
             skelData->AnimationPlayer->ActiveStates.front().Loop = true;
 
             if (!chosenAnim.empty()) {
-                // Load unified asset; fallback to legacy skeletal clip if needed
-                cm::animation::AnimationAsset asset = cm::animation::LoadAnimationAsset(chosenAnim);
-                if (asset.tracks.empty()) {
-                    cm::animation::AnimationClip legacy = cm::animation::LoadAnimationClip(chosenAnim);
-                    if (!legacy.BoneTracks.empty()) {
-                        asset = cm::animation::WrapLegacyClipAsAsset(legacy);
-                    }
-                }
-                auto assetPtr = std::make_shared<cm::animation::AnimationAsset>(std::move(asset));
-                // Cache and bind into the first active state so non-controller playback works
-                skelData->AnimationPlayer->CachedAssets[0] = assetPtr;
-                skelData->AnimationPlayer->ActiveStates.front().Asset = assetPtr.get();
+                // Start loading the clip (legacy skeletal clips are wrapped by the cache); the
+                // animation system binds it into the first active state once it is in
+                cm::animation::AnimationAssetCache::Instance().Acquire(chosenAnim);
+                skelData->AnimationPlayer->ActiveStates.front().Asset = nullptr;
                 skelData->AnimationPlayer->ActiveStates.front().Time = 0.0f;
                 skelData->AnimationPlayer->ActiveStates.front().Weight = 1.0f;
                 skelData->AnimationPlayer->Controller.reset();
@@ -866,6 +868,25 @@ EntityID Scene::InstantiateModelFast(const std::string& metaPath, const glm::vec
             if (fs::exists(guess)) source = guess.string();
         }
         if (source.empty()) return -1;
+
+        // Mesh cache path is recorded per mesh as "<file>.meshbin#<index>"
+        std::string meshBin;
+        if (j.contains("meshes") && j["meshes"].is_array() && !j["meshes"].empty()) {
+            meshBin = j["meshes"][0].value("mesh", std::string());
+            size_t hash = meshBin.find('#');
+            if (hash != std::string::npos) meshBin.resize(hash);
+        }
+        std::string skelBin = j.value("skeleton", std::string());
+        std::vector<std::string> animPaths;
+        if (j.contains("animations") && j["animations"].is_array())
+            for (const auto& a : j["animations"]) if (a.is_string()) animPaths.push_back(a.get<std::string>());
+
+        if (!meshBin.empty()) {
+            Model model = ModelLoader::LoadModelCache(meshBin, skelBin, source);
+            if (!model.Meshes.empty())
+                return InstantiateLoadedModel(model, source, position, animPaths);
+        }
+        // Cache missing or stale: import the source
         return InstantiateModel(source, position);
     } catch (const std::exception& e) {
         std::cerr << "[Scene] InstantiateModelFast error: " << e.what() << std::endl;
@@ -890,6 +911,9 @@ void Scene::SetParent(EntityID child, EntityID parent) {
 
    childData->Parent = parent;
    parentData->Children.push_back(child);
+   ++m_HierarchyVersion;
+   HierarchyRelevel(child);
+   if (m_Hierarchy.Valid) m_TransformStore.SetParent(child, parent);
    // Mark child subtree dirty so transforms recompute relative to new parent
    MarkTransformDirty(child);
    }
@@ -897,30 +921,249 @@ void Scene::SetParent(EntityID child, EntityID parent) {
 
 void Scene::UpdateTransforms()
    {
-   // Build levels (roots -> leaves). Later you can cache this and update when SetParent/RemoveEntity runs.
-   std::vector<std::vector<EntityID>> levels;
-   BuildHierarchyLevels(*this, levels);
+   // Hierarchy edited behind our back (deserialization, clone, id reset): rebuild once and
+   // recompute everything.
+   if (!m_Hierarchy.Valid) {
+      RebuildHierarchy();
+      ComposeAll(m_TransformStore);
+      m_BoundsAllMoved = true;
+      m_BoundsStale = true;
+      return;
+      }
 
-   if (levels.empty()) return;
+   if (m_DirtyTransforms.empty()) return;
 
-   // One byte per possible EntityID (IDs are monotonic up to m_NextID)
-   std::vector<uint8_t> recomputed(m_NextID, 0);
+   // Expand queued entities into their subtrees, bucketed by depth. Shallowest first, so an
+   // entity already reached through a queued ancestor is skipped.
+   std::sort(m_DirtyTransforms.begin(), m_DirtyTransforms.end(),
+      [this](EntityID a, EntityID b) { return HierarchyDepth(a) < HierarchyDepth(b); });
 
-   // Level 0: roots
-   {
-   RootArgs args{ this, &levels[0], &recomputed };
-   parallel_for(Jobs(), size_t{0}, levels[0].size(), size_t{1024},
-      [&](size_t s, size_t c) { RootsKernel(args, s, c); });
+   if (++m_TransformEpoch == 0) {
+      std::fill(m_TransformVisit.begin(), m_TransformVisit.end(), 0u);
+      m_TransformEpoch = 1;
+      }
+   if (m_TransformVisit.size() < m_Hierarchy.Depth.size())
+      m_TransformVisit.resize(m_Hierarchy.Depth.size(), 0u);
+   for (auto& level : m_TransformWork) level.clear();
+
+   for (EntityID root : m_DirtyTransforms) {
+      if (root < m_TransformQueued.size()) m_TransformQueued[root] = 0;
+      const int32_t rootDepth = HierarchyDepth(root);
+      if (rootDepth < 0 || m_TransformVisit[root] == m_TransformEpoch) continue;
+
+      m_TransformVisit[root] = m_TransformEpoch;
+      m_TransformStack.clear();
+      m_TransformStack.push_back(root);
+      while (!m_TransformStack.empty()) {
+         const EntityID id = m_TransformStack.back();
+         m_TransformStack.pop_back();
+         const size_t depth = (size_t)HierarchyDepth(id);
+         const int32_t slot = m_TransformStore.SlotOf(id);
+         if (m_TransformWork.size() <= depth) m_TransformWork.resize(depth + 1);
+         if (slot >= 0) m_TransformWork[depth].push_back((uint32_t)slot);
+
+         const auto* d = GetEntityData(id);
+         if (!d) continue;
+         for (EntityID child : d->Children) {
+            if (HierarchyDepth(child) < 0 || m_TransformVisit[child] == m_TransformEpoch) continue;
+            m_TransformVisit[child] = m_TransformEpoch;
+            m_TransformStack.push_back(child);
+            }
+         }
+      }
+   m_DirtyTransforms.clear();
+
+   ComposeLevels(m_TransformStore, m_TransformWork);
+
+   // Recomposed entities get their bounds refitted on the next GetBounds()
+   if (!m_BoundsAllMoved) {
+      for (const auto& level : m_TransformWork)
+         for (uint32_t slot : level) m_BoundsMoved.push_back(m_TransformStore.EntityAt(slot));
+      // Nobody has asked for bounds in a while; a full refit is cheaper than the backlog
+      if (m_BoundsMoved.size() > m_TransformStore.Size()) {
+         m_BoundsMoved.clear();
+         m_BoundsAllMoved = true;
+         }
+      }
+   m_BoundsStale = true;
    }
 
-   // Levels 1..N: propagate world = parentWorld * local
-   for (size_t L = 1; L < levels.size(); ++L) {
-      PropArgs args{ this, &levels[L], &recomputed };
-      parallel_for(Jobs(), size_t{0}, levels[L].size(), size_t{2048},
-         [&](size_t s, size_t c) { PropagateKernel(args, s, c); });
+void Scene::QueueTransformUpdate(EntityID id) {
+   if (id >= m_TransformQueued.size()) m_TransformQueued.resize((size_t)id + 1, 0);
+   if (m_TransformQueued[id]) return;
+   m_TransformQueued[id] = 1;
+   m_DirtyTransforms.push_back(id);
+   }
+
+void Scene::SyncBounds() {
+   m_BoundsStale = false;
+   if (++m_BoundsEpoch == 0) {
+      for (EntityID id : m_BoundsTracked) m_BoundsProxy[id].Seen = 0;
+      m_BoundsEpoch = 1;
+      }
+
+   // Components are assigned directly through EntityData, so look at every mesh entity for
+   // new proxies and swapped meshes; only those and moved entities touch the tree.
+   for (auto [id, entity, meshComp] : View<EntityData, MeshComponent>()) {
+      const Mesh* mesh = meshComp.mesh.get();
+      if (!mesh) continue;
+      if (id >= m_BoundsProxy.size()) m_BoundsProxy.resize((size_t)id + 1);
+      BoundsProxy& p = m_BoundsProxy[id];
+      p.Seen = m_BoundsEpoch;
+
+      // CPU-skinned meshes (ecs/CpuSkinning.h) have exact animated bounds; other skinned
+      // meshes get the padded bind-pose box
+      const bool cpuSkinned = HasCpuSkinnedPose(entity.Skinning.get(), *mesh);
+      const bool skinned = mesh->HasSkinning() && !cpuSkinned;
+      const glm::vec3 localMin = cpuSkinned ? entity.Skinning->SkinnedBoundsMin : mesh->BoundsMin;
+      const glm::vec3 localMax = cpuSkinned ? entity.Skinning->SkinnedBoundsMax : mesh->BoundsMax;
+      const bool changed = p.MeshPtr != mesh || p.Skinned != skinned
+                        || p.LocalMin != localMin || p.LocalMax != localMax;
+      if (p.Node != DynamicBVH::kNull && !changed && !m_BoundsAllMoved) continue;
+
+      p.MeshPtr = mesh;
+      p.Skinned = skinned;
+      p.LocalMin = localMin;
+      p.LocalMax = localMax;
+      const DynamicBVH::AABB box = MeshWorldBounds(p.LocalMin, p.LocalMax, p.Skinned, entity.Transform.WorldMatrix);
+      if (p.Node == DynamicBVH::kNull) {
+         p.Node = m_Bounds.Insert(box, id, &entity);
+         p.Tracked = (uint32_t)m_BoundsTracked.size();
+         m_BoundsTracked.push_back(id);
+         }
+      else {
+         m_Bounds.Move(p.Node, box);
+         }
+      }
+
+   if (!m_BoundsAllMoved) {
+      for (EntityID id : m_BoundsMoved) {
+         if (id >= m_BoundsProxy.size()) continue;
+         const BoundsProxy& p = m_BoundsProxy[id];
+         if (p.Node == DynamicBVH::kNull || p.Seen != m_BoundsEpoch) continue;
+         const auto* d = static_cast<const EntityData*>(m_Bounds.UserData(p.Node));
+         m_Bounds.Move(p.Node, MeshWorldBounds(p.LocalMin, p.LocalMax, p.Skinned, d->Transform.WorldMatrix));
+         }
+      }
+   m_BoundsMoved.clear();
+   m_BoundsAllMoved = false;
+
+   // Entities whose mesh was removed
+   for (size_t i = 0; i < m_BoundsTracked.size();) {
+      const EntityID id = m_BoundsTracked[i];
+      if (m_BoundsProxy[id].Seen == m_BoundsEpoch) { ++i; continue; }
+      DestroyBoundsProxy(id); // swaps the last tracked entity into slot i
       }
    }
 
+void Scene::DestroyBoundsProxy(EntityID id) {
+   if (id >= m_BoundsProxy.size()) return;
+   BoundsProxy& p = m_BoundsProxy[id];
+   if (p.Node == DynamicBVH::kNull) return;
+   m_Bounds.Remove(p.Node);
+   const EntityID last = m_BoundsTracked.back();
+   m_BoundsTracked[p.Tracked] = last;
+   m_BoundsProxy[last].Tracked = p.Tracked;
+   m_BoundsTracked.pop_back();
+   p = BoundsProxy{};
+   }
+
+void Scene::HierarchyTrack(EntityID id, int32_t depth) {
+   auto& h = m_Hierarchy;
+   if (id >= h.Depth.size()) {
+      h.Depth.resize((size_t)id + 1, -1);
+      h.Slot.resize((size_t)id + 1, 0);
+      }
+   if (h.Levels.size() <= (size_t)depth) h.Levels.resize((size_t)depth + 1);
+   auto& level = h.Levels[depth];
+   h.Depth[id] = depth;
+   h.Slot[id] = (uint32_t)level.size();
+   level.push_back(id);
+   }
+
+void Scene::HierarchyUntrack(EntityID id) {
+   auto& h = m_Hierarchy;
+   const int32_t depth = HierarchyDepth(id);
+   if (depth < 0) return;
+   // Swap-remove within the level
+   auto& level = h.Levels[depth];
+   const uint32_t slot = h.Slot[id];
+   const EntityID moved = level.back();
+   level[slot] = moved;
+   h.Slot[moved] = slot;
+   level.pop_back();
+   h.Depth[id] = -1;
+   while (!h.Levels.empty() && h.Levels.back().empty()) h.Levels.pop_back();
+   }
+
+void Scene::HierarchyRelevel(EntityID root) {
+   if (!m_Hierarchy.Valid) return;
+   auto* d = GetEntityData(root);
+   if (!d) return;
+
+   int32_t depth = 0;
+   if (d->Parent != INVALID_ENTITY_ID) {
+      const int32_t parentDepth = HierarchyDepth(d->Parent);
+      if (parentDepth < 0) { InvalidateHierarchy(); return; } // detached parent: rebuild lazily
+      depth = parentDepth + 1;
+      }
+   if (HierarchyDepth(root) == depth) return;
+
+   // Move the whole subtree to its new depth
+   std::vector<std::pair<EntityID, int32_t>> stack{ { root, depth } };
+   size_t visited = 0;
+   while (!stack.empty()) {
+      auto [id, dd] = stack.back();
+      stack.pop_back();
+      if (++visited > m_Entities.size()) { InvalidateHierarchy(); return; } // cycle guard
+      HierarchyUntrack(id);
+      HierarchyTrack(id, dd);
+      if (auto* cd = GetEntityData(id))
+         for (EntityID child : cd->Children) stack.emplace_back(child, dd + 1);
+      }
+   }
+
+void Scene::RebuildHierarchy() {
+   auto& h = m_Hierarchy;
+   h.Levels.clear();
+   h.Depth.assign(m_NextID, -1);
+   h.Slot.assign(m_NextID, 0);
+
+   for (const auto& e : m_EntityList) {
+      auto* d = GetEntityData(e.GetID());
+      if (d && d->Parent == INVALID_ENTITY_ID) HierarchyTrack(e.GetID(), 0);
+      }
+   // BFS: each level is the concatenation of all children from the previous level
+   for (size_t L = 0; L < h.Levels.size(); ++L) {
+      for (size_t i = 0; i < h.Levels[L].size(); ++i) {
+         auto* d = GetEntityData(h.Levels[L][i]);
+         if (!d) continue;
+         for (EntityID child : d->Children)
+            if (HierarchyDepth(child) < 0) HierarchyTrack(child, (int32_t)L + 1);
+         }
+      }
+   h.Valid = true;
+
+   // Re-pack the transform store in level order (parents before children, dead slots dropped)
+   m_TransformStore.Clear();
+   for (const auto& level : h.Levels) {
+      m_TransformStore.BeginLevel();
+      for (EntityID id : level) {
+         auto* d = GetEntityData(id);
+         if (!d) continue;
+         const int32_t parentSlot = (d->Parent != INVALID_ENTITY_ID) ? m_TransformStore.SlotOf(d->Parent)
+                                                                     : TransformStore::kNoParent;
+         m_TransformStore.Add(id, &d->Transform, parentSlot);
+         }
+      }
+   m_TransformStore.EndRebuild();
+
+   // Everything gets recomputed; drop the queue.
+   for (EntityID id : m_DirtyTransforms)
+      if (id < m_TransformQueued.size()) m_TransformQueued[id] = 0;
+   m_DirtyTransforms.clear();
+   }
+
 
 
 void Scene::TopologicalSortEntities(std::vector<EntityID>& outSorted) {
@@ -960,11 +1203,10 @@ void Scene::SetPosition(EntityID id, const glm::vec3& pos) {
 
 void Scene::MarkTransformDirty(EntityID id) {
    auto* data = GetEntityData(id);
-   if (!data || data->Transform.TransformDirty) return;
+   if (!data) return;
    data->Transform.TransformDirty = true;
-
-   for (EntityID child : data->Children)
-      MarkTransformDirty(child);
+   // Descendants are recomposed as part of this entity's subtree in UpdateTransforms
+   QueueTransformUpdate(id);
    }
 
 
@@ -991,6 +1233,7 @@ std::shared_ptr<Scene> Scene::RuntimeClone() {
       clone->m_Entities.emplace(id, m_Entities.at(id).DeepCopy(id, clone.get()));
       
       auto& data = clone->m_Entities[id];
+      clone->m_Archetypes.Insert(id, &data);
 
       // Mark transform as dirty so world matrices are computed
       data.Transform.TransformDirty = true;
@@ -1213,6 +1456,7 @@ void Scene::CreatePhysicsBody(EntityID id, const TransformComponent& transform,
    settings.mRestitution = data->RigidBody ? data->RigidBody->Restitution : data->StaticBody ? data->StaticBody->Restitution : 0.0f;
    settings.mAllowSleeping = true;
    settings.mIsSensor = collider.IsTrigger;
+   settings.mUserData = id; // entity lookup for Physics::GetBodyStates()
 
    if (data->RigidBody) {
       settings.mMotionQuality = JPH::EMotionQuality::LinearCast; // Optional: for fast-moving objects
@@ -1250,6 +1494,9 @@ void Scene::Update(float dt) {
    static bool once = (std::cout << "[C++] Scene::Update thread: " << GetCurrentThreadId() << "\n", true);
    // Ensure any queued deletions are processed at a safe point each frame
    ProcessPendingRemovals();
+   // Components may have been added/removed through EntityData since the last frame
+   m_Archetypes.MarkStale();
+   m_BoundsStale = true;
 
    // In play mode, evaluate animations before recomputing world transforms
    if (m_IsPlaying) {
@@ -1305,9 +1552,32 @@ void Scene::Update(float dt) {
                    << " - Gravity: (" << gravity.x << ", " << gravity.y << ", " << gravity.z << ")" << std::endl;
       }
       
+      // Kinematic velocities are pushed in one batch ahead of the steps
+      m_KinematicVelocities.clear();
+      for (auto [id, rb] : View<RigidBodyComponent>())
+         if (rb.IsKinematic && !rb.BodyID.IsInvalid())
+            m_KinematicVelocities.push_back({ rb.BodyID, rb.LinearVelocity, rb.AngularVelocity });
+
       {
          ScopedTimer t("Physics/Step");
-         Physics::Get().Step(dt);
+         Physics::SetKinematicVelocities(m_KinematicVelocities.data(), m_KinematicVelocities.size());
+         Physics::Advance(dt);
+      }
+
+      // Dynamic bodies: blend the last two fixed steps by the leftover time. Runs every
+      // frame, including frames without a step, so motion stays smooth above the step rate.
+      {
+         ScopedTimer t("Physics/Sync");
+         const float alpha = Physics::GetInterpolationAlpha();
+         for (const PhysicsBodyState& s : Physics::GetBodyStates()) {
+            const EntityID id = EntityID(s.UserData);
+            EntityData* data = GetEntityData(id);
+            if (!data || !data->RigidBody || data->RigidBody->BodyID != s.Body || data->RigidBody->IsKinematic) continue;
+            data->Transform.Position = glm::mix(s.PrevPosition, s.Position, alpha);
+            data->Transform.RotationQ = glm::normalize(glm::slerp(s.PrevRotation, s.Rotation, alpha));
+            data->Transform.UseQuatRotation = true;
+            MarkTransformDirty(id);
+            }
       }
 
       for (auto& [id, data] : m_Entities) {
@@ -1316,44 +1586,6 @@ void Scene::Update(float dt) {
             data.Camera->SyncWithTransform(data.Transform);
          }
 
-         // Sync physics bodies with transforms
-         if (data.RigidBody && !data.RigidBody->BodyID.IsInvalid()) {
-            // For kinematic bodies, apply velocity
-            if (data.RigidBody->IsKinematic) {
-               // Apply linear and angular velocity
-               Physics::Get().SetBodyLinearVelocity(data.RigidBody->BodyID, data.RigidBody->LinearVelocity);
-               Physics::Get().SetBodyAngularVelocity(data.RigidBody->BodyID, data.RigidBody->AngularVelocity);
-            } else {
-               // For dynamic bodies, sync transform from physics
-               glm::mat4 physicsTransform = Physics::Get().GetBodyTransform(data.RigidBody->BodyID);
-               if (physicsTransform != glm::mat4(0.0f)) { // Check if valid transform
-                  // Extract position and rotation from physics transform
-                  glm::vec3 position = glm::vec3(physicsTransform[3]);
-                  glm::mat3 rotationMatrix = glm::mat3(physicsTransform);
-                  glm::vec3 rotation = glm::degrees(glm::eulerAngles(glm::quat_cast(rotationMatrix)));
-                  
-                  // Debug: Print physics transform sync (only for first few frames)
-                  static int frameCount = 0;
-                  if (frameCount < 10) {
-                     std::cout << "[Physics] Frame " << frameCount << " - Entity " << id 
-                               << " physics pos: (" << position.x << ", " << position.y << ", " << position.z << ")" << std::endl;
-                  }
-                  frameCount++;
-                  
-                  // Update entity transform
-                  data.Transform.Position = position;
-                  data.Transform.Rotation = rotation;
-                  data.Transform.TransformDirty = true;
-               }
-            }
-         }
-
-         // Sync static bodies (they don't move, but we need to ensure they're positioned correctly)
-         if (data.StaticBody && !data.StaticBody->BodyID.IsInvalid()) {
-            // Static bodies don't move, but we can sync their initial position
-            // This is mainly for when static bodies are created
-         }
-
          for (auto& script : data.Scripts) {
             if (script.Instance) {
                auto scriptStart = std::chrono::high_resolution_clock::now();
@@ -1378,34 +1610,18 @@ void Scene::Update(float dt) {
    }
 
 bool Scene::HasComponent(const char* componentName) {
-   for (const auto& entity : m_EntityList) {
-      const EntityData* data = GetEntityData(entity.GetID());
-      if (!data) continue;
-      if (strcmp(componentName, "MeshComponent") == 0 && data->Mesh)
-         return true;
-      if (strcmp(componentName, "LightComponent") == 0 && data->Light)
-         return true;
-      if (strcmp(componentName, "ColliderComponent") == 0 && data->Collider)
-         return true;
-      if (strcmp(componentName, "CameraComponent") == 0 && data->Camera)
-         return true;
-      if (strcmp(componentName, "RigidBodyComponent") == 0 && data->RigidBody)
-         return true;
-      if (strcmp(componentName, "StaticBodyComponent") == 0 && data->StaticBody)
-         return true;
-      if (strcmp(componentName, "BlendShapeComponent") == 0 && data->BlendShapes)
-         return true;
-      if (strcmp(componentName, "SkeletonComponent") == 0 && data->Skeleton)
-         return true;
-      if (strcmp(componentName, "SkinningComponent") == 0 && data->Skinning)
-         return true;
-      if (strcmp(componentName, "CanvasComponent") == 0 && data->Canvas)
-         return true;
-      if (strcmp(componentName, "PanelComponent") == 0 && data->Panel)
-         return true;
-      if (strcmp(componentName, "ButtonComponent") == 0 && data->Button)
-         return true;
-      }
+   if (strcmp(componentName, "MeshComponent") == 0)       return View<MeshComponent>().Any();
+   if (strcmp(componentName, "LightComponent") == 0)      return View<LightComponent>().Any();
+   if (strcmp(componentName, "ColliderComponent") == 0)   return View<ColliderComponent>().Any();
+   if (strcmp(componentName, "CameraComponent") == 0)     return View<CameraComponent>().Any();
+   if (strcmp(componentName, "RigidBodyComponent") == 0)  return View<RigidBodyComponent>().Any();
+   if (strcmp(componentName, "StaticBodyComponent") == 0) return View<StaticBodyComponent>().Any();
+   if (strcmp(componentName, "BlendShapeComponent") == 0) return View<BlendShapeComponent>().Any();
+   if (strcmp(componentName, "SkeletonComponent") == 0)   return View<SkeletonComponent>().Any();
+   if (strcmp(componentName, "SkinningComponent") == 0)   return View<SkinningComponent>().Any();
+   if (strcmp(componentName, "CanvasComponent") == 0)     return View<CanvasComponent>().Any();
+   if (strcmp(componentName, "PanelComponent") == 0)      return View<PanelComponent>().Any();
+   if (strcmp(componentName, "ButtonComponent") == 0)     return View<ButtonComponent>().Any();
    return false;
    }
 
@@ -4,6 +4,9 @@
 #include <string>
 #include "Entity.h"
 #include "EntityData.h"
+#include "TransformStore.h"
+#include "Archetype.h"
+#include <rendering/DynamicBVH.h>
 #include <assimp/scene.h>
 #include <rendering/ModelLoader.h>
 #include <rendering/Camera.h>
@@ -27,6 +30,9 @@ public:
    Entity CreateEntity(const std::string& name = "Entity");
    // Create an entity preserving the exact provided name (no suffixing). For deserialization.
    Entity CreateEntityExact(const std::string& name);
+   // Moves in an entity assembled outside any scene (SceneLoader's staging) under a new id.
+   // Parent and Children are reset; link it with SetParent.
+   Entity AdoptEntity(EntityData&& data);
    void RemoveEntity(EntityID id);
 
    EntityData* GetEntityData(EntityID id);
@@ -34,12 +40,34 @@ public:
 
    const std::vector<Entity>& GetEntities() const { return m_EntityList; }
 
+   // Typed query over every entity that has all of Ts, e.g. View<TransformComponent, MeshComponent>().
+   // Walks dense per-archetype arrays instead of every entity; see ecs/Archetype.h for when
+   // component additions become visible.
+   template<class... Ts>
+   SceneView<Ts...> View() {
+      if (m_Archetypes.NeedsRefresh()) m_Archetypes.Refresh();
+      return SceneView<Ts...>(m_Archetypes);
+      }
+   // Makes components added since the last Update visible to the next View().
+   void InvalidateArchetypes() { m_Archetypes.MarkStale(); m_BoundsStale = true; }
+   // Call after adding/removing scripts or IK blocks, or retargeting an IK target/pole; the
+   // component mask does not cover them, so GetComponentVersion would not change otherwise.
+   void MarkComponentsChanged() { m_Archetypes.MarkChanged(); m_BoundsStale = true; }
+   // Bumped whenever an entity's component set may have changed (create/remove, a component
+   // added or removed, MarkComponentsChanged); lets systems cache results derived from it.
+   uint32_t GetComponentVersion() {
+      if (m_Archetypes.NeedsRefresh()) m_Archetypes.Refresh();
+      return m_Archetypes.Version();
+      }
+
    Entity CreateLight(const std::string& name, LightType type, const glm::vec3& color, float intensity);
 
    EntityID InstantiateAsset(const std::string& path, const glm::vec3& position);
    EntityID InstantiateModel(const std::string& path, const glm::vec3& rootPosition);
    // Fast path for models imported via cached binaries (.meta/.meshbin/.skelbin)
    EntityID InstantiateModelFast(const std::string& metaPath, const glm::vec3& position);
+   // Model imported off the main thread (ModelLoader::ImportModel); creates its GPU buffers here
+   EntityID InstantiateImportedModel(const ImportedModel& imported, const std::string& path, const glm::vec3& rootPosition);
 
    void DestroyEntity(Entity e) {RemoveEntity(e.GetID());}
 
@@ -47,10 +75,26 @@ public:
    void SetChild(EntityID parent, EntityID child) {SetParent(child, parent);} 
 
    // Transform Updates
+   // Only subtrees queued through MarkTransformDirty (or created since the last update) are
+   // recomputed; a frame in which nothing moved costs nothing.
    void UpdateTransforms();
    void TopologicalSortEntities(std::vector<EntityID>& outSorted);
    void SetPosition(EntityID id, const glm::vec3& pos);
+   // Flags the entity's local transform as edited and queues its subtree for the next
+   // UpdateTransforms. Main thread only. Setting TransformDirty directly is only picked up
+   // for entities created since the last update.
    void MarkTransformDirty(EntityID id);
+   // Call after editing Parent/Children directly (bypassing SetParent); the cached hierarchy
+   // order is rebuilt and every transform recomputed on the next UpdateTransforms.
+   void InvalidateHierarchy() { m_Hierarchy.Valid = false; ++m_HierarchyVersion; }
+   // Bumped whenever parent links may have changed (SetParent, RemoveEntity, InvalidateHierarchy);
+   // lets systems cache per-entity results derived from ancestors.
+   uint32_t GetHierarchyVersion() const { return m_HierarchyVersion; }
+
+   // World-space bounds of every entity with a mesh, for culling and picking. Leaves carry
+   // the EntityID (UserId) and EntityData* (UserData). Synced with transforms and mesh
+   // assignments on first use each frame; valid until the next structural change.
+   const DynamicBVH& GetBounds() { if (m_BoundsStale) SyncBounds(); return m_Bounds; }
 
    std::shared_ptr<Scene> RuntimeClone();
 
@@ -60,6 +104,7 @@ public:
     bool m_IsPaused = false;
 
    std::unordered_map<EntityID, JPH::BodyID> m_BodyMap;
+   std::vector<KinematicVelocity> m_KinematicVelocities; // scratch: batched per Update
 
    void CreatePhysicsBody(EntityID id, const TransformComponent&, const ColliderComponent&);
    void DestroyPhysicsBody(EntityID id);
@@ -88,11 +133,65 @@ public:
     void ProcessPendingRemovals();
 
     // Reset monotonically increasing ID counter (editor-only usage before full deserialization)
-    void ResetEntityIdCounter(EntityID next = 1) { m_NextID = next; }
+    void ResetEntityIdCounter(EntityID next = 1) { m_NextID = next; InvalidateHierarchy(); }
 
 private:
+   // Entity tree of a model already loaded from its source or from the model cache
+   EntityID InstantiateLoadedModel(const Model& model, const std::string& path, const glm::vec3& rootPosition,
+                                   const std::vector<std::string>& animPaths);
+
+   // Persistent roots -> leaves ordering used by UpdateTransforms. Patched by CreateEntity,
+   // SetParent and RemoveEntity; rebuilt lazily when invalidated.
+   struct HierarchyCache {
+      std::vector<std::vector<EntityID>> Levels; // Levels[d] = entities at depth d (unordered)
+      std::vector<int32_t> Depth;                // per EntityID, -1 = not reachable from a root
+      std::vector<uint32_t> Slot;                // per EntityID, index within Levels[Depth]
+      bool Valid = false;
+   };
+
+   int32_t HierarchyDepth(EntityID id) const {
+      return id < m_Hierarchy.Depth.size() ? m_Hierarchy.Depth[id] : -1;
+   }
+   void HierarchyTrack(EntityID id, int32_t depth);
+   void HierarchyUntrack(EntityID id);
+   void HierarchyRelevel(EntityID root);
+   void RebuildHierarchy();
+   void QueueTransformUpdate(EntityID id);
+   void SyncBounds();
+   void DestroyBoundsProxy(EntityID id);
+
+   HierarchyCache m_Hierarchy;
+   uint32_t m_HierarchyVersion = 0;
+   // Packed mirror of every tracked TransformComponent; sorted by depth on RebuildHierarchy.
+   TransformStore m_TransformStore;
+   std::vector<EntityID> m_DirtyTransforms;           // subtree roots queued since the last update
+   std::vector<uint8_t> m_TransformQueued;            // per EntityID, dedup for m_DirtyTransforms
+   std::vector<uint32_t> m_TransformVisit;            // per EntityID, == m_TransformEpoch when expanded
+   uint32_t m_TransformEpoch = 0;
+   std::vector<std::vector<uint32_t>> m_TransformWork; // scratch: store slots of dirty subtrees, by depth
+   std::vector<EntityID> m_TransformStack;            // scratch: subtree expansion
+
+   // Mesh bounds tree. Proxies are refitted only for entities whose world matrix was
+   // recomputed (m_BoundsMoved) or whose mesh changed since the last sync.
+   struct BoundsProxy {
+      int32_t Node = DynamicBVH::kNull;
+      const Mesh* MeshPtr = nullptr;
+      glm::vec3 LocalMin{ 0.0f }, LocalMax{ 0.0f };
+      bool Skinned = false;
+      uint32_t Seen = 0;                             // == m_BoundsEpoch if the mesh was found this sync
+      uint32_t Tracked = 0;                          // index in m_BoundsTracked
+   };
+   DynamicBVH m_Bounds;
+   std::vector<BoundsProxy> m_BoundsProxy;            // per EntityID
+   std::vector<EntityID> m_BoundsTracked;             // entities that own a proxy
+   std::vector<EntityID> m_BoundsMoved;               // world matrix recomputed since the last sync
+   bool m_BoundsAllMoved = true;
+   bool m_BoundsStale = true;
+   uint32_t m_BoundsEpoch = 0;
+
    std::unordered_map<EntityID, EntityData> m_Entities;
    std::vector<Entity> m_EntityList;
+   ArchetypeStorage m_Archetypes;
    EntityID m_NextID = 1;
     Environment m_Environment{};
     std::vector<EntityID> m_PendingRemovals;
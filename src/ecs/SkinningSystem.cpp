@@ -11,6 +11,8 @@
 #include "jobs/JobSystem.h"   
 #include "jobs/ParallelFor.h"
 #include "jobs/Jobs.h"
+#include "ecs/BlendShapeBlender.h"
+#include "ecs/CpuSkinning.h"
 
 // ---------- Palette kernel (assumes pose[i] = boneWorld[i] * invBind[i]) ----------
 struct PaletteArgs {
@@ -27,21 +29,71 @@ static inline void PaletteKernel(const PaletteArgs& a) {
 
    }
 
-// ---------- Blendshape kernel (adds pre-accumulated deltas to base) ----------
-struct MorphBlendArgs {
-   const glm::vec3* basePos; const glm::vec3* baseNrm;
-   const glm::vec3* accDP;   const glm::vec3* accDN; // weighted sums per vertex
-   size_t           vCount;
-   // Output contiguous arrays (avoid assuming interleaved vertex stride)
-   glm::vec3* outPos; glm::vec3* outNrm;
-   int start, count;
-   };
-static inline void MorphBlendKernel(const MorphBlendArgs& a) {
-   const int end = a.start + a.count;
-   for (int i = a.start; i < end; ++i) {
-      a.outPos[i] = a.basePos[i] + a.accDP[i];
-      a.outNrm[i] = a.baseNrm[i] + a.accDN[i];
+// ---------- Blend shapes (sparse deltas, see BlendShapeBlender.h) ----------
+static void FillVertex(PBRVertex& v, const Mesh& mesh, size_t i) {
+   v.x = mesh.Vertices[i].x;  v.y = mesh.Vertices[i].y;  v.z = mesh.Vertices[i].z;
+   v.nx = mesh.Normals[i].x;  v.ny = mesh.Normals[i].y;  v.nz = mesh.Normals[i].z;
+   // Preserve base UVs to avoid UV drift when morph targets are applied
+   if (i < mesh.UVs.size()) { v.u = mesh.UVs[i].x; v.v = mesh.UVs[i].y; }
+   else { v.u = 0.0f; v.v = 0.0f; }
+   }
+static void FillVertex(SkinnedPBRVertex& v, const Mesh& mesh, size_t i) {
+   v.x = mesh.Vertices[i].x;  v.y = mesh.Vertices[i].y;  v.z = mesh.Vertices[i].z;
+   v.nx = mesh.Normals[i].x;  v.ny = mesh.Normals[i].y;  v.nz = mesh.Normals[i].z;
+   if (i < mesh.UVs.size()) { v.u = mesh.UVs[i].x; v.v = mesh.UVs[i].y; }
+   else { v.u = 0.0f; v.v = 0.0f; }
+   const glm::ivec4 bi = (i < mesh.BoneIndices.size()) ? mesh.BoneIndices[i] : glm::ivec4(0);
+   v.i0 = (uint8_t)bi.x; v.i1 = (uint8_t)bi.y; v.i2 = (uint8_t)bi.z; v.i3 = (uint8_t)bi.w;
+   const glm::vec4 bw = (i < mesh.BoneWeights.size()) ? mesh.BoneWeights[i] : glm::vec4(1, 0, 0, 0);
+   v.w0 = bw.x; v.w1 = bw.y; v.w2 = bw.z; v.w3 = bw.w;
+   }
+
+// Rebuilds the component's CPU copy of the vertex buffer from the base mesh
+template <typename V>
+static void FillBaseVertices(BlendShapeComponent& bs, const Mesh& mesh, size_t vCount) {
+   bs.VertexStride = (uint32_t)sizeof(V);
+   bs.Vertices.resize(vCount * sizeof(V));
+   V* out = reinterpret_cast<V*>(bs.Vertices.data());
+   for (size_t i = 0; i < vCount; ++i) FillVertex(out[i], mesh, i);
+   }
+
+// Re-blends the vertices touched by changed weights and uploads only that range
+static void ApplyBlendShapes(Mesh& mesh, BlendShapeComponent& bs, bool skinnedVB) {
+   const size_t vCount = mesh.Vertices.size();
+   if (vCount == 0 || mesh.Normals.size() < vCount) { bs.Dirty = false; return; }
+
+   if (bs.SparseVertexCount != vCount) BuildSparseBlendShapes(bs, vCount);
+
+   // Full rebuild when the CPU copy does not match the mesh, or the GPU buffer was last
+   // written by another component (the edit/play copies of an entity share the mesh)
+   const uint32_t stride = skinnedVB ? (uint32_t)sizeof(SkinnedPBRVertex) : (uint32_t)sizeof(PBRVertex);
+   bool all = mesh.BlendShapeSerial != bs.VertexSerial.Value;
+   if (bs.VertexStride != stride || bs.Vertices.size() != vCount * stride) {
+      if (skinnedVB) FillBaseVertices<SkinnedPBRVertex>(bs, mesh, vCount);
+      else           FillBaseVertices<PBRVertex>(bs, mesh, vCount);
+      all = true;
+      }
+
+   const BlendShapeSpan span = BlendShapesInto(bs, mesh.Vertices.data(), mesh.Normals.data(), vCount, all, Jobs());
+   if (span.count > 0 && bgfx::isValid(mesh.dvbh)) {
+      const bgfx::Memory* mem = bgfx::copy(bs.Vertices.data() + size_t(span.first) * stride, span.count * stride);
+      bgfx::update(mesh.dvbh, span.first, mem);
+      mesh.BlendShapeSerial = bs.VertexSerial.Value;
       }
+   bs.Dirty = false;
+   }
+
+// Drops a CPU-skinned pose SkinningSystem no longer keeps up to date
+static void ReleaseCpuSkin(SkinningComponent& skin) {
+   if (!skin.SkinnedValid) return;
+   skin.SkinnedValid = false;
+   std::vector<glm::vec3>().swap(skin.SkinnedPositions);
+   std::vector<glm::vec3>().swap(skin.SkinnedNormals);
+   }
+
+bool& SkinningSystem::CpuSkinningForAll() {
+   static bool s_All = false;
+   return s_All;
    }
 
 static inline glm::mat4 GetWorldOrIdentity(Scene& scene, EntityID id)
@@ -56,8 +108,6 @@ static inline glm::mat4 GetWorldOrIdentity(Scene& scene, EntityID id)
 
 void SkinningSystem::Update(Scene& scene)
    { 
-   auto& entities = scene.GetEntities();
-
    // 1) Group skinned meshes by SkeletonRoot and collect per-skeleton data
    struct MeshWork {
       EntityID meshId;
@@ -88,11 +138,11 @@ void SkinningSystem::Update(Scene& scene)
       bool needsBlend = false;
       };
    std::vector<NonSkinnedWork> nonSkinned;
+   std::vector<MeshWork*> cpuSkinned;
 
    // Build map: skeleton root -> meshes using it; precompute invMeshWorld per mesh
-   for (const auto& ent : entities) {
-      EntityData* data = scene.GetEntityData(ent.GetID());
-      if (!data || !data->Mesh) continue;
+   for (auto [meshId, entity, meshComp] : scene.View<EntityData, MeshComponent>()) {
+      EntityData* data = &entity;
 
       // Collect non-skinned meshes for blendshape-only updates
       if (!data->Skinning) {
@@ -100,7 +150,7 @@ void SkinningSystem::Update(Scene& scene)
          const bool bsDirty = (data->BlendShapes && meshPtr && meshPtr->Dynamic && data->Mesh->BlendShapes && data->Mesh->BlendShapes->Dirty);
          if (bsDirty) {
             NonSkinnedWork nw{};
-            nw.meshId = ent.GetID();
+            nw.meshId = meshId;
             nw.meshPtr = meshPtr;
             nw.bs = data->BlendShapes.get();
             nw.needsBlend = true;
@@ -110,9 +160,8 @@ void SkinningSystem::Update(Scene& scene)
       }
 
       EntityID root = data->Skinning->SkeletonRoot;
-      if (root == (EntityID)-1) continue;
-      EntityData* skelData = scene.GetEntityData(root);
-      if (!skelData || !skelData->Skeleton) continue;
+      EntityData* skelData = (root == (EntityID)-1) ? nullptr : scene.GetEntityData(root);
+      if (!skelData || !skelData->Skeleton) { ReleaseCpuSkin(*data->Skinning); continue; }
 
       auto& g = groups[root];
       g.root = root; g.skelData = skelData; g.skel = skelData->Skeleton.get();
@@ -123,7 +172,7 @@ void SkinningSystem::Update(Scene& scene)
 
       // Prepare mesh work item
       MeshWork w{};
-      w.meshId = ent.GetID();
+      w.meshId = meshId;
       const glm::mat4 meshWorld = data->Transform.WorldMatrix;          // you already compute this before skinning
       w.invMeshWorld = glm::inverse(meshWorld);                          // palette must be mesh-local :contentReference[oaicite:7]{index=7}
       w.skin = data->Skinning.get();
@@ -136,7 +185,8 @@ void SkinningSystem::Update(Scene& scene)
       const bool bsDirty = (data->BlendShapes && meshPtr && meshPtr->Dynamic && data->Mesh->BlendShapes->Dirty);
       w.meshPtr = meshPtr;
       w.bs = data->BlendShapes.get();
-      w.needsBlend = bsDirty;
+      // Skeletons small on screen (animation LOD) keep the shape dirty until they come closer
+      w.needsBlend = bsDirty && cm::animation::BlendShapesAtLOD(g.skel->LOD.Level);
       // Decide buffer vertex format by mesh data, not material type
       w.isSkinnedVB = (w.meshPtr && w.meshPtr->HasSkinning()); // :contentReference[oaicite:9]{index=9}
 
@@ -146,7 +196,10 @@ void SkinningSystem::Update(Scene& scene)
    // 2) For each skeleton group, compute pose once; then fill palettes in parallel
    for (auto& [root, g] : groups) {
       const size_t boneCountRaw = std::min(g.skel->InverseBindPoses.size(), g.skel->BoneEntities.size());
-      if (boneCountRaw == 0) continue;                                   // :contentReference[oaicite:10]{index=10}
+      if (boneCountRaw == 0) {                                           // :contentReference[oaicite:10]{index=10}
+         for (auto& w : g.meshes) ReleaseCpuSkin(*w.skin);
+         continue;
+         }
       const size_t boneCount = std::min(boneCountRaw, (size_t)SkinnedPBRMaterial::MaxBones); // :contentReference[oaicite:11]{index=11}
 
       // Ensure each mesh palette sized; also decide if we can use identity fast path
@@ -155,20 +208,27 @@ void SkinningSystem::Update(Scene& scene)
          }
 
       // Build pose matrices once (animated or bind-pose)
-      std::vector<glm::mat4> boneWorld(boneCount);
-      // Always source current bone entity world transforms so authored/rest poses (e.g., T-pose) are respected in Edit mode
-      for (size_t i = 0; i < boneCount; ++i) {
-         const EntityID be = g.skel->BoneEntities[i];
-         const EntityData* bd = scene.GetEntityData(be);
-         if (bd) boneWorld[i] = bd->Transform.WorldMatrix;
-         else if (i < g.skel->BindPoseGlobals.size()) boneWorld[i] = g.skel->BindPoseGlobals[i];
-         else boneWorld[i] = glm::inverse(g.skel->InverseBindPoses[i]);
-      }
-
       g.pose.resize(boneCount);
-      for (size_t i = 0; i < boneCount; ++i) {
-         g.pose[i] = boneWorld[i] * g.skel->InverseBindPoses[i];
-      }
+      if (g.skel->PoseValid && g.skel->Pose.model.size() >= boneCount) {
+         // Evaluated this frame by AnimationSystem: bone world = skeleton root world * model pose,
+         // no bone entity lookups (bone entities are only written back when observed)
+         const glm::mat4& rootWorld = g.skelData->Transform.WorldMatrix;
+         for (size_t i = 0; i < boneCount; ++i) {
+            g.pose[i] = rootWorld * g.skel->Pose.model[i] * g.skel->InverseBindPoses[i];
+            }
+         }
+      else {
+         // Source current bone entity world transforms so authored/rest poses (e.g., T-pose) are respected in Edit mode
+         for (size_t i = 0; i < boneCount; ++i) {
+            const EntityID be = g.skel->BoneEntities[i];
+            const EntityData* bd = scene.GetEntityData(be);
+            glm::mat4 boneWorld;
+            if (bd) boneWorld = bd->Transform.WorldMatrix;
+            else if (i < g.skel->BindPoseGlobals.size()) boneWorld = g.skel->BindPoseGlobals[i];
+            else boneWorld = glm::inverse(g.skel->InverseBindPoses[i]);
+            g.pose[i] = boneWorld * g.skel->InverseBindPoses[i];
+            }
+         }
 
       // Fill palettes across meshes: palette[i] = invMesh * pose[i]
       // Parallelize per mesh first (bone counts are modest)
@@ -188,160 +248,30 @@ void SkinningSystem::Update(Scene& scene)
          }
       }
 
-      // 3) Blendshapes per mesh (dynamic; if dirty apply, else ensure base restored)
+      // 3) Blend shapes per mesh (dynamic meshes, when weights changed)
       for (auto& w : g.meshes) {
-         if (!w.meshPtr) continue;
-         const size_t vCountBase = w.meshPtr->Vertices.size();
-         if (vCountBase == 0) continue;
-
-         if (!w.needsBlend) { continue; }
-
-         const size_t vCount = vCountBase;               // :contentReference[oaicite:15]{index=15}
-         if (vCount == 0) { w.bs->Dirty = false; continue; }             // :contentReference[oaicite:16]{index=16}
-
-         // Base copy of output vertex buffer (keeps UVs/indices/weights as before)
-         if (w.isSkinnedVB) {
-            std::vector<SkinnedPBRVertex> blended(vCount);
-            // Copy base once (as your original code did) — keeps UVs/indices/weights intact :contentReference[oaicite:17]{index=17}
-            for (size_t i = 0; i < vCount; ++i) {
-               blended[i].x = w.meshPtr->Vertices[i].x;
-               blended[i].y = w.meshPtr->Vertices[i].y;
-               blended[i].z = w.meshPtr->Vertices[i].z;
-               blended[i].nx = w.meshPtr->Normals[i].x;
-               blended[i].ny = w.meshPtr->Normals[i].y;
-               blended[i].nz = w.meshPtr->Normals[i].z;
-               // Preserve base UVs to avoid UV drift when morph targets are applied
-               if (i < w.meshPtr->UVs.size()) { blended[i].u = w.meshPtr->UVs[i].x; blended[i].v = w.meshPtr->UVs[i].y; }
-               else { blended[i].u = 0.0f; blended[i].v = 0.0f; }
-               const glm::ivec4 bi = (i < w.meshPtr->BoneIndices.size()) ? w.meshPtr->BoneIndices[i] : glm::ivec4(0);
-               blended[i].i0 = (uint8_t)bi.x; blended[i].i1 = (uint8_t)bi.y;
-               blended[i].i2 = (uint8_t)bi.z; blended[i].i3 = (uint8_t)bi.w;
-               const glm::vec4 bw = (i < w.meshPtr->BoneWeights.size()) ? w.meshPtr->BoneWeights[i] : glm::vec4(1, 0, 0, 0);
-               blended[i].w0 = bw.x; blended[i].w1 = bw.y; blended[i].w2 = bw.z; blended[i].w3 = bw.w;
-               }
-
-            // Pre-accumulate weighted deltas once
-            std::vector<glm::vec3> accDP(vCount, glm::vec3(0));
-            std::vector<glm::vec3> accDN(vCount, glm::vec3(0));
-            for (const auto& shape : w.bs->Shapes) {
-               const float weight = shape.Weight;
-               if (weight == 0.0f) continue;
-               if (shape.DeltaPos.size() != vCount || shape.DeltaNormal.size() != vCount) continue; // :contentReference[oaicite:19]{index=19}
-               for (size_t i = 0; i < vCount; ++i) {
-                  accDP[i] += shape.DeltaPos[i] * weight;
-                  accDN[i] += shape.DeltaNormal[i] * weight;
-                  }
-               }
-
-            // Kernel over vertices -> contiguous outputs, then copy back
-            std::vector<glm::vec3> outPos(vCount), outNrm(vCount);
-            MorphBlendArgs ba{
-                w.meshPtr->Vertices.data(), w.meshPtr->Normals.data(),
-                accDP.data(), accDN.data(), vCount,
-                outPos.data(), outNrm.data(),
-                0, (int)vCount
-               };
-            MorphBlendKernel(ba);
-            for (size_t i = 0; i < vCount; ++i) {
-               blended[i].x = outPos[i].x; blended[i].y = outPos[i].y; blended[i].z = outPos[i].z;
-               blended[i].nx = outNrm[i].x; blended[i].ny = outNrm[i].y; blended[i].nz = outNrm[i].z;
-            }
-
-            // Upload once on main thread
-            const bgfx::Memory* mem = bgfx::copy(blended.data(), uint32_t(sizeof(SkinnedPBRVertex) * blended.size()));
-            if (bgfx::isValid(w.meshPtr->dvbh)) {
-               bgfx::update(w.meshPtr->dvbh, 0, mem);                   // :contentReference[oaicite:20]{index=20}
-            }
-            }
-         else {
-            std::vector<PBRVertex> blended(vCount);
-            for (size_t i = 0; i < vCount; ++i) {
-               blended[i].x = w.meshPtr->Vertices[i].x;
-               blended[i].y = w.meshPtr->Vertices[i].y;
-               blended[i].z = w.meshPtr->Vertices[i].z;
-               blended[i].nx = w.meshPtr->Normals[i].x;
-               blended[i].ny = w.meshPtr->Normals[i].y;
-               blended[i].nz = w.meshPtr->Normals[i].z;
-               // Preserve base UVs to avoid warping when morph targets apply
-               if (i < w.meshPtr->UVs.size()) { blended[i].u = w.meshPtr->UVs[i].x; blended[i].v = w.meshPtr->UVs[i].y; }
-               else { blended[i].u = 0.0f; blended[i].v = 0.0f; }
-               }
-            std::vector<glm::vec3> accDP(vCount, glm::vec3(0));
-            std::vector<glm::vec3> accDN(vCount, glm::vec3(0));
-            for (const auto& shape : w.bs->Shapes) {
-               const float weight = shape.Weight;
-               if (weight == 0.0f) continue;
-               if (shape.DeltaPos.size() != vCount || shape.DeltaNormal.size() != vCount) continue; // :contentReference[oaicite:22]{index=22}
-               for (size_t i = 0; i < vCount; ++i) {
-                  accDP[i] += shape.DeltaPos[i] * weight;
-                  accDN[i] += shape.DeltaNormal[i] * weight;
-                  }
-               }
-            std::vector<glm::vec3> outPos2(vCount), outNrm2(vCount);
-            MorphBlendArgs ba{
-                w.meshPtr->Vertices.data(), w.meshPtr->Normals.data(),
-                accDP.data(), accDN.data(), vCount,
-                outPos2.data(), outNrm2.data(),
-                0, (int)vCount
-               };
-            MorphBlendKernel(ba);
-            for (size_t i = 0; i < vCount; ++i) {
-               blended[i].x = outPos2[i].x; blended[i].y = outPos2[i].y; blended[i].z = outPos2[i].z;
-               blended[i].nx = outNrm2[i].x; blended[i].ny = outNrm2[i].y; blended[i].nz = outNrm2[i].z;
-            }
-            const bgfx::Memory* mem = bgfx::copy(blended.data(), uint32_t(sizeof(PBRVertex) * blended.size()));
-            if (bgfx::isValid(w.meshPtr->dvbh)) {
-               bgfx::update(w.meshPtr->dvbh, 0, mem);                   // :contentReference[oaicite:23]{index=23}
-            }
-            }
+         if (!w.needsBlend || !w.meshPtr || !w.bs) continue;
+         ApplyBlendShapes(*w.meshPtr, *w.bs, w.isSkinnedVB);
+         }
 
-         w.bs->Dirty = false;                                            // :contentReference[oaicite:24]{index=24}
+      for (auto& w : g.meshes) {
+         if (w.meshPtr && w.isSkinnedVB && (w.skin->CpuSkinning || CpuSkinningForAll())) cpuSkinned.push_back(&w);
+         else ReleaseCpuSkin(*w.skin);
          }
       }
-        
+
+   // CPU skinning (after blend shapes, which it reads), one mesh per task
+   parallel_for(Jobs(), size_t{ 0 }, cpuSkinned.size(), size_t{ 1 },
+      [&](size_t start, size_t count) {
+      for (size_t i = start; i < start + count; ++i) {
+         const MeshWork& w = *cpuSkinned[i];
+         CpuSkinMesh(*w.meshPtr, w.bs, *w.skin);
+         }
+      });
+
    // 4) Non-skinned meshes: apply blendshapes separately
    for (auto& w : nonSkinned) {
       if (!w.needsBlend || !w.meshPtr || !w.bs) continue;
-      const size_t vCount = w.meshPtr->Vertices.size();
-      if (vCount == 0) { w.bs->Dirty = false; continue; }
-
-      std::vector<PBRVertex> blended(vCount);
-      for (size_t i = 0; i < vCount; ++i) {
-         blended[i].x = w.meshPtr->Vertices[i].x;
-         blended[i].y = w.meshPtr->Vertices[i].y;
-         blended[i].z = w.meshPtr->Vertices[i].z;
-         blended[i].nx = w.meshPtr->Normals[i].x;
-         blended[i].ny = w.meshPtr->Normals[i].y;
-         blended[i].nz = w.meshPtr->Normals[i].z;
-         blended[i].u = 0.0f; blended[i].v = 0.0f;
-      }
-      std::vector<glm::vec3> accDP(vCount, glm::vec3(0));
-      std::vector<glm::vec3> accDN(vCount, glm::vec3(0));
-      for (const auto& shape : w.bs->Shapes) {
-         const float weight = shape.Weight;
-         if (weight == 0.0f) continue;
-         if (shape.DeltaPos.size() != vCount || shape.DeltaNormal.size() != vCount) continue;
-         for (size_t i = 0; i < vCount; ++i) {
-            accDP[i] += shape.DeltaPos[i] * weight;
-            accDN[i] += shape.DeltaNormal[i] * weight;
-         }
-      }
-      std::vector<glm::vec3> outPos(vCount), outNrm(vCount);
-      MorphBlendArgs ba{
-         w.meshPtr->Vertices.data(), w.meshPtr->Normals.data(),
-         accDP.data(), accDN.data(), vCount,
-         outPos.data(), outNrm.data(),
-         0, (int)vCount
-      };
-      MorphBlendKernel(ba);
-      for (size_t i = 0; i < vCount; ++i) {
-         blended[i].x = outPos[i].x; blended[i].y = outPos[i].y; blended[i].z = outPos[i].z;
-         blended[i].nx = outNrm[i].x; blended[i].ny = outNrm[i].y; blended[i].nz = outNrm[i].z;
-      }
-      const bgfx::Memory* mem = bgfx::copy(blended.data(), uint32_t(sizeof(PBRVertex) * blended.size()));
-      if (bgfx::isValid(w.meshPtr->dvbh)) {
-         bgfx::update(w.meshPtr->dvbh, 0, mem);
-      }
-      w.bs->Dirty = false;
+      ApplyBlendShapes(*w.meshPtr, *w.bs, w.meshPtr->HasSkinning());
    }
 }
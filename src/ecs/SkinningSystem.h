@@ -5,4 +5,8 @@
 class SkinningSystem {
 public:
     static void Update(Scene& scene);
+
+    // CPU-skin every skinned mesh (ecs/CpuSkinning.h), not only those with
+    // SkinningComponent::CpuSkinning set; e.g. on a server without a GPU
+    static bool& CpuSkinningForAll();
 };
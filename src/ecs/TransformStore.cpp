@@ -0,0 +1,304 @@
+#include "TransformStore.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__AVX__)
+#define CLAYMORE_TRANSFORM_AVX 1
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLAYMORE_TRANSFORM_SSE 1
+#include <emmintrin.h>
+#endif
+
+static constexpr EntityID kDeadSlot = static_cast<EntityID>(-1);
+
+// --- Layout -------------------------------------------------------------------
+
+void TransformStore::Clear() {
+   m_Entity.clear();
+   m_Parent.clear();
+   m_Source.clear();
+   m_PosX.clear(); m_PosY.clear(); m_PosZ.clear();
+   m_RotX.clear(); m_RotY.clear(); m_RotZ.clear(); m_RotW.clear();
+   m_SclX.clear(); m_SclY.clear(); m_SclZ.clear();
+   m_Local.clear();
+   m_World.clear();
+   std::fill(m_SlotOf.begin(), m_SlotOf.end(), kNoParent);
+   m_LevelStart.clear();
+   m_SortedEnd = 0;
+   m_Dead = 0;
+   }
+
+uint32_t TransformStore::Add(EntityID id, TransformComponent* source, int32_t parentSlot) {
+   const uint32_t slot = (uint32_t)m_Entity.size();
+   static const Matrix kIdentity{ { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 } };
+   m_Entity.push_back(id);
+   m_Parent.push_back(parentSlot);
+   m_Source.push_back(source);
+   m_PosX.push_back(0.0f); m_PosY.push_back(0.0f); m_PosZ.push_back(0.0f);
+   m_RotX.push_back(0.0f); m_RotY.push_back(0.0f); m_RotZ.push_back(0.0f); m_RotW.push_back(1.0f);
+   m_SclX.push_back(1.0f); m_SclY.push_back(1.0f); m_SclZ.push_back(1.0f);
+   m_Local.push_back(kIdentity);
+   m_World.push_back(kIdentity);
+   if (id >= m_SlotOf.size()) m_SlotOf.resize((size_t)id + 1, kNoParent);
+   m_SlotOf[id] = (int32_t)slot;
+   return slot;
+   }
+
+void TransformStore::Remove(EntityID id) {
+   const int32_t slot = SlotOf(id);
+   if (slot < 0) return;
+   m_Entity[slot] = kDeadSlot;
+   m_Source[slot] = nullptr;
+   m_Parent[slot] = kNoParent;
+   m_SlotOf[id] = kNoParent;
+   ++m_Dead;
+   }
+
+void TransformStore::SetParent(EntityID child, EntityID parent) {
+   const int32_t slot = SlotOf(child);
+   if (slot < 0) return;
+   m_Parent[slot] = SlotOf(parent); // kNoParent for INVALID_ENTITY_ID / untracked
+   }
+
+// --- Kernels ------------------------------------------------------------------
+//
+// Local = T * R(q) * S, written column-major:
+//   c0 = R[0] * sx, c1 = R[1] * sy, c2 = R[2] * sz, c3 = (t, 1)
+// with R from the normalized quaternion exactly as glm::mat3_cast builds it.
+// Zero-length quaternions map to identity, matching glm::normalize.
+
+namespace {
+
+inline void ComposeLocalScalar(float px, float py, float pz,
+   float qx, float qy, float qz, float qw,
+   float sx, float sy, float sz, float* out)
+   {
+   const float len2 = qx * qx + qy * qy + qz * qz + qw * qw;
+   if (len2 > 0.0f) {
+      const float inv = 1.0f / std::sqrt(len2);
+      qx *= inv; qy *= inv; qz *= inv; qw *= inv;
+      }
+   else {
+      qx = qy = qz = 0.0f; qw = 1.0f;
+      }
+   const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+   const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+   const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+   out[0]  = (1.0f - 2.0f * (yy + zz)) * sx;
+   out[1]  = 2.0f * (xy + wz) * sx;
+   out[2]  = 2.0f * (xz - wy) * sx;
+   out[3]  = 0.0f;
+   out[4]  = 2.0f * (xy - wz) * sy;
+   out[5]  = (1.0f - 2.0f * (xx + zz)) * sy;
+   out[6]  = 2.0f * (yz + wx) * sy;
+   out[7]  = 0.0f;
+   out[8]  = 2.0f * (xz + wy) * sz;
+   out[9]  = 2.0f * (yz - wx) * sz;
+   out[10] = (1.0f - 2.0f * (xx + yy)) * sz;
+   out[11] = 0.0f;
+   out[12] = px;
+   out[13] = py;
+   out[14] = pz;
+   out[15] = 1.0f;
+   }
+
+inline void MulMatScalar(const float* p, const float* l, float* out) {
+   for (int c = 0; c < 4; ++c) {
+      const float l0 = l[c * 4 + 0], l1 = l[c * 4 + 1], l2 = l[c * 4 + 2], l3 = l[c * 4 + 3];
+      for (int r = 0; r < 4; ++r)
+         out[c * 4 + r] = p[r] * l0 + p[4 + r] * l1 + p[8 + r] * l2 + p[12 + r] * l3;
+      }
+   }
+
+#if defined(CLAYMORE_TRANSFORM_SSE)
+inline void MulMatSSE(const float* p, const float* l, float* out) {
+   const __m128 p0 = _mm_load_ps(p + 0);
+   const __m128 p1 = _mm_load_ps(p + 4);
+   const __m128 p2 = _mm_load_ps(p + 8);
+   const __m128 p3 = _mm_load_ps(p + 12);
+   for (int c = 0; c < 4; ++c) {
+      const float* lc = l + c * 4;
+      __m128 r = _mm_mul_ps(p0, _mm_set1_ps(lc[0]));
+      r = _mm_add_ps(r, _mm_mul_ps(p1, _mm_set1_ps(lc[1])));
+      r = _mm_add_ps(r, _mm_mul_ps(p2, _mm_set1_ps(lc[2])));
+      r = _mm_add_ps(r, _mm_mul_ps(p3, _mm_set1_ps(lc[3])));
+      _mm_store_ps(out + c * 4, r);
+      }
+   }
+
+// Arithmetic shared by the 4-wide (SSE) and 8-wide (AVX) compose kernels.
+inline __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+inline __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+inline __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+inline __m128 Div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+inline __m128 Sqrt(__m128 a) { return _mm_sqrt_ps(a); }
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+inline __m128 GreaterThan(__m128 a, __m128 b) { return _mm_cmpgt_ps(a, b); }
+inline __m128 Splat(__m128*, float f) { return _mm_set1_ps(f); }
+
+// Writes column 'c' (x/y/z/w streams of 4 lanes) into the lanes' matrices.
+inline void StoreColumn(float* const out[4], int c, __m128 x, __m128 y, __m128 z, __m128 w) {
+   _MM_TRANSPOSE4_PS(x, y, z, w);
+   _mm_store_ps(out[0] + c * 4, x);
+   _mm_store_ps(out[1] + c * 4, y);
+   _mm_store_ps(out[2] + c * 4, z);
+   _mm_store_ps(out[3] + c * 4, w);
+   }
+#endif
+
+#if defined(CLAYMORE_TRANSFORM_AVX)
+inline __m256 Add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+inline __m256 Sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+inline __m256 Mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+inline __m256 Div(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+inline __m256 Sqrt(__m256 a) { return _mm256_sqrt_ps(a); }
+inline __m256 Select(__m256 mask, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+inline __m256 GreaterThan(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline __m256 Splat(__m256*, float f) { return _mm256_set1_ps(f); }
+
+inline void StoreColumn(float* const out[8], int c, __m256 x, __m256 y, __m256 z, __m256 w) {
+   StoreColumn(out, c,
+      _mm256_castps256_ps128(x), _mm256_castps256_ps128(y),
+      _mm256_castps256_ps128(z), _mm256_castps256_ps128(w));
+   StoreColumn(out + 4, c,
+      _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1),
+      _mm256_extractf128_ps(z, 1), _mm256_extractf128_ps(w, 1));
+   }
+#endif
+
+#if defined(CLAYMORE_TRANSFORM_AVX)
+using Lane = __m256;
+constexpr size_t kLanes = 8;
+inline Lane LoadRange(const float* p) { return _mm256_loadu_ps(p); }
+inline Lane LoadGather(const float* p, const uint32_t* s) {
+   return _mm256_setr_ps(p[s[0]], p[s[1]], p[s[2]], p[s[3]], p[s[4]], p[s[5]], p[s[6]], p[s[7]]);
+   }
+#elif defined(CLAYMORE_TRANSFORM_SSE)
+using Lane = __m128;
+constexpr size_t kLanes = 4;
+inline Lane LoadRange(const float* p) { return _mm_loadu_ps(p); }
+inline Lane LoadGather(const float* p, const uint32_t* s) {
+   return _mm_setr_ps(p[s[0]], p[s[1]], p[s[2]], p[s[3]]);
+   }
+#endif
+
+#if defined(CLAYMORE_TRANSFORM_SSE)
+struct TRSLanes { Lane px, py, pz, qx, qy, qz, qw, sx, sy, sz; };
+
+inline void ComposeLanes(TRSLanes t, float* const out[kLanes]) {
+   const Lane zero = Splat((Lane*)nullptr, 0.0f);
+   const Lane one = Splat((Lane*)nullptr, 1.0f);
+   const Lane two = Splat((Lane*)nullptr, 2.0f);
+
+   const Lane len2 = Add(Add(Mul(t.qx, t.qx), Mul(t.qy, t.qy)), Add(Mul(t.qz, t.qz), Mul(t.qw, t.qw)));
+   const Lane valid = GreaterThan(len2, zero);
+   const Lane inv = Div(one, Sqrt(Select(valid, len2, one)));
+   const Lane qx = Select(valid, Mul(t.qx, inv), zero);
+   const Lane qy = Select(valid, Mul(t.qy, inv), zero);
+   const Lane qz = Select(valid, Mul(t.qz, inv), zero);
+   const Lane qw = Select(valid, Mul(t.qw, inv), one);
+
+   const Lane xx = Mul(qx, qx), yy = Mul(qy, qy), zz = Mul(qz, qz);
+   const Lane xy = Mul(qx, qy), xz = Mul(qx, qz), yz = Mul(qy, qz);
+   const Lane wx = Mul(qw, qx), wy = Mul(qw, qy), wz = Mul(qw, qz);
+
+   StoreColumn(out, 0,
+      Mul(Sub(one, Mul(two, Add(yy, zz))), t.sx),
+      Mul(Mul(two, Add(xy, wz)), t.sx),
+      Mul(Mul(two, Sub(xz, wy)), t.sx),
+      zero);
+   StoreColumn(out, 1,
+      Mul(Mul(two, Sub(xy, wz)), t.sy),
+      Mul(Sub(one, Mul(two, Add(xx, zz))), t.sy),
+      Mul(Mul(two, Add(yz, wx)), t.sy),
+      zero);
+   StoreColumn(out, 2,
+      Mul(Mul(two, Add(xz, wy)), t.sz),
+      Mul(Mul(two, Sub(yz, wx)), t.sz),
+      Mul(Sub(one, Mul(two, Add(xx, yy))), t.sz),
+      zero);
+   StoreColumn(out, 3, t.px, t.py, t.pz, one);
+   }
+#endif
+
+} // namespace
+
+const char* TransformStore::KernelName() {
+#if defined(CLAYMORE_TRANSFORM_AVX)
+   return "avx";
+#elif defined(CLAYMORE_TRANSFORM_SSE)
+   return "sse";
+#else
+   return "scalar";
+#endif
+   }
+
+void TransformStore::ComposeLocalRange(uint32_t begin, uint32_t end) {
+   uint32_t i = begin;
+#if defined(CLAYMORE_TRANSFORM_SSE)
+   for (; i + kLanes <= end; i += kLanes) {
+      TRSLanes t{
+         LoadRange(&m_PosX[i]), LoadRange(&m_PosY[i]), LoadRange(&m_PosZ[i]),
+         LoadRange(&m_RotX[i]), LoadRange(&m_RotY[i]), LoadRange(&m_RotZ[i]), LoadRange(&m_RotW[i]),
+         LoadRange(&m_SclX[i]), LoadRange(&m_SclY[i]), LoadRange(&m_SclZ[i]) };
+      float* out[kLanes];
+      for (size_t l = 0; l < kLanes; ++l) out[l] = m_Local[i + l].m;
+      ComposeLanes(t, out);
+      }
+#endif
+   for (; i < end; ++i)
+      ComposeLocalScalar(m_PosX[i], m_PosY[i], m_PosZ[i],
+         m_RotX[i], m_RotY[i], m_RotZ[i], m_RotW[i],
+         m_SclX[i], m_SclY[i], m_SclZ[i], m_Local[i].m);
+   }
+
+void TransformStore::ComposeLocal(const uint32_t* slots, size_t count) {
+   size_t n = 0;
+#if defined(CLAYMORE_TRANSFORM_SSE)
+   for (; n + kLanes <= count; n += kLanes) {
+      const uint32_t* s = slots + n;
+      TRSLanes t{
+         LoadGather(m_PosX.data(), s), LoadGather(m_PosY.data(), s), LoadGather(m_PosZ.data(), s),
+         LoadGather(m_RotX.data(), s), LoadGather(m_RotY.data(), s), LoadGather(m_RotZ.data(), s), LoadGather(m_RotW.data(), s),
+         LoadGather(m_SclX.data(), s), LoadGather(m_SclY.data(), s), LoadGather(m_SclZ.data(), s) };
+      float* out[kLanes];
+      for (size_t l = 0; l < kLanes; ++l) out[l] = m_Local[s[l]].m;
+      ComposeLanes(t, out);
+      }
+#endif
+   for (; n < count; ++n) {
+      const uint32_t i = slots[n];
+      ComposeLocalScalar(m_PosX[i], m_PosY[i], m_PosZ[i],
+         m_RotX[i], m_RotY[i], m_RotZ[i], m_RotW[i],
+         m_SclX[i], m_SclY[i], m_SclZ[i], m_Local[i].m);
+      }
+   }
+
+void TransformStore::ComposeWorldRange(uint32_t begin, uint32_t end) {
+   for (uint32_t i = begin; i < end; ++i) {
+      const int32_t p = m_Parent[i];
+      if (p < 0) { m_World[i] = m_Local[i]; continue; }
+#if defined(CLAYMORE_TRANSFORM_SSE)
+      MulMatSSE(m_World[p].m, m_Local[i].m, m_World[i].m);
+#else
+      MulMatScalar(m_World[p].m, m_Local[i].m, m_World[i].m);
+#endif
+      }
+   }
+
+void TransformStore::ComposeWorld(const uint32_t* slots, size_t count) {
+   for (size_t n = 0; n < count; ++n) {
+      const uint32_t i = slots[n];
+      const int32_t p = m_Parent[i];
+      if (p < 0) { m_World[i] = m_Local[i]; continue; }
+#if defined(CLAYMORE_TRANSFORM_SSE)
+      MulMatSSE(m_World[p].m, m_Local[i].m, m_World[i].m);
+#else
+      MulMatScalar(m_World[p].m, m_Local[i].m, m_World[i].m);
+#endif
+      }
+   }
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Entity.h"
+
+struct TransformComponent;
+
+// -----------------------------------------------------------------------------
+// Packed transform storage used by Scene::UpdateTransforms.
+//
+// Every tracked entity owns a slot. Local TRS is staged as structure-of-arrays
+// (one float stream per component) so the local-matrix kernel composes 4 (SSE)
+// or 8 (AVX) entities per iteration; local/world matrices live in dense arrays
+// next to a parent *slot* index, so propagation never goes through the entity
+// hash map.
+//
+// A rebuild (Clear, then BeginLevel + Add for each level, then EndRebuild)
+// leaves the slots parent-sorted, roots first, with every level a contiguous
+// range. Entities added afterwards are appended and re-parented in place;
+// removed ones leave a dead slot. Both are folded back into sorted order by the
+// next rebuild.
+//
+// Matrices are column-major float[16], layout-compatible with glm::mat4. This
+// header deliberately has no glm/bgfx dependency so the kernels can be built
+// on their own (see benchmarks/TransformsBench.cpp).
+// -----------------------------------------------------------------------------
+class TransformStore {
+public:
+   struct alignas(16) Matrix { float m[16]; };
+
+   static constexpr int32_t kNoParent = -1;
+
+   // --- Layout -------------------------------------------------------------------
+   void Clear();
+   // Starts a new contiguous level range (rebuild only).
+   void BeginLevel() { m_LevelStart.push_back((uint32_t)m_Entity.size()); }
+   // Appends a slot. 'source' is the component mirrored by this slot (may be null).
+   uint32_t Add(EntityID id, TransformComponent* source, int32_t parentSlot = kNoParent);
+   void Remove(EntityID id);
+   void SetParent(EntityID child, EntityID parent);
+
+   int32_t SlotOf(EntityID id) const {
+      return id < m_SlotOf.size() ? m_SlotOf[id] : kNoParent;
+      }
+   size_t Size() const { return m_Entity.size(); }
+   size_t DeadCount() const { return m_Dead; }
+   // Level ranges are only meaningful right after a rebuild.
+   size_t LevelCount() const { return m_LevelStart.size(); }
+   uint32_t LevelBegin(size_t level) const { return m_LevelStart[level]; }
+   uint32_t LevelEnd(size_t level) const {
+      return level + 1 < m_LevelStart.size() ? m_LevelStart[level + 1] : m_SortedEnd;
+      }
+   void EndRebuild() { m_SortedEnd = (uint32_t)m_Entity.size(); }
+
+   EntityID EntityAt(uint32_t slot) const { return m_Entity[slot]; }
+   int32_t Parent(uint32_t slot) const { return m_Parent[slot]; }
+   TransformComponent* Source(uint32_t slot) const { return m_Source[slot]; }
+
+   // --- Data ---------------------------------------------------------------------
+   // Stages local TRS for ComposeLocal. 'quat' is x, y, z, w and need not be normalized.
+   void SetLocalTRS(uint32_t slot, const float pos[3], const float quat[4], const float scale[3]) {
+      m_PosX[slot] = pos[0];   m_PosY[slot] = pos[1];   m_PosZ[slot] = pos[2];
+      m_RotX[slot] = quat[0];  m_RotY[slot] = quat[1];  m_RotZ[slot] = quat[2];  m_RotW[slot] = quat[3];
+      m_SclX[slot] = scale[0]; m_SclY[slot] = scale[1]; m_SclZ[slot] = scale[2];
+      }
+   Matrix& Local(uint32_t slot) { return m_Local[slot]; }
+   const Matrix& World(uint32_t slot) const { return m_World[slot]; }
+
+   // --- Kernels ------------------------------------------------------------------
+   // Local = T * R * S from the staged TRS. Slots are independent; any order.
+   void ComposeLocalRange(uint32_t begin, uint32_t end);
+   void ComposeLocal(const uint32_t* slots, size_t count);
+   // World = World[parent] * Local (Local for roots). Parents must be final.
+   void ComposeWorldRange(uint32_t begin, uint32_t end);
+   void ComposeWorld(const uint32_t* slots, size_t count);
+
+   // Name of the compiled kernel flavour ("avx", "sse" or "scalar").
+   static const char* KernelName();
+
+private:
+   std::vector<EntityID> m_Entity;                 // INVALID for dead slots
+   std::vector<int32_t> m_Parent;                  // parent slot or kNoParent
+   std::vector<TransformComponent*> m_Source;
+   std::vector<float> m_PosX, m_PosY, m_PosZ;
+   std::vector<float> m_RotX, m_RotY, m_RotZ, m_RotW;
+   std::vector<float> m_SclX, m_SclY, m_SclZ;
+   std::vector<Matrix> m_Local, m_World;
+   std::vector<int32_t> m_SlotOf;                  // per EntityID
+   std::vector<uint32_t> m_LevelStart;
+   uint32_t m_SortedEnd = 0;
+   size_t m_Dead = 0;
+   };
@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iostream>
 #include <core/application.h>
+#include <physics/Physics.h>
 
 using json = nlohmann::json;
 
@@ -34,6 +35,14 @@ bool Project::Load(const std::filesystem::path& path) {
     std::string relAssetPath = j.value("assetDirectory", "assets");
     s_AssetDir = s_ProjectDir / relAssetPath;
 
+    s_PhysicsHz = 60.0f;
+    s_PhysicsMaxSubsteps = 4;
+    if (j.contains("physics") && j["physics"].is_object()) {
+        s_PhysicsHz = j["physics"].value("fixedHz", s_PhysicsHz);
+        s_PhysicsMaxSubsteps = j["physics"].value("maxSubsteps", s_PhysicsMaxSubsteps);
+    }
+    Physics::SetFixedTimestep(s_PhysicsHz, s_PhysicsMaxSubsteps);
+
     std::cout << "[Project] Loaded: " << s_ProjectName << std::endl;
     std::cout << "[Project] Root: " << s_ProjectDir << std::endl;
     std::cout << "[Project] Assets: " << s_AssetDir << std::endl;
@@ -53,6 +62,7 @@ void Project::Save() {
     j["name"] = s_ProjectName;
     j["version"] = 1;
     j["assetDirectory"] = std::filesystem::relative(s_AssetDir, s_ProjectDir).string();
+    j["physics"] = { { "fixedHz", s_PhysicsHz }, { "maxSubsteps", s_PhysicsMaxSubsteps } };
 
     std::ofstream out(s_ProjectFile);
     if (!out) {
@@ -15,6 +15,11 @@ public:
     static const std::string& GetProjectName();
     static const std::filesystem::path& GetProjectFile();
 
+    // Fixed physics step ("physics": { "fixedHz", "maxSubsteps" } in the .clayproj);
+    // applied to Physics::SetFixedTimestep on load and written to the game manifest on export
+    static float GetPhysicsHz() { return s_PhysicsHz; }
+    static int GetPhysicsMaxSubsteps() { return s_PhysicsMaxSubsteps; }
+
 	static void SetProjectDirectory(const std::filesystem::path& path) {
 		s_ProjectDir = path;
 		s_AssetDir = path / "assets"; // Default asset directory
@@ -25,4 +30,6 @@ private:
     static inline std::filesystem::path s_ProjectFile;
     static inline std::filesystem::path s_ProjectDir;
     static inline std::filesystem::path s_AssetDir;
+    static inline float s_PhysicsHz = 60.0f;
+    static inline int s_PhysicsMaxSubsteps = 4;
 };
@@ -30,6 +30,15 @@ std::string FileSystem::Normalize(const std::string& path) {
     return out;
 }
 
+std::string FileSystem::PakKey(const std::string& path) {
+    std::string key = Normalize(path);
+    auto pos = key.find("assets/");
+    if (pos == std::string::npos) pos = key.find("shaders/");
+    if (pos != std::string::npos && pos != 0) key.erase(0, pos);
+    else if (key.rfind("./", 0) == 0) key.erase(0, 2);
+    return key;
+}
+
 bool FileSystem::MountPak(const std::string& pakPath) {
     m_PakMounted = g_Pak.Open(pakPath);
     if (m_PakMounted) {
@@ -43,23 +52,12 @@ bool FileSystem::MountPak(const std::string& pakPath) {
 
 bool FileSystem::ReadFile(const std::string& path, std::vector<uint8_t>& outData) const {
     if (m_PakMounted) {
-        std::string key = Normalize(path);
-        if (g_Pak.ReadFile(key, outData)) return true;
-        // Also try to strip leading ./ or absolute prefix up to "assets/" or "shaders/"
-        auto pos = key.find("assets/");
-        if (pos != std::string::npos) {
-            std::string rel = key.substr(pos);
-            if (g_Pak.ReadFile(rel, outData)) return true;
-        }
-        pos = key.find("shaders/");
-        if (pos != std::string::npos) {
-            std::string rel = key.substr(pos);
-            if (g_Pak.ReadFile(rel, outData)) return true;
-            // If key was shaders/<name>.bin but pak used compiled folder, try that
-            if (rel.rfind("shaders/", 0) == 0 && rel.find(".bin") != std::string::npos) {
-                std::string candidate = std::string("shaders/compiled/windows/") + rel.substr(std::string("shaders/").size());
-                if (g_Pak.ReadFile(candidate, outData)) return true;
-            }
+        const std::string key = PakKey(path);
+        if (g_Pak.ReadFile(key, outData, m_Jobs)) return true;
+        // v1 paks carry no aliases for shader bins kept under the compiled folder
+        if (g_Pak.GetVersion() == 1 && key.rfind("shaders/", 0) == 0 && key.find(".bin") != std::string::npos) {
+            std::string candidate = std::string("shaders/compiled/windows/") + key.substr(std::string("shaders/").size());
+            if (g_Pak.ReadFile(candidate, outData, m_Jobs)) return true;
         }
     }
 
@@ -93,6 +91,15 @@ bool FileSystem::ReadFile(const std::string& path, std::vector<uint8_t>& outData
     return true;
 }
 
+bool FileSystem::ReadFileView(const std::string& path, const uint8_t*& outData, size_t& outSize) const {
+    if (!m_PakMounted) return false;
+    PakArchive::View view;
+    if (!g_Pak.ReadFileView(PakKey(path), view)) return false;
+    outData = view.data;
+    outSize = view.size;
+    return true;
+}
+
 bool FileSystem::ReadTextFile(const std::string& path, std::string& outText) const {
     std::vector<uint8_t> data;
     if (!ReadFile(path, data)) return false;
@@ -101,16 +108,6 @@ bool FileSystem::ReadTextFile(const std::string& path, std::string& outText) con
 }
 
 bool FileSystem::Exists(const std::string& path) const {
-    if (m_PakMounted) {
-        std::string key = Normalize(path);
-        std::vector<uint8_t> dummy;
-        if (g_Pak.Contains(key)) return true;
-        auto pos = key.find("assets/");
-        if (pos != std::string::npos && g_Pak.Contains(key.substr(pos))) return true;
-        pos = key.find("shaders/");
-        if (pos != std::string::npos && g_Pak.Contains(key.substr(pos))) return true;
-    }
+    if (m_PakMounted && g_Pak.Contains(PakKey(path))) return true;
     return std::filesystem::exists(path);
 }
-
-
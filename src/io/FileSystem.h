@@ -3,6 +3,8 @@
 #include <vector>
 #include <unordered_map>
 
+class JobSystem;
+
 class FileSystem {
 public:
     static FileSystem& Instance() {
@@ -12,13 +14,22 @@ public:
     bool MountPak(const std::string& pakPath);
     bool IsPakMounted() const { return m_PakMounted; }
 
+    // Workers used to decode compressed pak entries; null decodes on the calling thread
+    void SetJobSystem(JobSystem* js) { m_Jobs = js; }
+
     bool ReadFile(const std::string& path, std::vector<uint8_t>& outData) const;
+    // Zero-copy view of an uncompressed entry in the mounted pak. Valid while the pak
+    // stays mounted; fails for loose files and compressed entries (use ReadFile).
+    bool ReadFileView(const std::string& path, const uint8_t*& outData, size_t& outSize) const;
     bool ReadTextFile(const std::string& path, std::string& outText) const;
     bool Exists(const std::string& path) const;
 
     // Convert an absolute or project-relative path into a normalized virtual path key
     // For now we use forward slashes and collapse redundant separators.
     static std::string Normalize(const std::string& path);
+    // Key a path is stored under in a pak: normalized, and cut to start at its
+    // "assets/" or "shaders/" segment when it has one (see BuildExporter).
+    static std::string PakKey(const std::string& path);
 
 private:
     FileSystem() = default;
@@ -26,6 +37,7 @@ private:
 
     bool m_PakMounted = false;
     std::string m_PakPath;
+    JobSystem* m_Jobs = nullptr;
 };
 
 
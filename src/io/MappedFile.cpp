@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) return *this;
+    Close();
+    std::swap(m_Data, other.m_Data);
+    std::swap(m_Size, other.m_Size);
+    std::swap(m_Open, other.m_Open);
+#ifdef _WIN32
+    std::swap(m_File, other.m_File);
+    std::swap(m_Mapping, other.m_Mapping);
+#else
+    std::swap(m_Fd, other.m_Fd);
+#endif
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) { CloseHandle(file); return false; }
+    m_File = file;
+    m_Size = static_cast<size_t>(size.QuadPart);
+    m_Open = true;
+    if (m_Size == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { Close(); return false; }
+    m_Mapping = mapping;
+    m_Data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_Data) { Close(); return false; }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_Data) UnmapViewOfFile(m_Data);
+    if (m_Mapping) CloseHandle(static_cast<HANDLE>(m_Mapping));
+    if (m_File) CloseHandle(static_cast<HANDLE>(m_File));
+    m_Data = nullptr;
+    m_Mapping = nullptr;
+    m_File = nullptr;
+    m_Size = 0;
+    m_Open = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) { ::close(fd); return false; }
+    m_Fd = fd;
+    m_Size = static_cast<size_t>(st.st_size);
+    m_Open = true;
+    if (m_Size == 0) return true;
+
+    void* p = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) { Close(); return false; }
+    m_Data = static_cast<const uint8_t*>(p);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_Data) ::munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    if (m_Fd >= 0) ::close(m_Fd);
+    m_Data = nullptr;
+    m_Fd = -1;
+    m_Size = 0;
+    m_Open = false;
+}
+
+#endif
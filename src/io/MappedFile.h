@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Read-only memory mapping of a whole file. Move-only; the view stays valid until
+// Close() or destruction. Empty files open successfully with Data() == nullptr.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_Open; }
+    const uint8_t* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+
+private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+    bool m_Open = false;
+#ifdef _WIN32
+    void* m_File = nullptr;     // HANDLE
+    void* m_Mapping = nullptr;  // HANDLE
+#else
+    int m_Fd = -1;
+#endif
+};
@@ -0,0 +1,241 @@
+#include "JobSystem.h"
+
+namespace {
+
+   // Identity of the calling thread within a JobSystem (-1 = foreign thread).
+   thread_local JobSystem* t_System = nullptr;
+   thread_local int t_QueueIndex = -1;
+   thread_local uint32_t t_StealSeed = 0x9E3779B9u;
+
+   // Per-thread job recycling. Jobs are mostly created on one thread and released
+   // on another, so surplus jobs move between threads in batches through a shared
+   // pool instead of being freed and reallocated.
+   constexpr size_t kJobBatch = 256;
+
+   struct SharedJobPool {
+      std::mutex mutex;
+      std::vector<std::vector<jobs_detail::Job*>> batches;
+      ~SharedJobPool() { for (auto& b : batches) for (auto* j : b) delete j; }
+      };
+   SharedJobPool& Pool() { static SharedJobPool s_Pool; return s_Pool; }
+
+   struct JobFreeList {
+      static constexpr size_t kMaxCached = 4 * kJobBatch;
+      std::vector<jobs_detail::Job*> jobs;
+      ~JobFreeList() { for (auto* j : jobs) delete j; }
+      };
+   thread_local JobFreeList t_FreeJobs;
+
+   inline uint32_t NextSteal() {
+      // xorshift32; only used to spread thieves across victims
+      uint32_t x = t_StealSeed;
+      x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+      t_StealSeed = x;
+      return x;
+      }
+}
+
+namespace jobs_detail {
+
+Job* AllocJob() {
+   auto& fl = t_FreeJobs.jobs;
+   if (fl.empty()) {
+      SharedJobPool& pool = Pool();
+      std::lock_guard<std::mutex> lk(pool.mutex);
+      if (!pool.batches.empty()) {
+         fl.swap(pool.batches.back());
+         pool.batches.pop_back();
+         }
+      }
+   if (!fl.empty()) {
+      Job* j = fl.back();
+      fl.pop_back();
+      return j;
+      }
+   return new Job();
+   }
+
+void ReleaseJob(Job* job) {
+   if (job->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+   auto& fl = t_FreeJobs.jobs;
+   fl.push_back(job);
+   if (fl.size() < JobFreeList::kMaxCached) return;
+   // Hand the oldest batch to the shared pool, for threads that create more jobs than they release
+   std::vector<Job*> batch(fl.begin(), fl.begin() + kJobBatch);
+   fl.erase(fl.begin(), fl.begin() + kJobBatch);
+   SharedJobPool& pool = Pool();
+   std::lock_guard<std::mutex> lk(pool.mutex);
+   pool.batches.push_back(std::move(batch));
+   }
+
+} // namespace jobs_detail
+
+using jobs_detail::Job;
+
+JobSystem::JobSystem(size_t threads) {
+   const size_t n = threads ? threads : 1;
+   m_Queues.reserve(n + 1);
+   for (size_t i = 0; i < n + 1; ++i)
+      m_Queues.emplace_back(std::make_unique<jobs_detail::WorkStealingDeque>());
+
+   // The constructing thread owns queue 0.
+   t_System = this;
+   t_QueueIndex = 0;
+
+   m_BackgroundLimit = (n > 1) ? int32_t(n - 1) : 1;
+
+   m_Workers.reserve(n);
+   for (size_t i = 0; i < n; ++i)
+      m_Workers.emplace_back([this, i] { WorkerLoop(static_cast<int>(i + 1)); });
+   }
+
+JobSystem::~JobSystem() {
+   m_Stopping.store(true, std::memory_order_seq_cst);
+      {
+      std::lock_guard<std::mutex> lk(m_SleepMutex);
+      m_SleepCv.notify_all();
+      }
+   for (auto& t : m_Workers) if (t.joinable()) t.join();
+   m_Workers.clear();
+
+   // Leftover jobs are dropped (not run) but still completed, so parents and
+   // handles observe a consistent state and nothing leaks.
+   for (auto& q : m_Queues)
+      while (Job* j = q->Steal()) { j->destroy(j); Finish(j); }
+   for (Job* j : m_Inject) { j->destroy(j); Finish(j); }
+   m_Inject.clear();
+   for (Job* j : m_Background) { j->destroy(j); Finish(j); }
+   m_Background.clear();
+
+   if (t_System == this) { t_System = nullptr; t_QueueIndex = -1; }
+   }
+
+int JobSystem::LocalQueueIndex() const {
+   return (t_System == this) ? t_QueueIndex : -1;
+   }
+
+void JobSystem::Submit(Job* j) {
+   const int q = LocalQueueIndex();
+   if (q >= 0) m_Queues[q]->Push(j);
+   else {
+      std::lock_guard<std::mutex> lk(m_InjectMutex);
+      m_Inject.push_back(j);
+      }
+   m_Queued.fetch_add(1, std::memory_order_seq_cst);
+   WakeOne();
+   }
+
+void JobSystem::WakeOne() {
+   if (m_Sleepers.load(std::memory_order_seq_cst) == 0) return;
+   std::lock_guard<std::mutex> lk(m_SleepMutex);
+   m_SleepCv.notify_one();
+   }
+
+Job* JobSystem::FindJob(int self, bool steal) {
+   Job* j = nullptr;
+   if (self >= 0) j = m_Queues[self]->Pop();
+
+   if (!j && steal && m_Queued.load(std::memory_order_relaxed) > 0) {
+      const size_t n = m_Queues.size();
+      const size_t start = NextSteal() % n;
+      for (size_t i = 0; i < n && !j; ++i) {
+         const size_t victim = (start + i) % n;
+         if ((int)victim == self) continue;
+         j = m_Queues[victim]->Steal();
+         }
+      if (!j) {
+         std::lock_guard<std::mutex> lk(m_InjectMutex);
+         if (!m_Inject.empty()) {
+            j = m_Inject.front();
+            m_Inject.pop_front();
+            }
+         }
+      }
+
+   if (j) m_Queued.fetch_sub(1, std::memory_order_seq_cst);
+   return j;
+   }
+
+bool JobSystem::BackgroundReady() const {
+   return m_BackgroundQueued.load(std::memory_order_seq_cst) > 0
+      && m_BackgroundRunning.load(std::memory_order_relaxed) < m_BackgroundLimit;
+   }
+
+Job* JobSystem::TakeBackground() {
+   if (!BackgroundReady()) return nullptr;
+   std::lock_guard<std::mutex> lk(m_BackgroundMutex);
+   if (m_Background.empty() || m_BackgroundRunning.load(std::memory_order_relaxed) >= m_BackgroundLimit) return nullptr;
+   Job* j = m_Background.front();
+   m_Background.pop_front();
+   m_BackgroundRunning.fetch_add(1, std::memory_order_relaxed);
+   m_BackgroundQueued.fetch_sub(1, std::memory_order_seq_cst);
+   return j;
+   }
+
+void JobSystem::ExecuteBackground(Job* j) {
+   Execute(j);
+   m_BackgroundRunning.fetch_sub(1, std::memory_order_seq_cst);
+   // A slot opened: another worker may have gone to sleep with background work queued
+   if (m_BackgroundQueued.load(std::memory_order_seq_cst) > 0) WakeOne();
+   }
+
+void JobSystem::Execute(Job* j) {
+   // Never let exceptions escape the worker thread.
+   try { j->invoke(j); }
+   catch (...) {}
+   j->destroy(j);
+   Finish(j);
+   }
+
+void JobSystem::Finish(Job* j) {
+   while (j) {
+      if (j->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+      Job* parent = j->parent;
+      jobs_detail::ReleaseJob(j); // scheduler reference
+      j = parent;
+      }
+   }
+
+bool JobSystem::TryRunOne() {
+   if (Job* j = FindJob(LocalQueueIndex(), true)) { Execute(j); return true; }
+   if (Job* j = TakeBackground()) { ExecuteBackground(j); return true; }
+   return false;
+   }
+
+void JobSystem::Wait(const JobHandle& h) {
+   // The main thread only helps with its own jobs; workers (possibly inside a
+   // background job) help with any frame job. Nobody takes background work here.
+   const int self = LocalQueueIndex();
+   const bool steal = self != 0;
+   while (!h.IsDone()) {
+      if (Job* j = FindJob(self, steal)) Execute(j);
+      else std::this_thread::yield();
+      }
+   }
+
+void JobSystem::WorkerLoop(int index) {
+   t_System = this;
+   t_QueueIndex = index;
+   t_StealSeed ^= static_cast<uint32_t>(index) * 0x85EBCA6Bu;
+
+   constexpr int kSpinRounds = 64;
+   while (!m_Stopping.load(std::memory_order_acquire)) {
+      if (Job* j = FindJob(index, true)) { Execute(j); continue; }
+      // Background work only when no frame job is pending
+      if (Job* j = TakeBackground()) { ExecuteBackground(j); continue; }
+
+      bool work = false;
+      for (int spin = 0; !work && spin < kSpinRounds; ++spin) {
+         std::this_thread::yield();
+         work = m_Queued.load(std::memory_order_relaxed) > 0 || BackgroundReady();
+         }
+      if (work) continue;
+
+      std::unique_lock<std::mutex> lk(m_SleepMutex);
+      m_Sleepers.fetch_add(1, std::memory_order_seq_cst);
+      m_SleepCv.wait(lk, [this] {
+         return m_Stopping.load(std::memory_order_acquire) || m_Queued.load(std::memory_order_seq_cst) > 0 || BackgroundReady();
+         });
+      m_Sleepers.fetch_sub(1, std::memory_order_seq_cst);
+      }
+   }
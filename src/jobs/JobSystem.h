@@ -4,71 +4,280 @@
 #include <deque>
 #include <mutex>
 #include <condition_variable>
-#include <functional>
 #include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
 
-class JobSystem {
-public:
-   explicit JobSystem(size_t threads =
-      std::max(1u, std::thread::hardware_concurrency()))
-      {
-      start(threads ? threads : 1);
+// -----------------------------------------------------------------------------
+// Work-stealing job scheduler.
+//
+// Every worker owns a fixed-size Chase-Lev deque: the owner pushes/pops at the
+// bottom (LIFO, cache friendly), idle workers steal from the top (FIFO). The
+// thread that constructs the JobSystem (the main thread) owns a deque as well,
+// so jobs it schedules never touch a lock. Other threads submit through a small
+// mutex-protected injection queue.
+//
+// Long work (streaming, scene staging, asset loads and imports) goes through
+// EnqueueBackground instead: a separate lane that only idle workers take, and at
+// most WorkerCount() - 1 of them at a time (one with a single worker), so frame
+// work always finds a free worker.
+//
+// Jobs store their callable inline (small-buffer, no std::function) and are
+// recycled through per-thread free lists, which trade surplus jobs in batches
+// through a shared pool (jobs are usually created on one thread and finished on
+// another). A job may have a parent: the parent
+// is not considered finished until all of its children have finished, which is
+// how groups (e.g. parallel_for) are expressed. Wait() never sleeps; the
+// waiting thread executes pending jobs until the awaited one completes. It never
+// picks up background jobs, and the main thread only runs jobs from its own
+// deque (the ones it scheduled, e.g. its parallel_for helpers), so a frame-time
+// wait cannot end up inside a decode or an import that a worker spawned.
+// -----------------------------------------------------------------------------
+
+namespace jobs_detail {
+
+struct alignas(64) Job {
+   static constexpr size_t kInlineBytes = 96;
+
+   void (*invoke)(Job*) = nullptr;   // run the stored callable
+   void (*destroy)(Job*) = nullptr;  // destroy the stored callable
+   Job* parent = nullptr;
+   std::atomic<int32_t> unfinished{ 0 }; // self + live children
+   std::atomic<int32_t> refs{ 0 };       // scheduler + outstanding handles
+   alignas(std::max_align_t) unsigned char storage[kInlineBytes];
+
+   template<class F>
+   void Bind(F&& fn) {
+      using T = std::decay_t<F>;
+      if constexpr (sizeof(T) <= kInlineBytes && alignof(T) <= alignof(std::max_align_t)) {
+         ::new (static_cast<void*>(storage)) T(std::forward<F>(fn));
+         invoke = [](Job* j) { (*std::launder(reinterpret_cast<T*>(j->storage)))(); };
+         destroy = [](Job* j) { std::launder(reinterpret_cast<T*>(j->storage))->~T(); };
+         }
+      else {
+         // Oversized captures spill to the heap; the pointer lives in the inline buffer.
+         T* heap = new T(std::forward<F>(fn));
+         std::memcpy(storage, &heap, sizeof(heap));
+         invoke = [](Job* j) { T* p; std::memcpy(&p, j->storage, sizeof(p)); (*p)(); };
+         destroy = [](Job* j) { T* p; std::memcpy(&p, j->storage, sizeof(p)); delete p; };
+         }
       }
+   };
 
-   ~JobSystem() { stop(); }
+// Single-owner / multi-thief deque (Chase-Lev, Le et al. 2013). The ring grows
+// when full; replaced rings stay alive until the deque is destroyed, because a
+// thief may still be reading one.
+class WorkStealingDeque {
+public:
+   static constexpr int64_t kInitialCapacity = 4096; // power of two
 
-   // Queue a job; returns false if system is stopping.
-   bool Enqueue(std::function<void()> job) {
-         {
-         std::lock_guard<std::mutex> lk(m_);
-         if (stopping_) return false;
-         q_.push_back(std::move(job));
+   WorkStealingDeque() { m_Ring.store(NewRing(kInitialCapacity), std::memory_order_relaxed); }
+   WorkStealingDeque(const WorkStealingDeque&) = delete;
+   WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+   void Push(Job* job) {
+      const int64_t b = m_Bottom.load(std::memory_order_relaxed);
+      const int64_t t = m_Top.load(std::memory_order_acquire);
+      Ring* r = m_Ring.load(std::memory_order_relaxed);
+      if (b - t >= r->capacity) r = Grow(r, t, b);
+      r->At(b).store(job, std::memory_order_relaxed);
+      m_Bottom.store(b + 1, std::memory_order_release); // publishes the slot to thieves
+      }
+
+   Job* Pop() {
+      const int64_t b = m_Bottom.load(std::memory_order_relaxed) - 1;
+      Ring* r = m_Ring.load(std::memory_order_relaxed);
+      m_Bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = m_Top.load(std::memory_order_relaxed);
+      if (t > b) {
+         m_Bottom.store(b + 1, std::memory_order_relaxed);
+         return nullptr;
+         }
+      Job* job = r->At(b).load(std::memory_order_relaxed);
+      if (t == b) {
+         // Last element: race against thieves for it.
+         if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            job = nullptr;
+         m_Bottom.store(b + 1, std::memory_order_relaxed);
          }
-         cv_.notify_one();
-         return true;
+      return job;
+      }
+
+   Job* Steal() {
+      int64_t t = m_Top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const int64_t b = m_Bottom.load(std::memory_order_acquire);
+      if (t >= b) return nullptr;
+      Ring* r = m_Ring.load(std::memory_order_acquire);
+      Job* job = r->At(t).load(std::memory_order_relaxed);
+      if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+         return nullptr;
+      return job;
       }
 
 private:
-   void start(size_t n) {
-      stopping_ = false;
-      workers_.reserve(n);
-      for (size_t i = 0; i < n; ++i) {
-         workers_.emplace_back([this] {
-            for (;;) {
-               std::function<void()> job;
-               {
-               std::unique_lock<std::mutex> lk(m_);
-               cv_.wait(lk, [this] { return stopping_ || !q_.empty(); });
-               if (stopping_ && q_.empty()) return;
-               job = std::move(q_.front());
-               q_.pop_front();
-               }
-               // Never let exceptions escape the worker thread.
-               try { job(); }
-               catch (...) {
-#ifdef _MSC_VER
-                  //OutputDebugStringA("[JobSystem] Unhandled job exception swallowed in worker.\n");
-#endif
-                  }
-               }
-            });
-         }
+   struct Ring {
+      int64_t capacity;
+      std::unique_ptr<std::atomic<Job*>[]> slots;
+      std::atomic<Job*>& At(int64_t i) { return slots[i & (capacity - 1)]; }
+      };
+
+   Ring* NewRing(int64_t capacity) {
+      m_Rings.push_back(std::make_unique<Ring>(Ring{ capacity, std::make_unique<std::atomic<Job*>[]>(size_t(capacity)) }));
+      return m_Rings.back().get();
+      }
+
+   Ring* Grow(Ring* old, int64_t t, int64_t b) {
+      Ring* r = NewRing(old->capacity * 2);
+      for (int64_t i = t; i < b; ++i) r->At(i).store(old->At(i).load(std::memory_order_relaxed), std::memory_order_relaxed);
+      m_Ring.store(r, std::memory_order_release);
+      return r;
+      }
+
+   alignas(64) std::atomic<int64_t> m_Top{ 0 };
+   alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+   alignas(64) std::atomic<Ring*> m_Ring{ nullptr };
+   std::vector<std::unique_ptr<Ring>> m_Rings;  // owner only; current ring is the last
+   };
+
+Job* AllocJob();
+void ReleaseJob(Job* job); // drops one reference; recycles on zero
+
+} // namespace jobs_detail
+
+// Reference-counted handle to a scheduled (or created, not yet run) job.
+class JobHandle {
+public:
+   JobHandle() = default;
+   JobHandle(const JobHandle& o) : m_Job(o.m_Job) { if (m_Job) m_Job->refs.fetch_add(1, std::memory_order_relaxed); }
+   JobHandle(JobHandle&& o) noexcept : m_Job(o.m_Job) { o.m_Job = nullptr; }
+   JobHandle& operator=(JobHandle o) noexcept { std::swap(m_Job, o.m_Job); return *this; }
+   ~JobHandle() { if (m_Job) jobs_detail::ReleaseJob(m_Job); }
+
+   bool IsValid() const { return m_Job != nullptr; }
+   // True once the job and all of its children have run.
+   bool IsDone() const { return !m_Job || m_Job->unfinished.load(std::memory_order_acquire) == 0; }
+
+private:
+   friend class JobSystem;
+   explicit JobHandle(jobs_detail::Job* j) : m_Job(j) {}
+   jobs_detail::Job* m_Job = nullptr;
+   };
+
+class JobSystem {
+public:
+   explicit JobSystem(size_t threads =
+      std::max(1u, std::thread::hardware_concurrency()));
+   ~JobSystem();
+
+   JobSystem(const JobSystem&) = delete;
+   JobSystem& operator=(const JobSystem&) = delete;
+
+   // Fire-and-forget; returns false if the system is stopping.
+   template<class F>
+   bool Enqueue(F&& fn) {
+      if (m_Stopping.load(std::memory_order_acquire)) return false;
+      jobs_detail::Job* j = Make(nullptr, std::forward<F>(fn));
+      Submit(j);
+      return true;
       }
 
-   void stop() {
+   // Fire-and-forget on the background lane, for work that may take longer than a
+   // frame; never run by Wait(). Returns false if the system is stopping.
+   template<class F>
+   bool EnqueueBackground(F&& fn) {
+      if (m_Stopping.load(std::memory_order_acquire)) return false;
+      jobs_detail::Job* j = Make(nullptr, std::forward<F>(fn));
          {
-         std::lock_guard<std::mutex> lk(m_);
-         stopping_ = true;
+         std::lock_guard<std::mutex> lk(m_BackgroundMutex);
+         m_Background.push_back(j);
          }
-         cv_.notify_all();
-         for (auto& t : workers_) if (t.joinable()) t.join();
-         workers_.clear();
-         // Any leftover queued jobs are dropped on shutdown (by design).
+      m_BackgroundQueued.fetch_add(1, std::memory_order_seq_cst);
+      WakeOne();
+      return true;
+      }
+
+   // Create a job without running it. Children may be attached before Run().
+   template<class F>
+   JobHandle Create(F&& fn) {
+      jobs_detail::Job* j = Make(nullptr, std::forward<F>(fn));
+      j->refs.fetch_add(1, std::memory_order_relaxed);
+      return JobHandle(j);
+      }
+
+   // Create a child of 'parent': the parent only completes once this job has run.
+   template<class F>
+   JobHandle CreateChild(const JobHandle& parent, F&& fn) {
+      jobs_detail::Job* j = Make(parent.m_Job, std::forward<F>(fn));
+      j->refs.fetch_add(1, std::memory_order_relaxed);
+      return JobHandle(j);
+      }
+
+   // Submit a job previously returned by Create/CreateChild. Call once per job.
+   void Run(const JobHandle& h) { if (h.m_Job) Submit(h.m_Job); }
+
+   template<class F>
+   JobHandle Schedule(F&& fn) { JobHandle h = Create(std::forward<F>(fn)); Run(h); return h; }
+
+   template<class F>
+   JobHandle ScheduleChild(const JobHandle& parent, F&& fn) { JobHandle h = CreateChild(parent, std::forward<F>(fn)); Run(h); return h; }
+
+   // Block until 'h' (and its children) completed, executing other frame jobs meanwhile
+   // (on the main thread: only its own).
+   void Wait(const JobHandle& h);
+
+   // Execute at most one pending job on the calling thread, background ones included
+   // (for explicit pumping, e.g. a blocking import). Returns false if none was found.
+   bool TryRunOne();
+
+   size_t WorkerCount() const { return m_Workers.size(); }
+
+private:
+   template<class F>
+   jobs_detail::Job* Make(jobs_detail::Job* parent, F&& fn) {
+      jobs_detail::Job* j = jobs_detail::AllocJob();
+      j->Bind(std::forward<F>(fn));
+      j->parent = parent;
+      j->unfinished.store(1, std::memory_order_relaxed);
+      j->refs.store(1, std::memory_order_relaxed); // scheduler reference
+      if (parent) parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+      return j;
       }
 
-   std::vector<std::thread> workers_;
-   std::deque<std::function<void()>> q_;
-   std::mutex m_;
-   std::condition_variable cv_;
-   bool stopping_{ false };
+   void Submit(jobs_detail::Job* j);
+   jobs_detail::Job* FindJob(int self, bool steal);
+   jobs_detail::Job* TakeBackground();
+   bool BackgroundReady() const;
+   void ExecuteBackground(jobs_detail::Job* j);
+   void Execute(jobs_detail::Job* j);
+   void Finish(jobs_detail::Job* j);
+   void WorkerLoop(int index);
+   void WakeOne();
+   int  LocalQueueIndex() const;
+
+   // m_Queues[0] belongs to the constructing thread, [1..N] to the workers.
+   std::vector<std::unique_ptr<jobs_detail::WorkStealingDeque>> m_Queues;
+   std::vector<std::thread> m_Workers;
+
+   std::mutex m_InjectMutex;
+   std::deque<jobs_detail::Job*> m_Inject; // submissions from foreign threads / deque overflow
+
+   std::mutex m_SleepMutex;
+   std::condition_variable m_SleepCv;
+   std::mutex m_BackgroundMutex;
+   std::deque<jobs_detail::Job*> m_Background; // EnqueueBackground, FIFO
+   std::atomic<int32_t> m_BackgroundQueued{ 0 };
+   std::atomic<int32_t> m_BackgroundRunning{ 0 };
+   int32_t m_BackgroundLimit = 1;        // workers that may run background jobs at once
+
+   std::atomic<int64_t> m_Queued{ 0 };   // frame jobs submitted but not yet taken
+   std::atomic<int32_t> m_Sleepers{ 0 };
+   std::atomic<bool> m_Stopping{ false };
    };
@@ -1,6 +1,56 @@
 #include "core/Application.h"
+#include "editor/Project.h"
+#include "jobs/JobSystem.h"
+#include "pipeline/AssetPipeline.h"
+#include "serialization/SceneBinary.h"
+#include "serialization/Serializer.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    // Batch mode: claymore --warm-cache [projectDir]
+    // Fills the project's derived-data cache without opening a window, so the editor
+    // opens after a checkout or branch switch without re-importing unchanged assets.
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--warm-cache") != 0) continue;
+        std::filesystem::path projectDir = (i + 1 < argc) ? std::filesystem::path(argv[i + 1]) : std::filesystem::current_path();
+        Project::SetProjectDirectory(std::filesystem::weakly_canonical(projectDir));
+        JobSystem js;
+        size_t failed = AssetPipeline::Instance().WarmCache(Project::GetProjectDirectory().string(), js);
+        return failed == 0 ? 0 : 1;
+    }
+
+    // Batch mode: claymore --convert-scene <in> [out] [--json | --binary]
+    // Converts a scene or prefab between JSON and the binary encoding. Without a flag
+    // the file is flipped to the other format; without 'out' it is rewritten in place.
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--convert-scene") != 0) continue;
+        std::vector<std::string> paths;
+        const char* forced = nullptr;
+        for (int j = i + 1; j < argc; ++j) {
+            if (std::strcmp(argv[j], "--json") == 0 || std::strcmp(argv[j], "--binary") == 0) forced = argv[j];
+            else paths.push_back(argv[j]);
+        }
+        if (paths.empty() || paths.size() > 2) {
+            std::cerr << "usage: claymore --convert-scene <in> [out] [--json | --binary]" << std::endl;
+            return 2;
+        }
+        Serializer::SceneFormat format;
+        if (forced) {
+            format = std::strcmp(forced, "--binary") == 0 ? Serializer::SceneFormat::Binary : Serializer::SceneFormat::Json;
+        } else {
+            uint8_t head[sizeof(scenebin::Header)] = {};
+            std::ifstream in(paths[0], std::ios::binary);
+            in.read(reinterpret_cast<char*>(head), sizeof(head));
+            format = scenebin::IsSceneBinary(head, size_t(in.gcount())) ? Serializer::SceneFormat::Json : Serializer::SceneFormat::Binary;
+        }
+        return Serializer::ConvertSceneFile(paths[0], paths.size() > 1 ? paths[1] : paths[0], format) ? 0 : 1;
+    }
 
-int main() {
     Application app(1920, 1080, "Claymore Engine");
     app.Run();
     return 0;
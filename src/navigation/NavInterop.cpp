@@ -70,7 +70,10 @@ static void Nav_Agent_Stop_Native(EntityID agentEntity)
 static void Nav_Agent_Warp_Native(EntityID agentEntity, glm::vec3 pos)
 {
     if (auto* d = Scene::Get().GetEntityData(agentEntity)) {
-        if (d->NavAgent) d->NavAgent->Warp(pos, &d->Transform, &Physics::Get(), d->RigidBody.get());
+        if (d->NavAgent) {
+            d->NavAgent->Warp(pos, &d->Transform, &Physics::Get(), d->RigidBody.get());
+            Scene::Get().MarkTransformDirty(agentEntity);
+        }
     }
 }
 
@@ -2,6 +2,8 @@
 #include "navigation/NavMesh.h"
 #include "ecs/Scene.h"
 #include "ecs/Components.h"
+#include "ecs/AnimationComponents.h"
+#include "ecs/CpuSkinning.h"
 #include <algorithm>
 
 using namespace nav;
@@ -16,7 +18,18 @@ bool nav::bake::BuildFromScene(Scene& scene, const NavMeshComponent& comp, NavMe
         const Mesh& m = *d->Mesh->mesh; const glm::mat4& M = d->Transform.WorldMatrix;
         uint32_t base = (uint32_t)out.vertices.size();
         out.vertices.reserve(out.vertices.size() + m.Vertices.size());
-        for (const auto& v : m.Vertices) { glm::vec3 w = glm::vec3(M * glm::vec4(v,1)); out.vertices.push_back(w); out.bounds.expand(w); }
+        // Skinned meshes bake in their current pose: SkinningSystem's CPU-skinned one, else
+        // skinned here with the last palette (no palette yet: bind pose)
+        const SkinningComponent* skin = d->Skinning.get();
+        const std::vector<glm::vec3>* verts = &m.Vertices;
+        SkinningComponent posed;
+        if (HasCpuSkinnedPose(skin, m)) verts = &skin->SkinnedPositions;
+        else if (skin && m.HasSkinning() && !skin->Palette.empty()) {
+            posed.Palette = skin->Palette;
+            CpuSkinMesh(m, d->BlendShapes.get(), posed);
+            if (HasCpuSkinnedPose(&posed, m)) verts = &posed.SkinnedPositions;
+        }
+        for (const auto& v : *verts) { glm::vec3 w = glm::vec3(M * glm::vec4(v,1)); out.vertices.push_back(w); out.bounds.expand(w); }
         for (size_t i = 0; i + 2 < m.Indices.size(); i += 3) { out.indices.push_back(base + m.Indices[i+0]); out.indices.push_back(base + m.Indices[i+1]); out.indices.push_back(base + m.Indices[i+2]); }
     }
     return !out.vertices.empty() && !out.indices.empty();
@@ -49,25 +49,23 @@ bool Navigation::NearestPoint(Scene& scene, uint32_t navMeshEntity, const glm::v
 void Navigation::Update(Scene& scene, float dt)
 {
     // Iterate agents, compute steering along paths
-    for (const auto& e : scene.GetEntities()) {
-        auto* d = scene.GetEntityData(e.GetID()); if (!d) continue;
-        if (!d->NavAgent || !d->NavAgent->Enabled) continue;
-        NavAgentComponent& agent = *d->NavAgent;
+    for (auto [agentId, entity, agent] : scene.View<EntityData, NavAgentComponent>()) {
+        if (!agent.Enabled) continue;
+        auto* d = &entity;
         ::TransformComponent& tr = d->Transform;
 
         // Auto-bind to nearest/only NavMesh if none set
         if (agent.NavMeshEntity == 0) {
             float bestDist2 = FLT_MAX; EntityID best = 0; int count = 0;
             glm::vec3 p = glm::vec3(tr.WorldMatrix[3]);
-            for (const auto& e2 : scene.GetEntities()) {
-                auto* d2 = scene.GetEntityData(e2.GetID()); if (!d2 || !d2->Navigation) continue;
+            for (auto [meshId, surface] : scene.View<NavMeshComponent>()) {
                 count++;
                 // Prefer the first if only one exists
-                if (count == 1) best = e2.GetID();
+                if (count == 1) best = meshId;
                 // If runtime bounds available, pick nearest by AABB center
-                glm::vec3 c = (d2->Navigation->AABB.min + d2->Navigation->AABB.max) * 0.5f;
+                glm::vec3 c = (surface.AABB.min + surface.AABB.max) * 0.5f;
                 float dsq = glm::distance2(p, c);
-                if (dsq < bestDist2) { bestDist2 = dsq; best = e2.GetID(); }
+                if (dsq < bestDist2) { bestDist2 = dsq; best = meshId; }
             }
             if (best != 0) agent.NavMeshEntity = best;
         }
@@ -121,7 +119,7 @@ void Navigation::Update(Scene& scene, float dt)
                 ::Physics::Get().SetBodyLinearVelocity(d->RigidBody->BodyID, vel);
             }
         } else {
-            tr.Position += vel * dt; tr.TransformDirty = true;
+            tr.Position += vel * dt; scene.MarkTransformDirty(agentId);
         }
 
         // debug draw
@@ -131,9 +129,7 @@ void Navigation::Update(Scene& scene, float dt)
 
     // Draw navmesh runtime when debug is enabled (editor only)
     if (!scene.m_IsPlaying && (uint32_t)m_DebugMask != 0) {
-        for (const auto& e : scene.GetEntities()) {
-            auto* d = scene.GetEntityData(e.GetID()); if (!d || !d->Navigation) continue;
-            auto& comp = *d->Navigation;
+        for (auto [meshId, comp] : scene.View<NavMeshComponent>()) {
             if (comp.Runtime || comp.EnsureRuntimeLoaded()) {
                 debug::DrawRuntime(*comp.Runtime, 0);
             }
@@ -5,6 +5,9 @@
 #include <Jolt/Math/Mat44.h>
 #include <glm/gtc/type_ptr.hpp> // for glm::value_ptr
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <algorithm>
+#include <cmath>
 
 // ---- Layer Definitions ----
 static const JPH::ObjectLayer OBJECT_LAYER_NON_MOVING = 0;
@@ -21,6 +24,19 @@ BroadPhaseLayerInterfaceImpl* Physics::s_BroadPhaseInterface = nullptr;
 ObjectVsBroadPhaseLayerFilterImpl* Physics::s_ObjectVsBroadPhaseFilter = nullptr;
 ObjectLayerPairFilterImpl* Physics::s_ObjectLayerPairFilter = nullptr;
 
+// Fixed-step state
+float Physics::s_FixedDeltaTime = 1.0f / 60.0f;
+int Physics::s_MaxSubsteps = 4;
+float Physics::s_Accumulator = 0.0f;
+float Physics::s_InterpolationAlpha = 0.0f;
+std::vector<PhysicsBodyState> Physics::s_BodyStates;
+JPH::BodyIDVector Physics::s_ActiveBodies;
+
+// Sized for scenes with 5k+ dynamic bodies
+static constexpr JPH::uint kMaxBodies = 65536;
+static constexpr JPH::uint kMaxBodyPairs = 65536;
+static constexpr JPH::uint kMaxContactConstraints = 32768;
+
 
 class ObjectLayerPairFilterImpl : public JPH::ObjectLayerPairFilter {
 public:
@@ -73,7 +89,7 @@ void Physics::Init() {
     JPH::Factory::sInstance = new JPH::Factory();
     JPH::RegisterTypes();
 
-    s_TempAllocator = new JPH::TempAllocatorImpl(10 * 1024 * 1024);
+    s_TempAllocator = new JPH::TempAllocatorImpl(32 * 1024 * 1024);
     s_JobSystem = new JPH::JobSystemThreadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, JPH::thread::hardware_concurrency() - 1);
 
     s_BroadPhaseInterface = new BroadPhaseLayerInterfaceImpl();
@@ -82,7 +98,7 @@ void Physics::Init() {
 
     s_PhysicsSystem = new JPH::PhysicsSystem();
     s_PhysicsSystem->Init(
-        1024, 0, 1024, 1024,
+        kMaxBodies, 0, kMaxBodyPairs, kMaxContactConstraints,
         *s_BroadPhaseInterface,
         *s_ObjectVsBroadPhaseFilter,
         *s_ObjectLayerPairFilter
@@ -107,6 +123,83 @@ void Physics::Step(float deltaTime) {
     s_PhysicsSystem->Update(deltaTime, 1, s_TempAllocator, s_JobSystem);
 }
 
+void Physics::SetFixedTimestep(float hz, int maxSubsteps) {
+    s_FixedDeltaTime = 1.0f / std::max(hz, 1.0f);
+    s_MaxSubsteps = std::max(maxSubsteps, 1);
+}
+
+void Physics::ResetFixedStep() {
+    s_Accumulator = 0.0f;
+    s_InterpolationAlpha = 0.0f;
+    s_BodyStates.clear();
+}
+
+int Physics::Advance(float frameDelta) {
+    if (!s_PhysicsSystem) return 0;
+
+    s_Accumulator += std::max(frameDelta, 0.0f);
+    const int steps = std::min(int(s_Accumulator / s_FixedDeltaTime), s_MaxSubsteps);
+    for (int i = 0; i < steps; ++i) {
+        if (i == steps - 1) CaptureBodyStates(true);
+        Step(s_FixedDeltaTime);
+        s_Accumulator -= s_FixedDeltaTime;
+    }
+    if (steps > 0) CaptureBodyStates(false);
+
+    // More than maxSubsteps behind: drop the backlog instead of spiralling
+    if (s_Accumulator >= s_FixedDeltaTime) s_Accumulator = std::fmod(s_Accumulator, s_FixedDeltaTime);
+    s_Accumulator = std::max(s_Accumulator, 0.0f);
+    s_InterpolationAlpha = s_Accumulator / s_FixedDeltaTime;
+    return steps;
+}
+
+// previous == true: rebuild the list from the active dynamic bodies and fill both
+// states; otherwise refresh the current state of the bodies already listed, so both
+// halves of every entry describe the same body.
+void Physics::CaptureBodyStates(bool previous) {
+    const JPH::BodyLockInterfaceNoLock& locks = s_PhysicsSystem->GetBodyLockInterfaceNoLock();
+
+    if (previous) {
+        s_ActiveBodies.clear();
+        s_PhysicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, s_ActiveBodies);
+        s_BodyStates.clear();
+        s_BodyStates.reserve(s_ActiveBodies.size());
+        for (const JPH::BodyID& id : s_ActiveBodies) {
+            JPH::BodyLockRead lock(locks, id);
+            if (!lock.Succeeded() || !lock.GetBody().IsDynamic()) continue;
+            const JPH::Body& body = lock.GetBody();
+            const JPH::RVec3 p = body.GetPosition();
+            const JPH::Quat q = body.GetRotation();
+            PhysicsBodyState& s = s_BodyStates.emplace_back();
+            s.Body = id;
+            s.UserData = body.GetUserData();
+            s.Position = s.PrevPosition = glm::vec3(float(p.GetX()), float(p.GetY()), float(p.GetZ()));
+            s.Rotation = s.PrevRotation = glm::quat(q.GetW(), q.GetX(), q.GetY(), q.GetZ());
+        }
+        return;
+    }
+
+    for (PhysicsBodyState& s : s_BodyStates) {
+        JPH::BodyLockRead lock(locks, s.Body);
+        if (!lock.Succeeded()) continue;
+        const JPH::RVec3 p = lock.GetBody().GetPosition();
+        const JPH::Quat q = lock.GetBody().GetRotation();
+        s.Position = glm::vec3(float(p.GetX()), float(p.GetY()), float(p.GetZ()));
+        s.Rotation = glm::quat(q.GetW(), q.GetX(), q.GetY(), q.GetZ());
+    }
+}
+
+void Physics::SetKinematicVelocities(const KinematicVelocity* velocities, size_t count) {
+    if (!s_PhysicsSystem) return;
+    JPH::BodyInterface& bi = s_PhysicsSystem->GetBodyInterfaceNoLock();
+    for (size_t i = 0; i < count; ++i) {
+        const KinematicVelocity& v = velocities[i];
+        bi.SetLinearAndAngularVelocity(v.Body,
+            JPH::Vec3(v.Linear.x, v.Linear.y, v.Linear.z),
+            JPH::Vec3(v.Angular.x, v.Angular.y, v.Angular.z));
+    }
+}
+
 glm::vec3 Physics::GetGravity() {
     if (!s_PhysicsSystem) return glm::vec3(0.0f, -9.81f, 0.0f);
     JPH::Vec3 gravity = s_PhysicsSystem->GetGravity();
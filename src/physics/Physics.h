@@ -9,12 +9,14 @@
 #include <Jolt/Physics/Body/BodyInterface.h>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
 #include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
 #include <Jolt/Physics/Collision/Shape/MeshShape.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 enum class ColliderShape {
     Box,
@@ -22,6 +24,23 @@ enum class ColliderShape {
     Mesh
 };
 
+// Dynamic body as of the last two fixed steps. UserData is the owning EntityID
+// (BodyCreationSettings::mUserData, set by Scene::CreatePhysicsBody).
+struct PhysicsBodyState {
+    JPH::BodyID Body;
+    uint64_t UserData = 0;
+    glm::vec3 PrevPosition{ 0.0f };
+    glm::vec3 Position{ 0.0f };
+    glm::quat PrevRotation{ 1, 0, 0, 0 };
+    glm::quat Rotation{ 1, 0, 0, 0 };
+};
+
+struct KinematicVelocity {
+    JPH::BodyID Body;
+    glm::vec3 Linear{ 0.0f };
+    glm::vec3 Angular{ 0.0f };
+};
+
 class Physics {
 public:
 	static Physics& Get() {
@@ -34,6 +53,21 @@ public:
     static void Shutdown();
     static void Step(float deltaTime);
 
+    // Fixed-rate simulation. Advance() adds the frame delta to an accumulator and runs
+    // whole steps of 1/hz, at most maxSubsteps per call (time beyond that is dropped).
+    // Around the last step it captures every active dynamic body into GetBodyStates(),
+    // to be blended with GetInterpolationAlpha() = leftover time / step.
+    static void SetFixedTimestep(float hz, int maxSubsteps);
+    static float GetFixedDeltaTime() { return s_FixedDeltaTime; }
+    static int Advance(float frameDelta);
+    static float GetInterpolationAlpha() { return s_InterpolationAlpha; }
+    static const std::vector<PhysicsBodyState>& GetBodyStates() { return s_BodyStates; }
+    // Drops the accumulator and the captured states, e.g. when play mode starts
+    static void ResetFixedStep();
+
+    // Pushes all velocities through the lock-free body interface; call between steps only
+    static void SetKinematicVelocities(const KinematicVelocity* velocities, size_t count);
+
     static void DestroyBody(JPH::BodyID bodyID);
     static JPH::BodyID CreateBody(const glm::mat4& transform, JPH::RefConst<JPH::Shape> shape, bool isStatic = false);
 
@@ -59,4 +93,13 @@ private:
     static class BroadPhaseLayerInterfaceImpl* s_BroadPhaseInterface;
     static class ObjectVsBroadPhaseLayerFilterImpl* s_ObjectVsBroadPhaseFilter;
     static class ObjectLayerPairFilterImpl* s_ObjectLayerPairFilter;
+
+    static void CaptureBodyStates(bool previous);
+
+    static float s_FixedDeltaTime;
+    static int s_MaxSubsteps;
+    static float s_Accumulator;
+    static float s_InterpolationAlpha;
+    static std::vector<PhysicsBodyState> s_BodyStates;
+    static JPH::BodyIDVector s_ActiveBodies;
 };
\ No newline at end of file
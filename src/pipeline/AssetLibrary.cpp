@@ -208,12 +208,16 @@ std::shared_ptr<bgfx::TextureHandle> AssetLibrary::LoadTexture(const AssetRefere
         path = it->second.path;
     }
     if (!path.empty()) {
-        bgfx::TextureHandle handle = TextureLoader::Load2D(path);
-        auto texPtr = std::make_shared<bgfx::TextureHandle>(handle);
+        std::shared_ptr<StreamedTexture> streamed = TextureStreamer::Instance().Request(path);
+        if (!streamed) return nullptr;
+        std::shared_ptr<bgfx::TextureHandle> texPtr(streamed, &streamed->Handle);
         std::lock_guard<std::mutex> lk2(m_Mutex);
         auto it = m_Assets.find(ref.guid);
         if (it == m_Assets.end()) return texPtr;
-        if (!it->second.texture) it->second.texture = texPtr;
+        if (!it->second.texture) {
+            it->second.texture = texPtr;
+            it->second.streamedTexture = streamed;
+        }
         return it->second.texture;
     }
     return nullptr;
@@ -333,10 +337,25 @@ std::string AssetLibrary::ResolveMeshBinFromMeta(const std::string& metaPath, in
     return {};
 }
 
-std::shared_ptr<Mesh> AssetLibrary::LoadMeshBin(const std::string& meshBinPath, int /*fileID*/) {
-    // Stub: allocate an empty mesh for now; real implementation will map/read streams and create GPU buffers
-    auto mesh = std::make_shared<Mesh>();
-    mesh->numVertices = 0;
-    mesh->numIndices = 0;
-    return mesh;
-}
\ No newline at end of file
+std::shared_ptr<Mesh> AssetLibrary::LoadMeshBin(const std::string& meshBinPath, int fileID) {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    auto it = m_MeshBinMeshes.find(meshBinPath);
+    if (it == m_MeshBinMeshes.end()) {
+        // Skeleton and meta sit next to the mesh cache; the meta names the source for texture lookup
+        std::filesystem::path mp(meshBinPath);
+        std::string stem = mp.stem().string();
+        std::string skelBin = (mp.parent_path() / (stem + ".skelbin")).string();
+        std::string source;
+        try {
+            std::ifstream in((mp.parent_path() / (stem + ".meta")).string());
+            if (in.is_open()) { nlohmann::json j; in >> j; source = j.value("source", std::string()); }
+        } catch (...) {}
+        if (source.empty()) source = meshBinPath;
+
+        Model model = ModelLoader::LoadModelCache(meshBinPath, skelBin, source);
+        if (model.Meshes.empty()) return nullptr;
+        it = m_MeshBinMeshes.emplace(meshBinPath, std::move(model.Meshes)).first;
+    }
+    if (fileID < 0 || fileID >= (int)it->second.size()) return nullptr;
+    return it->second[fileID];
+}
@@ -8,6 +8,7 @@
 #include "rendering/Mesh.h"
 #include "rendering/Material.h"
 #include "rendering/TextureLoader.h"
+#include "rendering/TextureStreamer.h"
 #include "animation/AnimationTypes.h"
 #include <mutex>
 
@@ -38,7 +39,8 @@ struct AssetEntry {
     // Runtime data
     std::shared_ptr<Mesh> mesh;
     std::shared_ptr<Material> material;
-    std::shared_ptr<bgfx::TextureHandle> texture;
+    std::shared_ptr<bgfx::TextureHandle> texture;          // aliases streamedTexture->Handle
+    std::shared_ptr<StreamedTexture> streamedTexture;
     std::shared_ptr<cm::animation::AnimationClip> animation;
     
     AssetEntry() = default;
@@ -67,6 +69,7 @@ public:
     // Asset loading
     std::shared_ptr<Mesh> LoadMesh(const AssetReference& ref);
     std::shared_ptr<Material> LoadMaterial(const AssetReference& ref);
+    // Streams in the background (TextureStreamer); the pointed-to handle upgrades in place
     std::shared_ptr<bgfx::TextureHandle> LoadTexture(const AssetReference& ref);
     std::shared_ptr<cm::animation::AnimationClip> LoadAnimation(const AssetReference& ref);
 
@@ -94,4 +97,5 @@ private:
     std::unordered_map<std::string, ClaymoreGUID> m_PathToGUID;
     std::unordered_map<ClaymoreGUID, std::string> m_GUIDToPath;
     std::unordered_map<std::string, std::shared_ptr<Mesh>> m_PrimitiveMeshes;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<Mesh>>> m_MeshBinMeshes; // .meshbin path -> meshes by fileID
 }; 
\ No newline at end of file
@@ -11,6 +11,7 @@ struct AssetMetadata {
     std::string hash;          // Hash of file contents (or timestamp)
     std::string lastImported;  // ISO 8601 timestamp (optional)
     std::unordered_map<std::string, std::string> settings; // Pipeline options
+    std::string settingsHash;  // DerivedDataCache::HashSettings(settings) of the last import
     ClaymoreGUID guid;                 // Unique identifier for this asset
     AssetReference reference;   // Asset reference for serialization
 };
@@ -23,6 +24,7 @@ inline void to_json(nlohmann::json& j, const AssetMetadata& meta) {
         {"hash", meta.hash},
         {"lastImported", meta.lastImported},
         {"settings", meta.settings},
+        {"settingsHash", meta.settingsHash},
         {"guid", meta.guid},
         {"reference", meta.reference}
     };
@@ -35,6 +37,7 @@ inline void from_json(const nlohmann::json& j, AssetMetadata& meta) {
     j.at("hash").get_to(meta.hash);
     j.at("lastImported").get_to(meta.lastImported);
     j.at("settings").get_to(meta.settings);
+    if (j.contains("settingsHash")) j.at("settingsHash").get_to(meta.settingsHash);
     if (j.contains("guid")) j.at("guid").get_to(meta.guid);
     if (j.contains("reference")) j.at("reference").get_to(meta.reference);
 }
\ No newline at end of file
@@ -4,11 +4,16 @@
 #include "AssetLibrary.h"
 #include "rendering/ModelLoader.h"
 #include "rendering/TextureLoader.h"
+#include "rendering/TextureStreamer.h"
 #include "rendering/ShaderManager.h"
 #include "animation/AnimationImporter.h"
 #include "animation/AnimationSerializer.h"
 #include "ModelImportCache.h"
 #include "ShaderImporter.h"
+#include "DerivedDataCache.h"
+#include "ImportGraph.h"
+#include "MaterialImporter.h"
+#include "TextureCooker.h"
 #include <rendering/ShaderBundle.h>
 
 #ifndef NOMINMAX
@@ -21,9 +26,12 @@
 #include <chrono>
 #include <iomanip>
 #include <unordered_set>
-#include <openssl/md5.h>
+#include <set>
+#include <cstring>
 #include <nlohmann/json.hpp>
 #include <iostream>
+#include <atomic>
+#include <limits>
 #include "ui/Logger.h"
 #include <stb_image.h>
 #include "scripting/DotNetHost.h"
@@ -42,6 +50,11 @@
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
+// Bump when an importer's output changes so derived-data cache entries are not reused
+static constexpr uint32_t kTextureImporterVersion = 2;
+static constexpr uint32_t kShaderImporterVersion = 2;
+static constexpr const char* kShaderPlatform = "windows";
+
 // ---------------------------------------
 // SCAN PROJECT (background safe)
 // ---------------------------------------
@@ -76,67 +89,107 @@ void AssetPipeline::EnqueueAssetImport(const std::string& path) {
 // ---------------------------------------
 // PROCESS IMPORTS + GPU TASKS
 // ---------------------------------------
-void AssetPipeline::ProcessMainThreadTasks() {
-    // 1. Import queue (CPU-bound work can run in parallel)
+// Turns the queued paths into one import graph and starts it on the workers; returns at once
+void AssetPipeline::StartQueuedImports() {
     std::vector<std::string> batch;
     {
         std::lock_guard<std::mutex> lock(m_QueueMutex);
         while (!m_ImportQueue.empty()) { batch.push_back(std::move(m_ImportQueue.front())); m_ImportQueue.pop(); }
     }
-    if (!batch.empty()) {
-        auto& js = Jobs();
-        const size_t n = batch.size();
-        const size_t chunk = 4; // balance enqueue overhead vs. I/O contention
-        parallel_for(js, size_t(0), n, chunk, [&](size_t s, size_t c){
-            for (size_t i = 0; i < c; ++i) {
-                const std::string& path = batch[s + i];
-                // ImportAsset may enqueue main-thread and GPU tasks; those are thread-safe
-                ImportAsset(path);
+    if (batch.empty()) return;
+
+    auto graph = std::make_shared<ImportGraph>();
+    // ImportAsset may enqueue main-thread and GPU tasks; those are thread-safe
+    for (const std::string& path : batch) graph->Add(path, [this, path]() { ImportAsset(path); });
+    m_ActiveImports.push_back(graph);
+
+    // Declaring inputs reads .mat files and lists model folders, so the edges are added
+    // and the graph started on a worker; the graph is not done until Run()
+    auto plan = [this, graph, batch = std::move(batch)]() {
+        for (const std::string& path : batch) {
+            const size_t node = graph->Find(path);
+            for (const std::string& input : DeclareImportInputs(path)) {
+                const size_t in = graph->Find(input);
+                if (in != SIZE_MAX) graph->AddDependency(node, in);
             }
-        });
-    }
+        }
+        graph->Run(Jobs());
+    };
+    if (!Jobs().EnqueueBackground(plan)) plan();
+}
 
-    // 2. Execute scheduled lambdas (e.g., GPU safe)
-    std::queue<std::function<void()>> localTaskQueue;
-    {
-        std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
-        std::swap(localTaskQueue, m_MainThreadTasks);
-    }
+bool AssetPipeline::ImportsRunning() {
+    m_ActiveImports.erase(std::remove_if(m_ActiveImports.begin(), m_ActiveImports.end(),
+        [](const std::shared_ptr<ImportGraph>& g) { return g->IsDone(); }), m_ActiveImports.end());
+    return !m_ActiveImports.empty();
+}
 
-    while (!localTaskQueue.empty()) {
-        localTaskQueue.front()();
-        localTaskQueue.pop();
-    }
+void AssetPipeline::GetImportProgress(size_t& done, size_t& total) const {
+    done = total = 0;
+    for (const auto& g : m_ActiveImports) { done += g->Completed(); total += g->Total(); }
+}
 
-    // 2b. (removed) model-specific queue no longer used; callbacks go through m_MainThreadTasks
+void AssetPipeline::ProcessMainThreadTasks() {
+    // 1. Import queue -> dependency graph on the job system (does not block the frame)
+    StartQueuedImports();
+    ImportsRunning();
 
-    // 3. Process GPU upload jobs
-    ProcessGPUUploads();
+    // 2. Scheduled main-thread work and 3. GPU uploads, within the frame budget
+    RunMainThreadWork(m_MainThreadBudgetMs);
+}
+
+// Runs queued main-thread tasks, then GPU uploads, until 'budgetMs' is used up. At least one
+// item runs per call so a slow task cannot stall the queue; the rest waits for the next frame.
+void AssetPipeline::RunMainThreadWork(double budgetMs) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMs));
+    bool ranAny = false;
+
+    for (;;) {
+        if (ranAny && Clock::now() >= deadline) return;
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+            if (m_MainThreadTasks.empty()) break;
+            task = std::move(m_MainThreadTasks.front());
+            m_MainThreadTasks.pop_front();
+        }
+        task();
+        ranAny = true;
+    }
+
+    for (;;) {
+        if (ranAny && Clock::now() >= deadline) return;
+        PendingGPUUpload upload;
+        {
+            std::lock_guard<std::mutex> lock(m_GPUQueueMutex);
+            if (m_GPUUploadQueue.empty()) break;
+            upload = std::move(m_GPUUploadQueue.front());
+            m_GPUUploadQueue.pop_front();
+        }
+        upload.Upload();
+        ranAny = true;
+    }
 }
 
 void AssetPipeline::ProcessGPUUploads() {
-    std::queue<PendingGPUUpload> localGPUQueue;
+    std::deque<PendingGPUUpload> localGPUQueue;
     {
         std::lock_guard<std::mutex> lock(m_GPUQueueMutex);
         std::swap(localGPUQueue, m_GPUUploadQueue);
     }
 
-    while (!localGPUQueue.empty()) {
-        localGPUQueue.front().Upload();
-        localGPUQueue.pop();
-    }
+    for (PendingGPUUpload& upload : localGPUQueue) upload.Upload();
 }
 
 // Block until current import queue and tasks are processed (called after menu-triggered reimport)
 void AssetPipeline::ProcessAllBlocking() {
-    // Pump until queues are empty for this frame budget
-    int safety = 10000;
-    while (safety-- > 0) {
-        size_t q1, q2, q3;
-        {
-            std::lock_guard<std::mutex> l1(m_QueueMutex);
-            q1 = m_ImportQueue.size();
-        }
+    // Pump until queues are empty; the main thread helps the workers while imports run
+    int idleSafety = 10000;
+    while (idleSafety > 0) {
+        StartQueuedImports();
+        const bool running = ImportsRunning();
+        size_t q2, q3;
         {
             std::lock_guard<std::mutex> l2(m_MainThreadQueueMutex);
             q2 = m_MainThreadTasks.size();
@@ -145,20 +198,28 @@ void AssetPipeline::ProcessAllBlocking() {
             std::lock_guard<std::mutex> l3(m_GPUQueueMutex);
             q3 = m_GPUUploadQueue.size();
         }
-        if (q1 == 0 && q2 == 0 && q3 == 0) break;
-        ProcessMainThreadTasks();
+        if (!running && q2 == 0 && q3 == 0) {
+            std::lock_guard<std::mutex> l1(m_QueueMutex);
+            if (m_ImportQueue.empty()) break;
+        }
+        RunMainThreadWork(std::numeric_limits<double>::infinity());
+        if (running) {
+            while (Jobs().TryRunOne()) {}
+        } else {
+            --idleSafety;
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 }
 
 void AssetPipeline::EnqueueMainThreadTask(std::function<void()> task) {
     std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
-    m_MainThreadTasks.push(std::move(task));
+    m_MainThreadTasks.push_back(std::move(task));
 }
 
 void AssetPipeline::EnqueueGPUUpload(PendingGPUUpload&& task) {
     std::lock_guard<std::mutex> lock(m_GPUQueueMutex);
-    m_GPUUploadQueue.push(std::move(task));
+    m_GPUUploadQueue.push_back(std::move(task));
 }
 
 // ---------------------------------------
@@ -171,19 +232,15 @@ void AssetPipeline::ImportAsset(const std::string& path) {
     std::string hash = ComputeFileHash(path);
 
     AssetMetadata meta;
-    bool hasMeta = false;
-
-    if (fs::exists(metaPath)) {
-        std::ifstream in(metaPath);
-        if (in) {
-            json j;
-            in >> j;
-            meta = j.get<AssetMetadata>();
-            hasMeta = true;
-        }
-    }
+    const bool hasMeta = ReadMetaFile(path, meta);
 
-    if (hasMeta && meta.hash == hash) return;
+    // Up to date when neither the source nor its .meta settings changed. Unchanged
+    // textures still cook once when their sidecar is missing (fresh checkout)
+    const std::string settingsHash = DerivedDataCache::HashSettings(meta.settings);
+    const bool needsCook = DetermineType(ext) == "texture" && !fs::exists(TextureCooker::CookedPath(path));
+    if (hasMeta && meta.hash == hash && meta.settingsHash == settingsHash && !needsCook) return;
+    // Importers that key on the registry (DerivedDataKey) see the settings being imported
+    if (hasMeta) AssetRegistry::Instance().SetMetadata(path, meta);
 
     // Dispatch
     if (ext == ".fbx" || ext == ".obj" || ext == ".gltf" || ext == ".glb") {
@@ -191,7 +248,7 @@ void AssetPipeline::ImportAsset(const std::string& path) {
         meta.type = "model";
     }
     else if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga") {
-        ImportTextureCPU(path); // Optimized async texture
+        ImportTextureCPU(path, meta.settings); // the registry has no entry yet on a first import
         meta.type = "texture";
     }
     else if (ext == ".sc" || ext == ".glsl" || ext == ".shader") {
@@ -245,6 +302,7 @@ void AssetPipeline::ImportAsset(const std::string& path) {
     meta.sourcePath = path;
     meta.processedPath = "cache/" + fs::path(path).filename().string();
     meta.hash = hash;
+    meta.settingsHash = settingsHash;
     meta.lastImported = GetCurrentTimestamp();
     
             // Generate GUID and asset reference if not already present
@@ -269,12 +327,55 @@ void AssetPipeline::ImportAsset(const std::string& path) {
 }
 
 void AssetPipeline::ImportMaterial(const std::string& path) {
+    // Resolve on the import worker; the shader and textures it names were imported first
+    MaterialAssetUnified material;
+    if (!MaterialImporter::Load(path, material)) {
+        std::cerr << "[AssetPipeline] Failed to read material: " << path << std::endl;
+        return;
+    }
     EnqueueMainThreadTask([path]() {
         std::cout << "[AssetPipeline] Material reloaded: " << path << std::endl;
         // Future: notify inspector/renderer of material changes
     });
 }
 
+// Assets that must finish importing before 'path' when they are in the same batch
+std::vector<std::string> AssetPipeline::DeclareImportInputs(const std::string& path) const {
+    std::vector<std::string> inputs;
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    const fs::path dir = fs::path(path).parent_path();
+    auto resolve = [&](const std::string& ref) {
+        if (ref.empty()) return;
+        fs::path p(ref);
+        std::error_code ec;
+        if (p.is_relative() && !fs::exists(p, ec)) {
+            if (fs::exists(dir / p, ec)) p = dir / p;
+            else p = Project::GetProjectDirectory() / p;
+        }
+        inputs.push_back(p.string());
+    };
+
+    if (ext == ".mat") {
+        // material -> shader, textures
+        MaterialAssetUnified material;
+        if (MaterialImporter::Load(path, material)) {
+            resolve(material.shaderPath);
+            for (const auto& kv : material.textures) resolve(kv.second);
+        }
+    } else if (DetermineType(ext) == "model") {
+        // model -> textures and materials next to it (what its material slots resolve against)
+        std::error_code ec;
+        for (auto it = fs::directory_iterator(dir, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+            std::string e = it->path().extension().string();
+            std::transform(e.begin(), e.end(), e.begin(), ::tolower);
+            const std::string type = DetermineType(e);
+            if (type == "texture" || type == "material") inputs.push_back(it->path().string());
+        }
+    }
+    return inputs;
+}
+
 
 
 void AssetPipeline::ImportScript(const std::string& path)
@@ -343,245 +444,192 @@ void AssetPipeline::ImportScript(const std::string& path)
 
 
 // ---------------------------------------
-// MODEL IMPORT (GPU-safe queued)
+// MODEL IMPORT (import worker; scene hot-swap on the main thread)
 // ---------------------------------------
 void AssetPipeline::ImportModel(const std::string& path) {
-    EnqueueMainThreadTask([path]() {
-        auto model = ModelLoader::LoadModel(path);
-        std::cout << "[AssetPipeline] Model uploaded to GPU: " << path << std::endl;
-
-        // --------- Auto-generate humanoid avatar (heuristic) ---------
-        // Use the runtime scene loader path to build skeleton bind data, then export an .avatar file next to the model.
-        try {
-            // Build a transient skeleton with parents using Assimp hierarchy for accurate bind locals
-            Assimp::Importer aimport;
-            const aiScene* aScene = aimport.ReadFile(path,
-                aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace |
-                aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices |
-                aiProcess_ImproveCacheLocality | aiProcess_LimitBoneWeights);
-            SkeletonComponent tempSkel;
-            tempSkel.InverseBindPoses = model.InverseBindPoses;
-            tempSkel.BoneParents.resize(model.BoneNames.size(), -1);
-            for (int i = 0; i < (int)model.BoneNames.size(); ++i) tempSkel.BoneNameToIndex[model.BoneNames[i]] = i;
-
-            if (aScene && aScene->mRootNode) {
-                std::unordered_map<std::string, aiNode*> nodeByName;
-                std::function<void(aiNode*)> gather = [&](aiNode* n){ nodeByName[n->mName.C_Str()] = n; for (unsigned c=0;c<n->mNumChildren;++c) gather(n->mChildren[c]); };
-                gather(aScene->mRootNode);
-                // Build name->index map
-                std::unordered_map<std::string, int> boneIndexMap;
-                for (int i = 0; i < (int)model.BoneNames.size(); ++i) boneIndexMap[model.BoneNames[i]] = i;
-                for (size_t i = 0; i < model.BoneNames.size(); ++i) {
-                    auto itNode = nodeByName.find(model.BoneNames[i]);
-                    if (itNode != nodeByName.end()) {
-                        aiNode* p = itNode->second->mParent;
-                        while (p) {
-                            auto itBI = boneIndexMap.find(p->mName.C_Str());
-                            if (itBI != boneIndexMap.end()) { tempSkel.BoneParents[i] = itBI->second; break; }
-                            p = p->mParent;
-                        }
-                    }
-                }
+    // CPU only: GPU buffers are created when the model is instantiated
+    ImportedModel model;
+    if (!ModelLoader::ImportModel(path, model)) {
+        std::cerr << "[AssetPipeline] Model import failed: " << path << std::endl;
+        return;
+    }
+    std::cout << "[AssetPipeline] Model imported: " << path << std::endl;
+
+    // --------- Auto-generate humanoid avatar (heuristic) ---------
+    // Use the runtime scene loader path to build skeleton bind data, then export an .avatar file next to the model.
+    try {
+        // Transient skeleton; parents come from the import's node hierarchy
+        SkeletonComponent tempSkel;
+        tempSkel.InverseBindPoses = model.InverseBindPoses;
+        tempSkel.BoneParents = model.BoneParents;
+        tempSkel.BoneParents.resize(model.BoneNames.size(), -1);
+        for (int i = 0; i < (int)model.BoneNames.size(); ++i) tempSkel.BoneNameToIndex[model.BoneNames[i]] = i;
+
+        cm::animation::AvatarDefinition avatar;
+        avatar.RigName = std::filesystem::path(path).stem().string();
+        cm::animation::avatar_builders::BuildFromSkeleton(tempSkel, avatar, true);
+        // Save next to the model
+        std::filesystem::path p(path);
+        std::string avatarPath = (p.parent_path() / (p.stem().string() + ".avatar")).string();
+        cm::animation::SaveAvatar(avatar, avatarPath);
+        std::cout << "[AssetPipeline] Wrote avatar: " << avatarPath << std::endl;
+    } catch(...) {
+        // Non-fatal
+    } 
+
+    // --------- Capture external textures into assets/textures/<model>/ and register ---------
+    try {
+        fs::path src(path);
+        std::string modelName = src.stem().string();
+        fs::path proj = Project::GetProjectDirectory();
+        fs::path texRoot = proj / "assets" / "textures" / modelName;
+        std::error_code ec; fs::create_directories(texRoot, ec);
+
+        // Texture references come from the import above; no second Assimp pass over the file
+        for (const ImportedMaterial& mat : model.Materials) {
+            for (const std::string& tpath : mat.TexturePaths) {
+                // Skip obvious embedded markers; embedded extraction not implemented here
+                if (!tpath.empty() && tpath[0] == '*') continue;
+
+                fs::path psrc = tpath;
+                if (!fs::exists(psrc)) psrc = src.parent_path() / tpath;
+                if (!fs::exists(psrc)) continue;
+                fs::path pdst = texRoot / psrc.filename();
+                fs::copy_file(psrc, pdst, fs::copy_options::overwrite_existing, ec);
+                std::string vpath = pdst.string(); std::replace(vpath.begin(), vpath.end(), '\\', '/');
+                size_t pos = vpath.find("assets/"); if (pos != std::string::npos) vpath = vpath.substr(pos);
+                AssetMetadata tmeta; tmeta.guid = ClaymoreGUID::Generate(); tmeta.type = "texture"; tmeta.sourcePath = vpath; tmeta.processedPath = vpath;
+                nlohmann::json tj = tmeta; std::ofstream outm((pdst.string()+".meta").c_str()); if (outm) outm << tj.dump(4);
+                AssetLibrary::Instance().RegisterAsset(AssetReference(tmeta.guid, 0, (int)AssetType::Texture), AssetType::Texture, vpath, pdst.filename().string());
+                std::cout << "[FBXImport] Copied texture to: " << pdst << std::endl;
             }
-
-            cm::animation::AvatarDefinition avatar;
-            avatar.RigName = std::filesystem::path(path).stem().string();
-            cm::animation::avatar_builders::BuildFromSkeleton(tempSkel, avatar, true);
-            // Save next to the model
-            std::filesystem::path p(path);
-            std::string avatarPath = (p.parent_path() / (p.stem().string() + ".avatar")).string();
-            cm::animation::SaveAvatar(avatar, avatarPath);
-            std::cout << "[AssetPipeline] Wrote avatar: " << avatarPath << std::endl;
-        } catch(...) {
-            // Non-fatal
-        } 
-
-        // --------- Capture external textures into assets/textures/<model>/ and register ---------
-        try {
-            fs::path src(path);
-            std::string modelName = src.stem().string();
-            fs::path proj = Project::GetProjectDirectory();
-            fs::path texRoot = proj / "assets" / "textures" / modelName;
-            std::error_code ec; fs::create_directories(texRoot, ec);
-
-            Assimp::Importer aimport2;
-            const aiScene* s2 = aimport2.ReadFile(path, aiProcess_Triangulate | aiProcess_GenNormals);
-            if (s2 && s2->HasMaterials()) {
-                for (unsigned mi = 0; mi < s2->mNumMaterials; ++mi) {
-                    const aiMaterial* aim = s2->mMaterials[mi];
-
-                    // Gather all texture paths across many stacks and indices (robust for various exporters)
-                    std::vector<std::string> texPaths;
-                    auto maybeAdd = [&](const std::string& p){ if (!p.empty() && std::find(texPaths.begin(), texPaths.end(), p) == texPaths.end()) texPaths.push_back(p); };
-                    auto gatherType = [&](aiTextureType t){
-                        const unsigned count = aim->GetTextureCount(t);
-                        for (unsigned ti = 0; ti < count; ++ti) { aiString s; if (aim->GetTexture(t, ti, &s) == AI_SUCCESS) maybeAdd(std::string(s.C_Str())); }
-                    };
-
-                    // Common and extended stacks
-                    gatherType(aiTextureType_BASE_COLOR);
-                    gatherType(aiTextureType_DIFFUSE);
-                    gatherType(aiTextureType_SPECULAR);
-                    gatherType(aiTextureType_AMBIENT);
-                    gatherType(aiTextureType_EMISSIVE);
-                    gatherType(aiTextureType_NORMALS);
-                    gatherType(aiTextureType_HEIGHT);
-                    gatherType(aiTextureType_SHININESS);
-                    gatherType(aiTextureType_OPACITY);
-                    gatherType(aiTextureType_DISPLACEMENT);
-                    gatherType(aiTextureType_LIGHTMAP);
-                    gatherType(aiTextureType_REFLECTION);
-                    gatherType(aiTextureType_METALNESS);
-                    gatherType(aiTextureType_DIFFUSE_ROUGHNESS);
-                    gatherType(aiTextureType_AMBIENT_OCCLUSION);
-                    gatherType(aiTextureType_CLEARCOAT);
-                    gatherType(aiTextureType_SHEEN);
-                    gatherType(aiTextureType_TRANSMISSION);
-                    gatherType(aiTextureType_UNKNOWN);
-
-                    for (const auto& tpath : texPaths) {
-                        // Skip obvious embedded markers; embedded extraction not implemented here
-                        if (!tpath.empty() && tpath[0] == '*') continue;
-
-                        fs::path psrc = tpath;
-                        if (!fs::exists(psrc)) psrc = src.parent_path() / tpath;
-                        if (!fs::exists(psrc)) continue;
-                        fs::path pdst = texRoot / psrc.filename();
-                        fs::copy_file(psrc, pdst, fs::copy_options::overwrite_existing, ec);
-                        std::string vpath = pdst.string(); std::replace(vpath.begin(), vpath.end(), '\\', '/');
-                        size_t pos = vpath.find("assets/"); if (pos != std::string::npos) vpath = vpath.substr(pos);
-                        AssetMetadata tmeta; tmeta.guid = ClaymoreGUID::Generate(); tmeta.type = "texture"; tmeta.sourcePath = vpath; tmeta.processedPath = vpath;
-                        nlohmann::json tj = tmeta; std::ofstream outm((pdst.string()+".meta").c_str()); if (outm) outm << tj.dump(4);
-                        AssetLibrary::Instance().RegisterAsset(AssetReference(tmeta.guid, 0, (int)AssetType::Texture), AssetType::Texture, vpath, pdst.filename().string());
-                        std::cout << "[FBXImport] Copied texture to: " << pdst << std::endl;
+        }
+    } catch(...) { std::cerr << "[FBXImport] Texture capture step failed: " << path << std::endl; }
+
+    // --------- Failsafe: grep PNG file paths referenced in FBX and copy any missing ---------
+    try {
+        fs::path src(path);
+        std::string modelName = src.stem().string();
+        fs::path proj = Project::GetProjectDirectory();
+        fs::path texRoot = proj / "assets" / "textures" / modelName;
+        std::error_code ec; fs::create_directories(texRoot, ec);
+
+        std::ifstream fin(path, std::ios::binary);
+        if (fin) {
+            std::vector<char> buf((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+
+            auto isAllowed = [](char c) -> bool {
+                unsigned char uc = static_cast<unsigned char>(c);
+                return std::isalnum(uc) || c=='_' || c=='-' || c=='.' || c=='/' || c=='\\';
+            };
+
+            std::vector<std::string> candidates;
+            auto addUnique = [&](const std::string& s){ if (!s.empty() && std::find(candidates.begin(), candidates.end(), s)==candidates.end()) candidates.push_back(s); };
+
+            for (size_t i = 0; i + 4 <= buf.size(); ++i) {
+                char c0 = buf[i+0];
+                char c1 = (i+1<buf.size()?buf[i+1]:0);
+                char c2 = (i+2<buf.size()?buf[i+2]:0);
+                char c3 = (i+3<buf.size()?buf[i+3]:0);
+                if (c0=='.' && (c1=='p'||c1=='P') && (c2=='n'||c2=='N') && (c3=='g'||c3=='G')) {
+                    // Expand backwards to include path/filename
+                    size_t start = i;
+                    while (start>0 && isAllowed(buf[start-1])) --start;
+                    // Expand forwards to include any trailing path parts (unlikely after extension, but safe)
+                    size_t end = i+4;
+                    while (end<buf.size() && isAllowed(buf[end])) ++end;
+                    if (end>start) {
+                        std::string token(buf.data()+start, buf.data()+end);
+                        // Normalize separators to the local FS style
+                        for (char& ch : token) if (ch=='\\') ch = '\\';
+                        addUnique(token);
                     }
                 }
             }
-        } catch(...) { std::cerr << "[FBXImport] Texture capture step failed: " << path << std::endl; }
 
-        // --------- Failsafe: grep PNG file paths referenced in FBX and copy any missing ---------
-        try {
-            fs::path src(path);
-            std::string modelName = src.stem().string();
-            fs::path proj = Project::GetProjectDirectory();
-            fs::path texRoot = proj / "assets" / "textures" / modelName;
-            std::error_code ec; fs::create_directories(texRoot, ec);
-
-            std::ifstream fin(path, std::ios::binary);
-            if (fin) {
-                std::vector<char> buf((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
-
-                auto isAllowed = [](char c) -> bool {
-                    unsigned char uc = static_cast<unsigned char>(c);
-                    return std::isalnum(uc) || c=='_' || c=='-' || c=='.' || c=='/' || c=='\\';
-                };
-
-                std::vector<std::string> candidates;
-                auto addUnique = [&](const std::string& s){ if (!s.empty() && std::find(candidates.begin(), candidates.end(), s)==candidates.end()) candidates.push_back(s); };
-
-                for (size_t i = 0; i + 4 <= buf.size(); ++i) {
-                    char c0 = buf[i+0];
-                    char c1 = (i+1<buf.size()?buf[i+1]:0);
-                    char c2 = (i+2<buf.size()?buf[i+2]:0);
-                    char c3 = (i+3<buf.size()?buf[i+3]:0);
-                    if (c0=='.' && (c1=='p'||c1=='P') && (c2=='n'||c2=='N') && (c3=='g'||c3=='G')) {
-                        // Expand backwards to include path/filename
-                        size_t start = i;
-                        while (start>0 && isAllowed(buf[start-1])) --start;
-                        // Expand forwards to include any trailing path parts (unlikely after extension, but safe)
-                        size_t end = i+4;
-                        while (end<buf.size() && isAllowed(buf[end])) ++end;
-                        if (end>start) {
-                            std::string token(buf.data()+start, buf.data()+end);
-                            // Normalize separators to the local FS style
-                            for (char& ch : token) if (ch=='\\') ch = '\\';
-                            addUnique(token);
-                        }
-                    }
-                }
-
-                for (const auto& tpath : candidates) {
-                    // Skip embedded markers (e.g., "*0")
-                    if (!tpath.empty() && tpath[0]=='*') continue;
-
-                    fs::path psrc = tpath;
-                    if (!fs::exists(psrc)) psrc = src.parent_path() / tpath;
-                    if (!fs::exists(psrc)) psrc = src.parent_path() / fs::path(tpath).filename();
-                    if (!fs::exists(psrc)) continue;
-
-                    fs::path pdst = texRoot / psrc.filename();
-                    if (!fs::exists(pdst)) {
-                        fs::copy_file(psrc, pdst, fs::copy_options::overwrite_existing, ec);
-                        std::string vpath = pdst.string(); std::replace(vpath.begin(), vpath.end(), '\\', '/');
-                        size_t pos = vpath.find("assets/"); if (pos != std::string::npos) vpath = vpath.substr(pos);
-                        AssetMetadata tmeta; tmeta.guid = ClaymoreGUID::Generate(); tmeta.type = "texture"; tmeta.sourcePath = vpath; tmeta.processedPath = vpath;
-                        nlohmann::json tj = tmeta; std::ofstream outm((pdst.string()+".meta").c_str()); if (outm) outm << tj.dump(4);
-                        AssetLibrary::Instance().RegisterAsset(AssetReference(tmeta.guid, 0, (int)AssetType::Texture), AssetType::Texture, vpath, pdst.filename().string());
-                        std::cout << "[FBXImport] Grep-copied PNG to: " << pdst << std::endl;
-                    }
+            for (const auto& tpath : candidates) {
+                // Skip embedded markers (e.g., "*0")
+                if (!tpath.empty() && tpath[0]=='*') continue;
+
+                fs::path psrc = tpath;
+                if (!fs::exists(psrc)) psrc = src.parent_path() / tpath;
+                if (!fs::exists(psrc)) psrc = src.parent_path() / fs::path(tpath).filename();
+                if (!fs::exists(psrc)) continue;
+
+                fs::path pdst = texRoot / psrc.filename();
+                if (!fs::exists(pdst)) {
+                    fs::copy_file(psrc, pdst, fs::copy_options::overwrite_existing, ec);
+                    std::string vpath = pdst.string(); std::replace(vpath.begin(), vpath.end(), '\\', '/');
+                    size_t pos = vpath.find("assets/"); if (pos != std::string::npos) vpath = vpath.substr(pos);
+                    AssetMetadata tmeta; tmeta.guid = ClaymoreGUID::Generate(); tmeta.type = "texture"; tmeta.sourcePath = vpath; tmeta.processedPath = vpath;
+                    nlohmann::json tj = tmeta; std::ofstream outm((pdst.string()+".meta").c_str()); if (outm) outm << tj.dump(4);
+                    AssetLibrary::Instance().RegisterAsset(AssetReference(tmeta.guid, 0, (int)AssetType::Texture), AssetType::Texture, vpath, pdst.filename().string());
+                    std::cout << "[FBXImport] Grep-copied PNG to: " << pdst << std::endl;
                 }
             }
-        } catch(...) { std::cerr << "[FBXImport] PNG grep step failed: " << path << std::endl; }
-
-        // --------- Extract animations (unified .anim as primary) ---------
-        using namespace cm::animation;
-        auto clips = AnimationImporter::ImportFromModel(path);
-        std::cout << "[AssetPipeline] ImportFromModel found " << clips.size() << " animation(s)." << std::endl;
-        if (!clips.empty()) {
-            std::filesystem::path p(path);
-            std::string dir = p.parent_path().string();
-            // Try to load/create a source avatar for this rig
-            AvatarDefinition srcAvatar;
-            std::string avatarPath = (p.parent_path() / (p.stem().string() + ".avatar")).string();
-            bool hasAvatar = cm::animation::LoadAvatar(srcAvatar, avatarPath);
-            for (auto& clip : clips) {
-                // Build a unified AnimationAsset and convert skeletal to Avatar tracks if humanoid
-                AnimationAsset asset; asset.name = clip.Name; asset.meta.version = 1; asset.meta.fps = (clip.TicksPerSecond > 0.0f ? clip.TicksPerSecond : 30.0f); asset.meta.length = clip.Duration;
-                bool isHumanoid = false;
-                if (hasAvatar) {
-                    // Convert using avatar mapping when bone names match, otherwise fall back to skeletal
-                    for (const auto& [boneName, bt] : clip.BoneTracks) {
-                        // Find mapped humanoid id
-                        int mappedId = -1;
-                        for (uint16_t i = 0; i < cm::animation::HumanoidBoneCount; ++i) {
-                            if (!srcAvatar.Present[i]) continue;
-                            const auto& e = srcAvatar.Map[i];
-                            if (!e.BoneName.empty() && e.BoneName == boneName) { mappedId = (int)i; break; }
-                        }
-                        if (mappedId >= 0) {
-                            isHumanoid = true;
-                            auto t = std::make_unique<AssetAvatarTrack>();
-                            t->humanBoneId = mappedId;
-                            t->name = std::string("Humanoid:") + ToString(static_cast<cm::animation::HumanoidBone>(mappedId));
-                            for (const auto& k : bt.PositionKeys) t->t.keys.push_back({0ull, k.Time, k.Value});
-                            for (const auto& k : bt.RotationKeys) t->r.keys.push_back({0ull, k.Time, k.Value});
-                            for (const auto& k : bt.ScaleKeys)    t->s.keys.push_back({0ull, k.Time, k.Value});
-                            asset.tracks.push_back(std::move(t));
-                        }
+        }
+    } catch(...) { std::cerr << "[FBXImport] PNG grep step failed: " << path << std::endl; }
+
+    // --------- Extract animations (unified .anim as primary) ---------
+    using namespace cm::animation;
+    auto clips = AnimationImporter::ImportFromModel(path);
+    std::cout << "[AssetPipeline] ImportFromModel found " << clips.size() << " animation(s)." << std::endl;
+    if (!clips.empty()) {
+        std::filesystem::path p(path);
+        std::string dir = p.parent_path().string();
+        // Try to load/create a source avatar for this rig
+        AvatarDefinition srcAvatar;
+        std::string avatarPath = (p.parent_path() / (p.stem().string() + ".avatar")).string();
+        bool hasAvatar = cm::animation::LoadAvatar(srcAvatar, avatarPath);
+        for (auto& clip : clips) {
+            // Build a unified AnimationAsset and convert skeletal to Avatar tracks if humanoid
+            AnimationAsset asset; asset.name = clip.Name; asset.meta.version = 1; asset.meta.fps = (clip.TicksPerSecond > 0.0f ? clip.TicksPerSecond : 30.0f); asset.meta.length = clip.Duration;
+            bool isHumanoid = false;
+            if (hasAvatar) {
+                // Convert using avatar mapping when bone names match, otherwise fall back to skeletal
+                for (const auto& [boneName, bt] : clip.BoneTracks) {
+                    // Find mapped humanoid id
+                    int mappedId = -1;
+                    for (uint16_t i = 0; i < cm::animation::HumanoidBoneCount; ++i) {
+                        if (!srcAvatar.Present[i]) continue;
+                        const auto& e = srcAvatar.Map[i];
+                        if (!e.BoneName.empty() && e.BoneName == boneName) { mappedId = (int)i; break; }
                     }
-                }
-                // If not humanoid or no avatar mapping, keep skeletal bone tracks
-                if (!isHumanoid) {
-                    for (const auto& [boneName, bt] : clip.BoneTracks) {
-                        auto t = std::make_unique<AssetBoneTrack>();
-                        t->name = boneName;
+                    if (mappedId >= 0) {
+                        isHumanoid = true;
+                        auto t = std::make_unique<AssetAvatarTrack>();
+                        t->humanBoneId = mappedId;
+                        t->name = std::string("Humanoid:") + ToString(static_cast<cm::animation::HumanoidBone>(mappedId));
                         for (const auto& k : bt.PositionKeys) t->t.keys.push_back({0ull, k.Time, k.Value});
                         for (const auto& k : bt.RotationKeys) t->r.keys.push_back({0ull, k.Time, k.Value});
                         for (const auto& k : bt.ScaleKeys)    t->s.keys.push_back({0ull, k.Time, k.Value});
                         asset.tracks.push_back(std::move(t));
                     }
                 }
-
-                // Save as unified .anim
-                std::string outPath = dir + "/" + p.stem().string() + "_" + clip.Name + ".anim";
-                if (SaveAnimationAsset(asset, outPath)) {
-                    std::cout << "[AssetPipeline] Saved animation asset: " << outPath << std::endl;
+            }
+            // If not humanoid or no avatar mapping, keep skeletal bone tracks
+            if (!isHumanoid) {
+                for (const auto& [boneName, bt] : clip.BoneTracks) {
+                    auto t = std::make_unique<AssetBoneTrack>();
+                    t->name = boneName;
+                    for (const auto& k : bt.PositionKeys) t->t.keys.push_back({0ull, k.Time, k.Value});
+                    for (const auto& k : bt.RotationKeys) t->r.keys.push_back({0ull, k.Time, k.Value});
+                    for (const auto& k : bt.ScaleKeys)    t->s.keys.push_back({0ull, k.Time, k.Value});
+                    asset.tracks.push_back(std::move(t));
                 }
             }
+
+            // Save as unified .anim
+            std::string outPath = dir + "/" + p.stem().string() + "_" + clip.Name + ".anim";
+            if (SaveAnimationAsset(asset, outPath)) {
+                std::cout << "[AssetPipeline] Saved animation asset: " << outPath << std::endl;
+            }
         }
-        // After import: hot-swap in active scene
+    }
+    // After import: hot-swap in active scene
+    EnqueueMainThreadTask([path]() {
         AssetPipeline::Instance().HotSwapModelInScene(path);
-        });
+    });
 }
 void AssetPipeline::HotSwapModelInScene(const std::string& modelPath) {
     // Resolve GUID for this path if known
@@ -741,7 +789,7 @@ void AssetPipeline::HotSwapModelInScene(const std::string& modelPath) {
 // ---------------------------------------
 void AssetPipeline::EnqueueModelImport(const ImportRequest& req) {
     // Run CPU-heavy build in a background job; then marshal to main thread
-    Jobs().Enqueue([this, req]{
+    Jobs().EnqueueBackground([this, req]{
         try {
             BuiltModelPaths built{};
             if (!EnsureModelCache(req.sourcePath, built)) {
@@ -764,33 +812,73 @@ void AssetPipeline::EnqueueModelImport(const ImportRequest& req) {
 }
 
 // ---------------------------------------
-// TEXTURE IMPORT (CPU -> GPU queue)
+// TEXTURE IMPORT (cook to GPU format)
 // ---------------------------------------
-void AssetPipeline::ImportTextureCPU(const std::string& path) {
-    int width, height, channels;
-    stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
-    if (!pixels) {
-        std::cerr << "[AssetPipeline] Failed to load texture: " << path << std::endl;
+void AssetPipeline::ImportTextureCPU(const std::string& path, const std::unordered_map<std::string, std::string>& settings) {
+    if (!CookTexture(path, settings)) {
+        std::cerr << "[AssetPipeline] Failed to cook texture: " << path << std::endl;
         return;
     }
+    TextureLoader::RegisterTexturePath(path);
+    // Materials already showing this texture pick up the new cook
+    EnqueueMainThreadTask([path]() { TextureStreamer::Instance().Reload(path); });
+    std::cout << "[AssetPipeline] Cooked texture: " << TextureCooker::CookedPath(path) << std::endl;
+}
 
-    std::vector<uint8_t> pixelData(pixels, pixels + width * height * 4);
-    stbi_image_free(pixels);
-
-    PendingGPUUpload task;
-    task.type = PendingGPUUpload::Type::Texture;
-    task.sourcePath = path;
-    task.width = width;
-    task.height = height;
-    task.pixelData = std::move(pixelData);
-    task.Upload = [task]() {
-        const bgfx::Memory* mem = bgfx::copy(task.pixelData.data(), task.pixelData.size());
-        bgfx::createTexture2D((uint16_t)task.width, (uint16_t)task.height,
-            false, 1, task.format, 0, mem);
-        std::cout << "[AssetPipeline] Uploaded texture: " << task.sourcePath << std::endl;
-        };
+bool AssetPipeline::DecodeTexture(const std::string& path, int& width, int& height, std::vector<uint8_t>& pixels) {
+    int channels = 0;
+    stbi_uc* decoded = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!decoded) return false;
+    pixels.assign(decoded, decoded + size_t(width) * height * 4);
+    stbi_image_free(decoded);
+    return true;
+}
+
+// DDC entry "ktx": the cooked container, keyed by content and the resolved cook settings
+// (which include file-name usage guesses, so identical pixels under two names stay apart)
+std::string AssetPipeline::TextureDerivedDataKey(const std::string& path, const std::unordered_map<std::string, std::string>& metaSettings) const {
+    const std::string hash = DerivedDataCache::HashFile(path);
+    if (hash.empty()) return {};
+    std::unordered_map<std::string, std::string> settings = metaSettings;
+    settings["cook"] = TextureCooker::Describe(TextureCooker::ResolveSettings(path, metaSettings));
+    return DerivedDataCache::MakeKey(hash, "texture", kTextureImporterVersion, settings);
+}
+
+bool AssetPipeline::CookTexture(const std::string& path, const std::unordered_map<std::string, std::string>& settings) {
+    const TextureCooker::Settings cook = TextureCooker::ResolveSettings(path, settings);
+    const std::string key = TextureDerivedDataKey(path, settings);
+    if (key.empty()) return false;
+
+    std::vector<uint8_t> ktx;
+    if (!DerivedDataCache::Instance().FetchBlob(key, "ktx", ktx)) {
+        int width = 0, height = 0;
+        std::vector<uint8_t> pixels;
+        if (!DecodeTexture(path, width, height, pixels)) return false;
+        std::string error;
+        if (!TextureCooker::Cook(pixels.data(), (uint32_t)width, (uint32_t)height, cook, ktx, &error)) {
+            std::cerr << "[AssetPipeline] " << path << ": " << error << std::endl;
+            return false;
+        }
+        DerivedDataCache::Instance().StoreBlob(key, "ktx", ktx);
+    }
 
-    EnqueueGPUUpload(std::move(task));
+    // Leave an identical sidecar alone so its timestamp keeps meaning "cooked after source"
+    const std::string cookedPath = TextureCooker::CookedPath(path);
+    std::error_code ec;
+    if (fs::exists(cookedPath, ec) && fs::file_size(cookedPath, ec) == ktx.size()
+        && fs::last_write_time(cookedPath, ec) >= fs::last_write_time(path, ec)) {
+        std::ifstream in(cookedPath, std::ios::binary);
+        std::vector<uint8_t> existing(ktx.size());
+        if (in.read(reinterpret_cast<char*>(existing.data()), (std::streamsize)existing.size()) && existing == ktx) return true;
+    }
+    const std::string tmpPath = cookedPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char*>(ktx.data()), (std::streamsize)ktx.size())) return false;
+    }
+    fs::rename(tmpPath, cookedPath, ec);
+    if (ec) { fs::remove(tmpPath, ec); return false; }
+    return true;
 }
 
 // ---------------------------------------
@@ -801,23 +889,19 @@ void AssetPipeline::ImportShader(const std::string& path) {
     std::string ext = std::filesystem::path(path).extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     if (ext == ".shader") {
-        // Unified path: run ShaderImporter to compile both stages and emit meta
-        EnqueueMainThreadTask([path]() {
-            cm::ShaderImporterContext ctx;
-            ctx.projectRoot = std::filesystem::current_path().string();
-            ctx.toolsDir = (std::filesystem::current_path() / "tools").string();
-            ctx.shadersOutRoot = (std::filesystem::current_path() / "shaders").string();
-            ctx.platform = "windows";
-            cm::ShaderMeta meta; std::string err;
-            if (!cm::ShaderImporter::ImportShader(path, ctx, meta, err)) {
-                std::cerr << "[AssetPipeline] Shader import failed: " << err << std::endl;
-                return;
-            }
-            // Invalidate cached program for this base name
-            ShaderBundle::Instance().Invalidate(meta.baseName);
-            std::cout << "[AssetPipeline] Shader imported: " << path << std::endl;
+        // Unified path: compile both stages and emit meta here on the import worker
+        cm::ShaderMeta meta; std::string err;
+        if (!ImportShaderCached(path, meta, err)) {
+            std::cerr << "[AssetPipeline] Shader import failed: " << err << std::endl;
+            return;
+        }
+        std::cout << "[AssetPipeline] Shader imported: " << path << std::endl;
+        // Invalidate cached program for this base name
+        EnqueueMainThreadTask([baseName = meta.baseName]() {
+            ShaderBundle::Instance().Invalidate(baseName);
         });
     } else {
+        // Legacy path compiles and creates the bgfx shader in one call, so it stays on the main thread
         ShaderType type = ShaderType::Fragment;
         if (path.find("vs_") != std::string::npos) type = ShaderType::Vertex;
         else if (path.find("fs_") != std::string::npos) type = ShaderType::Fragment;
@@ -828,22 +912,196 @@ void AssetPipeline::ImportShader(const std::string& path) {
     }
 }
 
+// Compiled stages and meta land where ShaderImporter writes them; a DDC hit copies them back
+bool AssetPipeline::ImportShaderCached(const std::string& path, cm::ShaderMeta& meta, std::string& error) {
+    const std::string baseName = fs::path(path).stem().string();
+    const fs::path outDir = fs::path("shaders") / "compiled" / kShaderPlatform;
+    const std::string vsBin = (outDir / (baseName + ".vs.bin")).string();
+    const std::string fsBin = (outDir / (baseName + ".fs.bin")).string();
+    const std::string metaJson = (fs::path("shaders") / "meta" / (baseName + ".json")).string();
+
+    DerivedDataCache& ddc = DerivedDataCache::Instance();
+    const std::string key = ShaderDerivedDataKey(path);
+    if (!key.empty() && ddc.Contains(key)
+        && ddc.FetchFile(key, "vs.bin", vsBin) && ddc.FetchFile(key, "fs.bin", fsBin) && ddc.FetchFile(key, "meta.json", metaJson)) {
+        meta.baseName = baseName;
+        return true;
+    }
+
+    cm::ShaderImporterContext ctx;
+    ctx.projectRoot = std::filesystem::current_path().string();
+    ctx.toolsDir = (std::filesystem::current_path() / "tools").string();
+    ctx.shadersOutRoot = (std::filesystem::current_path() / "shaders").string();
+    ctx.platform = kShaderPlatform;
+    if (!cm::ShaderImporter::ImportShader(path, ctx, meta, error)) return false;
+    if (!key.empty()) ddc.Store(key, { { "vs.bin", vsBin }, { "fs.bin", fsBin }, { "meta.json", metaJson } });
+    return true;
+}
+
+// ---------------------------------------
+// DERIVED-DATA CACHE
+// ---------------------------------------
+std::string AssetPipeline::DerivedDataKey(const std::string& path, const char* importer, uint32_t importerVersion) const {
+    const std::string hash = DerivedDataCache::HashFile(path);
+    if (hash.empty()) return {};
+    const AssetMetadata* meta = GetMetadata(path);
+    static const std::unordered_map<std::string, std::string> kNoSettings;
+    return DerivedDataCache::MakeKey(hash, importer, importerVersion, meta ? meta->settings : kNoSettings);
+}
+
+namespace {
+
+// Directories shaderc searches for #include: the project's shaders/ (-i shaders) and bgfx's src
+std::vector<fs::path> ShaderIncludeRoots() {
+    std::vector<fs::path> roots{ fs::current_path() / "shaders" };
+    fs::path bgfxInc = fs::current_path();
+    for (int i = 0; i < 10 && !fs::exists(bgfxInc / "external/bgfx/src/bgfx_shader.sh"); ++i) bgfxInc = bgfxInc.parent_path();
+    roots.push_back(bgfxInc / "external/bgfx/src");
+    return roots;
+}
+
+// Resolves every #include reachable from 'file' (its own folder first, then the include roots)
+void CollectShaderIncludes(const fs::path& file, const std::vector<fs::path>& roots, std::set<fs::path>& out, int depth = 0) {
+    std::ifstream in(file);
+    if (!in || depth > 16) return;
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t inc = line.find("#include");
+        if (inc == std::string::npos || line.find_first_not_of(" \t") != inc) continue;
+        const size_t open = line.find_first_of("\"<", inc + 8);
+        if (open == std::string::npos) continue;
+        const size_t close = line.find_first_of("\">", open + 1);
+        if (close == std::string::npos) continue;
+        const std::string name = line.substr(open + 1, close - open - 1);
+
+        std::vector<fs::path> candidates{ file.parent_path() / name, fs::current_path() / name };
+        for (const fs::path& root : roots) candidates.push_back(root / name);
+        for (const fs::path& candidate : candidates) {
+            std::error_code ec;
+            if (!fs::is_regular_file(candidate, ec)) continue;
+            const fs::path resolved = fs::weakly_canonical(candidate, ec);
+            if (out.insert(resolved).second) CollectShaderIncludes(resolved, roots, out, depth + 1);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+std::string AssetPipeline::ShaderDerivedDataKey(const std::string& path) const {
+    std::string hash = DerivedDataCache::HashFile(path);
+    if (hash.empty()) return {};
+
+    // shaderc itself: a new compiler may emit different bytecode for the same source.
+    // Hashed once per process; the tool does not change under a running editor.
+    static const std::string shadercHash = DerivedDataCache::HashFile((fs::current_path() / "tools" / "shaderc.exe").string());
+    hash += "|shaderc:" + shadercHash;
+
+    // Engine includes ShaderImporter adds (skinning to skinned vertex stages, normal map
+    // helpers to every fragment stage), the source's own #includes, and whatever those
+    // include in turn
+    const std::vector<fs::path> roots = ShaderIncludeRoots();
+    std::set<fs::path> includes;
+    for (const char* engineInclude : { "shaders/imgui/varying.def.sc", "shaders/engine/skinning.sc", "shaders/normal_map.sh" }) {
+        std::error_code ec;
+        const fs::path p = fs::current_path() / engineInclude;
+        if (fs::is_regular_file(p, ec) && includes.insert(fs::weakly_canonical(p, ec)).second) CollectShaderIncludes(p, roots, includes);
+    }
+    CollectShaderIncludes(path, roots, includes);
+    for (const fs::path& include : includes) hash += "|" + include.filename().string() + ":" + DerivedDataCache::HashFile(include.string());
+
+    const AssetMetadata* meta = GetMetadata(path);
+    static const std::unordered_map<std::string, std::string> kNoSettings;
+    return DerivedDataCache::MakeKey(hash, "shader", kShaderImporterVersion, meta ? meta->settings : kNoSettings);
+}
+
+size_t AssetPipeline::WarmCache(const std::string& rootPath, JobSystem& js) {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(rootPath, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        std::string ext = it->path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        const std::string type = DetermineType(ext);
+        if (type == "model" || type == "texture" || ext == ".shader") paths.push_back(it->path().string());
+    }
+
+    // Keys include the .meta settings, and the editor reads them from the sidecar when it
+    // imports (ImportAsset); the registry is empty in batch mode, so fill it the same way
+    for (const std::string& path : paths) {
+        try {
+            AssetMetadata meta;
+            if (ReadMetaFile(path, meta)) AssetRegistry::Instance().SetMetadata(path, meta);
+        } catch (const std::exception& e) {
+            std::cerr << "[WarmCache] " << path << ".meta: " << e.what() << std::endl;
+        }
+    }
+
+    std::atomic<size_t> imported{ 0 }, failed{ 0 }, unmatched{ 0 };
+    DerivedDataCache& ddc = DerivedDataCache::Instance();
+    parallel_for(js, size_t(0), paths.size(), size_t(1), [&](size_t s, size_t c) {
+        for (size_t i = s; i < s + c; ++i) {
+            const std::string& path = paths[i];
+            std::string ext = fs::path(path).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            const std::string type = DetermineType(ext);
+            bool ok = true;
+            if (type == "model") {
+                // EnsureModelCache restores or builds, and stores new builds in the DDC
+                BuiltModelPaths built;
+                ok = EnsureModelCache(path, built);
+            } else if (type == "texture") {
+                // Restores or cooks, and refreshes the sidecar next to the source
+                const AssetMetadata* meta = GetMetadata(path);
+                const std::unordered_map<std::string, std::string> settings = meta ? meta->settings : std::unordered_map<std::string, std::string>{};
+                ok = CookTexture(path, settings);
+                if (ok) imported++;
+                // The editor cooks with the settings it parses from the sidecar
+                AssetMetadata editorMeta;
+                if (ok && !ddc.Contains(TextureDerivedDataKey(path, ReadMetaFile(path, editorMeta) ? editorMeta.settings : settings))) {
+                    std::cerr << "[WarmCache] " << path << ": warmed under another key than the editor's" << std::endl;
+                    unmatched++;
+                }
+            } else {
+                const std::string key = ShaderDerivedDataKey(path);
+                if (key.empty() || ddc.Contains(key)) continue;
+                cm::ShaderMeta meta; std::string err;
+                ok = ImportShaderCached(path, meta, err);
+                if (ok) imported++;
+                else std::cerr << "[WarmCache] " << path << ": " << err << std::endl;
+                if (ok && !ddc.Contains(key)) {
+                    std::cerr << "[WarmCache] " << path << ": warmed under another key than the editor's" << std::endl;
+                    unmatched++;
+                }
+            }
+            if (!ok) failed++;
+        }
+    });
+
+    std::cout << "[WarmCache] " << paths.size() << " assets, " << imported.load() << " textures/shaders imported, "
+              << failed.load() << " failed, " << unmatched.load() << " under a key the editor does not use; cache "
+              << (ddc.GetSizeBytes() >> 20) << " MB" << std::endl;
+    return failed.load() + unmatched.load();
+}
+
+bool AssetPipeline::ReadMetaFile(const std::string& assetPath, AssetMetadata& meta) {
+    const std::string metaPath = assetPath + ".meta";
+    std::error_code ec;
+    if (!fs::exists(metaPath, ec)) return false;
+    std::ifstream in(metaPath);
+    if (!in) return false;
+    json j;
+    in >> j;
+    meta = j.get<AssetMetadata>();
+    return true;
+}
+
 // ---------------------------------------
 // HASH UTILITIES
 // ---------------------------------------
 std::string AssetPipeline::ComputeFileHash(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    std::ostringstream contents;
-    contents << file.rdbuf();
-    std::string data = contents.str();
-
-    unsigned char result[MD5_DIGEST_LENGTH];
-    MD5(reinterpret_cast<const unsigned char*>(data.c_str()), data.size(), result);
-
-    std::ostringstream hex;
-    for (int i = 0; i < MD5_DIGEST_LENGTH; i++)
-        hex << std::hex << std::setw(2) << std::setfill('0') << (int)result[i];
-    return hex.str();
+    return DerivedDataCache::HashFile(path);
 }
 
 std::string AssetPipeline::ComputeHash(const std::string& path) const {
@@ -867,7 +1125,7 @@ bool AssetPipeline::IsSupportedAsset(const std::string& ext) const {
     return supported.find(ext) != supported.end();
 }
 
-std::string AssetPipeline::DetermineType(const std::string& ext) {
+std::string AssetPipeline::DetermineType(const std::string& ext) const {
     if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb") return "model";
     if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga") return "texture";
     if (ext == ".sc" || ext == ".shader" || ext == ".glsl") return "shader";
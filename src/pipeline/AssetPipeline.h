@@ -9,10 +9,14 @@
 #include <rendering/ShaderManager.h>
 #include <bgfx/bgfx.h>
 #include <deque>
+#include <memory>
 
 #include "ModelImportCache.h"
 #include "ShaderImporter.h"
 
+class JobSystem;
+class ImportGraph;
+
 // ---------------------------
 // GPU Upload Job Struct
 // ---------------------------
@@ -58,9 +62,13 @@ public:
     // Editor convenience: drain all pending imports and tasks synchronously (blocking)
     void ProcessAllBlocking();
 
-    // Main-thread execution
+    // Main-thread execution. Starts queued imports as a dependency graph on the job system,
+    // then runs main-thread tasks and GPU uploads for at most the frame budget.
     void ProcessMainThreadTasks();
     void ProcessGPUUploads();
+    void SetMainThreadBudgetMs(double ms) { m_MainThreadBudgetMs = ms; }
+    // Imports still running in the background, summed over the active batches
+    void GetImportProgress(size_t& done, size_t& total) const;
     void EnqueueMainThreadTask(std::function<void()> task);
     void EnqueueGPUUpload(PendingGPUUpload&& task);
 
@@ -83,12 +91,35 @@ public:
 
     void ImportScript(const std::string& path);
 
-    // CPU-side texture pre-process for async
-    void ImportTextureCPU(const std::string& path);
+    // Cooks the texture on the import worker; the runtime loads the result (TextureLoader)
+    void ImportTextureCPU(const std::string& path, const std::unordered_map<std::string, std::string>& settings);
+    // Decoded RGBA8 source pixels
+    bool DecodeTexture(const std::string& path, int& width, int& height, std::vector<uint8_t>& pixels);
+    // Writes the GPU-ready "<path>.ktx" (TextureCooker) with the .meta 'settings', from the
+    // derived-data cache when possible
+    bool CookTexture(const std::string& path, const std::unordered_map<std::string, std::string>& settings);
+    // Derived-data cache key CookTexture uses; empty if the file cannot be read
+    std::string TextureDerivedDataKey(const std::string& path, const std::unordered_map<std::string, std::string>& settings) const;
+    // Unified .shader compile, restored from the derived-data cache when possible
+    bool ImportShaderCached(const std::string& path, cm::ShaderMeta& meta, std::string& error);
+
+    // Derived-data cache key of importing 'path' with 'importer': content hash, importer
+    // version and the asset's .meta settings. Empty if the file cannot be read.
+    std::string DerivedDataKey(const std::string& path, const char* importer, uint32_t importerVersion) const;
+    // DerivedDataKey of a .shader plus everything shaderc reads besides it: the engine
+    // includes the generated stages pull in, the source's own #includes and the shaderc binary
+    std::string ShaderDerivedDataKey(const std::string& path) const;
+    // Batch mode (--warm-cache): imports every model, texture and .shader under rootPath
+    // into the derived-data cache without touching the GPU, keyed with each asset's .meta
+    // settings like the editor. Returns the number of failures, counting textures and
+    // shaders whose entry is not under the editor's key.
+    size_t WarmCache(const std::string& rootPath, JobSystem& js);
+    // Parses the sidecar "<assetPath>.meta"; false if there is none
+    static bool ReadMetaFile(const std::string& assetPath, AssetMetadata& meta);
 
     // Utility helpers
     bool IsSupportedAsset(const std::string& ext) const;
-    std::string DetermineType(const std::string& ext);
+    std::string DetermineType(const std::string& ext) const;
     std::string ComputeHash(const std::string& path) const;
     std::string ComputeFileHash(const std::string& path);
     std::string GetCurrentTimestamp() const;
@@ -104,17 +135,27 @@ public:
     void SetScriptsCompiled(bool success) { m_ScriptsCompiled = success; }
 
 private:
+    void StartQueuedImports();
+    bool ImportsRunning();
+    void RunMainThreadWork(double budgetMs);
+    // Inputs an importer waits for: material -> shader/textures, model -> textures/materials beside it
+    std::vector<std::string> DeclareImportInputs(const std::string& path) const;
+
     bool m_ScriptsCompiled = true;
     // Queues
     std::queue<std::string> m_ImportQueue;
     std::mutex m_QueueMutex;
 
-    std::queue<std::function<void()>> m_MainThreadTasks;
+    std::deque<std::function<void()>> m_MainThreadTasks;
     std::mutex m_MainThreadQueueMutex;
 
-    std::queue<PendingGPUUpload> m_GPUUploadQueue;
+    std::deque<PendingGPUUpload> m_GPUUploadQueue;
     std::mutex m_GPUQueueMutex;
 
+    // Import batches in flight (main thread only)
+    std::vector<std::shared_ptr<ImportGraph>> m_ActiveImports;
+    double m_MainThreadBudgetMs = 4.0;
+
     // Debug: snapshot of assets collected by last ScanProject
     std::vector<std::string> m_LastScanList;
 
@@ -36,11 +36,10 @@ struct ClaymoreGUID {
         return ss.str();
     }
     
-    // Generate a new random GUID
+    // Generate a new random GUID (per-thread generator: entities are also built on job threads)
     static ClaymoreGUID Generate() {
-        static std::random_device rd;
-        static std::mt19937_64 gen(rd());
-        static std::uniform_int_distribution<uint64_t> dis;
+        thread_local std::mt19937_64 gen(std::random_device{}());
+        thread_local std::uniform_int_distribution<uint64_t> dis;
         
         return ClaymoreGUID(dis(gen), dis(gen));
     }
@@ -9,6 +9,19 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <climits>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -38,63 +51,251 @@ void AssetWatcher::Stop() {
 void AssetWatcher::WatchLoop() {
     std::cout << "[AssetWatcher] Watching: " << m_RootPath << std::endl;
 
+    // Initial registration of every asset; afterwards only changed paths are touched
+    ScanDirectory(m_RootPath);
+
+    if (!RunNativeWatch() && m_Running) {
+        std::cout << "[AssetWatcher] No change notifications available, polling every "
+                  << std::chrono::duration_cast<std::chrono::seconds>(POLL_INTERVAL).count() << " s" << std::endl;
+        PollLoop();
+    }
+}
+
+void AssetWatcher::PollLoop() {
     while (m_Running) {
-        try {
-            for (auto& entry : fs::recursive_directory_iterator(m_RootPath)) {
-                if (!entry.is_regular_file()) continue;
+        for (auto waited = std::chrono::milliseconds(0); m_Running && waited < POLL_INTERVAL; waited += WAIT_SLICE)
+            std::this_thread::sleep_for(WAIT_SLICE);
+        if (m_Running) ScanDirectory(m_RootPath);
+    }
+}
 
-                std::string filePath = entry.path().string();
-                std::string ext = entry.path().extension().string();
+void AssetWatcher::ScanDirectory(const fs::path& dir) {
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!m_Running) return;
+        if (!it->is_regular_file(ec)) continue;
+        const fs::path& path = it->path();
+        if (!m_Pipeline.IsSupportedAsset(path.extension().string())) continue;
 
-                if (!m_Pipeline.IsSupportedAsset(ext)) continue;
+        std::error_code tec;
+        auto lastWriteTime = fs::last_write_time(path, tec);
+        if (tec) continue;
+        if (HasFileChanged(path.string(), lastWriteTime)) {
+            m_Pipeline.EnqueueAssetImport(path.string());
+            RefreshMeta(path);
+        }
+    }
+    if (ec) std::cerr << "[AssetWatcher] Scan error in " << dir << ": " << ec.message() << std::endl;
+}
 
-                auto lastWriteTime = fs::last_write_time(entry);
+void AssetWatcher::NotePendingPath(const fs::path& path) {
+    m_Pending[path.string()] = std::chrono::steady_clock::now();
+}
 
-                if (HasFileChanged(filePath, lastWriteTime)) {
-                    m_Pipeline.EnqueueAssetImport(filePath);
-                }
+// Handles every path that has been quiet for SETTLE_DELAY (or all of them)
+void AssetWatcher::FlushSettledPaths(bool all) {
+    if (m_Pending.empty()) return;
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<std::string> ready;
+    for (auto it = m_Pending.begin(); it != m_Pending.end();) {
+        if (all || now - it->second >= SETTLE_DELAY) { ready.push_back(it->first); it = m_Pending.erase(it); }
+        else ++it;
+    }
+    for (const std::string& p : ready) HandleChangedPath(p);
+}
 
-                // Opportunistically refresh GUID→path registration using sidecar .meta (handles renames/moves)
-                try {
-                    // Sidecar .meta next to asset
-                    fs::path metaPath = entry.path(); metaPath += ".meta";
-                    if (fs::exists(metaPath)) {
-                        // Parse meta
-                        std::ifstream mi(metaPath.string());
-                        nlohmann::json mj; mi >> mj; mi.close();
-                        AssetMetadata meta = mj.get<AssetMetadata>();
-                        if (meta.guid.high != 0 || meta.guid.low != 0) {
-                            // Build virtual path relative to project root, normalize to forward slashes
-                            std::error_code ec;
-                            fs::path rel = fs::relative(entry.path(), Project::GetProjectDirectory(), ec);
-                            std::string vpath = (ec ? entry.path().string() : rel.string());
-                            std::replace(vpath.begin(), vpath.end(), '\\', '/');
-                            // Ensure it starts with assets/
-                            size_t pos = vpath.find("assets/");
-                            if (pos != std::string::npos) vpath = vpath.substr(pos);
-                            // Infer AssetType from extension
-                            std::string lowerExt = ext; std::transform(lowerExt.begin(), lowerExt.end(), lowerExt.begin(), ::tolower);
-                            AssetType at = AssetType::Mesh;
-                            if (lowerExt == ".fbx" || lowerExt == ".gltf" || lowerExt == ".glb" || lowerExt == ".obj") at = AssetType::Mesh;
-                            else if (lowerExt == ".png" || lowerExt == ".jpg" || lowerExt == ".jpeg" || lowerExt == ".tga") at = AssetType::Texture;
-                            else if (lowerExt == ".prefab") at = AssetType::Prefab;
-                            else if (lowerExt == ".ttf" || lowerExt == ".otf") at = AssetType::Font;
-                            // Register mapping and alias (RegisterAsset now dedupes silently)
-                            AssetLibrary::Instance().RegisterAsset(AssetReference(meta.guid, 0, static_cast<int32_t>(at)), at, vpath, entry.path().filename().string());
-                            AssetLibrary::Instance().RegisterPathAlias(meta.guid, filePath);
-                        }
-                    }
-                } catch(...) { /* silent; watcher continues */ }
+void AssetWatcher::HandleChangedPath(const fs::path& path) {
+    std::error_code ec;
+    const fs::file_status st = fs::status(path, ec);
+    if (ec || !fs::exists(st)) {
+        // Deleted or renamed away: forget it so a file reappearing there imports again
+        std::lock_guard<std::mutex> lock(m_TimestampMutex);
+        m_FileTimestamps.erase(path.string());
+        return;
+    }
+    if (fs::is_directory(st)) {
+        // Directory created or moved into the tree: its contents produced no events of their own
+        ScanDirectory(path);
+        return;
+    }
+    if (!fs::is_regular_file(st)) return;
+
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".meta") {
+        fs::path asset = path; asset.replace_extension();
+        if (!fs::exists(asset, ec)) return;
+        RefreshMeta(asset);
+        // Settings edited in the inspector or on disk: re-import the owning asset. ImportAsset
+        // returns early when the source hash and settings hash both still match, so the
+        // sidecar it writes itself after an import does not import again.
+        if (m_Pipeline.IsSupportedAsset(asset.extension().string())) m_Pipeline.EnqueueAssetImport(asset.string());
+        return;
+    }
+    if (!m_Pipeline.IsSupportedAsset(path.extension().string())) return;
+
+    auto lastWriteTime = fs::last_write_time(path, ec);
+    if (ec) return;
+    if (HasFileChanged(path.string(), lastWriteTime)) {
+        m_Pipeline.EnqueueAssetImport(path.string());
+        // New or moved assets bring their sidecar along
+        RefreshMeta(path);
+    }
+}
+
+// Refresh GUID→path registration from the sidecar .meta (handles renames/moves)
+void AssetWatcher::RefreshMeta(const fs::path& assetPath) {
+    try {
+        fs::path metaPath = assetPath; metaPath += ".meta";
+        std::error_code ec;
+        if (!fs::exists(metaPath, ec)) return;
+        std::ifstream mi(metaPath.string());
+        nlohmann::json mj; mi >> mj; mi.close();
+        AssetMetadata meta = mj.get<AssetMetadata>();
+        if (meta.guid.high == 0 && meta.guid.low == 0) return;
+
+        // Build virtual path relative to project root, normalize to forward slashes
+        fs::path rel = fs::relative(assetPath, Project::GetProjectDirectory(), ec);
+        std::string vpath = (ec ? assetPath.string() : rel.string());
+        std::replace(vpath.begin(), vpath.end(), '\\', '/');
+        // Ensure it starts with assets/
+        size_t pos = vpath.find("assets/");
+        if (pos != std::string::npos) vpath = vpath.substr(pos);
+        // Infer AssetType from extension
+        std::string lowerExt = assetPath.extension().string();
+        std::transform(lowerExt.begin(), lowerExt.end(), lowerExt.begin(), ::tolower);
+        AssetType at = AssetType::Mesh;
+        if (lowerExt == ".fbx" || lowerExt == ".gltf" || lowerExt == ".glb" || lowerExt == ".obj") at = AssetType::Mesh;
+        else if (lowerExt == ".png" || lowerExt == ".jpg" || lowerExt == ".jpeg" || lowerExt == ".tga") at = AssetType::Texture;
+        else if (lowerExt == ".prefab") at = AssetType::Prefab;
+        else if (lowerExt == ".ttf" || lowerExt == ".otf") at = AssetType::Font;
+        // Register mapping and alias (RegisterAsset now dedupes silently)
+        AssetLibrary::Instance().RegisterAsset(AssetReference(meta.guid, 0, static_cast<int32_t>(at)), at, vpath, assetPath.filename().string());
+        AssetLibrary::Instance().RegisterPathAlias(meta.guid, assetPath.string());
+    } catch(...) { /* silent; watcher continues */ }
+}
+
+#if defined(_WIN32)
+
+bool AssetWatcher::RunNativeWatch() {
+    HANDLE dir = CreateFileW(fs::path(m_RootPath).wstring().c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (dir == INVALID_HANDLE_VALUE) return false;
+    OVERLAPPED ov{};
+    ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!ov.hEvent) { CloseHandle(dir); return false; }
+
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+    std::vector<DWORD> buffer(16 * 1024); // DWORD-aligned, as the API requires
+    auto arm = [&]() {
+        ResetEvent(ov.hEvent);
+        return ReadDirectoryChangesW(dir, buffer.data(), (DWORD)(buffer.size() * sizeof(DWORD)), TRUE, filter, nullptr, &ov, nullptr) != FALSE;
+    };
+
+    bool ok = arm();
+    while (ok && m_Running) {
+        const DWORD wait = WaitForSingleObject(ov.hEvent, (DWORD)WAIT_SLICE.count());
+        if (wait == WAIT_OBJECT_0) {
+            DWORD bytes = 0;
+            if (!GetOverlappedResult(dir, &ov, &bytes, FALSE)) { ok = false; break; }
+            if (bytes == 0) {
+                // Notification buffer overflowed: changes were lost, compare against a full scan
+                m_Pending.clear();
+                ScanDirectory(m_RootPath);
+            } else {
+                for (BYTE* p = reinterpret_cast<BYTE*>(buffer.data());;) {
+                    auto* info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(p);
+                    std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                    NotePendingPath(fs::path(m_RootPath) / name);
+                    if (!info->NextEntryOffset) break;
+                    p += info->NextEntryOffset;
+                }
             }
+            ok = arm();
         }
-        catch (const std::exception& e) {
-            std::cerr << "[AssetWatcher] Error: " << e.what() << std::endl;
+        FlushSettledPaths(false);
+    }
+
+    CancelIo(dir);
+    CloseHandle(ov.hEvent);
+    CloseHandle(dir);
+    FlushSettledPaths(true);
+    return ok || !m_Running;
+}
+
+#elif defined(__linux__)
+
+bool AssetWatcher::RunNativeWatch() {
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return false;
+
+    // inotify is not recursive: one watch per directory
+    const uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    std::unordered_map<int, fs::path> watches;
+    auto addTree = [&](const fs::path& root) {
+        auto add = [&](const fs::path& d) {
+            const int wd = inotify_add_watch(fd, d.c_str(), mask);
+            if (wd >= 0) watches[wd] = d;
+            return wd >= 0;
+        };
+        if (!add(root)) return false;
+        std::error_code ec;
+        for (auto it = fs::recursive_directory_iterator(root, fs::directory_options::skip_permission_denied, ec);
+             !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_directory(ec) && !it->is_symlink(ec) && !add(it->path())) return false;
         }
+        return true;
+    };
+    if (!addTree(m_RootPath)) {
+        // Usually max_user_watches on a huge tree
+        std::cerr << "[AssetWatcher] inotify watch setup failed" << std::endl;
+        close(fd);
+        return false;
+    }
 
-        std::this_thread::sleep_for(POLL_INTERVAL);
+    alignas(struct inotify_event) char buffer[64 * 1024];
+    while (m_Running) {
+        pollfd pfd{ fd, POLLIN, 0 };
+        const int ready = poll(&pfd, 1, (int)WAIT_SLICE.count());
+        if (ready > 0 && (pfd.revents & POLLIN)) {
+            for (;;) {
+                const ssize_t len = read(fd, buffer, sizeof(buffer));
+                if (len <= 0) break;
+                for (char* p = buffer; p < buffer + len;) {
+                    const auto* ev = reinterpret_cast<const struct inotify_event*>(p);
+                    p += sizeof(struct inotify_event) + ev->len;
+                    if (ev->mask & IN_Q_OVERFLOW) {
+                        m_Pending.clear();
+                        ScanDirectory(m_RootPath);
+                        continue;
+                    }
+                    if (ev->mask & IN_IGNORED) { watches.erase(ev->wd); continue; }
+                    auto it = watches.find(ev->wd);
+                    if (it == watches.end() || ev->len == 0) continue;
+                    const fs::path path = it->second / ev->name;
+                    if ((ev->mask & IN_ISDIR) && (ev->mask & (IN_CREATE | IN_MOVED_TO))) addTree(path);
+                    NotePendingPath(path);
+                }
+            }
+        }
+        FlushSettledPaths(false);
     }
+
+    close(fd);
+    FlushSettledPaths(true);
+    return true;
+}
+
+#else
+
+bool AssetWatcher::RunNativeWatch() {
+    return false;
 }
 
+#endif
+
 bool AssetWatcher::HasFileChanged(const std::string& path, fs::file_time_type lastWriteTime) {
     std::lock_guard<std::mutex> lock(m_TimestampMutex);
 
@@ -9,6 +9,14 @@
 
 class AssetPipeline;
 
+// Watches the project tree and feeds changed assets to AssetPipeline::EnqueueAssetImport.
+//
+// One recursive scan at start-up registers every asset; after that the OS reports
+// changes (ReadDirectoryChangesW on Windows, inotify on Linux). Events are coalesced
+// per path until the path has been quiet for SETTLE_DELAY, so an editor's burst of
+// writes or a save-via-rename imports once. Sidecar .meta files are parsed only when
+// they or their asset change. Platforms without a native backend, or a backend that
+// fails to start, fall back to polling every POLL_INTERVAL.
 class AssetWatcher {
 public:
     AssetWatcher(AssetPipeline& pipeline, const std::string& rootPath);
@@ -21,6 +29,16 @@ public:
 
 private:
     void WatchLoop();
+    void PollLoop();
+    bool RunNativeWatch();
+
+    // Walks 'dir' recursively; enqueues new or modified assets and registers their .meta
+    void ScanDirectory(const std::filesystem::path& dir);
+    // Called for a path once its events have settled
+    void HandleChangedPath(const std::filesystem::path& path);
+    void NotePendingPath(const std::filesystem::path& path);
+    void FlushSettledPaths(bool all);
+    void RefreshMeta(const std::filesystem::path& assetPath);
     bool HasFileChanged(const std::string& path, std::filesystem::file_time_type lastWriteTime);
 
     AssetPipeline& m_Pipeline;
@@ -31,5 +49,10 @@ private:
     std::unordered_map<std::string, std::filesystem::file_time_type> m_FileTimestamps;
     std::mutex m_TimestampMutex;
 
+    // Paths with events not yet handled -> time of their latest event (watch thread only)
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_Pending;
+
     static constexpr auto POLL_INTERVAL = std::chrono::seconds(2);
+    static constexpr auto SETTLE_DELAY = std::chrono::milliseconds(150);
+    static constexpr auto WAIT_SLICE = std::chrono::milliseconds(50);
 };
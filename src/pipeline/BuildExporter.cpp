@@ -1,8 +1,11 @@
 #include "BuildExporter.h"
-#include "PakArchive.h"
+#include "PakWriter.h"
+#include "TextureCooker.h"
+#include "DerivedDataCache.h"
 #include "AssetMetadata.h"
 #include "AssetRegistry.h"
 #include <serialization/Serializer.h>
+#include <serialization/SceneBinary.h>
 #include <editor/Project.h>
 #include <nlohmann/json.hpp>
 #include <filesystem>
@@ -10,6 +13,7 @@
 #include <unordered_set>
 
 #include "pipeline/AssetLibrary.h"
+#include "jobs/Jobs.h"
 
 namespace fs = std::filesystem;
 using json = nlohmann::json;
@@ -68,6 +72,18 @@ static const std::vector<std::string> kExts = {
     ".mat", ".json", ".prefab"
 };
 
+static bool IsCookableTexture(const std::string& s) {
+    auto ext = fs::path(s).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga";
+}
+
+static bool IsSceneDocument(const std::string& s) {
+    auto ext = fs::path(s).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".scene" || ext == ".prefab";
+}
+
 static bool LooksLikeAssetPath(const std::string& s) {
     fs::path p(s);
     auto ext = p.extension().string();
@@ -99,9 +115,8 @@ void BuildExporter::CollectSceneDependencies(const std::string& scenePath,
                                              std::vector<std::string>& outFiles)
 {
     AddIfExists(scenePath, outFiles);
-    std::ifstream in(scenePath);
-    if (!in.is_open()) return;
-    json j; in >> j;
+    json j;
+    if (!Serializer::ReadSceneFile(scenePath, j)) return;
     CollectPathsFromJson(j, outFiles);
 }
 
@@ -198,30 +213,57 @@ bool BuildExporter::ExportProject(const Options& opts) {
         if (uniqueFiles.insert(f).second) dedup.push_back(f);
     }
 
-    // Build .pak
-    PakArchive pak;
+    // Resolve project name with sensible fallback
+    std::string projName = Project::GetProjectName();
+    if (projName.empty()) {
+        fs::path projDir = Project::GetProjectDirectory();
+        if (!projDir.empty()) projName = projDir.filename().string();
+        if (projName.empty()) projName = "Game";
+    }
+
+    // Build .pak: entries are streamed from their sources by PakWriter, not loaded here
+    PakWriter pak;
     // Prepare manifest with entry scene virtual path (if any)
     std::string entrySceneVPath;
     if (!opts.entryScenes.empty()) {
         const std::string& first = opts.entryScenes.front();
         entrySceneVPath = MakeVirtualPath(fs::path(first));
     }
+    const std::string kCompiledPrefix = "shaders/compiled/windows/";
+    size_t cookedTextures = 0, binaryScenes = 0;
     for (const auto& f : dedup) {
-        std::ifstream in(f, std::ios::binary);
-        if (!in.is_open()) {
-            std::cerr << "[BuildExporter] Warning: Could not open file: " << f << std::endl;
-            continue;
-        }
-        in.seekg(0, std::ios::end);
-        size_t size = static_cast<size_t>(in.tellg());
-        in.seekg(0, std::ios::beg);
-        std::vector<uint8_t> data(size);
-        if (size != 0) in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
-
         // Virtual path within pak
         std::string vpath = MakeVirtualPath(fs::path(f));
-        pak.AddFile(vpath, data);
-        std::cout << "[BuildExporter] Added to pak: " << vpath << " (" << size << " bytes)" << std::endl;
+        // Textures ship cooked in place of their source; TextureLoader asks for "<path>.ktx" first
+        if (IsCookableTexture(f)) {
+            const std::string cooked = TextureCooker::CookedPath(f);
+            std::error_code srcEc, cookedEc;
+            const auto srcTime = fs::last_write_time(f, srcEc);
+            const auto cookedTime = fs::last_write_time(cooked, cookedEc);
+            if (!srcEc && !cookedEc && cookedTime >= srcTime) {
+                pak.AddFile(TextureCooker::CookedPath(vpath), cooked);
+                ++cookedTextures;
+                continue;
+            }
+            std::cerr << "[BuildExporter] WARNING: no up-to-date cooked texture for " << f << ", shipping the source" << std::endl;
+        }
+        // Scenes and prefabs ship binary under their own path; loaders tell the formats apart
+        if (opts.binaryScenes && IsSceneDocument(f)) {
+            json document;
+            std::vector<uint8_t> encoded;
+            std::string error;
+            if (Serializer::ReadSceneFile(f, document) && scenebin::Encode(document, encoded, &error)) {
+                pak.AddBytes(vpath, std::move(encoded));
+                ++binaryScenes;
+                continue;
+            }
+            std::cerr << "[BuildExporter] WARNING: could not convert " << f << " to binary" << (error.empty() ? "" : ": " + error)
+                      << ", shipping the source" << std::endl;
+        }
+        pak.AddFile(vpath, f);
+        // Runtime asks for shaders/<name>.bin as well; resolve it with one lookup
+        if (vpath.rfind(kCompiledPrefix, 0) == 0)
+            pak.AddAlias("shaders/" + vpath.substr(kCompiledPrefix.size()), vpath);
     }
 
     // Add simple manifest
@@ -229,21 +271,26 @@ bool BuildExporter::ExportProject(const Options& opts) {
         json manifest;
         manifest["entryScene"] = entrySceneVPath;
         if (!assetMap.empty()) manifest["assetMap"] = assetMap;
+        manifest["physics"] = { { "fixedHz", Project::GetPhysicsHz() }, { "maxSubsteps", Project::GetPhysicsMaxSubsteps() } };
         std::string text = manifest.dump(0);
-        std::vector<uint8_t> bytes(text.begin(), text.end());
-        pak.AddFile("game_manifest.json", bytes);
+        pak.AddBytes("game_manifest.json", std::vector<uint8_t>(text.begin(), text.end()));
     }
 
-    fs::create_directories(opts.outputDirectory);
-    // Resolve project name with sensible fallback
-    std::string projName = Project::GetProjectName();
-    if (projName.empty()) {
-        fs::path projDir = Project::GetProjectDirectory();
-        if (!projDir.empty()) projName = projDir.filename().string();
-        if (projName.empty()) projName = "Game";
+    // Incremental: unchanged files are kept from the previous export's pak, patched in place when possible
+    if (opts.incremental) {
+        fs::path info = fs::path(DerivedDataCache::Instance().GetRoot()) / "export" / (projName + ".pak.json");
+        pak.SetBuildInfo(info.string());
     }
+
+    fs::create_directories(opts.outputDirectory);
     fs::path pakOut = fs::path(opts.outputDirectory) / (projName + ".pak");
-    if (!pak.SaveToFile(pakOut.string())) return false;
+    PakWriter::Stats pakStats;
+    if (!pak.Write(pakOut.string(), &Jobs(), &pakStats)) return false;
+    std::cout << "[BuildExporter] Wrote " << pakOut.string() << ": " << pakStats.entries << " entries ("
+              << pakStats.compressed << " packed, " << pakStats.reused << " reused, " << pakStats.deduplicated
+              << " duplicates" << (pakStats.patched ? ", patched in place" : "") << "), " << pakStats.rawBytes << " -> " << pakStats.storedBytes << " bytes" << std::endl;
+    std::cout << "[BuildExporter] Cooked textures shipped: " << cookedTextures << std::endl;
+    std::cout << "[BuildExporter] Binary scenes/prefabs shipped: " << binaryScenes << std::endl;
 
     // Copy runtime executable and required DLLs next to pak, configured via manifest
     fs::path runtimeDir = exeDir;
@@ -11,6 +11,8 @@ public:
         std::string outputDirectory; // where to place MyGame.exe and MyGame.pak
         std::vector<std::string> entryScenes; // absolute or project-relative scene paths to include
         bool includeAllAssets = false; // debug switch
+        bool incremental = true; // reuse unchanged entries from the previous export's pak
+        bool binaryScenes = true; // ship scenes and prefabs in the binary encoding (SceneBinary.h)
     };
 
     // High-level: export current project as standalone
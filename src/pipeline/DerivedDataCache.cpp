@@ -0,0 +1,282 @@
+#include "DerivedDataCache.h"
+#include "editor/Project.h"
+#include <openssl/md5.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::string ToHex(const unsigned char* digest, size_t n) {
+        std::ostringstream hex;
+        for (size_t i = 0; i < n; ++i)
+            hex << std::hex << std::setw(2) << std::setfill('0') << (int)digest[i];
+        return hex.str();
+    }
+
+    int64_t NowTicks() {
+        return fs::file_time_type::clock::now().time_since_epoch().count();
+    }
+
+    uint64_t DirectoryBytes(const fs::path& dir) {
+        uint64_t total = 0;
+        std::error_code ec;
+        for (auto it = fs::directory_iterator(dir, ec); !ec && it != fs::directory_iterator(); it.increment(ec)) {
+            if (it->is_regular_file(ec)) total += it->file_size(ec);
+        }
+        return total;
+    }
+
+    bool CopyAtomic(const fs::path& from, const fs::path& to) {
+        std::error_code ec;
+        if (to.has_parent_path()) fs::create_directories(to.parent_path(), ec);
+        fs::path tmp = to; tmp += ".ddctmp";
+        if (!fs::copy_file(from, tmp, fs::copy_options::overwrite_existing, ec)) return false;
+        fs::rename(tmp, to, ec);
+        if (ec) { fs::remove(tmp, ec); return false; }
+        return true;
+    }
+
+    // Settings sorted so the text does not depend on map iteration order
+    std::string SettingsText(const std::unordered_map<std::string, std::string>& settings) {
+        std::vector<std::pair<std::string, std::string>> sorted(settings.begin(), settings.end());
+        std::sort(sorted.begin(), sorted.end());
+        std::string text;
+        for (const auto& kv : sorted) text += "|" + kv.first + "=" + kv.second;
+        return text;
+    }
+
+    std::string HashText(const std::string& text) {
+        unsigned char digest[MD5_DIGEST_LENGTH];
+        MD5(reinterpret_cast<const unsigned char*>(text.data()), text.size(), digest);
+        return ToHex(digest, MD5_DIGEST_LENGTH);
+    }
+}
+
+bool DerivedDataCache::Open(const std::string& root, uint64_t maxBytes) {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    return OpenLocked(root, maxBytes);
+}
+
+bool DerivedDataCache::OpenLocked(const std::string& root, uint64_t maxBytes) {
+    m_Root = root;
+    m_MaxBytes = maxBytes;
+    m_TotalBytes = 0;
+    m_Entries.clear();
+
+    std::error_code ec;
+    fs::create_directories(root, ec);
+    if (ec) {
+        std::cerr << "[DDC] Cannot create cache directory: " << root << std::endl;
+        return false;
+    }
+    // Leftovers of interrupted stores
+    fs::remove_all(fs::path(root) / "tmp", ec);
+
+    for (auto shard = fs::directory_iterator(root, ec); !ec && shard != fs::directory_iterator(); shard.increment(ec)) {
+        if (!shard->is_directory(ec) || shard->path().filename().string().size() != 2) continue;
+        std::error_code ec2;
+        for (auto it = fs::directory_iterator(shard->path(), ec2); !ec2 && it != fs::directory_iterator(); it.increment(ec2)) {
+            if (!it->is_directory(ec2)) continue;
+            Entry e;
+            e.bytes = DirectoryBytes(it->path());
+            e.lastUse = fs::last_write_time(it->path(), ec2).time_since_epoch().count();
+            m_TotalBytes += e.bytes;
+            m_Entries[it->path().filename().string()] = e;
+        }
+    }
+    TrimLocked();
+    std::cout << "[DDC] " << m_Entries.size() << " entries, " << (m_TotalBytes >> 20) << " MB in " << root << std::endl;
+    return true;
+}
+
+void DerivedDataCache::SetMaxBytes(uint64_t maxBytes) {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    m_MaxBytes = maxBytes;
+    TrimLocked();
+}
+
+const std::string& DerivedDataCache::GetRoot() {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    EnsureOpenLocked();
+    return m_Root;
+}
+
+uint64_t DerivedDataCache::GetSizeBytes() {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    return m_TotalBytes;
+}
+
+void DerivedDataCache::EnsureOpenLocked() {
+    if (!m_Root.empty()) return;
+    fs::path base = Project::GetProjectDirectory();
+    if (base.empty()) base = fs::current_path();
+    OpenLocked((base / "DerivedDataCache").string(), m_MaxBytes);
+}
+
+std::string DerivedDataCache::EntryDir(const std::string& key) const {
+    return (fs::path(m_Root) / key.substr(0, 2) / key).string();
+}
+
+std::string DerivedDataCache::HashFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return {};
+    MD5_CTX ctx;
+    MD5_Init(&ctx);
+    std::vector<char> buf(1 << 16);
+    while (in) {
+        in.read(buf.data(), (std::streamsize)buf.size());
+        if (in.gcount() > 0) MD5_Update(&ctx, buf.data(), (size_t)in.gcount());
+    }
+    unsigned char digest[MD5_DIGEST_LENGTH];
+    MD5_Final(digest, &ctx);
+    return ToHex(digest, MD5_DIGEST_LENGTH);
+}
+
+std::string DerivedDataCache::MakeKey(const std::string& contentHash, const std::string& importer, uint32_t importerVersion,
+                                      const std::unordered_map<std::string, std::string>& settings) {
+    return HashText(contentHash + "|" + importer + "|" + std::to_string(importerVersion) + SettingsText(settings));
+}
+
+std::string DerivedDataCache::HashSettings(const std::unordered_map<std::string, std::string>& settings) {
+    return HashText(SettingsText(settings));
+}
+
+void DerivedDataCache::TouchLocked(const std::string& key) {
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) return;
+    it->second.lastUse = NowTicks();
+    // Persist recency for the next session's LRU order
+    std::error_code ec;
+    fs::last_write_time(EntryDir(key), fs::file_time_type::clock::now(), ec);
+}
+
+bool DerivedDataCache::Contains(const std::string& key) {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    EnsureOpenLocked();
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) return false;
+    std::error_code ec;
+    if (!fs::is_directory(EntryDir(key), ec)) {
+        // Removed behind our back
+        m_TotalBytes -= std::min(m_TotalBytes, it->second.bytes);
+        m_Entries.erase(it);
+        return false;
+    }
+    TouchLocked(key);
+    return true;
+}
+
+bool DerivedDataCache::FetchFile(const std::string& key, const std::string& name, const std::string& destPath) {
+    std::string dir;
+    {
+        std::lock_guard<std::mutex> lk(m_Mutex);
+        EnsureOpenLocked();
+        if (m_Entries.find(key) == m_Entries.end()) return false;
+        TouchLocked(key);
+        dir = EntryDir(key);
+    }
+    return CopyAtomic(fs::path(dir) / name, destPath);
+}
+
+bool DerivedDataCache::FetchBlob(const std::string& key, const std::string& name, std::vector<uint8_t>& out) {
+    std::string dir;
+    {
+        std::lock_guard<std::mutex> lk(m_Mutex);
+        EnsureOpenLocked();
+        if (m_Entries.find(key) == m_Entries.end()) return false;
+        TouchLocked(key);
+        dir = EntryDir(key);
+    }
+    std::ifstream in(fs::path(dir) / name, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamoff size = in.tellg();
+    if (size < 0) return false;
+    out.resize((size_t)size);
+    in.seekg(0);
+    return size == 0 || (bool)in.read(reinterpret_cast<char*>(out.data()), size);
+}
+
+bool DerivedDataCache::Store(const std::string& key, const std::vector<Item>& items) {
+    std::string tmpDir, finalDir;
+    {
+        std::lock_guard<std::mutex> lk(m_Mutex);
+        EnsureOpenLocked();
+        tmpDir = (fs::path(m_Root) / "tmp" / (key + "-" + std::to_string(++m_TempCounter))).string();
+        finalDir = EntryDir(key);
+    }
+
+    std::error_code ec;
+    fs::create_directories(tmpDir, ec);
+    if (ec) return false;
+    uint64_t bytes = 0;
+    bool ok = true;
+    for (const Item& item : items) {
+        const fs::path dst = fs::path(tmpDir) / item.name;
+        if (!item.path.empty()) {
+            ok = fs::copy_file(item.path, dst, fs::copy_options::overwrite_existing, ec);
+        } else if (item.bytes) {
+            std::ofstream of(dst, std::ios::binary | std::ios::trunc);
+            of.write(reinterpret_cast<const char*>(item.bytes->data()), (std::streamsize)item.bytes->size());
+            ok = (bool)of;
+        }
+        if (!ok) break;
+        bytes += fs::file_size(dst, ec);
+    }
+
+    if (ok) {
+        fs::create_directories(fs::path(finalDir).parent_path(), ec);
+        fs::rename(tmpDir, finalDir, ec);
+        // Another writer stored the same key first: same inputs, same outputs
+        if (ec) ok = fs::is_directory(finalDir);
+    }
+    fs::remove_all(tmpDir, ec);
+    if (!ok) {
+        std::cerr << "[DDC] Store failed for " << key << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    Entry& e = m_Entries[key];
+    m_TotalBytes = m_TotalBytes - std::min(m_TotalBytes, e.bytes) + bytes;
+    e.bytes = bytes;
+    e.lastUse = NowTicks();
+    TrimLocked();
+    return true;
+}
+
+bool DerivedDataCache::StoreBlob(const std::string& key, const std::string& name, const std::vector<uint8_t>& bytes) {
+    Item item;
+    item.name = name;
+    item.bytes = &bytes;
+    return Store(key, { item });
+}
+
+void DerivedDataCache::Trim() {
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    TrimLocked();
+}
+
+void DerivedDataCache::TrimLocked() {
+    if (m_TotalBytes <= m_MaxBytes) return;
+    std::vector<std::pair<int64_t, std::string>> byAge;
+    byAge.reserve(m_Entries.size());
+    for (const auto& kv : m_Entries) byAge.emplace_back(kv.second.lastUse, kv.first);
+    std::sort(byAge.begin(), byAge.end());
+
+    size_t evicted = 0;
+    for (const auto& [lastUse, key] : byAge) {
+        if (m_TotalBytes <= m_MaxBytes) break;
+        std::error_code ec;
+        fs::remove_all(EntryDir(key), ec);
+        auto it = m_Entries.find(key);
+        m_TotalBytes -= std::min(m_TotalBytes, it->second.bytes);
+        m_Entries.erase(it);
+        ++evicted;
+    }
+    std::cout << "[DDC] Evicted " << evicted << " entries, " << (m_TotalBytes >> 20) << " MB remain" << std::endl;
+}
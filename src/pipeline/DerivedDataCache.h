@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Project-local derived-data cache (DDC): importer outputs keyed by what they were
+// derived from, so a fresh checkout, branch switch or touched file only re-imports
+// assets whose content or import settings actually changed.
+//
+//   key   = MD5(source content hash, importer name, importer version, import settings)
+//   entry = <root>/<key[0..1]>/<key>/<name>...   (one directory per key, named files)
+//
+// Entries are written to a temp directory and renamed into place, so readers never
+// see a partial entry and concurrent writers of the same key are harmless. Lookups
+// refresh the entry's timestamp; Store() evicts least recently used entries once the
+// cache exceeds its size cap. Thread-safe.
+class DerivedDataCache {
+public:
+    static DerivedDataCache& Instance() {
+        static DerivedDataCache instance;
+        return instance;
+    }
+
+    static constexpr uint64_t kDefaultMaxBytes = 4ull << 30;
+
+    // Opens (or creates) the cache at 'root' and indexes the entries already there.
+    // Until called, the first use opens <project>/DerivedDataCache.
+    bool Open(const std::string& root, uint64_t maxBytes = kDefaultMaxBytes);
+    void SetMaxBytes(uint64_t maxBytes);
+    const std::string& GetRoot();
+    uint64_t GetSizeBytes();
+
+    // Hex MD5 of a file's contents; empty if the file cannot be read
+    static std::string HashFile(const std::string& path);
+    static std::string MakeKey(const std::string& contentHash, const std::string& importer, uint32_t importerVersion,
+                               const std::unordered_map<std::string, std::string>& settings);
+    // Hex MD5 of import settings, independent of map order (AssetMetadata::settingsHash)
+    static std::string HashSettings(const std::unordered_map<std::string, std::string>& settings);
+
+    // Whether 'key' is cached; counts as a use
+    bool Contains(const std::string& key);
+    // Copies a stored file to 'destPath' (write-then-rename)
+    bool FetchFile(const std::string& key, const std::string& name, const std::string& destPath);
+    bool FetchBlob(const std::string& key, const std::string& name, std::vector<uint8_t>& out);
+
+    // One named file of an entry: copied from 'path', or 'bytes' when path is empty
+    struct Item {
+        std::string name;
+        std::string path;
+        const std::vector<uint8_t>* bytes = nullptr;
+    };
+    bool Store(const std::string& key, const std::vector<Item>& items);
+    bool StoreBlob(const std::string& key, const std::string& name, const std::vector<uint8_t>& bytes);
+
+    // Evicts least recently used entries until the cache fits its cap
+    void Trim();
+
+private:
+    DerivedDataCache() = default;
+
+    struct Entry {
+        uint64_t bytes = 0;
+        int64_t lastUse = 0; // file_time ticks
+    };
+
+    bool OpenLocked(const std::string& root, uint64_t maxBytes);
+    void EnsureOpenLocked();
+    std::string EntryDir(const std::string& key) const;
+    void TouchLocked(const std::string& key);
+    void TrimLocked();
+
+    std::mutex m_Mutex;
+    std::string m_Root;
+    uint64_t m_MaxBytes = kDefaultMaxBytes;
+    uint64_t m_TotalBytes = 0;
+    uint64_t m_TempCounter = 0;
+    std::unordered_map<std::string, Entry> m_Entries;
+};
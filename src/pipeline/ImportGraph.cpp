@@ -0,0 +1,86 @@
+#include "ImportGraph.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <iostream>
+
+std::string ImportGraph::NormalizeKey(const std::string& path) {
+    std::string key = path;
+    std::replace(key.begin(), key.end(), '\\', '/');
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    return key;
+}
+
+size_t ImportGraph::Add(const std::string& key, Task task) {
+    const std::string norm = NormalizeKey(key);
+    auto it = m_Index.find(norm);
+    if (it != m_Index.end()) return it->second;
+    auto node = std::make_unique<Node>();
+    node->task = std::move(task);
+    m_Nodes.push_back(std::move(node));
+    m_Index.emplace(norm, m_Nodes.size() - 1);
+    return m_Nodes.size() - 1;
+}
+
+size_t ImportGraph::Find(const std::string& key) const {
+    auto it = m_Index.find(NormalizeKey(key));
+    return it != m_Index.end() ? it->second : SIZE_MAX;
+}
+
+// True if 'from' (transitively) waits for 'to'
+bool ImportGraph::Reaches(size_t from, size_t to) const {
+    std::vector<size_t> stack{ from };
+    std::vector<bool> seen(m_Nodes.size(), false);
+    while (!stack.empty()) {
+        const size_t n = stack.back(); stack.pop_back();
+        if (n == to) return true;
+        if (seen[n]) continue;
+        seen[n] = true;
+        for (size_t in : m_Nodes[n]->inputs) stack.push_back(in);
+    }
+    return false;
+}
+
+void ImportGraph::AddDependency(size_t node, size_t input) {
+    if (node == input || node >= m_Nodes.size() || input >= m_Nodes.size()) return;
+    Node& n = *m_Nodes[node];
+    if (std::find(n.inputs.begin(), n.inputs.end(), input) != n.inputs.end()) return;
+    if (Reaches(input, node)) {
+        std::cerr << "[ImportGraph] Ignoring cyclic import dependency" << std::endl;
+        return;
+    }
+    n.inputs.push_back(input);
+    n.pending.fetch_add(1, std::memory_order_relaxed);
+    m_Nodes[input]->dependents.push_back(node);
+}
+
+void ImportGraph::Run(JobSystem& js) {
+    // Snapshot the roots before launching any: once a root finishes, a worker drops its
+    // dependents' pending to 0 and launches them itself, so a scan that interleaves with
+    // launching would start those nodes a second time
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < m_Nodes.size(); ++i)
+        if (m_Nodes[i]->pending.load(std::memory_order_relaxed) == 0) ready.push_back(i);
+    m_Running.store(true, std::memory_order_release);
+    for (size_t i : ready) Launch(js, i);
+}
+
+void ImportGraph::Launch(JobSystem& js, size_t node) {
+    auto body = [self = shared_from_this(), js = &js, node]() {
+        Node& n = *self->m_Nodes[node];
+        try {
+            if (n.task) n.task();
+        } catch (const std::exception& e) {
+            std::cerr << "[ImportGraph] Import threw: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "[ImportGraph] Import threw unknown exception" << std::endl;
+        }
+        n.task = nullptr;
+        // Dependents are released even if this import failed; they report their own errors
+        for (size_t d : n.dependents)
+            if (self->m_Nodes[d]->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) self->Launch(*js, d);
+        self->m_Completed.fetch_add(1, std::memory_order_acq_rel);
+    };
+    // Background lane, so frame-time waits never run an import. System shutting
+    // down: finish inline so the batch still completes
+    if (!js.EnqueueBackground(body)) body();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+// Dependency graph of one batch of asset imports, executed on the job system.
+//
+// Each node is one asset's CPU import. A node starts once every node it depends
+// on has finished (e.g. a material after its shader and textures), so independent
+// imports run side by side on the workers. Nodes go to the job system's background
+// lane (JobSystem::EnqueueBackground), which frame-time waits never drain. Run()
+// only launches the ready nodes and returns; the rest are launched by the workers
+// as their inputs complete. Keep the graph alive through a shared_ptr until IsDone().
+class ImportGraph : public std::enable_shared_from_this<ImportGraph> {
+public:
+    using Task = std::function<void()>;
+
+    // Adds the import of 'key' (normalized path); adding the same key again returns the existing node
+    size_t Add(const std::string& key, Task task);
+    // Node index of 'key', or SIZE_MAX if it is not part of this batch
+    size_t Find(const std::string& key) const;
+    // 'node' waits for 'input'. Call before Run(), from one thread at a time (it need not be
+    // the one that called Add); edges that would close a cycle are dropped.
+    void AddDependency(size_t node, size_t input);
+
+    void Run(JobSystem& js);
+
+    size_t Total() const { return m_Nodes.size(); }
+    size_t Completed() const { return m_Completed.load(std::memory_order_acquire); }
+    // False until Run(), so a graph whose edges are still being added is never reported done
+    bool IsDone() const { return m_Running.load(std::memory_order_acquire) && Completed() >= Total(); }
+
+    static std::string NormalizeKey(const std::string& path);
+
+private:
+    struct Node {
+        Task task;
+        std::vector<size_t> dependents;
+        std::vector<size_t> inputs;
+        std::atomic<uint32_t> pending{ 0 };
+    };
+
+    bool Reaches(size_t from, size_t to) const;
+    void Launch(JobSystem& js, size_t node);
+
+    std::vector<std::unique_ptr<Node>> m_Nodes;
+    std::unordered_map<std::string, size_t> m_Index;
+    std::atomic<size_t> m_Completed{ 0 };
+    std::atomic<bool> m_Running{ false };
+};
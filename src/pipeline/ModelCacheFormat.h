@@ -0,0 +1,184 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// On-disk layout of the model import cache written by BuildModelCacheBlocking():
+//   .meshbin  vertex/index streams, bounds, skin weights, blend-shape deltas, materials, node transforms
+//   .skelbin  bone names, parents and inverse bind poses
+//   .animbin  one clip of bone tracks
+// Every file is a fixed header followed by 16-byte aligned sections addressed by
+// BinRange (byte offset from the start of the file). The files are meant to be
+// memory-mapped: the interleaved GPU vertex stream and the index stream are in
+// upload format and go to bgfx::makeRef as-is. Strings live in one table per file
+// and are referenced by byte offset (NUL-terminated). Little-endian only.
+namespace modelcache {
+
+constexpr uint32_t kMeshBinMagic = 0x424D4D43; // "CMMB"
+constexpr uint32_t kSkelBinMagic = 0x42534D43; // "CMSB"
+constexpr uint32_t kAnimBinMagic = 0x42414D43; // "CMAB"
+// Bump on any layout change; EnsureModelCache rebuilds caches with another version.
+constexpr uint32_t kVersion = 2;
+constexpr uint64_t kAlignment = 16;
+
+// Import options baked into the data (ModelLoader's global axis flips)
+enum ImportFlags : uint32_t {
+    ImportFlipY      = 1u << 0,
+    ImportFlipZ      = 1u << 1,
+    ImportRotateY180 = 1u << 2,
+};
+
+struct BinRange {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+struct MeshBinHeader {
+    uint32_t magic = kMeshBinMagic;
+    uint32_t version = kVersion;
+    uint32_t importFlags = 0;
+    uint32_t meshCount = 0;
+    uint32_t materialCount = 0;
+    uint32_t animationCount = 0;   // clips in the source; their .animbin files are listed in the .meta
+    uint32_t reserved[2] = {};
+    float    rootTransform[16] = {}; // column-major
+    BinRange meshes;               // MeshBinMesh[meshCount]
+    BinRange materials;            // MeshBinMaterial[materialCount]
+    BinRange strings;
+};
+
+enum MeshFlags : uint32_t {
+    MeshSkinned = 1u << 0,   // gpuVertices holds SkinnedPBRVertex, else PBRVertex
+    MeshIndex32 = 1u << 1,   // indices are uint32, else uint16
+};
+
+struct MeshBinMesh {
+    uint32_t name = 0;             // string offsets
+    uint32_t nodeName = 0;
+    uint32_t flags = 0;
+    uint32_t materialIndex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t blendShapeCount = 0;
+    uint32_t reserved = 0;
+    float    transform[16] = {};   // relative to the model root, column-major
+    float    boundsMin[3] = {};
+    float    boundsMax[3] = {};
+    BinRange gpuVertices;          // interleaved, upload-ready
+    BinRange indices;              // upload-ready
+    BinRange positions;            // glm::vec3[vertexCount]  (CPU copies for picking, bounds, morphs)
+    BinRange normals;              // glm::vec3[vertexCount]
+    BinRange uvs;                  // glm::vec2[vertexCount]
+    BinRange boneWeights;          // glm::vec4[vertexCount], skinned only
+    BinRange boneIndices;          // glm::ivec4[vertexCount], skinned only
+    BinRange blendShapes;          // MeshBinBlendShape[blendShapeCount]
+};
+
+struct MeshBinBlendShape {
+    uint32_t name = 0;
+    uint32_t reserved = 0;
+    BinRange deltaPositions;       // glm::vec3[vertexCount]
+    BinRange deltaNormals;         // glm::vec3[vertexCount]
+};
+
+struct MeshBinMaterial {
+    uint32_t albedo = 0;           // source texture paths as authored (resolved at load)
+    uint32_t metallicRoughness = 0;
+    uint32_t normal = 0;
+    uint32_t hasTint = 0;
+    float    tint[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+struct SkelBinHeader {
+    uint32_t magic = kSkelBinMagic;
+    uint32_t version = kVersion;
+    uint32_t boneCount = 0;
+    uint32_t reserved = 0;
+    BinRange names;                // uint32 string offsets [boneCount]
+    BinRange parents;              // int32 [boneCount], -1 for roots
+    BinRange inverseBindPoses;     // glm::mat4 [boneCount]
+    BinRange strings;
+};
+
+struct AnimBinHeader {
+    uint32_t magic = kAnimBinMagic;
+    uint32_t version = kVersion;
+    uint32_t trackCount = 0;
+    uint32_t name = 0;
+    float    length = 0.0f;
+    float    fps = 30.0f;
+    uint32_t reserved[2] = {};
+    BinRange tracks;               // AnimBinTrack[trackCount]
+    BinRange strings;
+};
+
+struct AnimBinKeyVec3 { float t; float v[3]; };
+struct AnimBinKeyQuat { float t; float v[4]; }; // x, y, z, w
+
+struct AnimBinTrack {
+    uint32_t name = 0;             // bone (node) name
+    uint32_t reserved = 0;
+    BinRange translation;          // AnimBinKeyVec3[]
+    BinRange rotation;             // AnimBinKeyQuat[]
+    BinRange scale;                // AnimBinKeyVec3[]
+};
+
+// Builds a cache file in memory: a header slot, then aligned sections, then the string table.
+class BinWriter {
+public:
+    explicit BinWriter(size_t headerSize) : m_Bytes(Align(headerSize), 0) {}
+
+    BinRange Append(const void* data, size_t size) {
+        BinRange r{ m_Bytes.size(), size };
+        if (size) m_Bytes.insert(m_Bytes.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        m_Bytes.resize(Align(m_Bytes.size()), 0);
+        return r;
+    }
+    template<class T>
+    BinRange Append(const std::vector<T>& v) { return Append(v.data(), v.size() * sizeof(T)); }
+
+    // Reserves an aligned section to be filled in place later (e.g. a record table)
+    BinRange Reserve(size_t size) {
+        BinRange r{ m_Bytes.size(), size };
+        m_Bytes.resize(Align(m_Bytes.size() + size), 0);
+        return r;
+    }
+
+    uint32_t String(const std::string& s) {
+        const uint32_t offset = static_cast<uint32_t>(m_Strings.size());
+        m_Strings.insert(m_Strings.end(), s.begin(), s.end());
+        m_Strings.push_back('\0');
+        return offset;
+    }
+    BinRange FinishStrings() { return Append(m_Strings.data(), m_Strings.size()); }
+
+    uint8_t* At(uint64_t offset) { return m_Bytes.data() + offset; }
+    template<class T>
+    void SetHeader(const T& header) { std::memcpy(m_Bytes.data(), &header, sizeof(T)); }
+    const std::vector<uint8_t>& Bytes() const { return m_Bytes; }
+
+private:
+    static size_t Align(size_t n) { return (n + (kAlignment - 1)) & ~size_t(kAlignment - 1); }
+
+    std::vector<uint8_t> m_Bytes;
+    std::vector<char> m_Strings;
+};
+
+// Bounds-checked views into a mapped cache file
+inline bool RangeValid(const BinRange& r, size_t fileSize) {
+    return r.offset <= fileSize && r.size <= fileSize - r.offset;
+}
+
+inline const char* StringAt(const uint8_t* file, const BinRange& strings, uint32_t offset) {
+    if (offset >= strings.size) return "";
+    return reinterpret_cast<const char*>(file + strings.offset + offset);
+}
+
+template<class T>
+const T* ArrayAt(const uint8_t* file, size_t fileSize, const BinRange& r, size_t count) {
+    if (!RangeValid(r, fileSize) || r.size < count * sizeof(T)) return nullptr;
+    return reinterpret_cast<const T*>(file + r.offset);
+}
+
+} // namespace modelcache
@@ -1,108 +1,333 @@
 #include "ModelImportCache.h"
+#include "ModelCacheFormat.h"
+#include "DerivedDataCache.h"
+#include "AssetRegistry.h"
+#include "io/MappedFile.h"
+#include "rendering/ModelLoader.h"
+#include "animation/AnimationAsset.h"
+#include "animation/AnimationSerializer.h"
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <mutex>
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
-// Minimal stubbed implementation to establish the API and file outputs.
-// The full Assimp-based build and binary writers can be incrementally filled in.
+// Binary model cache next to the source file:
+//   <stem>.meshbin, <stem>.skelbin, <stem>_<n>.animbin  (layouts in ModelCacheFormat.h)
+//   <stem>.meta                                          (JSON index of the above)
+// Built from one ModelLoader::ImportModel pass; loaded with ModelLoader::LoadModelCache.
+// Freshness is decided by the derived-data key (source content hash, cache format version,
+// import options) recorded in the meta, not by timestamps; builds are also stored in the
+// DerivedDataCache so a checkout or branch switch restores them without re-importing.
 
 namespace {
     using json = nlohmann::json;
     std::mutex g_modelCacheMutex;
 
-    static inline bool EndsWith(const std::string& s, const std::string& suf) {
-        if (s.size() < suf.size()) return false;
-        return std::equal(suf.rbegin(), suf.rend(), s.rbegin(),
-            [](char a, char b){ return ::tolower(a) == ::tolower(b); });
-    }
-
     static std::string ToForwardSlashes(std::string p) {
         std::replace(p.begin(), p.end(), '\\', '/');
         return p;
     }
+
+    static uint32_t CurrentImportFlags() {
+        uint32_t flags = 0;
+        if (ModelLoader::GetFlipYAxis()) flags |= modelcache::ImportFlipY;
+        if (ModelLoader::GetFlipZAxis()) flags |= modelcache::ImportFlipZ;
+        if (ModelLoader::GetRotateY180()) flags |= modelcache::ImportRotateY180;
+        return flags;
+    }
+
+    static void FillPaths(const std::filesystem::path& src, BuiltModelPaths& out) {
+        std::filesystem::path baseDir = src.parent_path();
+        std::string stem = src.stem().string();
+        out.metaPath = (baseDir / (stem + ".meta")).string();
+        out.skelPath = (baseDir / (stem + ".skelbin")).string();
+        out.meshPath = (baseDir / (stem + ".meshbin")).string();
+        out.animPaths.clear();
+    }
+
+    // Writes next to the target and renames over it, so a reader never maps a half-written file
+    static bool WriteFileAtomic(const std::string& path, const std::vector<uint8_t>& bytes) {
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream of(tmp, std::ios::binary | std::ios::trunc);
+            if (!of.is_open()) return false;
+            of.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!of) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) { std::filesystem::remove(tmp, ec); return false; }
+        return true;
+    }
+
+    // Header of an existing .meshbin matches this build and the current import options
+    static bool MeshBinCurrent(const std::string& meshPath) {
+        std::ifstream in(meshPath, std::ios::binary);
+        modelcache::MeshBinHeader h;
+        if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) return false;
+        return h.magic == modelcache::kMeshBinMagic && h.version == modelcache::kVersion
+            && h.importFlags == CurrentImportFlags();
+    }
+
+    // Derived-data key of the cache files for this source; empty if it cannot be read
+    static std::string ModelCacheKey(const std::string& sourceModelPath) {
+        const std::string hash = DerivedDataCache::HashFile(sourceModelPath);
+        if (hash.empty()) return {};
+        std::unordered_map<std::string, std::string> settings;
+        if (const AssetMetadata* meta = AssetRegistry::Instance().GetMetadata(sourceModelPath)) settings = meta->settings;
+        settings["importFlags"] = std::to_string(CurrentImportFlags());
+        return DerivedDataCache::MakeKey(hash, "model", modelcache::kVersion, settings);
+    }
+
+    static std::string AnimBinPath(const std::filesystem::path& src, size_t index) {
+        return (src.parent_path() / (src.stem().string() + "_" + std::to_string(index) + ".animbin")).string();
+    }
+
+    // Mesh node names recorded in a .meshbin, for rewriting the meta after a DDC restore
+    static bool ReadMeshNodeNames(const std::string& meshPath, std::vector<std::string>& names) {
+        using namespace modelcache;
+        MappedFile file;
+        if (!file.Open(meshPath) || file.Size() < sizeof(MeshBinHeader)) return false;
+        const uint8_t* base = file.Data();
+        MeshBinHeader h;
+        std::memcpy(&h, base, sizeof(h));
+        if (h.magic != kMeshBinMagic || h.version != kVersion) return false;
+        const MeshBinMesh* meshes = ArrayAt<MeshBinMesh>(base, file.Size(), h.meshes, h.meshCount);
+        if (!meshes || !RangeValid(h.strings, file.Size())) return false;
+        names.clear();
+        for (uint32_t i = 0; i < h.meshCount; ++i) names.push_back(StringAt(base, h.strings, meshes[i].nodeName));
+        return true;
+    }
 }
 
-static bool WriteTinyMeta(const std::string& sourceModelPath, const BuiltModelPaths& out) {
+static std::vector<uint8_t> EncodeMeshBin(const ImportedModel& model) {
+    using namespace modelcache;
+    BinWriter w(sizeof(MeshBinHeader));
+    MeshBinHeader h;
+    h.importFlags = CurrentImportFlags();
+    h.meshCount = static_cast<uint32_t>(model.Meshes.size());
+    h.materialCount = static_cast<uint32_t>(model.Materials.size());
+    h.animationCount = model.AnimationCount;
+    std::memcpy(h.rootTransform, glm::value_ptr(model.RootTransform), sizeof(h.rootTransform));
+    h.meshes = w.Reserve(sizeof(MeshBinMesh) * model.Meshes.size());
+    h.materials = w.Reserve(sizeof(MeshBinMaterial) * model.Materials.size());
+
+    std::vector<MeshBinMesh> meshes(model.Meshes.size());
+    std::vector<uint8_t> stream;
+    std::vector<MeshBinBlendShape> shapes;
+    for (size_t i = 0; i < model.Meshes.size(); ++i) {
+        const ImportedMesh& m = model.Meshes[i];
+        MeshBinMesh& r = meshes[i];
+        r.name = w.String(m.Name);
+        r.nodeName = w.String(m.NodeName);
+        r.materialIndex = m.MaterialIndex;
+        r.vertexCount = static_cast<uint32_t>(m.Positions.size());
+        r.indexCount = static_cast<uint32_t>(m.Indices.size());
+        r.blendShapeCount = static_cast<uint32_t>(m.BlendShapes.size());
+        std::memcpy(r.transform, glm::value_ptr(m.Transform), sizeof(r.transform));
+
+        glm::vec3 bmin(0.0f), bmax(0.0f);
+        if (!m.Positions.empty()) {
+            bmin = glm::vec3(std::numeric_limits<float>::max());
+            bmax = glm::vec3(std::numeric_limits<float>::lowest());
+            for (const glm::vec3& p : m.Positions) { bmin = glm::min(bmin, p); bmax = glm::max(bmax, p); }
+        }
+        std::memcpy(r.boundsMin, glm::value_ptr(bmin), sizeof(r.boundsMin));
+        std::memcpy(r.boundsMax, glm::value_ptr(bmax), sizeof(r.boundsMax));
+
+        ModelLoader::PackVertexStream(m, stream);
+        r.gpuVertices = w.Append(stream);
+        if (ModelLoader::PackIndexStream(m, stream)) r.flags |= MeshIndex32;
+        r.indices = w.Append(stream);
+        r.positions = w.Append(m.Positions);
+        r.normals = w.Append(m.Normals);
+        r.uvs = w.Append(m.UVs);
+        if (m.Skinned) {
+            r.flags |= MeshSkinned;
+            r.boneWeights = w.Append(m.BoneWeights);
+            r.boneIndices = w.Append(m.BoneIndices);
+        }
+
+        shapes.assign(m.BlendShapes.size(), MeshBinBlendShape{});
+        for (size_t s = 0; s < m.BlendShapes.size(); ++s) {
+            shapes[s].name = w.String(m.BlendShapes[s].Name);
+            shapes[s].deltaPositions = w.Append(m.BlendShapes[s].DeltaPos);
+            shapes[s].deltaNormals = w.Append(m.BlendShapes[s].DeltaNormal);
+        }
+        r.blendShapes = w.Append(shapes);
+    }
+
+    std::vector<MeshBinMaterial> materials(model.Materials.size());
+    for (size_t i = 0; i < model.Materials.size(); ++i) {
+        const ImportedMaterial& m = model.Materials[i];
+        materials[i].albedo = w.String(m.AlbedoPath);
+        materials[i].metallicRoughness = w.String(m.MetallicRoughnessPath);
+        materials[i].normal = w.String(m.NormalPath);
+        materials[i].hasTint = m.HasTint ? 1u : 0u;
+        std::memcpy(materials[i].tint, glm::value_ptr(m.ColorTint), sizeof(materials[i].tint));
+    }
+
+    if (!meshes.empty()) std::memcpy(w.At(h.meshes.offset), meshes.data(), sizeof(MeshBinMesh) * meshes.size());
+    if (!materials.empty()) std::memcpy(w.At(h.materials.offset), materials.data(), sizeof(MeshBinMaterial) * materials.size());
+    h.strings = w.FinishStrings();
+    w.SetHeader(h);
+    return w.Bytes();
+}
+
+static std::vector<uint8_t> EncodeSkelBin(const ImportedModel& model) {
+    using namespace modelcache;
+    BinWriter w(sizeof(SkelBinHeader));
+    SkelBinHeader h;
+    h.boneCount = static_cast<uint32_t>(model.BoneNames.size());
+    std::vector<uint32_t> names;
+    names.reserve(model.BoneNames.size());
+    for (const std::string& n : model.BoneNames) names.push_back(w.String(n));
+    std::vector<int32_t> parents(model.BoneParents.begin(), model.BoneParents.end());
+    h.names = w.Append(names);
+    h.parents = w.Append(parents);
+    h.inverseBindPoses = w.Append(model.InverseBindPoses);
+    h.strings = w.FinishStrings();
+    w.SetHeader(h);
+    return w.Bytes();
+}
+
+static bool WriteMeta(const std::string& sourceModelPath, const std::vector<std::string>& meshNodeNames,
+                      const std::string& key, const BuiltModelPaths& out) {
     try {
         json j;
-        j["version"] = 1;
+        j["version"] = modelcache::kVersion;
+        j["key"] = key;
         j["source"] = ToForwardSlashes(sourceModelPath);
         j["skeleton"] = ToForwardSlashes(out.skelPath);
-        // Minimal meshes list with a single submesh entry mapping fileID 0
         j["meshes"] = json::array();
-        j["meshes"].push_back({ {"fileID", 0}, {"mesh", ToForwardSlashes(out.meshPath + "#0")} });
+        for (size_t i = 0; i < meshNodeNames.size(); ++i) {
+            j["meshes"].push_back({ {"fileID", i},
+                                    {"mesh", ToForwardSlashes(out.meshPath + "#" + std::to_string(i))},
+                                    {"name", meshNodeNames[i]} });
+        }
         j["animations"] = json::array();
+        for (const std::string& a : out.animPaths) j["animations"].push_back(ToForwardSlashes(a));
 
-        std::ofstream of(out.metaPath, std::ios::binary | std::ios::trunc);
-        if (!of.is_open()) return false;
-        of << j.dump(4);
-        return true;
+        const std::string text = j.dump(4);
+        return WriteFileAtomic(out.metaPath, std::vector<uint8_t>(text.begin(), text.end()));
     } catch (...) {
         return false;
     }
 }
 
-bool EnsureModelCache(const std::string& sourceModelPath, BuiltModelPaths& out) {
+// Reads the derived-data key and the .animbin files recorded in an existing meta
+static std::string ReadMeta(BuiltModelPaths& out) {
+    try {
+        std::ifstream in(out.metaPath);
+        if (!in.is_open()) return {};
+        json j; in >> j;
+        if (j.contains("animations") && j["animations"].is_array())
+            for (const auto& a : j["animations"]) if (a.is_string()) out.animPaths.push_back(a.get<std::string>());
+        return j.value("key", std::string());
+    } catch (...) {
+        return {};
+    }
+}
+
+// Copies a cached build of 'key' next to the source and rewrites the meta for this path
+static bool RestoreFromDerivedData(const std::string& sourceModelPath, const std::string& key, BuiltModelPaths& out) {
     namespace fs = std::filesystem;
+    DerivedDataCache& ddc = DerivedDataCache::Instance();
+    if (!ddc.Contains(key)) return false;
     fs::path src(sourceModelPath);
-    if (!fs::exists(src)) return false;
+    if (!ddc.FetchFile(key, "mesh.meshbin", out.meshPath) || !ddc.FetchFile(key, "skel.skelbin", out.skelPath)) return false;
+    for (size_t i = 0;; ++i) {
+        const std::string animPath = AnimBinPath(src, i);
+        if (!ddc.FetchFile(key, "anim_" + std::to_string(i) + ".animbin", animPath)) break;
+        out.animPaths.push_back(animPath);
+    }
+    std::vector<std::string> nodeNames;
+    if (!ReadMeshNodeNames(out.meshPath, nodeNames)) return false;
+    if (!WriteMeta(sourceModelPath, nodeNames, key, out)) return false;
+    std::cout << "[ModelImportCache] Restored from derived-data cache: " << sourceModelPath << "\n";
+    return true;
+}
 
-    fs::path baseDir = src.parent_path();
-    fs::path stem = src.stem();
+static bool BuildModelCache(const std::string& sourceModelPath, const std::string& key, BuiltModelPaths& out);
 
-    out.metaPath = (baseDir / (stem.string() + ".meta")).string();
-    out.skelPath = (baseDir / (stem.string() + ".skelbin")).string();
-    out.meshPath = (baseDir / (stem.string() + ".meshbin")).string();
+bool EnsureModelCache(const std::string& sourceModelPath, BuiltModelPaths& out) {
+    namespace fs = std::filesystem;
+    fs::path src(sourceModelPath);
+    if (!fs::exists(src)) return false;
+    FillPaths(src, out);
 
-    // If all files exist and are newer than source, consider up-to-date.
-    auto upToDate = [&](const fs::path& p) {
-        if (!fs::exists(p)) return false;
-        auto tSrc = fs::last_write_time(src);
-        auto tP = fs::last_write_time(p);
-        return tP >= tSrc;
-    };
+    // Up to date when the meta was written for the same content and import options
+    // (touching the source or checking it out again does not invalidate it).
+    const std::string key = ModelCacheKey(sourceModelPath);
+    if (key.empty()) return false;
+    std::error_code ec;
+    if (ReadMeta(out) == key && fs::exists(out.skelPath, ec) && MeshBinCurrent(out.meshPath))
+        return true;
 
-    bool ok = upToDate(out.metaPath) && upToDate(out.skelPath) && upToDate(out.meshPath);
-    if (ok) return true;
+    out.animPaths.clear();
+    if (RestoreFromDerivedData(sourceModelPath, key, out)) return true;
 
     // Otherwise, build now (blocking in caller thread).
-    return BuildModelCacheBlocking(sourceModelPath, out);
+    return BuildModelCache(sourceModelPath, key, out);
 }
 
 bool BuildModelCacheBlocking(const std::string& sourceModelPath, BuiltModelPaths& out) {
+    const std::string key = ModelCacheKey(sourceModelPath);
+    if (key.empty()) return false;
+    return BuildModelCache(sourceModelPath, key, out);
+}
+
+static bool BuildModelCache(const std::string& sourceModelPath, const std::string& key, BuiltModelPaths& out) {
     namespace fs = std::filesystem;
     try {
         std::lock_guard<std::mutex> lk(g_modelCacheMutex);
         fs::path src(sourceModelPath);
         if (!fs::exists(src)) return false;
-        fs::path baseDir = src.parent_path();
-        fs::path stem = src.stem();
+        FillPaths(src, out);
+        {
+            std::error_code ec; fs::create_directories(src.parent_path(), ec);
+        }
 
-        out.metaPath = (baseDir / (stem.string() + ".meta")).string();
-        out.skelPath = (baseDir / (stem.string() + ".skelbin")).string();
-        out.meshPath = (baseDir / (stem.string() + ".meshbin")).string();
+        ImportedModel model;
+        std::vector<cm::animation::AnimationAsset> animations;
+        if (!ModelLoader::ImportModel(sourceModelPath, model, &animations)) return false;
 
-        // TODO: Integrate Assimp parse via existing ModelLoader here; for now, create placeholder binaries.
-        // Ensure directory exists
-        {
-            std::error_code ec; fs::create_directories(baseDir, ec);
+        if (!WriteFileAtomic(out.meshPath, EncodeMeshBin(model))) {
+            std::cerr << "[ModelImportCache] Cannot write meshbin: " << out.meshPath << "\n";
+            return false;
         }
-        {
-            std::ofstream skel(out.skelPath, std::ios::binary | std::ios::trunc);
-            if (!skel.is_open()) { std::cerr << "[ModelImportCache] Cannot open skelbin: " << out.skelPath << "\n"; return false; }
-            uint32_t jointCount = 0u;
-            skel.write(reinterpret_cast<const char*>(&jointCount), sizeof(jointCount));
+        if (!WriteFileAtomic(out.skelPath, EncodeSkelBin(model))) {
+            std::cerr << "[ModelImportCache] Cannot write skelbin: " << out.skelPath << "\n";
+            return false;
         }
-        {
-            std::ofstream mesh(out.meshPath, std::ios::binary | std::ios::trunc);
-            if (!mesh.is_open()) { std::cerr << "[ModelImportCache] Cannot open meshbin: " << out.meshPath << "\n"; return false; }
-            uint32_t submeshCount = 0u;
-            mesh.write(reinterpret_cast<const char*>(&submeshCount), sizeof(submeshCount));
+        for (size_t i = 0; i < animations.size(); ++i) {
+            const std::string animPath = AnimBinPath(src, i);
+            const std::string tmp = animPath + ".tmp";
+            std::error_code ec;
+            if (!cm::animation::SaveAnimationBin(animations[i], tmp)) {
+                std::cerr << "[ModelImportCache] Cannot write animbin: " << animPath << "\n";
+                continue;
+            }
+            fs::rename(tmp, animPath, ec);
+            if (!ec) out.animPaths.push_back(animPath);
         }
-        if (!WriteTinyMeta(sourceModelPath, out)) return false;
+        // Meta last: its key marks the cache complete
+        std::vector<std::string> nodeNames;
+        for (const ImportedMesh& m : model.Meshes) nodeNames.push_back(m.NodeName);
+        if (!WriteMeta(sourceModelPath, nodeNames, key, out)) return false;
+
+        // Share the build through the derived-data cache
+        std::vector<DerivedDataCache::Item> items;
+        items.push_back({ "mesh.meshbin", out.meshPath });
+        items.push_back({ "skel.skelbin", out.skelPath });
+        for (size_t i = 0; i < out.animPaths.size(); ++i)
+            items.push_back({ "anim_" + std::to_string(i) + ".animbin", out.animPaths[i] });
+        DerivedDataCache::Instance().Store(key, items);
 
         return true;
     } catch (const std::exception& e) {
@@ -113,5 +338,3 @@ bool BuildModelCacheBlocking(const std::string& sourceModelPath, BuiltModelPaths
         return false;
     }
 }
-
-
@@ -1,106 +1,276 @@
 #include "PakArchive.h"
-#include <fstream>
-#include <filesystem>
+#include "jobs/ParallelFor.h"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#ifdef CLAYMORE_WITH_LZ4
+#include <lz4.h>
+#endif
+#ifdef CLAYMORE_WITH_ZSTD
+#include <zstd.h>
+#endif
 
 namespace {
-    constexpr uint32_t kPakVersion = 1;
+    constexpr uint32_t kPakVersionV1 = 1;
     constexpr char kMagic[4] = {'C','L','Y','P'};
-}
+    constexpr uint32_t kEmptyBucket = 0;
 
-void PakArchive::AddFile(const std::string& virtualPath, const std::vector<uint8_t>& data) {
-    m_Files.push_back({ virtualPath, data });
+    bool DecompressChunk(PakArchive::Codec codec, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+        // Chunks that did not compress are stored as is
+        if (srcSize == dstSize) {
+            std::memcpy(dst, src, dstSize);
+            return true;
+        }
+        switch (codec) {
+#ifdef CLAYMORE_WITH_LZ4
+        case PakArchive::Codec::LZ4:
+            return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                       static_cast<int>(srcSize), static_cast<int>(dstSize)) == static_cast<int>(dstSize);
+#endif
+#ifdef CLAYMORE_WITH_ZSTD
+        case PakArchive::Codec::Zstd: {
+            size_t n = ZSTD_decompress(dst, dstSize, src, srcSize);
+            return !ZSTD_isError(n) && n == dstSize;
+        }
+#endif
+        default:
+            (void)src; (void)srcSize; (void)dst; (void)dstSize;
+            return false;
+        }
+    }
 }
 
-bool PakArchive::SaveToFile(const std::string& pakPath) const {
-    std::ofstream out(pakPath, std::ios::binary | std::ios::trunc);
-    if (!out.is_open()) return false;
-
-    // Write header
-    out.write(kMagic, 4);
-    uint32_t version = kPakVersion;
-    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
-
-    uint32_t fileCount = static_cast<uint32_t>(m_Files.size());
-    out.write(reinterpret_cast<const char*>(&fileCount), sizeof(fileCount));
-
-    // Reserve space for table; compute offsets as we go
-    // We'll first compute the starting offset after the table
-    // Table size = sum over files of (4 + pathLen + 8 + 8)
-    uint64_t tableSize = 0;
-    for (const auto& f : m_Files) {
-        tableSize += 4 + static_cast<uint32_t>(f.path.size()) + 8 + 8;
+uint64_t PakArchive::HashPath(std::string_view path) {
+    // FNV-1a 64
+    uint64_t h = 14695981039346656037ull;
+    for (char c : path) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 1099511628211ull;
     }
-    const uint64_t headerSize = 4 + 4 + 4 + tableSize;
-
-    uint64_t runningOffset = headerSize;
-    // Write table
-    for (const auto& f : m_Files) {
-        uint32_t pathLen = static_cast<uint32_t>(f.path.size());
-        out.write(reinterpret_cast<const char*>(&pathLen), sizeof(pathLen));
-        out.write(f.path.data(), pathLen);
-        out.write(reinterpret_cast<const char*>(&runningOffset), sizeof(runningOffset));
-        uint64_t size = static_cast<uint64_t>(f.data.size());
-        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        runningOffset += size;
+    return h;
+}
+
+bool PakArchive::IsCodecAvailable(Codec codec) {
+    switch (codec) {
+    case Codec::None: return true;
+#ifdef CLAYMORE_WITH_LZ4
+    case Codec::LZ4: return true;
+#endif
+#ifdef CLAYMORE_WITH_ZSTD
+    case Codec::Zstd: return true;
+#endif
+    default: return false;
     }
+}
 
-    // Write blobs
-    for (const auto& f : m_Files) {
-        if (!f.data.empty())
-            out.write(reinterpret_cast<const char*>(f.data.data()), static_cast<std::streamsize>(f.data.size()));
+std::vector<uint32_t> PakArchive::BuildBuckets(const std::vector<Record>& records) {
+    size_t n = 1;
+    while (n < records.size() * 2) n <<= 1;
+    std::vector<uint32_t> buckets(n, kEmptyBucket);
+    const size_t mask = n - 1;
+    for (size_t i = 0; i < records.size(); ++i) {
+        size_t b = static_cast<size_t>(records[i].hash) & mask;
+        while (buckets[b] != kEmptyBucket) b = (b + 1) & mask;
+        buckets[b] = static_cast<uint32_t>(i + 1);
     }
+    return buckets;
+}
 
-    return true;
+void PakArchive::Close() {
+    m_Map.Close();
+    m_Version = 0;
+    m_Records = nullptr;
+    m_Buckets = nullptr;
+    m_ChunkSizes = nullptr;
+    m_Paths = nullptr;
+    m_Count = m_BucketCount = m_ChunkCount = m_PathBytes = 0;
+    m_ChunkSize = kChunkSize;
+    m_V1Records.clear();
+    m_V1Buckets.clear();
+    m_V1Paths.clear();
 }
 
 bool PakArchive::Open(const std::string& pakPath) {
-    m_Index.clear();
-    m_PakPath = pakPath;
+    Close();
+    if (!m_Map.Open(pakPath)) return false;
 
-    std::ifstream in(pakPath, std::ios::binary);
-    if (!in.is_open()) return false;
+    const uint8_t* base = m_Map.Data();
+    if (m_Map.Size() < 12 || std::memcmp(base, kMagic, 4) != 0) { Close(); return false; }
+    std::memcpy(&m_Version, base + 4, sizeof(m_Version));
 
-    char magic[4] = {};
-    in.read(magic, 4);
-    if (std::memcmp(magic, kMagic, 4) != 0) return false;
+    bool ok = false;
+    if (m_Version == kVersion) ok = OpenV2();
+    else if (m_Version == kPakVersionV1) ok = OpenV1();
+    if (!ok) Close();
+    return ok;
+}
 
-    uint32_t version = 0;
-    in.read(reinterpret_cast<char*>(&version), sizeof(version));
-    if (version != kPakVersion) return false;
+bool PakArchive::OpenV2() {
+    const uint8_t* base = m_Map.Data();
+    const uint64_t fileSize = m_Map.Size();
+    if (fileSize < sizeof(Header)) return false;
+    Header h;
+    std::memcpy(&h, base, sizeof(Header));
 
-    uint32_t fileCount = 0;
-    in.read(reinterpret_cast<char*>(&fileCount), sizeof(fileCount));
+    auto inside = [&](uint64_t offset, uint64_t bytes) { return offset <= fileSize && bytes <= fileSize - offset; };
+    if ((h.recordsOffset | h.bucketsOffset | h.chunksOffset) % 8 != 0) return false;
+    if (!inside(h.recordsOffset, uint64_t(h.count) * sizeof(Record))) return false;
+    if (!inside(h.bucketsOffset, uint64_t(h.bucketCount) * sizeof(uint32_t))) return false;
+    if (!inside(h.chunksOffset, uint64_t(h.chunkCount) * sizeof(uint32_t))) return false;
+    if (!inside(h.pathsOffset, h.pathBytes)) return false;
+    if (h.bucketCount == 0 || (h.bucketCount & (h.bucketCount - 1)) != 0 || h.chunkSize == 0) return false;
 
+    m_Records = reinterpret_cast<const Record*>(base + h.recordsOffset);
+    m_Buckets = reinterpret_cast<const uint32_t*>(base + h.bucketsOffset);
+    m_ChunkSizes = reinterpret_cast<const uint32_t*>(base + h.chunksOffset);
+    m_Paths = reinterpret_cast<const char*>(base + h.pathsOffset);
+    m_Count = h.count;
+    m_BucketCount = h.bucketCount;
+    m_ChunkCount = h.chunkCount;
+    m_PathBytes = static_cast<size_t>(h.pathBytes);
+    m_ChunkSize = h.chunkSize;
+    return true;
+}
+
+bool PakArchive::OpenV1() {
+    const uint8_t* base = m_Map.Data();
+    const size_t fileSize = m_Map.Size();
+    size_t pos = 8;
+    auto readU32 = [&](uint32_t& v) {
+        if (fileSize - pos < sizeof(v)) return false;
+        std::memcpy(&v, base + pos, sizeof(v)); pos += sizeof(v); return true;
+    };
+    auto readU64 = [&](uint64_t& v) {
+        if (fileSize - pos < sizeof(v)) return false;
+        std::memcpy(&v, base + pos, sizeof(v)); pos += sizeof(v); return true;
+    };
+
+    uint32_t fileCount = 0;
+    if (!readU32(fileCount)) return false;
+    std::unordered_map<std::string_view, bool> seen;
+    m_V1Records.reserve(fileCount);
     for (uint32_t i = 0; i < fileCount; ++i) {
         uint32_t pathLen = 0;
-        in.read(reinterpret_cast<char*>(&pathLen), sizeof(pathLen));
-        std::string path;
-        path.resize(pathLen);
-        if (pathLen) in.read(path.data(), pathLen);
-        Entry e{};
-        in.read(reinterpret_cast<char*>(&e.offset), sizeof(e.offset));
-        in.read(reinterpret_cast<char*>(&e.size), sizeof(e.size));
-        m_Index.emplace(std::move(path), e);
+        if (!readU32(pathLen) || fileSize - pos < pathLen) return false;
+        std::string_view path(reinterpret_cast<const char*>(base + pos), pathLen);
+        pos += pathLen;
+        Record r{};
+        if (!readU64(r.offset) || !readU64(r.storedSize)) return false;
+        if (!seen.emplace(path, true).second) continue;
+        r.rawSize = r.storedSize;
+        r.hash = HashPath(path);
+        r.pathOffset = static_cast<uint32_t>(m_V1Paths.size());
+        r.pathLen = pathLen;
+        r.codec = static_cast<uint32_t>(Codec::None);
+        m_V1Paths.append(path);
+        m_V1Records.push_back(r);
     }
+    m_V1Buckets = BuildBuckets(m_V1Records);
+
+    m_Records = m_V1Records.data();
+    m_Buckets = m_V1Buckets.data();
+    m_Paths = m_V1Paths.data();
+    m_Count = m_V1Records.size();
+    m_BucketCount = m_V1Buckets.size();
+    m_PathBytes = m_V1Paths.size();
     return true;
 }
 
-bool PakArchive::Contains(const std::string& virtualPath) const {
-    return m_Index.find(virtualPath) != m_Index.end();
+std::string_view PakArchive::PathOf(const Record& r) const {
+    if (r.pathOffset > m_PathBytes || r.pathLen > m_PathBytes - r.pathOffset) return {};
+    return std::string_view(m_Paths + r.pathOffset, r.pathLen);
 }
 
-bool PakArchive::ReadFile(const std::string& virtualPath, std::vector<uint8_t>& outData) const {
-    auto it = m_Index.find(virtualPath);
-    if (it == m_Index.end()) return false;
-    const Entry& e = it->second;
+const PakArchive::Record* PakArchive::Find(std::string_view virtualPath) const {
+    if (m_BucketCount == 0) return nullptr;
+    const uint64_t h = HashPath(virtualPath);
+    const size_t mask = m_BucketCount - 1;
+    size_t b = static_cast<size_t>(h) & mask;
+    for (size_t probe = 0; probe < m_BucketCount; ++probe, b = (b + 1) & mask) {
+        const uint32_t slot = m_Buckets[b];
+        if (slot == kEmptyBucket) return nullptr;
+        if (slot > m_Count) return nullptr;
+        const Record& r = m_Records[slot - 1];
+        if (r.hash == h && PathOf(r) == virtualPath) return &r;
+    }
+    return nullptr;
+}
+
+bool PakArchive::Contains(std::string_view virtualPath) const {
+    return Find(virtualPath) != nullptr;
+}
 
-    std::ifstream in(m_PakPath, std::ios::binary);
-    if (!in.is_open()) return false;
-    in.seekg(static_cast<std::streamoff>(e.offset), std::ios::beg);
-    outData.resize(static_cast<size_t>(e.size));
-    if (e.size != 0) in.read(reinterpret_cast<char*>(outData.data()), static_cast<std::streamsize>(e.size));
+bool PakArchive::ReadFileView(std::string_view virtualPath, View& outView) const {
+    const Record* r = Find(virtualPath);
+    if (!r || r->codec != static_cast<uint32_t>(Codec::None)) return false;
+    if (r->offset > m_Map.Size() || r->storedSize > m_Map.Size() - r->offset) return false;
+    outView.data = r->storedSize ? m_Map.Data() + r->offset : nullptr;
+    outView.size = static_cast<size_t>(r->storedSize);
+    return true;
+}
+
+bool PakArchive::GetStoredEntry(std::string_view virtualPath, StoredEntry& out) const {
+    const Record* r = Find(virtualPath);
+    if (!r) return false;
+    if (r->offset > m_Map.Size() || r->storedSize > m_Map.Size() - r->offset) return false;
+    out = StoredEntry{};
+    out.data = m_Map.Data() + r->offset;
+    out.offset = r->offset;
+    out.storedSize = r->storedSize;
+    out.rawSize = r->rawSize;
+    out.codec = static_cast<Codec>(r->codec);
+    if (out.codec != Codec::None) {
+        out.chunkCount = static_cast<size_t>((r->rawSize + m_ChunkSize - 1) / m_ChunkSize);
+        if (r->firstChunk > m_ChunkCount || out.chunkCount > m_ChunkCount - r->firstChunk) return false;
+        out.chunkSizes = m_ChunkSizes + r->firstChunk;
+    }
     return true;
 }
 
+bool PakArchive::ReadFile(std::string_view virtualPath, std::vector<uint8_t>& outData, JobSystem* js) const {
+    const Record* r = Find(virtualPath);
+    if (!r) return false;
+    if (r->offset > m_Map.Size() || r->storedSize > m_Map.Size() - r->offset) return false;
+    const uint8_t* src = m_Map.Data() + r->offset;
 
+    const Codec codec = static_cast<Codec>(r->codec);
+    if (codec == Codec::None) {
+        outData.assign(src, src + r->storedSize);
+        return true;
+    }
+    if (!IsCodecAvailable(codec)) {
+        std::cerr << "[PakArchive] " << PathOf(*r) << " uses a codec this build does not include" << std::endl;
+        return false;
+    }
+
+    const size_t chunkCount = static_cast<size_t>((r->rawSize + m_ChunkSize - 1) / m_ChunkSize);
+    if (r->firstChunk > m_ChunkCount || chunkCount > m_ChunkCount - r->firstChunk) return false;
+    std::vector<uint64_t> chunkOffset(chunkCount + 1, 0);
+    for (size_t c = 0; c < chunkCount; ++c)
+        chunkOffset[c + 1] = chunkOffset[c] + m_ChunkSizes[r->firstChunk + c];
+    if (chunkOffset[chunkCount] != r->storedSize) return false;
+
+    outData.resize(static_cast<size_t>(r->rawSize));
+    std::atomic<bool> failed{ false };
+    auto decode = [&](size_t start, size_t count) {
+        for (size_t c = start; c < start + count; ++c) {
+            const size_t rawPos = c * m_ChunkSize;
+            const size_t rawLen = std::min<size_t>(m_ChunkSize, outData.size() - rawPos);
+            if (!DecompressChunk(codec, src + chunkOffset[c], static_cast<size_t>(chunkOffset[c + 1] - chunkOffset[c]),
+                                 outData.data() + rawPos, rawLen))
+                failed.store(true, std::memory_order_relaxed);
+        }
+    };
+    if (js && chunkCount > 1) parallel_for(*js, 0, chunkCount, 1, decode);
+    else decode(0, chunkCount);
+
+    if (failed.load()) {
+        std::cerr << "[PakArchive] Corrupt entry: " << PathOf(*r) << std::endl;
+        outData.clear();
+        return false;
+    }
+    return true;
+}
@@ -1,48 +1,125 @@
 #pragma once
 #include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
+#include "io/MappedFile.h"
 
-// Simple uncompressed .pak archive format:
-// [magic: "CLYP" 4 bytes]
-// [version: uint32 = 1]
-// [fileCount: uint32]
-// repeated fileCount times:
-//   [pathLen: uint32]
-//   [path bytes UTF-8]
-//   [offset: uint64]
-//   [size: uint64]
-// [blob data...]
+class JobSystem;
 
+// .pak archive reader (written by PakWriter).
+//
+// v2 layout (all integers little-endian, every section 8-byte aligned):
+// [Header]            magic "CLYP", version = 2, counts and section offsets
+// [Record x count]    fixed-size entry records (path hash, data offset, sizes, codec, chunks)
+// [Bucket x buckets]  open-addressing table of record index + 1 (0 = empty), keyed by path hash
+// [ChunkSize x n]     stored size of every chunk; each entry owns a run of ceil(rawSize / chunkSize)
+// [Paths]             path bytes referenced by the records (not NUL-terminated)
+// [Blob data...]      entries 16-byte aligned, each as back-to-back chunks
+//
+// A chunk whose stored size equals its raw size is stored as is; an entry with
+// codec None is stored raw as a whole. Identical blobs are shared by several records.
+//
+// The reader maps the file once and uses the records and buckets in place, so a
+// lookup is one hash plus a short probe with no allocation. Stored entries are
+// handed out as views into the mapping; compressed entries are decoded chunk by
+// chunk, in parallel when a JobSystem is supplied.
+//
+// v1 layout (read only):
+// [magic "CLYP"] [version = 1] [fileCount: uint32]
+// fileCount x { [pathLen: uint32] [path bytes] [offset: uint64] [size: uint64] }
+// [blob data...]
 class PakArchive {
 public:
-    struct Entry {
-        uint64_t offset = 0;
-        uint64_t size = 0;
-    };
+    enum class Codec : uint32_t { None = 0, LZ4 = 1, Zstd = 2 };
 
-    // Writer API
-    void AddFile(const std::string& virtualPath, const std::vector<uint8_t>& data);
-    bool SaveToFile(const std::string& pakPath) const;
+    struct View {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
 
-    // Reader API
     bool Open(const std::string& pakPath);
-    bool Contains(const std::string& virtualPath) const;
-    bool ReadFile(const std::string& virtualPath, std::vector<uint8_t>& outData) const;
+    void Close();
+    bool IsOpen() const { return m_Map.IsOpen(); }
+    uint32_t GetVersion() const { return m_Version; }
+    size_t GetFileCount() const { return m_Count; }
+    uint32_t GetChunkSize() const { return m_ChunkSize; }
 
-private:
-    struct FileData {
-        std::string path;
-        std::vector<uint8_t> data;
+    bool Contains(std::string_view virtualPath) const;
+    // Zero-copy access; fails for compressed entries (use ReadFile for those)
+    bool ReadFileView(std::string_view virtualPath, View& outView) const;
+    // Copies stored entries and decodes compressed ones; 'js' spreads the chunks over its workers
+    bool ReadFile(std::string_view virtualPath, std::vector<uint8_t>& outData, JobSystem* js = nullptr) const;
+
+    static uint64_t HashPath(std::string_view path);
+    static bool IsCodecAvailable(Codec codec);
+
+    static constexpr uint32_t kVersion = 2;
+    static constexpr uint32_t kChunkSize = 256 * 1024;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t count;
+        uint32_t bucketCount;
+        uint32_t chunkCount;
+        uint32_t chunkSize;
+        uint64_t recordsOffset;
+        uint64_t bucketsOffset;
+        uint64_t chunksOffset;
+        uint64_t pathsOffset;
+        uint64_t pathBytes;
     };
+    static_assert(sizeof(Header) == 64, "PakArchive::Header must stay 64 bytes");
 
-    // For writer
-    std::vector<FileData> m_Files;
+    // On-disk entry record (v2); v1 tables are converted to this form on Open
+    struct Record {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t storedSize;
+        uint64_t rawSize;
+        uint32_t pathOffset;
+        uint32_t pathLen;
+        uint32_t codec;
+        uint32_t firstChunk;
+    };
+    static_assert(sizeof(Record) == 48, "PakArchive::Record must stay tightly packed");
 
-    // For reader
-    std::string m_PakPath;
-    std::unordered_map<std::string, Entry> m_Index;
-};
+    // Bucket table for 'records' (power-of-two size, linear probing)
+    static std::vector<uint32_t> BuildBuckets(const std::vector<Record>& records);
 
+    // An entry exactly as stored, so a writer can carry it into a new archive unchanged
+    struct StoredEntry {
+        const uint8_t* data = nullptr;
+        uint64_t offset = 0;                  // of 'data' from the start of the archive
+        uint64_t storedSize = 0;
+        uint64_t rawSize = 0;
+        Codec codec = Codec::None;
+        const uint32_t* chunkSizes = nullptr; // null for entries stored raw
+        size_t chunkCount = 0;
+    };
+    bool GetStoredEntry(std::string_view virtualPath, StoredEntry& out) const;
 
+private:
+    const Record* Find(std::string_view virtualPath) const;
+    std::string_view PathOf(const Record& r) const;
+    bool OpenV1();
+    bool OpenV2();
+
+    MappedFile m_Map;
+    uint32_t m_Version = 0;
+    const Record* m_Records = nullptr;
+    const uint32_t* m_Buckets = nullptr;
+    const uint32_t* m_ChunkSizes = nullptr;
+    const char* m_Paths = nullptr;
+    size_t m_Count = 0;
+    size_t m_BucketCount = 0;
+    size_t m_ChunkCount = 0;
+    size_t m_PathBytes = 0;
+    uint32_t m_ChunkSize = kChunkSize;
+
+    // v1 tables rebuilt in memory
+    std::vector<Record> m_V1Records;
+    std::vector<uint32_t> m_V1Buckets;
+    std::string m_V1Paths;
+};
@@ -0,0 +1,546 @@
+#include "PakWriter.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+#include <openssl/md5.h>
+
+#ifdef CLAYMORE_WITH_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#ifdef CLAYMORE_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    constexpr uint32_t kBuildInfoVersion = 2;
+    // A chunk is stored compressed only if that saves at least this fraction
+    constexpr double kMinCompressionGain = 0.10;
+    constexpr int kZstdLevel = 15;
+    // Caps the job count for packs of many tiny files, where the byte budget alone would not
+    constexpr size_t kMaxChunksInFlight = 1024;
+    // Patching in place is allowed while at least this share of the old data region is still referenced
+    constexpr double kMinLiveFraction = 0.75;
+
+    uint64_t AlignUp(uint64_t v, uint64_t a) { return (v + a - 1) & ~(a - 1); }
+
+    std::string ToHex(const unsigned char* digest, size_t n) {
+        std::ostringstream hex;
+        for (size_t i = 0; i < n; ++i)
+            hex << std::hex << std::setw(2) << std::setfill('0') << (int)digest[i];
+        return hex.str();
+    }
+
+    bool CompressChunk(PakArchive::Codec codec, const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+        switch (codec) {
+#ifdef CLAYMORE_WITH_LZ4
+        case PakArchive::Codec::LZ4: {
+            out.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(size))));
+            int n = LZ4_compress_HC(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(out.data()),
+                                    static_cast<int>(size), static_cast<int>(out.size()), LZ4HC_CLEVEL_DEFAULT);
+            if (n <= 0) return false;
+            out.resize(static_cast<size_t>(n));
+            return true;
+        }
+#endif
+#ifdef CLAYMORE_WITH_ZSTD
+        case PakArchive::Codec::Zstd: {
+            out.resize(ZSTD_compressBound(size));
+            size_t n = ZSTD_compress(out.data(), out.size(), src, size, kZstdLevel);
+            if (ZSTD_isError(n)) return false;
+            out.resize(n);
+            return true;
+        }
+#endif
+        default:
+            (void)src; (void)size; (void)out;
+            return false;
+        }
+    }
+
+    void WritePadding(std::ostream& out, uint64_t& cursor, uint64_t to) {
+        static const char kZeros[4096] = {};
+        while (cursor < to) {
+            uint64_t n = std::min<uint64_t>(to - cursor, sizeof(kZeros));
+            out.write(kZeros, static_cast<std::streamsize>(n));
+            cursor += n;
+        }
+    }
+
+    // One chunk of one entry, produced by a job and consumed in order by the writer
+    struct ChunkWork {
+        size_t entry = 0;
+        uint64_t rawPos = 0;
+        size_t rawLen = 0;
+        std::vector<uint8_t> stored;
+        unsigned char digest[MD5_DIGEST_LENGTH] = {};
+        bool ok = false;
+        std::atomic<bool> done{ false };
+    };
+
+    // Where an entry's bytes ended up; duplicates and aliases copy this
+    struct Blob {
+        uint64_t offset = 0;
+        uint64_t storedSize = 0;
+        uint64_t rawSize = 0;
+        uint32_t codec = 0;
+        uint32_t firstChunk = 0;
+    };
+}
+
+void PakWriter::AddFile(const std::string& virtualPath, const std::string& sourcePath) {
+    Entry e;
+    e.path = virtualPath;
+    e.source = sourcePath;
+    m_Entries.push_back(std::move(e));
+}
+
+void PakWriter::AddBytes(const std::string& virtualPath, std::vector<uint8_t> data) {
+    Entry e;
+    e.path = virtualPath;
+    e.bytes = std::move(data);
+    m_Entries.push_back(std::move(e));
+}
+
+void PakWriter::AddAlias(const std::string& alias, const std::string& target) {
+    m_Aliases.emplace_back(alias, target);
+}
+
+bool PakWriter::Write(const std::string& pakPath, JobSystem* js, Stats* stats) {
+    using Codec = PakArchive::Codec;
+    Codec codec = m_Codec;
+    if (!PakArchive::IsCodecAvailable(codec)) {
+        if (PakArchive::IsCodecAvailable(Codec::LZ4)) codec = Codec::LZ4;
+        else if (PakArchive::IsCodecAvailable(Codec::Zstd)) codec = Codec::Zstd;
+        else codec = Codec::None;
+    }
+    const uint32_t chunkSize = PakArchive::kChunkSize;
+    Stats st;
+
+    // Entries that make it into the pak, in order: first per path, source readable
+    std::vector<size_t> order;
+    std::unordered_map<std::string, size_t> byPath; // path -> position in 'order'
+    for (size_t i = 0; i < m_Entries.size(); ++i) {
+        Entry& e = m_Entries[i];
+        if (byPath.count(e.path)) continue;
+        if (!e.source.empty()) {
+            std::error_code ec;
+            e.rawSize = fs::file_size(e.source, ec);
+            if (!ec) e.stamp = fs::last_write_time(e.source, ec).time_since_epoch().count();
+            if (ec) {
+                std::cerr << "[PakWriter] Warning: Could not open file: " << e.source << std::endl;
+                continue;
+            }
+        } else {
+            e.rawSize = e.bytes.size();
+        }
+        byPath.emplace(e.path, order.size());
+        order.push_back(i);
+    }
+
+    // Previous build: entries whose source stamp is unchanged are carried over as stored
+    PakArchive previous;
+    json previousInfo;
+    bool havePrevious = false;
+    if (!m_BuildInfoPath.empty() && fs::exists(m_BuildInfoPath) && fs::exists(pakPath)) {
+        try {
+            std::ifstream in(m_BuildInfoPath);
+            in >> previousInfo;
+            // The info only describes the pak that was written along with it
+            std::error_code ec;
+            const uint64_t pakSize = fs::file_size(pakPath, ec);
+            const int64_t pakStamp = ec ? 0 : fs::last_write_time(pakPath, ec).time_since_epoch().count();
+            havePrevious = !ec && previousInfo.value("version", 0u) == kBuildInfoVersion &&
+                           previousInfo.value("pakSize", uint64_t(0)) == pakSize &&
+                           previousInfo.value("pakStamp", int64_t(0)) == pakStamp &&
+                           previousInfo.value("codec", 0u) == static_cast<uint32_t>(codec) &&
+                           previousInfo.value("chunkSize", 0u) == chunkSize &&
+                           previousInfo.contains("entries") &&
+                           previous.Open(pakPath) && previous.GetVersion() == PakArchive::kVersion &&
+                           previous.GetChunkSize() == chunkSize;
+        } catch (const std::exception& ex) {
+            std::cerr << "[PakWriter] Ignoring unreadable build info " << m_BuildInfoPath << ": " << ex.what() << std::endl;
+        }
+    }
+    std::vector<PakArchive::StoredEntry> reused(order.size());
+    std::vector<std::string> contentHash(order.size());
+    std::vector<bool> isReused(order.size(), false);
+    if (havePrevious) {
+        const json& prevEntries = previousInfo["entries"];
+        for (size_t k = 0; k < order.size(); ++k) {
+            const Entry& e = m_Entries[order[k]];
+            if (e.source.empty()) continue;
+            auto it = prevEntries.find(e.path);
+            if (it == prevEntries.end()) continue;
+            if (it->value("source", std::string()) != e.source || it->value("size", uint64_t(0)) != e.rawSize ||
+                it->value("stamp", int64_t(0)) != e.stamp) continue;
+            PakArchive::StoredEntry se;
+            if (!previous.GetStoredEntry(e.path, se) || se.rawSize != e.rawSize) continue;
+            if (se.codec != Codec::None && se.codec != codec) continue;
+            reused[k] = se;
+            contentHash[k] = it->value("hash", std::string());
+            isReused[k] = !contentHash[k].empty();
+        }
+    }
+
+    // Table region, sized before any blob is read
+    std::vector<PakArchive::Record> records;
+    std::vector<size_t> recordEntry; // record -> position in 'order'
+    std::string paths;
+    auto addRecord = [&](const std::string& path, size_t k) {
+        PakArchive::Record r{};
+        r.hash = PakArchive::HashPath(path);
+        r.pathOffset = static_cast<uint32_t>(paths.size());
+        r.pathLen = static_cast<uint32_t>(path.size());
+        paths += path;
+        records.push_back(r);
+        recordEntry.push_back(k);
+    };
+    std::vector<uint32_t> firstChunk(order.size(), 0);
+    uint32_t chunkCount = 0;
+    for (size_t k = 0; k < order.size(); ++k) {
+        const Entry& e = m_Entries[order[k]];
+        addRecord(e.path, k);
+        firstChunk[k] = chunkCount;
+        chunkCount += static_cast<uint32_t>((e.rawSize + chunkSize - 1) / chunkSize);
+    }
+    for (const auto& a : m_Aliases) {
+        auto target = byPath.find(a.second);
+        if (target == byPath.end()) {
+            std::cerr << "[PakWriter] Alias target not found: " << a.second << std::endl;
+            continue;
+        }
+        if (!byPath.emplace(a.first, target->second).second) continue;
+        addRecord(a.first, target->second);
+    }
+    std::vector<uint32_t> buckets = PakArchive::BuildBuckets(records);
+    std::vector<uint32_t> chunkSizes(chunkCount, 0);
+
+    PakArchive::Header h{};
+    std::memcpy(h.magic, "CLYP", 4);
+    h.version = PakArchive::kVersion;
+    h.count = static_cast<uint32_t>(records.size());
+    h.bucketCount = static_cast<uint32_t>(buckets.size());
+    h.chunkCount = chunkCount;
+    h.chunkSize = chunkSize;
+    h.pathBytes = paths.size();
+    // Places the tables at 'base' (front: right after the header; tail: after the data), returns their end
+    auto layoutTables = [&](uint64_t base) {
+        h.recordsOffset = base;
+        h.bucketsOffset = AlignUp(h.recordsOffset + records.size() * sizeof(PakArchive::Record), 8);
+        h.chunksOffset = AlignUp(h.bucketsOffset + buckets.size() * sizeof(uint32_t), 8);
+        h.pathsOffset = AlignUp(h.chunksOffset + uint64_t(chunkCount) * sizeof(uint32_t), 8);
+        return AlignUp(h.pathsOffset + paths.size(), 16);
+    };
+    const uint64_t tablesEnd = layoutTables(sizeof(PakArchive::Header));
+    // With build info the tables get slack, so later builds that add a few entries can still patch
+    uint64_t dataStart = m_BuildInfoPath.empty() ? tablesEnd : AlignUp(tablesEnd + tablesEnd / 8, 4096);
+
+    // Patch in place when most of the previous data is still referenced: carried-over blobs stay
+    // where they are and changed entries are appended. Nothing the previous header points at is
+    // overwritten; the new tables go to whichever slot the previous ones do not occupy (the
+    // front slack, or the tail after the new data) and the header is switched last. Otherwise
+    // the whole pak is rewritten to a temp file.
+    bool patch = false;
+    bool tablesAtTail = false;
+    uint64_t previousSize = 0;
+    if (havePrevious) {
+        const uint64_t previousDataStart = previousInfo.value("dataStart", uint64_t(0));
+        const uint64_t previousTables = previousInfo.value("tablesOffset", uint64_t(sizeof(PakArchive::Header)));
+        previousSize = previousInfo.value("pakSize", uint64_t(0));
+        std::unordered_set<uint64_t> liveOffsets;
+        uint64_t liveBytes = 0;
+        for (size_t k = 0; k < order.size(); ++k)
+            if (isReused[k] && liveOffsets.insert(reused[k].offset).second) liveBytes += reused[k].storedSize;
+        patch = previousDataStart >= sizeof(PakArchive::Header) && previousDataStart <= previousSize &&
+                liveBytes >= static_cast<uint64_t>(kMinLiveFraction * double(previousSize - previousDataStart));
+        tablesAtTail = previousTables < previousDataStart || tablesEnd > previousDataStart;
+        if (patch) {
+            dataStart = previousDataStart;
+            // Carried-over chunk tables are copied now; the previous mapping closes before the pak is opened for writing
+            for (size_t k = 0; k < order.size(); ++k) {
+                if (!isReused[k]) continue;
+                const uint64_t rawSize = m_Entries[order[k]].rawSize;
+                for (size_t c = 0; c < static_cast<size_t>((rawSize + chunkSize - 1) / chunkSize); ++c) {
+                    const uint32_t rawLen = static_cast<uint32_t>(std::min<uint64_t>(chunkSize, rawSize - c * chunkSize));
+                    chunkSizes[firstChunk[k] + c] = reused[k].chunkSizes ? reused[k].chunkSizes[c] : rawLen;
+                }
+            }
+            previous.Close();
+        }
+    }
+
+    const std::string tmpPath = pakPath + ".tmp";
+    const std::string& outPath = patch ? pakPath : tmpPath;
+    std::fstream out(outPath, patch ? (std::ios::binary | std::ios::in | std::ios::out)
+                                    : (std::ios::binary | std::ios::out | std::ios::trunc));
+    if (!out.is_open()) {
+        std::cerr << "[PakWriter] Could not " << (patch ? "open " : "create ") << outPath << std::endl;
+        return false;
+    }
+    uint64_t cursor = 0;
+    if (patch) {
+        // Appending only; the previous build info stops matching once the size or stamp changes
+        out.seekp(static_cast<std::streamoff>(previousSize));
+        cursor = previousSize;
+    } else {
+        WritePadding(out, cursor, dataStart);
+    }
+
+    // Read/hash/compress jobs run ahead of the writer within the in-flight budget
+    std::deque<std::unique_ptr<ChunkWork>> inFlight;
+    uint64_t inFlightBytes = 0;
+    size_t schedEntry = 0;
+    uint64_t schedPos = 0;
+    const Entry* entries = m_Entries.data();
+    auto process = [entries, codec](ChunkWork* w) {
+        const Entry& e = entries[w->entry];
+        std::vector<uint8_t> raw;
+        const uint8_t* src = nullptr;
+        if (e.source.empty()) {
+            src = e.bytes.data() + w->rawPos;
+        } else {
+            std::ifstream in(e.source, std::ios::binary);
+            raw.resize(w->rawLen);
+            in.seekg(static_cast<std::streamoff>(w->rawPos));
+            in.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(w->rawLen));
+            if (!in || static_cast<size_t>(in.gcount()) != w->rawLen) {
+                w->done.store(true, std::memory_order_release);
+                return;
+            }
+            src = raw.data();
+        }
+        MD5(src, w->rawLen, w->digest);
+        if (codec != Codec::None && CompressChunk(codec, src, w->rawLen, w->stored) &&
+            w->stored.size() <= static_cast<size_t>(w->rawLen * (1.0 - kMinCompressionGain))) {
+            w->ok = true;
+        } else {
+            if (e.source.empty()) w->stored.assign(src, src + w->rawLen);
+            else w->stored = std::move(raw);
+            w->ok = true;
+        }
+        w->done.store(true, std::memory_order_release);
+    };
+    auto schedule = [&]() {
+        while (schedEntry < order.size()) {
+            const Entry& e = m_Entries[order[schedEntry]];
+            if (isReused[schedEntry] || schedPos >= e.rawSize) {
+                ++schedEntry;
+                schedPos = 0;
+                continue;
+            }
+            const size_t len = static_cast<size_t>(std::min<uint64_t>(chunkSize, e.rawSize - schedPos));
+            if (!inFlight.empty() && (inFlight.size() >= kMaxChunksInFlight || inFlightBytes + len > m_MaxInFlightBytes)) return;
+            auto w = std::make_unique<ChunkWork>();
+            w->entry = order[schedEntry];
+            w->rawPos = schedPos;
+            w->rawLen = len;
+            ChunkWork* raw = w.get();
+            inFlight.push_back(std::move(w));
+            inFlightBytes += len;
+            schedPos += len;
+            if (!js || !js->Enqueue([process, raw] { process(raw); })) process(raw);
+        }
+    };
+    auto waitFront = [&]() {
+        while (!inFlight.front()->done.load(std::memory_order_acquire)) {
+            schedule();
+            if (!js || !js->TryRunOne()) std::this_thread::yield();
+        }
+    };
+    // Jobs point into 'inFlight'; every one must finish before it goes away
+    auto drain = [&]() {
+        while (!inFlight.empty()) {
+            waitFront();
+            inFlight.pop_front();
+        }
+    };
+
+    std::vector<Blob> blobs(order.size());
+    std::unordered_map<std::string, size_t> blobByHash; // content hash -> position in 'order'
+    bool ok = true;
+    for (size_t k = 0; k < order.size() && ok; ++k) {
+        const Entry& e = m_Entries[order[k]];
+        schedule();
+        st.rawBytes += e.rawSize;
+
+        // Known content (carried over): share an existing blob without writing anything
+        if (isReused[k]) {
+            auto dup = blobByHash.find(contentHash[k]);
+            if (dup != blobByHash.end() && blobs[dup->second].rawSize == e.rawSize) {
+                blobs[k] = blobs[dup->second];
+                ++st.deduplicated;
+                continue;
+            }
+        }
+        // Patching: a carried-over blob stays where the previous build put it
+        if (isReused[k] && patch) {
+            Blob& b = blobs[k];
+            b.offset = reused[k].offset;
+            b.storedSize = reused[k].storedSize;
+            b.rawSize = e.rawSize;
+            b.codec = static_cast<uint32_t>(reused[k].codec);
+            b.firstChunk = firstChunk[k];
+            blobByHash.emplace(contentHash[k], k);
+            ++st.reused;
+            continue;
+        }
+
+        WritePadding(out, cursor, AlignUp(cursor, 16));
+        const uint64_t entryStart = cursor;
+        const size_t chunks = static_cast<size_t>((e.rawSize + chunkSize - 1) / chunkSize);
+        bool allRaw = true;
+
+        if (isReused[k]) {
+            const PakArchive::StoredEntry& se = reused[k];
+            out.write(reinterpret_cast<const char*>(se.data), static_cast<std::streamsize>(se.storedSize));
+            cursor += se.storedSize;
+            for (size_t c = 0; c < chunks; ++c) {
+                const uint32_t rawLen = static_cast<uint32_t>(std::min<uint64_t>(chunkSize, e.rawSize - c * chunkSize));
+                chunkSizes[firstChunk[k] + c] = se.chunkSizes ? se.chunkSizes[c] : rawLen;
+            }
+            allRaw = se.codec == Codec::None;
+            ++st.reused;
+        } else {
+            MD5_CTX ctx;
+            MD5_Init(&ctx);
+            for (size_t c = 0; c < chunks; ++c) {
+                waitFront();
+                std::unique_ptr<ChunkWork> w = std::move(inFlight.front());
+                inFlight.pop_front();
+                inFlightBytes -= w->rawLen;
+                if (!w->ok) {
+                    std::cerr << "[PakWriter] Failed to read " << e.source << std::endl;
+                    ok = false;
+                    break;
+                }
+                out.write(reinterpret_cast<const char*>(w->stored.data()), static_cast<std::streamsize>(w->stored.size()));
+                cursor += w->stored.size();
+                chunkSizes[firstChunk[k] + c] = static_cast<uint32_t>(w->stored.size());
+                allRaw = allRaw && w->stored.size() == w->rawLen;
+                MD5_Update(&ctx, w->digest, sizeof(w->digest));
+                schedule();
+            }
+            if (!ok) break;
+            unsigned char digest[MD5_DIGEST_LENGTH];
+            MD5_Final(digest, &ctx);
+            contentHash[k] = ToHex(digest, MD5_DIGEST_LENGTH);
+            ++st.compressed;
+        }
+
+        auto dup = blobByHash.find(contentHash[k]);
+        if (dup != blobByHash.end() && blobs[dup->second].rawSize == e.rawSize) {
+            // Same bytes already in the pak: drop what was just written
+            out.seekp(static_cast<std::streamoff>(entryStart));
+            cursor = entryStart;
+            blobs[k] = blobs[dup->second];
+            ++st.deduplicated;
+            continue;
+        }
+        Blob& b = blobs[k];
+        b.offset = entryStart;
+        b.storedSize = cursor - entryStart;
+        b.rawSize = e.rawSize;
+        b.codec = static_cast<uint32_t>(allRaw ? Codec::None : codec);
+        b.firstChunk = firstChunk[k];
+        blobByHash.emplace(contentHash[k], k);
+    }
+    drain();
+    previous.Close();
+
+    if (ok) {
+        for (size_t r = 0; r < records.size(); ++r) {
+            const Blob& b = blobs[recordEntry[r]];
+            records[r].offset = b.offset;
+            records[r].storedSize = b.storedSize;
+            records[r].rawSize = b.rawSize;
+            records[r].codec = b.codec;
+            records[r].firstChunk = b.firstChunk;
+        }
+        const uint64_t dataEnd = cursor;
+        uint64_t end = dataEnd;
+        if (patch && tablesAtTail) end = layoutTables(AlignUp(dataEnd, 16));
+        out.seekp(static_cast<std::streamoff>(h.recordsOffset));
+        if (!records.empty()) out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(PakArchive::Record)));
+        out.seekp(static_cast<std::streamoff>(h.bucketsOffset));
+        out.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(uint32_t)));
+        out.seekp(static_cast<std::streamoff>(h.chunksOffset));
+        if (!chunkSizes.empty()) out.write(reinterpret_cast<const char*>(chunkSizes.data()), static_cast<std::streamsize>(chunkSizes.size() * sizeof(uint32_t)));
+        out.seekp(static_cast<std::streamoff>(h.pathsOffset));
+        out.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+        // The header goes last, in one write: until it lands the previous tables still describe the pak
+        out.flush();
+        if (out) {
+            out.seekp(0);
+            out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        }
+        ok = static_cast<bool>(out);
+        out.close();
+        // A duplicate at the very end leaves its bytes past the last blob (or the tail tables)
+        std::error_code ec;
+        if (ok) fs::resize_file(outPath, end, ec);
+        ok = ok && !ec;
+        st.storedBytes = dataEnd - dataStart;
+    }
+    out.close();
+
+    std::error_code ec;
+    if (patch) {
+        // Failed before the header switch: drop the appended bytes, the previous pak is unchanged
+        if (!ok) {
+            fs::resize_file(pakPath, previousSize, ec);
+            return false;
+        }
+        st.patched = true;
+    } else if (ok) {
+        fs::rename(tmpPath, pakPath, ec);
+        if (ec) {
+            std::cerr << "[PakWriter] Could not replace " << pakPath << ": " << ec.message() << std::endl;
+            ok = false;
+        }
+    }
+    if (!ok) {
+        // The previous pak and its build info are left as they were
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+
+    if (!m_BuildInfoPath.empty()) {
+        json info;
+        info["version"] = kBuildInfoVersion;
+        info["codec"] = static_cast<uint32_t>(codec);
+        info["chunkSize"] = chunkSize;
+        info["dataStart"] = dataStart;
+        info["tablesOffset"] = h.recordsOffset;
+        info["pakSize"] = fs::file_size(pakPath, ec);
+        info["pakStamp"] = fs::last_write_time(pakPath, ec).time_since_epoch().count();
+        json& list = info["entries"] = json::object();
+        for (size_t k = 0; k < order.size(); ++k) {
+            const Entry& e = m_Entries[order[k]];
+            if (e.source.empty()) continue;
+            list[e.path] = { { "source", e.source }, { "size", e.rawSize }, { "stamp", e.stamp }, { "hash", contentHash[k] } };
+        }
+        fs::create_directories(fs::path(m_BuildInfoPath).parent_path(), ec);
+        std::ofstream infoOut(m_BuildInfoPath, std::ios::trunc);
+        infoOut << info.dump();
+    }
+
+    st.entries = records.size();
+    if (stats) *stats = st;
+    return true;
+}
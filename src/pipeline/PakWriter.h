@@ -0,0 +1,70 @@
+#pragma once
+#include "PakArchive.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+// Streaming writer for v2 .pak archives (see PakArchive for the layout).
+//
+// Entries are registered up front by path and source, so the table region can be
+// sized before any data is read. Write() then streams the blobs to a temp file in
+// entry order: jobs read, hash and compress chunks ahead of the writing thread,
+// bounded by SetMaxInFlightBytes(), so memory use does not grow with the content
+// set. Entries with identical content (MD5) share one blob. The tables go in last
+// and the temp file is renamed over the output.
+//
+// With SetBuildInfo(), Write() records each entry's source stamp and content hash,
+// and leaves some slack after the tables. The next Write() to the same pak reads and
+// compresses only entries whose source changed. If at least 3/4 of the old data is
+// still referenced, the pak is patched in place: unchanged blobs stay put, changed ones
+// are appended, so a one-file change writes about that file. The new tables go to the
+// slot the old ones do not use (the front slack or the tail) and the header is written
+// last, so a patch that fails or is interrupted leaves the previous pak readable.
+// Otherwise unchanged entries are copied from the previous archive into a full rewrite.
+class PakWriter {
+public:
+    struct Stats {
+        size_t entries = 0;
+        size_t compressed = 0;   // read and encoded this run
+        size_t reused = 0;       // carried over from the previous build
+        bool patched = false;    // previous pak updated in place rather than rewritten
+        size_t deduplicated = 0; // share another entry's blob
+        uint64_t rawBytes = 0;
+        uint64_t storedBytes = 0;
+    };
+
+    // Codec for compressible chunks; falls back to another compiled-in codec, then None
+    void SetCodec(PakArchive::Codec codec) { m_Codec = codec; }
+    void SetMaxInFlightBytes(uint64_t bytes) { m_MaxInFlightBytes = bytes; }
+    // Enables incremental rebuilds and in-place patching (read before, written after Write)
+    void SetBuildInfo(const std::string& buildInfoPath) { m_BuildInfoPath = buildInfoPath; }
+
+    // Paths are stored as given; use FileSystem::PakKey() forms so runtime lookups hit.
+    // The first entry added for a path wins.
+    void AddFile(const std::string& virtualPath, const std::string& sourcePath);
+    void AddBytes(const std::string& virtualPath, std::vector<uint8_t> data);
+    // Makes 'alias' resolve to the same bytes as 'target'
+    void AddAlias(const std::string& alias, const std::string& target);
+
+    // 'js' reads and compresses on its workers while this thread writes; null does it all inline
+    bool Write(const std::string& pakPath, JobSystem* js, Stats* stats = nullptr);
+
+    static constexpr uint64_t kDefaultMaxInFlightBytes = 256ull << 20;
+
+private:
+    struct Entry {
+        std::string path;
+        std::string source;         // empty for in-memory entries
+        std::vector<uint8_t> bytes;
+        uint64_t rawSize = 0;
+        int64_t stamp = 0;          // source write time ticks
+    };
+
+    std::vector<Entry> m_Entries;
+    std::vector<std::pair<std::string, std::string>> m_Aliases;
+    PakArchive::Codec m_Codec = PakArchive::Codec::LZ4;
+    uint64_t m_MaxInFlightBytes = kDefaultMaxInFlightBytes;
+    std::string m_BuildInfoPath;
+};
@@ -213,6 +213,8 @@ std::string ShaderImporter::EmitFragmentSource(const ParsedShader& ps, const std
     out += "\n";
     out += varyingDef;
     out += "\n";
+    // clayUnpackNormal(): normal maps are cooked to BC5 (X and Y only, see TextureCooker)
+    out += "#include \"normal_map.sh\"\n";
     out += ps.fragmentSource;
     return out;
 }
@@ -0,0 +1,216 @@
+#include "TextureCooker.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#include <bimg/bimg.h>
+#include <bimg/encode.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
+#include <bx/readerwriter.h>
+
+namespace {
+    std::string ToLower(std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return s;
+    }
+
+    bool EndsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    bimg::TextureFormat::Enum PickFormat(const TextureCooker::Settings& s, bool hasAlpha) {
+        using Usage = TextureCooker::Usage;
+        if (s.usage == Usage::UI || s.compression == TextureCooker::Compression::None)
+            return bimg::TextureFormat::RGBA8;
+        if (s.compression == TextureCooker::Compression::ASTC) {
+            switch (s.usage) {
+            case Usage::Albedo: return hasAlpha ? bimg::TextureFormat::ASTC4x4 : bimg::TextureFormat::ASTC6x6;
+            case Usage::ORM:    return bimg::TextureFormat::ASTC6x6;
+            default:            return bimg::TextureFormat::ASTC4x4;
+            }
+        }
+        switch (s.usage) {
+        case Usage::Albedo: return hasAlpha ? bimg::TextureFormat::BC3 : bimg::TextureFormat::BC1;
+        case Usage::Normal: return bimg::TextureFormat::BC5;
+        default:            return bimg::TextureFormat::BC7;
+        }
+    }
+
+    float SrgbToLinear(uint8_t v) {
+        static const auto kTable = [] {
+            std::vector<float> t(256);
+            for (int i = 0; i < 256; ++i) {
+                const float c = i / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return kTable[v];
+    }
+
+    uint8_t LinearToSrgb(float c) {
+        c = std::clamp(c, 0.0f, 1.0f);
+        const float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        return (uint8_t)std::lround(s * 255.0f);
+    }
+
+    // 2x2 box filter to the next mip (odd edges clamp)
+    void Downsample(const std::vector<uint8_t>& src, uint32_t sw, uint32_t sh, TextureCooker::Usage usage,
+                    std::vector<uint8_t>& dst, uint32_t& dw, uint32_t& dh) {
+        dw = std::max(1u, sw / 2);
+        dh = std::max(1u, sh / 2);
+        dst.resize(size_t(dw) * dh * 4);
+        for (uint32_t y = 0; y < dh; ++y) {
+            const uint32_t y0 = std::min(y * 2, sh - 1), y1 = std::min(y * 2 + 1, sh - 1);
+            for (uint32_t x = 0; x < dw; ++x) {
+                const uint32_t x0 = std::min(x * 2, sw - 1), x1 = std::min(x * 2 + 1, sw - 1);
+                const uint8_t* p[4] = {
+                    &src[(size_t(y0) * sw + x0) * 4], &src[(size_t(y0) * sw + x1) * 4],
+                    &src[(size_t(y1) * sw + x0) * 4], &src[(size_t(y1) * sw + x1) * 4]
+                };
+                uint8_t* out = &dst[(size_t(y) * dw + x) * 4];
+                const float alpha = (p[0][3] + p[1][3] + p[2][3] + p[3][3]) * 0.25f;
+                out[3] = (uint8_t)std::lround(alpha);
+
+                if (usage == TextureCooker::Usage::Albedo) {
+                    for (int c = 0; c < 3; ++c) {
+                        const float sum = SrgbToLinear(p[0][c]) + SrgbToLinear(p[1][c]) + SrgbToLinear(p[2][c]) + SrgbToLinear(p[3][c]);
+                        out[c] = LinearToSrgb(sum * 0.25f);
+                    }
+                } else if (usage == TextureCooker::Usage::Normal) {
+                    float n[3] = { 0.0f, 0.0f, 0.0f };
+                    for (int k = 0; k < 4; ++k)
+                        for (int c = 0; c < 3; ++c) n[c] += p[k][c] / 127.5f - 1.0f;
+                    const float len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    if (len > 1e-6f) for (float& v : n) v /= len;
+                    else { n[0] = n[1] = 0.0f; n[2] = 1.0f; }
+                    for (int c = 0; c < 3; ++c) out[c] = (uint8_t)std::lround(std::clamp((n[c] + 1.0f) * 127.5f, 0.0f, 255.0f));
+                } else {
+                    for (int c = 0; c < 3; ++c)
+                        out[c] = (uint8_t)((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+                }
+            }
+        }
+    }
+
+    // Block encoders work on whole blocks; tail mips smaller than a block repeat their edge
+    const uint8_t* PadToBlocks(const std::vector<uint8_t>& src, uint32_t w, uint32_t h, uint32_t pw, uint32_t ph,
+                               std::vector<uint8_t>& scratch) {
+        if (pw == w && ph == h) return src.data();
+        scratch.resize(size_t(pw) * ph * 4);
+        for (uint32_t y = 0; y < ph; ++y)
+            for (uint32_t x = 0; x < pw; ++x)
+                std::memcpy(&scratch[(size_t(y) * pw + x) * 4], &src[(size_t(std::min(y, h - 1)) * w + std::min(x, w - 1)) * 4], 4);
+        return scratch.data();
+    }
+
+    class VectorWriter : public bx::WriterI {
+    public:
+        explicit VectorWriter(std::vector<uint8_t>& out) : m_Out(out) {}
+        int32_t write(const void* data, int32_t size, bx::Error*) override {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_Out.insert(m_Out.end(), bytes, bytes + size);
+            return size;
+        }
+    private:
+        std::vector<uint8_t>& m_Out;
+    };
+}
+
+TextureCooker::Settings TextureCooker::ResolveSettings(const std::string& sourcePath,
+                                                       const std::unordered_map<std::string, std::string>& meta) {
+    Settings s;
+    std::string path = ToLower(sourcePath);
+    std::replace(path.begin(), path.end(), '\\', '/');
+    const size_t slash = path.find_last_of('/');
+    std::string stem = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    stem = stem.substr(0, stem.find('.'));
+
+    if (path.find("/ui/") != std::string::npos || path.find("/icons/") != std::string::npos) s.usage = Usage::UI;
+    else if (stem.find("normal") != std::string::npos || EndsWith(stem, "_n") || EndsWith(stem, "_nrm")) s.usage = Usage::Normal;
+    else if (stem.find("metallic") != std::string::npos || stem.find("roughness") != std::string::npos
+             || EndsWith(stem, "_orm") || EndsWith(stem, "_mr") || EndsWith(stem, "_ao")) s.usage = Usage::ORM;
+
+    auto it = meta.find("usage");
+    if (it != meta.end()) {
+        const std::string v = ToLower(it->second);
+        if (v == "albedo" || v == "color") s.usage = Usage::Albedo;
+        else if (v == "normal") s.usage = Usage::Normal;
+        else if (v == "orm") s.usage = Usage::ORM;
+        else if (v == "linear" || v == "data") s.usage = Usage::Linear;
+        else if (v == "ui") s.usage = Usage::UI;
+    }
+    it = meta.find("compression");
+    if (it != meta.end()) {
+        const std::string v = ToLower(it->second);
+        if (v == "bc") s.compression = Compression::BC;
+        else if (v == "astc") s.compression = Compression::ASTC;
+        else if (v == "none") s.compression = Compression::None;
+    }
+    it = meta.find("mips");
+    if (it != meta.end()) s.mips = ToLower(it->second) != "false";
+    return s;
+}
+
+std::string TextureCooker::Describe(const Settings& settings) {
+    static const char* kUsage[] = { "albedo", "normal", "orm", "linear", "ui" };
+    static const char* kCompression[] = { "bc", "astc", "none" };
+    return std::string(kUsage[(int)settings.usage]) + "/" + kCompression[(int)settings.compression]
+        + (settings.mips ? "/mips" : "/nomips");
+}
+
+bool TextureCooker::Cook(const uint8_t* rgba, uint32_t width, uint32_t height, const Settings& settings,
+                         std::vector<uint8_t>& outKtx, std::string* error) {
+    auto fail = [&](const std::string& msg) { if (error) *error = msg; return false; };
+    if (!rgba || width == 0 || height == 0) return fail("empty image");
+    if (width > UINT16_MAX || height > UINT16_MAX) return fail("image too large");
+
+    const size_t texels = size_t(width) * height;
+    bool hasAlpha = false;
+    for (size_t i = 0; i < texels && !hasAlpha; ++i) hasAlpha = rgba[i * 4 + 3] != 255;
+
+    const bimg::TextureFormat::Enum format = PickFormat(settings, hasAlpha);
+    const bool mips = settings.mips && settings.usage != Usage::UI;
+
+    bx::DefaultAllocator allocator;
+    bimg::ImageContainer* image = bimg::imageAlloc(&allocator, format, (uint16_t)width, (uint16_t)height, 1, 1, false, mips);
+    if (!image) return fail("bimg::imageAlloc failed");
+
+    std::vector<uint8_t> level(rgba, rgba + texels * 4), next, scratch;
+    uint32_t lw = width, lh = height;
+    bool ok = true;
+    for (uint8_t lod = 0; ok && lod < image->m_numMips; ++lod) {
+        if (lod > 0) {
+            uint32_t nw = 0, nh = 0;
+            Downsample(level, lw, lh, settings.usage, next, nw, nh);
+            level.swap(next);
+            lw = nw; lh = nh;
+        }
+        bimg::ImageMip mip;
+        if (!bimg::imageGetRawData(*image, 0, lod, image->m_data, image->m_size, mip)) { ok = fail("bimg::imageGetRawData failed"); break; }
+        uint8_t* dst = const_cast<uint8_t*>(mip.m_data);
+        if (format == bimg::TextureFormat::RGBA8) {
+            std::memcpy(dst, level.data(), std::min<size_t>(level.size(), mip.m_size));
+            continue;
+        }
+        const uint8_t* src = PadToBlocks(level, lw, lh, mip.m_width, mip.m_height, scratch);
+        bx::Error err;
+        bimg::imageEncodeFromRgba8(&allocator, dst, src, mip.m_width, mip.m_height, 1, format, bimg::Quality::Default, &err);
+        if (!err.isOk()) {
+            const bx::StringView msg = err.getMessage();
+            ok = fail("encode failed: " + std::string(msg.getPtr(), msg.getLength()));
+        }
+    }
+
+    if (ok) {
+        outKtx.clear();
+        VectorWriter writer(outKtx);
+        bx::Error err;
+        bimg::imageWriteKtx(&writer, *image, image->m_data, image->m_size, &err);
+        if (!err.isOk() || outKtx.empty()) ok = fail("bimg::imageWriteKtx failed");
+    }
+    bimg::imageFree(image);
+    return ok;
+}
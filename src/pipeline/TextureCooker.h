@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Offline texture cooking: RGBA8 source pixels -> GPU block-compressed KTX with a
+// full mip chain, encoded with bimg. The runtime hands the cooked file to
+// bgfx::createTexture as is (see TextureLoader::Load2D).
+//
+// The format follows the texture's usage, taken from the .meta settings
+// ("usage": albedo | normal | orm | linear | ui, "compression": bc | astc | none,
+// "mips": true | false) or guessed from the file name when unset:
+//
+//   usage    bc                       astc
+//   albedo   BC1, BC3 with alpha      ASTC 6x6, 4x4 with alpha
+//   normal   BC5 (XY, Z rebuilt)      ASTC 4x4
+//   orm      BC7                      ASTC 6x6
+//   linear   BC7                      ASTC 4x4
+//   ui       RGBA8, no mips           RGBA8, no mips
+//
+// Albedo mips are filtered in linear space; normal mips are renormalized. BC5 keeps
+// only X and Y: shaders must sample normal maps through clayUnpackNormal(), which
+// rebuilds Z. It lives in shaders/normal_map.sh: ShaderImporter includes it in every
+// unified fragment stage, hand-written shaders must include it themselves. GPUs
+// without a cooked format get it decoded to RGBA8 at load (TextureLoader::Load2D).
+class TextureCooker {
+public:
+    enum class Usage { Albedo, Normal, ORM, Linear, UI };
+    enum class Compression { BC, ASTC, None };
+
+    struct Settings {
+        Usage usage = Usage::Albedo;
+        Compression compression = Compression::BC;
+        bool mips = true;
+    };
+
+    // Cooked sidecar of a source texture: "foo.png" -> "foo.png.ktx"
+    static constexpr const char* kCookedExtension = ".ktx";
+    static std::string CookedPath(const std::string& sourcePath) { return sourcePath + kCookedExtension; }
+
+    static Settings ResolveSettings(const std::string& sourcePath, const std::unordered_map<std::string, std::string>& meta);
+    // Stable description of 'settings', for cache keys
+    static std::string Describe(const Settings& settings);
+
+    // Encodes 'rgba' (width*height*4 bytes) into a KTX container
+    static bool Cook(const uint8_t* rgba, uint32_t width, uint32_t height, const Settings& settings,
+                     std::vector<uint8_t>& outKtx, std::string* error = nullptr);
+};
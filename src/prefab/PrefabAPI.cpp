@@ -88,7 +88,7 @@ static void GenerateBoneEntitiesForSkeleton(Scene& scene, EntityID skeletonEntit
                 bd->Transform.RotationQ = glm::normalize(rq);
                 bd->Transform.UseQuatRotation = true;
                 bd->Transform.Rotation = glm::degrees(glm::eulerAngles(rq));
-                bd->Transform.TransformDirty = true;
+                scene.MarkTransformDirty(boneID);
             }
         }
     }
@@ -147,7 +147,7 @@ EntityID InstantiatePrefab(const ClaymoreGUID& prefabGuid, Scene& dst, const Pre
                     auto* nd = dst.GetEntityData(nid);
                     if (nd) {
                         nd->Name = e.Name;
-                        if (e.Components.contains("transform")) { Serializer::DeserializeTransform(e.Components["transform"], nd->Transform); nd->Transform.TransformDirty = true; }
+                        if (e.Components.contains("transform")) { Serializer::DeserializeTransform(e.Components["transform"], nd->Transform); dst.MarkTransformDirty(nid); }
                         if (e.Components.contains("scripts")) { Serializer::DeserializeScripts(e.Components["scripts"], nd->Scripts); }
                         if (e.Components.contains("animator")) { if (!nd->AnimationPlayer) nd->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>(); Serializer::DeserializeAnimator(e.Components["animator"], *nd->AnimationPlayer); }
                         // Attach GUID to the model root for stable mapping
@@ -200,7 +200,7 @@ EntityID InstantiatePrefab(const ClaymoreGUID& prefabGuid, Scene& dst, const Pre
                     if (!glm::all(glm::epsilonEqual(d->Transform.RotationQ, glm::quat(1,0,0,0), 0.0f))) {
                         d->Transform.UseQuatRotation = true;
                     }
-                    d->Transform.TransformDirty = true;
+                    dst.MarkTransformDirty(id);
                     d->Transform.CalculateLocalMatrix();
                 }
                 if (e.Components.contains("mesh")) { d->Mesh = std::make_unique<MeshComponent>(); /* defer renderer build */ }
@@ -292,7 +292,7 @@ EntityID InstantiatePrefab(const ClaymoreGUID& prefabGuid, Scene& dst, const Pre
             }
             if (target == (EntityID)-1) continue;
             auto* td = dst.GetEntityData(target); if (!td) continue;
-            if (childOverride.contains("transform")) { Serializer::DeserializeTransform(childOverride["transform"], td->Transform); td->Transform.TransformDirty = true; }
+            if (childOverride.contains("transform")) { Serializer::DeserializeTransform(childOverride["transform"], td->Transform); dst.MarkTransformDirty(target); }
             if (childOverride.contains("mesh")) {
                 if (!td->Mesh) td->Mesh = std::make_unique<MeshComponent>();
                 ClaymoreGUID meshGuid{}; int fileId = 0; ClaymoreGUID skelGuid{};
@@ -395,7 +395,7 @@ EntityID InstantiatePrefab(const ClaymoreGUID& prefabGuid, Scene& dst, const Pre
                         bd->Transform.RotationQ = glm::normalize(rq);
                         bd->Transform.UseQuatRotation = true;
                         bd->Transform.Rotation = glm::degrees(glm::eulerAngles(rq));
-                        bd->Transform.TransformDirty = true;
+                        dst.MarkTransformDirty(boneID);
                     }
                 }
             }
@@ -431,7 +431,7 @@ EntityID InstantiatePrefabFromAuthoringPath(const std::string& authoringPath, Sc
         auto itId = guidToId.find(pack(e.Guid)); if (itId == guidToId.end()) continue;
         EntityID id = itId->second; auto* d = dst.GetEntityData(id); if (!d) continue;
         if (e.ParentGuid.high != 0 || e.ParentGuid.low != 0) { auto itP = guidToId.find(pack(e.ParentGuid)); if (itP != guidToId.end()) dst.SetParent(id, itP->second); }
-        if (e.Components.contains("transform")) { Serializer::DeserializeTransform(e.Components["transform"], d->Transform); d->Transform.TransformDirty = true; d->Transform.CalculateLocalMatrix(); }
+        if (e.Components.contains("transform")) { Serializer::DeserializeTransform(e.Components["transform"], d->Transform); dst.MarkTransformDirty(id); d->Transform.CalculateLocalMatrix(); }
         if (e.Components.contains("mesh")) { d->Mesh = std::make_unique<MeshComponent>(); Serializer::DeserializeMesh(e.Components["mesh"], *d->Mesh); }
         if (e.Components.contains("skeleton")) { d->Skeleton = std::make_unique<SkeletonComponent>(); Serializer::DeserializeSkeleton(e.Components["skeleton"], *d->Skeleton); }
         if (e.Components.contains("skinning")) { d->Skinning = std::make_unique<SkinningComponent>(); Serializer::DeserializeSkinning(e.Components["skinning"], *d->Skinning); }
@@ -523,7 +523,7 @@ bool ApplyOverrides(EntityID root, const PrefabOverrides& ov, Scene& scene) {
                 if (!glm::all(glm::epsilonEqual(d->Transform.RotationQ, glm::quat(1,0,0,0), 0.0f))) {
                     d->Transform.UseQuatRotation = true;
                 }
-                d->Transform.TransformDirty = true;
+                scene.MarkTransformDirty(id);
                 d->Transform.CalculateLocalMatrix();
             }
             if (c.contains("mesh")) { if (!d->Mesh) d->Mesh = std::make_unique<MeshComponent>(); }
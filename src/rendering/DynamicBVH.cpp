@@ -0,0 +1,418 @@
+#include "DynamicBVH.h"
+#include "jobs/JobSystem.h"
+#include "jobs/ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using AABB = DynamicBVH::AABB;
+
+// Leaves are fattened by 10% of their extent plus a fixed margin, so small motion does
+// not touch the tree.
+constexpr float kFatMarginRel = 0.1f;
+constexpr float kFatMarginAbs = 0.1f;
+// Below this many leaves a single thread culls faster than the fan-out costs.
+constexpr size_t kParallelCullLeaves = 4096;
+// Subtrees handed out per thread by a parallel cull.
+constexpr size_t kCullTasksPerThread = 4;
+
+enum class Side { Outside, Intersect, Inside };
+
+inline AABB Union(const AABB& a, const AABB& b) {
+   return { glm::min(a.Min, b.Min), glm::max(a.Max, b.Max) };
+   }
+
+inline float Area(const AABB& b) {
+   const glm::vec3 d = b.Max - b.Min;
+   return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+   }
+
+inline bool Contains(const AABB& outer, const AABB& inner) {
+   return glm::all(glm::lessThanEqual(outer.Min, inner.Min)) && glm::all(glm::greaterThanEqual(outer.Max, inner.Max));
+   }
+
+inline AABB Fatten(const AABB& b) {
+   const glm::vec3 margin = (b.Max - b.Min) * kFatMarginRel + glm::vec3(kFatMarginAbs);
+   return { b.Min - margin, b.Max + margin };
+   }
+
+inline Side Classify(const Frustum& f, const AABB& b) {
+   const glm::vec3 c = (b.Min + b.Max) * 0.5f;
+   const glm::vec3 e = (b.Max - b.Min) * 0.5f;
+   bool inside = true;
+   for (const glm::vec4& p : f.Planes) {
+      const glm::vec3 n(p);
+      const float d = glm::dot(n, c) + p.w;
+      const float r = glm::dot(glm::abs(n), e);
+      if (d < -r) return Side::Outside;
+      if (d < r) inside = false;
+      }
+   return inside ? Side::Inside : Side::Intersect;
+   }
+
+inline bool RayHits(const glm::vec3& origin, const glm::vec3& invDir, const AABB& b) {
+   const glm::vec3 t1 = (b.Min - origin) * invDir;
+   const glm::vec3 t2 = (b.Max - origin) * invDir;
+   const glm::vec3 lo = glm::min(t1, t2), hi = glm::max(t1, t2);
+   const float tMin = std::max(std::max(lo.x, lo.y), std::max(lo.z, 0.0f));
+   const float tMax = std::min(std::min(hi.x, hi.y), hi.z);
+   return tMax >= tMin;
+   }
+
+} // namespace
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+   const glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+   const glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+   const glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+   const glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+   Frustum f;
+   f.Planes[0] = r3 + r0; // left
+   f.Planes[1] = r3 - r0; // right
+   f.Planes[2] = r3 + r1; // bottom
+   f.Planes[3] = r3 - r1; // top
+   f.Planes[4] = r3 + r2; // near
+   f.Planes[5] = r3 - r2; // far
+   for (glm::vec4& p : f.Planes) {
+      const float len = glm::length(glm::vec3(p));
+      if (len > 0.0f) p /= len;
+      }
+   return f;
+   }
+
+// ---------------- Proxies ----------------
+
+int32_t DynamicBVH::Insert(const AABB& box, uint32_t id, void* user) {
+   const int32_t proxy = AllocateNode();
+   Node& n = m_Nodes[proxy];
+   n.Tight = box;
+   n.Box = Fatten(box);
+   n.Height = 0;
+   n.Id = id;
+   n.User = user;
+   InsertLeaf(proxy);
+   ++m_LeafCount;
+   return proxy;
+   }
+
+void DynamicBVH::Remove(int32_t proxy) {
+   RemoveLeaf(proxy);
+   FreeNode(proxy);
+   --m_LeafCount;
+   }
+
+bool DynamicBVH::Move(int32_t proxy, const AABB& box) {
+   Node& n = m_Nodes[proxy];
+   n.Tight = box;
+   if (Contains(n.Box, box)) {
+      // Still inside the fat box; re-insert only if it has shrunk a lot, so the tree
+      // does not keep boxes far larger than their contents.
+      const AABB fat = Fatten(box);
+      if (Area(n.Box) <= 4.0f * Area(fat)) return false;
+      }
+   RemoveLeaf(proxy);
+   m_Nodes[proxy].Box = Fatten(box);
+   InsertLeaf(proxy);
+   return true;
+   }
+
+void DynamicBVH::Clear() {
+   m_Nodes.clear();
+   m_Root = kNull;
+   m_FreeList = kNull;
+   m_LeafCount = 0;
+   }
+
+// ---------------- Queries ----------------
+
+void DynamicBVH::CullFrustum(const Frustum& frustum, std::vector<int32_t>& out, JobSystem* js) const {
+   if (m_Root == kNull) return;
+   if (!js || js->WorkerCount() == 0 || m_LeafCount < kParallelCullLeaves) {
+      CullSubtree(frustum, m_Root, false, out);
+      return;
+      }
+
+   // Classify the top of the tree breadth-first until there are enough subtrees to go
+   // around, then cull those independently.
+   struct Task { int32_t Node; bool Inside; };
+   std::vector<Task> frontier{ { m_Root, false } }, next;
+   const size_t target = (js->WorkerCount() + 1) * kCullTasksPerThread;
+   while (frontier.size() < target) {
+      next.clear();
+      bool expanded = false;
+      for (const Task& t : frontier) {
+         const Node& n = m_Nodes[t.Node];
+         if (t.Inside || n.IsLeaf()) { next.push_back(t); continue; }
+         for (int32_t child : { n.Child1, n.Child2 }) {
+            const Node& c = m_Nodes[child];
+            const Side side = Classify(frustum, c.IsLeaf() ? c.Tight : c.Box);
+            if (side == Side::Outside) continue;
+            next.push_back({ child, side == Side::Inside || c.IsLeaf() });
+            }
+         expanded = true;
+         }
+      frontier.swap(next);
+      if (!expanded) break;
+      }
+
+   std::vector<std::vector<int32_t>> parts(frontier.size());
+   parallel_for(*js, size_t{ 0 }, frontier.size(), size_t{ 1 }, [&](size_t s, size_t c) {
+      for (size_t i = s; i < s + c; ++i) {
+         if (frontier[i].Inside) EmitSubtree(frontier[i].Node, parts[i]);
+         else CullSubtree(frustum, frontier[i].Node, false, parts[i]);
+         }
+      });
+   for (const auto& part : parts) out.insert(out.end(), part.begin(), part.end());
+   }
+
+void DynamicBVH::CullSubtree(const Frustum& frustum, int32_t root, bool inside, std::vector<int32_t>& out) const {
+   if (inside) { EmitSubtree(root, out); return; }
+   std::vector<int32_t> stack;
+   stack.reserve(64);
+   stack.push_back(root);
+   while (!stack.empty()) {
+      const int32_t index = stack.back();
+      stack.pop_back();
+      const Node& n = m_Nodes[index];
+      const Side side = Classify(frustum, n.IsLeaf() ? n.Tight : n.Box);
+      if (side == Side::Outside) continue;
+      if (n.IsLeaf()) { out.push_back(index); continue; }
+      if (side == Side::Inside) { EmitSubtree(index, out); continue; }
+      stack.push_back(n.Child2);
+      stack.push_back(n.Child1);
+      }
+   }
+
+void DynamicBVH::EmitSubtree(int32_t root, std::vector<int32_t>& out) const {
+   std::vector<int32_t> stack;
+   stack.reserve(64);
+   stack.push_back(root);
+   while (!stack.empty()) {
+      const int32_t index = stack.back();
+      stack.pop_back();
+      const Node& n = m_Nodes[index];
+      if (n.IsLeaf()) { out.push_back(index); continue; }
+      stack.push_back(n.Child2);
+      stack.push_back(n.Child1);
+      }
+   }
+
+void DynamicBVH::QueryRay(const glm::vec3& origin, const glm::vec3& dir, std::vector<int32_t>& out) const {
+   if (m_Root == kNull) return;
+   glm::vec3 invDir;
+   for (int a = 0; a < 3; ++a)
+      invDir[a] = std::abs(dir[a]) > 1e-12f ? 1.0f / dir[a] : (dir[a] < 0.0f ? -1e12f : 1e12f);
+
+   std::vector<int32_t> stack;
+   stack.reserve(64);
+   stack.push_back(m_Root);
+   while (!stack.empty()) {
+      const int32_t index = stack.back();
+      stack.pop_back();
+      const Node& n = m_Nodes[index];
+      if (!RayHits(origin, invDir, n.IsLeaf() ? n.Tight : n.Box)) continue;
+      if (n.IsLeaf()) { out.push_back(index); continue; }
+      stack.push_back(n.Child2);
+      stack.push_back(n.Child1);
+      }
+   }
+
+// ---------------- Tree maintenance ----------------
+
+int32_t DynamicBVH::AllocateNode() {
+   if (m_FreeList == kNull) {
+      m_Nodes.emplace_back();
+      return (int32_t)m_Nodes.size() - 1;
+      }
+   const int32_t index = m_FreeList;
+   m_FreeList = m_Nodes[index].Parent;
+   m_Nodes[index] = Node{};
+   return index;
+   }
+
+void DynamicBVH::FreeNode(int32_t node) {
+   m_Nodes[node] = Node{};
+   m_Nodes[node].Parent = m_FreeList;
+   m_FreeList = node;
+   }
+
+void DynamicBVH::InsertLeaf(int32_t leaf) {
+   if (m_Root == kNull) {
+      m_Root = leaf;
+      m_Nodes[leaf].Parent = kNull;
+      return;
+      }
+
+   // Walk down to the sibling with the lowest surface-area cost.
+   const AABB leafBox = m_Nodes[leaf].Box;
+   int32_t index = m_Root;
+   while (!m_Nodes[index].IsLeaf()) {
+      const Node& n = m_Nodes[index];
+      const float area = Area(n.Box);
+      const float combinedArea = Area(Union(n.Box, leafBox));
+      // Cost of a new parent for this node and the leaf, and the minimum cost of pushing it further down
+      const float cost = 2.0f * combinedArea;
+      const float inheritance = 2.0f * (combinedArea - area);
+
+      auto descendCost = [&](int32_t child) {
+         const Node& c = m_Nodes[child];
+         const float grown = Area(Union(leafBox, c.Box));
+         return (c.IsLeaf() ? grown : grown - Area(c.Box)) + inheritance;
+         };
+      const float cost1 = descendCost(n.Child1);
+      const float cost2 = descendCost(n.Child2);
+
+      if (cost < cost1 && cost < cost2) break;
+      index = cost1 < cost2 ? n.Child1 : n.Child2;
+      }
+
+   const int32_t sibling = index;
+   const int32_t oldParent = m_Nodes[sibling].Parent;
+   const int32_t newParent = AllocateNode();
+   m_Nodes[newParent].Parent = oldParent;
+   m_Nodes[newParent].Box = Union(leafBox, m_Nodes[sibling].Box);
+   m_Nodes[newParent].Height = m_Nodes[sibling].Height + 1;
+   m_Nodes[newParent].Child1 = sibling;
+   m_Nodes[newParent].Child2 = leaf;
+   m_Nodes[sibling].Parent = newParent;
+   m_Nodes[leaf].Parent = newParent;
+
+   if (oldParent != kNull) {
+      if (m_Nodes[oldParent].Child1 == sibling) m_Nodes[oldParent].Child1 = newParent;
+      else m_Nodes[oldParent].Child2 = newParent;
+      }
+   else {
+      m_Root = newParent;
+      }
+
+   // Refit and rebalance up to the root
+   index = m_Nodes[leaf].Parent;
+   while (index != kNull) {
+      index = Balance(index);
+      Node& n = m_Nodes[index];
+      n.Height = 1 + std::max(m_Nodes[n.Child1].Height, m_Nodes[n.Child2].Height);
+      n.Box = Union(m_Nodes[n.Child1].Box, m_Nodes[n.Child2].Box);
+      index = n.Parent;
+      }
+   }
+
+void DynamicBVH::RemoveLeaf(int32_t leaf) {
+   if (leaf == m_Root) {
+      m_Root = kNull;
+      return;
+      }
+
+   const int32_t parent = m_Nodes[leaf].Parent;
+   const int32_t grandParent = m_Nodes[parent].Parent;
+   const int32_t sibling = m_Nodes[parent].Child1 == leaf ? m_Nodes[parent].Child2 : m_Nodes[parent].Child1;
+
+   if (grandParent == kNull) {
+      m_Root = sibling;
+      m_Nodes[sibling].Parent = kNull;
+      FreeNode(parent);
+      return;
+      }
+
+   // Splice the sibling into the parent's place and refit upwards
+   if (m_Nodes[grandParent].Child1 == parent) m_Nodes[grandParent].Child1 = sibling;
+   else m_Nodes[grandParent].Child2 = sibling;
+   m_Nodes[sibling].Parent = grandParent;
+   FreeNode(parent);
+
+   int32_t index = grandParent;
+   while (index != kNull) {
+      index = Balance(index);
+      Node& n = m_Nodes[index];
+      n.Box = Union(m_Nodes[n.Child1].Box, m_Nodes[n.Child2].Box);
+      n.Height = 1 + std::max(m_Nodes[n.Child1].Height, m_Nodes[n.Child2].Height);
+      index = n.Parent;
+      }
+   }
+
+// Rotates the taller grandchild subtree up when A's children differ in height by more
+// than one. Returns the index now at A's position.
+int32_t DynamicBVH::Balance(int32_t iA) {
+   Node& A = m_Nodes[iA];
+   if (A.IsLeaf() || A.Height < 2) return iA;
+
+   const int32_t iB = A.Child1;
+   const int32_t iC = A.Child2;
+   Node& B = m_Nodes[iB];
+   Node& C = m_Nodes[iC];
+   const int32_t balance = C.Height - B.Height;
+
+   auto replaceInParent = [&](int32_t oldChild, int32_t newChild, int32_t parent) {
+      if (parent == kNull) { m_Root = newChild; return; }
+      if (m_Nodes[parent].Child1 == oldChild) m_Nodes[parent].Child1 = newChild;
+      else m_Nodes[parent].Child2 = newChild;
+      };
+
+   // Rotate C up
+   if (balance > 1) {
+      const int32_t iF = C.Child1;
+      const int32_t iG = C.Child2;
+      Node& F = m_Nodes[iF];
+      Node& G = m_Nodes[iG];
+
+      C.Child1 = iA;
+      C.Parent = A.Parent;
+      A.Parent = iC;
+      replaceInParent(iA, iC, C.Parent);
+
+      if (F.Height > G.Height) {
+         C.Child2 = iF;
+         A.Child2 = iG;
+         G.Parent = iA;
+         A.Box = Union(B.Box, G.Box);
+         C.Box = Union(A.Box, F.Box);
+         A.Height = 1 + std::max(B.Height, G.Height);
+         C.Height = 1 + std::max(A.Height, F.Height);
+         }
+      else {
+         C.Child2 = iG;
+         A.Child2 = iF;
+         F.Parent = iA;
+         A.Box = Union(B.Box, F.Box);
+         C.Box = Union(A.Box, G.Box);
+         A.Height = 1 + std::max(B.Height, F.Height);
+         C.Height = 1 + std::max(A.Height, G.Height);
+         }
+      return iC;
+      }
+
+   // Rotate B up
+   if (balance < -1) {
+      const int32_t iD = B.Child1;
+      const int32_t iE = B.Child2;
+      Node& D = m_Nodes[iD];
+      Node& E = m_Nodes[iE];
+
+      B.Child1 = iA;
+      B.Parent = A.Parent;
+      A.Parent = iB;
+      replaceInParent(iA, iB, B.Parent);
+
+      if (D.Height > E.Height) {
+         B.Child2 = iD;
+         A.Child1 = iE;
+         E.Parent = iA;
+         A.Box = Union(C.Box, E.Box);
+         B.Box = Union(A.Box, D.Box);
+         A.Height = 1 + std::max(C.Height, E.Height);
+         B.Height = 1 + std::max(A.Height, D.Height);
+         }
+      else {
+         B.Child2 = iE;
+         A.Child1 = iD;
+         D.Parent = iA;
+         A.Box = Union(C.Box, D.Box);
+         B.Box = Union(A.Box, E.Box);
+         A.Height = 1 + std::max(C.Height, D.Height);
+         B.Height = 1 + std::max(A.Height, E.Height);
+         }
+      return iB;
+      }
+
+   return iA;
+   }
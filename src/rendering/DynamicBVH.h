@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class JobSystem;
+
+// Six normalized planes (xyz = inward normal, w = distance) of a view-projection.
+struct Frustum {
+   glm::vec4 Planes[6];
+
+   // Gribb-Hartmann extraction. The near plane uses the -w..w clip range, which is
+   // conservative for 0..1 depth as well.
+   static Frustum FromMatrix(const glm::mat4& viewProj);
+   };
+
+// -----------------------------------------------------------------------------
+// Dynamic AABB tree (incrementally balanced, fattened leaves).
+//
+// Each leaf ("proxy") stores the tight box it was given plus a fattened copy the
+// tree is built on, so a proxy that moves a little stays where it is and Move()
+// costs one containment test. Leaves carry an id and an opaque pointer for the
+// owner (Scene stores the EntityID and EntityData*).
+//
+// Proxy ids are node indices and stay valid until Remove(). Not thread-safe for
+// modification; queries may run concurrently with each other.
+// -----------------------------------------------------------------------------
+class DynamicBVH {
+public:
+   struct AABB { glm::vec3 Min, Max; };
+
+   static constexpr int32_t kNull = -1;
+
+   int32_t Insert(const AABB& box, uint32_t id, void* user);
+   void Remove(int32_t proxy);
+   // Updates the tight box. Returns true if the leaf had to be re-inserted.
+   bool Move(int32_t proxy, const AABB& box);
+   void Clear();
+
+   const AABB& Bounds(int32_t proxy) const { return m_Nodes[proxy].Tight; }
+   const AABB& FatBounds(int32_t proxy) const { return m_Nodes[proxy].Box; }
+   uint32_t UserId(int32_t proxy) const { return m_Nodes[proxy].Id; }
+   void* UserData(int32_t proxy) const { return m_Nodes[proxy].User; }
+
+   size_t LeafCount() const { return m_LeafCount; }
+   int32_t Height() const { return m_Root == kNull ? 0 : m_Nodes[m_Root].Height; }
+
+   // Appends every proxy whose tight box intersects the frustum. Subtrees fully inside
+   // are emitted without further plane tests. With a job system, large trees are split
+   // into subtrees that are culled in parallel; output order is deterministic either way.
+   void CullFrustum(const Frustum& frustum, std::vector<int32_t>& out, JobSystem* js = nullptr) const;
+
+   // Appends every proxy whose tight box is hit by the ray (t >= 0), unordered.
+   void QueryRay(const glm::vec3& origin, const glm::vec3& dir, std::vector<int32_t>& out) const;
+
+   // fn(proxy) for every leaf, in storage order.
+   template<class Fn>
+   void ForEachLeaf(Fn&& fn) const {
+      for (int32_t i = 0; i < (int32_t)m_Nodes.size(); ++i)
+         if (m_Nodes[i].Height == 0) fn(i);
+      }
+
+private:
+   struct Node {
+      AABB Box;                 // fattened for leaves, union of children otherwise
+      AABB Tight;               // leaves only
+      int32_t Parent = kNull;   // next free node while on the free list
+      int32_t Child1 = kNull;
+      int32_t Child2 = kNull;
+      int32_t Height = -1;      // 0 = leaf, -1 = free
+      uint32_t Id = 0;
+      void* User = nullptr;
+
+      bool IsLeaf() const { return Child1 == kNull; }
+      };
+
+   int32_t AllocateNode();
+   void FreeNode(int32_t node);
+   void InsertLeaf(int32_t leaf);
+   void RemoveLeaf(int32_t leaf);
+   int32_t Balance(int32_t node);
+   void CullSubtree(const Frustum& frustum, int32_t root, bool inside, std::vector<int32_t>& out) const;
+   void EmitSubtree(int32_t root, std::vector<int32_t>& out) const;
+
+   std::vector<Node> m_Nodes;
+   int32_t m_Root = kNull;
+   int32_t m_FreeList = kNull;
+   size_t m_LeafCount = 0;
+   };
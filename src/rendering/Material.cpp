@@ -1,4 +1,11 @@
 #include "Material.h"
+#include <atomic>
+
+uint32_t Material::NextSortId()
+{
+    static std::atomic<uint32_t> s_Next{ 1 };
+    return s_Next.fetch_add(1, std::memory_order_relaxed);
+}
 
 void Material::SetUniform(const std::string& name, const glm::vec4& value)
 {
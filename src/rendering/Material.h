@@ -22,11 +22,16 @@ public:
     bgfx::ProgramHandle GetProgram() const { return m_Program; }
     uint64_t GetStateFlags() const { return m_StateFlags; }
 	std::string GetName() const { return m_Name; }
+    // Small process-unique id used to group draws by material in the render queue
+    uint32_t GetSortId() const { return m_SortId; }
 
     uint64_t m_StateFlags;
 
 private:  
+    static uint32_t NextSortId();
+
     std::string m_Name;
+    uint32_t m_SortId = NextSortId();
     bgfx::ProgramHandle m_Program;
     
     struct UniformData {
@@ -1,6 +1,6 @@
 #include "MaterialAsset.h"
 #include "ShaderManager.h"
-#include "TextureLoader.h"
+#include "TextureStreamer.h"
 #include "PBRMaterial.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
@@ -68,18 +68,13 @@ std::shared_ptr<Material> CreateMaterialFromAsset(const MaterialAssetDesc& desc)
     // Use PBRMaterial to support standard texture slots, while still allowing vec4 uniforms
     auto mat = std::make_shared<PBRMaterial>(desc.name.empty() ? std::string("Material") : desc.name, program);
 
-    if (!desc.albedoPath.empty()) {
-        bgfx::TextureHandle t = TextureLoader::Load2D(desc.albedoPath);
-        if (bgfx::isValid(t)) static_cast<PBRMaterial*>(mat.get())->SetAlbedoTexture(t);
-    }
-    if (!desc.metallicRoughnessPath.empty()) {
-        bgfx::TextureHandle t = TextureLoader::Load2D(desc.metallicRoughnessPath);
-        if (bgfx::isValid(t)) static_cast<PBRMaterial*>(mat.get())->SetMetallicRoughnessTexture(t);
-    }
-    if (!desc.normalPath.empty()) {
-        bgfx::TextureHandle t = TextureLoader::Load2D(desc.normalPath);
-        if (bgfx::isValid(t)) static_cast<PBRMaterial*>(mat.get())->SetNormalTexture(t);
-    }
+    // Textures stream in; the material shows placeholders until their mips arrive
+    if (!desc.albedoPath.empty())
+        mat->SetAlbedoTexture(TextureStreamer::Instance().Request(desc.albedoPath));
+    if (!desc.metallicRoughnessPath.empty())
+        mat->SetMetallicRoughnessTexture(TextureStreamer::Instance().Request(desc.metallicRoughnessPath));
+    if (!desc.normalPath.empty())
+        mat->SetNormalTexture(TextureStreamer::Instance().Request(desc.normalPath));
 
     for (const auto& kv : desc.vec4Uniforms) {
         mat->SetUniform(kv.first, kv.second);
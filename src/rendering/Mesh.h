@@ -32,8 +32,12 @@ struct Mesh {
     std::vector<glm::vec4> BoneWeights; // xyzw weight
     std::vector<glm::ivec4> BoneIndices;
 
-    glm::vec3 BoundsMin;
-    glm::vec3 BoundsMax;
+    // BlendShapeComponent::VertexSerial of the vertices the dynamic buffer last received
+    // (0: none); another component must upload in full before partial updates
+    uint64_t BlendShapeSerial = 0;
+
+    glm::vec3 BoundsMin{ 0.0f };
+    glm::vec3 BoundsMax{ 0.0f };
 
     bool HasSkinning() const { return !BoneWeights.empty(); }
 
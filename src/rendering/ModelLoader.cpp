@@ -13,6 +13,7 @@
 #include <assimp/postprocess.h>
 
 #include <filesystem>
+#include <functional>
 #include <unordered_map>
 #include <algorithm>
 #include <cstdint>
@@ -20,6 +21,10 @@
 #include <iostream>
 #include <fstream>
 #include "io/FileSystem.h"
+#include "io/MappedFile.h"
+#include "pipeline/ModelCacheFormat.h"
+#include "animation/AnimationAsset.h"
+#include "animation/AnimationImporter.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -61,6 +66,28 @@ static std::string GetTexPath(const aiMaterial* mat, aiTextureType type)
     return {};
 }
 
+// All texture paths across every stack and index (robust for various exporters), without duplicates
+static void GatherTexturePaths(const aiMaterial* aim, std::vector<std::string>& out)
+{
+    static const aiTextureType kTypes[] = {
+        aiTextureType_BASE_COLOR, aiTextureType_DIFFUSE, aiTextureType_SPECULAR, aiTextureType_AMBIENT,
+        aiTextureType_EMISSIVE, aiTextureType_NORMALS, aiTextureType_HEIGHT, aiTextureType_SHININESS,
+        aiTextureType_OPACITY, aiTextureType_DISPLACEMENT, aiTextureType_LIGHTMAP, aiTextureType_REFLECTION,
+        aiTextureType_METALNESS, aiTextureType_DIFFUSE_ROUGHNESS, aiTextureType_AMBIENT_OCCLUSION,
+        aiTextureType_CLEARCOAT, aiTextureType_SHEEN, aiTextureType_TRANSMISSION, aiTextureType_UNKNOWN };
+    for (aiTextureType t : kTypes)
+    {
+        const unsigned count = aim->GetTextureCount(t);
+        for (unsigned ti = 0; ti < count; ++ti)
+        {
+            aiString s;
+            if (aim->GetTexture(t, ti, &s) != AI_SUCCESS) continue;
+            std::string p(s.C_Str());
+            if (!p.empty() && std::find(out.begin(), out.end(), p) == out.end()) out.push_back(std::move(p));
+        }
+    }
+}
+
 // Some glTF 2.0 packs ORM; this tries common slots in reasonable order.
 static void ExtractPbrTextures(const aiMaterial* aim,
     std::string& albedo,
@@ -96,24 +123,10 @@ static void ApplyTexturesToMaterial(Material* mat, const std::string& baseDir,
             return (std::filesystem::path(baseDir) / rel).string();
         };
 
-    if (!albedo.empty())
-    {
-        std::string p = resolve(albedo);
-        auto t = TextureLoader::Load2D(p.c_str());
-        if (bgfx::isValid(t)) { pbr->SetAlbedoTexture(t); pbr->SetAlbedoTextureFromPath(p); }
-    }
-    if (!mr.empty())
-    {
-        std::string p = resolve(mr);
-        auto t = TextureLoader::Load2D(p.c_str());
-        if (bgfx::isValid(t)) { pbr->SetMetallicRoughnessTexture(t); pbr->SetMetallicRoughnessTextureFromPath(p); }
-    }
-    if (!normal.empty())
-    {
-        std::string p = resolve(normal);
-        auto t = TextureLoader::Load2D(p.c_str());
-        if (bgfx::isValid(t)) { pbr->SetNormalTexture(t); pbr->SetNormalTextureFromPath(p); }
-    }
+    // Streamed: the material binds placeholders until the mips arrive
+    if (!albedo.empty()) pbr->SetAlbedoTextureFromPath(resolve(albedo));
+    if (!mr.empty()) pbr->SetMetallicRoughnessTextureFromPath(resolve(mr));
+    if (!normal.empty()) pbr->SetNormalTextureFromPath(resolve(normal));
 }
 
 static inline bool IsFinite3(const glm::vec3& v)
@@ -175,7 +188,62 @@ bool ModelLoader::GetFlipZAxis() { return s_FlipZ; }
 void ModelLoader::SetRotateY180(bool enabled) { s_RotateY180 = enabled; }
 bool ModelLoader::GetRotateY180() { return s_RotateY180; }
 
-Model ModelLoader::LoadModel(const std::string& filepath)
+
+// Vertex streams in upload format; shared by CreateModel and the model cache writer
+void ModelLoader::PackVertexStream(const ImportedMesh& m, std::vector<uint8_t>& out)
+{
+    const size_t n = m.Positions.size();
+    if (m.Skinned)
+    {
+        out.resize(n * sizeof(SkinnedPBRVertex));
+        auto* v = reinterpret_cast<SkinnedPBRVertex*>(out.data());
+        for (size_t i = 0; i < n; ++i)
+        {
+            const glm::vec3& p = m.Positions[i];
+            const glm::vec3& nr = m.Normals[i];
+            const glm::vec2& uv = m.UVs[i];
+            const glm::ivec4& bi = m.BoneIndices[i];
+            const glm::vec4& bw = m.BoneWeights[i];
+            // SkinnedPBRVertex from VertexTypes.h:
+            // (x,y,z, nx,ny,nz, u,v, i0,i1,i2,i3, w0,w1,w2,w3)
+            v[i] = { p.x, p.y, p.z, nr.x, nr.y, nr.z, uv.x, uv.y,
+                     (uint8_t)bi.x, (uint8_t)bi.y, (uint8_t)bi.z, (uint8_t)bi.w,
+                     bw.x, bw.y, bw.z, bw.w };
+        }
+    }
+    else
+    {
+        out.resize(n * sizeof(PBRVertex));
+        auto* v = reinterpret_cast<PBRVertex*>(out.data());
+        for (size_t i = 0; i < n; ++i)
+        {
+            // PBRVertex from VertexTypes.h: (x,y,z, nx,ny,nz, u,v)
+            v[i] = { m.Positions[i].x, m.Positions[i].y, m.Positions[i].z,
+                     m.Normals[i].x, m.Normals[i].y, m.Normals[i].z, m.UVs[i].x, m.UVs[i].y };
+        }
+    }
+}
+
+bool ModelLoader::PackIndexStream(const ImportedMesh& m, std::vector<uint8_t>& out)
+{
+    uint32_t maxIndex = 0;
+    for (uint32_t idx : m.Indices) maxIndex = std::max(maxIndex, idx);
+    const bool use32 = (maxIndex >= 65536u);
+    if (use32)
+    {
+        out.resize(m.Indices.size() * sizeof(uint32_t));
+        std::memcpy(out.data(), m.Indices.data(), out.size());
+    }
+    else
+    {
+        out.resize(m.Indices.size() * sizeof(uint16_t));
+        auto* idx16 = reinterpret_cast<uint16_t*>(out.data());
+        for (size_t i = 0; i < m.Indices.size(); ++i) idx16[i] = (uint16_t)m.Indices[i];
+    }
+    return use32;
+}
+
+static void InitImportLayouts()
 {
     // Initialize the predefined layouts once (from VertexTypes.h)
     static bool layoutsInit = false;
@@ -185,7 +253,142 @@ Model ModelLoader::LoadModel(const std::string& filepath)
         SkinnedPBRVertex::Init();
         layoutsInit = true;
     }
+}
+
+// Dynamic if skinned or has blendshapes (CPU updates). Returns null if bgfx rejected a buffer.
+static std::shared_ptr<Mesh> CreateMeshBuffers(const bgfx::Memory* vbMem, const bgfx::Memory* ibMem,
+    bool skinned, bool dynamic, bool index32, const char* debugName)
+{
+    const bgfx::VertexLayout& layout = skinned ? SkinnedPBRVertex::layout : PBRVertex::layout;
+    std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
+    if (dynamic)
+    {
+        mesh->dvbh = bgfx::createDynamicVertexBuffer(vbMem, layout);
+        mesh->Dynamic = true;
+    }
+    else
+    {
+        mesh->vbh = bgfx::createVertexBuffer(vbMem, layout);
+        mesh->Dynamic = false;
+    }
+    mesh->ibh = index32 ? bgfx::createIndexBuffer(ibMem, BGFX_BUFFER_INDEX32) : bgfx::createIndexBuffer(ibMem);
+
+    // Validate handles
+    bool vbValid = mesh->Dynamic ? bgfx::isValid(mesh->dvbh) : bgfx::isValid(mesh->vbh);
+    if (!vbValid || !bgfx::isValid(mesh->ibh))
+    {
+        std::cerr << "[ModelLoader] ERROR: Failed to create GPU buffers for mesh '" << debugName << "'\n";
+        return nullptr;
+    }
+    return mesh;
+}
 
+// Material for one imported mesh: scene-preset default, tint, then textures resolved from
+// the source-relative path, assets/textures/<modelName>/<file>, or a keyword search there.
+static std::shared_ptr<Material> CreateImportedMaterial(const ImportedMaterial* md, bool skinned, const std::string& filepath)
+{
+    // Use scene preset aware material (skinned variant for skinned meshes)
+    Scene& sc = Scene::Get();
+    std::shared_ptr<Material> mat = skinned
+        ? MaterialManager::Instance().CreateSceneSkinnedDefaultMaterial(&sc)
+        : MaterialManager::Instance().CreateSceneDefaultMaterial(&sc);
+    if (!md) return mat;
+
+    if (md->HasTint)
+    {
+        const_cast<Material*>(mat.get())->SetUniform("u_ColorTint", md->ColorTint);
+    }
+
+    // Attempt to resolve textures from original paths; if those fail,
+    // fall back to <Project::Assets>/textures/<modelName>/<filename>
+    auto* pbr = dynamic_cast<PBRMaterial*>(mat.get());
+    if (!pbr) return mat;
+
+    const std::string baseDir = std::filesystem::path(filepath).parent_path().string();
+    const std::string modelName = std::filesystem::path(filepath).stem().string();
+    const std::filesystem::path texDirA = Project::GetAssetDirectory() / "textures" / modelName;
+    auto tryOriginalThenExtracted = [&](const std::string& src,
+        void(PBRMaterial::*setTexPath)(const std::string&),
+        bgfx::TextureHandle& outHandle)
+    {
+        if (src.empty()) return;
+        // 1) Try FBX-provided path relative to model location
+        std::string original = baseDir.empty() ? src : (std::filesystem::path(baseDir) / src).string();
+        (pbr->*setTexPath)(original);
+        if (bgfx::isValid(outHandle)) return;
+
+        // 2) Fallback: assets/textures/<modelName>/<filename>
+        std::string fname = std::filesystem::path(src).filename().string();
+        std::error_code ec;
+        std::filesystem::path candidate = texDirA / fname;
+        if (std::filesystem::exists(candidate, ec))
+        {
+            (pbr->*setTexPath)(candidate.string());
+            if (bgfx::isValid(outHandle)) return;
+        }
+    };
+
+    tryOriginalThenExtracted(md->AlbedoPath,            &PBRMaterial::SetAlbedoTextureFromPath,             pbr->m_AlbedoTex);
+    tryOriginalThenExtracted(md->MetallicRoughnessPath, &PBRMaterial::SetMetallicRoughnessTextureFromPath, pbr->m_MetallicRoughnessTex);
+    tryOriginalThenExtracted(md->NormalPath,            &PBRMaterial::SetNormalTextureFromPath,             pbr->m_NormalTex);
+
+    // Final fallback: if FBX didn't provide paths (or loads failed),
+    // probe assets/textures/<modelName> for best-effort matches by filename keywords.
+    auto findInDirByKeywords = [&](const std::vector<std::string>& keywords) -> std::string
+    {
+        std::error_code ec;
+        if (std::filesystem::exists(texDirA, ec))
+        {
+            for (auto it = std::filesystem::directory_iterator(texDirA, ec); !ec && it != std::filesystem::end(it); it.increment(ec))
+            {
+                if (!it->is_regular_file(ec)) continue;
+                const std::string fname = it->path().filename().string();
+                // Only consider common image extensions
+                std::string ext = it->path().extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+                if (ext != ".png" && ext != ".jpg" && ext != ".jpeg" && ext != ".tga" && ext != ".bmp") continue;
+                std::string lower = fname;
+                std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+                for (const auto& k : keywords)
+                {
+                    if (lower.find(k) != std::string::npos)
+                        return it->path().string();
+                }
+            }
+        }
+        return {};
+    };
+
+    if (!bgfx::isValid(pbr->m_AlbedoTex))
+    {
+        // Prefer albedo/basecolor/diffuse and common character terms
+        std::string cand = findInDirByKeywords({"albedo","basecolor","base_color","diffuse","color","col","face","body","base"});
+        if (!cand.empty()) pbr->SetAlbedoTextureFromPath(cand);
+    }
+    if (!bgfx::isValid(pbr->m_NormalTex))
+    {
+        std::string cand = findInDirByKeywords({"normal","norm","nrm"});
+        if (!cand.empty()) pbr->SetNormalTextureFromPath(cand);
+    }
+    if (!bgfx::isValid(pbr->m_MetallicRoughnessTex))
+    {
+        // Look for combined ORM or MR maps; also accept roughness/metallic keywords
+        std::string cand = findInDirByKeywords({"metalrough","metallicrough","metal_rough","mr","orm","occlusionroughnessmetallic","rough","metal"});
+        if (!cand.empty()) pbr->SetMetallicRoughnessTextureFromPath(cand);
+    }
+    return mat;
+}
+
+Model ModelLoader::LoadModel(const std::string& filepath)
+{
+    ImportedModel imported;
+    if (!ImportModel(filepath, imported)) return Model{};
+    return CreateModel(imported, filepath);
+}
+
+bool ModelLoader::ImportModel(const std::string& filepath, ImportedModel& out,
+    std::vector<cm::animation::AnimationAsset>* animations)
+{
     Assimp::Importer importer;
     importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
     // If file is inside a mounted pak, extract to temp cache before loading via Assimp
@@ -198,10 +401,10 @@ Model ModelLoader::LoadModel(const std::string& filepath)
             size_t h = std::hash<std::string>{}(filepath);
             std::string ext = std::filesystem::path(filepath).extension().string();
             std::filesystem::path outPath = cacheDir / ("model_" + std::to_string(h) + ext);
-            std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
-            if (out.is_open()) {
-                if (!bytes.empty()) out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
-                out.close();
+            std::ofstream outFile(outPath, std::ios::binary | std::ios::trunc);
+            if (outFile.is_open()) {
+                if (!bytes.empty()) outFile.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+                outFile.close();
                 openPath = outPath.string();
             }
         }
@@ -219,29 +422,19 @@ Model ModelLoader::LoadModel(const std::string& filepath)
         aiProcess_GlobalScale
     );
 
-    Model result;
+    out = ImportedModel{};
     if (!scene || !scene->mRootNode)
     {
         std::cerr << "[ModelLoader] Failed to load: " << filepath
             << " (" << importer.GetErrorString() << ")\n";
-        return result;
-    }
-
-    // Determine unit scale from source (e.g., FBX UnitScaleFactor). Default to 1.0.
-    float importScale = 1.0f;
-    if (scene->mMetaData)
-    {
-        double unitScaleDouble = 1.0;
-        if (scene->mMetaData->Get("UnitScaleFactor", unitScaleDouble))
-            importScale = static_cast<float>(unitScaleDouble);
+        return false;
     }
 
-    const std::string baseDir = std::filesystem::path(filepath).parent_path().string();
+    out.RootTransform = AiToGlm(scene->mRootNode->mTransformation);
+    out.AnimationCount = scene->mNumAnimations;
 
     // ---------------- Scene-wide bone prepass (stable indices across submeshes) ----------------
     std::unordered_map<std::string, uint32_t> boneIndexMap;
-    result.BoneNames.clear();
-    result.InverseBindPoses.clear();
 
     auto registerBone = [&](const aiBone* abone) -> uint32_t
         {
@@ -249,13 +442,13 @@ Model ModelLoader::LoadModel(const std::string& filepath)
             auto it = boneIndexMap.find(name);
             if (it != boneIndexMap.end()) return it->second;
 
-            uint32_t idx = (uint32_t)result.BoneNames.size();
+            uint32_t idx = (uint32_t)out.BoneNames.size();
             boneIndexMap.emplace(name, idx);
-            result.BoneNames.push_back(name);
+            out.BoneNames.push_back(name);
 
             // Use raw construction (no extra transpose) to match skinning convention elsewhere
             glm::mat4 offset = AiToGlm(abone->mOffsetMatrix);
-            result.InverseBindPoses.push_back(offset);
+            out.InverseBindPoses.push_back(offset);
 
             return idx;
         };
@@ -270,42 +463,62 @@ Model ModelLoader::LoadModel(const std::string& filepath)
         }
     }
 
-    // ---------------- Material texture prepass (extract once for every material) ----------------
-    struct ExtractedMaterialData
+    // ---------------- Node prepass: mesh placement and bone parents ----------------
+    out.Meshes.resize(scene->mNumMeshes);
+    std::unordered_map<std::string, const aiNode*> nodeByName;
     {
-        std::string AlbedoPath;
-        std::string MetallicRoughnessPath;
-        std::string NormalPath;
-        glm::vec4   ColorTint = glm::vec4(1.0f);
-        bool        HasTint   = false;
-    };
+        const glm::mat4 invRoot = glm::inverse(out.RootTransform);
+        std::function<void(const aiNode*, const glm::mat4&)> traverse = [&](const aiNode* node, const glm::mat4& parentTransform)
+        {
+            nodeByName[node->mName.C_Str()] = node;
+            const glm::mat4 global = parentTransform * AiToGlm(node->mTransformation);
+            // Keep meshes in the model's local space; the instantiated root carries the root node transform.
+            for (unsigned i = 0; i < node->mNumMeshes; ++i)
+            {
+                const unsigned meshIndex = node->mMeshes[i];
+                if (meshIndex >= out.Meshes.size()) continue;
+                out.Meshes[meshIndex].Transform = invRoot * global;
+                out.Meshes[meshIndex].NodeName = node->mName.C_Str();
+            }
+            for (unsigned c = 0; c < node->mNumChildren; ++c)
+                traverse(node->mChildren[c], global);
+        };
+        traverse(scene->mRootNode, glm::mat4(1.0f));
+    }
+
+    // Parent of a bone = nearest ancestor node that is also a bone
+    out.BoneParents.assign(out.BoneNames.size(), -1);
+    for (size_t i = 0; i < out.BoneNames.size(); ++i)
+    {
+        auto itNode = nodeByName.find(out.BoneNames[i]);
+        if (itNode == nodeByName.end()) continue;
+        for (const aiNode* p = itNode->second->mParent; p; p = p->mParent)
+        {
+            auto itBI = boneIndexMap.find(p->mName.C_Str());
+            if (itBI != boneIndexMap.end()) { out.BoneParents[i] = (int)itBI->second; break; }
+        }
+    }
 
-    std::vector<ExtractedMaterialData> extractedMaterials;
+    // ---------------- Material texture prepass (extract once for every material) ----------------
     if (scene->HasMaterials())
     {
-        extractedMaterials.resize(scene->mNumMaterials);
+        out.Materials.resize(scene->mNumMaterials);
         for (unsigned mi = 0; mi < scene->mNumMaterials; ++mi)
         {
-            std::string albedo, mr, normal;
-            ExtractPbrTextures(scene->mMaterials[mi], albedo, mr, normal);
-            extractedMaterials[mi].AlbedoPath = std::move(albedo);
-            extractedMaterials[mi].MetallicRoughnessPath = std::move(mr);
-            extractedMaterials[mi].NormalPath = std::move(normal);
+            ExtractPbrTextures(scene->mMaterials[mi], out.Materials[mi].AlbedoPath,
+                out.Materials[mi].MetallicRoughnessPath, out.Materials[mi].NormalPath);
+            GatherTexturePaths(scene->mMaterials[mi], out.Materials[mi].TexturePaths);
 
             aiColor4D baseCol(1,1,1,1);
             if (scene->mMaterials[mi]->Get(AI_MATKEY_COLOR_DIFFUSE, baseCol) == AI_SUCCESS)
             {
-                extractedMaterials[mi].ColorTint = glm::vec4(baseCol.r, baseCol.g, baseCol.b, baseCol.a);
-                extractedMaterials[mi].HasTint   = true;
+                out.Materials[mi].ColorTint = glm::vec4(baseCol.r, baseCol.g, baseCol.b, baseCol.a);
+                out.Materials[mi].HasTint   = true;
             }
         }
     }
 
     // ---------------- Convert meshes ----------------
-    result.Meshes.reserve(scene->mNumMeshes);
-    result.Materials.reserve(scene->mNumMeshes);
-    result.BlendShapes.reserve(scene->mNumMeshes);
-
     // Import options for non-skinned meshes
     const bool kFlipYOnImport = s_FlipY;
     const bool kFlipZOnImport = s_FlipZ;
@@ -314,134 +527,21 @@ Model ModelLoader::LoadModel(const std::string& filepath)
     for (unsigned mi = 0; mi < scene->mNumMeshes; ++mi)
     {
         aiMesh* aMesh = scene->mMeshes[mi];
+        ImportedMesh& dst = out.Meshes[mi];
         const bool hasSkin = (aMesh->mNumBones > 0);
         const bool flipYThisMesh = (kFlipYOnImport && !hasSkin);
         const bool flipZThisMesh = (kFlipZOnImport && !hasSkin);
         const bool rotateY180ThisMesh = (kRotateY180 && !hasSkin);
 
-        // ---- Material (create first so we can attach textures later)
-        std::shared_ptr<Material> mat;
-        if (hasSkin)
-        {
-            // Use scene preset aware material for skinned
-            Scene& sc = Scene::Get();
-            mat = MaterialManager::Instance().CreateSceneSkinnedDefaultMaterial(&sc);
-        }
-        else
-        {
-            // Use scene preset aware material
-            Scene& sc = Scene::Get();
-            mat = MaterialManager::Instance().CreateSceneDefaultMaterial(&sc);
-        }
-
-        // Extract & apply textures (using prepass results for every material)
+        dst.Name = aMesh->mName.C_Str();
+        dst.Skinned = hasSkin;
         if (scene->HasMaterials() && aMesh->mMaterialIndex < scene->mNumMaterials)
-        {
-            const ExtractedMaterialData& md = extractedMaterials[aMesh->mMaterialIndex];
-
-            if (md.HasTint)
-            {
-                const_cast<Material*>(mat.get())->SetUniform("u_ColorTint", md.ColorTint);
-            }
-
-            // Attempt to resolve textures from original paths; if those fail,
-            // fall back to <Project::Assets>/textures/<modelName>/<filename>
-            auto* pbr = dynamic_cast<PBRMaterial*>(mat.get());
-            if (pbr)
-            {
-                const std::string modelName = std::filesystem::path(filepath).stem().string();
-                const std::filesystem::path texDirA = Project::GetAssetDirectory() / "textures" / modelName;
-                auto tryOriginalThenExtracted = [&](const std::string& src,
-                    void(PBRMaterial::*setTexPath)(const std::string&),
-                    bgfx::TextureHandle& outHandle)
-                {
-                    if (src.empty()) return;
-                    // 1) Try FBX-provided path relative to model location
-                    std::string original = baseDir.empty() ? src : (std::filesystem::path(baseDir) / src).string();
-                    (pbr->*setTexPath)(original);
-                    if (bgfx::isValid(outHandle)) return;
-
-                    // 2) Fallback: assets/textures/<modelName>/<filename>
-                    std::string fname = std::filesystem::path(src).filename().string();
-                    std::error_code ec;
-                    std::filesystem::path candidate = texDirA / fname;
-                    if (std::filesystem::exists(candidate, ec))
-                    {
-                        (pbr->*setTexPath)(candidate.string());
-                        if (bgfx::isValid(outHandle)) return;
-                    }
-                };
-
-                tryOriginalThenExtracted(md.AlbedoPath,            &PBRMaterial::SetAlbedoTextureFromPath,             pbr->m_AlbedoTex);
-                tryOriginalThenExtracted(md.MetallicRoughnessPath, &PBRMaterial::SetMetallicRoughnessTextureFromPath, pbr->m_MetallicRoughnessTex);
-                tryOriginalThenExtracted(md.NormalPath,            &PBRMaterial::SetNormalTextureFromPath,             pbr->m_NormalTex);
+            dst.MaterialIndex = aMesh->mMaterialIndex;
 
-                // Final fallback: if FBX didn't provide paths (or loads failed),
-                // probe assets/textures/<modelName> for best-effort matches by filename keywords.
-                auto findInDirByKeywords = [&](const std::vector<std::string>& keywords) -> std::string
-                {
-                    std::error_code ec;
-                    if (std::filesystem::exists(texDirA, ec))
-                    {
-                        for (auto it = std::filesystem::directory_iterator(texDirA, ec); !ec && it != std::filesystem::end(it); it.increment(ec))
-                        {
-                            if (!it->is_regular_file(ec)) continue;
-                            const std::string fname = it->path().filename().string();
-                            // Only consider common image extensions
-                            std::string ext = it->path().extension().string();
-                            std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return (char)std::tolower(c); });
-                            if (ext != ".png" && ext != ".jpg" && ext != ".jpeg" && ext != ".tga" && ext != ".bmp") continue;
-                            std::string lower = fname;
-                            std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c){ return (char)std::tolower(c); });
-                            for (const auto& k : keywords)
-                            {
-                                if (lower.find(k) != std::string::npos)
-                                    return it->path().string();
-                            }
-                        }
-                    }
-                    return {};
-                };
-
-                if (!bgfx::isValid(pbr->m_AlbedoTex))
-                {
-                    // Prefer albedo/basecolor/diffuse and common character terms
-                    std::string cand = findInDirByKeywords({"albedo","basecolor","base_color","diffuse","color","col","face","body","base"});
-                    if (!cand.empty()) pbr->SetAlbedoTextureFromPath(cand);
-                }
-                if (!bgfx::isValid(pbr->m_NormalTex))
-                {
-                    std::string cand = findInDirByKeywords({"normal","norm","nrm"});
-                    if (!cand.empty()) pbr->SetNormalTextureFromPath(cand);
-                }
-                if (!bgfx::isValid(pbr->m_MetallicRoughnessTex))
-                {
-                    // Look for combined ORM or MR maps; also accept roughness/metallic keywords
-                    std::string cand = findInDirByKeywords({"metalrough","metallicrough","metal_rough","mr","orm","occlusionroughnessmetallic","rough","metal"});
-                    if (!cand.empty()) pbr->SetMetallicRoughnessTextureFromPath(cand);
-                }
-            }
-        }
-
-        // ---- CPU vertex arrays (final packed types for GPU upload)
-        std::vector<PBRVertex>           vertices;
-        std::vector<SkinnedPBRVertex>    skVertices;
-        std::vector<uint32_t>            indices32;
-        // CPU caches for morph blending (non-skinned meshes store base data here)
-        std::vector<glm::vec3>           meshVerticesCPU; meshVerticesCPU.reserve(aMesh->mNumVertices);
-        std::vector<glm::vec3>           meshNormalsCPU;  meshNormalsCPU.reserve(aMesh->mNumVertices);
-        std::vector<glm::vec2>           meshUVsCPU;      meshUVsCPU.reserve(aMesh->mNumVertices);
-
-        vertices.reserve(hasSkin ? 0 : aMesh->mNumVertices);
-        skVertices.reserve(hasSkin ? aMesh->mNumVertices : 0);
-        indices32.reserve(aMesh->mNumFaces * 3);
-
-        // ---- Gather raw per-vertex base attributes
-        // Also collect skinning weights/indices as top-4
-        std::vector<glm::vec4>   vertWeights(aMesh->mNumVertices, glm::vec4(0.0f));
-        std::vector<glm::ivec4>  vertIndices(aMesh->mNumVertices, glm::ivec4(0));
-
-        // Pre-fill base attributes (pos/norm/uv)
+        // ---- Base attributes (pos/norm/uv), kept on the CPU for picking, bounds and morph blending
+        dst.Positions.reserve(aMesh->mNumVertices);
+        dst.Normals.reserve(aMesh->mNumVertices);
+        dst.UVs.reserve(aMesh->mNumVertices);
         for (unsigned i = 0; i < aMesh->mNumVertices; ++i)
         {
             aiVector3D pos = aMesh->mVertices[i];
@@ -463,24 +563,19 @@ Model ModelLoader::LoadModel(const std::string& filepath)
             // Renormalize after flips
             normal = glm::normalize(normal);
 
-            // Always keep a CPU copy of base data for morph blending (skinned and non-skinned)
-            meshVerticesCPU.push_back(glm::vec3(pos.x, pos.y, pos.z));
-            meshNormalsCPU.push_back(glm::vec3(normal.x, normal.y, normal.z));
-            meshUVsCPU.push_back(glm::vec2(u, v));
-
-            if (!hasSkin)
-            {
-                // PBRVertex from VertexTypes.h: (x,y,z, nx,ny,nz, u,v)
-                vertices.push_back({
-                    pos.x , pos.y , pos.z,
-                    normal.x, normal.y, normal.z, u, v
-                    });
-            }
+            dst.Positions.push_back(glm::vec3(pos.x, pos.y, pos.z));
+            dst.Normals.push_back(normal);
+            dst.UVs.push_back(glm::vec2(u, v));
         }
 
         // ---- Skinning data: accumulate top-4 weights using scene-wide bone indices
         if (hasSkin)
         {
+            std::vector<glm::vec4>&  vertWeights = dst.BoneWeights;
+            std::vector<glm::ivec4>& vertIndices = dst.BoneIndices;
+            vertWeights.assign(aMesh->mNumVertices, glm::vec4(0.0f));
+            vertIndices.assign(aMesh->mNumVertices, glm::ivec4(0));
+
             for (unsigned b = 0; b < aMesh->mNumBones; ++b)
             {
                 const aiBone* bone = aMesh->mBones[b];
@@ -524,206 +619,289 @@ Model ModelLoader::LoadModel(const std::string& filepath)
                 if (sum > 0.0001f) vertWeights[v] /= sum;
                 else { vertWeights[v].x = 1.0f; vertIndices[v].x = 0; }
             }
-
-            // Build SkinnedPBRVertex array
-            skVertices.reserve(aMesh->mNumVertices);
-            for (unsigned i = 0; i < aMesh->mNumVertices; ++i)
-            {
-                aiVector3D pos = aMesh->mVertices[i];
-                aiVector3D norm = aMesh->mNormals ? aMesh->mNormals[i] : aiVector3D(0, 1, 0);
-                aiVector3D uv = aMesh->HasTextureCoords(0) ? aMesh->mTextureCoords[0][i] : aiVector3D(0, 0, 0);
-
-                float u = std::isfinite(uv.x) ? uv.x : 0.0f;
-                float v = std::isfinite(uv.y) ? uv.y : 0.0f;
-
-                glm::vec3 normal(norm.x, norm.y, norm.z);
-                if (!IsFinite3(normal) || glm::length(normal) < 0.001f)
-                    normal = glm::vec3(0.0f, 1.0f, 0.0f);
-                else
-                    normal = glm::normalize(normal);
-
-                if (flipYThisMesh) { pos.y = -pos.y; normal.y = -normal.y; }
-                if (flipZThisMesh) { pos.z = -pos.z; normal.z = -normal.z; }
-                if (rotateY180ThisMesh) { pos.x = -pos.x; normal.x = -normal.x; }
-                normal = glm::normalize(normal);
-
-                const glm::ivec4& bi = vertIndices[i];
-                const glm::vec4& bw = vertWeights[i];
-
-                // SkinnedPBRVertex from VertexTypes.h:
-                // (x,y,z, nx,ny,nz, u,v, i0,i1,i2,i3, w0,w1,w2,w3)
-                skVertices.push_back({
-                    pos.x , pos.y, pos.z,
-                    normal.x, normal.y, normal.z,
-                    u, v,
-                    (uint8_t)bi.x, (uint8_t)bi.y, (uint8_t)bi.z, (uint8_t)bi.w,
-                    bw.x, bw.y, bw.z, bw.w
-                    });
-            }
         }
 
         // ---- Indices
+        dst.Indices.reserve(aMesh->mNumFaces * 3);
         for (unsigned f = 0; f < aMesh->mNumFaces; ++f)
         {
             const aiFace& face = aMesh->mFaces[f];
             if (face.mNumIndices != 3) continue;
-            // Reverse winding only when the scaling changes handedness (odd number of axis flips)
-            indices32.push_back((uint32_t)face.mIndices[0]);
-            indices32.push_back((uint32_t)face.mIndices[1]);
-            indices32.push_back((uint32_t)face.mIndices[2]);
-            
+            dst.Indices.push_back((uint32_t)face.mIndices[0]);
+            dst.Indices.push_back((uint32_t)face.mIndices[1]);
+            dst.Indices.push_back((uint32_t)face.mIndices[2]);
         }
 
-        // ---- Create GPU buffers (use predefined layouts from VertexTypes.h)
-        const bgfx::Memory* vbMem = nullptr;
-        const bgfx::VertexLayout* layoutPtr = nullptr;
-
-        if (hasSkin)
+        // Sanity: indices within range
+        if (!dst.Indices.empty())
         {
-            vbMem = bgfx::copy(skVertices.data(), (uint32_t)(sizeof(SkinnedPBRVertex) * skVertices.size()));
-            layoutPtr = &SkinnedPBRVertex::layout;
+            uint32_t maxIdxCpu = *std::max_element(dst.Indices.begin(), dst.Indices.end());
+            if (maxIdxCpu >= dst.Positions.size())
+            {
+                std::cerr << "[ModelLoader] ERROR: Mesh '" << aMesh->mName.C_Str()
+                    << "' has out-of-bounds index " << maxIdxCpu
+                    << " (vertex count = " << dst.Positions.size() << ")\n";
+            }
         }
-        else
+
+        // ---- Blend Shapes (Morph Targets)
+        for (unsigned a = 0; a < aMesh->mNumAnimMeshes; ++a)
         {
-            vbMem = bgfx::copy(vertices.data(), (uint32_t)(sizeof(PBRVertex) * vertices.size()));
-            layoutPtr = &PBRVertex::layout;
+            aiAnimMesh* anim = aMesh->mAnimMeshes[a];
+            BlendShape bs;
+            bs.Name = NormalizeBlendShapeName(anim->mName.C_Str(), aMesh->mName.C_Str());
+            bs.DeltaPos.reserve(aMesh->mNumVertices);
+            bs.DeltaNormal.reserve(aMesh->mNumVertices);
+
+            for (unsigned v = 0; v < aMesh->mNumVertices; ++v)
+            {
+                // Assimp stores target positions; convert to deltas relative to base mesh
+                const glm::vec3 baseP = dst.Positions[v];
+                aiVector3D ap = anim->mVertices[v];
+                if (flipYThisMesh) ap.y = -ap.y; // match axis flip applied to base
+                if (flipZThisMesh) ap.z = -ap.z;
+                if (rotateY180ThisMesh) ap.x = -ap.x;
+                bs.DeltaPos.emplace_back(glm::vec3(ap.x, ap.y, ap.z) - baseP);
+
+                const glm::vec3 baseN = dst.Normals[v];
+                aiVector3D an = anim->mNormals ? anim->mNormals[v] : aiVector3D(0, 0, 0);
+                if (flipYThisMesh) an.y = -an.y;
+                if (flipZThisMesh) an.z = -an.z;
+                if (rotateY180ThisMesh) an.x = -an.x;
+                bs.DeltaNormal.emplace_back(glm::vec3(an.x, an.y, an.z) - baseN);
+            }
+            dst.BlendShapes.push_back(std::move(bs));
         }
 
-        std::shared_ptr<Mesh> mesh = std::make_shared<Mesh>();
+        // Debug (optional):
+        std::cout << "[ModelLoader] Mesh '" << aMesh->mName.C_Str()
+            << "' verts=" << dst.Positions.size()
+            << " indices=" << dst.Indices.size()
+            << " faces=" << aMesh->mNumFaces
+            << " skinned=" << (hasSkin ? "yes" : "no")
+            << " animMeshes=" << aMesh->mNumAnimMeshes
+            << "\n";
+    }
 
-        // Dynamic if skinned or has blendshapes (CPU updates)
-        if (hasSkin || aMesh->mNumAnimMeshes > 0)
-        {
-            mesh->dvbh = bgfx::createDynamicVertexBuffer(vbMem, *layoutPtr);
-            mesh->Dynamic = true;
-        }
-        else
+    if (animations)
+    {
+        animations->clear();
+        for (unsigned a = 0; a < scene->mNumAnimations; ++a)
+            animations->push_back(cm::animation::AnimationImporter::BuildAsset(scene, a));
+    }
+    return true;
+}
+
+Model ModelLoader::CreateModel(const ImportedModel& imported, const std::string& filepath)
+{
+    InitImportLayouts();
+
+    Model result;
+    result.BoneNames = imported.BoneNames;
+    result.InverseBindPoses = imported.InverseBindPoses;
+    result.BoneParents = imported.BoneParents;
+    result.RootTransform = imported.RootTransform;
+    result.AnimationCount = imported.AnimationCount;
+    result.Meshes.reserve(imported.Meshes.size());
+    result.Materials.reserve(imported.Meshes.size());
+    result.BlendShapes.reserve(imported.Meshes.size());
+
+    std::vector<uint8_t> vertexBytes, indexBytes;
+    for (const ImportedMesh& src : imported.Meshes)
+    {
+        const ImportedMaterial* md = src.MaterialIndex < imported.Materials.size() ? &imported.Materials[src.MaterialIndex] : nullptr;
+        std::shared_ptr<Material> mat = CreateImportedMaterial(md, src.Skinned, filepath);
+
+        PackVertexStream(src, vertexBytes);
+        const bool use32 = PackIndexStream(src, indexBytes);
+        std::shared_ptr<Mesh> mesh = CreateMeshBuffers(
+            bgfx::copy(vertexBytes.data(), (uint32_t)vertexBytes.size()),
+            bgfx::copy(indexBytes.data(), (uint32_t)indexBytes.size()),
+            src.Skinned, src.Skinned || !src.BlendShapes.empty(), use32, src.Name.c_str());
+
+        // Keep every vector indexed like the source meshes (fileID), even for a failed mesh
+        result.MeshTransforms.push_back(src.Transform);
+        result.MeshNodeNames.push_back(src.NodeName);
+        result.Materials.push_back(mat);
+        result.BlendShapes.push_back(BlendShapeComponent{ src.BlendShapes, false });
+        if (mesh)
         {
-            mesh->vbh = bgfx::createVertexBuffer(vbMem, *layoutPtr);
-            mesh->Dynamic = false;
+            mesh->numVertices = (uint32_t)src.Positions.size();
+            mesh->numIndices = (uint32_t)src.Indices.size();
+            // ---- CPU-side data (for picking/AABB/debug and morph blending)
+            mesh->Vertices = src.Positions;
+            mesh->Normals = src.Normals;
+            mesh->UVs = src.UVs;
+            mesh->Indices = src.Indices;
+            // Static meshes carry zero weights, as the importer always has
+            mesh->BoneWeights = src.Skinned ? src.BoneWeights : std::vector<glm::vec4>(src.Positions.size(), glm::vec4(0.0f));
+            mesh->BoneIndices = src.Skinned ? src.BoneIndices : std::vector<glm::ivec4>(src.Positions.size(), glm::ivec4(0));
+            mesh->ComputeBounds();
         }
+        result.Meshes.push_back(mesh);
+    }
+    return result;
+}
 
-        // Choose 16-bit vs 32-bit indices
-        uint32_t maxIndex = 0;
-        for (uint32_t idx : indices32) maxIndex = std::max(maxIndex, idx);
-        const bool use32 = (maxIndex >= 65536u);
+// ------------------------------ Model cache --------------------------------
+namespace {
 
-        if (use32)
+// Keeps the mapping alive until bgfx has consumed every range referenced from it
+void ReleaseMappedRange(void*, void* userData)
+{
+    delete static_cast<std::shared_ptr<MappedFile>*>(userData);
+}
+
+const bgfx::Memory* RefMapped(const std::shared_ptr<MappedFile>& file, const modelcache::BinRange& r)
+{
+    return bgfx::makeRef(file->Data() + r.offset, (uint32_t)r.size, &ReleaseMappedRange, new std::shared_ptr<MappedFile>(file));
+}
+
+template<class T>
+void AssignMapped(std::vector<T>& dst, const uint8_t* base, size_t size, const modelcache::BinRange& r, size_t count)
+{
+    const T* src = modelcache::ArrayAt<T>(base, size, r, count);
+    if (src) dst.assign(src, src + count);
+    else dst.clear();
+}
+
+} // namespace
+
+Model ModelLoader::LoadModelCache(const std::string& meshBinPath, const std::string& skelBinPath, const std::string& sourcePath)
+{
+    using namespace modelcache;
+    InitImportLayouts();
+
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(meshBinPath) || file->Size() < sizeof(MeshBinHeader)) return Model{};
+    const uint8_t* base = file->Data();
+    const size_t size = file->Size();
+
+    MeshBinHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != kMeshBinMagic || header.version != kVersion) return Model{};
+    const MeshBinMesh* meshes = ArrayAt<MeshBinMesh>(base, size, header.meshes, header.meshCount);
+    const MeshBinMaterial* materials = ArrayAt<MeshBinMaterial>(base, size, header.materials, header.materialCount);
+    if (!meshes || !materials || !RangeValid(header.strings, size))
+    {
+        std::cerr << "[ModelLoader] Corrupt model cache: " << meshBinPath << "\n";
+        return Model{};
+    }
+
+    Model result;
+    result.RootTransform = glm::make_mat4(header.rootTransform);
+    result.AnimationCount = header.animationCount;
+
+    for (uint32_t mi = 0; mi < header.meshCount; ++mi)
+    {
+        const MeshBinMesh& mb = meshes[mi];
+        const bool skinned = (mb.flags & MeshSkinned) != 0;
+        const bool index32 = (mb.flags & MeshIndex32) != 0;
+        const size_t n = mb.vertexCount;
+        const size_t stride = skinned ? sizeof(SkinnedPBRVertex) : sizeof(PBRVertex);
+        const char* name = StringAt(base, header.strings, mb.name);
+
+        std::shared_ptr<Material> mat;
+        if (mb.materialIndex < header.materialCount)
         {
-            const bgfx::Memory* imem = bgfx::copy(indices32.data(), (uint32_t)(indices32.size() * sizeof(uint32_t)));
-            mesh->ibh = bgfx::createIndexBuffer(imem, BGFX_BUFFER_INDEX32);
+            const MeshBinMaterial& m = materials[mb.materialIndex];
+            ImportedMaterial md;
+            md.AlbedoPath = StringAt(base, header.strings, m.albedo);
+            md.MetallicRoughnessPath = StringAt(base, header.strings, m.metallicRoughness);
+            md.NormalPath = StringAt(base, header.strings, m.normal);
+            md.HasTint = m.hasTint != 0;
+            md.ColorTint = glm::make_vec4(m.tint);
+            mat = CreateImportedMaterial(&md, skinned, sourcePath);
         }
         else
         {
-            std::vector<uint16_t> idx16; idx16.reserve(indices32.size());
-            for (uint32_t v : indices32) idx16.push_back((uint16_t)v);
-            const bgfx::Memory* imem = bgfx::copy(idx16.data(), (uint32_t)(idx16.size() * sizeof(uint16_t)));
-            mesh->ibh = bgfx::createIndexBuffer(imem);
+            mat = CreateImportedMaterial(nullptr, skinned, sourcePath);
         }
 
-        mesh->numVertices = hasSkin ? (uint32_t)skVertices.size() : (uint32_t)vertices.size();
-        mesh->numIndices = (uint32_t)indices32.size();
-
-        // Validate handles
-        bool vbValid = mesh->Dynamic ? bgfx::isValid(mesh->dvbh) : bgfx::isValid(mesh->vbh);
-        if (!vbValid || !bgfx::isValid(mesh->ibh))
+        BlendShapeComponent blend;
+        const MeshBinBlendShape* shapes = ArrayAt<MeshBinBlendShape>(base, size, mb.blendShapes, mb.blendShapeCount);
+        for (uint32_t s = 0; shapes && s < mb.blendShapeCount; ++s)
         {
-            std::cerr << "[ModelLoader] ERROR: Failed to create GPU buffers for mesh '"
-                << aMesh->mName.C_Str() << "'\n";
-            continue;
+            BlendShape bs;
+            bs.Name = StringAt(base, header.strings, shapes[s].name);
+            AssignMapped(bs.DeltaPos, base, size, shapes[s].deltaPositions, n);
+            AssignMapped(bs.DeltaNormal, base, size, shapes[s].deltaNormals, n);
+            blend.Shapes.push_back(std::move(bs));
         }
 
-        // ---- CPU-side data (for picking/AABB/debug)
-        mesh->Vertices.reserve(aMesh->mNumVertices);
-        mesh->Normals.reserve(aMesh->mNumVertices);
-        mesh->BoneWeights = vertWeights;
-        mesh->BoneIndices = vertIndices;
-
-        for (unsigned i = 0; i < aMesh->mNumVertices; ++i)
+        // GPU streams go to bgfx straight from the mapping
+        std::shared_ptr<Mesh> mesh;
+        const bool streamsValid = RangeValid(mb.gpuVertices, size) && mb.gpuVertices.size == n * stride
+            && RangeValid(mb.indices, size) && mb.indices.size == size_t(mb.indexCount) * (index32 ? 4 : 2);
+        if (streamsValid)
         {
-            aiVector3D p = aMesh->mVertices[i];
-            if (flipYThisMesh) p.y = -p.y;
-            if (flipZThisMesh) p.z = -p.z;
-            if (rotateY180ThisMesh) p.x = -p.x;
-            mesh->Vertices.emplace_back(p.x , p.y , p.z );
-
-            aiVector3D n = aMesh->mNormals ? aMesh->mNormals[i] : aiVector3D(0, 0, 1);
-            if (flipYThisMesh) n.y = -n.y;
-            if (flipZThisMesh) n.z = -n.z;
-            if (rotateY180ThisMesh) n.x = -n.x;
-            mesh->Normals.emplace_back(n.x, n.y, n.z);
+            mesh = CreateMeshBuffers(RefMapped(file, mb.gpuVertices), RefMapped(file, mb.indices),
+                skinned, skinned || !blend.Shapes.empty(), index32, name);
         }
-        mesh->Indices = indices32;
-
-        // Sanity: indices within range
-        if (!indices32.empty())
+        else
         {
-            uint32_t maxIdxCpu = *std::max_element(indices32.begin(), indices32.end());
-            const size_t vcount = mesh->numVertices;
-            if (maxIdxCpu >= vcount)
-            {
-                std::cerr << "[ModelLoader] ERROR: Mesh '" << aMesh->mName.C_Str()
-                    << "' has out-of-bounds index " << maxIdxCpu
-                    << " (vertex count = " << vcount << ")\n";
-            }
+            std::cerr << "[ModelLoader] Corrupt mesh '" << name << "' in model cache: " << meshBinPath << "\n";
         }
 
-        mesh->ComputeBounds();
-
-        // ---- Blend Shapes (Morph Targets)
-        BlendShapeComponent blendComp;
-        if (aMesh->mNumAnimMeshes > 0)
+        if (mesh)
         {
-            for (unsigned a = 0; a < aMesh->mNumAnimMeshes; ++a)
+            mesh->numVertices = mb.vertexCount;
+            mesh->numIndices = mb.indexCount;
+            AssignMapped(mesh->Vertices, base, size, mb.positions, n);
+            AssignMapped(mesh->Normals, base, size, mb.normals, n);
+            AssignMapped(mesh->UVs, base, size, mb.uvs, n);
+            if (index32)
             {
-                aiAnimMesh* anim = aMesh->mAnimMeshes[a];
-                BlendShape bs;
-                bs.Name = NormalizeBlendShapeName(anim->mName.C_Str(), aMesh->mName.C_Str());
-                bs.DeltaPos.reserve(aMesh->mNumVertices);
-                bs.DeltaNormal.reserve(aMesh->mNumVertices);
-
-                for (unsigned v = 0; v < aMesh->mNumVertices; ++v)
-                {
-                    // Assimp stores target positions; convert to deltas relative to base mesh
-                    const glm::vec3 baseP = (v < meshVerticesCPU.size()) ? meshVerticesCPU[v] : glm::vec3(0);
-                    aiVector3D ap = anim->mVertices[v];
-                    if (flipYThisMesh) ap.y = -ap.y; // match axis flip applied to base
-                    if (flipZThisMesh) ap.z = -ap.z;
-                    if (rotateY180ThisMesh) ap.x = -ap.x;
-                    const glm::vec3 tgtP(ap.x, ap.y, ap.z);
-                    bs.DeltaPos.emplace_back(tgtP - baseP);
-
-                    const glm::vec3 baseN = (v < meshNormalsCPU.size()) ? meshNormalsCPU[v] : glm::vec3(0, 1, 0);
-                    aiVector3D an = anim->mNormals ? anim->mNormals[v] : aiVector3D(0, 0, 0);
-                    if (flipYThisMesh) an.y = -an.y;
-                    if (flipZThisMesh) an.z = -an.z;
-                    if (rotateY180ThisMesh) an.x = -an.x;
-                    const glm::vec3 tgtN(an.x, an.y, an.z);
-                    bs.DeltaNormal.emplace_back(tgtN - baseN);
-                }
-                blendComp.Shapes.push_back(std::move(bs));
+                AssignMapped(mesh->Indices, base, size, mb.indices, mb.indexCount);
+            }
+            else
+            {
+                const uint16_t* idx16 = reinterpret_cast<const uint16_t*>(base + mb.indices.offset);
+                mesh->Indices.assign(idx16, idx16 + mb.indexCount);
+            }
+            if (skinned)
+            {
+                AssignMapped(mesh->BoneWeights, base, size, mb.boneWeights, n);
+                AssignMapped(mesh->BoneIndices, base, size, mb.boneIndices, n);
             }
+            else
+            {
+                // Static meshes carry zero weights, as the importer always has
+                mesh->BoneWeights.assign(n, glm::vec4(0.0f));
+                mesh->BoneIndices.assign(n, glm::ivec4(0));
+            }
+            mesh->BoundsMin = glm::make_vec3(mb.boundsMin);
+            mesh->BoundsMax = glm::make_vec3(mb.boundsMax);
         }
 
-        // Fill CPU caches for morph blending (both skinned and non-skinned)
-        mesh->Vertices = std::move(meshVerticesCPU);
-        mesh->Normals  = std::move(meshNormalsCPU);
-        mesh->UVs      = std::move(meshUVsCPU);
-
-        // ---- Append to result
         result.Meshes.push_back(mesh);
         result.Materials.push_back(mat);
-        result.BlendShapes.push_back(std::move(blendComp));
-
-        // Debug (optional):
-        std::cout << "[ModelLoader] Mesh '" << aMesh->mName.C_Str()
-            << "' verts=" << mesh->numVertices
-            << " indices=" << mesh->numIndices
-            << " faces=" << aMesh->mNumFaces
-            << " skinned=" << (hasSkin ? "yes" : "no")
-            << " animMeshes=" << aMesh->mNumAnimMeshes
-            << "\n";
+        result.BlendShapes.push_back(std::move(blend));
+        result.MeshTransforms.push_back(glm::make_mat4(mb.transform));
+        result.MeshNodeNames.push_back(StringAt(base, header.strings, mb.nodeName));
     }
 
+    // Skeleton
+    MappedFile skel;
+    if (!skelBinPath.empty() && skel.Open(skelBinPath) && skel.Size() >= sizeof(SkelBinHeader))
+    {
+        SkelBinHeader sh;
+        std::memcpy(&sh, skel.Data(), sizeof(sh));
+        const uint8_t* sb = skel.Data();
+        const uint32_t* names = ArrayAt<uint32_t>(sb, skel.Size(), sh.names, sh.boneCount);
+        const int32_t* parents = ArrayAt<int32_t>(sb, skel.Size(), sh.parents, sh.boneCount);
+        const glm::mat4* invBind = ArrayAt<glm::mat4>(sb, skel.Size(), sh.inverseBindPoses, sh.boneCount);
+        if (sh.magic == kSkelBinMagic && sh.version == kVersion && names && parents && invBind && RangeValid(sh.strings, skel.Size()))
+        {
+            result.BoneNames.reserve(sh.boneCount);
+            for (uint32_t b = 0; b < sh.boneCount; ++b) result.BoneNames.emplace_back(StringAt(sb, sh.strings, names[b]));
+            result.BoneParents.assign(parents, parents + sh.boneCount);
+            result.InverseBindPoses.assign(invBind, invBind + sh.boneCount);
+        }
+        else
+        {
+            std::cerr << "[ModelLoader] Ignoring corrupt skeleton cache: " << skelBinPath << "\n";
+        }
+    }
     return result;
 }
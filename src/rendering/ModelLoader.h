@@ -5,12 +5,57 @@
 #include "Mesh.h"
 #include "ecs/AnimationComponents.h"
 
+namespace cm { namespace animation { struct AnimationAsset; } }
+
 struct Model {
    std::vector<std::shared_ptr<Mesh>> Meshes;
    std::vector<std::shared_ptr<Material>> Materials;
    std::vector<BlendShapeComponent> BlendShapes;
    std::vector<std::string> BoneNames;
    std::vector<glm::mat4> InverseBindPoses;
+
+   // Node data for instantiation, indexed like Meshes / BoneNames
+   std::vector<int> BoneParents;            // -1 for roots
+   std::vector<glm::mat4> MeshTransforms;   // relative to the model root node
+   std::vector<std::string> MeshNodeNames;  // node that references the mesh
+   glm::mat4 RootTransform{ 1.0f };
+   uint32_t AnimationCount = 0;             // clips in the source file
+   };
+
+// CPU-side result of one Assimp import: everything a Model is built from, without
+// GPU buffers or materials, so it can run on a worker thread or go to the model cache.
+struct ImportedMaterial {
+   std::string AlbedoPath;
+   std::string MetallicRoughnessPath;
+   std::string NormalPath;
+   std::vector<std::string> TexturePaths;   // every texture any stack references, for texture capture
+   glm::vec4 ColorTint{ 1.0f };
+   bool HasTint = false;
+   };
+
+struct ImportedMesh {
+   std::string Name;
+   std::string NodeName;
+   glm::mat4 Transform{ 1.0f };
+   uint32_t MaterialIndex = UINT32_MAX;
+   bool Skinned = false;
+   std::vector<glm::vec3> Positions;
+   std::vector<glm::vec3> Normals;
+   std::vector<glm::vec2> UVs;
+   std::vector<uint32_t> Indices;
+   std::vector<glm::vec4> BoneWeights;  // skinned only, normalized top-4
+   std::vector<glm::ivec4> BoneIndices;
+   std::vector<BlendShape> BlendShapes;
+   };
+
+struct ImportedModel {
+   glm::mat4 RootTransform{ 1.0f };
+   std::vector<ImportedMesh> Meshes;
+   std::vector<ImportedMaterial> Materials;
+   std::vector<std::string> BoneNames;
+   std::vector<int> BoneParents;
+   std::vector<glm::mat4> InverseBindPoses;
+   uint32_t AnimationCount = 0;
    };
 
 class ModelLoader {
@@ -26,8 +71,26 @@ public:
     // Load a model using the current global configuration
     static Model LoadModel(const std::string& filepath);
 
+    // Assimp stage of LoadModel. Touches no GPU or material state; optionally also
+    // converts the file's animations (bone tracks keyed by node name).
+    static bool ImportModel(const std::string& filepath, ImportedModel& out,
+        std::vector<cm::animation::AnimationAsset>* animations = nullptr);
+    // GPU/material stage of LoadModel (main thread)
+    static Model CreateModel(const ImportedModel& imported, const std::string& filepath);
+
+    // Upload-format streams of one mesh: PBRVertex or SkinnedPBRVertex, and 16-bit
+    // indices unless some index needs 32 (returns true then)
+    static void PackVertexStream(const ImportedMesh& mesh, std::vector<uint8_t>& out);
+    static bool PackIndexStream(const ImportedMesh& mesh, std::vector<uint8_t>& out);
+
+    // Builds the model from a .meshbin (+ .skelbin next to it) written by the model
+    // cache. The file is memory-mapped and the vertex/index streams are handed to
+    // bgfx by reference; 'sourcePath' resolves material texture paths. Returns a
+    // model without meshes if the cache is missing or stale.
+    static Model LoadModelCache(const std::string& meshBinPath, const std::string& skelBinPath, const std::string& sourcePath);
+
 private:
     static bool s_FlipY;
     static bool s_FlipZ;
     static bool s_RotateY180;
-};
\ No newline at end of file
+};
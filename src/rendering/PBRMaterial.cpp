@@ -1,5 +1,6 @@
 #include "PBRMaterial.h"
 #include "TextureLoader.h"
+#include "TextureStreamer.h"
 
 PBRMaterial::PBRMaterial(const std::string& name, bgfx::ProgramHandle program)
     : Material(name, program,
@@ -30,28 +31,47 @@ PBRMaterial::PBRMaterial(const std::string& name, bgfx::ProgramHandle program, u
     SetUniform("u_ColorTint", glm::vec4(1.0f));
 }
 
-void PBRMaterial::SetAlbedoTexture(bgfx::TextureHandle texture) { m_AlbedoTex = texture; }
-void PBRMaterial::SetMetallicRoughnessTexture(bgfx::TextureHandle texture) { m_MetallicRoughnessTex = texture; }
-void PBRMaterial::SetNormalTexture(bgfx::TextureHandle texture) { m_NormalTex = texture; }
+void PBRMaterial::SetAlbedoTexture(bgfx::TextureHandle texture) { m_AlbedoTex = texture; m_AlbedoStream.reset(); }
+void PBRMaterial::SetMetallicRoughnessTexture(bgfx::TextureHandle texture) { m_MetallicRoughnessTex = texture; m_MetallicRoughnessStream.reset(); }
+void PBRMaterial::SetNormalTexture(bgfx::TextureHandle texture) { m_NormalTex = texture; m_NormalStream.reset(); }
+
+void PBRMaterial::SetAlbedoTexture(std::shared_ptr<StreamedTexture> texture) {
+    if (!texture) return;
+    m_AlbedoTex = texture->Handle;
+    m_AlbedoStream = std::move(texture);
+}
+
+void PBRMaterial::SetMetallicRoughnessTexture(std::shared_ptr<StreamedTexture> texture) {
+    if (!texture) return;
+    m_MetallicRoughnessTex = texture->Handle;
+    m_MetallicRoughnessStream = std::move(texture);
+}
+
+void PBRMaterial::SetNormalTexture(std::shared_ptr<StreamedTexture> texture) {
+    if (!texture) return;
+    m_NormalTex = texture->Handle;
+    m_NormalStream = std::move(texture);
+}
 
 void PBRMaterial::SetAlbedoTextureFromPath(const std::string& path) {
     m_AlbedoPath = path;
-    bgfx::TextureHandle t = TextureLoader::Load2D(path);
-    if (bgfx::isValid(t)) m_AlbedoTex = t;
+    SetAlbedoTexture(TextureStreamer::Instance().Request(path));
 }
 
 void PBRMaterial::SetMetallicRoughnessTextureFromPath(const std::string& path) {
     m_MetallicRoughnessPath = path;
-    bgfx::TextureHandle t = TextureLoader::Load2D(path);
-    if (bgfx::isValid(t)) m_MetallicRoughnessTex = t;
+    SetMetallicRoughnessTexture(TextureStreamer::Instance().Request(path));
 }
 
 void PBRMaterial::SetNormalTextureFromPath(const std::string& path) {
     m_NormalPath = path;
-    bgfx::TextureHandle t = TextureLoader::Load2D(path);
-    if (bgfx::isValid(t)) m_NormalTex = t;
+    SetNormalTexture(TextureStreamer::Instance().Request(path));
 }
 
+bgfx::TextureHandle PBRMaterial::GetAlbedoTexture() const { return m_AlbedoStream ? m_AlbedoStream->Handle : m_AlbedoTex; }
+bgfx::TextureHandle PBRMaterial::GetMetallicRoughnessTexture() const { return m_MetallicRoughnessStream ? m_MetallicRoughnessStream->Handle : m_MetallicRoughnessTex; }
+bgfx::TextureHandle PBRMaterial::GetNormalTexture() const { return m_NormalStream ? m_NormalStream->Handle : m_NormalTex; }
+
 void PBRMaterial::BindUniforms() const
    {
    Material::BindUniforms();
@@ -71,7 +91,11 @@ void PBRMaterial::BindUniforms() const
    };
    ensureDefaults();
 
-   bgfx::setTexture(0, u_AlbedoSampler, bgfx::isValid(m_AlbedoTex) ? m_AlbedoTex : s_defaultWhite);
-   bgfx::setTexture(1, u_MetallicRoughnessSampler, bgfx::isValid(m_MetallicRoughnessTex) ? m_MetallicRoughnessTex : s_defaultMR);
-   bgfx::setTexture(2, u_NormalSampler, bgfx::isValid(m_NormalTex) ? m_NormalTex : s_defaultNrm);
+   // Streamed slots are read (and marked used) at bind time
+   const bgfx::TextureHandle albedo = m_AlbedoStream ? m_AlbedoStream->Use() : m_AlbedoTex;
+   const bgfx::TextureHandle mr = m_MetallicRoughnessStream ? m_MetallicRoughnessStream->Use() : m_MetallicRoughnessTex;
+   const bgfx::TextureHandle normal = m_NormalStream ? m_NormalStream->Use() : m_NormalTex;
+   bgfx::setTexture(0, u_AlbedoSampler, bgfx::isValid(albedo) ? albedo : s_defaultWhite);
+   bgfx::setTexture(1, u_MetallicRoughnessSampler, bgfx::isValid(mr) ? mr : s_defaultMR);
+   bgfx::setTexture(2, u_NormalSampler, bgfx::isValid(normal) ? normal : s_defaultNrm);
    }
@@ -1,8 +1,11 @@
 #pragma once
 #include "Material.h"
 #include <bgfx/bgfx.h>
+#include <memory>
 #include <string>
 
+struct StreamedTexture;
+
 class PBRMaterial : public Material
    {
    public:
@@ -16,13 +19,24 @@ class PBRMaterial : public Material
       void SetMetallicRoughnessTexture(bgfx::TextureHandle texture);
       void SetNormalTexture(bgfx::TextureHandle texture);
 
-      // Convenience setters that also remember source paths for serialization
+      // Streamed slots (TextureStreamer): the handle is re-read at bind time as mips arrive
+      void SetAlbedoTexture(std::shared_ptr<StreamedTexture> texture);
+      void SetMetallicRoughnessTexture(std::shared_ptr<StreamedTexture> texture);
+      void SetNormalTexture(std::shared_ptr<StreamedTexture> texture);
+
+      // Convenience setters that stream the texture and remember its path for serialization
       void SetAlbedoTextureFromPath(const std::string& path);
       void SetMetallicRoughnessTextureFromPath(const std::string& path);
       void SetNormalTextureFromPath(const std::string& path);
 
+      // Current handle of each slot, streamed or not
+      bgfx::TextureHandle GetAlbedoTexture() const;
+      bgfx::TextureHandle GetMetallicRoughnessTexture() const;
+      bgfx::TextureHandle GetNormalTexture() const;
+
       void BindUniforms() const override;
       
+      // Valid once a slot has a texture; a streamed slot's live handle is Get*Texture()
       bgfx::TextureHandle m_AlbedoTex;
       bgfx::TextureHandle m_MetallicRoughnessTex;
       bgfx::TextureHandle m_NormalTex;
@@ -42,5 +56,9 @@ class PBRMaterial : public Material
       std::string m_AlbedoPath;
       std::string m_MetallicRoughnessPath;
       std::string m_NormalPath;
+
+      std::shared_ptr<StreamedTexture> m_AlbedoStream;
+      std::shared_ptr<StreamedTexture> m_MetallicRoughnessStream;
+      std::shared_ptr<StreamedTexture> m_NormalStream;
    };
  
\ No newline at end of file
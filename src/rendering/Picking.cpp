@@ -1,4 +1,6 @@
 #include "Picking.h"
+#include "ecs/CpuSkinning.h"
+#include "ecs/AnimationComponents.h"
 #include <limits>
 #include <cfloat>
 
@@ -43,24 +45,36 @@ int Picking::PickEntityRay(const Ray& ray, Scene& scene) {
     int pickedEntity = -1;
     float closestT = FLT_MAX;
 
+    // Broad phase: only meshes whose world bounds the ray passes through
+    const DynamicBVH& bounds = scene.GetBounds();
+    std::vector<int32_t> candidates;
+    bounds.QueryRay(ray.Origin, ray.Direction, candidates);
+
     // First pass: collect candidate hits with distance, then sort by distance ascending.
     struct Hit { EntityID id; float t; float diag; };
-    std::vector<Hit> hits; hits.reserve(scene.GetEntities().size());
-    for (auto& entity : scene.GetEntities()) {
-        auto* data = scene.GetEntityData(entity.GetID());
+    std::vector<Hit> hits; hits.reserve(candidates.size());
+    for (int32_t proxy : candidates) {
+        const EntityID entityId = bounds.UserId(proxy);
+        auto* data = static_cast<EntityData*>(bounds.UserData(proxy));
         if (!data || !data->Mesh) continue;
         // Skip invisible entities entirely
         if (!data->Visible) continue;
 
         // Use precomputed world matrix (includes parent hierarchy)
         glm::mat4 transform = data->Transform.WorldMatrix;
+        // Take a strong reference to guard against entity deletion during this loop
+        std::shared_ptr<Mesh> meshRef = data->Mesh->mesh;
+        if (!meshRef) continue;
+        // Animated triangles and bounds when the mesh is CPU-skinned, else the bind pose
+        const SkinningComponent* skin = HasCpuSkinnedPose(data->Skinning.get(), *meshRef) ? data->Skinning.get() : nullptr;
+        const glm::vec3 boundsMin = skin ? skin->SkinnedBoundsMin : meshRef->BoundsMin;
+        const glm::vec3 boundsMax = skin ? skin->SkinnedBoundsMax : meshRef->BoundsMax;
         // Optional early-out: if camera is inside the entity's OBB, skip picking this entity
         // This helps when navigating inside large enclosing meshes (e.g., room walls)
-        if (data->Mesh && data->Mesh->mesh) {
-            const Mesh& meshBoundsSrc = *data->Mesh->mesh.get();
+        {
             // Only if bounds are valid (min <= max across axes)
-            glm::vec3 bmin = meshBoundsSrc.BoundsMin;
-            glm::vec3 bmax = meshBoundsSrc.BoundsMax;
+            glm::vec3 bmin = boundsMin;
+            glm::vec3 bmax = boundsMax;
             // Transform camera (ray origin) to local space and test against AABB
             glm::mat4 inv = glm::inverse(transform);
             glm::vec3 camLocal = glm::vec3(inv * glm::vec4(ray.Origin, 1.0f));
@@ -76,17 +90,14 @@ int Picking::PickEntityRay(const Ray& ray, Scene& scene) {
 
         float tTri = FLT_MAX;
         bool triHit = false;
-        // Take a strong reference to guard against entity deletion during this loop
-        std::shared_ptr<Mesh> meshRef = data->Mesh->mesh;
-        if (!meshRef) continue;
-        triHit = RayIntersectsMesh(ray, *meshRef.get(), transform, tTri);
+        triHit = RayIntersectsMesh(ray, *meshRef.get(), skin ? skin->SkinnedPositions.data() : nullptr, transform, tTri);
 
         // Fallback: if triangle data is not available or no tri hit, intersect against OBB from mesh bounds
         float tObb = FLT_MAX;
         bool obbHit = false;
         {
-            const glm::vec3 bmin = meshRef->BoundsMin;
-            const glm::vec3 bmax = meshRef->BoundsMax;
+            const glm::vec3 bmin = boundsMin;
+            const glm::vec3 bmax = boundsMax;
             if (bmax.x > bmin.x && bmax.y > bmin.y && bmax.z > bmin.z) {
                 float tTmp;
                 if (RayIntersectsOBB(ray, transform, bmin, bmax, tTmp)) {
@@ -100,21 +111,13 @@ int Picking::PickEntityRay(const Ray& ray, Scene& scene) {
         if (obbHit && tObb > 0.0f && tObb < tHit) { anyHit = true; tHit = tObb; }
 
         if (anyHit) {
-            // Approximate world-space diagonal of the entity's bounds for size biasing
-            glm::vec3 bmin = meshRef->BoundsMin;
-            glm::vec3 bmax = meshRef->BoundsMax;
-            glm::vec3 corners[8] = {
-                {bmin.x,bmin.y,bmin.z},{bmax.x,bmin.y,bmin.z},{bmin.x,bmax.y,bmin.z},{bmax.x,bmax.y,bmin.z},
-                {bmin.x,bmin.y,bmax.z},{bmax.x,bmin.y,bmax.z},{bmin.x,bmax.y,bmax.z},{bmax.x,bmax.y,bmax.z}
-            };
-            glm::vec3 wmin( FLT_MAX), wmax(-FLT_MAX);
-            for (int i=0;i<8;i++) {
-                glm::vec3 wp = glm::vec3(transform * glm::vec4(corners[i], 1.0f));
-                wmin = glm::min(wmin, wp);
-                wmax = glm::max(wmax, wp);
-            }
-            float diag = glm::length(wmax - wmin);
-            hits.push_back({ entity.GetID(), tHit, diag });
+            // World-space AABB diagonal of the mesh bounds for size biasing (centre/extent form)
+            const glm::vec3 e = (boundsMax - boundsMin) * 0.5f;
+            const glm::vec3 we = glm::abs(glm::vec3(transform[0])) * e.x
+                               + glm::abs(glm::vec3(transform[1])) * e.y
+                               + glm::abs(glm::vec3(transform[2])) * e.z;
+            float diag = 2.0f * glm::length(we);
+            hits.push_back({ entityId, tHit, diag });
         }
     }
     if (hits.empty()) return -1;
@@ -243,18 +246,27 @@ bool Picking::RayIntersectsTriangle(const glm::vec3& origin, const glm::vec3& di
     return t > EPSILON;
 }
 
-bool Picking::RayIntersectsMesh(const Ray& ray, const Mesh& mesh, const glm::mat4& transform, float& closestT) {
+bool Picking::RaycastEntity(const Ray& ray, const EntityData& data, float& t) {
+    if (!data.Mesh || !data.Mesh->mesh) return false;
+    const Mesh& mesh = *data.Mesh->mesh;
+    const SkinningComponent* skin = data.Skinning.get();
+    const glm::vec3* positions = HasCpuSkinnedPose(skin, mesh) ? skin->SkinnedPositions.data() : nullptr;
+    return RayIntersectsMesh(ray, mesh, positions, data.Transform.WorldMatrix, t);
+}
+
+bool Picking::RayIntersectsMesh(const Ray& ray, const Mesh& mesh, const glm::vec3* positions, const glm::mat4& transform, float& closestT) {
     closestT = FLT_MAX;
     bool hit = false;
+    const glm::vec3* verts = positions ? positions : mesh.Vertices.data();
 
     glm::mat4 invTransform = glm::inverse(transform);
     glm::vec3 localOrigin = glm::vec3(invTransform * glm::vec4(ray.Origin, 1.0f));
     glm::vec3 localDir = glm::normalize(glm::vec3(invTransform * glm::vec4(ray.Direction, 0.0f)));
 
     for (size_t i = 0; i < mesh.Indices.size(); i += 3) {
-        glm::vec3 v0 = mesh.Vertices[mesh.Indices[i]];
-        glm::vec3 v1 = mesh.Vertices[mesh.Indices[i + 1]];
-        glm::vec3 v2 = mesh.Vertices[mesh.Indices[i + 2]];
+        glm::vec3 v0 = verts[mesh.Indices[i]];
+        glm::vec3 v1 = verts[mesh.Indices[i + 1]];
+        glm::vec3 v2 = verts[mesh.Indices[i + 2]];
 
         float t;
         if (RayIntersectsTriangle(localOrigin, localDir, v0, v1, v2, t)) {
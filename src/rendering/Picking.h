@@ -28,12 +28,17 @@ public:
     static bool HadPickThisFrame();
     static bool HadHitThisFrame();
 
+    // Closest hit of a world-space ray against the entity's triangles, skinned when the
+    // mesh is CPU-skinned (ecs/CpuSkinning.h); no camera or GPU needed (server hitboxes)
+    static bool RaycastEntity(const Ray& ray, const EntityData& data, float& t);
+
 private:
     // Existing intersection methods (unchanged)
     static bool RayIntersectsAABB(const Ray& ray, const glm::vec3& min, const glm::vec3& max, float& t);
     static bool RayIntersectsOBB(const Ray& ray, const glm::mat4& transform, const glm::vec3& min, const glm::vec3& max, float& t);
     static bool RayIntersectsTriangle(const glm::vec3& origin, const glm::vec3& dir, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float& t);
-    static bool RayIntersectsMesh(const Ray& ray, const Mesh& mesh, const glm::mat4& transform, float& closestT);
+    // 'positions' replaces mesh.Vertices when not null (CPU-skinned vertices)
+    static bool RayIntersectsMesh(const Ray& ray, const Mesh& mesh, const glm::vec3* positions, const glm::mat4& transform, float& closestT);
 
     // Internal helpers
     static int PickEntityRay(const Ray& ray, Scene& scene);
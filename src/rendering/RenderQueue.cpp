@@ -0,0 +1,226 @@
+#include "RenderQueue.h"
+#include "Mesh.h"
+#include "Material.h"
+#include "MaterialPropertyBlock.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Bindings and state survive into the next draw when it uses the same material.
+constexpr uint8_t kDiscardKeepMaterial =
+   BGFX_DISCARD_INDEX_BUFFER | BGFX_DISCARD_INSTANCE_DATA | BGFX_DISCARD_TRANSFORM | BGFX_DISCARD_VERTEX_STREAMS;
+
+constexpr uint64_t kTranslucentBit = uint64_t(1) << 55;
+
+// Smaller groups are submitted as plain draws
+constexpr uint32_t kMinInstances = 4;
+// World matrix (4 columns) + tint
+constexpr uint16_t kInstanceStride = 20 * sizeof(float);
+
+// Positive IEEE floats order like their bit patterns; the top 16 bits give a
+// log-spaced bucket (exponent + 7 mantissa bits).
+inline uint64_t DepthBucket(float depth) {
+   if (!(depth > 0.0f)) return 0;
+   uint32_t bits;
+   std::memcpy(&bits, &depth, sizeof(bits));
+   return bits >> 16;
+   }
+
+void SetGeometry(const DrawItem& d) {
+   const Mesh& mesh = *d.MeshPtr;
+   if (mesh.Dynamic) bgfx::setVertexBuffer(0, mesh.dvbh, 0, mesh.numVertices);
+   else bgfx::setVertexBuffer(0, mesh.vbh);
+   if (d.IndexCount == UINT32_MAX) bgfx::setIndexBuffer(mesh.ibh);
+   else bgfx::setIndexBuffer(mesh.ibh, d.IndexStart, d.IndexCount);
+   }
+
+// Tint the item contributes to its instance; false if its property block overrides
+// more than u_ColorTint, which instance data cannot carry.
+bool InstanceTint(const DrawItem& d, const glm::vec4& materialTint, glm::vec4& out) {
+   out = materialTint;
+   if (!d.Block) return true;
+   if (!d.Block->Textures.empty()) return false;
+   for (const auto& kv : d.Block->Vec4Uniforms) {
+      if (kv.first != "u_ColorTint") return false;
+      out = kv.second;
+      }
+   return true;
+   }
+
+bool SameGeometry(const DrawItem& a, const DrawItem& b) {
+   return a.MeshPtr == b.MeshPtr && a.IndexStart == b.IndexStart && a.IndexCount == b.IndexCount;
+   }
+
+} // namespace
+
+void RenderQueue::Add(bgfx::ViewId view, const DrawItem& item, float viewDepth) {
+   const uint64_t program = item.Mat->GetProgram().idx & 0x7FFFu;
+   const uint64_t material = item.Mat->GetSortId() & 0xFFFFFFu;
+   const uint64_t depth = DepthBucket(viewDepth);
+   const bool translucent = (item.Mat->GetStateFlags() & BGFX_STATE_BLEND_MASK) != 0;
+
+   uint64_t key = uint64_t(view) << 56;
+   if (translucent)
+      key |= (uint64_t(1) << 55) | ((0xFFFFu - depth) << 39) | (program << 24) | material;
+   else
+      key |= (program << 40) | (material << 16) | depth;
+
+   m_Keys.push_back({ key, (uint32_t)m_Items.size() });
+   m_Items.push_back(item);
+   }
+
+// LSD radix sort, one byte per pass; passes where every key has the same byte are skipped.
+void RenderQueue::Sort() {
+   const size_t n = m_Keys.size();
+   if (n < 2) return;
+   m_Scratch.resize(n);
+   SortEntry* src = m_Keys.data();
+   SortEntry* dst = m_Scratch.data();
+
+   for (int pass = 0; pass < 8; ++pass) {
+      const int shift = pass * 8;
+      size_t count[256] = {};
+      for (size_t i = 0; i < n; ++i) ++count[(src[i].Key >> shift) & 0xFF];
+      if (count[(src[0].Key >> shift) & 0xFF] == n) continue;
+
+      size_t offset = 0;
+      for (size_t& c : count) { const size_t t = c; c = offset; offset += t; }
+      for (size_t i = 0; i < n; ++i) dst[count[(src[i].Key >> shift) & 0xFF]++] = src[i];
+      std::swap(src, dst);
+      }
+   if (src != m_Keys.data()) std::memcpy(m_Keys.data(), src, n * sizeof(SortEntry));
+   }
+
+void RenderQueue::Submit(bgfx::UniformHandle normalMatrixUniform) {
+   m_MaterialBinds = 0;
+   m_DrawCalls = 0;
+   m_InstancedItems = 0;
+   m_Bound = nullptr;
+   m_BoundNormal = nullptr;
+
+   // Runs of consecutive items that share view and material
+   size_t begin = 0;
+   while (begin < m_Keys.size()) {
+      const Material* mat = m_Items[m_Keys[begin].Item].Mat;
+      const uint64_t view = m_Keys[begin].Key >> 56;
+      size_t end = begin + 1;
+      while (end < m_Keys.size() && m_Items[m_Keys[end].Item].Mat == mat && (m_Keys[end].Key >> 56) == view) ++end;
+      SubmitRun(begin, end, normalMatrixUniform);
+      begin = end;
+      }
+   }
+
+void RenderQueue::SubmitRun(size_t begin, size_t end, bgfx::UniformHandle normalMatrixUniform) {
+   const bgfx::ViewId view = bgfx::ViewId(m_Keys[begin].Key >> 56);
+   const Material* mat = m_Items[m_Keys[begin].Item].Mat;
+
+   bgfx::ProgramHandle instanced = BGFX_INVALID_HANDLE;
+   if (m_VariantOf && end - begin >= kMinInstances && !(m_Keys[begin].Key & kTranslucentBit))
+      instanced = m_VariantOf(mat->GetProgram());
+   if (!bgfx::isValid(instanced)) {
+      for (size_t e = begin; e < end; ++e)
+         SubmitSingle(view, m_Items[m_Keys[e].Item], normalMatrixUniform, e + 1 == end);
+      return;
+      }
+
+   // Group the instanceable items by geometry; the rest keep their key order
+   glm::vec4 materialTint(1.0f);
+   mat->TryGetUniform("u_ColorTint", materialTint);
+   m_Batched.clear();
+   m_Batches.clear();
+   m_Singles.clear();
+   for (size_t e = begin; e < end; ++e) {
+      glm::vec4 tint;
+      if (InstanceTint(m_Items[m_Keys[e].Item], materialTint, tint)) m_Batched.push_back({ (uint32_t)e, tint });
+      else m_Singles.push_back((uint32_t)e);
+      }
+   std::sort(m_Batched.begin(), m_Batched.end(), [this](const BatchedItem& a, const BatchedItem& b) {
+      const DrawItem& da = m_Items[m_Keys[a.Entry].Item];
+      const DrawItem& db = m_Items[m_Keys[b.Entry].Item];
+      if (da.MeshPtr != db.MeshPtr) return std::less<const Mesh*>()(da.MeshPtr, db.MeshPtr);
+      if (da.IndexStart != db.IndexStart) return da.IndexStart < db.IndexStart;
+      if (da.IndexCount != db.IndexCount) return da.IndexCount < db.IndexCount;
+      return a.Entry < b.Entry;
+      });
+   for (size_t g = 0; g < m_Batched.size();) {
+      const DrawItem& first = m_Items[m_Keys[m_Batched[g].Entry].Item];
+      size_t n = 1;
+      while (g + n < m_Batched.size() && SameGeometry(first, m_Items[m_Keys[m_Batched[g + n].Entry].Item])) ++n;
+      if (n >= kMinInstances) m_Batches.push_back({ (uint32_t)g, (uint32_t)n });
+      else for (size_t k = g; k < g + n; ++k) m_Singles.push_back(m_Batched[k].Entry);
+      g += n;
+      }
+   std::sort(m_Singles.begin(), m_Singles.end());
+
+   const size_t draws = m_Batches.size() + m_Singles.size();
+   size_t drawn = 0;
+   for (const Batch& b : m_Batches)
+      SubmitInstanced(view, instanced, b, normalMatrixUniform, ++drawn == draws);
+   for (uint32_t e : m_Singles)
+      SubmitSingle(view, m_Items[m_Keys[e].Item], normalMatrixUniform, ++drawn == draws);
+   }
+
+void RenderQueue::SubmitInstanced(bgfx::ViewId view, bgfx::ProgramHandle program, const Batch& batch,
+                                  bgfx::UniformHandle normalMatrixUniform, bool last) {
+   const DrawItem& d = m_Items[m_Keys[m_Batched[batch.First].Entry].Item];
+   uint32_t done = 0;
+   while (done < batch.Count) {
+      const uint32_t count = bgfx::getAvailInstanceDataBuffer(batch.Count - done, kInstanceStride);
+      if (count == 0) break;
+      bgfx::InstanceDataBuffer idb;
+      bgfx::allocInstanceDataBuffer(&idb, count, kInstanceStride);
+      float* dst = reinterpret_cast<float*>(idb.data);
+      for (uint32_t i = 0; i < count; ++i, dst += kInstanceStride / sizeof(float)) {
+         const BatchedItem& b = m_Batched[batch.First + done + i];
+         std::memcpy(dst, m_Items[m_Keys[b.Entry].Item].Transform, 16 * sizeof(float));
+         std::memcpy(dst + 16, &b.Tint[0], 4 * sizeof(float));
+         }
+      done += count;
+
+      SetGeometry(d);
+      bgfx::setInstanceDataBuffer(&idb);
+      // Tint-only property blocks travel in the instance data; never apply them here
+      if (d.Mat != m_Bound) BindMaterial(*d.Mat);
+      const bool keep = !(last && done == batch.Count);
+      bgfx::submit(view, program, 0, keep ? kDiscardKeepMaterial : BGFX_DISCARD_ALL);
+      m_Bound = keep ? d.Mat : nullptr;
+      ++m_DrawCalls;
+      m_InstancedItems += count;
+      }
+
+   // Out of transient instance memory this frame: draw the remainder one by one
+   for (; done < batch.Count; ++done) {
+      const DrawItem& item = m_Items[m_Keys[m_Batched[batch.First + done].Entry].Item];
+      SubmitSingle(view, item, normalMatrixUniform, last && done + 1 == batch.Count);
+      }
+   }
+
+void RenderQueue::SubmitSingle(bgfx::ViewId view, const DrawItem& d, bgfx::UniformHandle normalMatrixUniform, bool last) {
+   bgfx::setTransform(d.Transform);
+   SetGeometry(d);
+
+   // Submeshes of one entity share the matrix; uniforms persist between draws
+   if (d.NormalMatrix != m_BoundNormal) {
+      bgfx::setUniform(normalMatrixUniform, d.NormalMatrix);
+      m_BoundNormal = d.NormalMatrix;
+      }
+
+   if (d.Mat != m_Bound || d.Block) {
+      BindMaterial(*d.Mat);
+      if (d.Block) d.Mat->ApplyPropertyBlock(*d.Block);
+      }
+
+   // Keep the material bound if the next draw of the run uses it as-is. Property-block
+   // overrides are not undone, so a draw with one always leaves the material unbound.
+   const bool keep = !last && !d.Block;
+   bgfx::submit(view, d.Mat->GetProgram(), 0, keep ? kDiscardKeepMaterial : BGFX_DISCARD_ALL);
+   m_Bound = keep ? d.Mat : nullptr;
+   ++m_DrawCalls;
+   }
+
+void RenderQueue::BindMaterial(const Material& mat) {
+   mat.BindUniforms();
+   bgfx::setState(mat.GetStateFlags());
+   ++m_MaterialBinds;
+   }
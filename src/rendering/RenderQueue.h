@@ -0,0 +1,89 @@
+#pragma once
+#include <bgfx/bgfx.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct Mesh;
+class Material;
+struct MaterialPropertyBlock;
+
+// One submesh (or whole mesh) draw. Pointers must stay valid until Submit() returns.
+struct DrawItem {
+   const Mesh* MeshPtr = nullptr;
+   const Material* Mat = nullptr;
+   const MaterialPropertyBlock* Block = nullptr; // per-entity overrides; null when empty
+   const float* Transform = nullptr;             // world matrix, column-major
+   const float* NormalMatrix = nullptr;          // transpose(inverse(mat3(world))) as mat4
+   uint32_t IndexStart = 0;
+   uint32_t IndexCount = UINT32_MAX;             // UINT32_MAX = whole index buffer
+   };
+
+// -----------------------------------------------------------------------------
+// Per-frame draw list. Items are gathered in any order, radix-sorted on a 64-bit
+// key and submitted so that material uniforms, textures and render state are
+// only bound when the material changes between consecutive draws.
+//
+// Key (high to low bits):
+//   opaque:      view:8 | 0:1 | program:15 | material:24 | depth:16 (front to back)
+//   translucent: view:8 | 1:1 | depth:16 (back to front) | program:15 | material:24
+//
+// Consecutive draws inherit uniforms from the previous one, so the views drawn
+// through a queue must be in bgfx::ViewMode::Sequential (the queue's order is the
+// order bgfx executes).
+//
+// With instancing enabled, opaque draws that share material and geometry (mesh and
+// index range) are collapsed into one instanced draw using the material program's
+// instanced variant. Instance data is the world matrix plus a tint (i_data4); a
+// property block that only overrides u_ColorTint is packed into the tint, any other
+// block keeps the draw on the regular path.
+// -----------------------------------------------------------------------------
+class RenderQueue {
+public:
+   void Clear() { m_Items.clear(); m_Keys.clear(); }
+   // 'viewDepth' is the view-space distance of the item (only its order matters).
+   void Add(bgfx::ViewId view, const DrawItem& item, float viewDepth);
+   void Sort();
+   // Submits every item in key order. 'normalMatrixUniform' receives DrawItem::NormalMatrix.
+   void Submit(bgfx::UniformHandle normalMatrixUniform);
+
+   // 'variantOf' maps a material program to its instanced variant (invalid = none).
+   // An empty function disables instancing.
+   using InstancedVariantFn = std::function<bgfx::ProgramHandle(bgfx::ProgramHandle)>;
+   void SetInstancing(InstancedVariantFn variantOf) { m_VariantOf = std::move(variantOf); }
+
+   size_t Size() const { return m_Items.size(); }
+   // Stats of the last Submit
+   size_t MaterialBinds() const { return m_MaterialBinds; }    // one per run of draws sharing a material
+   size_t DrawCalls() const { return m_DrawCalls; }            // bgfx::submit calls
+   size_t InstancedItems() const { return m_InstancedItems; }  // items drawn through instancing
+
+private:
+   struct SortEntry { uint64_t Key; uint32_t Item; };
+   // Instanced draw of m_Batched[First, First + Count)
+   struct Batch { uint32_t First; uint32_t Count; };
+   struct BatchedItem { uint32_t Entry; glm::vec4 Tint; };
+
+   void SubmitRun(size_t begin, size_t end, bgfx::UniformHandle normalMatrixUniform);
+   void SubmitInstanced(bgfx::ViewId view, bgfx::ProgramHandle program, const Batch& batch,
+                        bgfx::UniformHandle normalMatrixUniform, bool last);
+   void SubmitSingle(bgfx::ViewId view, const DrawItem& d, bgfx::UniformHandle normalMatrixUniform, bool last);
+   void BindMaterial(const Material& mat);
+
+   std::vector<DrawItem> m_Items;
+   std::vector<SortEntry> m_Keys;
+   std::vector<SortEntry> m_Scratch;    // radix ping-pong buffer
+   InstancedVariantFn m_VariantOf;
+
+   // Per-run scratch
+   std::vector<BatchedItem> m_Batched;
+   std::vector<Batch> m_Batches;
+   std::vector<uint32_t> m_Singles;     // entries drawn one by one, in key order
+
+   const Material* m_Bound = nullptr;   // material whose uniforms/textures/state are still set
+   const float* m_BoundNormal = nullptr;
+   size_t m_MaterialBinds = 0;
+   size_t m_DrawCalls = 0;
+   size_t m_InstancedItems = 0;
+   };
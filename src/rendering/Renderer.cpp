@@ -20,10 +20,13 @@
 
 #include "TextRenderer.h"
 #include "pipeline/AssetLibrary.h"
+#include "TextureStreamer.h"
 #include "editor/Input.h"
 
 #include <core/application.h>
 #include "Terrain.h"
+#include "utils/Profiler.h"
+#include "jobs/Jobs.h"
 #include <limits>
 #include <algorithm>
 
@@ -83,6 +86,7 @@ void Renderer::Init(uint32_t width, uint32_t height, void* windowHandle) {
    TerrainVertex::Init();
    ParticleVertex::Init();
    UIVertex::Init();
+   TextureStreamer::Instance().Init();
 
    // Debug line program
    m_DebugLineProgram = ShaderManager::Instance().LoadProgram("vs_debug", "fs_debug");
@@ -154,6 +158,11 @@ void Renderer::Init(uint32_t width, uint32_t height, void* windowHandle) {
    u_SkyHorizon = bgfx::createUniform("u_skyHorizon", bgfx::UniformType::Vec4);
 
 
+   // Opaque PBR/PSX draws sharing mesh and material are collapsed into instanced draws
+   m_RenderQueue.SetInstancing([](bgfx::ProgramHandle program) {
+      return ShaderManager::Instance().GetInstancedVariant(program);
+      });
+
    // Terrain resources
    m_TerrainProgram = ShaderManager::Instance().LoadProgram("vs_pbr", "fs_pbr");
    m_TerrainHeightTexProgram = ShaderManager::Instance().LoadProgram("vs_terrain_height_texture", "fs_terrain");
@@ -195,6 +204,7 @@ Renderer::~Renderer() {
 
 void Renderer::Shutdown() {
    if (bgfx::isValid(m_DebugLineProgram)) bgfx::destroy(m_DebugLineProgram);
+   TextureStreamer::Instance().Shutdown();
    bgfx::shutdown();
    }
 
@@ -369,17 +379,17 @@ void Renderer::RenderScene(Scene& scene) {
    // --------------------------------------
    std::vector<LightData> lights;
    lights.reserve(4); // Max 4 lights for now
-   for (auto& entity : scene.GetEntities()) {
-      auto* data = scene.GetEntityData(entity.GetID());
-      if (!data || !data->Light || !data->Visible) continue;
+   for (auto [lightId, entity, light] : scene.View<EntityData, LightComponent>()) {
+      auto* data = &entity;
+      if (!data->Visible) continue;
 
       LightData ld;
-      ld.type = data->Light->Type;
-      ld.color = data->Light->Color * data->Light->Intensity;
+      ld.type = light.Type;
+      ld.color = light.Color * light.Intensity;
       ld.position = data->Transform.Position;
 
       // Compute direction for directional lights
-      if (data->Light->Type == LightType::Directional) {
+      if (light.Type == LightType::Directional) {
          float yaw = glm::radians(data->Transform.Rotation.y);
          float pitch = glm::radians(data->Transform.Rotation.x);
          ld.direction = glm::normalize(glm::vec3(
@@ -414,66 +424,17 @@ void Renderer::RenderScene(Scene& scene) {
    UploadLightsToShader(lights);
 
    // --------------------------------------
-   // Draw all meshes
+   // Draw all meshes inside the view frustum
    // --------------------------------------
-   // Take a snapshot of entity IDs to avoid iterator invalidation during deletions
-   std::vector<EntityID> entityIds;
-   entityIds.reserve(scene.GetEntities().size());
-   for (const auto& eSnap : scene.GetEntities()) entityIds.push_back(eSnap.GetID());
-
-   for (EntityID eid : entityIds) {
-      auto* data = scene.GetEntityData(eid);
-      if (!data || !data->Visible || !data->Mesh || !data->Mesh->mesh) continue;
-
-      // Hold a local strong ref to guard against concurrent resets
-      std::shared_ptr<Mesh> meshPtr = data->Mesh->mesh; // local strong ref
-      if (!meshPtr) continue;
-
-      bool meshValid = meshPtr->Dynamic ? bgfx::isValid(meshPtr->dvbh) : bgfx::isValid(meshPtr->vbh);
-      if (!meshValid || !bgfx::isValid(meshPtr->ibh)) {
-         std::cerr << "Invalid mesh for entity " << eid << "\n";
-         continue;
-         }
-
-      float transform[16];
-      memcpy(transform, glm::value_ptr(data->Transform.WorldMatrix), sizeof(float) * 16);
-
-
-      // If the mesh has submeshes and the component has multiple materials, draw per submesh/material slot
-      if (!meshPtr->Submeshes.empty() && !data->Mesh->materials.empty()) {
-         for (const auto& sm : meshPtr->Submeshes) {
-            const size_t slot = sm.materialSlot < data->Mesh->materials.size() ? sm.materialSlot : 0;
-            const Material* mat = data->Mesh->materials[slot] ? data->Mesh->materials[slot].get() : data->Mesh->material.get();
-            if (!mat) mat = data->Mesh->material.get();
-            bgfx::setTransform(transform);
-            if (meshPtr->Dynamic) {
-               if (bgfx::isValid(meshPtr->dvbh)) {
-                  bgfx::setVertexBuffer(0, meshPtr->dvbh, 0, meshPtr->numVertices);
-               } else {
-                  continue;
-               }
-            } else {
-               bgfx::setVertexBuffer(0, meshPtr->vbh);
-            }
-            // Submit only the sub-range of indices
-            bgfx::setIndexBuffer(meshPtr->ibh, sm.indexStart, sm.indexCount);
-            // Normal matrix for this draw
-            glm::mat4 modelMtx = glm::make_mat4(transform);
-            glm::mat3 n3 = glm::transpose(glm::inverse(glm::mat3(modelMtx)));
-            glm::mat4 normalMat4(1.0f); normalMat4[0] = glm::vec4(n3[0], 0.0f); normalMat4[1] = glm::vec4(n3[1], 0.0f); normalMat4[2] = glm::vec4(n3[2], 0.0f);
-            bgfx::setUniform(u_normalMat, glm::value_ptr(normalMat4));
-
-            mat->BindUniforms();
-            if (data->Mesh && !data->Mesh->PropertyBlock.Empty())
-               mat->ApplyPropertyBlock(data->Mesh->PropertyBlock);
-            bgfx::setState(mat->GetStateFlags());
-            if (bgfx::isValid(mat->GetProgram()))
-               bgfx::submit(1, mat->GetProgram());
-         }
-      } else {
-         DrawMesh(*meshPtr.get(), transform, *data->Mesh->material, &data->Mesh->PropertyBlock);
-      }
-      }
+   // The queue's order is final and relies on draws inheriting material uniforms
+   bgfx::setViewMode(1, bgfx::ViewMode::Sequential);
+   CullScene(scene, proj * view);
+   BuildMeshQueue(scene, 1, view);
+   m_RenderQueue.Sort();
+   m_RenderQueue.Submit(u_normalMat);
+   Profiler::Get().RecordCounter("Render/Draws", (int64_t)m_RenderQueue.DrawCalls());
+   Profiler::Get().RecordCounter("Render/Instanced Items", (int64_t)m_RenderQueue.InstancedItems());
+   Profiler::Get().RecordCounter("Render/Material Binds", (int64_t)m_RenderQueue.MaterialBinds());
 
    // --------------------------------------
    // Draw all terrains
@@ -550,29 +511,17 @@ void Renderer::RenderScene(Scene& scene) {
             }
          }
 
-      // Picking AABBs (world-space) around meshes
+      // Picking/culling AABBs (world-space) around meshes, straight from the bounds tree
       if (m_ShowAABBs) {
-         for (auto& entity : scene.GetEntities()) {
-            auto* data = scene.GetEntityData(entity.GetID());
-            if (!data || !data->Visible || !data->Mesh || !data->Mesh->mesh) continue;
-            std::shared_ptr<Mesh> meshPtr = data->Mesh->mesh;
-            if (!meshPtr) continue;
-            // Transform local AABB to world-space by transforming the 8 corners and recomputing min/max
-            const glm::vec3 lmin = meshPtr->BoundsMin;
-            const glm::vec3 lmax = meshPtr->BoundsMax;
-            glm::vec3 corners[8] = {
-               {lmin.x, lmin.y, lmin.z}, {lmax.x, lmin.y, lmin.z}, {lmin.x, lmax.y, lmin.z}, {lmax.x, lmax.y, lmin.z},
-               {lmin.x, lmin.y, lmax.z}, {lmax.x, lmin.y, lmax.z}, {lmin.x, lmax.y, lmax.z}, {lmax.x, lmax.y, lmax.z}
-            };
-            glm::vec3 wmin( std::numeric_limits<float>::max());
-            glm::vec3 wmax(-std::numeric_limits<float>::max());
-            for (int i = 0; i < 8; ++i) {
-               glm::vec3 w = glm::vec3(data->Transform.WorldMatrix * glm::vec4(corners[i], 1.0f));
-               wmin = glm::min(wmin, w);
-               wmax = glm::max(wmax, w);
-            }
-            DrawAABB(wmin, wmax, 0);
-         }
+         const DynamicBVH& bounds = scene.GetBounds();
+         bounds.ForEachLeaf([&](int32_t proxy) {
+            const auto* data = static_cast<const EntityData*>(bounds.UserData(proxy));
+            if (!data->Visible) return;
+            const DynamicBVH::AABB& box = bounds.Bounds(proxy);
+            // Meshes without CPU bounds are stored as unbounded; nothing useful to draw
+            if (box.Max.x - box.Min.x > 1e9f) return;
+            DrawAABB(box.Min, box.Max, 0);
+            });
       }
    }
 
@@ -611,45 +560,66 @@ void Renderer::RenderScene(Scene& scene) {
       bool mouseDown = Input::IsMouseButtonPressed(0);
       m_UIInputConsumed = false;
 
-      // Sorted UI draw: collect panels and screen-space texts, sort by canvas order then z
+      // Sorted UI draw: collect panels and screen-space texts, sort by canvas order then z.
+      // Panels are batched by m_UIBatcher; text flushes the batch first so painter's order holds.
       enum class UIItemType { Panel, Text };
       struct UIDrawItem {
          int canvasOrder;
          int z;
          float canvasOpacity;
          UIItemType type;
+         bgfx::TextureHandle texture; // panels only
          PanelComponent* panel;
          TextRendererComponent* text;
          EntityData* data;
       };
       std::vector<UIDrawItem> items;
-      items.reserve(scene.GetEntities().size());
 
-      for (auto& e : scene.GetEntities()) {
-         auto* d = scene.GetEntityData(e.GetID());
-         if (!d || !d->Visible) continue;
-         // Find nearest ancestor screen-space canvas
-         CanvasComponent* canvas = nullptr;
-         {
-            EntityID cur = e.GetID();
-            while (cur != INVALID_ENTITY_ID) {
-               auto* d2 = scene.GetEntityData(cur);
-               if (!d2) break;
-               if (d2->Canvas && d2->Canvas->Space == CanvasComponent::RenderSpace::ScreenSpace) { canvas = d2->Canvas.get(); break; }
-               cur = d2->Parent;
+      m_UIBatcher.BeginFrame(scene);
+      auto canvasOf = [&](EntityID id) -> const CanvasComponent* {
+         const EntityID owner = m_UIBatcher.OwningCanvas(scene, id);
+         EntityData* cd = owner != INVALID_ENTITY_ID ? scene.GetEntityData(owner) : nullptr;
+         return cd ? cd->Canvas.get() : nullptr;
+      };
+      auto panelTexture = [&](PanelComponent& p) {
+         bgfx::TextureHandle th = m_UIWhiteTex;
+         if (p.Texture.IsValid()) {
+            if (auto* entry = AssetLibrary::Instance().GetAsset(p.Texture)) {
+               // Lazy-load the texture if needed so drops immediately show up
+               if (!entry->texture || !bgfx::isValid(*entry->texture)) {
+                  auto tex = AssetLibrary::Instance().LoadTexture(p.Texture);
+                  (void)tex;
+                  }
+               if (entry->streamedTexture) th = entry->streamedTexture->Use();
+               else if (entry->texture && bgfx::isValid(*entry->texture)) th = *entry->texture;
+               }
             }
-         }
-         int corder = canvas ? canvas->SortOrder : 0;
-         float copacity = canvas ? canvas->Opacity : 1.0f;
-         if (d->Panel && d->Panel->Visible) items.push_back({ corder, d->Panel->ZOrder, copacity, UIItemType::Panel, d->Panel.get(), nullptr, d });
-         if (d->Text && !d->Text->WorldSpace && d->Text->Visible) items.push_back({ corder, d->Text->ZOrder, copacity, UIItemType::Text, nullptr, d->Text.get(), d });
+         return th;
+      };
+
+      for (auto [id, d, panel] : scene.View<EntityData, PanelComponent>()) {
+         if (!d.Visible || !panel.Visible) continue;
+         const CanvasComponent* canvas = canvasOf(id);
+         items.push_back({ canvas ? canvas->SortOrder : 0, panel.ZOrder, canvas ? canvas->Opacity : 1.0f,
+                           UIItemType::Panel, panelTexture(panel), &panel, nullptr, &d });
+      }
+      for (auto [id, d, text] : scene.View<EntityData, TextRendererComponent>()) {
+         if (!d.Visible || text.WorldSpace || !text.Visible) continue;
+         const CanvasComponent* canvas = canvasOf(id);
+         items.push_back({ canvas ? canvas->SortOrder : 0, text.ZOrder, canvas ? canvas->Opacity : 1.0f,
+                           UIItemType::Text, m_UIWhiteTex, nullptr, &text, &d });
       }
 
+      // Ties: panels under text, then panels grouped by texture so they share a draw
       std::sort(items.begin(), items.end(), [](const UIDrawItem& a, const UIDrawItem& b){
          if (a.canvasOrder != b.canvasOrder) return a.canvasOrder < b.canvasOrder;
-         return a.z < b.z;
+         if (a.z != b.z) return a.z < b.z;
+         if (a.type != b.type) return a.type == UIItemType::Panel;
+         return a.texture.idx < b.texture.idx;
       });
 
+      const uint64_t uiState = BGFX_STATE_WRITE_RGB | BGFX_STATE_BLEND_ALPHA;
+      std::vector<glm::vec3> debugRectLines;
       for (const UIDrawItem& it : items) {
          if (it.type == UIItemType::Panel) {
             EntityData* d = it.data;
@@ -695,14 +665,23 @@ void Renderer::RenderScene(Scene& scene) {
             uint8_t a = (uint8_t)(clamp01(tint.a * p.Opacity * it.canvasOpacity) * 255.0f);
             abgr = (a << 24) | (b << 16) | (g << 8) | (r);
 
-            UIVertex verts[4];
-            uint16_t idx[6] = { 0,1,2, 0,2,3 };
+            auto addQuad = [&](float xa, float ya, float xb, float yb, float ua, float va, float ub, float vb) {
+               const UIVertex vv[4] = {
+                   { xa, ya, 0.0f, ua, va, abgr },
+                   { xb, ya, 0.0f, ub, va, abgr },
+                   { xb, yb, 0.0f, ub, vb, abgr },
+                   { xa, yb, 0.0f, ua, vb, abgr }
+                  };
+               m_UIBatcher.AddQuad(it.texture, vv);
+               };
+
             if (p.Mode == PanelComponent::FillMode::NineSlice && p.Texture.IsValid()) {
                float L = x0, T = y0, R = x1, B = y1;
                float w = (x1 - x0), h = (y1 - y0);
                float uL = p.UVRect.x, vT = p.UVRect.y, uR = p.UVRect.z, vB = p.UVRect.w;
                float du = (uR - uL);
                float dv = (vB - vT);
+               // Convert absolute UV slice margins into fractions of the selected rect
                float lFrac = (du != 0.0f) ? (p.SliceUV.x / du) : 0.0f;
                float rFrac = (du != 0.0f) ? (p.SliceUV.z / du) : 0.0f;
                float tFrac = (dv != 0.0f) ? (p.SliceUV.y / dv) : 0.0f;
@@ -720,90 +699,31 @@ void Renderer::RenderScene(Scene& scene) {
                float yM = T + tpx;
                float yB = B - bpx;
 
+               // Compute UV splits using absolute slice margins inside the rect
                float uL2 = uL + p.SliceUV.x;
                float uR2 = uR - p.SliceUV.z;
                float vT2 = vT + p.SliceUV.y;
                float vB2 = vB - p.SliceUV.w;
 
-               auto submitQuad = [&](float xa, float ya, float xb, float yb, float ua, float va, float ub, float vb) {
-                  UIVertex vv[4] = {
-                      { xa, ya, 0.0f, ua, va, abgr },
-                      { xb, ya, 0.0f, ub, va, abgr },
-                      { xb, yb, 0.0f, ub, vb, abgr },
-                      { xa, yb, 0.0f, ua, vb, abgr }
-                     };
-                  uint16_t ii[6] = { 0,1,2, 0,2,3 };
-                  const bgfx::Memory* vmem2 = bgfx::copy(vv, sizeof(vv));
-                  const bgfx::Memory* imem2 = bgfx::copy(ii, sizeof(ii));
-                  bgfx::VertexBufferHandle vbh2 = bgfx::createVertexBuffer(vmem2, UIVertex::layout);
-                  bgfx::IndexBufferHandle  ibh2 = bgfx::createIndexBuffer(imem2);
-                  float id2[16]; bx::mtxIdentity(id2); bgfx::setTransform(id2);
-                  bgfx::setVertexBuffer(0, vbh2);
-                  bgfx::setIndexBuffer(ibh2);
-                  bgfx::TextureHandle th2 = m_UIWhiteTex;
-                  if (p.Texture.IsValid()) {
-                     if (auto* entry = AssetLibrary::Instance().GetAsset(p.Texture)) {
-                        if (!entry->texture || !bgfx::isValid(*entry->texture)) {
-                           auto tex = AssetLibrary::Instance().LoadTexture(p.Texture);
-                           (void)tex;
-                           }
-                        if (entry->texture && bgfx::isValid(*entry->texture)) th2 = *entry->texture;
-                        }
-                     }
-                  bgfx::setTexture(0, m_UISampler, th2);
-                  bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_BLEND_ALPHA);
-                  bgfx::submit(2, m_UIProgram);
-                  bgfx::destroy(vbh2);
-                  bgfx::destroy(ibh2);
-                  };
-
-               submitQuad(xL, yT, xM, yM, uL, vT, uL2, vT2);
-               submitQuad(xM, yT, xR, yM, uL2, vT, uR2, vT2);
-               submitQuad(xR, yT, R, yM, uR2, vT, uR, vT2);
-               submitQuad(xL, yM, xM, yB, uL, vT2, uL2, vB2);
-               submitQuad(xM, yM, xR, yB, uL2, vT2, uR2, vB2);
-               submitQuad(xR, yM, R, yB, uR2, vT2, uR, vB2);
-               submitQuad(xL, yB, xM, B, uL, vB2, uL2, vB);
-               submitQuad(xM, yB, xR, B, uL2, vB2, uR2, vB);
-               submitQuad(xR, yB, R, B, uR2, vB2, uR, vB);
+               addQuad(xL, yT, xM, yM, uL, vT, uL2, vT2);
+               addQuad(xM, yT, xR, yM, uL2, vT, uR2, vT2);
+               addQuad(xR, yT, R, yM, uR2, vT, uR, vT2);
+               addQuad(xL, yM, xM, yB, uL, vT2, uL2, vB2);
+               addQuad(xM, yM, xR, yB, uL2, vT2, uR2, vB2);
+               addQuad(xR, yM, R, yB, uR2, vT2, uR, vB2);
+               addQuad(xL, yB, xM, B, uL, vB2, uL2, vB);
+               addQuad(xM, yB, xR, B, uL2, vB2, uR2, vB);
+               addQuad(xR, yB, R, B, uR2, vB2, uR, vB);
                continue;
             }
             else if (p.Mode == PanelComponent::FillMode::Tile) {
                float u0 = p.UVRect.x, v0 = p.UVRect.y;
                float u1 = p.UVRect.z * p.TileRepeat.x, v1 = p.UVRect.w * p.TileRepeat.y;
-               verts[0] = { x0, y0, 0.0f, u0, v0, abgr };
-               verts[1] = { x1, y0, 0.0f, u1, v0, abgr };
-               verts[2] = { x1, y1, 0.0f, u1, v1, abgr };
-               verts[3] = { x0, y1, 0.0f, u0, v1, abgr };
+               addQuad(x0, y0, x1, y1, u0, v0, u1, v1);
             }
             else {
-               verts[0] = { x0, y0, 0.0f, p.UVRect.x, p.UVRect.y, abgr };
-               verts[1] = { x1, y0, 0.0f, p.UVRect.z, p.UVRect.y, abgr };
-               verts[2] = { x1, y1, 0.0f, p.UVRect.z, p.UVRect.w, abgr };
-               verts[3] = { x0, y1, 0.0f, p.UVRect.x, p.UVRect.w, abgr };
+               addQuad(x0, y0, x1, y1, p.UVRect.x, p.UVRect.y, p.UVRect.z, p.UVRect.w);
             }
-            const bgfx::Memory* vmem = bgfx::copy(verts, sizeof(verts));
-            const bgfx::Memory* imem = bgfx::copy(idx, sizeof(idx));
-            bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(vmem, UIVertex::layout);
-            bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(imem);
-            float id[16]; bx::mtxIdentity(id); bgfx::setTransform(id);
-            bgfx::setVertexBuffer(0, vbh);
-            bgfx::setIndexBuffer(ibh);
-            bgfx::TextureHandle th = m_UIWhiteTex;
-            if (p.Texture.IsValid()) {
-               if (auto* entry = AssetLibrary::Instance().GetAsset(p.Texture)) {
-                  if (!entry->texture || !bgfx::isValid(*entry->texture)) {
-                     auto tex = AssetLibrary::Instance().LoadTexture(p.Texture);
-                     (void)tex;
-                  }
-                  if (entry->texture && bgfx::isValid(*entry->texture)) th = *entry->texture;
-               }
-            }
-            bgfx::setTexture(0, m_UISampler, th);
-            bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_BLEND_ALPHA);
-            bgfx::submit(2, m_UIProgram);
-            bgfx::destroy(vbh);
-            bgfx::destroy(ibh);
 
             // Button hit-testing overlay
             if (d->Button && d->Button->Interactable) {
@@ -816,23 +736,13 @@ void Renderer::RenderScene(Scene& scene) {
                if (d->Button->Toggle && d->Button->Clicked) d->Button->Toggled = !d->Button->Toggled;
             }
 
-            // Optional: debug rect outline
+            // Optional: debug rect outline, drawn over the UI after the last flush
             if (m_ShowUIRects) {
-               ImU32 dbg = 0x66ff8800u;
-               // draw via bgfx line list: use a tiny transient buffer for the rectangle
-               struct L { float x,y,z; };
-               L v[8] = { {x0,y0,0},{x1,y0,0}, {x1,y0,0},{x1,y1,0}, {x1,y1,0},{x0,y1,0}, {x0,y1,0},{x0,y0,0} };
-               const bgfx::Memory* mem = bgfx::copy(v, sizeof(v));
-               bgfx::VertexLayout layout; layout.begin().add(bgfx::Attrib::Position,3,bgfx::AttribType::Float).end();
-               bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(mem, layout);
-               float idm[16]; bx::mtxIdentity(idm); bgfx::setTransform(idm);
-               bgfx::setVertexBuffer(0, vbh);
-               auto debugMat = MaterialManager::Instance().CreateDefaultDebugMaterial(); debugMat->BindUniforms();
-               bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_PT_LINES | BGFX_STATE_BLEND_ALPHA);
-               bgfx::submit(2, debugMat->GetProgram());
-               bgfx::destroy(vbh);
+               const glm::vec3 rect[8] = { {x0,y0,0},{x1,y0,0}, {x1,y0,0},{x1,y1,0}, {x1,y1,0},{x0,y1,0}, {x0,y1,0},{x0,y0,0} };
+               debugRectLines.insert(debugRectLines.end(), rect, rect + 8);
             }
          } else if (it.type == UIItemType::Text) {
+            m_UIBatcher.Flush(2, m_UIProgram, m_UISampler, uiState);
             // Compute anchored screen position
             float sx = it.data->Transform.Position.x;
             float sy = it.data->Transform.Position.y;
@@ -861,201 +771,93 @@ void Renderer::RenderScene(Scene& scene) {
             }
          }
       }
+      m_UIBatcher.Flush(2, m_UIProgram, m_UISampler, uiState);
+
+      if (!debugRectLines.empty()) {
+         bgfx::VertexLayout layout; layout.begin().add(bgfx::Attrib::Position,3,bgfx::AttribType::Float).end();
+         const uint32_t n = (uint32_t)debugRectLines.size();
+         if (bgfx::getAvailTransientVertexBuffer(n, layout) == n) {
+            bgfx::TransientVertexBuffer tvb;
+            bgfx::allocTransientVertexBuffer(&tvb, n, layout);
+            std::memcpy(tvb.data, debugRectLines.data(), n * sizeof(glm::vec3));
+            float idm[16]; bx::mtxIdentity(idm); bgfx::setTransform(idm);
+            bgfx::setVertexBuffer(0, &tvb);
+            auto debugMat = MaterialManager::Instance().CreateDefaultDebugMaterial(); debugMat->BindUniforms();
+            bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_PT_LINES | BGFX_STATE_BLEND_ALPHA);
+            bgfx::submit(2, debugMat->GetProgram());
+         }
+      }
 
-      // We fully handled UI drawing above; skip legacy per-entity path
-      return;
-
-      // Simple per-entity pass: draw panels; drive buttons; text already handled by TextRenderer screen path
-      for (auto& e : scene.GetEntities()) {
-         auto* d = scene.GetEntityData(e.GetID());
-         if (!d || !d->Visible) continue;
-
-         // If entity has a Canvas and is screen space, it just acts as a scope for children; we currently use global backbuffer size
-         // Draw Panel
-         if (d->Panel && d->Panel->Visible) {
-            PanelComponent& p = *d->Panel;
-            // Compute anchor-based top-left position
-            float ax = 0.0f, ay = 0.0f;
-            if (p.AnchorEnabled) {
-               switch (p.Anchor) {
-                     case UIAnchorPreset::TopLeft:    ax = 0;              ay = 0;               break;
-                     case UIAnchorPreset::Top:        ax = m_Width * 0.5f;   ay = 0;               break;
-                     case UIAnchorPreset::TopRight:   ax = (float)m_Width;  ay = 0;               break;
-                     case UIAnchorPreset::Left:       ax = 0;              ay = m_Height * 0.5f;  break;
-                     case UIAnchorPreset::Center:     ax = m_Width * 0.5f;   ay = m_Height * 0.5f;  break;
-                     case UIAnchorPreset::Right:      ax = (float)m_Width; ay = m_Height * 0.5f;  break;
-                     case UIAnchorPreset::BottomLeft: ax = 0;              ay = (float)m_Height; break;
-                     case UIAnchorPreset::Bottom:     ax = m_Width * 0.5f;   ay = (float)m_Height; break;
-                     case UIAnchorPreset::BottomRight:ax = (float)m_Width; ay = (float)m_Height; break;
-                  }
-               ax += p.AnchorOffset.x;
-               ay += p.AnchorOffset.y;
-               }
-            else {
-               ax = p.Position.x;
-               ay = p.Position.y;
-               }
-            float x0 = ax;
-            float y0 = ay;
-            float x1 = x0 + p.Size.x * p.Scale.x;
-            float y1 = y0 + p.Size.y * p.Scale.y;
-
-            // Base tint: panel tint
-            uint32_t abgr = 0xffffffffu;
-            // Pack tint including opacity
-            auto clamp01 = [](float v) { return std::max(0.0f, std::min(1.0f, v)); };
-            glm::vec4 tint = p.TintColor;
-            // Apply button state tint if present
-            if (d->Button) {
-               if (d->Button->Pressed)      tint *= d->Button->PressedTint;
-               else if (d->Button->Hovered) tint *= d->Button->HoverTint;
-               else                          tint *= d->Button->NormalTint;
-               }
-            // Multiply by ancestor canvas opacity if under a screen-space canvas
-            float canvasOpacity = 1.0f;
-            {
-               EntityID cur = e.GetID();
-               while (cur != INVALID_ENTITY_ID) {
-                  auto* d2 = scene.GetEntityData(cur);
-                  if (!d2) break;
-                  if (d2->Canvas && d2->Canvas->Space == CanvasComponent::RenderSpace::ScreenSpace) { canvasOpacity = d2->Canvas->Opacity; break; }
-                  cur = d2->Parent;
-               }
-            }
-            uint8_t r = (uint8_t)(clamp01(tint.r) * 255.0f);
-            uint8_t g = (uint8_t)(clamp01(tint.g) * 255.0f);
-            uint8_t b = (uint8_t)(clamp01(tint.b) * 255.0f);
-            uint8_t a = (uint8_t)(clamp01(tint.a * p.Opacity * canvasOpacity) * 255.0f);
-            abgr = (a << 24) | (b << 16) | (g << 8) | (r);
-
-            UIVertex verts[4];
-            uint16_t idx[6] = { 0,1,2, 0,2,3 };
-            if (p.Mode == PanelComponent::FillMode::NineSlice && p.Texture.IsValid()) {
-               float L = x0, T = y0, R = x1, B = y1;
-               float w = (x1 - x0), h = (y1 - y0);
-               float uL = p.UVRect.x, vT = p.UVRect.y, uR = p.UVRect.z, vB = p.UVRect.w;
-               float du = (uR - uL);
-               float dv = (vB - vT);
-               // Convert absolute UV slice margins into fractions of the selected rect
-               float lFrac = (du != 0.0f) ? (p.SliceUV.x / du) : 0.0f;
-               float rFrac = (du != 0.0f) ? (p.SliceUV.z / du) : 0.0f;
-               float tFrac = (dv != 0.0f) ? (p.SliceUV.y / dv) : 0.0f;
-               float bFrac = (dv != 0.0f) ? (p.SliceUV.w / dv) : 0.0f;
-
-               float lpx = w * lFrac;
-               float rpx = w * rFrac;
-               float tpx = h * tFrac;
-               float bpx = h * bFrac;
+      Profiler::Get().RecordCounter("UI/Draws", (int64_t)m_UIBatcher.DrawCalls());
+      Profiler::Get().RecordCounter("UI/Quads", (int64_t)m_UIBatcher.Quads());
+      }
 
-               float xL = L;
-               float xM = L + lpx;
-               float xR = R - rpx;
-               float yT = T;
-               float yM = T + tpx;
-               float yB = B - bpx;
+   }
 
-               // Compute UV splits using absolute slice margins inside the rect
-               float uL2 = uL + p.SliceUV.x;
-               float uR2 = uR - p.SliceUV.z;
-               float vT2 = vT + p.SliceUV.y;
-               float vB2 = vB - p.SliceUV.w;
+void Renderer::CullScene(Scene& scene, const glm::mat4& viewProj)
+   {
+   const DynamicBVH& bounds = scene.GetBounds();
+   m_VisibleProxies.clear();
+   {
+      ScopedTimer t("Render/Cull");
+      bounds.CullFrustum(Frustum::FromMatrix(viewProj), m_VisibleProxies, &Jobs());
+   }
+   Profiler::Get().RecordCounter("Render/Visible", (int64_t)m_VisibleProxies.size());
+   Profiler::Get().RecordCounter("Render/Culled", (int64_t)(bounds.LeafCount() - m_VisibleProxies.size()));
+   }
 
-               auto submitQuad = [&](float xa, float ya, float xb, float yb, float ua, float va, float ub, float vb) {
-                  UIVertex vv[4] = {
-                      { xa, ya, 0.0f, ua, va, abgr },
-                      { xb, ya, 0.0f, ub, va, abgr },
-                      { xb, yb, 0.0f, ub, vb, abgr },
-                      { xa, yb, 0.0f, ua, vb, abgr }
-                     };
-                  uint16_t ii[6] = { 0,1,2, 0,2,3 };
-                  const bgfx::Memory* vmem2 = bgfx::copy(vv, sizeof(vv));
-                  const bgfx::Memory* imem2 = bgfx::copy(ii, sizeof(ii));
-                  bgfx::VertexBufferHandle vbh2 = bgfx::createVertexBuffer(vmem2, UIVertex::layout);
-                  bgfx::IndexBufferHandle  ibh2 = bgfx::createIndexBuffer(imem2);
-                  float id2[16]; bx::mtxIdentity(id2); bgfx::setTransform(id2);
-                  bgfx::setVertexBuffer(0, vbh2);
-                  bgfx::setIndexBuffer(ibh2);
-                  bgfx::TextureHandle th2 = m_UIWhiteTex;
-                  if (p.Texture.IsValid()) {
-                     if (auto* entry = AssetLibrary::Instance().GetAsset(p.Texture)) {
-                        // Lazy-load like the non-9slice path to ensure the texture is available
-                        if (!entry->texture || !bgfx::isValid(*entry->texture)) {
-                           auto tex = AssetLibrary::Instance().LoadTexture(p.Texture);
-                           (void)tex;
-                           }
-                        if (entry->texture && bgfx::isValid(*entry->texture)) th2 = *entry->texture;
-                        }
-                     }
-                  bgfx::setTexture(0, m_UISampler, th2);
-                  bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_BLEND_ALPHA);
-                  bgfx::submit(2, m_UIProgram);
-                  bgfx::destroy(vbh2);
-                  bgfx::destroy(ibh2);
-                  };
+void Renderer::BuildMeshQueue(Scene& scene, bgfx::ViewId viewId, const glm::mat4& view)
+   {
+   const DynamicBVH& bounds = scene.GetBounds();
+   m_RenderQueue.Clear();
+   // View-space depth is -z; only the ordering matters for the sort key
+   const glm::vec4 depthRow(-view[0][2], -view[1][2], -view[2][2], -view[3][2]);
+
+   for (int32_t proxy : m_VisibleProxies) {
+      auto* data = static_cast<EntityData*>(bounds.UserData(proxy));
+      if (!data->Visible || !data->Mesh || !data->Mesh->mesh) continue;
+      MeshComponent& meshComp = *data->Mesh;
+      const Mesh* mesh = meshComp.mesh.get();
+
+      const bool meshValid = mesh->Dynamic ? bgfx::isValid(mesh->dvbh) : bgfx::isValid(mesh->vbh);
+      if (!meshValid || !bgfx::isValid(mesh->ibh)) {
+         std::cerr << "Invalid mesh for entity " << bounds.UserId(proxy) << "\n";
+         continue;
+         }
 
-               submitQuad(xL, yT, xM, yM, uL, vT, uL2, vT2);
-               submitQuad(xM, yT, xR, yM, uL2, vT, uR2, vT2);
-               submitQuad(xR, yT, R, yM, uR2, vT, uR, vT2);
-               submitQuad(xL, yM, xM, yB, uL, vT2, uL2, vB2);
-               submitQuad(xM, yM, xR, yB, uL2, vT2, uR2, vB2);
-               submitQuad(xR, yM, R, yB, uR2, vT2, uR, vB2);
-               submitQuad(xL, yB, xM, B, uL, vB2, uL2, vB);
-               submitQuad(xM, yB, xR, B, uL2, vB2, uR2, vB);
-               submitQuad(xR, yB, R, B, uR2, vB2, uR, vB);
-               continue;
-               }
-            else if (p.Mode == PanelComponent::FillMode::Tile) {
-               float u0 = p.UVRect.x, v0 = p.UVRect.y;
-               float u1 = p.UVRect.z * p.TileRepeat.x, v1 = p.UVRect.w * p.TileRepeat.y;
-               verts[0] = { x0, y0, 0.0f, u0, v0, abgr };
-               verts[1] = { x1, y0, 0.0f, u1, v0, abgr };
-               verts[2] = { x1, y1, 0.0f, u1, v1, abgr };
-               verts[3] = { x0, y1, 0.0f, u0, v1, abgr };
-               }
-            else {
-               verts[0] = { x0, y0, 0.0f, p.UVRect.x, p.UVRect.y, abgr };
-               verts[1] = { x1, y0, 0.0f, p.UVRect.z, p.UVRect.y, abgr };
-               verts[2] = { x1, y1, 0.0f, p.UVRect.z, p.UVRect.w, abgr };
-               verts[3] = { x0, y1, 0.0f, p.UVRect.x, p.UVRect.w, abgr };
-               }
-            const bgfx::Memory* vmem = bgfx::copy(verts, sizeof(verts));
-            const bgfx::Memory* imem = bgfx::copy(idx, sizeof(idx));
-            bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(vmem, UIVertex::layout);
-            bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(imem);
-            float id[16]; bx::mtxIdentity(id); bgfx::setTransform(id);
-            bgfx::setVertexBuffer(0, vbh);
-            bgfx::setIndexBuffer(ibh);
-            bgfx::TextureHandle th = m_UIWhiteTex;
-            if (p.Texture.IsValid()) {
-               if (auto* entry = AssetLibrary::Instance().GetAsset(p.Texture)) {
-                  // Lazy-load the texture if needed so drops immediately show up
-                  if (!entry->texture || !bgfx::isValid(*entry->texture)) {
-                     auto tex = AssetLibrary::Instance().LoadTexture(p.Texture);
-                     (void)tex;
-                     }
-                  if (entry->texture && bgfx::isValid(*entry->texture)) th = *entry->texture;
-                  }
-               }
-            bgfx::setTexture(0, m_UISampler, th);
-            bgfx::setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_BLEND_ALPHA);
-            bgfx::submit(2, m_UIProgram);
-            bgfx::destroy(vbh);
-            bgfx::destroy(ibh);
+      DrawItem item;
+      item.MeshPtr = mesh;
+      item.Transform = glm::value_ptr(data->Transform.WorldMatrix);
+      item.NormalMatrix = glm::value_ptr(data->Transform.GetNormalMatrix());
+      const float depth = glm::dot(depthRow, data->Transform.WorldMatrix[3]);
 
-            // Button hit-testing overlay
-            if (d->Button && d->Button->Interactable) {
-               bool inside = (mx >= x0 && mx <= x1 && my >= y0 && my <= y1);
-               d->Button->Hovered = inside;
-               if (inside) m_UIInputConsumed = true;
-               bool wasPressed = d->Button->Pressed;
-               d->Button->Pressed = inside && mouseDown;
-               d->Button->Clicked = (!mouseDown && wasPressed && inside);
-               if (d->Button->Toggle && d->Button->Clicked) d->Button->Toggled = !d->Button->Toggled;
-               }
+      // If the mesh has submeshes and the component has multiple materials, draw per submesh/material slot
+      if (!mesh->Submeshes.empty() && !meshComp.materials.empty()) {
+         for (const auto& sm : mesh->Submeshes) {
+            const size_t slot = sm.materialSlot < meshComp.materials.size() ? sm.materialSlot : 0;
+            const Material* mat = meshComp.materials[slot] ? meshComp.materials[slot].get() : meshComp.material.get();
+            if (!mat || !bgfx::isValid(mat->GetProgram())) continue;
+            // Per-slot property block if present; else fall back to the component block
+            const MaterialPropertyBlock* pb = nullptr;
+            if (sm.materialSlot < meshComp.SlotPropertyBlocks.size() && !meshComp.SlotPropertyBlocks[sm.materialSlot].Empty())
+               pb = &meshComp.SlotPropertyBlocks[sm.materialSlot];
+            if (!pb && !meshComp.PropertyBlock.Empty()) pb = &meshComp.PropertyBlock;
+
+            item.Mat = mat;
+            item.Block = pb;
+            item.IndexStart = sm.indexStart;
+            item.IndexCount = sm.indexCount;
+            m_RenderQueue.Add(viewId, item, depth);
             }
          }
+      else {
+         const Material* mat = meshComp.material.get();
+         if (!mat || !bgfx::isValid(mat->GetProgram())) continue;
+         item.Mat = mat;
+         item.Block = meshComp.PropertyBlock.Empty() ? nullptr : &meshComp.PropertyBlock;
+         m_RenderQueue.Add(viewId, item, depth);
+         }
       }
-
    }
 
 void Renderer::RenderScene(Scene& scene, uint16_t viewId)
@@ -1074,16 +876,16 @@ void Renderer::RenderScene(Scene& scene, uint16_t viewId)
 
    std::vector<LightData> lights;
    lights.reserve(4);
-   for (auto& entity : scene.GetEntities()) {
-      auto* data = scene.GetEntityData(entity.GetID());
-      if (!data || !data->Light || !data->Visible) continue;
+   for (auto [lightId, entity, light] : scene.View<EntityData, LightComponent>()) {
+      auto* data = &entity;
+      if (!data->Visible) continue;
 
       // Collect light data from the entity
-      LightData ld; ld.type = data->Light->Type; 
-      ld.color = data->Light->Color * data->Light->Intensity;
+      LightData ld; ld.type = light.Type; 
+      ld.color = light.Color * light.Intensity;
       ld.position = data->Transform.Position;
 
-      if (data->Light->Type == LightType::Directional) 
+      if (light.Type == LightType::Directional) 
          {
          float yaw = glm::radians(data->Transform.Rotation.y);
          float pitch = glm::radians(data->Transform.Rotation.x);
@@ -1104,55 +906,11 @@ void Renderer::RenderScene(Scene& scene, uint16_t viewId)
    }
    UploadLightsToShader(lights);
 
-   std::vector<EntityID> entityIds; entityIds.reserve(scene.GetEntities().size());
-   for (const auto& eSnap : scene.GetEntities()) entityIds.push_back(eSnap.GetID());
-   for (EntityID eid : entityIds) {
-
-      auto* data = scene.GetEntityData(eid);
-      if (!data || !data->Visible || !data->Mesh || !data->Mesh->mesh) continue;
-      std::shared_ptr<Mesh> meshPtr = data->Mesh->mesh; if (!meshPtr) continue;
-
-      bool meshValid = meshPtr->Dynamic ? bgfx::isValid(meshPtr->dvbh) : bgfx::isValid(meshPtr->vbh);
-      if (!meshValid || !bgfx::isValid(meshPtr->ibh)) continue;
-
-      float transform[16]; memcpy(transform, glm::value_ptr(data->Transform.WorldMatrix), sizeof(float) * 16);
-
-      if (!meshPtr->Submeshes.empty() && !data->Mesh->materials.empty()) {
-         for (const auto& sm : meshPtr->Submeshes) {
-            const size_t slot = sm.materialSlot < data->Mesh->materials.size() ? sm.materialSlot : 0;
-            const Material* mat = data->Mesh->materials[slot] ? data->Mesh->materials[slot].get() : data->Mesh->material.get();
-            if (!mat) mat = data->Mesh->material.get();
-            bgfx::setTransform(transform);
-            if (meshPtr->Dynamic) {
-               if (bgfx::isValid(meshPtr->dvbh)) {
-                  bgfx::setVertexBuffer(0, meshPtr->dvbh, 0, meshPtr->numVertices);
-               } else { continue; }
-            } else {
-               bgfx::setVertexBuffer(0, meshPtr->vbh);
-            }
-            bgfx::setIndexBuffer(meshPtr->ibh, sm.indexStart, sm.indexCount);
-            // Normal matrix for this draw
-            glm::mat4 modelMtx = glm::make_mat4(transform);
-            glm::mat3 n3 = glm::transpose(glm::inverse(glm::mat3(modelMtx)));
-            glm::mat4 normalMat4(1.0f); normalMat4[0] = glm::vec4(n3[0], 0.0f); normalMat4[1] = glm::vec4(n3[1], 0.0f); normalMat4[2] = glm::vec4(n3[2], 0.0f);
-            bgfx::setUniform(u_normalMat, glm::value_ptr(normalMat4));
-            mat->BindUniforms();
-            // Apply per-slot property block if present; else fall back to component block
-            const MaterialPropertyBlock* pb = nullptr;
-            if (data->Mesh && sm.materialSlot < data->Mesh->SlotPropertyBlocks.size()) {
-               if (!data->Mesh->SlotPropertyBlocks[sm.materialSlot].Empty()) pb = &data->Mesh->SlotPropertyBlocks[sm.materialSlot];
-            }
-            if (!pb && data->Mesh && !data->Mesh->PropertyBlock.Empty()) pb = &data->Mesh->PropertyBlock;
-            if (pb) mat->ApplyPropertyBlock(*pb);
-            bgfx::setState(mat->GetStateFlags());
-            if (bgfx::isValid(mat->GetProgram())) {
-               bgfx::submit(viewId, mat->GetProgram());
-            }
-         }
-      } else {
-         DrawMesh(*meshPtr.get(), transform, *data->Mesh->material, viewId, &data->Mesh->PropertyBlock);
-      }
-      }
+   CullScene(scene, proj * view);
+   bgfx::setViewMode(viewId, bgfx::ViewMode::Sequential);
+   BuildMeshQueue(scene, viewId, view);
+   m_RenderQueue.Sort();
+   m_RenderQueue.Submit(u_normalMat);
    }
 
 
@@ -9,6 +9,8 @@
 #include "Material.h"
 #include "DebugMaterial.h"
 #include "TextRenderer.h"
+#include "RenderQueue.h"
+#include "UIBatcher.h"
 
 // TextRenderer is used via unique_ptr; include full type to avoid incomplete-type destructor issues
 
@@ -181,6 +183,7 @@ private:
     bool m_ShowUIOverlay = true;
     bool m_UIInputConsumed = false;
     bool m_ShowUIRects = false;
+    UIBatcher m_UIBatcher;
     // Viewport-reported mouse position in scene framebuffer space (pixels)
     float m_UIMouseX = 0.0f;
     float m_UIMouseY = 0.0f;
@@ -207,6 +210,15 @@ public:
  private:
     // Helper: draw world-space axis-aligned bounding box on a given view (default debug view 0)
     void DrawAABB(const glm::vec3& worldMin, const glm::vec3& worldMax, uint16_t viewId = 0);
+    // Frustum-cull the scene's mesh bounds; fills m_VisibleProxies and reports counts to the Profiler
+    void CullScene(Scene& scene, const glm::mat4& viewProj);
+
+    // Gather draw items for every visible mesh into m_RenderQueue
+    void BuildMeshQueue(Scene& scene, bgfx::ViewId viewId, const glm::mat4& view);
+
+    // Scratch: bounds-tree proxies that survived the last CullScene
+    std::vector<int32_t> m_VisibleProxies;
+    RenderQueue m_RenderQueue;
 
     // Debug draw flags (editor)
     bool m_ShowGrid = true;
@@ -9,11 +9,17 @@ namespace fs = std::filesystem;
 using json = nlohmann::json;
 
 static bgfx::ShaderHandle CreateShaderFromFile(const fs::path& path) {
+    const uint8_t* bytes = nullptr;
+    size_t size = 0;
     std::vector<uint8_t> data;
-    if (!FileSystem::Instance().ReadFile(path.string(), data)) return BGFX_INVALID_HANDLE;
-    const bgfx::Memory* mem = bgfx::alloc(uint32_t(data.size()+1));
-    if (!data.empty()) memcpy(mem->data, data.data(), data.size());
-    mem->data[data.size()]='\0';
+    if (!FileSystem::Instance().ReadFileView(path.string(), bytes, size)) {
+        if (!FileSystem::Instance().ReadFile(path.string(), data)) return BGFX_INVALID_HANDLE;
+        bytes = data.data();
+        size = data.size();
+    }
+    const bgfx::Memory* mem = bgfx::alloc(uint32_t(size+1));
+    if (size != 0) memcpy(mem->data, bytes, size);
+    mem->data[size]='\0';
     return bgfx::createShader(mem);
 }
 
@@ -93,14 +93,21 @@ bool ShaderManager::CompileShader(const std::string& name, ShaderType type)
 
 static bgfx::ShaderHandle CreateShaderFromFile(const fs::path& path)
    {
+   // Uncompressed pak entries are copied straight out of the mapped archive
+   const uint8_t* bytes = nullptr;
+   size_t size = 0;
    std::vector<uint8_t> data;
-   if (!FileSystem::Instance().ReadFile(path.string(), data)) {
-       std::cerr << "[ShaderManager] Failed to read shader: \"" << path.string() << "\"" << std::endl;
-       return BGFX_INVALID_HANDLE;
+   if (!FileSystem::Instance().ReadFileView(path.string(), bytes, size)) {
+       if (!FileSystem::Instance().ReadFile(path.string(), data)) {
+           std::cerr << "[ShaderManager] Failed to read shader: \"" << path.string() << "\"" << std::endl;
+           return BGFX_INVALID_HANDLE;
+       }
+       bytes = data.data();
+       size = data.size();
    }
-   const bgfx::Memory* mem = bgfx::alloc(uint32_t(data.size() + 1));
-   if (!data.empty()) memcpy(mem->data, data.data(), data.size());
-   mem->data[data.size()] = '\0';
+   const bgfx::Memory* mem = bgfx::alloc(uint32_t(size + 1));
+   if (size != 0) memcpy(mem->data, bytes, size);
+   mem->data[size] = '\0';
 
    return bgfx::createShader(mem);
    }
@@ -118,8 +125,7 @@ bgfx::ShaderHandle ShaderManager::LoadShader(const std::string& name, ShaderType
            fs::path("shaders/") / (name + ".bin")
        };
        for (auto& c : candidates) {
-           std::vector<uint8_t> data;
-           if (FileSystem::Instance().ReadFile(c.string(), data) && !data.empty()) {
+           if (FileSystem::Instance().Exists(c.string())) {
                std::cout << "[ShaderManager] Using shader bin: " << c.string() << std::endl;
                shaderOut = c; break;
            }
@@ -140,6 +146,18 @@ bgfx::ShaderHandle ShaderManager::LoadShader(const std::string& name, ShaderType
    return CreateShaderFromFile(shaderOut);
    }
 
+// Mesh programs that have an instanced variant (see RenderQueue)
+static const struct InstancedVariant
+   {
+   const char* Vs;
+   const char* Fs;
+   const char* InstancedVs;
+   const char* InstancedFs;
+   } kInstancedVariants[] = {
+      { "vs_pbr", "fs_pbr", "vs_pbr_instanced", "fs_pbr_instanced" },
+      { "vs_psx", "fs_psx", "vs_psx_instanced", "fs_psx_instanced" },
+   };
+
 bgfx::ProgramHandle ShaderManager::LoadProgram(const std::string& vsName, const std::string& fsName)
    {
    bgfx::ShaderHandle vsh = LoadShader(vsName, ShaderType::Vertex);
@@ -161,9 +179,30 @@ bgfx::ProgramHandle ShaderManager::LoadProgram(const std::string& vsName, const
    std::lock_guard<std::mutex> lock(m_ProgramMutex);
    m_Programs[vsName + "+" + fsName] = program;
    }
+
+   if (bgfx::isValid(program) && (bgfx::getCaps()->supported & BGFX_CAPS_INSTANCING)) {
+      for (const InstancedVariant& v : kInstancedVariants) {
+         if (vsName != v.Vs || fsName != v.Fs) continue;
+         {
+         std::lock_guard<std::mutex> lock(m_ProgramMutex);
+         if (m_InstancedPrograms.count(program.idx)) break;
+         }
+         bgfx::ProgramHandle instanced = LoadProgram(v.InstancedVs, v.InstancedFs);
+         std::lock_guard<std::mutex> lock(m_ProgramMutex);
+         m_InstancedPrograms[program.idx] = instanced;
+         break;
+         }
+      }
    return program;
    }
 
+bgfx::ProgramHandle ShaderManager::GetInstancedVariant(bgfx::ProgramHandle program)
+   {
+   std::lock_guard<std::mutex> lock(m_ProgramMutex);
+   auto it = m_InstancedPrograms.find(program.idx);
+   return it != m_InstancedPrograms.end() ? it->second : bgfx::ProgramHandle{ bgfx::kInvalidHandle };
+   }
+
 bgfx::ProgramHandle ShaderManager::LoadProgramFromBundle(const std::string& baseName)
 {
     return ShaderBundle::Instance().Load(baseName);
@@ -176,6 +215,7 @@ void ShaderManager::InvalidateProgram(const std::string& key)
         std::lock_guard<std::mutex> lock(m_ProgramMutex);
         auto it = m_Programs.find(key);
         if (it != m_Programs.end()) {
+            m_InstancedPrograms.erase(it->second.idx); // the variant stays registered under its own key
             if (bgfx::isValid(it->second)) bgfx::destroy(it->second);
             m_Programs.erase(it);
         }
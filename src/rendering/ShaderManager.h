@@ -25,6 +25,11 @@ class ShaderManager
       bgfx::ProgramHandle LoadProgramFromBundle(const std::string& baseName);
       void InvalidateProgram(const std::string& key);
 
+      // Instanced counterpart of a mesh program (model matrix and tint read from
+      // i_data0..i_data4), or an invalid handle if the program has none or the
+      // backend cannot instance. Loaded together with the base program.
+      bgfx::ProgramHandle GetInstancedVariant(bgfx::ProgramHandle program);
+
       // Compile all shaders found in the executable's shaders directory if out-of-date or missing bin.
       void CompileAllShaders();
 
@@ -40,6 +45,7 @@ class ShaderManager
 
       std::mutex m_ProgramMutex;
       std::unordered_map<std::string, bgfx::ProgramHandle> m_Programs;
+      std::unordered_map<uint16_t, bgfx::ProgramHandle> m_InstancedPrograms; // base program idx -> variant
 
       std::unordered_map<std::string, bgfx::ShaderHandle> m_ShaderCache; // name -> handle
       std::mutex m_ShaderMutex;
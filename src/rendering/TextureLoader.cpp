@@ -2,6 +2,10 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include "io/FileSystem.h"
+#include "pipeline/TextureCooker.h"
+#include <bimg/bimg.h>
+#include <bx/allocator.h>
+#include <bx/error.h>
 #include <stdexcept>
 #include <algorithm>
 #include <string>
@@ -9,6 +13,8 @@
 #include <cmath>
 #include <cstdint>
 #include <filesystem>
+#include <mutex>
+#include <unordered_map>
 
 #define NANOSVG_IMPLEMENTATION
 #include "nanosvg.h"
@@ -19,65 +25,171 @@
 #include "editor/Project.h"
 
 
+namespace {
+    // GPUs without the cooked block format: decode every mip to RGBA8 on the CPU. Exports
+    // ship only the cooked file, so there is no source image to fall back to.
+    bgfx::TextureHandle CreateDecodedRgba8(const bimg::ImageContainer& info, const uint8_t* data, size_t size)
+    {
+        const bgfx::Caps* caps = bgfx::getCaps();
+        if (!caps || !(caps->formats[bgfx::TextureFormat::RGBA8] & BGFX_CAPS_FORMAT_TEXTURE_2D)) return BGFX_INVALID_HANDLE;
+
+        bx::DefaultAllocator allocator;
+        std::vector<uint8_t> rgba, decoded;
+        for (uint8_t lod = 0; lod < info.m_numMips; ++lod) {
+            bimg::ImageMip mip;
+            if (!bimg::imageGetRawData(info, 0, lod, data, static_cast<uint32_t>(size), mip)) return BGFX_INVALID_HANDLE;
+            // Block formats report whole blocks; the texture wants the real mip size
+            const uint32_t w = std::max(1u, info.m_width >> lod), h = std::max(1u, info.m_height >> lod);
+            decoded.resize(size_t(mip.m_width) * mip.m_height * 4);
+            bimg::imageDecodeToRgba8(&allocator, decoded.data(), mip.m_data, mip.m_width, mip.m_height, mip.m_width * 4, info.m_format);
+            for (uint32_t y = 0; y < h; ++y) {
+                const uint8_t* row = &decoded[size_t(y) * mip.m_width * 4];
+                rgba.insert(rgba.end(), row, row + size_t(w) * 4);
+            }
+        }
+        return bgfx::createTexture2D(static_cast<uint16_t>(info.m_width), static_cast<uint16_t>(info.m_height), info.m_numMips > 1, 1,
+                                     bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_NONE, bgfx::copy(rgba.data(), static_cast<uint32_t>(rgba.size())));
+    }
+
+    // Cooked textures go to the GPU as stored: one createTexture call, all mips
+    bool TryLoadCooked(const std::string& path, bgfx::TextureHandle& out)
+    {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        std::vector<uint8_t> fileData;
+        if (!TextureLoader::ReadCooked(path, fileData, data, size)) return false;
+
+        bimg::ImageContainer info;
+        bx::Error err;
+        if (!bimg::imageParse(info, data, static_cast<uint32_t>(size), &err)) return false;
+        const bgfx::Caps* caps = bgfx::getCaps();
+        if (!caps || !(caps->formats[info.m_format] & BGFX_CAPS_FORMAT_TEXTURE_2D))
+            out = CreateDecodedRgba8(info, data, size);
+        else
+            out = bgfx::createTexture(bgfx::copy(data, static_cast<uint32_t>(size)), BGFX_TEXTURE_NONE);
+        return bgfx::isValid(out);
+    }
+
+    // File name -> first texture path seen with that name. Built from the asset
+    // folders on the first miss, then kept current by the importer.
+    struct TextureNameIndex
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::string> byName;
+        bool scanned = false;
+    };
+
+    TextureNameIndex& NameIndex()
+    {
+        static TextureNameIndex index;
+        return index;
+    }
+
+    bool IsTextureFile(const std::filesystem::path& p)
+    {
+        std::string ext = p.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga";
+    }
+
+    void ScanTextureRoots(TextureNameIndex& index)
+    {
+        std::error_code ec;
+        std::vector<std::filesystem::path> roots;
+        // Preferred: Project asset root, then relative 'assets/textures' from run dir
+        std::filesystem::path assetRoot = Project::GetAssetDirectory();
+        if (!assetRoot.empty() && std::filesystem::exists(assetRoot / "textures", ec)) roots.push_back(assetRoot / "textures");
+        auto rRel = std::filesystem::path("assets") / "textures";
+        if (std::filesystem::exists(rRel, ec)) roots.push_back(rRel);
+
+        for (const auto& root : roots) {
+            for (std::filesystem::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+                if (!it->is_regular_file(ec) || !IsTextureFile(it->path())) continue;
+                index.byName.emplace(it->path().filename().string(), it->path().string());
+            }
+        }
+    }
+
+    std::string ResolveByFileName(const std::string& path)
+    {
+        const std::string fname = std::filesystem::path(path).filename().string();
+        if (fname.empty()) return {};
+        TextureNameIndex& index = NameIndex();
+        std::lock_guard<std::mutex> lock(index.mutex);
+        if (!index.scanned) {
+            index.scanned = true;
+            try { ScanTextureRoots(index); } catch (...) { /* Swallow filesystem errors, continue to procedural fallbacks */ }
+        }
+        auto it = index.byName.find(fname);
+        return it != index.byName.end() ? it->second : std::string();
+    }
+}
+
+std::string TextureLoader::FindByFileName(const std::string& path)
+{
+    return ResolveByFileName(path);
+}
+
+bool TextureLoader::ReadCooked(const std::string& path, std::vector<uint8_t>& storage, const uint8_t*& data, size_t& size)
+{
+    const std::string cooked = TextureCooker::CookedPath(path);
+    if (FileSystem::Instance().ReadFileView(cooked, data, size)) return true;
+    // Loose files: a sidecar older than its source is stale until the next import
+    std::error_code srcEc, cookedEc;
+    const auto srcTime = std::filesystem::last_write_time(path, srcEc);
+    const auto cookedTime = std::filesystem::last_write_time(cooked, cookedEc);
+    if (!srcEc && !cookedEc && cookedTime < srcTime) return false;
+    if (!FileSystem::Instance().ReadFile(cooked, storage)) return false;
+    data = storage.data();
+    size = storage.size();
+    return true;
+}
+
+void TextureLoader::RegisterTexturePath(const std::string& path)
+{
+    if (!IsTextureFile(path)) return;
+    TextureNameIndex& index = NameIndex();
+    std::lock_guard<std::mutex> lock(index.mutex);
+    index.byName.emplace(std::filesystem::path(path).filename().string(), path);
+}
+
 bgfx::TextureHandle TextureLoader::Load2D(const std::string& path, bool generateMips)
 {
+    bgfx::TextureHandle cooked = BGFX_INVALID_HANDLE;
+    if (TryLoadCooked(path, cooked)) return cooked;
+
     int width, height, channels;
     // Try virtual filesystem first
     std::vector<uint8_t> fileData;
     stbi_uc* data = nullptr;
-    if (FileSystem::Instance().ReadFile(path, fileData)) {
+    const uint8_t* packed = nullptr;
+    size_t packedSize = 0;
+    if (FileSystem::Instance().ReadFileView(path, packed, packedSize)) {
+        // Decode straight from the mapped pak
+        data = stbi_load_from_memory(packed, static_cast<int>(packedSize), &width, &height, &channels, 4);
+    } else if (FileSystem::Instance().ReadFile(path, fileData)) {
         data = stbi_load_from_memory(fileData.data(), static_cast<int>(fileData.size()), &width, &height, &channels, 4);
     } else {
         data = stbi_load(path.c_str(), &width, &height, &channels, 4);
     }
     if (!data)
     {
-        // Fallback: if original path failed, try to locate a texture with the same
-        // filename inside assets/textures/** (use first match)
-        try {
-            std::filesystem::path p(path);
-            const std::string fname = p.filename().string();
-            if (!fname.empty()) {
-                std::error_code ec;
-                std::vector<std::filesystem::path> roots;
-                // Preferred: Project asset root
-                std::filesystem::path assetRoot = Project::GetAssetDirectory();
-                if (!assetRoot.empty() && std::filesystem::exists(assetRoot, ec)) {
-                    auto r = assetRoot / "textures";
-                    if (std::filesystem::exists(r, ec)) roots.push_back(r);
-                }
-                // Secondary: relative 'assets/textures' from run dir
-                auto rRel = std::filesystem::path("assets") / "textures";
-                if (std::filesystem::exists(rRel, ec)) roots.push_back(rRel);
-
-                for (const auto& root : roots) {
-                    for (std::filesystem::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
-                        if (ec) break;
-                        if (!it->is_regular_file(ec)) continue;
-                        if (it->path().filename().string() == fname) {
-                            // Try loading from this candidate
-                            stbi_uc* alt = nullptr;
-                            std::vector<uint8_t> altData;
-                            const std::string candidate = it->path().string();
-                            if (FileSystem::Instance().ReadFile(candidate, altData)) {
-                                alt = stbi_load_from_memory(altData.data(), static_cast<int>(altData.size()), &width, &height, &channels, 4);
-                            } else {
-                                alt = stbi_load(candidate.c_str(), &width, &height, &channels, 4);
-                            }
-                            if (alt) {
-                                std::cout << "[TextureLoader] Fallback resolved by filename: '" << fname << "' -> " << candidate << "\n";
-                                data = alt; // use fallback image
-                            } else {
-                                std::cout << "[TextureLoader] Candidate existed but failed to load: " << candidate << "\n";
-                            }
-                            break;
-                        }
-                    }
-                    if (data) break;
-                }
+        // Fallback: a texture with the same file name elsewhere under the asset folders
+        const std::string candidate = ResolveByFileName(path);
+        if (!candidate.empty() && candidate != path) {
+            bgfx::TextureHandle alt = BGFX_INVALID_HANDLE;
+            if (TryLoadCooked(candidate, alt)) {
+                std::cout << "[TextureLoader] Fallback resolved by filename: " << path << " -> " << candidate << "\n";
+                return alt;
+            }
+            std::vector<uint8_t> altData;
+            if (FileSystem::Instance().ReadFile(candidate, altData)) {
+                data = stbi_load_from_memory(altData.data(), static_cast<int>(altData.size()), &width, &height, &channels, 4);
+            } else {
+                data = stbi_load(candidate.c_str(), &width, &height, &channels, 4);
             }
-        } catch (...) {
-            // Swallow filesystem errors, continue to procedural fallbacks
+            if (data) std::cout << "[TextureLoader] Fallback resolved by filename: " << path << " -> " << candidate << "\n";
+            else std::cout << "[TextureLoader] Candidate existed but failed to load: " << candidate << "\n";
         }
 
         // If still not found, consider procedural debug defaults
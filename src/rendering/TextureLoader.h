@@ -6,14 +6,24 @@
 
 #include <bgfx/bgfx.h>
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <imgui.h>
 
 class TextureLoader
    {
    public:
-      // When loading raw 2-D images we create only the base level by default.
-      // Pass generateMips=true if you upload your own full mip-chain.
+      // Loads the cooked "<path>.ktx" (block-compressed, full mip chain; see TextureCooker)
+      // with a single createTexture call when it exists; GPUs without its format get its
+      // mips decoded to RGBA8. Otherwise the source image is decoded and only the base level is created;
+      // pass generateMips=true if you upload your own full mip-chain.
       static bgfx::TextureHandle Load2D(const std::string& path, bool generateMips = false);
+      // Adds 'path' to the file name index used when a requested texture path misses
+      static void RegisterTexturePath(const std::string& path);
+      // First indexed texture with the same file name as 'path'; empty if none
+      static std::string FindByFileName(const std::string& path);
+      // Bytes of the up-to-date cooked file of 'path' (a pak view, or 'storage' for loose files)
+      static bool ReadCooked(const std::string& path, std::vector<uint8_t>& storage, const uint8_t*& data, size_t& size);
       static bgfx::TextureHandle LoadIconTexture(const std::string& path);
       static ImTextureID ToImGuiTextureID(bgfx::TextureHandle handle);
    };
@@ -0,0 +1,386 @@
+#include "TextureStreamer.h"
+#include "TextureLoader.h"
+#include "io/FileSystem.h"
+#include "pipeline/TextureCooker.h"
+#include "editor/Project.h"
+#include "jobs/Jobs.h"
+#include "jobs/JobSystem.h"
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <stb_image.h>
+#include <bimg/bimg.h>
+#include <bx/error.h>
+
+uint32_t TextureStreamer::s_Frame = 1;
+
+bgfx::TextureHandle StreamedTexture::Use() {
+   LastUsedFrame = TextureStreamer::CurrentFrame();
+   return Handle;
+   }
+
+namespace {
+
+uint8_t InitialSkipFor(uint32_t width, uint32_t height, uint8_t numMips) {
+   uint8_t skip = 0;
+   while (skip + 1 < numMips && (std::max(width, height) >> skip) > TextureStreamer::kInitialMaxDim) ++skip;
+   return skip;
+   }
+
+bool SourceExists(const std::string& path) {
+   const FileSystem& fs = FileSystem::Instance();
+   if (fs.Exists(path) || fs.Exists(TextureCooker::CookedPath(path))) return true;
+   // FileSystem::ReadFile also resolves project-relative paths
+   std::error_code ec;
+   const std::filesystem::path proj = Project::GetProjectDirectory();
+   return !proj.empty() && std::filesystem::exists(proj / path, ec);
+   }
+
+void ReleaseBytes(void*, void* user) {
+   delete static_cast<std::vector<uint8_t>*>(user);
+   }
+
+} // namespace
+
+TextureStreamer& TextureStreamer::Instance() {
+   static TextureStreamer instance;
+   return instance;
+   }
+
+std::shared_ptr<StreamedTexture> TextureStreamer::Find(const std::string& path) {
+   auto found = m_ByPath.find(path);
+   if (found == m_ByPath.end()) return nullptr;
+   auto it = m_Entries.find(found->second);
+   if (it != m_Entries.end()) return it->second.Texture;
+   m_ByPath.erase(found);
+   return nullptr;
+   }
+
+std::shared_ptr<StreamedTexture> TextureStreamer::Request(const std::string& path) {
+   {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (auto texture = Find(path)) return texture;
+      }
+
+   // File probes and the name index run unlocked, so other requests and Update() do not wait on disk
+   std::string source = path;
+   if (!SourceExists(path)) {
+      source = TextureLoader::FindByFileName(path);
+      if (source.empty()) return nullptr;
+      }
+
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   // Another thread may have added the same path in the meantime
+   if (auto texture = Find(path)) return texture;
+   const uint32_t id = m_NextId++;
+   Entry& e = m_Entries[id];
+   e.Id = id;
+   e.Path = source;
+   e.Key = FileSystem::PakKey(source);
+   e.PlaceholderKind = PlaceholderFor(source);
+   e.Texture = std::make_shared<StreamedTexture>();
+   e.Texture->Handle = m_Placeholders[e.PlaceholderKind];
+   e.Texture->LastUsedFrame = s_Frame;
+   m_ByPath[path] = id;
+   StartLoad(e, kNotResident);
+   return e.Texture;
+   }
+
+void TextureStreamer::Reload(const std::string& path) {
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   const std::string key = FileSystem::PakKey(path);
+   for (auto& [id, e] : m_Entries) {
+      if (e.Key != key) continue;
+      e.Failed = false;
+      if (e.InFlight) { e.ReloadQueued = true; continue; }
+      e.Known = false;
+      StartLoad(e, kNotResident);
+      }
+   }
+
+uint64_t TextureStreamer::GetPendingBytes() const {
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   uint64_t bytes = 0;
+   for (const auto& kv : m_Entries) bytes += kv.second.PendingBytes;
+   return bytes;
+   }
+
+TextureStreamer::Placeholder TextureStreamer::PlaceholderFor(const std::string& path) {
+   const TextureCooker::Usage usage = TextureCooker::ResolveSettings(path, {}).usage;
+   return usage == TextureCooker::Usage::Normal ? PlaceholderNormal
+      : usage == TextureCooker::Usage::ORM ? PlaceholderORM : PlaceholderWhite;
+   }
+
+bool TextureStreamer::CreatePlaceholders() {
+   bool created = false;
+   for (uint8_t kind = 0; kind < PlaceholderCount; ++kind) {
+      if (bgfx::isValid(m_Placeholders[kind])) continue;
+      uint8_t texel[4] = { 255, 255, 255, 255 };
+      if (kind == PlaceholderNormal) { texel[0] = 128; texel[1] = 128; }
+      else if (kind == PlaceholderORM) { texel[0] = 0; }
+      m_Placeholders[kind] = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_NONE,
+         bgfx::copy(texel, sizeof(texel)));
+      created = true;
+      }
+   return created;
+   }
+
+void TextureStreamer::Init() {
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   CreatePlaceholders();
+   }
+
+uint64_t TextureStreamer::TierBytes(const Entry& e, uint8_t skip) const {
+   bgfx::TextureInfo info;
+   bgfx::calcTextureSize(info,
+      uint16_t(std::max(1, e.Width >> skip)), uint16_t(std::max(1, e.Height >> skip)), 1,
+      false, e.NumMips - skip > 1, 1, e.Format);
+   return info.storageSize;
+   }
+
+TextureStreamer::Loaded TextureStreamer::LoadTier(uint32_t id, const std::string& path, uint8_t skip) {
+   Loaded out;
+   out.Id = id;
+
+   std::vector<uint8_t> storage;
+   const uint8_t* data = nullptr;
+   size_t size = 0;
+   if (TextureLoader::ReadCooked(path, storage, data, size)) {
+      bimg::ImageContainer image;
+      bx::Error err;
+      const bgfx::Caps* caps = bgfx::getCaps();
+      // GPUs without the block format get the source instead
+      if (bimg::imageParse(image, data, uint32_t(size), &err)
+          && image.m_depth == 1 && image.m_numLayers == 1 && !image.m_cubeMap
+          && caps && (caps->formats[image.m_format] & BGFX_CAPS_FORMAT_TEXTURE_2D)) {
+         out.Cooked = true;
+         out.Width = uint16_t(image.m_width);
+         out.Height = uint16_t(image.m_height);
+         out.NumMips = image.m_numMips;
+         out.Format = bgfx::TextureFormat::Enum(image.m_format);
+         out.Skip = skip == kNotResident ? InitialSkipFor(out.Width, out.Height, out.NumMips)
+                                         : std::min<uint8_t>(skip, uint8_t(out.NumMips - 1));
+         out.Pixels = std::make_unique<std::vector<uint8_t>>();
+         out.Ok = true;
+         for (uint8_t lod = out.Skip; lod < out.NumMips && out.Ok; ++lod) {
+            bimg::ImageMip mip;
+            out.Ok = bimg::imageGetRawData(image, 0, lod, data, uint32_t(size), mip);
+            if (out.Ok) out.Pixels->insert(out.Pixels->end(), mip.m_data, mip.m_data + mip.m_size);
+            }
+         if (out.Ok) return out;
+         }
+      }
+
+   // No usable cooked file: decode the source, base level only
+   out = Loaded{};
+   out.Id = id;
+   int width = 0, height = 0, channels = 0;
+   stbi_uc* pixels = nullptr;
+   std::vector<uint8_t> file;
+   const uint8_t* packed = nullptr;
+   size_t packedSize = 0;
+   if (FileSystem::Instance().ReadFileView(path, packed, packedSize))
+      pixels = stbi_load_from_memory(packed, int(packedSize), &width, &height, &channels, 4);
+   else if (FileSystem::Instance().ReadFile(path, file))
+      pixels = stbi_load_from_memory(file.data(), int(file.size()), &width, &height, &channels, 4);
+   if (!pixels) return out;
+   if (width <= UINT16_MAX && height <= UINT16_MAX) {
+      out.Width = uint16_t(width);
+      out.Height = uint16_t(height);
+      out.Pixels = std::make_unique<std::vector<uint8_t>>(pixels, pixels + size_t(width) * height * 4);
+      out.Ok = true;
+      }
+   stbi_image_free(pixels);
+   return out;
+   }
+
+void TextureStreamer::StartLoad(Entry& e, uint8_t skip) {
+   if (e.Known && skip != kNotResident) {
+      const uint64_t bytes = TierBytes(e, skip);
+      m_CommittedBytes = m_CommittedBytes - e.CommittedBytes + bytes;
+      e.CommittedBytes = bytes;
+      e.PendingBytes = bytes;
+      e.TargetSkip = skip;
+      }
+   e.InFlight = true;
+   ++m_LoadsInFlight;
+
+   std::shared_ptr<Inbox> inbox = m_Inbox;
+   const bool queued = Jobs().EnqueueBackground([inbox, id = e.Id, path = e.Path, skip] {
+      Loaded loaded = LoadTier(id, path, skip);
+      std::lock_guard<std::mutex> lock(inbox->Mutex);
+      inbox->Items.push_back(std::move(loaded));
+      });
+   if (!queued) {
+      // Shutting down
+      e.InFlight = false;
+      e.PendingBytes = 0;
+      --m_LoadsInFlight;
+      }
+   }
+
+void TextureStreamer::DestroyTexture(Entry& e) {
+   if (e.ResidentSkip != kNotResident && bgfx::isValid(e.Texture->Handle)) bgfx::destroy(e.Texture->Handle);
+   e.Texture->Handle = m_Placeholders[e.PlaceholderKind];
+   m_ResidentBytes -= e.ResidentBytes;
+   e.ResidentBytes = 0;
+   e.ResidentSkip = kNotResident;
+   }
+
+void TextureStreamer::Upload(Loaded& loaded) {
+   auto it = m_Entries.find(loaded.Id);
+   if (it == m_Entries.end()) return; // released while loading
+   Entry& e = it->second;
+   e.InFlight = false;
+   e.PendingBytes = 0;
+
+   if (e.ReloadQueued) {
+      // The file changed while this load ran; its result is already stale
+      e.ReloadQueued = false;
+      e.Known = false;
+      StartLoad(e, kNotResident);
+      return;
+      }
+
+   bool ok = loaded.Ok;
+   if (ok) {
+      e.Known = true;
+      e.Streamable = loaded.Cooked && loaded.NumMips > 1;
+      e.Width = loaded.Width;
+      e.Height = loaded.Height;
+      e.NumMips = loaded.Cooked ? loaded.NumMips : 1;
+      e.Format = loaded.Cooked ? loaded.Format : bgfx::TextureFormat::RGBA8;
+      e.InitialSkip = e.Streamable ? InitialSkipFor(e.Width, e.Height, e.NumMips) : 0;
+      ok = TierBytes(e, loaded.Skip) == loaded.Pixels->size();
+      }
+
+   bgfx::TextureHandle handle = BGFX_INVALID_HANDLE;
+   if (ok) {
+      const uint8_t skip = loaded.Skip;
+      std::vector<uint8_t>* bytes = loaded.Pixels.release();
+      const bgfx::Memory* mem = bgfx::makeRef(bytes->data(), uint32_t(bytes->size()), ReleaseBytes, bytes);
+      handle = bgfx::createTexture2D(uint16_t(std::max(1, e.Width >> skip)), uint16_t(std::max(1, e.Height >> skip)),
+         e.NumMips - skip > 1, 1, e.Format, BGFX_TEXTURE_NONE, mem);
+      ok = bgfx::isValid(handle);
+      }
+
+   if (!ok) {
+      if (!e.Failed) std::cerr << "[TextureStreamer] Failed to load texture: " << e.Path << std::endl;
+      e.Failed = true;
+      m_CommittedBytes = m_CommittedBytes - e.CommittedBytes + e.ResidentBytes;
+      e.CommittedBytes = e.ResidentBytes;
+      e.TargetSkip = e.ResidentSkip;
+      return;
+      }
+
+   DestroyTexture(e);
+   const uint64_t bytes = TierBytes(e, loaded.Skip);
+   e.Texture->Handle = handle;
+   e.ResidentSkip = e.TargetSkip = loaded.Skip;
+   e.ResidentBytes = bytes;
+   m_ResidentBytes += bytes;
+   m_CommittedBytes = m_CommittedBytes - e.CommittedBytes + bytes;
+   e.CommittedBytes = bytes;
+   }
+
+void TextureStreamer::ReleaseUnreferenced() {
+   for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+      Entry& e = it->second;
+      if (e.Texture.use_count() > 1 || e.InFlight) { ++it; continue; }
+      DestroyTexture(e);
+      m_CommittedBytes -= e.CommittedBytes;
+      for (auto p = m_ByPath.begin(); p != m_ByPath.end();) {
+         if (p->second == e.Id) p = m_ByPath.erase(p);
+         else ++p;
+         }
+      it = m_Entries.erase(it);
+      }
+   }
+
+void TextureStreamer::ScheduleUpgrades() {
+   std::vector<Entry*> wanted, idle;
+   for (auto& kv : m_Entries) {
+      Entry& e = kv.second;
+      if (!e.Known || !e.Streamable || e.Failed || e.InFlight) continue;
+      const uint32_t unused = s_Frame - e.Texture->LastUsedFrame;
+      if (unused <= 1 && e.TargetSkip > 0) wanted.push_back(&e);
+      else if (unused > kEvictAfterFrames && e.TargetSkip < e.InitialSkip) idle.push_back(&e);
+      }
+   // Least recently used go first
+   std::sort(idle.begin(), idle.end(), [](const Entry* a, const Entry* b) {
+      return a->Texture->LastUsedFrame < b->Texture->LastUsedFrame;
+      });
+
+   size_t nextIdle = 0;
+   auto evictOne = [&]() {
+      if (nextIdle == idle.size() || m_LoadsInFlight >= kMaxLoadsInFlight) return false;
+      Entry* victim = idle[nextIdle++];
+      StartLoad(*victim, victim->InitialSkip);
+      return true;
+      };
+
+   for (Entry* e : wanted) {
+      if (m_LoadsInFlight >= kMaxLoadsInFlight) break;
+      const uint64_t current = e->CommittedBytes;
+      while (m_CommittedBytes - current + TierBytes(*e, 0) > m_BudgetBytes && evictOne()) {}
+      // Upgrade as far as the budget allows
+      uint8_t skip = 0;
+      while (skip < e->TargetSkip && m_CommittedBytes - current + TierBytes(*e, skip) > m_BudgetBytes) ++skip;
+      if (skip < e->TargetSkip) StartLoad(*e, skip);
+      }
+   // A lowered budget is met by eviction alone
+   while (m_CommittedBytes > m_BudgetBytes && evictOne()) {}
+   }
+
+void TextureStreamer::Update() {
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   ++s_Frame;
+   // Textures requested before Init hold an invalid handle until the placeholders exist
+   if (CreatePlaceholders()) {
+      for (auto& kv : m_Entries)
+         if (kv.second.ResidentSkip == kNotResident) kv.second.Texture->Handle = m_Placeholders[kv.second.PlaceholderKind];
+      }
+   {
+      std::lock_guard<std::mutex> lock(m_Inbox->Mutex);
+      for (Loaded& l : m_Inbox->Items) {
+         --m_LoadsInFlight;
+         m_Ready.push_back(std::move(l));
+         }
+      m_Inbox->Items.clear();
+   }
+
+   uint64_t uploaded = 0;
+   while (!m_Ready.empty()) {
+      const uint64_t size = m_Ready.front().Pixels ? m_Ready.front().Pixels->size() : 0;
+      if (uploaded > 0 && uploaded + size > kMaxUploadBytesPerFrame) break;
+      Upload(m_Ready.front());
+      m_Ready.pop_front();
+      uploaded += size;
+      }
+
+   ReleaseUnreferenced();
+   ScheduleUpgrades();
+
+   Profiler::Get().RecordCounter("Textures/Resident KiB", int64_t(m_ResidentBytes >> 10));
+   uint64_t pending = 0;
+   for (const auto& kv : m_Entries) pending += kv.second.PendingBytes;
+   Profiler::Get().RecordCounter("Textures/Pending KiB", int64_t(pending >> 10));
+   Profiler::Get().RecordCounter("Textures/Upload KiB", int64_t(uploaded >> 10));
+   }
+
+void TextureStreamer::Shutdown() {
+   std::lock_guard<std::mutex> lock(m_Mutex);
+   for (auto& kv : m_Entries) DestroyTexture(kv.second);
+   for (bgfx::TextureHandle& h : m_Placeholders) {
+      if (bgfx::isValid(h)) bgfx::destroy(h);
+      h = BGFX_INVALID_HANDLE;
+      }
+   m_Entries.clear();
+   m_ByPath.clear();
+   m_Ready.clear();
+   // Loads still running deliver into the old inbox and are dropped with it
+   m_Inbox = std::make_shared<Inbox>();
+   m_LoadsInFlight = 0;
+   m_ResidentBytes = m_CommittedBytes = 0;
+   }
@@ -0,0 +1,148 @@
+#pragma once
+#include <bgfx/bgfx.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Stable view of a streamed texture. Materials keep the shared pointer; Handle is
+// replaced in place whenever the streamer uploads more mips or drops them, so it
+// must be re-read at bind time rather than copied.
+struct StreamedTexture {
+   bgfx::TextureHandle Handle = BGFX_INVALID_HANDLE;
+   uint32_t LastUsedFrame = 0;
+
+   // Current handle; marks the texture as used this frame for eviction
+   bgfx::TextureHandle Use();
+   };
+
+// -----------------------------------------------------------------------------
+// Texture streaming. Request() never blocks: it hands out a StreamedTexture that
+// shows a 1x1 placeholder until a job has read the file and Update() uploaded it.
+//
+// Cooked textures (TextureCooker's .ktx with a full mip chain) arrive in tiers: the
+// mips up to kInitialMaxDim first, then the levels above them once the texture is
+// drawn. Each tier is a new GPU texture holding only its mip range, so residency is
+// what is actually allocated. Upgrades stay within the budget by first dropping the
+// high mips of textures that have not been drawn for kEvictAfterFrames, least
+// recently used first; what still does not fit is upgraded as far as it can.
+// Textures without a cooked file are decoded and uploaded whole, once.
+//
+// Init, Update, Reload and Shutdown run on the main thread. Request is thread-safe,
+// since jobs call it (scene deserialization populates meshes in parallel); every member
+// takes m_Mutex, and Request probes the disk without holding it. Request makes no bgfx
+// calls: it hands out one of the shared placeholders Init created (or, before Init, an
+// invalid handle that the next Update replaces), and only Update creates or destroys
+// GPU textures. Uploads are spread over frames by kMaxUploadBytesPerFrame; a texture
+// nothing references any more is released on the next Update().
+// -----------------------------------------------------------------------------
+class TextureStreamer {
+public:
+   static TextureStreamer& Instance();
+
+   // Creates the shared placeholders; call after bgfx::init
+   void Init();
+   // Null when neither the texture nor its cooked file can be found
+   std::shared_ptr<StreamedTexture> Request(const std::string& path);
+   // Re-reads a texture after it was re-imported; no-op if it is not streamed
+   void Reload(const std::string& path);
+   // Once per frame: uploads finished loads, schedules upgrades and evictions
+   void Update();
+   // Destroys every texture; call before bgfx::shutdown
+   void Shutdown();
+
+   void SetBudgetBytes(uint64_t bytes) { m_BudgetBytes = bytes; }
+   uint64_t GetBudgetBytes() const { return m_BudgetBytes; }
+   uint64_t GetResidentBytes() const { return m_ResidentBytes; }
+   // Bytes being read or waiting for upload
+   uint64_t GetPendingBytes() const;
+
+   static uint32_t CurrentFrame() { return s_Frame; }
+
+   static constexpr uint64_t kDefaultBudgetBytes = 512ull << 20;
+   static constexpr uint32_t kInitialMaxDim = 64;
+   static constexpr uint32_t kEvictAfterFrames = 300;
+   static constexpr uint64_t kMaxUploadBytesPerFrame = 16ull << 20;
+   static constexpr uint32_t kMaxLoadsInFlight = 8;
+
+private:
+   TextureStreamer() = default;
+
+   static constexpr uint8_t kNotResident = 0xFF;
+
+   // Neutral values per usage, so an unloaded normal or ORM map does not skew shading
+   enum Placeholder : uint8_t { PlaceholderWhite, PlaceholderNormal, PlaceholderORM, PlaceholderCount };
+
+   struct Entry {
+      uint32_t Id = 0;
+      std::string Path;            // resolved source path
+      std::string Key;             // FileSystem::PakKey(Path), matched by Reload()
+      std::shared_ptr<StreamedTexture> Texture;
+      Placeholder PlaceholderKind = PlaceholderWhite;
+      // Known once the first load has read the file header
+      bool Known = false;
+      bool Streamable = false;     // cooked, with mips to stream
+      bool Failed = false;
+      bool InFlight = false;
+      bool ReloadQueued = false;
+      uint16_t Width = 0, Height = 0;
+      uint8_t NumMips = 1;
+      bgfx::TextureFormat::Enum Format = bgfx::TextureFormat::RGBA8;
+      uint8_t InitialSkip = 0;
+      uint8_t ResidentSkip = kNotResident; // top mips left out of the GPU texture
+      uint8_t TargetSkip = kNotResident;   // what the texture is resident at or loading to
+      uint64_t ResidentBytes = 0;
+      uint64_t CommittedBytes = 0; // size at TargetSkip
+      uint64_t PendingBytes = 0;
+      };
+
+   // Produced by a load job, consumed by Update()
+   struct Loaded {
+      uint32_t Id = 0;
+      bool Ok = false;
+      bool Cooked = false;
+      uint16_t Width = 0, Height = 0;
+      uint8_t NumMips = 1;
+      bgfx::TextureFormat::Enum Format = bgfx::TextureFormat::RGBA8;
+      uint8_t Skip = 0;
+      std::unique_ptr<std::vector<uint8_t>> Pixels; // mips Skip..NumMips-1, packed
+      };
+
+   struct Inbox {
+      std::mutex Mutex;
+      std::vector<Loaded> Items;
+      };
+
+   // Worker side: the mips from 'skip' down of the cooked file, else the decoded source
+   static Loaded LoadTier(uint32_t id, const std::string& path, uint8_t skip);
+
+   // Texture already streamed for 'path' (m_Mutex held)
+   std::shared_ptr<StreamedTexture> Find(const std::string& path);
+   static Placeholder PlaceholderFor(const std::string& path);
+   // Creates any missing placeholder (m_Mutex held); true when one was created
+   bool CreatePlaceholders();
+   uint64_t TierBytes(const Entry& e, uint8_t skip) const;
+   void StartLoad(Entry& e, uint8_t skip);
+   void Upload(Loaded& loaded);
+   void ReleaseUnreferenced();
+   void ScheduleUpgrades();
+   void DestroyTexture(Entry& e);
+
+   mutable std::mutex m_Mutex;
+   std::unordered_map<std::string, uint32_t> m_ByPath;
+   std::unordered_map<uint32_t, Entry> m_Entries;
+   std::shared_ptr<Inbox> m_Inbox = std::make_shared<Inbox>();
+   std::deque<Loaded> m_Ready;
+   std::array<bgfx::TextureHandle, PlaceholderCount> m_Placeholders = { { BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE, BGFX_INVALID_HANDLE } };
+   uint32_t m_NextId = 1;
+   uint32_t m_LoadsInFlight = 0;
+   uint64_t m_BudgetBytes = kDefaultBudgetBytes;
+   uint64_t m_ResidentBytes = 0;
+   uint64_t m_CommittedBytes = 0; // every texture at its TargetSkip; what the budget limits
+
+   static uint32_t s_Frame;
+   };
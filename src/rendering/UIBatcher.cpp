@@ -0,0 +1,105 @@
+#include "UIBatcher.h"
+#include "ecs/Scene.h"
+#include <algorithm>
+
+namespace {
+
+constexpr EntityID kUnresolved = INVALID_ENTITY_ID - 1;
+
+// 16-bit indices: a transient buffer holds at most 65536 / 4 quads
+constexpr uint32_t kMaxQuadsPerBuffer = 65536 / 4;
+
+} // namespace
+
+void UIBatcher::BeginFrame(Scene& scene) {
+   m_DrawCalls = 0;
+   m_QuadsDrawn = 0;
+   m_Vertices.clear();
+   m_Runs.clear();
+
+   m_CanvasScratch.clear();
+   for (auto [id, canvas] : scene.View<CanvasComponent>())
+      if (canvas.Space == CanvasComponent::RenderSpace::ScreenSpace) m_CanvasScratch.push_back(id);
+   std::sort(m_CanvasScratch.begin(), m_CanvasScratch.end());
+
+   if (m_CanvasScratch != m_Canvases || scene.GetHierarchyVersion() != m_HierarchyVersion) {
+      m_Canvases.swap(m_CanvasScratch);
+      m_HierarchyVersion = scene.GetHierarchyVersion();
+      m_CanvasOf.assign(m_CanvasOf.size(), kUnresolved);
+      }
+   }
+
+EntityID UIBatcher::OwningCanvas(Scene& scene, EntityID id) {
+   if (id < m_CanvasOf.size() && m_CanvasOf[id] != kUnresolved) return m_CanvasOf[id];
+
+   // Walk up to a canvas or an ancestor resolved earlier, then cache the whole path
+   m_Path.clear();
+   EntityID owner = INVALID_ENTITY_ID;
+   for (EntityID cur = id; cur != INVALID_ENTITY_ID;) {
+      if (cur < m_CanvasOf.size() && m_CanvasOf[cur] != kUnresolved) { owner = m_CanvasOf[cur]; break; }
+      EntityData* d = scene.GetEntityData(cur);
+      if (!d) break;
+      m_Path.push_back(cur);
+      if (d->Canvas && d->Canvas->Space == CanvasComponent::RenderSpace::ScreenSpace) { owner = cur; break; }
+      if (m_Path.size() > scene.GetEntities().size()) break; // cycle guard
+      cur = d->Parent;
+      }
+   for (EntityID e : m_Path) {
+      if (e >= m_CanvasOf.size()) m_CanvasOf.resize(size_t(e) + 1, kUnresolved);
+      m_CanvasOf[e] = owner;
+      }
+   return owner;
+   }
+
+void UIBatcher::AddQuad(bgfx::TextureHandle texture, const UIVertex (&quad)[4]) {
+   m_Vertices.insert(m_Vertices.end(), quad, quad + 4);
+   if (!m_Runs.empty() && m_Runs.back().Texture.idx == texture.idx) ++m_Runs.back().Count;
+   else m_Runs.push_back({ texture, 1 });
+   }
+
+void UIBatcher::Flush(bgfx::ViewId view, bgfx::ProgramHandle program, bgfx::UniformHandle sampler, uint64_t state) {
+   const uint32_t total = uint32_t(m_Vertices.size() / 4);
+   size_t run = 0;
+   uint32_t runDone = 0;   // quads of m_Runs[run] already drawn
+   uint32_t quad = 0;
+
+   while (quad < total) {
+      // One transient vertex/index pair per chunk; normally the whole frame fits in one
+      uint32_t chunk = std::min(total - quad, kMaxQuadsPerBuffer);
+      chunk = std::min(chunk, bgfx::getAvailTransientVertexBuffer(chunk * 4, UIVertex::layout) / 4);
+      chunk = std::min(chunk, bgfx::getAvailTransientIndexBuffer(chunk * 6) / 6);
+      if (chunk == 0) break; // out of transient memory this frame; drop the rest
+
+      bgfx::TransientVertexBuffer tvb;
+      bgfx::TransientIndexBuffer tib;
+      bgfx::allocTransientVertexBuffer(&tvb, chunk * 4, UIVertex::layout);
+      bgfx::allocTransientIndexBuffer(&tib, chunk * 6);
+      std::copy_n(m_Vertices.data() + size_t(quad) * 4, size_t(chunk) * 4, reinterpret_cast<UIVertex*>(tvb.data));
+      uint16_t* idx = reinterpret_cast<uint16_t*>(tib.data);
+      for (uint32_t q = 0; q < chunk; ++q, idx += 6) {
+         const uint16_t b = uint16_t(q * 4);
+         idx[0] = b; idx[1] = uint16_t(b + 1); idx[2] = uint16_t(b + 2);
+         idx[3] = b; idx[4] = uint16_t(b + 2); idx[5] = uint16_t(b + 3);
+         }
+
+      // One draw per texture run inside the chunk
+      uint32_t first = 0;
+      while (first < chunk) {
+         const uint32_t count = std::min(m_Runs[run].Count - runDone, chunk - first);
+         bgfx::setVertexBuffer(0, &tvb);
+         bgfx::setIndexBuffer(&tib, first * 6, count * 6);
+         bgfx::setTexture(0, sampler, m_Runs[run].Texture);
+         bgfx::setState(state);
+         bgfx::submit(view, program);
+         ++m_DrawCalls;
+         first += count;
+         runDone += count;
+         if (runDone == m_Runs[run].Count) { ++run; runDone = 0; }
+         }
+      quad += chunk;
+      m_QuadsDrawn += chunk;
+      }
+
+   m_Vertices.clear();
+   m_Runs.clear();
+   }
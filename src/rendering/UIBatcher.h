@@ -0,0 +1,53 @@
+#pragma once
+#include <bgfx/bgfx.h>
+#include <cstdint>
+#include <vector>
+#include "VertexTypes.h"
+#include "ecs/Entity.h"
+
+class Scene;
+
+// -----------------------------------------------------------------------------
+// Screen-space UI batcher.
+//
+// Panels append quads in draw order. Flush() copies every pending quad into one
+// transient vertex/index buffer and issues one draw per run of consecutive quads
+// that share a texture, so a HUD costs a handful of draws and no buffer
+// creation. Flush before drawing anything else on the same view (text) to keep
+// painter's order.
+//
+// Also caches the owning screen-space canvas of each entity. BeginFrame() drops
+// the cache when the scene's hierarchy or its set of screen-space canvases
+// changed since the previous frame.
+// -----------------------------------------------------------------------------
+class UIBatcher {
+public:
+   void BeginFrame(Scene& scene);
+
+   // Nearest ancestor (or the entity itself) with a screen-space CanvasComponent,
+   // INVALID_ENTITY_ID if there is none.
+   EntityID OwningCanvas(Scene& scene, EntityID id);
+
+   void AddQuad(bgfx::TextureHandle texture, const UIVertex (&quad)[4]);
+   // Draws and clears the pending quads.
+   void Flush(bgfx::ViewId view, bgfx::ProgramHandle program, bgfx::UniformHandle sampler, uint64_t state);
+
+   // Since BeginFrame
+   size_t DrawCalls() const { return m_DrawCalls; }
+   size_t Quads() const { return m_QuadsDrawn; }
+
+private:
+   struct Run { bgfx::TextureHandle Texture; uint32_t Count; };
+
+   std::vector<UIVertex> m_Vertices;        // 4 per pending quad
+   std::vector<Run> m_Runs;                 // consecutive pending quads sharing a texture
+
+   std::vector<EntityID> m_CanvasOf;        // per EntityID, kUnresolved until looked up
+   std::vector<EntityID> m_Canvases;        // screen-space canvases seen by the last BeginFrame
+   std::vector<EntityID> m_CanvasScratch;
+   std::vector<EntityID> m_Path;
+   uint32_t m_HierarchyVersion = 0;
+
+   size_t m_DrawCalls = 0;
+   size_t m_QuadsDrawn = 0;
+   };
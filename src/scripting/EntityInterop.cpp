@@ -102,7 +102,10 @@ extern "C"
     {
         auto* data = Scene::Get().GetEntityData(entityID);
         if(!data){ *outX = *outY = *outZ = 0.0f; return; }
-        auto rot = data->Transform.Rotation;
+        // Quaternion-driven transforms (physics, animation) only convert on request
+        auto rot = data->Transform.UseQuatRotation
+            ? glm::degrees(glm::eulerAngles(data->Transform.RotationQ))
+            : data->Transform.Rotation;
         *outX = rot.x; *outY = rot.y; *outZ = rot.z;
     }
 
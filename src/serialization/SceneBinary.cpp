@@ -0,0 +1,623 @@
+#include "SceneBinary.h"
+#include <climits>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace scenebin {
+
+namespace {
+
+enum Tag : uint8_t {
+    TagNull = 0,
+    TagFalse,
+    TagTrue,
+    TagInt,        // zigzag varint
+    TagUInt,       // varint
+    TagF32,
+    TagF64,
+    TagString,     // varint string index
+    TagGuid,       // varint guid index
+    TagArray,      // varint count, values
+    TagObject,     // varint count, (varint key string index, value)*
+    TagF32Array,   // varint count, f32[count]
+    TagI32Array,   // varint count, i32[count]; JSON signed integers
+    TagU32Array,   // varint count, u32[count]; JSON unsigned integers (entity ids)
+};
+
+constexpr int kMaxDepth = 256;
+constexpr uint64_t kAlign = 8;
+
+bool IsF32Exact(double d) {
+    const float f = static_cast<float>(d);
+    return static_cast<double>(f) == d || d != d;
+}
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Exactly ClaymoreGUID::ToString's form, so the string comes back byte for byte
+bool ParseGuid(const std::string& s, Guid& out) {
+    if (s.size() != 32) return false;
+    uint64_t parts[2] = {};
+    for (size_t i = 0; i < 32; ++i) {
+        const int d = HexDigit(s[i]);
+        if (d < 0) return false;
+        parts[i / 16] = (parts[i / 16] << 4) | uint64_t(d);
+    }
+    out.high = parts[0];
+    out.low = parts[1];
+    return true;
+}
+
+std::string GuidToString(const Guid& g) {
+    static const char kHex[] = "0123456789abcdef";
+    std::string s(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        s[15 - i] = kHex[(g.high >> (i * 4)) & 0xF];
+        s[31 - i] = kHex[(g.low >> (i * 4)) & 0xF];
+    }
+    return s;
+}
+
+// --------------------------------------------------------------------------------
+// Encoding
+// --------------------------------------------------------------------------------
+class Encoder {
+public:
+    std::vector<std::string_view> Strings;
+    std::vector<Guid> Guids;
+    std::vector<uint8_t> Values;
+    std::string Error;
+
+    uint32_t String(std::string_view s) {
+        auto it = m_StringIndex.find(s);
+        if (it != m_StringIndex.end()) return it->second;
+        const uint32_t index = uint32_t(Strings.size());
+        Strings.push_back(s);
+        m_StringIndex.emplace(s, index);
+        return index;
+    }
+
+    uint32_t GuidIndex(const std::string& s, const Guid& g) {
+        auto it = m_GuidIndex.find(s);
+        if (it != m_GuidIndex.end()) return it->second;
+        const uint32_t index = uint32_t(Guids.size());
+        Guids.push_back(g);
+        m_GuidIndex.emplace(s, index);
+        return index;
+    }
+
+    void Byte(uint8_t b) { Values.push_back(b); }
+
+    void Varint(uint64_t v) {
+        while (v >= 0x80) { Values.push_back(uint8_t(v) | 0x80); v >>= 7; }
+        Values.push_back(uint8_t(v));
+    }
+
+    template<class T>
+    void Raw(const T& v) {
+        const size_t at = Values.size();
+        Values.resize(at + sizeof(T));
+        std::memcpy(Values.data() + at, &v, sizeof(T));
+    }
+
+    bool Value(const json& v, int depth = 0) {
+        if (depth > kMaxDepth) { Error = "document nested too deeply"; return false; }
+        switch (v.type()) {
+        case json::value_t::null:
+            Byte(TagNull);
+            return true;
+        case json::value_t::boolean:
+            Byte(v.get<bool>() ? TagTrue : TagFalse);
+            return true;
+        case json::value_t::number_integer: {
+            const int64_t i = v.get<int64_t>();
+            Byte(TagInt);
+            Varint((uint64_t(i) << 1) ^ uint64_t(i >> 63));
+            return true;
+        }
+        case json::value_t::number_unsigned:
+            Byte(TagUInt);
+            Varint(v.get<uint64_t>());
+            return true;
+        case json::value_t::number_float: {
+            const double d = v.get<double>();
+            if (IsF32Exact(d)) { Byte(TagF32); Raw(static_cast<float>(d)); }
+            else { Byte(TagF64); Raw(d); }
+            return true;
+        }
+        case json::value_t::string: {
+            const std::string& s = v.get_ref<const std::string&>();
+            Guid g;
+            if (ParseGuid(s, g)) { Byte(TagGuid); Varint(GuidIndex(s, g)); }
+            else { Byte(TagString); Varint(String(s)); }
+            return true;
+        }
+        case json::value_t::array:
+            return Array(v, depth);
+        case json::value_t::object:
+            Byte(TagObject);
+            Varint(v.size());
+            for (auto it = v.begin(); it != v.end(); ++it) {
+                Varint(String(it.key()));
+                if (!Value(it.value(), depth + 1)) return false;
+            }
+            return true;
+        default:
+            Error = "binary JSON values are not supported";
+            return false;
+        }
+    }
+
+private:
+    bool Array(const json& v, int depth) {
+        bool allF32 = !v.empty(), allI32 = !v.empty(), allU32 = !v.empty();
+        for (const json& e : v) {
+            if (allF32 && !(e.is_number_float() && IsF32Exact(e.get<double>()))) allF32 = false;
+            if (allI32) {
+                if (e.type() != json::value_t::number_integer) allI32 = false;
+                else { const int64_t i = e.get<int64_t>(); allI32 = i >= INT32_MIN && i <= INT32_MAX; }
+            }
+            if (allU32 && !(e.is_number_unsigned() && e.get<uint64_t>() <= UINT32_MAX)) allU32 = false;
+            if (!allF32 && !allI32 && !allU32) break;
+        }
+        if (allF32) {
+            Byte(TagF32Array);
+            Varint(v.size());
+            for (const json& e : v) Raw(static_cast<float>(e.get<double>()));
+            return true;
+        }
+        if (allI32) {
+            Byte(TagI32Array);
+            Varint(v.size());
+            for (const json& e : v) Raw(static_cast<int32_t>(e.get<int64_t>()));
+            return true;
+        }
+        if (allU32) {
+            Byte(TagU32Array);
+            Varint(v.size());
+            for (const json& e : v) Raw(static_cast<uint32_t>(e.get<uint64_t>()));
+            return true;
+        }
+        Byte(TagArray);
+        Varint(v.size());
+        for (const json& e : v)
+            if (!Value(e, depth + 1)) return false;
+        return true;
+    }
+
+    std::unordered_map<std::string_view, uint32_t> m_StringIndex;
+    std::unordered_map<std::string_view, uint32_t> m_GuidIndex;
+};
+
+bool ReadFloats(const json& obj, const char* key, float* out, size_t count) {
+    auto it = obj.find(key);
+    if (it == obj.end() || !it->is_array() || it->size() != count) return false;
+    for (size_t i = 0; i < count; ++i) {
+        const json& e = (*it)[i];
+        if (!e.is_number_float() || !IsF32Exact(e.get<double>())) return false;
+        out[i] = static_cast<float>(e.get<double>());
+    }
+    return true;
+}
+
+bool ReadFlag(const json& obj, const char* key, uint32_t bit, uint32_t& flags) {
+    auto it = obj.find(key);
+    if (it == obj.end() || !it->is_boolean()) return false;
+    if (it->get<bool>()) flags |= bit;
+    return true;
+}
+
+// Only an exact SerializeTransform object becomes a record; everything else stays generic
+bool PackTransform(const json& t, TransformRecord& r) {
+    return t.is_object() && t.size() == 8
+        && ReadFloats(t, "position", r.position, 3)
+        && ReadFloats(t, "rotation", r.rotation, 3)
+        && ReadFloats(t, "scale", r.scale, 3)
+        && ReadFloats(t, "rotationQ", r.rotationQ, 4)
+        && ReadFloats(t, "localMatrix", r.localMatrix, 16)
+        && ReadFloats(t, "worldMatrix", r.worldMatrix, 16)
+        && ReadFlag(t, "useQuatRotation", TransformUseQuatRotation, r.flags)
+        && ReadFlag(t, "transformDirty", TransformDirty, r.flags);
+}
+
+bool PackInteger(const json& v, int64_t& out, uint32_t& fields, uint32_t has, uint32_t isUnsigned) {
+    if (v.is_number_unsigned()) { out = int64_t(v.get<uint64_t>()); fields |= has | isUnsigned; return true; }
+    if (v.is_number_integer()) { out = v.get<int64_t>(); fields |= has; return true; }
+    return false;
+}
+
+struct PendingTable {
+    std::string_view key;
+    std::vector<std::pair<uint32_t, const json*>> rows;
+};
+
+void AppendSection(std::vector<uint8_t>& out, Range& range, const void* data, size_t size) {
+    out.resize((out.size() + kAlign - 1) & ~(kAlign - 1), 0);
+    range.offset = out.size();
+    range.size = size;
+    if (size) out.insert(out.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+}
+
+// --------------------------------------------------------------------------------
+// Decoding
+// --------------------------------------------------------------------------------
+struct Reader {
+    const uint8_t* p = nullptr;
+    const uint8_t* end = nullptr;
+    bool ok = true;
+
+    size_t Remaining() const { return size_t(end - p); }
+
+    uint8_t Byte() {
+        if (p >= end) { ok = false; return 0; }
+        return *p++;
+    }
+
+    uint64_t Varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = Byte();
+            if (!ok) return 0;
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+
+    template<class T>
+    T Raw() {
+        T v{};
+        if (Remaining() < sizeof(T)) { ok = false; return v; }
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return v;
+    }
+};
+
+class Decoder {
+public:
+    std::vector<std::string_view> Strings;
+    std::vector<Guid> Guids;
+
+    bool Value(Reader& r, json& out, int depth = 0) {
+        if (depth > kMaxDepth) return false;
+        switch (r.Byte()) {
+        case TagNull:  out = nullptr; return r.ok;
+        case TagFalse: out = false; return r.ok;
+        case TagTrue:  out = true; return r.ok;
+        case TagInt: {
+            const uint64_t z = r.Varint();
+            out = int64_t(z >> 1) ^ -int64_t(z & 1);
+            return r.ok;
+        }
+        case TagUInt: out = r.Varint(); return r.ok;
+        case TagF32:  out = static_cast<double>(r.Raw<float>()); return r.ok;
+        case TagF64:  out = r.Raw<double>(); return r.ok;
+        case TagString: {
+            const uint64_t i = r.Varint();
+            if (!r.ok || i >= Strings.size()) return false;
+            out = std::string(Strings[i]);
+            return true;
+        }
+        case TagGuid: {
+            const uint64_t i = r.Varint();
+            if (!r.ok || i >= Guids.size()) return false;
+            out = GuidToString(Guids[i]);
+            return true;
+        }
+        case TagArray: {
+            const uint64_t n = r.Varint();
+            if (!r.ok || n > r.Remaining()) return false; // every value takes at least a byte
+            json::array_t arr(n);
+            for (json& e : arr)
+                if (!Value(r, e, depth + 1)) return false;
+            out = std::move(arr);
+            return true;
+        }
+        case TagObject: {
+            const uint64_t n = r.Varint();
+            if (!r.ok || n > r.Remaining() / 2) return false;
+            json::object_t obj;
+            for (uint64_t i = 0; i < n; ++i) {
+                const uint64_t k = r.Varint();
+                if (!r.ok || k >= Strings.size()) return false;
+                // Keys were written in map order, so the hint makes every insert O(1)
+                auto it = obj.emplace_hint(obj.end(), std::string(Strings[k]), nullptr);
+                if (!Value(r, it->second, depth + 1)) return false;
+            }
+            out = std::move(obj);
+            return true;
+        }
+        case TagF32Array: return PackedArray<float>(r, out);
+        case TagI32Array: return PackedArray<int32_t>(r, out);
+        case TagU32Array: return PackedArray<uint32_t>(r, out);
+        default: return false;
+        }
+    }
+
+    json Transform(const TransformRecord& t) const {
+        json::object_t obj;
+        obj.emplace("localMatrix", Floats(t.localMatrix, 16));
+        obj.emplace("position", Floats(t.position, 3));
+        obj.emplace("rotation", Floats(t.rotation, 3));
+        obj.emplace("rotationQ", Floats(t.rotationQ, 4));
+        obj.emplace("scale", Floats(t.scale, 3));
+        obj.emplace("transformDirty", (t.flags & TransformDirty) != 0);
+        obj.emplace("useQuatRotation", (t.flags & TransformUseQuatRotation) != 0);
+        obj.emplace("worldMatrix", Floats(t.worldMatrix, 16));
+        return json(std::move(obj));
+    }
+
+private:
+    template<class T>
+    static bool PackedArray(Reader& r, json& out) {
+        const uint64_t n = r.Varint();
+        if (!r.ok || n > r.Remaining() / sizeof(T)) return false;
+        json::array_t arr;
+        arr.reserve(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            T v;
+            std::memcpy(&v, r.p + i * sizeof(T), sizeof(T));
+            if constexpr (std::is_same_v<T, float>) arr.emplace_back(static_cast<double>(v));
+            else if constexpr (std::is_same_v<T, uint32_t>) arr.emplace_back(static_cast<uint64_t>(v));
+            else arr.emplace_back(static_cast<int64_t>(v));
+        }
+        r.p += n * sizeof(T);
+        out = std::move(arr);
+        return true;
+    }
+
+    static json Floats(const float* f, size_t n) {
+        json::array_t arr;
+        arr.reserve(n);
+        for (size_t i = 0; i < n; ++i) arr.emplace_back(static_cast<double>(f[i]));
+        return json(std::move(arr));
+    }
+};
+
+bool InFile(const Range& r, size_t size) {
+    return r.offset <= size && r.size <= size - r.offset;
+}
+
+template<class T>
+bool ReadRecords(const uint8_t* data, const Range& r, uint32_t count, std::vector<T>& out) {
+    if (r.size != uint64_t(count) * sizeof(T)) return false;
+    out.resize(count);
+    if (count) std::memcpy(out.data(), data + r.offset, r.size);
+    return true;
+}
+
+bool Fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+bool IsSceneBinary(const uint8_t* data, size_t size) {
+    uint32_t magic = 0;
+    if (size < sizeof(Header)) return false;
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == kMagic;
+}
+
+bool Encode(const json& document, std::vector<uint8_t>& out, std::string* error) {
+    Encoder enc;
+    Header header;
+    std::vector<EntityRecord> entities;
+    std::vector<TransformRecord> transforms;
+    std::vector<PendingTable> tables;
+
+    const json* entityArray = nullptr;
+    if (document.is_object()) {
+        auto it = document.find("entities");
+        if (it != document.end() && it->is_array()) {
+            entityArray = &*it;
+            for (const json& e : *it)
+                if (!e.is_object()) { entityArray = nullptr; break; }
+        }
+    }
+
+    if (entityArray) {
+        header.flags |= HeaderHasEntityTable;
+        std::unordered_map<std::string_view, size_t> tableIndex;
+        entities.reserve(entityArray->size());
+        for (const json& e : *entityArray) {
+            const uint32_t index = uint32_t(entities.size());
+            EntityRecord rec;
+            for (auto it = e.begin(); it != e.end(); ++it) {
+                const std::string& key = it.key();
+                const json& v = it.value();
+                bool packed = false;
+                if (key == "id") packed = PackInteger(v, rec.id, rec.fields, EntityHasId, EntityIdUnsigned);
+                else if (key == "parent") packed = PackInteger(v, rec.parent, rec.fields, EntityHasParent, EntityParentUnsigned);
+                else if (key == "layer") packed = PackInteger(v, rec.layer, rec.fields, EntityHasLayer, EntityLayerUnsigned);
+                else if (key == "name" && v.is_string()) { rec.name = enc.String(v.get_ref<const std::string&>()); rec.fields |= EntityHasName; packed = true; }
+                else if (key == "tag" && v.is_string()) { rec.tag = enc.String(v.get_ref<const std::string&>()); rec.fields |= EntityHasTag; packed = true; }
+                else if (key == "guid" && v.is_string()) {
+                    Guid g;
+                    if (ParseGuid(v.get_ref<const std::string&>(), g)) {
+                        rec.guid = enc.GuidIndex(v.get_ref<const std::string&>(), g);
+                        rec.fields |= EntityHasGuid;
+                        packed = true;
+                    }
+                }
+                else if (key == "transform") {
+                    TransformRecord t;
+                    if (PackTransform(v, t)) { transforms.push_back(t); rec.fields |= EntityHasTransform; packed = true; }
+                }
+                if (packed) continue;
+
+                auto [slot, inserted] = tableIndex.emplace(key, tables.size());
+                if (inserted) tables.push_back(PendingTable{ key, {} });
+                tables[slot->second].rows.emplace_back(index, &v);
+            }
+            entities.push_back(rec);
+        }
+    }
+
+    // Component tables first, then the document without "entities"
+    std::vector<TableRecord> tableRecords;
+    tableRecords.reserve(tables.size());
+    for (const PendingTable& t : tables) {
+        TableRecord rec;
+        rec.key = enc.String(t.key);
+        rec.rowCount = uint32_t(t.rows.size());
+        rec.offset = enc.Values.size();
+        uint32_t previous = 0;
+        for (const auto& [entity, value] : t.rows) {
+            enc.Varint(entity - previous);
+            previous = entity;
+            if (!enc.Value(*value)) return Fail(error, enc.Error.c_str());
+        }
+        tableRecords.push_back(rec);
+    }
+    header.rootValue = enc.Values.size();
+    if (entityArray) {
+        enc.Byte(TagObject);
+        enc.Varint(document.size() - 1);
+        for (auto it = document.begin(); it != document.end(); ++it) {
+            if (&it.value() == entityArray) continue;
+            enc.Varint(enc.String(it.key()));
+            if (!enc.Value(it.value(), 1)) return Fail(error, enc.Error.c_str());
+        }
+    } else if (!enc.Value(document)) {
+        return Fail(error, enc.Error.c_str());
+    }
+
+    std::vector<uint32_t> offsets;
+    offsets.reserve(enc.Strings.size() + 1);
+    std::vector<uint8_t> stringSection;
+    uint64_t stringBytes = 0;
+    for (std::string_view s : enc.Strings) stringBytes += s.size();
+    if (stringBytes > UINT32_MAX) return Fail(error, "string table exceeds 4 GiB");
+    stringSection.resize((enc.Strings.size() + 1) * sizeof(uint32_t) + stringBytes);
+    {
+        uint8_t* bytes = stringSection.data() + (enc.Strings.size() + 1) * sizeof(uint32_t);
+        uint32_t at = 0;
+        for (std::string_view s : enc.Strings) {
+            offsets.push_back(at);
+            std::memcpy(bytes + at, s.data(), s.size());
+            at += uint32_t(s.size());
+        }
+        offsets.push_back(at);
+        std::memcpy(stringSection.data(), offsets.data(), offsets.size() * sizeof(uint32_t));
+    }
+
+    header.entityCount = uint32_t(entities.size());
+    header.stringCount = uint32_t(enc.Strings.size());
+    header.guidCount = uint32_t(enc.Guids.size());
+    header.transformCount = uint32_t(transforms.size());
+    header.tableCount = uint32_t(tableRecords.size());
+
+    out.clear();
+    out.reserve(sizeof(Header) + stringSection.size() + enc.Guids.size() * sizeof(Guid)
+        + entities.size() * sizeof(EntityRecord) + transforms.size() * sizeof(TransformRecord)
+        + tableRecords.size() * sizeof(TableRecord) + enc.Values.size() + 6 * kAlign);
+    out.resize(sizeof(Header));
+    AppendSection(out, header.strings, stringSection.data(), stringSection.size());
+    AppendSection(out, header.guids, enc.Guids.data(), enc.Guids.size() * sizeof(Guid));
+    AppendSection(out, header.entities, entities.data(), entities.size() * sizeof(EntityRecord));
+    AppendSection(out, header.transforms, transforms.data(), transforms.size() * sizeof(TransformRecord));
+    AppendSection(out, header.tables, tableRecords.data(), tableRecords.size() * sizeof(TableRecord));
+    AppendSection(out, header.values, enc.Values.data(), enc.Values.size());
+    std::memcpy(out.data(), &header, sizeof(Header));
+    return true;
+}
+
+bool Decode(const uint8_t* data, size_t size, json& out, std::string* error) {
+    if (!IsSceneBinary(data, size)) return Fail(error, "not a scene binary");
+    Header h;
+    std::memcpy(&h, data, sizeof(Header));
+    if (h.version != kVersion) return Fail(error, "unsupported scene binary version");
+    for (const Range* r : { &h.strings, &h.guids, &h.entities, &h.transforms, &h.tables, &h.values })
+        if (!InFile(*r, size)) return Fail(error, "section out of bounds");
+
+    Decoder dec;
+    {
+        const uint64_t tableBytes = (uint64_t(h.stringCount) + 1) * sizeof(uint32_t);
+        if (tableBytes > h.strings.size) return Fail(error, "string table out of bounds");
+        std::vector<uint32_t> offsets(size_t(h.stringCount) + 1);
+        std::memcpy(offsets.data(), data + h.strings.offset, tableBytes);
+        const char* bytes = reinterpret_cast<const char*>(data + h.strings.offset + tableBytes);
+        const uint64_t byteCount = h.strings.size - tableBytes;
+        dec.Strings.reserve(h.stringCount);
+        for (uint32_t i = 0; i < h.stringCount; ++i) {
+            if (offsets[i] > offsets[i + 1] || offsets[i + 1] > byteCount) return Fail(error, "corrupt string table");
+            dec.Strings.emplace_back(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+    std::vector<EntityRecord> entities;
+    std::vector<TransformRecord> transforms;
+    std::vector<TableRecord> tables;
+    if (!ReadRecords(data, h.guids, h.guidCount, dec.Guids)
+        || !ReadRecords(data, h.entities, h.entityCount, entities)
+        || !ReadRecords(data, h.transforms, h.transformCount, transforms)
+        || !ReadRecords(data, h.tables, h.tableCount, tables))
+        return Fail(error, "corrupt record section");
+
+    const uint8_t* values = data + h.values.offset;
+    auto readerAt = [&](uint64_t offset) {
+        Reader r;
+        r.p = values + (offset <= h.values.size ? offset : h.values.size);
+        r.end = values + h.values.size;
+        r.ok = offset <= h.values.size;
+        return r;
+    };
+
+    Reader root = readerAt(h.rootValue);
+    if (!root.ok || !dec.Value(root, out)) return Fail(error, "corrupt document");
+    if (!(h.flags & HeaderHasEntityTable)) return true;
+    if (!out.is_object()) return Fail(error, "corrupt document");
+
+    json::array_t ents(h.entityCount);
+    size_t nextTransform = 0;
+    for (uint32_t i = 0; i < h.entityCount; ++i) {
+        const EntityRecord& rec = entities[i];
+        json::object_t obj;
+        auto integer = [](int64_t v, bool isUnsigned) { return isUnsigned ? json(uint64_t(v)) : json(v); };
+        auto string = [&](uint32_t index, json& dst) {
+            if (index >= dec.Strings.size()) return false;
+            dst = std::string(dec.Strings[index]);
+            return true;
+        };
+        if (rec.fields & EntityHasId) obj.emplace("id", integer(rec.id, rec.fields & EntityIdUnsigned));
+        if (rec.fields & EntityHasParent) obj.emplace("parent", integer(rec.parent, rec.fields & EntityParentUnsigned));
+        if (rec.fields & EntityHasLayer) obj.emplace("layer", integer(rec.layer, rec.fields & EntityLayerUnsigned));
+        if ((rec.fields & EntityHasName) && !string(rec.name, obj["name"])) return Fail(error, "corrupt entity");
+        if ((rec.fields & EntityHasTag) && !string(rec.tag, obj["tag"])) return Fail(error, "corrupt entity");
+        if (rec.fields & EntityHasGuid) {
+            if (rec.guid >= dec.Guids.size()) return Fail(error, "corrupt entity");
+            obj.emplace("guid", GuidToString(dec.Guids[rec.guid]));
+        }
+        if (rec.fields & EntityHasTransform) {
+            if (nextTransform >= transforms.size()) return Fail(error, "corrupt entity");
+            obj.emplace("transform", dec.Transform(transforms[nextTransform++]));
+        }
+        ents[i] = json(std::move(obj));
+    }
+
+    for (const TableRecord& t : tables) {
+        if (t.key >= dec.Strings.size()) return Fail(error, "corrupt table");
+        const std::string key(dec.Strings[t.key]);
+        Reader r = readerAt(t.offset);
+        uint64_t entity = 0;
+        for (uint32_t row = 0; row < t.rowCount; ++row) {
+            entity += r.Varint();
+            if (!r.ok || entity >= ents.size()) return Fail(error, "corrupt table");
+            auto& obj = ents[entity].get_ref<json::object_t&>();
+            if (!dec.Value(r, obj[key], 1)) return Fail(error, "corrupt table");
+        }
+    }
+    out["entities"] = std::move(ents);
+    return true;
+}
+
+} // namespace scenebin
@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Binary encoding of scene and prefab documents, read and written alongside JSON.
+// It encodes the same document that Serializer::SerializeScene builds, so every
+// loader works on either format; Serializer::ReadSceneFile tells them apart by the
+// magic. Decoding skips the text parse and, for the bulk of a level, the number
+// and key parsing: entity headers and transforms are fixed records, float arrays
+// (vectors, matrices, weights) are packed f32.
+//
+// Layout: a fixed header followed by sections addressed by Range (byte offset from
+// the start of the file). Little-endian only.
+//   strings     uint32 offsets[stringCount + 1], then the UTF-8 bytes; keys and values
+//   guids       Guid[guidCount]; 32-digit hex strings (ClaymoreGUID::ToString) by value
+//   entities    EntityRecord[entityCount], one per element of "entities"
+//   transforms  TransformRecord per entity with EntityHasTransform, in entity order
+//   tables      TableRecord[tableCount]: one per remaining entity key ("mesh", "light",
+//               "children", ...), rows sorted by entity
+//   values      tagged value stream: table rows and the document without "entities"
+//
+// Values keep the JSON types exactly: floats are stored as f32 when that is lossless
+// and as f64 otherwise, integers as signed or unsigned varints, so decoding a
+// converted file yields a document equal to the parsed JSON.
+namespace scenebin {
+
+using json = nlohmann::json;
+
+constexpr uint32_t kMagic = 0x42435343; // "CSCB"
+// Bump on any layout change; older files fail to decode and must be re-converted.
+constexpr uint32_t kVersion = 1;
+
+enum HeaderFlags : uint32_t {
+    HeaderHasEntityTable = 1u << 0, // "entities" lives in the entity section, not in the root value
+};
+
+struct Range {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+struct Header {
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t flags = 0;
+    uint32_t entityCount = 0;
+    uint32_t stringCount = 0;
+    uint32_t guidCount = 0;
+    uint32_t transformCount = 0;
+    uint32_t tableCount = 0;
+    Range strings;
+    Range guids;
+    Range entities;
+    Range transforms;
+    Range tables;
+    Range values;
+    uint64_t rootValue = 0;        // offset of the root value within 'values'
+};
+
+struct Guid {
+    uint64_t high = 0;
+    uint64_t low = 0;
+};
+
+constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+enum EntityFields : uint32_t {
+    EntityHasId          = 1u << 0,
+    EntityIdUnsigned     = 1u << 1,
+    EntityHasParent      = 1u << 2,
+    EntityParentUnsigned = 1u << 3,
+    EntityHasLayer       = 1u << 4,
+    EntityLayerUnsigned  = 1u << 5,
+    EntityHasName        = 1u << 6,
+    EntityHasTag         = 1u << 7,
+    EntityHasGuid        = 1u << 8,
+    EntityHasTransform   = 1u << 9,
+};
+
+struct EntityRecord {
+    int64_t  id = 0;
+    int64_t  parent = 0;
+    int64_t  layer = 0;
+    uint32_t name = kNone;         // string index
+    uint32_t tag = kNone;          // string index
+    uint32_t guid = kNone;         // guid index
+    uint32_t fields = 0;           // EntityFields
+};
+
+enum TransformFlags : uint32_t {
+    TransformUseQuatRotation = 1u << 0,
+    TransformDirty           = 1u << 1,
+};
+
+// Serializer::SerializeTransform's object; any other shape goes to the "transform" table
+struct TransformRecord {
+    float    position[3] = {};
+    float    rotation[3] = {};
+    float    scale[3] = {};
+    float    rotationQ[4] = {};    // w, x, y, z
+    float    localMatrix[16] = {};
+    float    worldMatrix[16] = {};
+    uint32_t flags = 0;            // TransformFlags
+};
+
+struct TableRecord {
+    uint32_t key = 0;              // string index of the entity key
+    uint32_t rowCount = 0;
+    uint64_t offset = 0;           // within 'values'; rows are (varint entity delta, value)
+};
+
+// True if 'data' starts with a scene binary header (any version)
+bool IsSceneBinary(const uint8_t* data, size_t size);
+
+// Encodes a scene or prefab document
+bool Encode(const json& document, std::vector<uint8_t>& out, std::string* error = nullptr);
+// Decodes a document written by Encode. Validates every offset; safe on untrusted input.
+bool Decode(const uint8_t* data, size_t size, json& out, std::string* error = nullptr);
+
+} // namespace scenebin
@@ -0,0 +1,263 @@
+#include "SceneLoader.h"
+#include "Serializer.h"
+#include "ecs/Scene.h"
+#include "ecs/EntityData.h"
+#include "rendering/ModelLoader.h"
+#include "jobs/Jobs.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+
+// What the jobs produce. Jobs write it until Pending drops to zero; the main thread
+// reads it only after that (Records and the model count once Parsed is set).
+struct SceneLoader::Staging {
+    std::string Path;
+    json Data;
+    std::vector<Serializer::SceneRecord> Records;
+    std::vector<EntityData> Entities;  // one per Entity record, in record order
+    // Models without a binary cache, imported by source path; empty if the import failed
+    std::unordered_map<std::string, std::unique_ptr<ImportedModel>> Models;
+    bool Ok = false;
+    std::atomic<bool> Parsed{ false };
+    std::atomic<int> Pending{ 1 };     // the staging job plus model imports still running
+    std::atomic<size_t> ModelsTotal{ 0 };
+    std::atomic<size_t> ModelsDone{ 0 };
+};
+
+struct SceneLoader::Load {
+    Handle Id = kInvalidHandle;
+    Scene* Target = nullptr;
+    SceneLoadOptions Options;
+    std::shared_ptr<Staging> Staged;
+    bool Cancelled = false;
+    bool Succeeded = false;
+    bool Started = false;              // commit began: settings applied, scene cleared
+    size_t NextRecord = 0;
+    size_t NextEntity = 0;
+    std::unordered_map<EntityID, EntityID> IdMapping; // file id -> entity
+    std::unordered_set<EntityID> OpaqueRoots;
+    std::vector<EntityID> Committed;
+};
+
+SceneLoader::~SceneLoader() = default;
+
+SceneLoader& SceneLoader::Instance() {
+    static SceneLoader instance;
+    return instance;
+}
+
+SceneLoader::Handle SceneLoader::LoadAsync(const std::string& path, Scene& scene, SceneLoadOptions options) {
+    auto load = std::make_unique<Load>();
+    load->Id = m_NextHandle++;
+    load->Target = &scene;
+    load->Options = std::move(options);
+    load->Staged = std::make_shared<Staging>();
+    load->Staged->Path = path;
+
+    std::shared_ptr<Staging> staged = load->Staged;
+    if (!Jobs().EnqueueBackground([staged] { StageScene(staged); })) {
+        std::cerr << "[SceneLoader] Job system is stopping; cannot load " << path << std::endl;
+        return kInvalidHandle;
+    }
+    std::cout << "[SceneLoader] Loading " << (load->Options.additive ? "additive scene: " : "scene: ") << path << std::endl;
+    m_Loads.push_back(std::move(load));
+    return m_Loads.back()->Id;
+}
+
+void SceneLoader::StageScene(const std::shared_ptr<Staging>& st) {
+    using Kind = Serializer::SceneRecord::Kind;
+    if (Serializer::ReadSceneFile(st->Path, st->Data) && st->Data.contains("entities")) {
+        const json& data = st->Data;
+        Serializer::LogSceneSummary(data);
+        Serializer::PlanSceneEntities(data, st->Records);
+        // Plain entities are built here in full except mesh and scripts, which reach
+        // into asset, material and script state the main thread is using
+        for (const Serializer::SceneRecord& rec : st->Records) {
+            if (rec.kind == Kind::Entity) {
+                EntityData ed;
+                ed.Name = (*rec.data)["name"].get<std::string>();
+                Serializer::DeserializeEntityFields(*rec.data, ed);
+                Serializer::DeserializeEntityComponents(*rec.data, ed);
+                st->Entities.push_back(std::move(ed));
+            } else if (rec.kind == Kind::Model && rec.modelMeta.empty() && !rec.modelPath.empty()) {
+                st->Models.emplace(rec.modelPath, std::make_unique<ImportedModel>());
+            }
+        }
+        st->Ok = true;
+    } else if (st->Data.is_object()) {
+        std::cerr << "[SceneLoader] Not a scene (no entities): " << st->Path << std::endl;
+    }
+    st->ModelsTotal.store(st->Models.size());
+    st->Parsed.store(true, std::memory_order_release);
+
+    // Models without a binary cache go through Assimp, one job each; the map is not
+    // modified from here on
+    for (auto& [path, model] : st->Models) {
+        ImportedModel* slot = model.get();
+        st->Pending.fetch_add(1);
+        auto import = [st, path = path, slot] {
+            if (!ModelLoader::ImportModel(path, *slot)) *slot = ImportedModel{};
+            st->ModelsDone.fetch_add(1);
+            st->Pending.fetch_sub(1, std::memory_order_release);
+        };
+        if (!Jobs().EnqueueBackground(import)) import();
+    }
+    st->Pending.fetch_sub(1, std::memory_order_release);
+}
+
+void SceneLoader::Update() {
+    // Callbacks may start or cancel loads: Cancel only flags, LoadAsync only appends
+    for (size_t i = 0; i < m_Loads.size();) {
+        if (!Advance(*m_Loads[i])) { ++i; continue; }
+        std::unique_ptr<Load> done = std::move(m_Loads[i]);
+        m_Loads.erase(m_Loads.begin() + i);
+        if (done->Options.onComplete) done->Options.onComplete(done->Succeeded);
+    }
+}
+
+bool SceneLoader::Advance(Load& load) {
+    Staging& st = *load.Staged;
+    if (load.Cancelled) {
+        if (load.Options.additive) RemoveCommitted(load);
+        std::cout << "[SceneLoader] Cancelled: " << st.Path << std::endl;
+        Report(load, SceneLoadProgress::Stage::Cancelled);
+        return true;
+    }
+    if (st.Pending.load(std::memory_order_acquire) != 0) {
+        Report(load, st.Parsed.load(std::memory_order_acquire) ? SceneLoadProgress::Stage::Importing
+                                                               : SceneLoadProgress::Stage::Reading);
+        return false;
+    }
+    if (!st.Ok) {
+        std::cerr << "[SceneLoader] Failed to load scene: " << st.Path << std::endl;
+        Report(load, SceneLoadProgress::Stage::Failed);
+        return true;
+    }
+    if (!Commit(load)) {
+        Report(load, SceneLoadProgress::Stage::Committing);
+        return false;
+    }
+    load.Succeeded = true;
+    std::cout << "[SceneLoader] Scene loaded from: " << st.Path << std::endl;
+    Report(load, SceneLoadProgress::Stage::Done);
+    return true;
+}
+
+bool SceneLoader::Commit(Load& load) {
+    using Clock = std::chrono::steady_clock;
+    using Kind = Serializer::SceneRecord::Kind;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(load.Options.frameBudgetMs));
+    Staging& st = *load.Staged;
+    Scene& scene = *load.Target;
+    const bool additive = load.Options.additive;
+
+    if (!load.Started) {
+        load.Started = true;
+        Serializer::ApplySceneSettings(st.Data, scene, additive);
+        if (!additive) {
+            // Same reset as Serializer::DeserializeScene
+            std::vector<EntityID> entitiesToRemove;
+            for (const auto& entity : scene.GetEntities()) entitiesToRemove.push_back(entity.GetID());
+            for (EntityID id : entitiesToRemove) scene.RemoveEntity(id);
+            scene.ResetEntityIdCounter(1);
+            for (auto it = m_Additive.begin(); it != m_Additive.end();) {
+                if (it->second.Target == &scene) it = m_Additive.erase(it);
+                else ++it;
+            }
+        }
+    }
+
+    // At least one record per frame so a slow model cannot stall the load
+    bool ranAny = false;
+    while (load.NextRecord < st.Records.size()) {
+        if (ranAny && Clock::now() >= deadline) return false;
+        const Serializer::SceneRecord& rec = st.Records[load.NextRecord++];
+        if (rec.kind == Kind::Skip) continue;
+        ranAny = true;
+
+        const json& entityData = *rec.data;
+        EntityID newId = 0;
+        if (rec.kind == Kind::Model) {
+            auto it = st.Models.find(rec.modelPath);
+            newId = Serializer::InstantiateSceneModel(rec, scene, it != st.Models.end() ? it->second.get() : nullptr);
+            if (newId != 0) load.OpaqueRoots.insert(newId);
+        } else if (rec.kind == Kind::Entity) {
+            newId = scene.AdoptEntity(std::move(st.Entities[load.NextEntity++])).GetID();
+            if (auto* ed = scene.GetEntityData(newId)) {
+                if (entityData.contains("mesh")) { ed->Mesh = std::make_unique<MeshComponent>(); Serializer::DeserializeMesh(entityData["mesh"], *ed->Mesh); }
+                if (entityData.contains("scripts")) { Serializer::DeserializeScripts(entityData["scripts"], ed->Scripts); }
+            }
+        } else {
+            newId = Serializer::DeserializeEntity(entityData, scene);
+        }
+        if (newId != 0 && newId != (EntityID)-1) load.Committed.push_back(newId);
+        if (newId != 0 && rec.hasId) load.IdMapping[rec.oldId] = newId;
+    }
+    // Parent links and overrides get a frame of their own
+    if (ranAny && Clock::now() >= deadline) return false;
+
+    Serializer::FinishSceneLoad(st.Data, scene, load.IdMapping, load.OpaqueRoots, additive);
+    if (additive) {
+        Loaded& loaded = m_Additive[load.Id];
+        loaded.Target = &scene;
+        for (EntityID id : load.Committed) {
+            auto* ed = scene.GetEntityData(id);
+            if (ed && ed->Parent == INVALID_ENTITY_ID) loaded.Roots.push_back(id);
+        }
+    }
+    return true;
+}
+
+void SceneLoader::Report(Load& load, SceneLoadProgress::Stage stage) {
+    if (!load.Options.onProgress) return;
+    const Staging& st = *load.Staged;
+    SceneLoadProgress progress;
+    progress.stage = stage;
+    progress.path = st.Path;
+    if (st.Parsed.load(std::memory_order_acquire)) progress.entitiesTotal = st.Records.size();
+    progress.entitiesCommitted = load.NextRecord;
+
+    // Rough weights: reading 10%, model imports 40%, commit the rest
+    const size_t models = st.ModelsTotal.load();
+    const float imported = models ? float(st.ModelsDone.load()) / float(models) : 1.0f;
+    const float committed = progress.entitiesTotal ? float(load.NextRecord) / float(progress.entitiesTotal) : 1.0f;
+    switch (stage) {
+    case SceneLoadProgress::Stage::Reading:    progress.fraction = 0.0f; break;
+    case SceneLoadProgress::Stage::Importing:  progress.fraction = 0.1f + 0.4f * imported; break;
+    case SceneLoadProgress::Stage::Committing: progress.fraction = 0.5f + 0.5f * committed; break;
+    default:                                   progress.fraction = 1.0f; break;
+    }
+    load.Options.onProgress(progress);
+}
+
+void SceneLoader::RemoveCommitted(Load& load) {
+    // Children go with their parents; ids already gone are skipped
+    for (EntityID id : load.Committed) load.Target->QueueRemoveEntity(id);
+    load.Committed.clear();
+}
+
+void SceneLoader::Cancel(Handle handle) {
+    for (auto& load : m_Loads)
+        if (load->Id == handle) load->Cancelled = true;
+}
+
+bool SceneLoader::Unload(Handle handle) {
+    auto it = m_Additive.find(handle);
+    if (it == m_Additive.end()) return false;
+    for (EntityID id : it->second.Roots) it->second.Target->QueueRemoveEntity(id);
+    m_Additive.erase(it);
+    return true;
+}
+
+bool SceneLoader::IsLoading(Handle handle) const {
+    return std::any_of(m_Loads.begin(), m_Loads.end(), [&](const auto& load) { return load->Id == handle; });
+}
+
+const std::vector<EntityID>* SceneLoader::GetLoadedRoots(Handle handle) const {
+    auto it = m_Additive.find(handle);
+    return it != m_Additive.end() ? &it->second.Roots : nullptr;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ecs/Entity.h"
+
+class Scene;
+
+struct SceneLoadProgress {
+    enum class Stage { Reading, Importing, Committing, Done, Failed, Cancelled };
+    Stage stage = Stage::Reading;
+    std::string path;
+    float fraction = 0.0f;          // whole load, 0..1
+    size_t entitiesCommitted = 0;   // records of the file handled so far
+    size_t entitiesTotal = 0;
+};
+
+struct SceneLoadOptions {
+    // Keep the scene's entities, shader preset and environment; SceneLoader::Unload removes
+    // what the load brought in
+    bool additive = false;
+    // Main-thread time per frame spent creating entities
+    double frameBudgetMs = 4.0;
+    // Main thread, once per frame while loading and once at the end
+    std::function<void(const SceneLoadProgress&)> onProgress;
+    std::function<void(bool ok)> onComplete;
+};
+
+// -----------------------------------------------------------------------------
+// Non-blocking scene loads. A job reads and parses the file, plans every record
+// (Serializer::PlanSceneEntities) and builds the plain entities, components
+// included, in a staging area outside any scene; models without a binary cache are
+// imported with Assimp on further jobs. Update() then commits the staged scene on
+// the main thread a few records per frame (frameBudgetMs): entities are moved in,
+// models get their GPU buffers, meshes and scripts are attached. Parent links and
+// overrides under model roots are resolved once everything is in.
+//
+// A non-additive load clears the scene when its commit starts, so the previous
+// scene stays live while the file is read and imported. An additive load streams a
+// sub-scene in next to what is there. Main thread only; cancel loads that target a
+// scene before destroying it.
+// -----------------------------------------------------------------------------
+class SceneLoader {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kInvalidHandle = 0;
+
+    static SceneLoader& Instance();
+
+    Handle LoadAsync(const std::string& path, Scene& scene, SceneLoadOptions options = {});
+    // Once per frame: advances every load, committing within each load's frame budget
+    void Update();
+    // Stops a load. Entities an additive load already committed are removed; a
+    // replacing load leaves what it committed so far.
+    void Cancel(Handle handle);
+    // Removes the entities of a finished additive load
+    bool Unload(Handle handle);
+
+    bool IsLoading() const { return !m_Loads.empty(); }
+    bool IsLoading(Handle handle) const;
+    // Top-level entities of a finished additive load
+    const std::vector<EntityID>* GetLoadedRoots(Handle handle) const;
+
+private:
+    SceneLoader() = default;
+    ~SceneLoader();
+
+    struct Load;
+    struct Staging;
+
+    // Job side: parse, plan, build plain entities, start model imports
+    static void StageScene(const std::shared_ptr<Staging>& staging);
+    // True once the load is over (finished, failed or cancelled)
+    bool Advance(Load& load);
+    // True once every record is in and the scene is finished
+    bool Commit(Load& load);
+    void Report(Load& load, SceneLoadProgress::Stage stage);
+    void RemoveCommitted(Load& load);
+
+    struct Loaded {
+        Scene* Target = nullptr;
+        std::vector<EntityID> Roots;
+    };
+
+    std::vector<std::unique_ptr<Load>> m_Loads;
+    std::unordered_map<Handle, Loaded> m_Additive;
+    Handle m_NextHandle = 1;
+};
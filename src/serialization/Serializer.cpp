@@ -1,4 +1,5 @@
 #include "Serializer.h"
+#include "SceneBinary.h"
 #include <fstream>
 #include <iostream>
 #include "rendering/ModelBuild.h"
@@ -207,7 +208,7 @@ void Serializer::DeserializeTransform(const json& data, TransformComponent& tran
         transform.UseQuatRotation = uqr;
     }
     if (data.contains("localMatrix")) transform.LocalMatrix = DeserializeMat4(data["localMatrix"]);
-    if (data.contains("worldMatrix")) transform.WorldMatrix = DeserializeMat4(data["worldMatrix"]);
+    if (data.contains("worldMatrix")) { transform.WorldMatrix = DeserializeMat4(data["worldMatrix"]); transform.NormalMatrixDirty = true; }
     if (data.contains("transformDirty")) transform.TransformDirty = data["transformDirty"];
 }
 
@@ -455,6 +456,11 @@ void Serializer::DeserializeMesh(const json& data, MeshComponent& mesh) {
     }
     if (!mesh.materials.empty()) mesh.material = mesh.materials[0];
 
+    // Unique material toggle (read first: it decides whether the texture paths below apply)
+    if (data.contains("uniqueMaterial")) {
+        mesh.UniqueMaterial = data["uniqueMaterial"].get<bool>();
+    }
+
     // If the material is unique and we have texture source paths, restore them
     if (mesh.UniqueMaterial) {
         if (auto pbr = std::dynamic_pointer_cast<PBRMaterial>(mesh.material)) {
@@ -466,17 +472,13 @@ void Serializer::DeserializeMesh(const json& data, MeshComponent& mesh) {
                 bgfx::TextureHandle t = TextureLoader::Load2D(path);
                 if (bgfx::isValid(t)) setter(t), setter(path);
             };
-            if (data.contains("mat_albedoPath")) { pbr->SetAlbedoTexture(TextureLoader::Load2D(data["mat_albedoPath"].get<std::string>())); pbr->SetAlbedoTextureFromPath(data["mat_albedoPath"].get<std::string>()); }
-            if (data.contains("mat_mrPath")) { pbr->SetMetallicRoughnessTexture(TextureLoader::Load2D(data["mat_mrPath"].get<std::string>())); pbr->SetMetallicRoughnessTextureFromPath(data["mat_mrPath"].get<std::string>()); }
-            if (data.contains("mat_normalPath")) { pbr->SetNormalTexture(TextureLoader::Load2D(data["mat_normalPath"].get<std::string>())); pbr->SetNormalTextureFromPath(data["mat_normalPath"].get<std::string>()); }
+            // Streamed in the background; see TextureStreamer
+            if (data.contains("mat_albedoPath")) pbr->SetAlbedoTextureFromPath(data["mat_albedoPath"].get<std::string>());
+            if (data.contains("mat_mrPath")) pbr->SetMetallicRoughnessTextureFromPath(data["mat_mrPath"].get<std::string>());
+            if (data.contains("mat_normalPath")) pbr->SetNormalTextureFromPath(data["mat_normalPath"].get<std::string>());
         }
     }
 
-    // Unique material toggle
-    if (data.contains("uniqueMaterial")) {
-        mesh.UniqueMaterial = data["uniqueMaterial"].get<bool>();
-    }
-
     // PropertyBlock overrides
     mesh.PropertyBlock.Clear();
     if (data.contains("propertyBlockVec4") && data["propertyBlockVec4"].is_object()) {
@@ -579,6 +581,7 @@ json Serializer::SerializeSkeleton(const SkeletonComponent& skeleton) {
         j["jointGuids"] = json::array();
         for (uint64_t g : skeleton.JointGuids) j["jointGuids"].push_back(g);
     }
+    if (skeleton.WriteBackAllBones) j["writeBackAllBones"] = true;
     return j;
 }
 
@@ -618,18 +621,21 @@ void Serializer::DeserializeSkeleton(const json& j, SkeletonComponent& skeleton)
         skeleton.JointGuids.resize(arr.size());
         for (size_t i = 0; i < arr.size(); ++i) skeleton.JointGuids[i] = arr[i].get<uint64_t>();
     }
+    skeleton.WriteBackAllBones = j.value("writeBackAllBones", false);
 }
 
 json Serializer::SerializeSkinning(const SkinningComponent& skinning) {
     json j;
     // Do not serialize palette (runtime). Persist link to skeleton by name for robustness.
     j["skeletonRoot"] = skinning.SkeletonRoot; // temporary; may be -1. A post-load fixup will correct if needed.
+    if (skinning.CpuSkinning) j["cpuSkinning"] = true;
     return j;
 }
 
 void Serializer::DeserializeSkinning(const json& j, SkinningComponent& skinning) {
     skinning.Palette.clear();
     skinning.SkeletonRoot = j.value("skeletonRoot", (EntityID)-1);
+    skinning.CpuSkinning = j.value("cpuSkinning", false);
 }
 void Serializer::DeserializeLight(const json& data, LightComponent& light) {
     if (data.contains("type")) light.Type = static_cast<LightType>(data["type"]);
@@ -1184,6 +1190,8 @@ EntityID Serializer::DeserializeEntity(const json& data, Scene& scene) {
           entityData->Children.push_back(child.get<EntityID>());
           }
        }
+    // Parent/children were written directly (not via SetParent)
+    if (data.contains("parent") || data.contains("children")) scene.InvalidateHierarchy();
     // GUID & prefab source
     if (data.contains("guid")) {
         try { data.at("guid").get_to(entityData->EntityGuid); } catch(...) {}
@@ -1452,20 +1460,85 @@ json Serializer::SerializeScene( Scene& scene) {
 
 bool Serializer::DeserializeScene(const json& data, Scene& scene) {
     if (!data.contains("entities")) return false;
-    // Default shader preset
-    try {
-        if (data.contains("defaultShaderPreset")) {
-            int v = data["defaultShaderPreset"].get<int>();
-            scene.SetDefaultShaderPreset((Scene::ShaderPreset)v);
+    ApplySceneSettings(data, scene, false);
+    LogSceneSummary(data);
+
+    // Clear existing scene by removing all entities
+    std::vector<EntityID> entitiesToRemove;
+    for (const auto& entity : scene.GetEntities()) {
+        entitiesToRemove.push_back(entity.GetID());
+    }
+    
+    for (EntityID id : entitiesToRemove) {
+        scene.RemoveEntity(id);
+    }
+    // Reset ID counter so names don't receive incremental suffixes across reloads
+    scene.ResetEntityIdCounter(1);
+
+    std::vector<SceneRecord> records;
+    PlanSceneEntities(data, records);
+
+    // First pass: Create all entities
+    std::unordered_map<EntityID, EntityID> idMapping; // old ID -> new ID
+    // Keep track of roots that were instantiated from compact asset nodes (e.g., models).
+    // Their internal hierarchy should remain intact; skip child clearing/parent fixup for them.
+    std::unordered_set<EntityID> opaqueRoots;
+    // Created entities whose components are populated in the second pass
+    std::vector<std::pair<const json*, EntityID>> work;
+    work.reserve(records.size());
+
+    for (const SceneRecord& rec : records) {
+        const json& entityData = *rec.data;
+        EntityID newId = 0;
+        switch (rec.kind) {
+        case SceneRecord::Kind::Skip:
+            continue;
+        case SceneRecord::Kind::Model:
+            newId = InstantiateSceneModel(rec, scene);
+            if (newId != 0) opaqueRoots.insert(newId);
+            break;
+        case SceneRecord::Kind::Entity: {
+            // Preserve names exactly as authored (no suffixing)
+            newId = scene.CreateEntityExact(entityData["name"].get<std::string>()).GetID();
+            auto* ed = scene.GetEntityData(newId);
+            if (!ed) continue;
+            DeserializeEntityFields(entityData, *ed);
+            try {
+                std::cout << "[Create] guid=" << ed->EntityGuid.ToString() << " name=" << ed->Name << " src=Deserialize" << std::endl;
+            } catch(...) {}
+            work.emplace_back(&entityData, newId);
+            break;
         }
-    } catch(...) {}
+        case SceneRecord::Kind::Legacy:
+            newId = DeserializeEntity(entityData, scene);
+            if (newId != 0) work.emplace_back(&entityData, newId);
+            break;
+        }
+        if (newId != 0 && rec.hasId) {
+            idMapping[rec.oldId] = newId;
+        }
+    }
 
-    try {
-        std::cout << "[DeserializeBegin] version=" << data.value("version", "")
-                  << " entities=" << (data.contains("entities") && data["entities"].is_array() ? data["entities"].size() : 0)
-                  << std::endl;
-    } catch(...) {}
+    // Parallelize component population (entities already exist, no structural changes)
+    if (!work.empty()) {
+        auto& js = Jobs();
+        const size_t chunk = 32;
+        parallel_for(js, size_t(0), work.size(), chunk, [&](size_t s, size_t c){
+            for (size_t off = 0; off < c; ++off) {
+                const json& entityData = *work[s + off].first;
+                auto* ed = scene.GetEntityData(work[s + off].second); if (!ed) continue;
+                DeserializeEntityComponents(entityData, *ed);
+                if (entityData.contains("mesh")) { if (!ed->Mesh) ed->Mesh = std::make_unique<MeshComponent>(); DeserializeMesh(entityData["mesh"], *ed->Mesh); }
+                if (entityData.contains("scripts")) { DeserializeScripts(entityData["scripts"], ed->Scripts); }
+            }
+        });
+    }
+
+    FinishSceneLoad(data, scene, idMapping, opaqueRoots, false);
+    return true;
+}
 
+void Serializer::ApplySceneSettings(const json& data, Scene& scene, bool additive) {
     // If the scene carries an assetMap, pre-register GUID→path so asset references resolve
     try {
         if (data.contains("assetMap") && data["assetMap"].is_array()) {
@@ -1480,7 +1553,49 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
         }
     } catch(...) {}
 
-    // Telemetry: count components and unknown blocks before mutating scene
+    // A sub-scene loaded next to the current one keeps the current look
+    if (additive) return;
+
+    // Default shader preset
+    try {
+        if (data.contains("defaultShaderPreset")) {
+            int v = data["defaultShaderPreset"].get<int>();
+            scene.SetDefaultShaderPreset((Scene::ShaderPreset)v);
+        }
+    } catch(...) {}
+
+    // Apply environment if present
+    if (data.contains("environment") && data["environment"].is_object()) {
+        try {
+            Environment& env = scene.GetEnvironment();
+            const json& jenv = data["environment"];
+            std::string mode = jenv.value("ambientMode", "FlatColor");
+            env.Ambient = (mode == "Skybox") ? Environment::AmbientMode::Skybox : Environment::AmbientMode::FlatColor;
+            if (jenv.contains("ambientColor")) env.AmbientColor = DeserializeVec3(jenv["ambientColor"]);
+            env.AmbientIntensity = jenv.value("ambientIntensity", env.AmbientIntensity);
+            env.UseSkybox = jenv.value("useSkybox", env.UseSkybox);
+            env.Exposure = jenv.value("exposure", env.Exposure);
+            env.EnableFog = jenv.value("fogEnabled", env.EnableFog);
+            if (jenv.contains("fogColor")) env.FogColor = DeserializeVec3(jenv["fogColor"]);
+            env.FogDensity = jenv.value("fogDensity", env.FogDensity);
+            env.ProceduralSky = jenv.value("proceduralSky", env.ProceduralSky);
+            if (jenv.contains("skyZenithColor")) env.SkyZenithColor = DeserializeVec3(jenv["skyZenithColor"]);
+            if (jenv.contains("skyHorizonColor")) env.SkyHorizonColor = DeserializeVec3(jenv["skyHorizonColor"]);
+            // Cosmetic outline
+            env.OutlineEnabled = jenv.value("outlineEnabled", env.OutlineEnabled);
+            if (jenv.contains("outlineColor")) env.OutlineColor = DeserializeVec3(jenv["outlineColor"]);
+            env.OutlineThickness = jenv.value("outlineThickness", env.OutlineThickness);
+        } catch(...) {}
+    }
+}
+
+void Serializer::LogSceneSummary(const json& data) {
+    try {
+        std::cout << "[DeserializeBegin] version=" << data.value("version", "")
+                  << " entities=" << (data.contains("entities") && data["entities"].is_array() ? data["entities"].size() : 0)
+                  << std::endl;
+    } catch(...) {}
+
     try {
         const auto& ents = data["entities"];
         size_t numEntities = ents.is_array() ? ents.size() : 0;
@@ -1519,53 +1634,18 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
                   << " guid_missing=" << guidMissing
                   << " guid_dupes=" << guidDup << std::endl;
     } catch(...) {}
+}
 
-    // Apply environment if present
-    if (data.contains("environment") && data["environment"].is_object()) {
-        try {
-            Environment& env = scene.GetEnvironment();
-            const json& jenv = data["environment"];
-            std::string mode = jenv.value("ambientMode", "FlatColor");
-            env.Ambient = (mode == "Skybox") ? Environment::AmbientMode::Skybox : Environment::AmbientMode::FlatColor;
-            if (jenv.contains("ambientColor")) env.AmbientColor = DeserializeVec3(jenv["ambientColor"]);
-            env.AmbientIntensity = jenv.value("ambientIntensity", env.AmbientIntensity);
-            env.UseSkybox = jenv.value("useSkybox", env.UseSkybox);
-            env.Exposure = jenv.value("exposure", env.Exposure);
-            env.EnableFog = jenv.value("fogEnabled", env.EnableFog);
-            if (jenv.contains("fogColor")) env.FogColor = DeserializeVec3(jenv["fogColor"]);
-            env.FogDensity = jenv.value("fogDensity", env.FogDensity);
-            env.ProceduralSky = jenv.value("proceduralSky", env.ProceduralSky);
-            if (jenv.contains("skyZenithColor")) env.SkyZenithColor = DeserializeVec3(jenv["skyZenithColor"]);
-            if (jenv.contains("skyHorizonColor")) env.SkyHorizonColor = DeserializeVec3(jenv["skyHorizonColor"]);
-            // Cosmetic outline
-            env.OutlineEnabled = jenv.value("outlineEnabled", env.OutlineEnabled);
-            if (jenv.contains("outlineColor")) env.OutlineColor = DeserializeVec3(jenv["outlineColor"]);
-            env.OutlineThickness = jenv.value("outlineThickness", env.OutlineThickness);
-        } catch(...) {}
-    }
+void Serializer::PlanSceneEntities(const json& data, std::vector<SceneRecord>& out) {
+    out.clear();
+    if (!data.contains("entities") || !data["entities"].is_array()) return;
+    const json& entities = data["entities"];
+    out.reserve(entities.size());
 
-    // Clear existing scene by removing all entities
-    std::vector<EntityID> entitiesToRemove;
-    for (const auto& entity : scene.GetEntities()) {
-        entitiesToRemove.push_back(entity.GetID());
-    }
-    
-    for (EntityID id : entitiesToRemove) {
-        scene.RemoveEntity(id);
-    }
-    // Reset ID counter so names don't receive incremental suffixes across reloads
-    scene.ResetEntityIdCounter(1);
-    
-    // First pass: Create all entities
-    std::unordered_map<EntityID, EntityID> idMapping; // old ID -> new ID
-    // Keep track of roots that were instantiated from compact asset nodes (e.g., models).
-    // Their internal hierarchy should remain intact; skip child clearing/parent fixup for them.
-    std::unordered_set<EntityID> opaqueRoots;
-    
     // Pre-scan: map oldId -> parentOld and set of all model-asset entity ids
     std::unordered_map<EntityID, EntityID> oldToParent;
     std::unordered_set<EntityID> modelAssetIds;
-    for (const auto& ent : data["entities"]) {
+    for (const auto& ent : entities) {
         if (ent.contains("id") && ent.contains("parent")) {
             oldToParent[ ent["id"].get<EntityID>() ] = ent["parent"].get<EntityID>();
         }
@@ -1576,7 +1656,8 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
         }
     }
 
-    auto isDescendantOfModelAsset = [&](EntityID oldId) -> bool {
+    // True if any ancestor of 'oldId' (itself excluded) is a model asset root
+    auto underModelAsset = [&](EntityID oldId) -> bool {
         if (modelAssetIds.empty()) return false;
         EntityID cur = oldId;
         size_t guard = 0;
@@ -1599,267 +1680,207 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
         return hasMesh && !hasUserComp;
     };
 
-    for (const auto& entityData : data["entities"]) {
-        // Preserve names exactly as authored. Create with base name without suffixing.
-        EntityID newId = 0;
-        if (entityData.contains("name")) {
-            // If this entry is a descendant of a model asset root and looks like an original model node,
-            // skip creating it now to avoid duplicates. The importer will create the canonical node.
-            if (entityData.contains("id")) {
-                EntityID oldId = entityData["id"].get<EntityID>();
-                if (!entityData.contains("asset") && isDescendantOfModelAsset(oldId) && looksModelNode(entityData)) {
-                    std::cout << "[Skip] Model descendant original node id=" << oldId << " name=" << entityData["name"].get<std::string>() << std::endl;
-                    // Intentionally do not map this oldId so parenting that targets it will be detected as unresolved
-                    goto NEXT_ENTITY;
-                }
+    for (const auto& entityData : entities) {
+        SceneRecord rec;
+        rec.data = &entityData;
+        rec.hasId = entityData.contains("id");
+        if (rec.hasId) rec.oldId = entityData["id"].get<EntityID>();
+
+        if (!entityData.contains("name")) {
+            rec.kind = SceneRecord::Kind::Legacy;
+            out.push_back(std::move(rec));
+            continue;
+        }
+        // A descendant of a model asset root that looks like an original model node is
+        // skipped to avoid duplicates; the importer creates the canonical node. It stays
+        // unmapped so parenting that targets it is detected as unresolved.
+        if (rec.hasId && !entityData.contains("asset") && underModelAsset(rec.oldId) && looksModelNode(entityData)) {
+            std::cout << "[Skip] Model descendant original node id=" << rec.oldId << " name=" << entityData["name"].get<std::string>() << std::endl;
+            out.push_back(std::move(rec));
+            continue;
+        }
+        // Compact asset node: instantiate the model instead of a raw entity
+        if (entityData.contains("asset") && entityData["asset"].is_object()
+            && entityData["asset"].value("type", "") == std::string("model")) {
+            // Nested model-asset nodes are skipped to avoid duplicate instantiation
+            if (rec.hasId && underModelAsset(rec.oldId)) {
+                out.push_back(std::move(rec));
+                continue;
             }
-            // Handle compact asset node: instantiate model instead of raw entity
-            if (entityData.contains("asset") && entityData["asset"].is_object()) {
-                const auto& a = entityData["asset"];
-                std::string type = a.value("type", "");
-                if (type == "model") {
-                    // Skip nested model-asset nodes to avoid duplicate instantiation
-                    if (entityData.contains("id") && entityData.contains("parent")) {
-                        EntityID curParent = entityData["parent"].get<EntityID>();
-                        while (curParent != (EntityID)0 && curParent != (EntityID)-1) {
-                            if (modelAssetIds.count(curParent)) {
-                                // Parent (or ancestor) is a model asset root; skip this nested model node entirely
-                                goto NEXT_ENTITY; // continue outer loop
-                            }
-                            auto itp = oldToParent.find(curParent);
-                            if (itp == oldToParent.end()) break;
-                            curParent = itp->second;
-                        }
-                    }
-                    std::string p = a.value("path", "");
-                    // Use project-root relative virtual path; prefer cached .meta fast path if present
-                    std::string resolved = p;
-                    if (!resolved.empty() && !fs::exists(resolved)) {
-                        resolved = (Project::GetProjectDirectory() / p).string();
-                    }
-                    // Normalize slashes
-                    for (char& c : resolved) if (c=='\\') c = '/';
-                    // Register this model asset mapping so subsequent serialization/deserialization can resolve by GUID
-                    try {
-                        std::string gstr = a.value("guid", "");
-                        if (!gstr.empty()) {
-                            ClaymoreGUID g = ClaymoreGUID::FromString(gstr);
-                            if (!(g.high == 0 && g.low == 0)) {
-                                std::string v = p; for (char& ch : v) if (ch=='\\') ch = '/';
-                                AssetLibrary::Instance().RegisterAsset(AssetReference(g, 0, (int)AssetType::Mesh), AssetType::Mesh, v, v);
-                                if (!resolved.empty()) AssetLibrary::Instance().RegisterPathAlias(g, resolved);
-                            }
-                        }
-                    } catch(...) {}
-                    // Determine spawn position
-                    glm::vec3 pos(0.0f);
-                    if (entityData.contains("transform")) {
-                        auto t = entityData["transform"];
-                        if (t.contains("position")) pos = DeserializeVec3(t["position"]);
-                    }
-                    // Prefer sibling .meta (fast path)
-                    std::string metaTry = resolved;
-                    std::string ext = fs::path(resolved).extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext != ".meta") {
-                        fs::path rp(resolved);
-                        fs::path metaPath = rp.parent_path() / (rp.stem().string() + ".meta");
-                        if (fs::exists(metaPath)) metaTry = metaPath.string();
-                    }
-                    if (!metaTry.empty() && fs::path(metaTry).extension() == ".meta") {
-                        newId = scene.InstantiateModelFast(metaTry, pos);
-                        if (newId == (EntityID)0 || newId == (EntityID)-1) {
-                            // Fallback to slow path if fast path failed
-                            newId = scene.InstantiateModel(resolved, pos);
-                        }
-                    } else {
-                        newId = scene.InstantiateModel(resolved, pos);
-                    }
-                    if (newId != 0) {
-                        opaqueRoots.insert(newId);
-                        // Apply transform fully to the root entity
-                        if (auto* ed = scene.GetEntityData(newId)) {
-                            if (entityData.contains("name")) { ed->Name = entityData["name"].get<std::string>(); }
-                            if (entityData.contains("transform")) DeserializeTransform(entityData["transform"], ed->Transform);
-                            // Apply scripts on root if any
-                            if (entityData.contains("scripts")) DeserializeScripts(entityData["scripts"], ed->Scripts);
-                            if (entityData.contains("animator")) {
-                                if (!ed->AnimationPlayer) ed->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>();
-                                DeserializeAnimator(entityData["animator"], *ed->AnimationPlayer);
-                            }
-                            // Post-instantiate: if skeleton exists but BoneEntities unresolved, rebuild by name/path
-                            std::function<SkeletonComponent*(EntityID, EntityID&)> findSkel = [&](EntityID id, EntityID& out)->SkeletonComponent*{
-                                if (auto* d = scene.GetEntityData(id)) {
-                                    if (d->Skeleton) { out = id; return d->Skeleton.get(); }
-                                    for (EntityID c : d->Children) { if (auto* s = findSkel(c, out)) return s; }
-                                }
-                                return nullptr;
-                            };
-                            EntityID skelEntity = (EntityID)-1; if (auto* sk = findSkel(newId, skelEntity)) {
-                                bool needsRebind = sk->BoneEntities.size() != sk->InverseBindPoses.size();
-                                if (!needsRebind) {
-                                    for (const auto& id : sk->BoneEntities) { if (id == (EntityID)-1) { needsRebind = true; break; } }
-                                }
-                                if (needsRebind) {
-                                    std::unordered_map<std::string, EntityID> pathMap;
-                                    std::function<void(EntityID, const std::string&)> dfs = [&](EntityID id, const std::string& path){
-                                        if (auto* d = scene.GetEntityData(id)) {
-                                            pathMap[path] = id;
-                                            for (EntityID c : d->Children) if (auto* cd = scene.GetEntityData(c)) dfs(c, path.empty() ? cd->Name : (path + "/" + cd->Name));
-                                        }
-                                    };
-                                    if (auto* rd = scene.GetEntityData(newId)) dfs(newId, rd->Name);
-                                    const size_t n = sk->InverseBindPoses.size();
-                                    sk->BoneEntities.assign(n, (EntityID)-1);
-                                    // Build index->name list
-                                    std::vector<std::string> boneNames(n, std::string());
-                                    for (const auto& kv : sk->BoneNameToIndex) { int idx = kv.second; if (idx >= 0 && (size_t)idx < n) boneNames[(size_t)idx] = kv.first; }
-                                    for (size_t i = 0; i < n; ++i) {
-                                        const std::string& bname = boneNames[i];
-                                        if (bname.empty()) continue;
-                                        for (const auto& kv : pathMap) {
-                                            const std::string& full = kv.first; size_t s = full.find_last_of('/');
-                                            std::string last = (s == std::string::npos) ? full : full.substr(s+1);
-                                            if (last == bname) { sk->BoneEntities[i] = kv.second; break; }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    if (newId != 0 && entityData.contains("id")) {
-                        idMapping[entityData["id"].get<EntityID>()] = newId;
-                    }
-                    continue; // handled compact node
-                }
+            rec.kind = SceneRecord::Kind::Model;
+            // Use project-root relative virtual path; prefer cached .meta fast path if present
+            const std::string p = entityData["asset"].value("path", "");
+            std::string resolved = p;
+            std::error_code ec;
+            if (!resolved.empty() && !fs::exists(resolved, ec)) {
+                resolved = (Project::GetProjectDirectory() / p).string();
             }
-            // Create a temporary entity and immediately set the exact name
-            Entity temp = scene.CreateEntityExact(entityData["name"]);
-            newId = temp.GetID();
-            auto* ed = scene.GetEntityData(newId);
-            if (ed) ed->Name = entityData["name"]; // avoid auto-suffix pattern
-            try {
-                std::cout << "[Create] guid=" << ed->EntityGuid.ToString() << " name=" << ed->Name << " src=Deserialize" << std::endl;
-            } catch(...) {}
-            // Fill remaining fields by deserializing into this entity
-            // Reuse DeserializeEntity by overriding name to avoid creating a second entity
-            // We'll simulate by building a new json without name to skip creation
-            json copy = entityData;
-            copy.erase("name");
-            // Write id to ensure relationships mapping still works
-            // Then call DeserializeEntity on a synthetic structure that keeps properties
-            // but our DeserializeEntity currently always creates a new entity.
-            // Instead, manually apply properties here for the created entity:
-            if (copy.contains("layer")) ed->Layer = copy["layer"];
-            if (copy.contains("tag")) ed->Tag = copy["tag"];
-            if (copy.contains("parent")) ed->Parent = copy["parent"];
-            if (copy.contains("children")) {
-                ed->Children.clear();
-                for (const auto& child : copy["children"]) ed->Children.push_back(child.get<EntityID>());
+            // Normalize slashes
+            for (char& c : resolved) if (c=='\\') c = '/';
+            std::string ext = fs::path(resolved).extension().string();
+            std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+            if (ext == ".meta") {
+                rec.modelMeta = resolved;
+            } else if (!resolved.empty()) {
+                fs::path rp(resolved);
+                fs::path metaPath = rp.parent_path() / (rp.stem().string() + ".meta");
+                if (fs::exists(metaPath, ec)) rec.modelMeta = metaPath.string();
             }
-            // GUID & prefab source
-            if (copy.contains("guid")) {
-                try { copy.at("guid").get_to(ed->EntityGuid); } catch(...) {}
-            } else {
-                ed->EntityGuid = ClaymoreGUID::Generate();
+            rec.modelPath = std::move(resolved);
+            out.push_back(std::move(rec));
+            continue;
+        }
+        rec.kind = SceneRecord::Kind::Entity;
+        out.push_back(std::move(rec));
+    }
+}
+
+EntityID Serializer::InstantiateSceneModel(const SceneRecord& record, Scene& scene, const ImportedModel* imported) {
+    const json& entityData = *record.data;
+    const auto& a = entityData["asset"];
+    const std::string& resolved = record.modelPath;
+    // Register this model asset mapping so subsequent serialization/deserialization can resolve by GUID
+    try {
+        std::string gstr = a.value("guid", "");
+        if (!gstr.empty()) {
+            ClaymoreGUID g = ClaymoreGUID::FromString(gstr);
+            if (!(g.high == 0 && g.low == 0)) {
+                std::string v = a.value("path", ""); for (char& ch : v) if (ch=='\\') ch = '/';
+                AssetLibrary::Instance().RegisterAsset(AssetReference(g, 0, (int)AssetType::Mesh), AssetType::Mesh, v, v);
+                if (!resolved.empty()) AssetLibrary::Instance().RegisterPathAlias(g, resolved);
             }
-            if (copy.contains("prefabSource")) {
-                try { ed->PrefabSource = FileSystem::Normalize(copy.at("prefabSource").get<std::string>()); } catch(...) {}
+        }
+    } catch(...) {}
+    // Determine spawn position
+    glm::vec3 pos(0.0f);
+    if (entityData.contains("transform")) {
+        const auto& t = entityData["transform"];
+        if (t.contains("position")) pos = DeserializeVec3(t["position"]);
+    }
+    EntityID newId = 0;
+    if (imported) {
+        newId = scene.InstantiateImportedModel(*imported, resolved, pos);
+    } else if (!record.modelMeta.empty()) {
+        newId = scene.InstantiateModelFast(record.modelMeta, pos);
+        if (newId == (EntityID)0 || newId == (EntityID)-1) {
+            // Fallback to slow path if fast path failed
+            newId = scene.InstantiateModel(resolved, pos);
+        }
+    } else {
+        newId = scene.InstantiateModel(resolved, pos);
+    }
+    if (newId == 0) return newId;
+
+    // Apply transform fully to the root entity
+    if (auto* ed = scene.GetEntityData(newId)) {
+        if (entityData.contains("name")) { ed->Name = entityData["name"].get<std::string>(); }
+        if (entityData.contains("transform")) DeserializeTransform(entityData["transform"], ed->Transform);
+        // Apply scripts on root if any
+        if (entityData.contains("scripts")) DeserializeScripts(entityData["scripts"], ed->Scripts);
+        if (entityData.contains("animator")) {
+            if (!ed->AnimationPlayer) ed->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>();
+            DeserializeAnimator(entityData["animator"], *ed->AnimationPlayer);
+        }
+        // Post-instantiate: if skeleton exists but BoneEntities unresolved, rebuild by name/path
+        std::function<SkeletonComponent*(EntityID, EntityID&)> findSkel = [&](EntityID id, EntityID& out)->SkeletonComponent*{
+            if (auto* d = scene.GetEntityData(id)) {
+                if (d->Skeleton) { out = id; return d->Skeleton.get(); }
+                for (EntityID c : d->Children) { if (auto* s = findSkel(c, out)) return s; }
             }
-            if (copy.contains("transform")) DeserializeTransform(copy["transform"], ed->Transform);
-            if (copy.contains("mesh")) { ed->Mesh = std::make_unique<MeshComponent>(); DeserializeMesh(copy["mesh"], *ed->Mesh); }
-            if (copy.contains("light")) { ed->Light = std::make_unique<LightComponent>(); DeserializeLight(copy["light"], *ed->Light); }
-            if (copy.contains("collider")) { ed->Collider = std::make_unique<ColliderComponent>(); DeserializeCollider(copy["collider"], *ed->Collider); }
-            if (copy.contains("rigidbody")) { ed->RigidBody = std::make_unique<RigidBodyComponent>(); DeserializeRigidBody(copy["rigidbody"], *ed->RigidBody); }
-            if (copy.contains("staticbody")) { ed->StaticBody = std::make_unique<StaticBodyComponent>(); DeserializeStaticBody(copy["staticbody"], *ed->StaticBody); }
-            if (copy.contains("camera")) { ed->Camera = std::make_unique<CameraComponent>(); DeserializeCamera(copy["camera"], *ed->Camera); }
-            if (copy.contains("terrain")) { ed->Terrain = std::make_unique<TerrainComponent>(); DeserializeTerrain(copy["terrain"], *ed->Terrain); }
-            if (copy.contains("emitter")) { ed->Emitter = std::make_unique<ParticleEmitterComponent>(); DeserializeParticleEmitter(copy["emitter"], *ed->Emitter); }
-            if (copy.contains("canvas")) { ed->Canvas = std::make_unique<CanvasComponent>(); DeserializeCanvas(copy["canvas"], *ed->Canvas); }
-            if (copy.contains("panel")) { ed->Panel = std::make_unique<PanelComponent>(); DeserializePanel(copy["panel"], *ed->Panel); }
-            if (copy.contains("button")) { ed->Button = std::make_unique<ButtonComponent>(); DeserializeButton(copy["button"], *ed->Button); }
-            if (copy.contains("scripts")) { DeserializeScripts(copy["scripts"], ed->Scripts); }
-            // Preserve unknown fields
-            try {
-                static const std::unordered_set<std::string> kKnown = {
-                    "id","name","layer","tag","parent","children","guid","prefabSource",
-                    "transform","mesh","light","collider","rigidbody","staticbody","camera",
-                    "terrain","emitter","canvas","panel","button","scripts","animator","asset",
-                    "skeleton","skinning"
+            return nullptr;
+        };
+        EntityID skelEntity = (EntityID)-1; if (auto* sk = findSkel(newId, skelEntity)) {
+            bool needsRebind = sk->BoneEntities.size() != sk->InverseBindPoses.size();
+            if (!needsRebind) {
+                for (const auto& id : sk->BoneEntities) { if (id == (EntityID)-1) { needsRebind = true; break; } }
+            }
+            if (needsRebind) {
+                std::unordered_map<std::string, EntityID> pathMap;
+                std::function<void(EntityID, const std::string&)> dfs = [&](EntityID id, const std::string& path){
+                    if (auto* d = scene.GetEntityData(id)) {
+                        pathMap[path] = id;
+                        for (EntityID c : d->Children) if (auto* cd = scene.GetEntityData(c)) dfs(c, path.empty() ? cd->Name : (path + "/" + cd->Name));
+                    }
                 };
-                ed->Extra = nlohmann::json::object();
-                for (auto it = entityData.begin(); it != entityData.end(); ++it) {
-                    if (kKnown.find(it.key()) == kKnown.end()) {
-                        ed->Extra[it.key()] = it.value();
+                if (auto* rd = scene.GetEntityData(newId)) dfs(newId, rd->Name);
+                const size_t n = sk->InverseBindPoses.size();
+                sk->BoneEntities.assign(n, (EntityID)-1);
+                // Build index->name list
+                std::vector<std::string> boneNames(n, std::string());
+                for (const auto& kv : sk->BoneNameToIndex) { int idx = kv.second; if (idx >= 0 && (size_t)idx < n) boneNames[(size_t)idx] = kv.first; }
+                for (size_t i = 0; i < n; ++i) {
+                    const std::string& bname = boneNames[i];
+                    if (bname.empty()) continue;
+                    for (const auto& kv : pathMap) {
+                        const std::string& full = kv.first; size_t s = full.find_last_of('/');
+                        std::string last = (s == std::string::npos) ? full : full.substr(s+1);
+                        if (last == bname) { sk->BoneEntities[i] = kv.second; break; }
                     }
                 }
-            } catch(...) {}
-        } else {
-            newId = DeserializeEntity(entityData, scene);
-        }
-        if (newId != 0 && entityData.contains("id")) {
-            EntityID oldId = entityData["id"];
-            idMapping[oldId] = newId;
-        }
-        NEXT_ENTITY: ;
-    }
-
-    // Parallelize component population for non-opaque roots (safe, no bgfx calls here)
-    if (!idMapping.empty()) {
-        std::vector<const json*> work;
-        work.reserve(idMapping.size());
-        for (const auto& entityData : data["entities"]) {
-            if (!entityData.contains("id")) continue;
-            EntityID oldId = entityData["id"].get<EntityID>();
-            auto it = idMapping.find(oldId);
-            if (it == idMapping.end()) continue;
-            EntityID nid = it->second;
-            if (opaqueRoots.find(nid) != opaqueRoots.end()) continue; // skip compact model asset roots
-            // Also skip if this JSON node was a compact model node (handled already)
-            if (entityData.contains("asset") && entityData["asset"].is_object()) continue;
-            work.push_back(&entityData);
-        }
-        if (!work.empty()) {
-            auto& js = Jobs();
-            const size_t chunk = 32;
-            parallel_for(js, size_t(0), work.size(), chunk, [&](size_t s, size_t c){
-                for (size_t off = 0; off < c; ++off) {
-                    const json& entityData = *work[s + off];
-                    EntityID oldId = entityData.value("id", (EntityID)0);
-                    auto it = idMapping.find(oldId); if (it == idMapping.end()) continue;
-                    EntityID nid = it->second;
-                    auto* ed = scene.GetEntityData(nid); if (!ed) continue;
-                    // Transform
-                    if (entityData.contains("transform")) { DeserializeTransform(entityData["transform"], ed->Transform); }
-                    // Component shells + JSON decode (no GPU work)
-                    if (entityData.contains("mesh")) { if (!ed->Mesh) ed->Mesh = std::make_unique<MeshComponent>(); DeserializeMesh(entityData["mesh"], *ed->Mesh); }
-                    if (entityData.contains("light")) { if (!ed->Light) ed->Light = std::make_unique<LightComponent>(); DeserializeLight(entityData["light"], *ed->Light); }
-                    if (entityData.contains("collider")) { if (!ed->Collider) ed->Collider = std::make_unique<ColliderComponent>(); DeserializeCollider(entityData["collider"], *ed->Collider); }
-                    if (entityData.contains("rigidbody")) { if (!ed->RigidBody) ed->RigidBody = std::make_unique<RigidBodyComponent>(); DeserializeRigidBody(entityData["rigidbody"], *ed->RigidBody); }
-                    if (entityData.contains("staticbody")) { if (!ed->StaticBody) ed->StaticBody = std::make_unique<StaticBodyComponent>(); DeserializeStaticBody(entityData["staticbody"], *ed->StaticBody); }
-                    if (entityData.contains("camera")) { if (!ed->Camera) ed->Camera = std::make_unique<CameraComponent>(); DeserializeCamera(entityData["camera"], *ed->Camera); }
-                    if (entityData.contains("terrain")) { if (!ed->Terrain) ed->Terrain = std::make_unique<TerrainComponent>(); DeserializeTerrain(entityData["terrain"], *ed->Terrain); }
-                    if (entityData.contains("emitter")) { if (!ed->Emitter) ed->Emitter = std::make_unique<ParticleEmitterComponent>(); DeserializeParticleEmitter(entityData["emitter"], *ed->Emitter); }
-                    if (entityData.contains("canvas")) { if (!ed->Canvas) ed->Canvas = std::make_unique<CanvasComponent>(); DeserializeCanvas(entityData["canvas"], *ed->Canvas); }
-                    if (entityData.contains("panel")) { if (!ed->Panel) ed->Panel = std::make_unique<PanelComponent>(); DeserializePanel(entityData["panel"], *ed->Panel); }
-                    if (entityData.contains("button")) { if (!ed->Button) ed->Button = std::make_unique<ButtonComponent>(); DeserializeButton(entityData["button"], *ed->Button); }
-                    // Navigation components
-                    if (entityData.contains("navmesh")) { if (!ed->Navigation) ed->Navigation = std::make_unique<nav::NavMeshComponent>(); DeserializeNavMesh(entityData["navmesh"], *ed->Navigation); }
-                    if (entityData.contains("navagent")) { if (!ed->NavAgent) ed->NavAgent = std::make_unique<nav::NavAgentComponent>(); DeserializeNavAgent(entityData["navagent"], *ed->NavAgent); }
-                    if (entityData.contains("scripts")) { DeserializeScripts(entityData["scripts"], ed->Scripts); }
-                    if (entityData.contains("animator")) { if (!ed->AnimationPlayer) ed->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>(); DeserializeAnimator(entityData["animator"], *ed->AnimationPlayer); }
-                    if (entityData.contains("skeleton")) { if (!ed->Skeleton) ed->Skeleton = std::make_unique<SkeletonComponent>(); DeserializeSkeleton(entityData["skeleton"], *ed->Skeleton); }
-                    if (entityData.contains("skinning")) { if (!ed->Skinning) ed->Skinning = std::make_unique<SkinningComponent>(); DeserializeSkinning(entityData["skinning"], *ed->Skinning); }
-                }
-            });
+            }
         }
     }
+    return newId;
+}
 
+void Serializer::DeserializeEntityFields(const json& data, EntityData& ed) {
+    if (data.contains("layer")) ed.Layer = data["layer"];
+    if (data.contains("tag")) ed.Tag = data["tag"];
+    // GUID & prefab source
+    if (data.contains("guid")) {
+        try { data.at("guid").get_to(ed.EntityGuid); } catch(...) {}
+    } else {
+        ed.EntityGuid = ClaymoreGUID::Generate();
+    }
+    if (data.contains("prefabSource")) {
+        try { ed.PrefabSource = FileSystem::Normalize(data.at("prefabSource").get<std::string>()); } catch(...) {}
+    }
+    // Preserve unknown fields
+    try {
+        static const std::unordered_set<std::string> kKnown = {
+            "id","name","layer","tag","parent","children","guid","prefabSource",
+            "transform","mesh","light","collider","rigidbody","staticbody","camera",
+            "terrain","emitter","canvas","panel","button","scripts","animator","asset",
+            "skeleton","skinning"
+        };
+        ed.Extra = nlohmann::json::object();
+        for (auto it = data.begin(); it != data.end(); ++it) {
+            if (kKnown.find(it.key()) == kKnown.end()) {
+                ed.Extra[it.key()] = it.value();
+            }
+        }
+    } catch(...) {}
+}
+
+void Serializer::DeserializeEntityComponents(const json& entityData, EntityData& entity) {
+    EntityData* ed = &entity;
+    if (entityData.contains("transform")) { DeserializeTransform(entityData["transform"], ed->Transform); }
+    if (entityData.contains("light")) { if (!ed->Light) ed->Light = std::make_unique<LightComponent>(); DeserializeLight(entityData["light"], *ed->Light); }
+    if (entityData.contains("collider")) { if (!ed->Collider) ed->Collider = std::make_unique<ColliderComponent>(); DeserializeCollider(entityData["collider"], *ed->Collider); }
+    if (entityData.contains("rigidbody")) { if (!ed->RigidBody) ed->RigidBody = std::make_unique<RigidBodyComponent>(); DeserializeRigidBody(entityData["rigidbody"], *ed->RigidBody); }
+    if (entityData.contains("staticbody")) { if (!ed->StaticBody) ed->StaticBody = std::make_unique<StaticBodyComponent>(); DeserializeStaticBody(entityData["staticbody"], *ed->StaticBody); }
+    if (entityData.contains("camera")) { if (!ed->Camera) ed->Camera = std::make_unique<CameraComponent>(); DeserializeCamera(entityData["camera"], *ed->Camera); }
+    if (entityData.contains("terrain")) { if (!ed->Terrain) ed->Terrain = std::make_unique<TerrainComponent>(); DeserializeTerrain(entityData["terrain"], *ed->Terrain); }
+    if (entityData.contains("emitter")) { if (!ed->Emitter) ed->Emitter = std::make_unique<ParticleEmitterComponent>(); DeserializeParticleEmitter(entityData["emitter"], *ed->Emitter); }
+    if (entityData.contains("canvas")) { if (!ed->Canvas) ed->Canvas = std::make_unique<CanvasComponent>(); DeserializeCanvas(entityData["canvas"], *ed->Canvas); }
+    if (entityData.contains("panel")) { if (!ed->Panel) ed->Panel = std::make_unique<PanelComponent>(); DeserializePanel(entityData["panel"], *ed->Panel); }
+    if (entityData.contains("button")) { if (!ed->Button) ed->Button = std::make_unique<ButtonComponent>(); DeserializeButton(entityData["button"], *ed->Button); }
+    // Navigation components
+    if (entityData.contains("navmesh")) { if (!ed->Navigation) ed->Navigation = std::make_unique<nav::NavMeshComponent>(); DeserializeNavMesh(entityData["navmesh"], *ed->Navigation); }
+    if (entityData.contains("navagent")) { if (!ed->NavAgent) ed->NavAgent = std::make_unique<nav::NavAgentComponent>(); DeserializeNavAgent(entityData["navagent"], *ed->NavAgent); }
+    if (entityData.contains("animator")) { if (!ed->AnimationPlayer) ed->AnimationPlayer = std::make_unique<cm::animation::AnimationPlayerComponent>(); DeserializeAnimator(entityData["animator"], *ed->AnimationPlayer); }
+    if (entityData.contains("skeleton")) { if (!ed->Skeleton) ed->Skeleton = std::make_unique<SkeletonComponent>(); DeserializeSkeleton(entityData["skeleton"], *ed->Skeleton); }
+    if (entityData.contains("skinning")) { if (!ed->Skinning) ed->Skinning = std::make_unique<SkinningComponent>(); DeserializeSkinning(entityData["skinning"], *ed->Skinning); }
+}
+
+void Serializer::FinishSceneLoad(const json& data, Scene& scene, const std::unordered_map<EntityID, EntityID>& idMapping,
+                                 const std::unordered_set<EntityID>& opaqueRoots, bool additive) {
     // Reset children vectors to avoid duplicates for non-opaque roots, then fix up parent-child relationships
     for (const auto& [oldId, newId] : idMapping) {
         if (opaqueRoots.find(newId) != opaqueRoots.end()) continue;
         if (auto* ed = scene.GetEntityData(newId)) ed->Children.clear();
     }
+    scene.InvalidateHierarchy();
     // Second pass: Fix up parent-child relationships (skip opaque roots that already have a hierarchy)
     for (const auto& entityData : data["entities"]) {
         if (entityData.contains("id") && entityData.contains("parent")) {
@@ -2001,7 +2022,7 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
                 if (target != (EntityID)-1) {
                     // Apply override to the matched existing child
                     auto* td = scene.GetEntityData(target); if (!td) continue;
-                    if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); td->Transform.TransformDirty = true; }
+                    if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); scene.MarkTransformDirty(target); }
                     if (childOverride.contains("camera")) { if (!td->Camera) td->Camera = std::make_unique<CameraComponent>(); DeserializeCamera(childOverride["camera"], *td->Camera); }
                     if (childOverride.contains("light")) { if (!td->Light) td->Light = std::make_unique<LightComponent>(); DeserializeLight(childOverride["light"], *td->Light); }
                     if (childOverride.contains("collider")) { if (!td->Collider) td->Collider = std::make_unique<ColliderComponent>(); DeserializeCollider(childOverride["collider"], *td->Collider); }
@@ -2029,7 +2050,7 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
 
             // Apply overrides to existing node
             auto* td = scene.GetEntityData(target); if (!td) continue;
-            if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); td->Transform.TransformDirty = true; }
+            if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); scene.MarkTransformDirty(target); }
             if (childOverride.contains("mesh")) {
                 if (!td->Mesh) td->Mesh = std::make_unique<MeshComponent>();
                 DeserializeMesh(childOverride["mesh"], *td->Mesh);
@@ -2090,8 +2111,14 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
     }
 
     // Ensure transforms are dirty and updated after load
-    for (const auto& entity : scene.GetEntities()) {
-        scene.MarkTransformDirty(entity.GetID());
+    if (additive) {
+        for (const auto& [oldId, newId] : idMapping) {
+            if (newId != (EntityID)0 && newId != (EntityID)-1) scene.MarkTransformDirty(newId);
+        }
+    } else {
+        for (const auto& entity : scene.GetEntities()) {
+            scene.MarkTransformDirty(entity.GetID());
+        }
     }
     scene.UpdateTransforms();
 
@@ -2133,9 +2160,14 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
         std::unordered_map<std::string, EntityID> signatureToEntity;
         std::vector<EntityID> entitiesToRemove;
 
+        // An additive load leaves the entities that were already there alone
+        std::unordered_set<EntityID> loadedIds;
+        if (additive) for (const auto& [oldId, newId] : idMapping) loadedIds.insert(newId);
+
         for (const auto& e : scene.GetEntities()) {
             EntityID id = e.GetID();
             if (protectedIds.count(id)) continue; // never dedup model-instantiated hierarchies
+            if (additive && !loadedIds.count(id)) continue;
             auto* d = scene.GetEntityData(id);
             if (!d) continue;
 
@@ -2196,26 +2228,13 @@ bool Serializer::DeserializeScene(const json& data, Scene& scene) {
         }
         std::cout << "[DeserializeEnd] entities=" << scene.GetEntities().size() << std::endl;
     } catch(...) {}
-
-    return true;
 }
 
-bool Serializer::SaveSceneToFile(Scene& scene, const std::string& filepath) {
+
+bool Serializer::SaveSceneToFile(Scene& scene, const std::string& filepath, SceneFormat format) {
     try {
         json sceneData = SerializeScene(scene);
-        
-        // Ensure directory exists
-        fs::path path(filepath);
-        fs::create_directories(path.parent_path());
-        
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "[Serializer] Failed to open file for writing: " << filepath << std::endl;
-            return false;
-        }
-        
-        file << sceneData.dump(4); // Pretty print with 4 spaces
-        file.close();
+        if (!WriteSceneFile(sceneData, filepath, format)) return false;
         
         std::cout << "[Serializer] Scene saved to: " << filepath << std::endl;
         // Clear editor dirty flag on successful save
@@ -2228,24 +2247,74 @@ bool Serializer::SaveSceneToFile(Scene& scene, const std::string& filepath) {
     }
 }
 
-bool Serializer::LoadSceneFromFile(const std::string& filepath, Scene& scene) {
+bool Serializer::WriteSceneFile(const json& document, const std::string& filepath, SceneFormat format) {
+    // Ensure directory exists
+    fs::path path(filepath);
+    std::error_code ec;
+    if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[Serializer] Failed to open file for writing: " << filepath << std::endl;
+        return false;
+    }
+    if (format == SceneFormat::Binary) {
+        std::vector<uint8_t> bytes;
+        std::string error;
+        if (!scenebin::Encode(document, bytes, &error)) {
+            std::cerr << "[Serializer] Cannot encode " << filepath << " as binary: " << error << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+    } else {
+        file << document.dump(4); // Pretty print with 4 spaces
+    }
+    return bool(file);
+}
+
+bool Serializer::ReadSceneFile(const std::string& filepath, json& out) {
     try {
-        json sceneData;
-        // Virtual filesystem first; no direct OS reads for runtime
-        {
-            std::string sceneText;
-            if (FileSystem::Instance().ReadTextFile(filepath, sceneText)) {
-                sceneData = json::parse(sceneText);
-            } else {
-                std::vector<uint8_t> bytes;
-                if (FileSystem::Instance().ReadFile(filepath, bytes)) {
-                    sceneData = json::parse(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
-                } else {
-                    std::cerr << "[Serializer] Scene file does not exist or cannot be read: " << filepath << std::endl;
-                    return false;
-                }
+        // Virtual filesystem first; no direct OS reads for runtime. Stored pak entries
+        // are decoded in place, without a copy.
+        std::vector<uint8_t> bytes;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        if (!FileSystem::Instance().ReadFileView(filepath, data, size)) {
+            if (!FileSystem::Instance().ReadFile(filepath, bytes)) {
+                std::cerr << "[Serializer] Scene file does not exist or cannot be read: " << filepath << std::endl;
+                return false;
             }
+            data = bytes.data();
+            size = bytes.size();
+        }
+        if (scenebin::IsSceneBinary(data, size)) {
+            std::string error;
+            if (scenebin::Decode(data, size, out, &error)) return true;
+            std::cerr << "[Serializer] Error decoding scene " << filepath << ": " << error << std::endl;
+            return false;
         }
+        out = json::parse(data, data + size);
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[Serializer] Error parsing scene " << filepath << ": " << e.what() << std::endl;
+    }
+    return false;
+}
+
+bool Serializer::ConvertSceneFile(const std::string& filepath, const std::string& outPath, SceneFormat format) {
+    json document;
+    if (!ReadSceneFile(filepath, document)) return false;
+    if (!WriteSceneFile(document, outPath, format)) return false;
+    std::cout << "[Serializer] Converted " << filepath << " -> " << outPath
+              << (format == SceneFormat::Binary ? " (binary)" : " (json)") << std::endl;
+    return true;
+}
+
+bool Serializer::LoadSceneFromFile(const std::string& filepath, Scene& scene) {
+    try {
+        json sceneData;
+        if (!ReadSceneFile(filepath, sceneData)) return false;
         const std::string version = sceneData.value("version", "");
         std::cout << "[SceneLoad] Version=" << version << " Entities=" << (sceneData.contains("entities") ? sceneData["entities"].size() : 0) << std::endl;
         
@@ -2412,18 +2481,7 @@ bool Serializer::SavePrefabToFile(const EntityData& entityData, Scene& scene, co
 bool Serializer::LoadPrefabFromFile(const std::string& filepath, EntityData& entityData, Scene& scene) {
     try {
         json prefabData;
-        std::string text;
-        if (FileSystem::Instance().ReadTextFile(filepath, text)) {
-            prefabData = json::parse(text);
-        } else {
-            std::vector<uint8_t> bytes;
-            if (FileSystem::Instance().ReadFile(filepath, bytes)) {
-                prefabData = json::parse(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
-            } else {
-                std::cerr << "[Serializer] Prefab file does not exist or cannot be read: " << filepath << std::endl;
-                return false;
-            }
-        }
+        if (!ReadSceneFile(filepath, prefabData)) return false;
         
         bool success = DeserializePrefab(prefabData, entityData, scene);
         if (success) {
@@ -2556,18 +2614,7 @@ bool Serializer::SavePrefabSubtreeToFile(Scene& scene, EntityID rootId, const st
 EntityID Serializer::LoadPrefabToScene(const std::string& filepath, Scene& scene) {
     try {
         json data;
-        std::string text;
-        if (FileSystem::Instance().ReadTextFile(filepath, text)) {
-            data = json::parse(text);
-        } else {
-            std::vector<uint8_t> bytes;
-            if (FileSystem::Instance().ReadFile(filepath, bytes)) {
-                data = json::parse(std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
-            } else {
-                std::cerr << "[Serializer] Prefab file does not exist or cannot be read: " << filepath << std::endl;
-                return (EntityID)-1;
-            }
-        }
+        if (!ReadSceneFile(filepath, data)) return (EntityID)-1;
         // Support both legacy and subtree formats
         if (data.contains("entities") && data["entities"].is_array()) {
             // Subtree format: instantiate compact asset nodes (models) and create pure-serialized nodes; then apply overrides.
@@ -2743,7 +2790,7 @@ EntityID Serializer::LoadPrefabToScene(const std::string& filepath, Scene& scene
                     }
                     if (target == (EntityID)-1) continue;
                     auto* td = scene.GetEntityData(target); if (!td) continue;
-                    if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); td->Transform.TransformDirty = true; }
+                    if (childOverride.contains("transform")) { DeserializeTransform(childOverride["transform"], td->Transform); scene.MarkTransformDirty(target); }
                     if (childOverride.contains("mesh")) {
                         if (!td->Mesh) td->Mesh = std::make_unique<MeshComponent>();
                         ClaymoreGUID meshGuid{}; int fileId = 0; ClaymoreGUID skelGuid{};
@@ -1,6 +1,9 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "ecs/Scene.h"
 #include "ecs/Entity.h"
@@ -13,14 +16,52 @@ using json = nlohmann::json;
 
 // Forward declarations to avoid heavy includes
 namespace cm { namespace animation { struct AnimationPlayerComponent; } }
+struct ImportedModel;
  
 class Serializer {
 public:
+    // On-disk encoding of scene and prefab documents (see SceneBinary.h). Readers accept both.
+    enum class SceneFormat { Json, Binary };
+
     // Scene serialization 
     static json SerializeScene(Scene& scene);
     static bool DeserializeScene(const json& data, Scene& scene);
-    static bool SaveSceneToFile(Scene& scene, const std::string& filepath);
+    static bool SaveSceneToFile(Scene& scene, const std::string& filepath, SceneFormat format = SceneFormat::Json);
     static bool LoadSceneFromFile(const std::string& filepath, Scene& scene);
+    // Reads a scene or prefab document, JSON or binary, through the virtual filesystem.
+    // Safe off the main thread.
+    static bool ReadSceneFile(const std::string& filepath, json& out);
+    static bool WriteSceneFile(const json& document, const std::string& filepath, SceneFormat format);
+    // Re-encodes a scene or prefab file; 'filepath' and 'outPath' may be the same
+    static bool ConvertSceneFile(const std::string& filepath, const std::string& outPath, SceneFormat format);
+
+    // Scene loading stages. DeserializeScene runs them back to back; SceneLoader runs the
+    // pure ones (plan, fields, components) on a worker and commits the rest over several frames.
+    struct SceneRecord {
+        enum class Kind { Skip, Model, Entity, Legacy };
+        Kind kind = Kind::Skip;
+        const json* data = nullptr;   // the record in data["entities"]
+        bool hasId = false;
+        EntityID oldId = 0;
+        std::string modelPath;        // Model: resolved source path
+        std::string modelMeta;        // Model: sibling .meta for the cached fast path, if any
+    };
+    // What each record of data["entities"] becomes, in file order. Pure.
+    static void PlanSceneEntities(const json& data, std::vector<SceneRecord>& out);
+    // Entity/component counts and GUID sanity, logged before anything is created. Pure.
+    static void LogSceneSummary(const json& data);
+    // Registers the scene's asset map; a non-additive load also takes its shader preset and environment
+    static void ApplySceneSettings(const json& data, Scene& scene, bool additive);
+    // Instantiates a Model record (from 'imported' when given, else from the model cache or source)
+    static EntityID InstantiateSceneModel(const SceneRecord& record, Scene& scene, const ImportedModel* imported = nullptr);
+    // Layer, tag, GUID, prefab source and unknown fields of an Entity record. Pure.
+    static void DeserializeEntityFields(const json& data, EntityData& entity);
+    // Every component that only decodes JSON, i.e. all but mesh and scripts. Pure.
+    static void DeserializeEntityComponents(const json& data, EntityData& entity);
+    // Parent links, per-node overrides under model roots, transforms and duplicate cleanup.
+    // 'idMapping' maps file ids to created entities; an additive load only touches those.
+    static void FinishSceneLoad(const json& data, Scene& scene, const std::unordered_map<EntityID, EntityID>& idMapping,
+                                const std::unordered_set<EntityID>& opaqueRoots, bool additive);
 
     // Legacy prefab serialization (deprecated) — kept temporarily for backward compatibility only
     static json SerializePrefab(const EntityData& entityData, Scene& scene);
@@ -28,6 +28,7 @@
 #include "imnodes.h"
 #include <editor/Input.h>
 #include "serialization/Serializer.h"
+#include "serialization/SceneLoader.h"
 #include <ImGuizmo.h>
 #include <navigation/NavDebugDraw.h>
 #include "panels/PrefabEditorPanel.h"
@@ -688,15 +689,19 @@ void UILayer::BeginDockspace() {
                     if (!isDefault) continue;
                     // carry over albedo texture and tint if available
                     bgfx::TextureHandle albedo = BGFX_INVALID_HANDLE;
+                    std::string albedoPath;
                     glm::vec4 tint(1,1,1,1);
                     if (auto pbr = std::dynamic_pointer_cast<PBRMaterial>(mat)) {
-                        albedo = pbr->m_AlbedoTex;
+                        albedo = pbr->GetAlbedoTexture();
+                        albedoPath = pbr->GetAlbedoPath();
                         mat->TryGetUniform("u_ColorTint", tint);
                     }
                     std::shared_ptr<Material> newMat = skinned ? MaterialManager::Instance().CreateSceneSkinnedDefaultMaterial(&s)
                                                                : MaterialManager::Instance().CreateSceneDefaultMaterial(&s);
                     if (auto npbr = std::dynamic_pointer_cast<PBRMaterial>(newMat)) {
-                        if (bgfx::isValid(albedo)) npbr->SetAlbedoTexture(albedo);
+                        // Streamed textures are re-requested so the new material keeps following its tiers
+                        if (!albedoPath.empty()) npbr->SetAlbedoTextureFromPath(albedoPath);
+                        else if (bgfx::isValid(albedo)) npbr->SetAlbedoTexture(albedo);
                     }
                     newMat->SetUniform("u_ColorTint", tint);
                     d->Mesh->material = newMat;
@@ -844,25 +849,48 @@ void UILayer::DeferSceneLoad(const std::string& filepath) {
 
 void UILayer::ProcessDeferredSceneLoad() {
     if (!m_HasDeferredSceneLoad) return;
+    m_HasDeferredSceneLoad = false;
+
+    // A newer request replaces one still in flight
+    if (m_SceneLoadHandle != SceneLoader::kInvalidHandle) SceneLoader::Instance().Cancel(m_SceneLoadHandle);
 
     std::cout << "[UILayer] Processing deferred scene load: " << m_DeferredScenePath << std::endl;
-    if (Serializer::LoadSceneFromFile(m_DeferredScenePath, m_Scene)) {
-        std::cout << "[UILayer] Successfully loaded scene: " << m_DeferredScenePath << std::endl;
-        m_SelectedEntity = -1;
-        m_CurrentScenePath = m_DeferredScenePath;
-        // Reset viewport camera and interaction state after reload to ensure gizmo can capture input
-        m_ViewportPanel.ClearPickRequest();
-    } else {
-        std::cerr << "[UILayer] Failed to load scene: " << m_DeferredScenePath << std::endl;
-    }
-    m_HasDeferredSceneLoad = false;
+    // Entities are about to be replaced; don't keep pointing at one
+    m_SelectedEntity = -1;
+
+    SceneLoadOptions options;
+    options.onProgress = [this](const SceneLoadProgress& progress) {
+        m_BlockingOverlayProgress = progress.fraction;
+    };
+    const std::string path = m_DeferredScenePath;
+    options.onComplete = [this, path](bool ok) {
+        if (ok) {
+            std::cout << "[UILayer] Successfully loaded scene: " << path << std::endl;
+            m_SelectedEntity = -1;
+            m_CurrentScenePath = path;
+            // Reset viewport camera and interaction state after reload to ensure gizmo can capture input
+            m_ViewportPanel.ClearPickRequest();
+        } else {
+            std::cerr << "[UILayer] Failed to load scene: " << path << std::endl;
+        }
+        // A cancelled load's overlay belongs to the load replacing it
+        if (m_SceneLoadHandle != SceneLoader::kInvalidHandle && !SceneLoader::Instance().IsLoading(m_SceneLoadHandle)) {
+            m_SceneLoadHandle = SceneLoader::kInvalidHandle;
+            EndBlockingOverlay();
+        }
+    };
+    m_SceneLoadHandle = SceneLoader::Instance().LoadAsync(path, m_Scene, std::move(options));
     m_DeferredScenePath.clear();
-    EndBlockingOverlay();
+    if (m_SceneLoadHandle == SceneLoader::kInvalidHandle) {
+        std::cerr << "[UILayer] Failed to load scene: " << path << std::endl;
+        EndBlockingOverlay();
+    }
 }
 
 void UILayer::BeginBlockingOverlay(const std::string& label) {
     m_BlockingOverlayActive = true;
     m_BlockingOverlayLabel = label;
+    m_BlockingOverlayProgress = -1.0f;
 }
 
 void UILayer::EndBlockingOverlay() {
@@ -889,9 +917,13 @@ void UILayer::RenderBlockingOverlay() {
     ImGui::BeginChild("##LoadingBox", box, true, ImGuiWindowFlags_NoScrollbar);
     ImGui::Text("%s", m_BlockingOverlayLabel.empty()? "Loading..." : m_BlockingOverlayLabel.c_str());
     ImGui::Separator();
-    // Indeterminate bar alternative
-    static float t = 0.0f; t += 0.02f; if (t > 1.0f) t = 0.0f;
-    ImGui::ProgressBar(t, ImVec2(-1, 0));
+    if (m_BlockingOverlayProgress >= 0.0f) {
+        ImGui::ProgressBar(m_BlockingOverlayProgress, ImVec2(-1, 0));
+    } else {
+        // Indeterminate bar alternative
+        static float t = 0.0f; t += 0.02f; if (t > 1.0f) t = 0.0f;
+        ImGui::ProgressBar(t, ImVec2(-1, 0));
+    }
     ImGui::EndChild();
     ImGui::End();
     ImGui::PopStyleColor();
@@ -911,6 +943,7 @@ void UILayer::ProcessBeginPlayAsync() {
     scene.m_RuntimeScene = scene.RuntimeClone();
     if (scene.m_RuntimeScene) {
         scene.m_RuntimeScene->m_IsPlaying = true;
+        Physics::ResetFixedStep();
         TogglePlayMode();
     }
     EndBlockingOverlay();
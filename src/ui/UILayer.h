@@ -116,6 +116,7 @@ private:
     // Overlay state
     bool m_BlockingOverlayActive = false;
     std::string m_BlockingOverlayLabel;
+    float m_BlockingOverlayProgress = -1.0f; // < 0: indeterminate
     // Async play toggle state
     bool m_BeginPlayRequested = false;
 
@@ -138,5 +139,6 @@ private:
     // Deferred load
     bool m_HasDeferredSceneLoad = false;
     std::string m_DeferredScenePath;
+    uint32_t m_SceneLoadHandle = 0; // SceneLoader handle of the load in flight
     std::string m_CurrentScenePath;
 };
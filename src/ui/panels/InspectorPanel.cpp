@@ -9,6 +9,7 @@
 #include "scripting/ScriptReflection.h"
 #include "ecs/EntityData.h"
 #include "ecs/ComponentUtils.h"
+#include "ecs/Archetype.h"
 #include "rendering/PBRMaterial.h"
 #include "rendering/MaterialManager.h"
 #include "rendering/MaterialAsset.h"
@@ -416,6 +417,11 @@ void InspectorPanel::ShowAnimatorStateProperties(const std::string& stateName,
 void InspectorPanel::DrawComponents(EntityID entity) {
     auto* data = m_Context->GetEntityData(entity);
     if (!data) return;
+    // Adds/removes below write the members directly; the scene must hear about them here,
+    // since it may never run Update (prefab editor) and scripts/IK are not in the mask
+    const ComponentMask maskBefore = ComputeComponentMask(*data);
+    const size_t scriptsBefore = data->Scripts.size();
+    const size_t iksBefore = data->IKs.size();
 
     ImGui::Text("Entity: %s", data->Name.c_str());
     ImGui::Separator();
@@ -424,6 +430,8 @@ void InspectorPanel::DrawComponents(EntityID entity) {
 
     if (&data->Transform && ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
         registry.DrawComponentUI("Transform", &data->Transform);
+        // The drawer only flags the component; queue the subtree for UpdateTransforms
+        if (data->Transform.TransformDirty) m_Context->MarkTransformDirty(entity);
         // Timeline key operations removed
     }
 
@@ -790,11 +798,18 @@ void InspectorPanel::DrawComponents(EntityID entity) {
     // Skeleton tools (visible whether or not Animator exists)
     if (data->Skeleton && ImGui::CollapsingHeader("Skeleton")) {
         ImGui::Text("Bones: %d", (int)data->Skeleton->BoneNameToIndex.size());
+        ImGui::Checkbox("Write Back All Bones", &data->Skeleton->WriteBackAllBones);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Update every bone entity while animating (otherwise only bones with attachments, components or IK targets)");
         if (ImGui::Button("Open Avatar Builder")) {
             if (m_AvatarBuilder) m_AvatarBuilder->OpenForEntity(entity);
         }
     }
 
+    if (data->Skinning && ImGui::CollapsingHeader("Skinning")) {
+        ImGui::Checkbox("CPU Skinning", &data->Skinning->CpuSkinning);
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Skin this mesh on the CPU as well, for animated bounds, picking and hitbox queries");
+    }
+
     if (data->AnimationPlayer && ImGui::CollapsingHeader("Animator")) {
         // Draw component UI (includes mode and single-clip controls)
         registry.DrawComponentUI("Animator", data->AnimationPlayer.get());
@@ -865,6 +880,11 @@ void InspectorPanel::DrawComponents(EntityID entity) {
 
     ImGui::Separator();
     DrawAddComponentButton(entity);
+
+    data = m_Context->GetEntityData(entity);
+    if (data && (ComputeComponentMask(*data) != maskBefore || data->Scripts.size() != scriptsBefore
+                 || data->IKs.size() != iksBefore))
+        m_Context->MarkComponentsChanged();
 }
 
 void InspectorPanel::DrawAddComponentButton(EntityID entity) {
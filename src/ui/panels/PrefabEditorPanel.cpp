@@ -60,6 +60,9 @@ void PrefabEditorPanel::LoadPrefab(const std::string& path)
     m_Scene.UpdateTransforms();
     // Add non-serialized editor lighting/environment
     EnsureEditorLighting();
+    // This scene never runs Update, which is what normally re-buckets the archetype index;
+    // components attached while loading must be visible to the first View
+    m_Scene.InvalidateArchetypes();
 }
 
 void PrefabEditorPanel::OnImGuiRender()
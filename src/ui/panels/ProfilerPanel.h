@@ -3,6 +3,8 @@
 #include "EditorPanel.h"
 #include "utils/Profiler.h"
 #include <imgui.h>
+#include <algorithm>
+#include <vector>
 
 class ProfilerPanel : public EditorPanel {
 public:
@@ -39,6 +41,22 @@ public:
 			ImGui::EndTable();
 		}
 
+		const auto& counters = prof.GetLastFrameCounters();
+		if (!counters.empty() && ImGui::BeginTable("counters", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable)) {
+			ImGui::TableSetupColumn("Counter");
+			ImGui::TableSetupColumn("Value");
+			ImGui::TableHeadersRow();
+
+			std::vector<std::pair<std::string, int64_t>> rows(counters.begin(), counters.end());
+			std::sort(rows.begin(), rows.end());
+			for (const auto& c : rows) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(c.first.c_str());
+				ImGui::TableSetColumnIndex(1); ImGui::Text("%lld", (long long)c.second);
+			}
+			ImGui::EndTable();
+		}
+
 		ImGui::End();
 	}
 
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <particles/ParticleSystem.h>
 #include "animation/AnimationPlayerComponent.h"
+#include "animation/AnimationAssetCache.h"
 // Needed for LoadAnimationAsset and AnimationAsset serialization IO
 #include "animation/AnimationSerializer.h"
 #include <cstring>
@@ -71,7 +72,12 @@ inline void RegisterComponentDrawers() {
     registry.Register<MeshComponent>("Mesh", [](MeshComponent& m) {
         ImGui::Text("Mesh Name: %s", m.MeshName.c_str());
         if (!m.material && m.materials.empty()) return;
-        auto drawTexSlot = [&](const char* label, bgfx::TextureHandle& tex) {
+        // Dropped textures are streamed in through the material; the thumbnail shows
+        // whatever mip tier is currently resident
+        auto drawTexSlot = [&](const char* label, PBRMaterial& pbr,
+                               bgfx::TextureHandle (PBRMaterial::*getTex)() const,
+                               void (PBRMaterial::*setTexPath)(const std::string&)) {
+                bgfx::TextureHandle tex = (pbr.*getTex)();
                 ImGui::Separator();
                 ImGui::Text("%s", label);
                 ImTextureID texId = (ImTextureID)(uintptr_t)(bgfx::isValid(tex) ? tex.idx : 0);
@@ -93,10 +99,7 @@ inline void RegisterComponentDrawers() {
                         std::string ext = std::filesystem::path(path).extension().string();
                         std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
                         if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp" || ext == ".hdr") {
-                            bgfx::TextureHandle newTex = TextureLoader::Load2D(path);
-                            if (bgfx::isValid(newTex)) {
-                                tex = newTex;
-                            }
+                            (pbr.*setTexPath)(path);
                         }
                     }
                     if (ImGui::IsDragDropPayloadBeingAccepted()) {
@@ -117,16 +120,16 @@ inline void RegisterComponentDrawers() {
             auto mat = m.materials[selectedSlot];
             ImGui::TextDisabled("%s", mat ? mat->GetName().c_str() : "<none>");
             if (auto pbr = std::dynamic_pointer_cast<PBRMaterial>(mat)) {
-                drawTexSlot("Albedo", pbr->m_AlbedoTex);
-                drawTexSlot("MetallicRoughness", pbr->m_MetallicRoughnessTex);
-                drawTexSlot("Normal", pbr->m_NormalTex);
+                drawTexSlot("Albedo", *pbr, &PBRMaterial::GetAlbedoTexture, &PBRMaterial::SetAlbedoTextureFromPath);
+                drawTexSlot("MetallicRoughness", *pbr, &PBRMaterial::GetMetallicRoughnessTexture, &PBRMaterial::SetMetallicRoughnessTextureFromPath);
+                drawTexSlot("Normal", *pbr, &PBRMaterial::GetNormalTexture, &PBRMaterial::SetNormalTextureFromPath);
             }
         } else if (m.material) {
             ImGui::TextDisabled("%s", m.material->GetName().c_str());
             if (auto pbr = std::dynamic_pointer_cast<PBRMaterial>(m.material)) {
-                drawTexSlot("Albedo", pbr->m_AlbedoTex);
-                drawTexSlot("MetallicRoughness", pbr->m_MetallicRoughnessTex);
-                drawTexSlot("Normal", pbr->m_NormalTex);
+                drawTexSlot("Albedo", *pbr, &PBRMaterial::GetAlbedoTexture, &PBRMaterial::SetAlbedoTextureFromPath);
+                drawTexSlot("MetallicRoughness", *pbr, &PBRMaterial::GetMetallicRoughnessTexture, &PBRMaterial::SetMetallicRoughnessTextureFromPath);
+                drawTexSlot("Normal", *pbr, &PBRMaterial::GetNormalTexture, &PBRMaterial::SetNormalTextureFromPath);
             }
         }
         // Blend shape sliders
@@ -480,29 +483,21 @@ inline void RegisterComponentDrawers() {
                     bool isSelected = (i == selectedIndex);
                     if (ImGui::Selectable(s_options[i].name.c_str(), isSelected)) {
                         selectedIndex = i;
-                        // Load to validate this clip has skeletal content; if not, ignore selection
-                        cm::animation::AnimationAsset asset = cm::animation::LoadAnimationAsset(s_options[i].path);
+                        // Load to validate this clip has skeletal content; if not, ignore selection.
+                        // The shared cache wraps legacy skeletal clips, so one check covers both.
+                        std::shared_ptr<const cm::animation::AnimationAsset> asset = cm::animation::AnimationAssetCache::Instance().LoadBlocking(s_options[i].path);
                         bool hasSkeletal = false;
-                        for (const auto& t : asset.tracks) {
+                        for (const auto& t : asset->tracks) {
                             if (!t) continue;
                             if (t->type == cm::animation::TrackType::Bone || t->type == cm::animation::TrackType::Avatar) { hasSkeletal = true; break; }
                         }
-                        if (!hasSkeletal) {
-                            // Fallback: legacy skeletal
-                            cm::animation::AnimationClip legacy = cm::animation::LoadAnimationClip(s_options[i].path);
-                            if (!legacy.BoneTracks.empty() || !legacy.HumanoidTracks.empty()) {
-                                asset = cm::animation::WrapLegacyClipAsAsset(legacy);
-                                hasSkeletal = true;
-                            }
-                        }
                         if (hasSkeletal) {
                             ap.SingleClipPath = s_options[i].path;
                             ap._InitApplied = false; // allow PlayOnStart to apply on next run
-                            // Immediately bind/cached like previous behavior
-                            auto assetPtr = std::make_shared<cm::animation::AnimationAsset>(std::move(asset));
-                            ap.CachedAssets[0] = assetPtr;
+                            // Immediately bind like previous behavior
+                            ap.CachedAssets[s_options[i].path] = asset;
                             if (ap.ActiveStates.empty()) ap.ActiveStates.push_back({});
-                            ap.ActiveStates.front().Asset = assetPtr.get();
+                            ap.ActiveStates.front().Asset = asset.get();
                             ap.ActiveStates.front().LegacyClip = nullptr;
                             ap.AnimatorMode = cm::animation::AnimationPlayerComponent::Mode::AnimationPlayerAnimated;
                             ap.Controller.reset();
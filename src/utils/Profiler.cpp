@@ -20,11 +20,13 @@ bool Profiler::IsEnabled() const { return m_Enabled; }
 void Profiler::BeginFrame() {
 	if (!m_Enabled) return;
 	m_CurrentEntries.clear();
+	m_CurrentCounters.clear();
 }
 
 void Profiler::EndFrame() {
 	if (!m_Enabled) return;
 	m_LastEntries = m_CurrentEntries;
+	m_LastCounters = m_CurrentCounters;
 }
 
 void Profiler::Record(const std::string& name, double durationMs) {
@@ -39,6 +41,15 @@ void Profiler::RecordScriptSample(const std::string& scriptClassName, double dur
 	Record(std::string("Script/") + scriptClassName, durationMs);
 }
 
+void Profiler::RecordCounter(const std::string& name, int64_t value) {
+	if (!m_Enabled) return;
+	m_CurrentCounters[name] += value;
+}
+
+const std::unordered_map<std::string, int64_t>& Profiler::GetLastFrameCounters() const {
+	return m_LastCounters.empty() ? m_CurrentCounters : m_LastCounters;
+}
+
 const std::unordered_map<std::string, Profiler::Entry>& Profiler::GetEntries() const {
 	return m_CurrentEntries;
 }
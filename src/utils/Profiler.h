@@ -36,6 +36,11 @@ public:
 	// Convenience for script timings
 	void RecordScriptSample(const std::string& scriptClassName, double durationMs);
 
+	// Record a per-frame counter (e.g. visible/culled draws); repeated calls in a frame add up
+	void RecordCounter(const std::string& name, int64_t value);
+	// Last completed frame counters (unsorted)
+	const std::unordered_map<std::string, int64_t>& GetLastFrameCounters() const;
+
 	// Current frame entries (unsorted)
 	const std::unordered_map<std::string, Entry>& GetEntries() const;
 	// Last completed frame entries (unsorted)
@@ -52,6 +57,8 @@ private:
 	Profiler() = default;
 	std::unordered_map<std::string, Entry> m_CurrentEntries;
 	std::unordered_map<std::string, Entry> m_LastEntries;
+	std::unordered_map<std::string, int64_t> m_CurrentCounters;
+	std::unordered_map<std::string, int64_t> m_LastCounters;
 	bool m_Enabled = true;
 };
 